@@ -130,9 +130,9 @@ public class BraveShieldsContentSettings {
     }
 
     @CalledByNative
-    private void blockedEvent(int tabId, String block_type, String subresource) {
+    private void blockedEvent(int tabId, String block_type, String subresource, int count) {
         for (BraveShieldsContentSettingsObserver observer : mBraveShieldsContentSettingsObservers) {
-            observer.blockEvent(tabId, block_type, subresource);
+            observer.blockEvent(tabId, block_type, subresource, count);
         }
     }
 
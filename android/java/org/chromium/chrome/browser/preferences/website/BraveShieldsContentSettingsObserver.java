@@ -9,7 +9,10 @@ package org.chromium.chrome.browser.preferences.website;
  * Allows monitoring of blocked resources via brave shields.
  */
 public interface BraveShieldsContentSettingsObserver {
-    public void blockEvent(int tabId, String block_type, String subresource);
+    /**
+     * Called when |subresource| was blocked |count| times since the last event for it.
+     */
+    public void blockEvent(int tabId, String block_type, String subresource, int count);
     public void savedBandwidth(long savings);
 }
 
@@ -166,21 +166,21 @@ public class BraveShieldsHandler implements BraveRewardsHelper.LargeIconReadyCal
         }
     }
 
-    public void addStat(int tabId, String block_type, String subresource) {
+    public void addStat(int tabId, String block_type, int count) {
         if (!mTabsStat.containsKey(tabId)) {
             mTabsStat.put(tabId, new BlockersInfo());
         }
         BlockersInfo blockersInfo = mTabsStat.get(tabId);
         if (block_type.equals(BraveShieldsContentSettings.RESOURCE_IDENTIFIER_ADS)) {
-            blockersInfo.mAdsBlocked++;
+            blockersInfo.mAdsBlocked += count;
         } else if (block_type.equals(BraveShieldsContentSettings.RESOURCE_IDENTIFIER_TRACKERS)) {
-            blockersInfo.mTrackersBlocked++;
+            blockersInfo.mTrackersBlocked += count;
         } else if (block_type.equals(BraveShieldsContentSettings.RESOURCE_IDENTIFIER_HTTP_UPGRADABLE_RESOURCES)) {
-            blockersInfo.mHTTPSUpgrades++;
+            blockersInfo.mHTTPSUpgrades += count;
         } else if (block_type.equals(BraveShieldsContentSettings.RESOURCE_IDENTIFIER_JAVASCRIPTS)) {
-            blockersInfo.mScriptsBlocked++;
+            blockersInfo.mScriptsBlocked += count;
         } else if (block_type.equals(BraveShieldsContentSettings.RESOURCE_IDENTIFIER_FINGERPRINTING)) {
-            blockersInfo.mFingerprintsBlocked++;
+            blockersInfo.mFingerprintsBlocked += count;
         }
     }
 
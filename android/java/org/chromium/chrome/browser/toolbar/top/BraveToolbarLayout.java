@@ -237,8 +237,9 @@ public abstract class BraveToolbarLayout extends ToolbarLayout
         });
         mBraveShieldsContentSettingsObserver = new BraveShieldsContentSettingsObserver() {
             @Override
-            public void blockEvent(int tabId, String block_type, String subresource) {
-                mBraveShieldsHandler.addStat(tabId, block_type, subresource);
+            public void blockEvent(
+                    int tabId, String block_type, String subresource, int count) {
+                mBraveShieldsHandler.addStat(tabId, block_type, count);
                 Tab currentTab = getToolbarDataProvider().getTab();
                 if (currentTab == null || currentTab.getId() != tabId) {
                     return;
@@ -248,7 +249,7 @@ public abstract class BraveToolbarLayout extends ToolbarLayout
                         && (block_type.equals(BraveShieldsContentSettings.RESOURCE_IDENTIFIER_ADS)
                                 || block_type.equals(BraveShieldsContentSettings
                                                              .RESOURCE_IDENTIFIER_TRACKERS))) {
-                    addStatsToDb(block_type, subresource, currentTab.getUrlString());
+                    addStatsToDb(block_type, subresource, currentTab.getUrlString(), count);
                 }
             }
 
@@ -797,7 +798,7 @@ public abstract class BraveToolbarLayout extends ToolbarLayout
         }.executeOnExecutor(AsyncTask.THREAD_POOL_EXECUTOR);
     }
 
-    private void addStatsToDb(String statType, String statSite, String url) {
+    private void addStatsToDb(String statType, String statSite, String url, int count) {
         new AsyncTask<Void>() {
             @Override
             protected Void doInBackground() {
@@ -807,7 +808,9 @@ public abstract class BraveToolbarLayout extends ToolbarLayout
                     BraveStatsTable braveStatsTable = new BraveStatsTable(url, urlObject.getHost(),
                             statType, statSite, siteObject.getHost(),
                             BraveStatsUtil.getCalculatedDate("yyyy-MM-dd", 0));
-                    long rowId = mDatabaseHelper.insertStats(braveStatsTable);
+                    for (int i = 0; i < count; i++) {
+                        mDatabaseHelper.insertStats(braveStatsTable);
+                    }
                 } catch (Exception e) {
                     // Do nothing if url is invalid.
                     // Just return w/o showing shields popup.
@@ -39,6 +39,7 @@
 #include "components/password_manager/core/common/password_manager_features.h"
 #include "components/security_state/core/features.h"
 #include "components/sync/base/sync_base_switches.h"
+#include "components/tracing/common/tracing_switches.h"
 #include "components/translate/core/browser/translate_prefs.h"
 #include "components/variations/variations_switches.h"
 #include "content/public/common/content_features.h"
@@ -87,6 +88,13 @@ const char kBraveOriginTrialsPublicKey[] =
 
 const char kDummyUrl[] = "https://no-thanks.invalid";
 
+// Brave components start after the browser does, so record long enough to
+// catch them.
+const char kBraveTraceStartupCategories[] =
+    "brave.ads,brave.ipfs,brave.p3a,brave.rewards,brave.shields,brave.tor,"
+    "brave.wallet,startup,toplevel";
+const char kBraveTraceStartupDurationInSec[] = "30";
+
 BraveMainDelegate::BraveMainDelegate() : ChromeMainDelegate() {}
 
 BraveMainDelegate::BraveMainDelegate(base::TimeTicks exe_entry_point_ticks)
@@ -184,6 +192,14 @@ bool BraveMainDelegate::BasicStartupComplete(int* exit_code) {
 
   command_line.AppendSwitchASCII(switches::kLsoUrl, kDummyUrl);
 
+  if (base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kTraceBraveStartup)) {
+    command_line.AppendSwitchASCII(switches::kTraceStartup,
+                                   kBraveTraceStartupCategories);
+    command_line.AppendSwitchASCII(switches::kTraceStartupDuration,
+                                   kBraveTraceStartupDurationInSec);
+  }
+
   // Brave variations
   std::string kVariationsServerURL = BRAVE_VARIATIONS_SERVER_URL;
   command_line.AppendSwitchASCII(variations::switches::kVariationsServerURL,
@@ -50,12 +50,13 @@ void BraveShieldsContentSettings::Destroy(JNIEnv* env) {
 }
 
 void BraveShieldsContentSettings::DispatchBlockedEventToJava(int tab_id,
-        const std::string& block_type, const std::string& subresource) {
+        const std::string& block_type, const std::string& subresource,
+        int count) {
   JNIEnv* env = base::android::AttachCurrentThread();
   Java_BraveShieldsContentSettings_blockedEvent(
       env, jobj_, tab_id,
       base::android::ConvertUTF8ToJavaString(env, block_type),
-      base::android::ConvertUTF8ToJavaString(env, subresource));
+      base::android::ConvertUTF8ToJavaString(env, subresource), count);
 }
 
 void BraveShieldsContentSettings::DispatchSavedBandwidthToJava(
@@ -74,13 +75,14 @@ void BraveShieldsContentSettings::DispatchSavedBandwidth(uint64_t savings) {
 
 // static
 void BraveShieldsContentSettings::DispatchBlockedEvent(int tab_id,
-  const std::string& block_type, const std::string& subresource) {
+  const std::string& block_type, const std::string& subresource,
+  int count) {
   DCHECK(g_brave_shields_content_settings);
   if (!g_brave_shields_content_settings) {
     return;
   }
   g_brave_shields_content_settings->DispatchBlockedEventToJava(tab_id,
-      block_type, subresource);
+      block_type, subresource, count);
 }
 
 void JNI_BraveShieldsContentSettings_SetBraveShieldsEnabled(JNIEnv* env,
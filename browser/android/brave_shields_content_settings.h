@@ -22,14 +22,16 @@ class BraveShieldsContentSettings {
   void Destroy(JNIEnv* env);
   void DispatchBlockedEventToJava(int tab_id,
                                   const std::string& block_type,
-                                  const std::string& subresource);
+                                  const std::string& subresource,
+                                  int count);
   void DispatchSavedBandwidthToJava(uint64_t savings);
 
   static void DispatchSavedBandwidth(uint64_t savings);
 
   static void DispatchBlockedEvent(int tab_id,
                                    const std::string& block_type,
-                                   const std::string& subresource);
+                                   const std::string& subresource,
+                                   int count);
 
  private:
   base::android::ScopedJavaGlobalRef<jobject> jobj_;
@@ -6,6 +6,7 @@
 #include "brave/browser/brave_ads/ads_tab_helper.h"
 
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "brave/browser/brave_ads/ads_service_factory.h"
@@ -27,6 +28,16 @@
 
 namespace brave_ads {
 
+namespace {
+
+// Text classification only hashes the first 1048576 characters of page text,
+// so longer text is truncated in the renderer rather than copied to the ads
+// service
+constexpr char kTextScript[] =
+    "document?.body?.innerText?.substring(0, 1048576)";
+
+}  // namespace
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       tab_id_(sessions::SessionTabHelper::IdForTab(web_contents)),
@@ -77,13 +88,20 @@ void AdsTabHelper::RunIsolatedJavaScript(
     content::RenderFrameHost* render_frame_host) {
   DCHECK(render_frame_host);
 
-  dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "new XMLSerializer().serializeToString(document)",
-      base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
-                     weak_factory_.GetWeakPtr()));
+  // Page HTML is only used to look for conversion ids, so don't serialize and
+  // copy the whole document when conversion tracking is not allowed. The
+  // empty result still lets ads be transferred on navigation
+  if (ads_service_->ShouldAllowConversionTracking()) {
+    dom_distiller::RunIsolatedJavaScript(
+        render_frame_host, "new XMLSerializer().serializeToString(document)",
+        base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
+                       weak_factory_.GetWeakPtr()));
+  } else {
+    ads_service_->OnHtmlLoaded(tab_id_, redirect_chain_, std::string());
+  }
 
   dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "document?.body?.innerText",
+      render_frame_host, kTextScript,
       base::BindOnce(&AdsTabHelper::OnJavaScriptTextResult,
                      weak_factory_.GetWeakPtr()));
 }
@@ -93,7 +111,9 @@ void AdsTabHelper::OnJavaScriptHtmlResult(base::Value value) {
 
   DCHECK(value.is_string());
   std::string html;
-  value.GetAsString(&html);
+  if (value.is_string()) {
+    html = std::move(value.GetString());
+  }
 
   ads_service_->OnHtmlLoaded(tab_id_, redirect_chain_, html);
 }
@@ -103,7 +123,9 @@ void AdsTabHelper::OnJavaScriptTextResult(base::Value value) {
 
   DCHECK(value.is_string());
   std::string text;
-  value.GetAsString(&text);
+  if (value.is_string()) {
+    text = std::move(value.GetString());
+  }
 
   ads_service_->OnTextLoaded(tab_id_, redirect_chain_, text);
 }
@@ -22,8 +22,12 @@
 
 #if BUILDFLAG(ENABLE_TOR)
 #include <string>
+#include "base/bind.h"
 #include "base/files/file_util.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "brave/browser/tor/tor_profile_manager.h"
 #include "brave/components/tor/tor_constants.h"
+#include "chrome/browser/after_startup_task_utils.h"
 #include "chrome/browser/browser_process_impl.h"
 #include "chrome/browser/profiles/profile_attributes_storage.h"
 #include "chrome/browser/profiles/profile_manager.h"
@@ -57,6 +61,19 @@
 #include "extensions/browser/extension_system.h"
 #endif
 
+#if BUILDFLAG(ENABLE_TOR)
+namespace {
+
+void PrewarmTorForLastUsedProfile() {
+  Profile* profile = ProfileManager::GetLastUsedProfileIfLoaded();
+  if (!profile || profile->IsGuestSession() || profile->IsSystemProfile())
+    return;
+  TorProfileManager::PrewarmTor(profile->GetOriginalProfile());
+}
+
+}  // namespace
+#endif
+
 void BraveBrowserMainParts::PostBrowserStart() {
   ChromeBrowserMainParts::PostBrowserStart();
 
@@ -97,6 +114,12 @@ void BraveBrowserMainParts::PostBrowserStart() {
           ProfileMetrics::DELETE_PROFILE_SETTINGS);
     }
   }
+
+  // Don't compete with startup work; TorProfileManager::PrewarmTor bails out
+  // unless prewarming is enabled.
+  AfterStartupTaskUtils::PostTask(
+      FROM_HERE, base::SequencedTaskRunnerHandle::Get(),
+      base::BindOnce(&PrewarmTorForLastUsedProfile));
 #endif
 
 #if !defined(OS_ANDROID)
@@ -8,8 +8,11 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/feature_list.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/path_service.h"
 #include "base/task/post_task.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/browser/brave_stats/brave_stats_updater.h"
 #include "brave/browser/component_updater/brave_component_updater_configurator.h"
 #include "brave/browser/component_updater/brave_component_updater_delegate.h"
@@ -35,6 +38,7 @@
 #include "brave/components/p3a/brave_p3a_service.h"
 #include "brave/components/p3a/buildflags.h"
 #include "brave/services/network/public/cpp/system_request_handler.h"
+#include "chrome/browser/after_startup_task_utils.h"
 #include "chrome/browser/component_updater/component_updater_utils.h"
 #include "chrome/browser/net/system_network_context_manager.h"
 #include "chrome/common/buildflags.h"
@@ -75,6 +79,7 @@
 #endif
 
 #if BUILDFLAG(ENABLE_SPEEDREADER)
+#include "brave/components/speedreader/features.h"
 #include "brave/components/speedreader/speedreader_rewriter_service.h"
 #endif
 
@@ -142,6 +147,10 @@ void BraveBrowserProcessImpl::Init() {
   brave_component_updater::BraveOnDemandUpdater::GetInstance()->
       RegisterOnDemandUpdateCallback(
           base::BindRepeating(&component_updater::BraveOnDemandUpdate));
+  AfterStartupTaskUtils::PostTask(
+      FROM_HERE, base::SequencedTaskRunnerHandle::Get(),
+      base::BindOnce(&BraveBrowserProcessImpl::StartBraveServicesAfterStartup,
+                     base::Unretained(this)));
   UpdateBraveDarkMode();
   pref_change_registrar_.Add(
       kBraveDarkMode,
@@ -176,7 +185,11 @@ ProfileManager* BraveBrowserProcessImpl::profile_manager() {
 
 void BraveBrowserProcessImpl::StartBraveServices() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  brave_services_start_time_ = base::TimeTicks::Now();
 
+  // Shields and the local data files consumers have to be ready before the
+  // first navigation. Everything else waits for
+  // StartBraveServicesAfterStartup.
   ad_block_service()->Start();
   https_everywhere_service()->Start();
 
@@ -187,10 +200,10 @@ void BraveBrowserProcessImpl::StartBraveServices() {
   greaselion_download_service();
 #endif
 #if BUILDFLAG(ENABLE_SPEEDREADER)
-  speedreader_rewriter_service();
-#endif
-#if BUILDFLAG(BRAVE_ADS_ENABLED)
-  resource_component();
+  // The rewriter registers its component on creation, so don't download it
+  // unless speedreader can be turned on. It is also created on first use.
+  if (base::FeatureList::IsEnabled(speedreader::kSpeedreaderFeature))
+    speedreader_rewriter_service();
 #endif
   // Now start the local data files service, which calls all observers.
   local_data_files_service()->Start();
@@ -199,6 +212,30 @@ void BraveBrowserProcessImpl::StartBraveServices() {
   brave_sync::NetworkTimeHelper::GetInstance()
     ->SetNetworkTimeTracker(g_browser_process->network_time_tracker());
 #endif
+
+  UMA_HISTOGRAM_TIMES("Brave.Startup.StartServicesTime",
+                      base::TimeTicks::Now() - brave_services_start_time_);
+}
+
+void BraveBrowserProcessImpl::StartBraveServicesAfterStartup() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  if (!brave_services_start_time_.is_null()) {
+    UMA_HISTOGRAM_LONG_TIMES("Brave.Startup.AfterStartupDelay",
+                             start_time - brave_services_start_time_);
+  }
+
+  // Component updates which aren't needed for the first window were held
+  // back until now.
+  brave_component_updater::BraveOnDemandUpdater::GetInstance()
+      ->OnStartupComplete();
+#if BUILDFLAG(BRAVE_ADS_ENABLED)
+  // Ads services create it on demand if they start earlier.
+  resource_component();
+#endif
+
+  UMA_HISTOGRAM_TIMES("Brave.Startup.AfterStartupServicesTime",
+                      base::TimeTicks::Now() - start_time);
 }
 
 brave_shields::AdBlockService* BraveBrowserProcessImpl::ad_block_service() {
@@ -312,8 +349,10 @@ brave::BraveP3AService* BraveBrowserProcessImpl::brave_p3a_service() {
   if (brave_p3a_service_) {
     return brave_p3a_service_.get();
   }
+  base::FilePath user_data_dir;
+  base::PathService::Get(chrome::DIR_USER_DATA, &user_data_dir);
   brave_p3a_service_ = base::MakeRefCounted<brave::BraveP3AService>(
-      local_state(), brave::GetChannelName(),
+      local_state(), user_data_dir, brave::GetChannelName(),
       local_state()->GetString(kWeekOfInstallation));
   brave_p3a_service()->InitCallbacks();
   return brave_p3a_service_.get();
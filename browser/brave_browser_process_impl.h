@@ -9,6 +9,7 @@
 #include <memory>
 
 #include "base/memory/ref_counted.h"
+#include "base/time/time.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/components/brave_ads/browser/buildflags/buildflags.h"
 #include "brave/components/brave_component_updater/browser/brave_component.h"
@@ -124,6 +125,9 @@ class BraveBrowserProcessImpl : public BraveBrowserProcess,
   void CreateProfileManager();
   void CreateNotificationPlatformBridge();
 
+  // Starts services which aren't needed before the first window is shown.
+  void StartBraveServicesAfterStartup();
+
 #if BUILDFLAG(ENABLE_TOR)
   void OnTorEnabledChanged();
 #endif
@@ -134,6 +138,8 @@ class BraveBrowserProcessImpl : public BraveBrowserProcess,
   brave_component_updater::BraveComponent::Delegate*
   brave_component_updater_delegate();
 
+  base::TimeTicks brave_services_start_time_;
+
   // local_data_files_service_ should always be first because it needs
   // to be destroyed last
   std::unique_ptr<brave_component_updater::LocalDataFilesService>
@@ -207,6 +207,13 @@ bool AdBlockServiceTest::StartAdBlockRegionalServices() {
 }
 
 void AdBlockServiceTest::WaitForAdBlockServiceThreads() {
+  // Custom filter engines are built on their own sequence before being
+  // swapped in on the shields task runner.
+  scoped_refptr<base::ThreadTestHelper> build_helper(
+      new base::ThreadTestHelper(
+          g_brave_browser_process->ad_block_custom_filters_service()
+              ->GetEngineBuildTaskRunnerForTest()));
+  ASSERT_TRUE(build_helper->Run());
   scoped_refptr<base::ThreadTestHelper> tr_helper(new base::ThreadTestHelper(
       g_brave_browser_process->local_data_files_service()->GetTaskRunner()));
   ASSERT_TRUE(tr_helper->Run());
@@ -249,6 +256,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
                        NotAdsDoNotGetBlockedByCustomBlocker) {
   ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
                   ->UpdateCustomFilters("*ad_banner.png"));
+  WaitForAdBlockServiceThreads();
 
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
 
@@ -269,6 +277,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, AdsGetBlockedByCustomBlocker) {
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
   ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
                   ->UpdateCustomFilters("*ad_banner.png"));
+  WaitForAdBlockServiceThreads();
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
@@ -288,6 +297,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, DefaultBlockCustomException) {
   UpdateAdBlockInstanceWithRules("*ad_banner.png");
   ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
                   ->UpdateCustomFilters("@@ad_banner.png"));
+  WaitForAdBlockServiceThreads();
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
@@ -307,6 +317,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CustomBlockDefaultException) {
   UpdateAdBlockInstanceWithRules("@@ad_banner.png");
   ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
                   ->UpdateCustomFilters("*ad_banner.png"));
+  WaitForAdBlockServiceThreads();
 
   GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
   ui_test_utils::NavigateToURL(browser(), url);
@@ -1107,6 +1118,7 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CspRuleMerging) {
                       "||example.com^$csp=img-src 'none'\n"
                       "||sub.example.com^$csp=script-src 'nonce-abcdef' "
                       "'unsafe-eval' 'unsafe-inline'"));
+  WaitForAdBlockServiceThreads();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
 
   const GURL url =
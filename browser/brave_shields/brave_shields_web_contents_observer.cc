@@ -9,7 +9,11 @@
 #include <string>
 #include <utility>
 
+#include "base/bind.h"
+#include "base/hash/hash.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/utf_string_conversions.h"
+#include "brave/browser/ephemeral_storage/ephemeral_storage_tab_helper.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_perf_predictor/browser/buildflags.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -50,6 +54,17 @@ using content::WebContents;
 
 namespace {
 
+// How long blocked events are collected before being dispatched together.
+constexpr base::TimeDelta kBlockedEventsDispatchDelay =
+    base::TimeDelta::FromMilliseconds(100);
+
+// Dispatch early once this many events are pending, to bound the queue.
+constexpr size_t kMaxPendingBlockedEvents = 100;
+
+size_t HashString(base::StringPiece value) {
+  return base::FastHash(base::as_bytes(base::make_span(value)));
+}
+
 // Content Settings are only sent to the main frame currently. Chrome may fix
 // this at some point, but for now we do this as a work-around. You can verify
 // if this is fixed by running the following test: npm run test --
@@ -118,12 +133,51 @@ void BraveShieldsWebContentsObserver::RenderFrameHostChanged(
 
 bool BraveShieldsWebContentsObserver::IsBlockedSubresource(
     const std::string& subresource) {
-  return blocked_url_paths_.find(subresource) != blocked_url_paths_.end();
+  return blocked_url_paths_.find(HashString(subresource)) !=
+         blocked_url_paths_.end();
 }
 
 void BraveShieldsWebContentsObserver::AddBlockedSubresource(
     const std::string& subresource) {
-  blocked_url_paths_.insert(subresource);
+  blocked_url_paths_.insert(HashString(subresource));
+}
+
+void BraveShieldsWebContentsObserver::QueueBlockedEvent(
+    const std::string& block_type,
+    const std::string& subresource) {
+  const size_t hash =
+      base::HashInts(HashString(block_type), HashString(subresource));
+  auto it = pending_blocked_event_indices_.find(hash);
+  if (it != pending_blocked_event_indices_.end()) {
+    pending_blocked_events_[it->second].count++;
+    return;
+  }
+
+  pending_blocked_event_indices_[hash] = pending_blocked_events_.size();
+  pending_blocked_events_.push_back({block_type, subresource, 1});
+  if (pending_blocked_events_.size() >= kMaxPendingBlockedEvents) {
+    FlushBlockedEvents();
+    return;
+  }
+
+  if (!blocked_events_timer_.IsRunning()) {
+    blocked_events_timer_.Start(
+        FROM_HERE, kBlockedEventsDispatchDelay,
+        base::BindOnce(&BraveShieldsWebContentsObserver::FlushBlockedEvents,
+                       base::Unretained(this)));
+  }
+}
+
+void BraveShieldsWebContentsObserver::FlushBlockedEvents() {
+  blocked_events_timer_.Stop();
+  std::vector<BlockedEvent> blocked_events;
+  blocked_events.swap(pending_blocked_events_);
+  pending_blocked_event_indices_.clear();
+  for (const auto& blocked_event : blocked_events) {
+    DispatchBlockedEventForWebContents(
+        blocked_event.block_type, blocked_event.subresource,
+        blocked_event.count, web_contents());
+  }
 }
 
 // static
@@ -136,12 +190,17 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
   auto subresource = request_url.spec();
   WebContents* web_contents =
       WebContents::FromFrameTreeNodeId(frame_tree_node_id);
-  DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
-
-  if (web_contents) {
-    BraveShieldsWebContentsObserver* observer =
-        BraveShieldsWebContentsObserver::FromWebContents(web_contents);
-    if (observer && !observer->IsBlockedSubresource(subresource)) {
+  BraveShieldsWebContentsObserver* observer =
+      web_contents
+          ? BraveShieldsWebContentsObserver::FromWebContents(web_contents)
+          : nullptr;
+  if (!observer) {
+    DispatchBlockedEventForWebContents(block_type, subresource, 1,
+                                       web_contents);
+  } else {
+    observer->QueueBlockedEvent(block_type, subresource);
+
+    if (!observer->IsBlockedSubresource(subresource)) {
       observer->AddBlockedSubresource(subresource);
       PrefService* prefs =
           Profile::FromBrowserContext(web_contents->GetBrowserContext())
@@ -172,11 +231,14 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
 void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
     const std::string& block_type,
     const std::string& subresource,
+    int count,
     WebContents* web_contents) {
 #if BUILDFLAG(ENABLE_EXTENSIONS)
   if (!web_contents) {
     return;
   }
+  // The shields extension counts unique subresources per tab, so repeats
+  // don't need their own events and |count| is not passed on.
   EventRouter* event_router =
       EventRouter::Get(web_contents->GetBrowserContext());
   if (event_router) {
@@ -204,7 +266,23 @@ void BraveShieldsWebContentsObserver::OnJavaScriptBlocked(
     return;
 
   DispatchBlockedEventForWebContents(brave_shields::kJavaScript,
-                                     base::UTF16ToUTF8(details), web_contents);
+                                     base::UTF16ToUTF8(details), 1,
+                                     web_contents);
+}
+
+void BraveShieldsWebContentsObserver::CreateEphemeralStorageAreas(
+    CreateEphemeralStorageAreasCallback callback) {
+  WebContents* web_contents = WebContents::FromRenderFrameHost(
+      brave_shields_receivers_.GetCurrentTargetFrame());
+  if (web_contents) {
+    // The tab helper only exists while ephemeral storage is enabled.
+    if (auto* tab_helper =
+            ephemeral_storage::EphemeralStorageTabHelper::FromWebContents(
+                web_contents)) {
+      tab_helper->EnsureEphemeralStorageAreas();
+    }
+  }
+  std::move(callback).Run();
 }
 
 // static
@@ -242,6 +320,22 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
   }
 }
 
+void BraveShieldsWebContentsObserver::DidFinishNavigation(
+    content::NavigationHandle* navigation_handle) {
+  if (!navigation_handle->IsInMainFrame() ||
+      !navigation_handle->HasCommitted() ||
+      navigation_handle->IsSameDocument()) {
+    return;
+  }
+
+  // The shields UI resets its per-tab counts on main frame commits, so events
+  // still pending for the previous page would only be counted against the new
+  // one.
+  blocked_events_timer_.Stop();
+  pending_blocked_events_.clear();
+  pending_blocked_event_indices_.clear();
+}
+
 void BraveShieldsWebContentsObserver::AllowScriptsOnce(
     const std::vector<std::string>& origins,
     WebContents* contents) {
@@ -7,13 +7,15 @@
 #define BRAVE_BROWSER_BRAVE_SHIELDS_BRAVE_SHIELDS_WEB_CONTENTS_OBSERVER_H_
 
 #include <map>
-#include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
+#include "base/timer/timer.h"
 #include "brave/components/brave_shields/common/brave_shields.mojom.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_receiver_set.h"
@@ -36,9 +38,12 @@ class BraveShieldsWebContentsObserver
   ~BraveShieldsWebContentsObserver() override;
 
   static void RegisterProfilePrefs(PrefRegistrySimple* registry);
+  // |count| is the number of times |subresource| was blocked since the last
+  // event for it.
   static void DispatchBlockedEventForWebContents(
       const std::string& block_type,
       const std::string& subresource,
+      int count,
       content::WebContents* web_contents);
   static void DispatchBlockedEvent(const GURL& request_url,
                                    int frame_tree_node_id,
@@ -48,6 +53,12 @@ class BraveShieldsWebContentsObserver
                         content::WebContents* web_contents);
   bool IsBlockedSubresource(const std::string& subresource);
   void AddBlockedSubresource(const std::string& subresource);
+  // Queues a blocked event for the current page. Queued events are dispatched
+  // together shortly after. Repeats of a block type and subresource that is
+  // still queued are folded into its count instead of being queued again.
+  void QueueBlockedEvent(const std::string& block_type,
+                         const std::string& subresource);
+  void FlushBlockedEvents();
 
  protected:
   // content::WebContentsObserver overrides.
@@ -57,9 +68,13 @@ class BraveShieldsWebContentsObserver
                               content::RenderFrameHost* new_host) override;
   void ReadyToCommitNavigation(
       content::NavigationHandle* navigation_handle) override;
+  void DidFinishNavigation(
+      content::NavigationHandle* navigation_handle) override;
 
   // brave_shields::mojom::BraveShieldsHost.
   void OnJavaScriptBlocked(const std::u16string& details) override;
+  void CreateEphemeralStorageAreas(
+      CreateEphemeralStorageAreasCallback callback) override;
 
  private:
   friend class content::WebContentsUserData<BraveShieldsWebContentsObserver>;
@@ -68,6 +83,12 @@ class BraveShieldsWebContentsObserver
       content::RenderFrameHost*,
       mojo::AssociatedRemote<brave_shields::mojom::BraveShields>>;
 
+  struct BlockedEvent {
+    std::string block_type;
+    std::string subresource;
+    int count;
+  };
+
   // Return an already bound remote for the brave_shields::mojom::BraveShields
   // mojo interface. It is an error to call this method with an invalid |rfh|.
   mojo::AssociatedRemote<brave_shields::mojom::BraveShields>&
@@ -75,8 +96,15 @@ class BraveShieldsWebContentsObserver
 
   std::vector<std::string> allowed_script_origins_;
   // We keep a set of the current page's blocked URLs in case the page
-  // continually tries to load the same blocked URLs.
-  std::set<std::string> blocked_url_paths_;
+  // continually tries to load the same blocked URLs. Only hashes are kept, as
+  // ad-heavy pages block thousands of long URLs.
+  std::unordered_set<size_t> blocked_url_paths_;
+
+  // Blocked events waiting to be dispatched, and their indices in
+  // |pending_blocked_events_| by hash of block type and subresource.
+  std::vector<BlockedEvent> pending_blocked_events_;
+  std::unordered_map<size_t, size_t> pending_blocked_event_indices_;
+  base::OneShotTimer blocked_events_timer_;
 
   content::WebContentsFrameReceiverSet<brave_shields::mojom::BraveShieldsHost>
       brave_shields_receivers_;
@@ -18,6 +18,7 @@ namespace brave_shields {
 void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
     const std::string& block_type,
     const std::string& subresource,
+    int count,
     WebContents* web_contents) {
   if (!web_contents) {
     return;
@@ -30,7 +31,7 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
     tabId = tab->GetAndroidId();
   }
   chrome::android::BraveShieldsContentSettings::DispatchBlockedEvent(
-      tabId, block_type, subresource);
+      tabId, block_type, subresource, count);
 }
 
 }  // namespace brave_shields
@@ -0,0 +1,87 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/brave_shields/shields_settings_tab_helper.h"
+
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/profiles/profile.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/navigation_handle.h"
+#include "content/public/browser/web_contents.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+
+bool IsShieldsSettingsType(ContentSettingsType content_type) {
+  return content_type == ContentSettingsType::BRAVE_SHIELDS ||
+         content_type == ContentSettingsType::BRAVE_ADS ||
+         content_type == ContentSettingsType::BRAVE_HTTP_UPGRADABLE_RESOURCES ||
+         content_type == ContentSettingsType::BRAVE_REFERRERS;
+}
+
+}  // namespace
+
+ShieldsSettingsTabHelper::ShieldsSettingsTabHelper(
+    content::WebContents* web_contents)
+    : content::WebContentsObserver(web_contents),
+      map_(HostContentSettingsMapFactory::GetForProfile(
+          Profile::FromBrowserContext(web_contents->GetBrowserContext()))) {
+  content_settings_observation_.Observe(map_);
+}
+
+ShieldsSettingsTabHelper::~ShieldsSettingsTabHelper() = default;
+
+// static
+scoped_refptr<const ShieldsSettingsSnapshot>
+ShieldsSettingsTabHelper::GetSnapshot(int frame_tree_node_id,
+                                      HostContentSettingsMap* map,
+                                      const GURL& tab_origin) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  content::WebContents* web_contents =
+      content::WebContents::FromFrameTreeNodeId(frame_tree_node_id);
+  ShieldsSettingsTabHelper* helper =
+      web_contents ? FromWebContents(web_contents) : nullptr;
+  if (!helper)
+    return ShieldsSettingsSnapshot::Create(map, tab_origin);
+  return helper->GetOrCreateSnapshot(map, tab_origin);
+}
+
+scoped_refptr<const ShieldsSettingsSnapshot>
+ShieldsSettingsTabHelper::GetOrCreateSnapshot(HostContentSettingsMap* map,
+                                              const GURL& tab_origin) {
+  // Only cache settings read from this tab's own profile.
+  if (map != map_)
+    return ShieldsSettingsSnapshot::Create(map, tab_origin);
+  // Requests of the previous page can still arrive while a navigation is
+  // pending, so only the origin decides whether the snapshot is reusable.
+  if (!snapshot_ || snapshot_->tab_origin() != tab_origin)
+    snapshot_ = ShieldsSettingsSnapshot::Create(map_, tab_origin);
+  return snapshot_;
+}
+
+void ShieldsSettingsTabHelper::DidFinishNavigation(
+    content::NavigationHandle* navigation_handle) {
+  if (!navigation_handle->IsInMainFrame() ||
+      !navigation_handle->HasCommitted() ||
+      navigation_handle->IsSameDocument()) {
+    return;
+  }
+  snapshot_ = ShieldsSettingsSnapshot::Create(
+      map_, navigation_handle->GetURL().GetOrigin());
+}
+
+void ShieldsSettingsTabHelper::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type) {
+  if (IsShieldsSettingsType(content_type))
+    snapshot_ = nullptr;
+}
+
+WEB_CONTENTS_USER_DATA_KEY_IMPL(ShieldsSettingsTabHelper)
+
+}  // namespace brave_shields
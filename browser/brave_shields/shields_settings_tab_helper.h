@@ -0,0 +1,69 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_BRAVE_SHIELDS_SHIELDS_SETTINGS_TAB_HELPER_H_
+#define BRAVE_BROWSER_BRAVE_SHIELDS_SHIELDS_SETTINGS_TAB_HELPER_H_
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/scoped_observation.h"
+#include "brave/components/brave_shields/browser/shields_settings_snapshot.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "content/public/browser/web_contents_user_data.h"
+
+class GURL;
+
+namespace brave_shields {
+
+// Keeps the shields settings snapshot of the tab's current origin so that
+// subresource requests don't each query HostContentSettingsMap. The snapshot
+// is rebuilt when a main frame navigation commits and dropped whenever a
+// shields content setting changes.
+class ShieldsSettingsTabHelper
+    : public content::WebContentsObserver,
+      public content::WebContentsUserData<ShieldsSettingsTabHelper>,
+      public content_settings::Observer {
+ public:
+  ~ShieldsSettingsTabHelper() override;
+
+  // Returns the settings for |tab_origin|, reusing the snapshot of the tab
+  // that |frame_tree_node_id| belongs to when it matches.
+  static scoped_refptr<const ShieldsSettingsSnapshot> GetSnapshot(
+      int frame_tree_node_id,
+      HostContentSettingsMap* map,
+      const GURL& tab_origin);
+
+ private:
+  friend class content::WebContentsUserData<ShieldsSettingsTabHelper>;
+
+  explicit ShieldsSettingsTabHelper(content::WebContents* web_contents);
+
+  scoped_refptr<const ShieldsSettingsSnapshot> GetOrCreateSnapshot(
+      HostContentSettingsMap* map,
+      const GURL& tab_origin);
+
+  // content::WebContentsObserver overrides.
+  void DidFinishNavigation(
+      content::NavigationHandle* navigation_handle) override;
+
+  // content_settings::Observer overrides.
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type) override;
+
+  HostContentSettingsMap* map_;
+  scoped_refptr<const ShieldsSettingsSnapshot> snapshot_;
+  base::ScopedObservation<HostContentSettingsMap, content_settings::Observer>
+      content_settings_observation_{this};
+
+  WEB_CONTENTS_USER_DATA_KEY_DECL();
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettingsTabHelper);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_BROWSER_BRAVE_SHIELDS_SHIELDS_SETTINGS_TAB_HELPER_H_
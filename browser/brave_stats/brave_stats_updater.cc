@@ -5,10 +5,12 @@
 
 #include "brave/browser/brave_stats/brave_stats_updater.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/barrier_closure.h"
 #include "base/command_line.h"
+#include "base/rand_util.h"
 #include "base/system/sys_info.h"
 #include "bat/ads/pref_names.h"
 #include "brave/browser/brave_stats/brave_stats_updater_params.h"
@@ -52,10 +54,14 @@ BraveStatsUpdater::StatsUpdatedCallback* g_testing_stats_threshold_callback =
 // Ping the update server shortly after startup.
 static constexpr int kUpdateServerStartupPingDelaySeconds = 3;
 
-// Every five minutes, check if we need to ping the update server for
-// today.
+// Until the update server was pinged today, check every five minutes if we
+// need to ping it.
 static constexpr int kUpdateServerPeriodicPingFrequencySeconds = 5 * 60;
 
+// Once it was, wait for the next day, but wake up at least this often, as
+// the timer may not advance while the machine sleeps.
+static constexpr int kUpdateServerMaxPeriodicPingDelaySeconds = 60 * 60;
+
 static constexpr int kMinimumUsageThreshold = 3;
 
 GURL GetUpdateURL(
@@ -153,11 +159,34 @@ void BraveStatsUpdater::Start() {
 
   // Periodic timer.
   DCHECK(!server_ping_periodic_timer_);
-  server_ping_periodic_timer_ = std::make_unique<base::RepeatingTimer>();
+  server_ping_periodic_timer_ = std::make_unique<base::OneShotTimer>();
+  SchedulePeriodicPing();
+}
+
+void BraveStatsUpdater::SchedulePeriodicPing() {
+  const base::Time now = base::Time::Now();
+  base::TimeDelta delay =
+      base::TimeDelta::FromSeconds(kUpdateServerPeriodicPingFrequencySeconds);
+  if (base::CompareCaseInsensitiveASCII(
+          brave_stats::GetDateAsYMD(now),
+          pref_service_->GetString(kLastCheckYMD)) == 0) {
+    // Jitter the first check of the day, so that clients don't all ping the
+    // server right at midnight. Around DST changes, adding a day may not
+    // reach tomorrow, so never wait less than the regular period.
+    const base::TimeDelta until_tomorrow =
+        (now + base::TimeDelta::FromDays(1)).LocalMidnight() - now +
+        delay * base::RandDouble();
+    const base::TimeDelta max_delay = base::TimeDelta::FromSeconds(
+        kUpdateServerMaxPeriodicPingDelaySeconds);
+    delay = std::max(delay, std::min(until_tomorrow, max_delay));
+  }
   server_ping_periodic_timer_->Start(
-      FROM_HERE,
-      base::TimeDelta::FromSeconds(kUpdateServerPeriodicPingFrequencySeconds),
-      this, &BraveStatsUpdater::OnServerPingTimerFired);
+      FROM_HERE, delay, this, &BraveStatsUpdater::OnPeriodicPingTimerFired);
+}
+
+void BraveStatsUpdater::OnPeriodicPingTimerFired() {
+  OnServerPingTimerFired();
+  SchedulePeriodicPing();
 }
 
 void BraveStatsUpdater::Stop() {
@@ -69,6 +69,8 @@ class BraveStatsUpdater : public ProfileManagerObserver {
 
   // Invoked when server ping timer fires.
   void OnServerPingTimerFired();
+  void OnPeriodicPingTimerFired();
+  void SchedulePeriodicPing();
 
   // Invoked after browser has initialized with referral server.
   void OnReferralInitialization();
@@ -96,7 +98,7 @@ class BraveStatsUpdater : public ProfileManagerObserver {
   std::string usage_server_;
   std::unique_ptr<network::SimpleURLLoader> simple_url_loader_;
   std::unique_ptr<base::OneShotTimer> server_ping_startup_timer_;
-  std::unique_ptr<base::RepeatingTimer> server_ping_periodic_timer_;
+  std::unique_ptr<base::OneShotTimer> server_ping_periodic_timer_;
   std::unique_ptr<PrefChangeRegistrar> pref_change_registrar_;
   base::RepeatingClosure stats_preconditions_barrier_;
 
@@ -7,8 +7,10 @@
 
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "brave/browser/brave_ads/ads_service_factory.h"
 #include "brave/browser/brave_ads/ads_tab_helper.h"
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
+#include "brave/browser/brave_shields/shields_settings_tab_helper.h"
 #include "brave/browser/brave_stats/brave_stats_tab_helper.h"
 #include "brave/browser/ephemeral_storage/ephemeral_storage_tab_helper.h"
 #include "brave/browser/ui/bookmark/brave_bookmark_tab_helper.h"
@@ -19,6 +21,7 @@
 #include "brave/components/ipfs/buildflags/buildflags.h"
 #include "brave/components/speedreader/buildflags.h"
 #include "brave/components/tor/buildflags/buildflags.h"
+#include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/web_contents.h"
 #include "net/base/features.h"
@@ -34,6 +37,7 @@
 #endif
 
 #if BUILDFLAG(BRAVE_REWARDS_ENABLED)
+#include "brave/browser/brave_rewards/rewards_service_factory.h"
 #include "brave/browser/brave_rewards/rewards_tab_helper.h"
 #endif
 
@@ -66,11 +70,15 @@
 namespace brave {
 
 void AttachTabHelpers(content::WebContents* web_contents) {
+  Profile* profile =
+      Profile::FromBrowserContext(web_contents->GetBrowserContext());
+
 #if BUILDFLAG(ENABLE_GREASELION)
   greaselion::GreaselionTabHelper::CreateForWebContents(web_contents);
 #endif
   brave_shields::BraveShieldsWebContentsObserver::CreateForWebContents(
       web_contents);
+  brave_shields::ShieldsSettingsTabHelper::CreateForWebContents(web_contents);
 
 #if defined(OS_ANDROID)
   DesktopModeTabHelper::CreateForWebContents(web_contents);
@@ -80,8 +88,12 @@ void AttachTabHelpers(content::WebContents* web_contents) {
   BraveBookmarkTabHelper::CreateForWebContents(web_contents);
 #endif
 
+  // The rewards and ads helpers only forward tab events to their services,
+  // which don't exist for private, Tor and guest profiles. Don't attach them,
+  // and their browser list observers, to tabs there.
 #if BUILDFLAG(BRAVE_REWARDS_ENABLED)
-  brave_rewards::RewardsTabHelper::CreateForWebContents(web_contents);
+  if (brave_rewards::RewardsServiceFactory::GetForProfile(profile))
+    brave_rewards::RewardsTabHelper::CreateForWebContents(web_contents);
 #endif
 
 #if BUILDFLAG(ENABLE_WIDEVINE)
@@ -97,7 +109,8 @@ void AttachTabHelpers(content::WebContents* web_contents) {
       web_contents);
 #endif
 
-  brave_ads::AdsTabHelper::CreateForWebContents(web_contents);
+  if (brave_ads::AdsServiceFactory::GetForProfile(profile))
+    brave_ads::AdsTabHelper::CreateForWebContents(web_contents);
 
 #if BUILDFLAG(ENABLE_SPEEDREADER)
   speedreader::SpeedreaderTabHelper::CreateForWebContents(web_contents);
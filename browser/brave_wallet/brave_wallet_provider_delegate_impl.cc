@@ -6,6 +6,7 @@
 #include "brave/browser/brave_wallet/brave_wallet_provider_delegate_impl.h"
 #include "brave/browser/ui/browser_commands.h"
 #include "chrome/browser/ui/browser_finder.h"
+#include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/web_contents.h"
 
 namespace brave_wallet {
@@ -19,4 +20,8 @@ void BraveWalletProviderDelegateImpl::ShowConnectToSiteUI() {
   brave::ShowWalletBubble(browser);
 }
 
+url::Origin BraveWalletProviderDelegateImpl::GetOrigin() const {
+  return web_contents_->GetMainFrame()->GetLastCommittedOrigin();
+}
+
 }  // namespace brave_wallet
@@ -24,6 +24,7 @@ class BraveWalletProviderDelegateImpl : public BraveWalletProviderDelegate {
   ~BraveWalletProviderDelegateImpl() override = default;
 
   void ShowConnectToSiteUI() override;
+  url::Origin GetOrigin() const override;
 
  private:
   content::WebContents* web_contents_;
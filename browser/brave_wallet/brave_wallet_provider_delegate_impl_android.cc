@@ -4,13 +4,19 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "brave/browser/brave_wallet/brave_wallet_provider_delegate_impl_android.h"
+#include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/web_contents.h"
 
 namespace brave_wallet {
 
 BraveWalletProviderDelegateImplAndroid::BraveWalletProviderDelegateImplAndroid(
-    content::WebContents* web_contents) {}
+    content::WebContents* web_contents)
+    : web_contents_(web_contents) {}
 
 void BraveWalletProviderDelegateImplAndroid::ShowConnectToSiteUI() {}
 
+url::Origin BraveWalletProviderDelegateImplAndroid::GetOrigin() const {
+  return web_contents_->GetMainFrame()->GetLastCommittedOrigin();
+}
+
 }  // namespace brave_wallet
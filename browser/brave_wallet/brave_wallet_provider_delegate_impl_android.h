@@ -26,6 +26,10 @@ class BraveWalletProviderDelegateImplAndroid
   ~BraveWalletProviderDelegateImplAndroid() override = default;
 
   void ShowConnectToSiteUI() override;
+  url::Origin GetOrigin() const override;
+
+ private:
+  content::WebContents* web_contents_;
 };
 
 }  // namespace brave_wallet
@@ -50,6 +50,12 @@ void BraveComponentUpdaterDelegate::OnDemandUpdate(
   BraveOnDemandUpdater::GetInstance()->OnDemandUpdate(component_id);
 }
 
+void BraveComponentUpdaterDelegate::OnDemandUpdateAfterStartup(
+    const std::string& component_id) {
+  BraveOnDemandUpdater::GetInstance()->OnDemandUpdateAfterStartup(
+      component_id);
+}
+
 void BraveComponentUpdaterDelegate::AddObserver(ComponentObserver* observer) {
   g_browser_process->component_updater()->AddObserver(observer);
 }
@@ -35,6 +35,7 @@ class BraveComponentUpdaterDelegate : public BraveComponent::Delegate {
                 BraveComponent::ReadyCallback ready_callback) override;
   bool Unregister(const std::string& component_id) override;
   void OnDemandUpdate(const std::string& component_id) override;
+  void OnDemandUpdateAfterStartup(const std::string& component_id) override;
 
   void AddObserver(ComponentObserver* observer) override;
   void RemoveObserver(ComponentObserver* observer) override;
@@ -369,6 +369,80 @@ IN_PROC_BROWSER_TEST_F(EphemeralStorageBrowserTest,
   EXPECT_EQ("", values_after.iframe_2.cookies);
 }
 
+IN_PROC_BROWSER_TEST_F(EphemeralStorageBrowserTest,
+                       ClosingTabKeepsLocalStorageOfOtherTabs) {
+  WebContents* site_a_tab1 = LoadURLInNewTab(a_site_ephemeral_storage_url_);
+  WebContents* site_a_tab2 = LoadURLInNewTab(a_site_ephemeral_storage_url_);
+  EXPECT_EQ(browser()->tab_strip_model()->count(), 3);
+
+  // Only the first tab uses third-party storage, the second one never did.
+  SetValuesInFrames(site_a_tab1, "a.com value", "from=a.com");
+
+  int tab_index =
+      browser()->tab_strip_model()->GetIndexOfWebContents(site_a_tab1);
+  bool was_closed = browser()->tab_strip_model()->CloseWebContentsAt(
+      tab_index, TabStripModel::CloseTypes::CLOSE_NONE);
+  EXPECT_TRUE(was_closed);
+
+  // The second tab is still on the same domain, so its first access still
+  // finds the local storage the closed tab wrote.
+  ValuesFromFrames values = GetValuesFromFrames(site_a_tab2);
+  EXPECT_EQ("a.com value", values.main_frame.local_storage);
+  EXPECT_EQ("a.com value", values.iframe_1.local_storage);
+  EXPECT_EQ("a.com value", values.iframe_2.local_storage);
+
+  EXPECT_EQ(nullptr, values.main_frame.session_storage);
+  EXPECT_EQ(nullptr, values.iframe_1.session_storage);
+  EXPECT_EQ(nullptr, values.iframe_2.session_storage);
+
+  EXPECT_EQ("from=a.com", values.iframe_1.cookies);
+  EXPECT_EQ("from=a.com", values.iframe_2.cookies);
+
+  // Closing the last tab of the domain clears it.
+  tab_index = browser()->tab_strip_model()->GetIndexOfWebContents(site_a_tab2);
+  was_closed = browser()->tab_strip_model()->CloseWebContentsAt(
+      tab_index, TabStripModel::CloseTypes::CLOSE_NONE);
+  EXPECT_TRUE(was_closed);
+
+  ui_test_utils::NavigateToURL(browser(), a_site_ephemeral_storage_url_);
+  auto* web_contents = browser()->tab_strip_model()->GetActiveWebContents();
+  ValuesFromFrames values_after = GetValuesFromFrames(web_contents);
+  EXPECT_EQ(nullptr, values_after.iframe_1.local_storage);
+  EXPECT_EQ(nullptr, values_after.iframe_2.local_storage);
+}
+
+IN_PROC_BROWSER_TEST_F(EphemeralStorageBrowserTest,
+                       FirstStorageAccessAfterNavigation) {
+  ui_test_utils::NavigateToURL(browser(), a_site_ephemeral_storage_url_);
+  auto* web_contents = browser()->tab_strip_model()->GetActiveWebContents();
+  SetValuesInFrames(web_contents, "a.com value", "from=a.com");
+
+  // The storage areas of c.com don't exist until a third-party frame of the
+  // new page accesses storage, which has to find them empty and then keep
+  // what it writes.
+  ui_test_utils::NavigateToURL(browser(), c_site_ephemeral_storage_url_);
+  RenderFrameHost* main_frame = web_contents->GetMainFrame();
+  RenderFrameHost* iframe_1 = content::ChildFrameAt(main_frame, 0);
+  RenderFrameHost* iframe_2 = content::ChildFrameAt(main_frame, 1);
+  EXPECT_EQ(nullptr, GetStorageValueInFrame(iframe_1, StorageType::Local));
+  EXPECT_EQ(nullptr, GetStorageValueInFrame(iframe_1, StorageType::Session));
+
+  SetStorageValueInFrame(iframe_1, "c.com value", StorageType::Local);
+  SetStorageValueInFrame(iframe_1, "c.com value", StorageType::Session);
+  EXPECT_EQ("c.com value",
+            GetStorageValueInFrame(iframe_2, StorageType::Local));
+  EXPECT_EQ("c.com value",
+            GetStorageValueInFrame(iframe_2, StorageType::Session));
+
+  // Within the keep-alive, going back finds the values of a.com again.
+  ui_test_utils::NavigateToURL(browser(), a_site_ephemeral_storage_url_);
+  ValuesFromFrames values = GetValuesFromFrames(web_contents);
+  EXPECT_EQ("a.com value", values.iframe_1.local_storage);
+  EXPECT_EQ("a.com value", values.iframe_2.local_storage);
+  EXPECT_EQ(nullptr, values.iframe_1.session_storage);
+  EXPECT_EQ(nullptr, values.iframe_2.session_storage);
+}
+
 IN_PROC_BROWSER_TEST_F(EphemeralStorageBrowserTest,
                        ReloadDoesNotClearEphemeralStorage) {
   ui_test_utils::NavigateToURL(browser(), a_site_ephemeral_storage_url_);
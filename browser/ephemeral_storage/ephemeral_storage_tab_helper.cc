@@ -10,8 +10,8 @@
 
 #include "base/feature_list.h"
 #include "base/hash/md5.h"
+#include "base/optional.h"
 #include "base/ranges/ranges.h"
-#include "base/threading/sequenced_task_runner_handle.h"
 #include "content/public/browser/navigation_handle.h"
 #include "content/public/browser/session_storage_namespace.h"
 #include "content/public/browser/storage_partition.h"
@@ -66,8 +66,9 @@ EphemeralStorageTabHelper::EphemeralStorageTabHelper(WebContents* web_contents)
 EphemeralStorageTabHelper::~EphemeralStorageTabHelper() {}
 
 void EphemeralStorageTabHelper::WebContentsDestroyed() {
+  keep_alive_timer_.Stop();
+  keep_alive_expirations_.clear();
   keep_alive_tld_ephemeral_lifetime_list_.clear();
-  keep_alive_local_storage_list_.clear();
 }
 
 void EphemeralStorageTabHelper::ReadyToCommitNavigation(
@@ -86,13 +87,15 @@ void EphemeralStorageTabHelper::ReadyToCommitNavigation(
     return;
 
   CreateEphemeralStorageAreasForDomainAndURL(new_domain, new_url);
+
+  // A page restored from the back-forward cache doesn't ask for the storage
+  // areas again, as its frames did so before being cached.
+  if (navigation_handle->IsServedFromBackForwardCache())
+    EnsureEphemeralStorageAreas();
 }
 
 void EphemeralStorageTabHelper::ClearEphemeralLifetimeKeepalive(
     const content::TLDEphemeralLifetimeKey& key) {
-  ClearLocalStorageKeepAlive(
-      StringToSessionStorageId(key.second, kLocalStorageSuffix));
-
   auto it = base::ranges::find_if(keep_alive_tld_ephemeral_lifetime_list_,
                                   [&key](const auto& tld_ephermal_liftime) {
                                     return tld_ephermal_liftime->key() == key;
@@ -101,13 +104,21 @@ void EphemeralStorageTabHelper::ClearEphemeralLifetimeKeepalive(
     keep_alive_tld_ephemeral_lifetime_list_.erase(it);
 }
 
-void EphemeralStorageTabHelper::ClearLocalStorageKeepAlive(
-    const std::string& id) {
-  auto it = base::ranges::find_if(
-      keep_alive_local_storage_list_,
-      [&id](const auto& local_storage) { return local_storage->id() == id; });
-  if (it != keep_alive_local_storage_list_.end())
-    keep_alive_local_storage_list_.erase(it);
+void EphemeralStorageTabHelper::OnKeepAliveTimer() {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  while (!keep_alive_expirations_.empty() &&
+         keep_alive_expirations_.front().first <= now) {
+    const content::TLDEphemeralLifetimeKey key =
+        std::move(keep_alive_expirations_.front().second);
+    keep_alive_expirations_.pop_front();
+    ClearEphemeralLifetimeKeepalive(key);
+  }
+
+  if (!keep_alive_expirations_.empty()) {
+    keep_alive_timer_.Start(
+        FROM_HERE, keep_alive_expirations_.front().first - now, this,
+        &EphemeralStorageTabHelper::OnKeepAliveTimer);
+  }
 }
 
 void EphemeralStorageTabHelper::CreateEphemeralStorageAreasForDomainAndURL(
@@ -126,57 +137,87 @@ void EphemeralStorageTabHelper::CreateEphemeralStorageAreasForDomainAndURL(
           net::features::kBraveEphemeralStorageKeepAlive) &&
       tld_ephemeral_lifetime_) {
     keep_alive_tld_ephemeral_lifetime_list_.push_back(tld_ephemeral_lifetime_);
-    keep_alive_local_storage_list_.push_back(local_storage_namespace_);
 
     // keep the ephemeral storage alive for some time to handle redirects
     // including meta refresh or other page driven "redirects" that end up back
     // at the original origin
-    base::SequencedTaskRunnerHandle::Get()->PostDelayedTask(
-        FROM_HERE,
-        base::BindOnce(
-            &EphemeralStorageTabHelper::ClearEphemeralLifetimeKeepalive,
-            weak_factory_.GetWeakPtr(), tld_ephemeral_lifetime_->key()),
+    const base::TimeDelta keep_alive =
         g_storage_keep_alive_for_testing.is_min()
             ? base::TimeDelta::FromSeconds(
                   net::features::kBraveEphemeralStorageKeepAliveTimeInSeconds
                       .Get())
-            : g_storage_keep_alive_for_testing);
+            : g_storage_keep_alive_for_testing;
+    keep_alive_expirations_.emplace_back(base::TimeTicks::Now() + keep_alive,
+                                         tld_ephemeral_lifetime_->key());
+    if (!keep_alive_timer_.IsRunning()) {
+      keep_alive_timer_.Start(FROM_HERE, keep_alive, this,
+                              &EphemeralStorageTabHelper::OnKeepAliveTimer);
+    }
   }
 
-  // This will fetch a session storage namespace for this storage partition
-  // and storage domain. If another tab helper is already using the same
-  // namespace, this will just give us a new reference. When the last tab helper
-  // drops the reference, the namespace should be deleted.
-  std::string local_partition_id =
-      StringToSessionStorageId(new_domain, kLocalStorageSuffix);
-  local_storage_namespace_ = content::CreateSessionStorageNamespace(
-      partition, local_partition_id, base::nullopt);
-
-  // Session storage is always per-tab and never per-TLD, so we always delete
-  // and recreate the session storage when switching domains.
+  // The storage areas of the previous domain are released here and the ones
+  // of the new domain are only created when a third-party frame needs them.
   //
-  // We need to explicitly release the storage namespace before recreating a
-  // new one in order to make sure that we remove the final reference and free
-  // it.
+  // Session storage is always per-tab and never per-TLD, so we always delete
+  // and recreate the session storage when switching domains. We need to
+  // explicitly release the storage namespace before recreating a new one in
+  // order to make sure that we remove the final reference and free it.
   session_storage_namespace_.reset();
+  storage_domain_ = new_domain;
+  storage_url_ = new_url;
+
+  // Ephemeral cookies are not created through this class, so the lifetime
+  // which clears them has to exist for every domain. It also holds the
+  // domain's local storage, so tabs which haven't used it yet keep it alive
+  // for the ones which have.
+  tld_ephemeral_lifetime_ = content::TLDEphemeralLifetime::GetOrCreate(
+      browser_context, partition, new_domain);
+
+  // A cloned session storage has to be copied from the opener when the tab is
+  // set up rather than when it is first used.
+  // https://html.spec.whatwg.org/multipage/browsers.html#copy-session-storage
+  if (web_contents()->GetOpener())
+    EnsureEphemeralStorageAreas();
+}
+
+void EphemeralStorageTabHelper::EnsureEphemeralStorageAreas() {
+  if (storage_url_.is_empty() || session_storage_namespace_)
+    return;
+  DCHECK(tld_ephemeral_lifetime_);
+
+  auto* browser_context = web_contents()->GetBrowserContext();
+  auto site_instance =
+      content::SiteInstance::CreateForURL(browser_context, storage_url_);
+  auto* partition =
+      BrowserContext::GetStoragePartition(browser_context, site_instance.get());
+
+  // The first tab of the storage domain which needs local storage creates it
+  // for all of them. When the last tab leaves the domain, the lifetime and
+  // with it the namespace are deleted.
+  if (!tld_ephemeral_lifetime_->local_storage_namespace()) {
+    std::string local_partition_id =
+        StringToSessionStorageId(storage_domain_, kLocalStorageSuffix);
+    tld_ephemeral_lifetime_->SetLocalStorageNamespace(
+        content::CreateSessionStorageNamespace(partition, local_partition_id,
+                                               base::nullopt));
+  }
 
   std::string session_partition_id = StringToSessionStorageId(
       content::GetSessionStorageNamespaceId(web_contents()),
       kSessionStorageSuffix);
 
-  auto* rfh = web_contents()->GetOpener();
+  // clone the namespace if there is an opener which has one
+  base::Optional<std::string> clone_from_namespace_id;
+  if (auto* rfh = web_contents()->GetOpener()) {
+    WebContents* opener = WebContents::FromRenderFrameHost(rfh);
+    auto* opener_tab_helper = FromWebContents(opener);
+    if (opener_tab_helper && opener_tab_helper->session_storage_namespace_) {
+      clone_from_namespace_id = StringToSessionStorageId(
+          content::GetSessionStorageNamespaceId(opener), kSessionStorageSuffix);
+    }
+  }
   session_storage_namespace_ = content::CreateSessionStorageNamespace(
-      partition, session_partition_id,
-      // clone the namespace if there is an opener
-      // https://html.spec.whatwg.org/multipage/browsers.html#copy-session-storage
-      rfh ? base::make_optional<std::string>(StringToSessionStorageId(
-                content::GetSessionStorageNamespaceId(
-                    WebContents::FromRenderFrameHost(rfh)),
-                kSessionStorageSuffix))
-          : base::nullopt);
-
-  tld_ephemeral_lifetime_ = content::TLDEphemeralLifetime::GetOrCreate(
-      browser_context, partition, new_domain);
+      partition, session_partition_id, std::move(clone_from_namespace_id));
 }
 
 // static
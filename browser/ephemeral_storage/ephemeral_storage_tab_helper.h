@@ -10,11 +10,14 @@
 #include <utility>
 #include <vector>
 
-#include "base/memory/weak_ptr.h"
+#include "base/containers/circular_deque.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/session_storage_namespace.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
+#include "url/gurl.h"
 
 namespace content {
 class BrowserContext;
@@ -28,6 +31,11 @@ namespace ephemeral_storage {
 // iframes. This storage is partitioned based on the origin of the TLD
 // of the main frame. When no more tabs are open with a particular origin,
 // this storage is cleared.
+//
+// The localStorage and sessionStorage areas are only created once a
+// third-party frame of the tab accesses storage, see
+// |EnsureEphemeralStorageAreas|. The localStorage area is then owned by the
+// TLDEphemeralLifetime, which every tab of the storage domain holds.
 class EphemeralStorageTabHelper
     : public content::WebContentsObserver,
       public content::WebContentsUserData<EphemeralStorageTabHelper> {
@@ -37,6 +45,11 @@ class EphemeralStorageTabHelper
 
   static void SetKeepAliveTimeDelayForTesting(const base::TimeDelta& time);
 
+  // Creates the ephemeral localStorage and sessionStorage areas for the main
+  // frame's storage domain, if they don't exist yet. Called before a
+  // third-party frame of a new document first binds to them.
+  void EnsureEphemeralStorageAreas();
+
  private:
   // WebContentsObserver
   void ReadyToCommitNavigation(
@@ -45,22 +58,29 @@ class EphemeralStorageTabHelper
 
   void ClearEphemeralLifetimeKeepalive(
       const content::TLDEphemeralLifetimeKey& key);
-  void ClearLocalStorageKeepAlive(const std::string& id);
+  void OnKeepAliveTimer();
 
   void CreateEphemeralStorageAreasForDomainAndURL(const std::string& new_domain,
                                                   const GURL& new_url);
 
   friend class content::WebContentsUserData<EphemeralStorageTabHelper>;
-  scoped_refptr<content::SessionStorageNamespace> local_storage_namespace_;
+  // The storage domain of the main frame, and the URL it was derived from,
+  // which the storage areas are created for.
+  std::string storage_domain_;
+  GURL storage_url_;
   scoped_refptr<content::SessionStorageNamespace> session_storage_namespace_;
   scoped_refptr<content::TLDEphemeralLifetime> tld_ephemeral_lifetime_;
 
+  // Also keeps the local storage of the domains alive.
   std::vector<scoped_refptr<content::TLDEphemeralLifetime>>
       keep_alive_tld_ephemeral_lifetime_list_;
-  std::vector<scoped_refptr<content::SessionStorageNamespace>>
-      keep_alive_local_storage_list_;
 
-  base::WeakPtrFactory<EphemeralStorageTabHelper> weak_factory_{this};
+  // When each kept alive storage area may be released, oldest first. One timer
+  // runs for the earliest of them rather than a task per navigation.
+  base::circular_deque<
+      std::pair<base::TimeTicks, content::TLDEphemeralLifetimeKey>>
+      keep_alive_expirations_;
+  base::OneShotTimer keep_alive_timer_;
 
   WEB_CONTENTS_USER_DATA_KEY_DECL();
 };
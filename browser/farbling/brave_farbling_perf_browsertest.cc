@@ -0,0 +1,145 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+
+#include "base/path_service.h"
+#include "base/strings/stringprintf.h"
+#include "brave/browser/brave_content_browser_client.h"
+#include "brave/common/brave_paths.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/common/chrome_content_client.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "net/dns/mock_host_resolver.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// These tests measure the cost of the fingerprinting workloads which farbling
+// intercepts, at every farbling level, so that the levels can be compared
+// with each other and with unfarbled (OFF) results. They are disabled as they
+// only report timings; run them with --gtest_also_run_disabled_tests and
+// --gtest_filter=BraveFarblingPerfBrowserTest.*
+
+using brave_shields::ControlType;
+
+namespace {
+
+const char kEmbeddedTestServerDirectory[] = "farbling_perf";
+const char kMetricPrefix[] = "BraveFarbling.";
+const char kDurationMetric[] = ".duration";
+
+constexpr int kCanvasIterations = 50;
+constexpr int kAnalyserIterations = 1000;
+constexpr int kPluginIterations = 1000;
+
+const struct {
+  ControlType control_type;
+  const char* story;
+} kFarblingLevels[] = {
+    {ControlType::ALLOW, "off"},
+    {ControlType::DEFAULT, "balanced"},
+    {ControlType::BLOCK, "maximum"},
+};
+
+}  // namespace
+
+class BraveFarblingPerfBrowserTest : public InProcessBrowserTest {
+ public:
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+
+    content_client_.reset(new ChromeContentClient);
+    content::SetContentClient(content_client_.get());
+    browser_content_client_.reset(new BraveContentBrowserClient());
+    content::SetBrowserClientForTesting(browser_content_client_.get());
+
+    host_resolver()->AddRule("*", "127.0.0.1");
+
+    brave::RegisterPathProvider();
+    base::FilePath test_data_dir;
+    base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
+    test_data_dir = test_data_dir.AppendASCII(kEmbeddedTestServerDirectory);
+    embedded_test_server()->ServeFilesFromDirectory(test_data_dir);
+
+    ASSERT_TRUE(embedded_test_server()->Start());
+
+    top_level_page_url_ = embedded_test_server()->GetURL("a.com", "/");
+    workloads_url_ = embedded_test_server()->GetURL("a.com", "/workloads.html");
+  }
+
+  void TearDown() override {
+    browser_content_client_.reset();
+    content_client_.reset();
+  }
+
+  HostContentSettingsMap* content_settings() {
+    return HostContentSettingsMapFactory::GetForProfile(browser()->profile());
+  }
+
+  content::WebContents* contents() {
+    return browser()->tab_strip_model()->GetActiveWebContents();
+  }
+
+  // Runs |script| at every farbling level and reports the number of
+  // milliseconds it returns as |metric|.
+  void MeasureWorkload(const std::string& metric, const std::string& script) {
+    for (const auto& level : kFarblingLevels) {
+      brave_shields::SetFingerprintingControlType(
+          content_settings(), level.control_type, top_level_page_url_);
+      // A fresh document for every level, so no farbled state carries over.
+      ui_test_utils::NavigateToURL(browser(), workloads_url_);
+      ASSERT_TRUE(content::WaitForLoadStop(contents()));
+
+      const double duration =
+          content::EvalJs(contents(), script).ExtractDouble();
+      ASSERT_GE(duration, 0);
+
+      perf_test::PerfResultReporter reporter(kMetricPrefix + metric,
+                                             level.story);
+      reporter.RegisterImportantMetric(kDurationMetric, "ms");
+      reporter.AddResult(kDurationMetric, duration);
+    }
+  }
+
+ private:
+  GURL top_level_page_url_;
+  GURL workloads_url_;
+  std::unique_ptr<ChromeContentClient> content_client_;
+  std::unique_ptr<BraveContentBrowserClient> browser_content_client_;
+};
+
+IN_PROC_BROWSER_TEST_F(BraveFarblingPerfBrowserTest,
+                       DISABLED_SmallCanvasToDataURL) {
+  // The default canvas size, as used by most fingerprinting scripts.
+  MeasureWorkload("SmallCanvasToDataURL",
+                  base::StringPrintf("canvasToDataURL(300, 150, %d)",
+                                     kCanvasIterations));
+}
+
+IN_PROC_BROWSER_TEST_F(BraveFarblingPerfBrowserTest,
+                       DISABLED_LargeCanvasToDataURL) {
+  MeasureWorkload("LargeCanvasToDataURL",
+                  base::StringPrintf("canvasToDataURL(1920, 1080, %d)",
+                                     kCanvasIterations));
+}
+
+IN_PROC_BROWSER_TEST_F(BraveFarblingPerfBrowserTest,
+                       DISABLED_AnalyserGetFloatFrequencyData) {
+  MeasureWorkload("AnalyserGetFloatFrequencyData",
+                  base::StringPrintf("analyserFloatFrequencyData(%d)",
+                                     kAnalyserIterations));
+}
+
+IN_PROC_BROWSER_TEST_F(BraveFarblingPerfBrowserTest,
+                       DISABLED_EnumeratePlugins) {
+  MeasureWorkload(
+      "EnumeratePlugins",
+      base::StringPrintf("enumeratePlugins(%d)", kPluginIterations));
+}
@@ -23,6 +23,7 @@
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/extension_registry.h"
 #include "net/dns/mock_host_resolver.h"
 #include "ui/base/ui_base_switches.h"
 
@@ -364,6 +365,38 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, IsNotGreaselionExtension) {
   EXPECT_FALSE(greaselion_service->IsGreaselionExtension("INVALID"));
 }
 
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
+                       UpdateWithUnchangedRulesKeepsExtensions) {
+  ASSERT_TRUE(InstallMockExtension());
+
+  GreaselionService* greaselion_service =
+      GreaselionServiceFactory::GetForBrowserContext(profile());
+  ASSERT_TRUE(greaselion_service);
+  extensions::ExtensionRegistry* registry =
+      extensions::ExtensionRegistry::Get(profile());
+
+  const auto extension_ids = greaselion_service->GetExtensionIdsForTesting();
+  ASSERT_GT(extension_ids.size(), 0UL);
+  std::vector<const extensions::Extension*> extensions;
+  for (const auto& id : extension_ids) {
+    const extensions::Extension* extension =
+        registry->enabled_extensions().GetByID(id);
+    ASSERT_TRUE(extension);
+    extensions.push_back(extension);
+  }
+
+  // The rules hash the same as before, so nothing is unloaded or converted
+  // again.
+  greaselion_service->UpdateInstalledExtensions();
+  GreaselionServiceWaiter(greaselion_service).Wait();
+
+  EXPECT_EQ(extension_ids, greaselion_service->GetExtensionIdsForTesting());
+  for (size_t i = 0; i < extension_ids.size(); i++) {
+    EXPECT_EQ(extensions[i],
+              registry->enabled_extensions().GetByID(extension_ids[i]));
+  }
+}
+
 
 IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
                       ScriptInjectionWithBrowserVersionConditionLowWild) {
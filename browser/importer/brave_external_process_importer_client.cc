@@ -99,6 +99,36 @@ void BraveExternalProcessImporterClient::OnImportItemFinished(
   brave_profile_import_->ReportImportItemFinished(import_item);
 }
 
+void BraveExternalProcessImporterClient::OnHistoryImportStart(
+    uint32_t total_history_rows_count) {
+  if (!ShouldUseBraveImporter(source_profile_.importer_type)) {
+    ExternalProcessImporterClient::OnHistoryImportStart(
+        total_history_rows_count);
+    return;
+  }
+
+  // The brave importer sends history in several chunks, each announced by
+  // its own start message, so groups aren't accumulated against a total.
+}
+
+void BraveExternalProcessImporterClient::OnHistoryImportGroup(
+    const std::vector<ImporterURLRow>& history_rows_group,
+    int visit_source) {
+  if (!ShouldUseBraveImporter(source_profile_.importer_type)) {
+    ExternalProcessImporterClient::OnHistoryImportGroup(history_rows_group,
+                                                        visit_source);
+    return;
+  }
+
+  if (cancelled_)
+    return;
+
+  // Write each group to the history service as soon as it arrives instead of
+  // collecting the whole history in the browser process first.
+  bridge_->SetHistoryItems(history_rows_group,
+                           static_cast<importer::VisitSource>(visit_source));
+}
+
 void BraveExternalProcessImporterClient::OnCreditCardImportReady(
     const std::u16string& name_on_card,
     const std::u16string& expiration_month,
@@ -7,10 +7,12 @@
 #define BRAVE_BROWSER_IMPORTER_BRAVE_EXTERNAL_PROCESS_IMPORTER_CLIENT_H_
 
 #include <string>
+#include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "brave/common/importer/profile_import.mojom.h"
 #include "chrome/browser/importer/external_process_importer_client.h"
+#include "chrome/common/importer/importer_url_row.h"
 #include "mojo/public/cpp/bindings/receiver.h"
 #include "mojo/public/cpp/bindings/remote.h"
 
@@ -34,6 +36,10 @@ class BraveExternalProcessImporterClient
   void Cancel() override;
   void CloseMojoHandles() override;
   void OnImportItemFinished(importer::ImportItem import_item) override;
+  void OnHistoryImportStart(uint32_t total_history_rows_count) override;
+  void OnHistoryImportGroup(
+      const std::vector<ImporterURLRow>& history_rows_group,
+      int visit_source) override;
 
   // brave::mojom::ProfileImportObserver overrides:
   void OnCreditCardImportReady(const std::u16string& name_on_card,
@@ -296,6 +296,15 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
       return http_response;
     }
 
+    if (gurl.path_piece() == kImportStatPath) {
+      auto http_response =
+          std::make_unique<net::test_server::BasicHttpResponse>();
+      http_response->set_code(net::HTTP_OK);
+      http_response->set_content_type("application/json");
+      http_response->set_content(expected_response);
+      return http_response;
+    }
+
     if (gurl.path_piece() == kTestLinkImportPath) {
       auto http_response =
           std::make_unique<net::test_server::BasicHttpResponse>();
@@ -1030,6 +1039,25 @@ IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, PreWarmLink) {
   run_loop.Run();
 }
 
+IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, GatewayMediaStats) {
+  ResetTestServer(
+      base::BindRepeating(&IpfsServiceBrowserTest::HandleRequestServerError,
+                          base::Unretained(this)));
+  const std::string cid =
+      "bafybeiemxf5abjwjbikoz4mc3a3dla6ual3jsgpdr4cjr3oz3evfyavhwq";
+  EXPECT_FALSE(ipfs_service()->GetGatewayStats(cid));
+
+  ipfs_service()->PrefetchMediaBlocks(cid);
+  ipfs_service()->OnGatewayMediaResponse(cid, 1024);
+  ipfs_service()->OnGatewayMediaResponse(cid, -1);
+
+  auto stats = ipfs_service()->GetGatewayStats(cid);
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(stats->responses, 2u);
+  EXPECT_EQ(stats->bytes_served, 1024u);
+  EXPECT_GE(stats->last_time_to_headers, base::TimeDelta());
+}
+
 IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportFileToIpfsSuccess) {
   std::string expected_response =
       R"({"Name":"adbanner.js", "Size":"567857", "Hash": "QmYbK4SLa"})";
@@ -1092,6 +1120,50 @@ IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportFileAndPinToIpfsSuccess) {
   WaitForRequest();
 }
 
+class IpfsServiceParallelImportBrowserTest : public IpfsServiceBrowserTest {
+ public:
+  IpfsServiceParallelImportBrowserTest() {
+    parallel_import_feature_list_.InitAndEnableFeature(
+        ipfs::features::kIpfsParallelFolderImport);
+  }
+
+ private:
+  base::test::ScopedFeatureList parallel_import_feature_list_;
+};
+
+IN_PROC_BROWSER_TEST_F(IpfsServiceParallelImportBrowserTest,
+                       ImportDirectoryToIpfsSuccess) {
+  std::string expected_response =
+      R"({"Name":"manifest.json", "Size":"567857", "Hash": "QmYbK4SLa"})";
+  ResetTestServer(
+      base::BindRepeating(&IpfsServiceBrowserTest::HandleImportRequests,
+                          base::Unretained(this), expected_response));
+  auto* folder = FILE_PATH_LITERAL("brave/test/data/autoplay-whitelist-data");
+  auto test_path = embedded_test_server()->GetFullPathFromSourceDirectory(
+      base::FilePath(folder));
+  ipfs_service()->ImportDirectoryToIpfs(
+      test_path, std::string(),
+      base::BindOnce(&IpfsServiceBrowserTest::OnImportCompletedSuccess,
+                     base::Unretained(this)));
+  WaitForRequest();
+}
+
+IN_PROC_BROWSER_TEST_F(IpfsServiceParallelImportBrowserTest,
+                       ImportDirectoryToIpfsFail) {
+  ResetTestServer(
+      base::BindRepeating(&IpfsServiceBrowserTest::HandleImportRequestsFail,
+                          base::Unretained(this)));
+  auto* folder = FILE_PATH_LITERAL("brave/test/data/autoplay-whitelist-data");
+  auto test_path = embedded_test_server()->GetFullPathFromSourceDirectory(
+      base::FilePath(folder));
+  ipfs_service()->ImportDirectoryToIpfs(
+      test_path, std::string(),
+      base::BindOnce(&IpfsServiceBrowserTest::OnImportCompletedFail,
+                     base::Unretained(this), ipfs::IPFS_IMPORT_ERROR_ADD_FAILED,
+                     "autoplay-whitelist-data"));
+  WaitForRequest();
+}
+
 IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, UpdaterRegistration) {
   base::FilePath user_dir = base::FilePath(FILE_PATH_LITERAL("test"));
   BraveIpfsClientUpdater* updater =
@@ -7,6 +7,9 @@
 
 #include <string>
 
+#include "base/containers/mru_cache.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
@@ -17,6 +20,66 @@
 
 namespace brave {
 
+namespace {
+
+constexpr size_t kCspDirectivesCacheSize = 100;
+
+// Ad-block CSP directives of recent responses, keyed by request URL, source
+// host and resource type. Reloads and subframes sharing a tab host then skip
+// the engine lookups. Everything cached is dropped as soon as any engine
+// changes. Only used on the shields task runner.
+class CspDirectivesCache {
+ public:
+  static CspDirectivesCache* GetInstance() {
+    static base::NoDestructor<CspDirectivesCache> instance;
+    return instance.get();
+  }
+
+  base::Optional<std::string> Get(const GURL& url,
+                                  blink::mojom::ResourceType resource_type,
+                                  const std::string& source_host) {
+    const uint64_t generation =
+        brave_shields::AdBlockBaseService::GetEngineGeneration();
+    if (generation != generation_) {
+      entries_.Clear();
+      generation_ = generation;
+    }
+
+    const std::string key = MakeKey(url, resource_type, source_host);
+    auto it = entries_.Get(key);
+    if (it != entries_.end())
+      return it->second;
+
+    base::Optional<std::string> csp_directives =
+        g_brave_browser_process->ad_block_service()->GetCspDirectives(
+            url, resource_type, source_host);
+    // Filter list changes on the UI thread may race with the lookup.
+    if (brave_shields::AdBlockBaseService::GetEngineGeneration() == generation)
+      entries_.Put(key, csp_directives);
+    return csp_directives;
+  }
+
+ private:
+  friend class base::NoDestructor<CspDirectivesCache>;
+
+  CspDirectivesCache() : entries_(kCspDirectivesCacheSize) {}
+  ~CspDirectivesCache() = default;
+
+  static std::string MakeKey(const GURL& url,
+                             blink::mojom::ResourceType resource_type,
+                             const std::string& source_host) {
+    return base::NumberToString(static_cast<int>(resource_type)) + " " +
+           source_host + " " + url.spec();
+  }
+
+  uint64_t generation_ = 0;
+  base::HashingMRUCache<std::string, base::Optional<std::string>> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(CspDirectivesCache);
+};
+
+}  // namespace
+
 base::Optional<std::string> GetCspDirectivesOnTaskRunner(
     std::shared_ptr<BraveRequestInfo> ctx,
     base::Optional<std::string> original_csp) {
@@ -33,8 +96,8 @@ base::Optional<std::string> GetCspDirectivesOnTaskRunner(
   }
 
   base::Optional<std::string> csp_directives =
-      g_brave_browser_process->ad_block_service()->GetCspDirectives(
-          ctx->request_url, ctx->resource_type, source_host);
+      CspDirectivesCache::GetInstance()->Get(ctx->request_url,
+                                             ctx->resource_type, source_host);
 
   brave_shields::MergeCspDirectiveInto(original_csp, &csp_directives);
   return csp_directives;
@@ -11,13 +11,23 @@
 #include <vector>
 
 #include "base/base64url.h"
+#include "base/containers/mru_cache.h"
 #include "base/feature_list.h"
+#include "base/memory/ptr_util.h"
+#include "base/memory/ref_counted.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
+#include "base/supports_user_data.h"
+#include "base/synchronization/lock.h"
+#include "base/task/post_task.h"
+#include "base/time/time.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/url_constants.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_shields/common/features.h"
@@ -34,6 +44,7 @@
 #include "content/public/browser/storage_partition.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/common/url_constants.h"
+#include "crypto/sha2.h"
 #include "extensions/common/url_pattern.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "net/proxy_resolution/proxy_config.h"
@@ -53,6 +64,70 @@ void SetAdblockCnameHostResolverForTesting(
   g_testing_host_resolver = host_resolver;
 }
 
+namespace {
+
+const char kCnameResultCacheKey[] = "brave_adblock_cname_result_cache";
+
+// Number of adblock decisions remembered across all tabs.
+constexpr size_t kDecisionCacheSize = 2000;
+
+// Number of hosts whose canonical names are remembered per browser context.
+constexpr size_t kCnameResultCacheSize = 500;
+// ResolveHostClient doesn't report the record TTL, so use the lifetime the
+// host resolver gives successful system lookups.
+constexpr base::TimeDelta kCnameResultTtl = base::TimeDelta::FromMinutes(1);
+
+// Canonical names resolved for CNAME uncloaking, kept per browser context so
+// that repeated requests to the same host skip the DNS round trip. Only used
+// on the UI thread.
+class CnameResultCache : public base::SupportsUserData::Data {
+ public:
+  CnameResultCache() : entries_(kCnameResultCacheSize) {}
+  ~CnameResultCache() override = default;
+
+  static CnameResultCache* FromBrowserContext(
+      content::BrowserContext* browser_context) {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    auto* cache = static_cast<CnameResultCache*>(
+        browser_context->GetUserData(kCnameResultCacheKey));
+    if (!cache) {
+      cache = new CnameResultCache();
+      browser_context->SetUserData(kCnameResultCacheKey,
+                                   base::WrapUnique(cache));
+    }
+    return cache;
+  }
+
+  bool Get(const std::string& host, std::string* canonical_name) {
+    auto it = entries_.Get(host);
+    if (it == entries_.end())
+      return false;
+    if (base::TimeTicks::Now() >= it->second.expiry) {
+      entries_.Erase(it);
+      return false;
+    }
+    *canonical_name = it->second.canonical_name;
+    return true;
+  }
+
+  void Put(const std::string& host, const std::string& canonical_name) {
+    entries_.Put(
+        host, Entry{canonical_name, base::TimeTicks::Now() + kCnameResultTtl});
+  }
+
+ private:
+  struct Entry {
+    std::string canonical_name;
+    base::TimeTicks expiry;
+  };
+
+  base::HashingMRUCache<std::string, Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(CnameResultCache);
+};
+
+}  // namespace
+
 // Used to keep track of state between a primary adblock engine query and one
 // after CNAME uncloaking the request.
 struct EngineFlags {
@@ -61,28 +136,27 @@ struct EngineFlags {
   bool did_match_important = false;
 };
 
-void UseCnameResult(scoped_refptr<base::SequencedTaskRunner> task_runner,
-                    const ResponseCallback& next_callback,
-                    std::shared_ptr<BraveRequestInfo> ctx,
-                    EngineFlags previous_result,
-                    base::Optional<std::string> cname);
-
+// Resolves the canonical name of a request's host. Deletes itself once the
+// result is delivered.
 class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
  private:
   mojo::Receiver<network::mojom::ResolveHostClient> receiver_{this};
   base::OnceCallback<void(base::Optional<std::string>)> cb_;
   base::TimeTicks start_time_;
+  content::BrowserContext* browser_context_;
+  std::string host_;
 
  public:
   AdblockCnameResolveHostClient(
-      const ResponseCallback& next_callback,
-      scoped_refptr<base::SequencedTaskRunner> task_runner,
       std::shared_ptr<BraveRequestInfo> ctx,
-      EngineFlags previous_result) {
-    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-    cb_ = base::BindOnce(&UseCnameResult, task_runner, std::move(next_callback),
-                         ctx, previous_result);
+      base::OnceCallback<void(base::Optional<std::string>)> cb)
+      : cb_(std::move(cb)),
+        browser_context_(ctx->browser_context),
+        host_(ctx->request_url.host()) {}
 
+  // May complete, and delete |this|, synchronously.
+  void Start(std::shared_ptr<BraveRequestInfo> ctx) {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
     const auto network_isolation_key = ctx->network_isolation_key;
 
     network::mojom::ResolveHostParametersPtr optional_parameters =
@@ -138,6 +212,10 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
                         base::TimeTicks::Now() - start_time_);
     if (result == net::OK && resolved_addresses) {
       DCHECK(resolved_addresses.has_value() && !resolved_addresses->empty());
+      if (browser_context_) {
+        CnameResultCache::FromBrowserContext(browser_context_)
+            ->Put(host_, resolved_addresses->GetCanonicalName());
+      }
       std::move(cb_).Run(
           base::Optional<std::string>(resolved_addresses->GetCanonicalName()));
     } else {
@@ -158,54 +236,176 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
   }
 };
 
-// If `canonical_url` is specified, this will only check if the CNAME-uncloaked
-// response should be blocked. Otherwise, it will run the check for the
-// original request URL.
-EngineFlags ShouldBlockRequestOnTaskRunner(
-    std::shared_ptr<BraveRequestInfo> ctx,
-    EngineFlags previous_result,
-    base::Optional<GURL> canonical_url) {
-  if (!ctx->initiator_url.is_valid()) {
-    return previous_result;
+// Coalesces adblock checks that arrive while a check is already queued on the
+// shields task runner. A burst of subresource requests then costs one task
+// and one engine call per filter list, instead of one of each per request.
+// Decisions are also remembered per tab site until the engines change, so
+// subresources a site loads again, e.g. on reload, skip the engines entirely.
+class AdBlockRequestBatcher {
+ public:
+  using ReplyCallback = base::OnceCallback<void(EngineFlags)>;
+
+  static AdBlockRequestBatcher* GetInstance() {
+    static base::NoDestructor<AdBlockRequestBatcher> instance;
+    return instance.get();
   }
-  const std::string source_host = ctx->initiator_url.host();
 
-  GURL url_to_check;
-  if (canonical_url.has_value()) {
-    url_to_check = *canonical_url;
-  } else {
-    url_to_check = ctx->request_url;
+  // If `canonical_url` is specified, this will only check if the
+  // CNAME-uncloaked response should be blocked. Otherwise, it will run the
+  // check for the original request URL. `reply` runs on the UI thread.
+  void ShouldBlockRequest(scoped_refptr<base::SequencedTaskRunner> task_runner,
+                          std::shared_ptr<BraveRequestInfo> ctx,
+                          EngineFlags previous_result,
+                          base::Optional<GURL> canonical_url,
+                          ReplyCallback reply) {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    bool needs_flush = false;
+    {
+      base::AutoLock lock(lock_);
+      needs_flush = pending_checks_.empty();
+      pending_checks_.push_back({std::move(ctx), previous_result,
+                                 std::move(canonical_url), std::move(reply)});
+    }
+    if (needs_flush) {
+      task_runner->PostTask(
+          FROM_HERE, base::BindOnce(&AdBlockRequestBatcher::FlushOnTaskRunner,
+                                    base::Unretained(this)));
+    }
+  }
+
+ private:
+  friend class base::NoDestructor<AdBlockRequestBatcher>;
+
+  struct PendingCheck {
+    std::shared_ptr<BraveRequestInfo> ctx;
+    EngineFlags result;
+    base::Optional<GURL> canonical_url;
+    ReplyCallback reply;
+  };
+
+  AdBlockRequestBatcher() : decisions_(kDecisionCacheSize) {}
+  ~AdBlockRequestBatcher() = default;
+
+  // The decision depends on the request and, for the CNAME-uncloaked check,
+  // on what the first pass matched. The URL is only kept as a hash, so the
+  // cache doesn't hold on to the full URLs of recent requests.
+  static std::string DecisionKey(const adblock::BatchRequest& request,
+                                 const adblock::BatchResult& previous) {
+    std::string key;
+    key.reserve(request.tab_host.size() + request.resource_type.size() +
+                crypto::kSHA256Length + 5);
+    key += request.tab_host;
+    key += ' ';
+    key += request.resource_type;
+    key += ' ';
+    key += previous.did_match_rule ? '1' : '0';
+    key += previous.did_match_exception ? '1' : '0';
+    key += previous.did_match_important ? '1' : '0';
+    key += crypto::SHA256HashString(request.url);
+    return key;
+  }
+
+  void FlushOnTaskRunner() {
+    std::vector<PendingCheck> checks;
+    {
+      base::AutoLock lock(lock_);
+      checks.swap(pending_checks_);
+    }
+
+    // Read before matching, so decisions made while the engines are being
+    // replaced are dropped by the next flush.
+    const uint64_t generation =
+        brave_shields::AdBlockBaseService::GetEngineGeneration();
+    if (generation != decisions_generation_) {
+      decisions_.Clear();
+      decisions_generation_ = generation;
+    }
+
+    std::vector<adblock::BatchRequest> requests;
+    std::vector<adblock::BatchResult> results;
+    std::vector<std::string> keys;
+    std::vector<PendingCheck*> matched_checks;
+    std::vector<std::pair<PendingCheck*, adblock::BatchResult>> cached_checks;
+    requests.reserve(checks.size());
+    results.reserve(checks.size());
+    keys.reserve(checks.size());
+    matched_checks.reserve(checks.size());
+    for (auto& check : checks) {
+      if (!check.ctx->initiator_url.is_valid())
+        continue;
+      adblock::BatchRequest request =
+          brave_shields::AdBlockBaseService::MakeBatchRequest(
+              check.canonical_url.value_or(check.ctx->request_url),
+              check.ctx->resource_type, check.ctx->initiator_url.host());
+      adblock::BatchResult result;
+      result.did_match_rule = check.result.did_match_rule;
+      result.did_match_exception = check.result.did_match_exception;
+      result.did_match_important = check.result.did_match_important;
+      std::string key = DecisionKey(request, result);
+      auto it = decisions_.Get(key);
+      if (it != decisions_.end()) {
+        cached_checks.emplace_back(&check, it->second);
+        continue;
+      }
+      requests.push_back(std::move(request));
+      results.push_back(std::move(result));
+      keys.push_back(std::move(key));
+      matched_checks.push_back(&check);
+    }
+
+    if (!requests.empty()) {
+      g_brave_browser_process->ad_block_service()->ShouldStartRequests(
+          requests, &results);
+    }
+
+    for (size_t i = 0; i < matched_checks.size(); i++) {
+      decisions_.Put(std::move(keys[i]), results[i]);
+      ApplyResult(results[i], matched_checks[i]);
+    }
+    for (const auto& cached_check : cached_checks)
+      ApplyResult(cached_check.second, cached_check.first);
+
+    base::PostTask(FROM_HERE, {content::BrowserThread::UI},
+                   base::BindOnce(&AdBlockRequestBatcher::RunReplies,
+                                  std::move(checks)));
   }
 
-  g_brave_browser_process->ad_block_service()->ShouldStartRequest(
-      url_to_check, ctx->resource_type, source_host,
-      &previous_result.did_match_rule, &previous_result.did_match_exception,
-      &previous_result.did_match_important, &ctx->mock_data_url);
+  static void ApplyResult(const adblock::BatchResult& result,
+                          PendingCheck* check) {
+    check->result.did_match_rule = result.did_match_rule;
+    check->result.did_match_exception = result.did_match_exception;
+    check->result.did_match_important = result.did_match_important;
+    if (!result.redirect.empty())
+      check->ctx->mock_data_url = result.redirect;
+    if (result.did_match_important ||
+        (result.did_match_rule && !result.did_match_exception)) {
+      check->ctx->blocked_by = kAdBlocked;
+    }
+  }
 
-  if (previous_result.did_match_important ||
-      (previous_result.did_match_rule &&
-       !previous_result.did_match_exception)) {
-    ctx->blocked_by = kAdBlocked;
+  static void RunReplies(std::vector<PendingCheck> checks) {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    for (auto& check : checks)
+      std::move(check.reply).Run(check.result);
   }
 
-  return previous_result;
-}
+  base::Lock lock_;
+  std::vector<PendingCheck> pending_checks_;
 
-void OnShouldBlockRequestResult(
-    bool then_check_uncloaked,
-    scoped_refptr<base::SequencedTaskRunner> task_runner,
-    const ResponseCallback& next_callback,
-    std::shared_ptr<BraveRequestInfo> ctx,
-    EngineFlags result) {
+  // Only used on the shields task runner.
+  base::HashingMRUCache<std::string, adblock::BatchResult> decisions_;
+  uint64_t decisions_generation_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockRequestBatcher);
+};
+
+void OnShouldBlockRequestResult(const ResponseCallback& next_callback,
+                                std::shared_ptr<BraveRequestInfo> ctx,
+                                EngineFlags result) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   if (ctx->blocked_by == kAdBlocked) {
     brave_shields::BraveShieldsWebContentsObserver::DispatchBlockedEvent(
         ctx->request_url, ctx->frame_tree_node_id, brave_shields::kAds);
-  } else if (then_check_uncloaked) {
-    // This will be deleted by `AdblockCnameResolveHostClient::OnComplete`.
-    new AdblockCnameResolveHostClient(std::move(next_callback), task_runner,
-                                      ctx, result);
-    return;
   }
   next_callback.Run();
 }
@@ -224,17 +424,80 @@ void UseCnameResult(scoped_refptr<base::SequencedTaskRunner> task_runner,
                          url::Component(0, static_cast<int>(cname->length())));
     const GURL canonical_url = ctx->request_url.ReplaceComponents(replacements);
 
-    task_runner->PostTaskAndReplyWithResult(
-        FROM_HERE,
-        base::BindOnce(&ShouldBlockRequestOnTaskRunner, ctx, previous_result,
-                       base::make_optional<GURL>(canonical_url)),
-        base::BindOnce(&OnShouldBlockRequestResult, false, task_runner,
-                       next_callback, ctx));
+    AdBlockRequestBatcher::GetInstance()->ShouldBlockRequest(
+        task_runner, ctx, previous_result,
+        base::make_optional<GURL>(canonical_url),
+        base::BindOnce(&OnShouldBlockRequestResult, next_callback, ctx));
   } else {
     next_callback.Run();
   }
 }
 
+// Runs the first engine pass for a request and, only if it doesn't block the
+// request, looks up the host's canonical name for the uncloaked check. Hosts
+// the ad blocker blocks are never sent to the resolver. Only used on the UI
+// thread.
+class CnameUncloakingCheck : public base::RefCounted<CnameUncloakingCheck> {
+ public:
+  CnameUncloakingCheck(scoped_refptr<base::SequencedTaskRunner> task_runner,
+                       const ResponseCallback& next_callback,
+                       std::shared_ptr<BraveRequestInfo> ctx)
+      : task_runner_(std::move(task_runner)),
+        next_callback_(next_callback),
+        ctx_(std::move(ctx)) {}
+
+  void Start() {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    AdBlockRequestBatcher::GetInstance()->ShouldBlockRequest(
+        task_runner_, ctx_, EngineFlags(), base::nullopt,
+        base::BindOnce(&CnameUncloakingCheck::OnEngineResult,
+                       base::WrapRefCounted(this)));
+  }
+
+ private:
+  friend class base::RefCounted<CnameUncloakingCheck>;
+
+  ~CnameUncloakingCheck() = default;
+
+  void OnEngineResult(EngineFlags result) {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    if (ctx_->blocked_by == kAdBlocked) {
+      brave_shields::BraveShieldsWebContentsObserver::DispatchBlockedEvent(
+          ctx_->request_url, ctx_->frame_tree_node_id, brave_shields::kAds);
+      next_callback_.Run();
+      return;
+    }
+    engine_result_ = result;
+
+    std::string canonical_name;
+    if (ctx_->browser_context &&
+        CnameResultCache::FromBrowserContext(ctx_->browser_context)
+            ->Get(ctx_->request_url.host(), &canonical_name)) {
+      UMA_HISTOGRAM_BOOLEAN("Brave.ShieldsCNAMEBlocking.CacheHit", true);
+      OnCnameResult(canonical_name);
+      return;
+    }
+
+    UMA_HISTOGRAM_BOOLEAN("Brave.ShieldsCNAMEBlocking.CacheHit", false);
+    auto* client = new AdblockCnameResolveHostClient(
+        ctx_, base::BindOnce(&CnameUncloakingCheck::OnCnameResult,
+                             base::WrapRefCounted(this)));
+    client->Start(ctx_);
+  }
+
+  void OnCnameResult(base::Optional<std::string> cname) {
+    UseCnameResult(task_runner_, next_callback_, ctx_, engine_result_,
+                   std::move(cname));
+  }
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  ResponseCallback next_callback_;
+  std::shared_ptr<BraveRequestInfo> ctx_;
+  EngineFlags engine_result_;
+
+  DISALLOW_COPY_AND_ASSIGN(CnameUncloakingCheck);
+};
+
 // If only particular types of network traffic are being proxied, or if no
 // proxy is configured, it should be safe to continue making unproxied DNS
 // queries. However, in SingleProxy mode all types of network traffic should go
@@ -289,12 +552,15 @@ void OnBeforeURLRequestAdBlockTP(const ResponseCallback& next_callback,
       ctx->browser_context && !ctx->browser_context->IsTor() &&
       ProxySettingsAllowUncloaking(ctx->browser_context);
 
-  task_runner->PostTaskAndReplyWithResult(
-      FROM_HERE,
-      base::BindOnce(&ShouldBlockRequestOnTaskRunner, ctx, EngineFlags(),
-                     base::nullopt),
-      base::BindOnce(&OnShouldBlockRequestResult, should_check_uncloaked,
-                     task_runner, next_callback, ctx));
+  if (should_check_uncloaked) {
+    base::MakeRefCounted<CnameUncloakingCheck>(task_runner, next_callback, ctx)
+        ->Start();
+    return;
+  }
+
+  AdBlockRequestBatcher::GetInstance()->ShouldBlockRequest(
+      task_runner, ctx, EngineFlags(), base::nullopt,
+      base::BindOnce(&OnShouldBlockRequestResult, next_callback, ctx));
 }
 
 int OnBeforeURLRequest_AdBlockTPPreWork(const ResponseCallback& next_callback,
@@ -9,11 +9,14 @@
 #include <string>
 #include <utility>
 
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
+#include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/common/features.h"
 #include "brave/test/base/testing_brave_browser_process.h"
 #include "content/public/test/browser_task_environment.h"
 #include "net/base/net_errors.h"
@@ -173,3 +176,33 @@ TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, SimpleBlocking) {
   // made (`browser_context` is `nullptr`).
   EXPECT_EQ(0ULL, host_resolver_->num_resolve());
 }
+
+TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, CompiledUnionSubresource) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(
+      brave_shields::features::kBraveAdblockCompiledUnion);
+
+  brave_shields::AdBlockService* service =
+      g_brave_browser_process->ad_block_service();
+  ResetAdblockInstance(service, "||example.com/ad.js", "");
+  ResetAdblockInstance(service->custom_filters_service(),
+                       "||example.com/tracker.js\n@@||example.com/ad.js", "");
+
+  // Blocked by a rule that is only in the custom filter list.
+  const GURL blocked_url("https://example.com/tracker.js");
+  auto blocked_info = std::make_shared<brave::BraveRequestInfo>(blocked_url);
+  blocked_info->resource_type = blink::mojom::ResourceType::kScript;
+  blocked_info->initiator_url = GURL("https://brave.com");
+
+  EXPECT_TRUE(CheckRequest(blocked_info));
+  EXPECT_EQ(blocked_info->blocked_by, brave::kAdBlocked);
+
+  // The custom filter exception applies to the default list's rule.
+  const GURL allowed_url("https://example.com/ad.js");
+  auto allowed_info = std::make_shared<brave::BraveRequestInfo>(allowed_url);
+  allowed_info->resource_type = blink::mojom::ResourceType::kScript;
+  allowed_info->initiator_url = GURL("https://brave.com");
+
+  EXPECT_TRUE(CheckRequest(allowed_info));
+  EXPECT_EQ(allowed_info->blocked_by, brave::kNotBlocked);
+}
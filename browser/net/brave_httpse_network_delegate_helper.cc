@@ -76,6 +76,12 @@ int OnBeforeURLRequest_HttpsePreFileWork(
              ->GetHTTPSURLFromCacheOnly(&ctx->request_url,
                                         ctx->request_identifier,
                                         &ctx->new_url_spec)) {
+      // Most hosts have no rules at all; don't hop to the task runner for
+      // those.
+      if (!g_brave_browser_process->https_everywhere_service()->MayHaveRules(
+              ctx->request_url)) {
+        return net::OK;
+      }
       g_brave_browser_process->https_everywhere_service()
           ->GetTaskRunner()
           ->PostTaskAndReply(
@@ -96,4 +102,12 @@ int OnBeforeURLRequest_HttpsePreFileWork(
   return net::OK;
 }
 
+void OnURLRequestDestroyed_Httpse(std::shared_ptr<BraveRequestInfo> ctx) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  if (ctx->request_identifier == 0)
+    return;
+  g_brave_browser_process->https_everywhere_service()->OnRequestDestroyed(
+      ctx->request_identifier);
+}
+
 }  // namespace brave
@@ -13,6 +13,9 @@ int OnBeforeURLRequest_HttpsePreFileWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx);
 
+// Releases the HTTPSE state kept for a request that is going away.
+void OnURLRequestDestroyed_Httpse(std::shared_ptr<BraveRequestInfo> ctx);
+
 }  // namespace brave
 
 #endif  // BRAVE_BROWSER_NET_BRAVE_NETWORK_DELEGATE_H_
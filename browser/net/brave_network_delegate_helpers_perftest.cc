@@ -0,0 +1,213 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/time/time.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/browser/net/brave_common_static_redirect_network_delegate_helper.h"
+#include "brave/browser/net/brave_site_hacks_network_delegate_helper.h"
+#include "brave/browser/net/brave_static_redirect_network_delegate_helper.h"
+#include "brave/browser/net/global_privacy_control_network_delegate_helper.h"
+#include "brave/browser/net/url_context.h"
+#include "brave/common/network_constants.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_request_headers.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_net_perftests --filter=BraveNetworkDelegateHelpers*
+
+using brave::BraveRequestInfo;
+using brave::ResponseCallback;
+
+namespace {
+
+constexpr char kMetricBasename[] = "BraveNetworkDelegateHelpers";
+constexpr char kNsPerRequestMetric[] = ".ns_per_request";
+
+// Each corpus entry is replayed this many times so that per request timings
+// are not dominated by timer resolution.
+constexpr int kIterations = 200;
+
+constexpr char kUserAgent[] =
+    "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 "
+    "(KHTML, like Gecko) Chrome/90.0.4430.85 Safari/537.36";
+
+// A mix of request shapes seen during a typical page load: top level
+// documents, subresources with and without tracking parameters, and browser
+// service requests which are redirected by the static helpers.
+const char* const kCorpusSpecs[] = {
+    "https://www.google.com/search?q=brave+browser&oq=brave",
+    "https://www.youtube.com/watch?v=dQw4w9WgXcQ",
+    "https://www.facebook.com/",
+    "https://en.wikipedia.org/wiki/Web_browser",
+    "https://www.amazon.com/dp/B08N5WRWNW?ref_=nav_signin&th=1",
+    "https://twitter.com/brave/status/1384891281937555456",
+    "https://www.reddit.com/r/brave_browser/comments/abc123/",
+    "https://www.netflix.com/browse",
+    "https://duckduckgo.com/?q=privacy&t=brave",
+    "https://github.com/brave/brave-browser/issues?q=is%3Aopen",
+    "https://example.com/landing?utm_source=news&utm_medium=email",
+    "https://example.com/article?fbclid=IwAR0abcdefghijklmnopqrstuvwxyz",
+    "https://example.com/product?gclid=EAIaIQobChMI&color=blue",
+    "https://shop.example.com/cart?mc_eid=12345&mc_cid=67890&item=42",
+    "https://news.example.org/story?__hssc=1&__hstc=2&_hsenc=3&id=7",
+    "https://cdn.example.net/static/js/app.3f2a1b.js",
+    "https://cdn.example.net/static/css/main.8c4d2e.css",
+    "https://images.example.net/thumbs/640x360/abcdef.jpg",
+    "https://fonts.gstatic.com/s/roboto/v27/KFOmCnqEu92Fr1Mu4mxK.woff2",
+    "https://www.googletagmanager.com/gtag/js?id=UA-12345-1",
+    "https://api.example.com/v1/feed?cursor=abcdef&limit=20",
+    "https://www.googleapis.com/geolocation/v1/geolocate?key=2_3_5_7",
+    "https://safebrowsing.googleapis.com/v4/threatListUpdates:fetch?key=x",
+    "https://clients2.googleusercontent.com/crx/blobs/QgAAAC6zw0qH2DJtn/"
+    "extension_1_2_3_4.crx",
+    "https://dl.google.com/release2/chrome_component/crl-set",
+    "https://redirector.gvt1.com/edgedl/widevine-cdm/4.10.1582.1-win-x64.zip",
+    "https://clients4.google.com/chrome-sync/command/?client=Google+Chrome",
+    "https://update.googleapis.com/service/update2/json",
+};
+
+std::vector<GURL> BuildCorpus() {
+  std::vector<GURL> corpus;
+  for (const char* spec : kCorpusSpecs)
+    corpus.emplace_back(spec);
+  return corpus;
+}
+
+std::shared_ptr<BraveRequestInfo> BuildRequestInfo(const GURL& url) {
+  auto ctx = std::make_shared<BraveRequestInfo>(url);
+  ctx->tab_origin = url.GetOrigin();
+  ctx->initiator_url = url.GetOrigin();
+  ctx->method = "GET";
+  return ctx;
+}
+
+void ReportNsPerRequest(const std::string& story,
+                        const base::TimeDelta& duration,
+                        size_t requests) {
+  ASSERT_GT(requests, 0u);
+  perf_test::PerfResultReporter reporter(kMetricBasename, story);
+  reporter.RegisterImportantMetric(kNsPerRequestMetric, "ns");
+  reporter.AddResult(kNsPerRequestMetric,
+                     duration.InNanoseconds() / static_cast<double>(requests));
+}
+
+int RunBeforeURLRequestChain(std::shared_ptr<BraveRequestInfo> ctx) {
+  const ResponseCallback next_callback;
+  int rc = brave::OnBeforeURLRequest_SiteHacksWork(next_callback, ctx);
+  if (rc != net::OK)
+    return rc;
+  rc = brave::OnBeforeURLRequest_CommonStaticRedirectWork(next_callback, ctx);
+  if (rc != net::OK)
+    return rc;
+  return brave::OnBeforeURLRequest_StaticRedirectWork(next_callback, ctx);
+}
+
+int RunBeforeStartTransactionChain(net::HttpRequestHeaders* headers,
+                                   std::shared_ptr<BraveRequestInfo> ctx) {
+  const ResponseCallback next_callback;
+  int rc = brave::OnBeforeStartTransaction_SiteHacksWork(headers,
+                                                         next_callback, ctx);
+  if (rc != net::OK)
+    return rc;
+  return brave::OnBeforeStartTransaction_GlobalPrivacyControlWork(
+      headers, next_callback, ctx);
+}
+
+}  // namespace
+
+TEST(BraveNetworkDelegateHelpersPerfTest, BeforeURLRequestHelpers) {
+  const std::vector<GURL> corpus = BuildCorpus();
+
+  using Helper = int (*)(const ResponseCallback&,
+                         std::shared_ptr<BraveRequestInfo>);
+  const struct {
+    const char* story;
+    Helper helper;
+  } kHelpers[] = {
+      {"site_hacks", &brave::OnBeforeURLRequest_SiteHacksWork},
+      {"common_static_redirect",
+       &brave::OnBeforeURLRequest_CommonStaticRedirectWork},
+      {"static_redirect", &brave::OnBeforeURLRequest_StaticRedirectWork},
+  };
+
+  for (const auto& entry : kHelpers) {
+    base::TimeDelta duration;
+    for (int i = 0; i < kIterations; i++) {
+      for (const GURL& url : corpus) {
+        // Building the request info is not part of the measured work.
+        auto ctx = BuildRequestInfo(url);
+        base::ElapsedTimer timer;
+        const int rc = entry.helper(ResponseCallback(), ctx);
+        duration += timer.Elapsed();
+        EXPECT_EQ(net::OK, rc) << url;
+      }
+    }
+
+    ReportNsPerRequest(entry.story, duration, kIterations * corpus.size());
+  }
+}
+
+TEST(BraveNetworkDelegateHelpersPerfTest, BeforeStartTransactionHelpers) {
+  const std::vector<GURL> corpus = BuildCorpus();
+
+  using Helper = int (*)(net::HttpRequestHeaders*, const ResponseCallback&,
+                         std::shared_ptr<BraveRequestInfo>);
+  const struct {
+    const char* story;
+    Helper helper;
+  } kHelpers[] = {
+      {"site_hacks_headers", &brave::OnBeforeStartTransaction_SiteHacksWork},
+      {"global_privacy_control",
+       &brave::OnBeforeStartTransaction_GlobalPrivacyControlWork},
+  };
+
+  for (const auto& entry : kHelpers) {
+    base::TimeDelta duration;
+    for (int i = 0; i < kIterations; i++) {
+      for (const GURL& url : corpus) {
+        auto ctx = BuildRequestInfo(url);
+        net::HttpRequestHeaders headers;
+        headers.SetHeader(kUserAgentHeader, kUserAgent);
+        base::ElapsedTimer timer;
+        const int rc = entry.helper(&headers, ResponseCallback(), ctx);
+        duration += timer.Elapsed();
+        EXPECT_EQ(net::OK, rc) << url;
+      }
+    }
+
+    ReportNsPerRequest(entry.story, duration, kIterations * corpus.size());
+  }
+}
+
+// Replays the corpus through the helpers in the order BraveRequestHandler
+// runs them. Helpers which depend on browser process services (ad block,
+// HTTPS Everywhere, IPFS, decentralized DNS) are not part of the chain.
+TEST(BraveNetworkDelegateHelpersPerfTest, HelperChain) {
+  const std::vector<GURL> corpus = BuildCorpus();
+
+  base::TimeDelta duration;
+  for (int i = 0; i < kIterations; i++) {
+    for (const GURL& url : corpus) {
+      auto ctx = BuildRequestInfo(url);
+      net::HttpRequestHeaders headers;
+      headers.SetHeader(kUserAgentHeader, kUserAgent);
+      base::ElapsedTimer timer;
+      const int url_request_rc = RunBeforeURLRequestChain(ctx);
+      const int start_transaction_rc =
+          RunBeforeStartTransactionChain(&headers, ctx);
+      duration += timer.Elapsed();
+      EXPECT_EQ(net::OK, url_request_rc) << url;
+      EXPECT_EQ(net::OK, start_transaction_rc) << url;
+    }
+  }
+
+  ReportNsPerRequest("chain", duration, kIterations * corpus.size());
+}
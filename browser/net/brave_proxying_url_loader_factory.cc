@@ -19,6 +19,8 @@
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/common/url_utils.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/system/data_pipe_producer.h"
 #include "mojo/public/cpp/system/string_data_source.h"
 #include "net/base/completion_repeating_callback.h"
@@ -531,6 +533,21 @@ void BraveProxyingURLLoaderFactory::InProgressRequest::
 
   proxied_client_receiver_.Resume();
   target_client_->OnReceiveResponse(std::move(current_response_));
+
+  DetachLoaderPipe();
+}
+
+void BraveProxyingURLLoaderFactory::InProgressRequest::DetachLoaderPipe() {
+  if (!proxied_loader_receiver_.is_bound() || !target_loader_.is_bound())
+    return;
+
+  // No more redirects can follow the final response, so there is nothing
+  // left to intercept on the loader side. Join the original client's loader
+  // pipe with the network loader, so priority changes and body read
+  // pausing go straight to the network service. The client side stays
+  // attached: OnComplete is what records the total request time and lets
+  // the request handler see the request finish.
+  mojo::FusePipes(proxied_loader_receiver_.Unbind(), target_loader_.Unbind());
 }
 
 void BraveProxyingURLLoaderFactory::InProgressRequest::ContinueToBeforeRedirect(
@@ -109,6 +109,9 @@ class BraveProxyingURLLoaderFactory
         net::CompletionOnceCallback continuation);
     void OnRequestError(const network::URLLoaderCompletionStatus& status);
     void HandleBeforeRequestRedirect();
+    // Connects the original client's URLLoader pipe straight to the network
+    // loader once the final response headers have been handled.
+    void DetachLoaderPipe();
 
     base::TimeTicks start_time_;
 
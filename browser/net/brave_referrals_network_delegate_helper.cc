@@ -5,34 +5,96 @@
 
 #include "brave/browser/net/brave_referrals_network_delegate_helper.h"
 
+#include "base/logging.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
 #include "base/values.h"
-#include "brave/components/brave_referrals/browser/brave_referrals_service.h"
 #include "brave/common/network_constants.h"
-#include "chrome/browser/browser_process.h"
-#include "content/public/browser/browser_thread.h"
-#include "extensions/common/url_pattern.h"
-#include "net/url_request/url_request.h"
+#include "net/base/net_errors.h"
+#include "url/gurl.h"
 
 namespace brave {
 
+ReferralHeadersTable::ReferralHeadersTable(
+    const base::ListValue& referral_headers_list) {
+  size_t index = 0;
+  for (const auto& headers_value : referral_headers_list.GetList()) {
+    const size_t entry_index = index++;
+    const base::Value* domains_list =
+        headers_value.FindKeyOfType("domains", base::Value::Type::LIST);
+    if (!domains_list) {
+      LOG(WARNING) << "Failed to retrieve 'domains' key from referral headers";
+      continue;
+    }
+    const base::Value* headers_dict =
+        headers_value.FindKeyOfType("headers", base::Value::Type::DICTIONARY);
+    if (!headers_dict) {
+      LOG(WARNING) << "Failed to retrieve 'headers' key from referral headers";
+      continue;
+    }
+
+    base::Optional<std::string> partner_header;
+    if (const std::string* value =
+            headers_dict->FindStringKey(kBravePartnerHeader)) {
+      partner_header = *value;
+    }
+
+    for (const auto& domain_value : domains_list->GetList()) {
+      if (!domain_value.is_string())
+        continue;
+      // An earlier entry for the same domain takes precedence, so don't
+      // overwrite it.
+      entries_.emplace(base::ToLowerASCII(domain_value.GetString()),
+                       Entry{entry_index, partner_header});
+    }
+  }
+}
+
+ReferralHeadersTable::~ReferralHeadersTable() = default;
+
+bool ReferralHeadersTable::GetPartnerHeader(const GURL& url,
+                                            std::string* partner_header) const {
+  DCHECK(partner_header);
+  if (entries_.empty() || !url.SchemeIsHTTPOrHTTPS())
+    return false;
+
+  // Try the host and each of its parent domains, which is what a subdomain
+  // matching URLPattern would accept.
+  const Entry* match = nullptr;
+  base::StringPiece host = url.host_piece();
+  while (!host.empty()) {
+    auto it = entries_.find(host);
+    if (it != entries_.end() && (!match || it->second.index < match->index))
+      match = &it->second;
+
+    const size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
+
+  if (!match || !match->partner_header)
+    return false;
+
+  *partner_header = *match->partner_header;
+  return true;
+}
+
 int OnBeforeStartTransaction_ReferralsWork(
     net::HttpRequestHeaders* headers,
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
-  if (!ctx->referral_headers_list)
+  if (!ctx->referral_headers)
     return net::OK;
   // If the domain for this request matches one of our target domains,
   // set the associated custom headers.
-  const base::DictionaryValue* request_headers_dict = nullptr;
-  if (!BraveReferralsService::GetMatchingReferralHeaders(
-          *ctx->referral_headers_list, &request_headers_dict, ctx->request_url))
+  std::string partner_header;
+  if (!ctx->referral_headers->GetPartnerHeader(ctx->request_url,
+                                               &partner_header)) {
     return net::OK;
-  for (const auto& it : request_headers_dict->DictItems()) {
-    if (it.first == kBravePartnerHeader) {
-      headers->SetHeader(it.first, it.second.GetString());
-      ctx->set_headers.insert(it.first);
-    }
   }
+  headers->SetHeader(kBravePartnerHeader, partner_header);
+  ctx->set_headers.insert(kBravePartnerHeader);
   return net::OK;
 }
 
@@ -7,9 +7,18 @@
 #define BRAVE_BROWSER_NET_BRAVE_REFERRALS_NETWORK_DELEGATE_HELPER_H_
 
 #include <memory>
+#include <string>
 
+#include "base/containers/flat_map.h"
+#include "base/optional.h"
 #include "brave/browser/net/url_context.h"
 
+class GURL;
+
+namespace base {
+class ListValue;
+}  // namespace base
+
 struct BraveRequestInfo;
 
 namespace net {
@@ -19,6 +28,33 @@ class URLRequest;
 
 namespace brave {
 
+// The |kReferralHeaders| pref indexed by domain. It is built once whenever the
+// pref changes, so requests are matched with a few map lookups instead of
+// walking the pref list and building a URLPattern for every listed domain.
+class ReferralHeadersTable {
+ public:
+  explicit ReferralHeadersTable(const base::ListValue& referral_headers_list);
+  ~ReferralHeadersTable();
+
+  ReferralHeadersTable(const ReferralHeadersTable&) = delete;
+  ReferralHeadersTable& operator=(const ReferralHeadersTable&) = delete;
+
+  // Returns true and sets |partner_header| if |url|'s host, or one of its
+  // parent domains, is listed with a partner header. As with
+  // |BraveReferralsService::GetMatchingReferralHeaders|, the first matching
+  // list entry wins.
+  bool GetPartnerHeader(const GURL& url, std::string* partner_header) const;
+
+ private:
+  struct Entry {
+    // Position in the pref list, used to order overlapping domains.
+    size_t index;
+    base::Optional<std::string> partner_header;
+  };
+
+  base::flat_map<std::string, Entry, std::less<>> entries_;
+};
+
 int OnBeforeStartTransaction_ReferralsWork(
     net::HttpRequestHeaders* headers,
     const ResponseCallback& next_callback,
@@ -61,10 +61,12 @@ TEST(BraveReferralsNetworkDelegateHelperTest, ReplaceHeadersForMatchingDomain) {
 
   const base::ListValue* referral_headers_list = nullptr;
   referral_headers.value->GetAsList(&referral_headers_list);
+  auto referral_headers_table =
+      std::make_shared<brave::ReferralHeadersTable>(*referral_headers_list);
 
   net::HttpRequestHeaders headers;
   auto request_info = std::make_shared<brave::BraveRequestInfo>(url);
-  request_info->referral_headers_list = referral_headers_list;
+  request_info->referral_headers = referral_headers_table;
 
   int rc = brave::OnBeforeStartTransaction_ReferralsWork(
       &headers, brave::ResponseCallback(), request_info);
@@ -90,13 +92,41 @@ TEST(BraveReferralsNetworkDelegateHelperTest,
 
   const base::ListValue* referral_headers_list = nullptr;
   referral_headers.value->GetAsList(&referral_headers_list);
+  auto referral_headers_table =
+      std::make_shared<brave::ReferralHeadersTable>(*referral_headers_list);
 
   net::HttpRequestHeaders headers;
   auto request_info = std::make_shared<brave::BraveRequestInfo>(GURL());
-  request_info->referral_headers_list = referral_headers_list;
+  request_info->referral_headers = referral_headers_table;
   int rc = brave::OnBeforeStartTransaction_ReferralsWork(
       &headers, brave::ResponseCallback(), request_info);
 
   EXPECT_FALSE(headers.HasHeader("X-Brave-Partner"));
   EXPECT_EQ(rc, net::OK);
 }
+
+TEST(BraveReferralsNetworkDelegateHelperTest, MatchesOnlyListedDomains) {
+  base::JSONReader::ValueWithError referral_headers =
+      base::JSONReader::ReadAndReturnValueWithError(kTestReferralHeaders);
+  ASSERT_TRUE(referral_headers.value);
+  ASSERT_TRUE(referral_headers.value->is_list());
+
+  const base::ListValue* referral_headers_list = nullptr;
+  referral_headers.value->GetAsList(&referral_headers_list);
+  const brave::ReferralHeadersTable table(*referral_headers_list);
+
+  std::string partner_header;
+  EXPECT_TRUE(
+      table.GetPartnerHeader(GURL("http://barrons.com/a"), &partner_header));
+  EXPECT_EQ(partner_header, "dowjones");
+  EXPECT_TRUE(table.GetPartnerHeader(GURL("https://a.b.xxlmag.com"),
+                                     &partner_header));
+  EXPECT_EQ(partner_header, "townsquare");
+
+  EXPECT_FALSE(table.GetPartnerHeader(GURL("https://notbarrons.com"),
+                                      &partner_header));
+  EXPECT_FALSE(table.GetPartnerHeader(GURL("https://barrons.com.evil.com"),
+                                      &partner_header));
+  EXPECT_FALSE(
+      table.GetPartnerHeader(GURL("ftp://barrons.com"), &partner_header));
+}
@@ -9,8 +9,10 @@
 #include <utility>
 
 #include "base/feature_list.h"
+#include "base/metrics/histogram.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/task/post_task.h"
+#include "base/time/time.h"
 #include "brave/browser/net/brave_ad_block_csp_network_delegate_helper.h"
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
 #include "brave/browser/net/brave_common_static_redirect_network_delegate_helper.h"
@@ -76,73 +78,113 @@ BraveRequestHandler::BraveRequestHandler() {
 
 BraveRequestHandler::~BraveRequestHandler() = default;
 
-void BraveRequestHandler::SetupCallbacks() {
-  brave::OnBeforeURLRequestCallback callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_SiteHacksWork);
-  before_url_request_callbacks_.push_back(callback);
+namespace {
 
-  callback = base::BindRepeating(brave::OnBeforeURLRequest_AdBlockTPPreWork);
-  before_url_request_callbacks_.push_back(callback);
+constexpr char kHelperTimeHistogramPrefix[] = "Brave.NetworkDelegate.";
 
-  callback = base::BindRepeating(brave::OnBeforeURLRequest_HttpsePreFileWork);
-  before_url_request_callbacks_.push_back(callback);
+// Records how long a helper ran before it returned or went async.
+void RecordHelperTime(base::HistogramBase* histogram, base::TimeTicks start) {
+  histogram->AddTimeMicrosecondsGranularity(base::TimeTicks::Now() - start);
+}
 
-  callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_CommonStaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+}  // namespace
+
+template <typename Callback>
+BraveRequestHandler::Helper<Callback>::Helper(
+    Callback callback,
+    const brave::RequestFilter& filter,
+    base::HistogramBase* timing_histogram)
+    : callback(std::move(callback)),
+      filter(filter),
+      timing_histogram(timing_histogram) {}
+
+template <typename Callback>
+BraveRequestHandler::Helper<Callback>::Helper(const Helper& other) = default;
+
+template <typename Callback>
+BraveRequestHandler::Helper<Callback>::~Helper() = default;
+
+// static
+template <typename Callback>
+void BraveRequestHandler::AddHelper(std::vector<Helper<Callback>>* helpers,
+                                    const std::string& name,
+                                    Callback callback,
+                                    const brave::RequestFilter& filter) {
+  base::HistogramBase* histogram = base::Histogram::FactoryMicrosecondsTimeGet(
+      kHelperTimeHistogramPrefix + name,
+      base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+      50, base::HistogramBase::kUmaTargetedHistogramFlag);
+  helpers->emplace_back(std::move(callback), filter, histogram);
+}
+
+void BraveRequestHandler::SetupCallbacks() {
+  AddHelper(&before_url_request_callbacks_, "OnBeforeURLRequest.SiteHacks",
+            base::BindRepeating(brave::OnBeforeURLRequest_SiteHacksWork));
+  AddHelper(&before_url_request_callbacks_, "OnBeforeURLRequest.AdBlockTP",
+            base::BindRepeating(brave::OnBeforeURLRequest_AdBlockTPPreWork));
+  AddHelper(&before_url_request_callbacks_, "OnBeforeURLRequest.Httpse",
+            base::BindRepeating(brave::OnBeforeURLRequest_HttpsePreFileWork));
+  AddHelper(
+      &before_url_request_callbacks_, "OnBeforeURLRequest.CommonStaticRedirect",
+      base::BindRepeating(brave::OnBeforeURLRequest_CommonStaticRedirectWork));
 
 #if BUILDFLAG(DECENTRALIZED_DNS_ENABLED) && BUILDFLAG(BRAVE_WALLET_ENABLED)
-  callback = base::BindRepeating(
-      decentralized_dns::OnBeforeURLRequest_DecentralizedDnsPreRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddHelper(&before_url_request_callbacks_,
+            "OnBeforeURLRequest.DecentralizedDns",
+            base::BindRepeating(
+                decentralized_dns::
+                    OnBeforeURLRequest_DecentralizedDnsPreRedirectWork),
+            decentralized_dns::GetDecentralizedDnsPreRedirectWorkFilter());
 #endif
 
 #if BUILDFLAG(BRAVE_REWARDS_ENABLED)
-  callback = base::BindRepeating(brave_rewards::OnBeforeURLRequest);
-  before_url_request_callbacks_.push_back(callback);
+  AddHelper(&before_url_request_callbacks_, "OnBeforeURLRequest.Rewards",
+            base::BindRepeating(brave_rewards::OnBeforeURLRequest));
 #endif
 
 #if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_TranslateRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddHelper(
+      &before_url_request_callbacks_, "OnBeforeURLRequest.TranslateRedirect",
+      base::BindRepeating(brave::OnBeforeURLRequest_TranslateRedirectWork),
+      brave::GetTranslateRedirectWorkFilter());
 #endif
 
 #if BUILDFLAG(IPFS_ENABLED)
   if (base::FeatureList::IsEnabled(ipfs::features::kIpfsFeature)) {
-    callback = base::BindRepeating(ipfs::OnBeforeURLRequest_IPFSRedirectWork);
-    before_url_request_callbacks_.push_back(callback);
-    brave::OnHeadersReceivedCallback ipfs_headers_received_callback =
-        base::BindRepeating(ipfs::OnHeadersReceived_IPFSRedirectWork);
-    headers_received_callbacks_.push_back(ipfs_headers_received_callback);
+    AddHelper(&before_url_request_callbacks_, "OnBeforeURLRequest.IPFSRedirect",
+              base::BindRepeating(ipfs::OnBeforeURLRequest_IPFSRedirectWork),
+              ipfs::GetIPFSRedirectWorkFilter());
+    AddHelper(&headers_received_callbacks_, "OnHeadersReceived.IPFSRedirect",
+              base::BindRepeating(ipfs::OnHeadersReceived_IPFSRedirectWork));
   }
 #endif
 
-  brave::OnBeforeStartTransactionCallback start_transaction_callback =
-      base::BindRepeating(brave::OnBeforeStartTransaction_SiteHacksWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
-
-  start_transaction_callback = base::BindRepeating(
-      brave::OnBeforeStartTransaction_GlobalPrivacyControlWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+  AddHelper(
+      &before_start_transaction_callbacks_,
+      "OnBeforeStartTransaction.SiteHacks",
+      base::BindRepeating(brave::OnBeforeStartTransaction_SiteHacksWork));
+  AddHelper(&before_start_transaction_callbacks_,
+            "OnBeforeStartTransaction.GlobalPrivacyControl",
+            base::BindRepeating(
+                brave::OnBeforeStartTransaction_GlobalPrivacyControlWork));
 
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
-  start_transaction_callback =
-      base::BindRepeating(brave::OnBeforeStartTransaction_ReferralsWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+  AddHelper(
+      &before_start_transaction_callbacks_,
+      "OnBeforeStartTransaction.Referrals",
+      base::BindRepeating(brave::OnBeforeStartTransaction_ReferralsWork));
 #endif
 
 #if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
-  brave::OnHeadersReceivedCallback headers_received_callback =
-      base::BindRepeating(webtorrent::OnHeadersReceived_TorrentRedirectWork);
-  headers_received_callbacks_.push_back(headers_received_callback);
+  AddHelper(
+      &headers_received_callbacks_, "OnHeadersReceived.TorrentRedirect",
+      base::BindRepeating(webtorrent::OnHeadersReceived_TorrentRedirectWork));
 #endif
 
   if (base::FeatureList::IsEnabled(
           ::brave_shields::features::kBraveAdblockCspRules)) {
-    brave::OnHeadersReceivedCallback headers_received_callback2 =
-        base::BindRepeating(brave::OnHeadersReceived_AdBlockCspWork);
-    headers_received_callbacks_.push_back(headers_received_callback2);
+    AddHelper(&headers_received_callbacks_, "OnHeadersReceived.AdBlockCsp",
+              base::BindRepeating(brave::OnHeadersReceived_AdBlockCspWork));
   }
 }
 
@@ -165,7 +207,9 @@ void BraveRequestHandler::OnReferralHeadersChanged() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   if (const base::ListValue* referral_headers =
           g_browser_process->local_state()->GetList(kReferralHeaders)) {
-    referral_headers_list_.reset(referral_headers->DeepCopy());
+    // Requests in flight keep their own reference to the previous table.
+    referral_headers_ =
+        std::make_shared<const brave::ReferralHeadersTable>(*referral_headers);
   }
 }
 
@@ -185,8 +229,7 @@ int BraveRequestHandler::OnBeforeURLRequest(
   ctx->new_url = new_url;
   ctx->event_type = brave::kOnBeforeRequest;
   callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartCallbacks(ctx);
 }
 
 int BraveRequestHandler::OnBeforeStartTransaction(
@@ -198,10 +241,9 @@ int BraveRequestHandler::OnBeforeStartTransaction(
   }
   ctx->event_type = brave::kOnBeforeStartTransaction;
   ctx->headers = headers;
-  ctx->referral_headers_list = referral_headers_list_.get();
+  ctx->referral_headers = referral_headers_;
   callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartCallbacks(ctx);
 }
 
 int BraveRequestHandler::OnHeadersReceived(
@@ -228,8 +270,7 @@ int BraveRequestHandler::OnHeadersReceived(
   ctx->override_response_headers = override_response_headers;
   ctx->allowed_unsafe_redirect_url = allowed_unsafe_redirect_url;
 
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartCallbacks(ctx);
 }
 
 void BraveRequestHandler::OnURLRequestDestroyed(
@@ -237,6 +278,7 @@ void BraveRequestHandler::OnURLRequestDestroyed(
   if (base::Contains(callbacks_, ctx->request_identifier)) {
     callbacks_.erase(ctx->request_identifier);
   }
+  brave::OnURLRequestDestroyed_Httpse(ctx);
 }
 
 void BraveRequestHandler::RunCallbackForRequestIdentifier(
@@ -252,6 +294,21 @@ void BraveRequestHandler::RunCallbackForRequestIdentifier(
 
 // TODO(iefremov): Merge all callback containers into one and run only one loop
 // instead of many (issues/5574).
+int BraveRequestHandler::StartCallbacks(
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  const int rv = RunCallbacks(ctx);
+  if (rv == net::ERR_IO_PENDING)
+    return rv;
+  // Callers can take these results synchronously, which saves the posted
+  // task and its trip through the UI thread queue.
+  if (rv == net::OK || rv == net::ERR_BLOCKED_BY_CLIENT) {
+    callbacks_.erase(ctx->request_identifier);
+    return rv;
+  }
+  RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
+  return net::ERR_IO_PENDING;
+}
+
 void BraveRequestHandler::RunNextCallback(
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -260,20 +317,34 @@ void BraveRequestHandler::RunNextCallback(
     return;
   }
 
+  const int rv = RunCallbacks(ctx);
+  if (rv != net::ERR_IO_PENDING)
+    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
+}
+
+int BraveRequestHandler::RunCallbacks(
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK(base::Contains(callbacks_, ctx->request_identifier));
+
   // Continue processing callbacks until we hit one that returns PENDING
   int rv = net::OK;
 
   if (ctx->event_type == brave::kOnBeforeRequest) {
     while (before_url_request_callbacks_.size() !=
            ctx->next_url_request_index) {
-      brave::OnBeforeURLRequestCallback callback =
+      const auto& helper =
           before_url_request_callbacks_[ctx->next_url_request_index++];
+      if (!helper.filter.Matches(*ctx))
+        continue;
       brave::ResponseCallback next_callback =
           base::BindRepeating(&BraveRequestHandler::RunNextCallback,
                               weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(next_callback, ctx);
+      const base::TimeTicks start = base::TimeTicks::Now();
+      rv = helper.callback.Run(next_callback, ctx);
+      RecordHelperTime(helper.timing_histogram, start);
       if (rv == net::ERR_IO_PENDING) {
-        return;
+        return rv;
       }
       if (rv != net::OK) {
         break;
@@ -282,14 +353,18 @@ void BraveRequestHandler::RunNextCallback(
   } else if (ctx->event_type == brave::kOnBeforeStartTransaction) {
     while (before_start_transaction_callbacks_.size() !=
            ctx->next_url_request_index) {
-      brave::OnBeforeStartTransactionCallback callback =
+      const auto& helper =
           before_start_transaction_callbacks_[ctx->next_url_request_index++];
+      if (!helper.filter.Matches(*ctx))
+        continue;
       brave::ResponseCallback next_callback =
           base::BindRepeating(&BraveRequestHandler::RunNextCallback,
                               weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(ctx->headers, next_callback, ctx);
+      const base::TimeTicks start = base::TimeTicks::Now();
+      rv = helper.callback.Run(ctx->headers, next_callback, ctx);
+      RecordHelperTime(helper.timing_histogram, start);
       if (rv == net::ERR_IO_PENDING) {
-        return;
+        return rv;
       }
       if (rv != net::OK) {
         break;
@@ -297,16 +372,21 @@ void BraveRequestHandler::RunNextCallback(
     }
   } else if (ctx->event_type == brave::kOnHeadersReceived) {
     while (headers_received_callbacks_.size() != ctx->next_url_request_index) {
-      brave::OnHeadersReceivedCallback callback =
+      const auto& helper =
           headers_received_callbacks_[ctx->next_url_request_index++];
+      if (!helper.filter.Matches(*ctx))
+        continue;
       brave::ResponseCallback next_callback =
           base::BindRepeating(&BraveRequestHandler::RunNextCallback,
                               weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(ctx->original_response_headers,
-                        ctx->override_response_headers,
-                        ctx->allowed_unsafe_redirect_url, next_callback, ctx);
+      const base::TimeTicks start = base::TimeTicks::Now();
+      rv = helper.callback.Run(ctx->original_response_headers,
+                               ctx->override_response_headers,
+                               ctx->allowed_unsafe_redirect_url, next_callback,
+                               ctx);
+      RecordHelperTime(helper.timing_histogram, start);
       if (rv == net::ERR_IO_PENDING) {
-        return;
+        return rv;
       }
       if (rv != net::OK) {
         break;
@@ -314,10 +394,8 @@ void BraveRequestHandler::RunNextCallback(
     }
   }
 
-  if (rv != net::OK) {
-    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
-    return;
-  }
+  if (rv != net::OK)
+    return rv;
 
   if (ctx->event_type == brave::kOnBeforeRequest) {
     if (!ctx->new_url_spec.empty() &&
@@ -327,12 +405,9 @@ void BraveRequestHandler::RunNextCallback(
     }
     if (ctx->blocked_by == brave::kAdBlocked ||
         ctx->blocked_by == brave::kOtherBlocked) {
-      if (!ctx->ShouldMockRequest()) {
-        RunCallbackForRequestIdentifier(ctx->request_identifier,
-                                        net::ERR_BLOCKED_BY_CLIENT);
-        return;
-      }
+      if (!ctx->ShouldMockRequest())
+        return net::ERR_BLOCKED_BY_CLIENT;
     }
   }
-  RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
+  return rv;
 }
@@ -17,6 +17,10 @@
 
 class PrefChangeRegistrar;
 
+namespace base {
+class HistogramBase;
+}
+
 // Contains different network stack hooks (similar to capabilities of WebRequest
 // API).
 class BraveRequestHandler {
@@ -44,25 +48,58 @@ class BraveRequestHandler {
   void RunCallbackForRequestIdentifier(uint64_t request_identifier, int rv);
 
  private:
+  // A network delegate helper, the requests it applies to, and the histogram
+  // its run time is recorded in.
+  template <typename Callback>
+  struct Helper {
+    Helper(Callback callback,
+           const brave::RequestFilter& filter,
+           base::HistogramBase* timing_histogram);
+    Helper(const Helper& other);
+    ~Helper();
+
+    Callback callback;
+    brave::RequestFilter filter;
+    base::HistogramBase* timing_histogram;
+  };
+
+  template <typename Callback>
+  static void AddHelper(
+      std::vector<Helper<Callback>>* helpers,
+      const std::string& name,
+      Callback callback,
+      const brave::RequestFilter& filter = brave::RequestFilter());
+
   void SetupCallbacks();
   void InitPrefChangeRegistrar();
   void OnReferralHeadersChanged();
   void OnPreferenceChanged(const std::string& pref_name);
   void UpdateAdBlockFromPref(const std::string& pref_name);
 
+  // Runs the helpers for a new event. Returns the result directly when they
+  // all finish synchronously, otherwise ERR_IO_PENDING and the stored
+  // callback is run later.
+  int StartCallbacks(std::shared_ptr<brave::BraveRequestInfo> ctx);
+  // Continues the chain after a helper completed asynchronously.
   void RunNextCallback(std::shared_ptr<brave::BraveRequestInfo> ctx);
+  // Runs helpers until one goes async (ERR_IO_PENDING) or the chain ends, and
+  // returns the result.
+  int RunCallbacks(std::shared_ptr<brave::BraveRequestInfo> ctx);
 
-  std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
-  std::vector<brave::OnBeforeStartTransactionCallback>
+  std::vector<Helper<brave::OnBeforeURLRequestCallback>>
+      before_url_request_callbacks_;
+  std::vector<Helper<brave::OnBeforeStartTransactionCallback>>
       before_start_transaction_callbacks_;
-  std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
+  std::vector<Helper<brave::OnHeadersReceivedCallback>>
+      headers_received_callbacks_;
 
   // TODO(iefremov): actually, we don't have to keep the list here, since
   // it is global for the whole browser and could live a singletonce in the
   // rewards service. Eliminating this will also help to avoid using
   // PrefChangeRegistrar and corresponding |base::Unretained| usages, that are
   // illegal.
-  std::unique_ptr<base::ListValue> referral_headers_list_;
+  // Immutable once set; a pref change swaps in a new table.
+  std::shared_ptr<const brave::ReferralHeadersTable> referral_headers_;
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
   std::unique_ptr<PrefChangeRegistrar, content::BrowserThread::DeleteOnUIThread>
       pref_change_registrar_;
@@ -9,7 +9,8 @@
 #include <string>
 #include <vector>
 
-#include "base/lazy_instance.h"
+#include "base/containers/contains.h"
+#include "base/containers/flat_set.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/no_destructor.h"
 #include "base/strings/string_util.h"
@@ -22,7 +23,6 @@
 #include "net/url_request/url_request.h"
 #include "third_party/blink/public/common/loader/network_utils.h"
 #include "third_party/blink/public/common/loader/referrer_utils.h"
-#include "third_party/re2/src/re2/re2.h"
 
 namespace brave {
 
@@ -38,60 +38,83 @@ bool IsUAWhitelisted(const GURL& gurl) {
       [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); });
 }
 
-const std::string& GetQueryStringTrackers() {
-  static const base::NoDestructor<std::string> trackers(base::JoinString(
-      std::vector<std::string>(
-          {// https://github.com/brave/brave-browser/issues/4239
-           "fbclid", "gclid", "msclkid", "mc_eid",
-           // https://github.com/brave/brave-browser/issues/9879
-           "dclid",
-           // https://github.com/brave/brave-browser/issues/13644
-           "oly_anon_id", "oly_enc_id",
-           // https://github.com/brave/brave-browser/issues/11579
-           "_openstat",
-           // https://github.com/brave/brave-browser/issues/11817
-           "vero_conv", "vero_id",
-           // https://github.com/brave/brave-browser/issues/13647
-           "wickedid",
-           // https://github.com/brave/brave-browser/issues/11578
-           "yclid",
-           // https://github.com/brave/brave-browser/issues/8975
-           "__s",
-           // https://github.com/brave/brave-browser/issues/9019
-           "_hsenc", "__hssc", "__hstc", "__hsfp", "hsCtaTracking"}),
-      "|"));
+// Lower-case names of query parameters that only serve cross-site tracking.
+// Kept sorted for the lookup below.
+const base::flat_set<base::StringPiece>& GetQueryStringTrackers() {
+  static const base::NoDestructor<base::flat_set<base::StringPiece>> trackers(
+      std::vector<base::StringPiece>({
+          // https://github.com/brave/brave-browser/issues/4239
+          "fbclid", "gclid", "msclkid", "mc_eid",
+          // https://github.com/brave/brave-browser/issues/9879
+          "dclid",
+          // https://github.com/brave/brave-browser/issues/13644
+          "oly_anon_id", "oly_enc_id",
+          // https://github.com/brave/brave-browser/issues/11579
+          "_openstat",
+          // https://github.com/brave/brave-browser/issues/11817
+          "vero_conv", "vero_id",
+          // https://github.com/brave/brave-browser/issues/13647
+          "wickedid",
+          // https://github.com/brave/brave-browser/issues/11578
+          "yclid",
+          // https://github.com/brave/brave-browser/issues/8975
+          "__s",
+          // https://github.com/brave/brave-browser/issues/9019
+          "_hsenc", "__hssc", "__hstc", "__hsfp", "hsctatracking"}));
   return *trackers;
 }
 
-// From src/components/autofill/content/renderer/page_passwords_analyser.cc
-// and password_form_conversion_utils.cc:
-#define DECLARE_LAZY_MATCHER(NAME, PATTERN)                                   \
-  struct LabelPatternLazyInstanceTraits_##NAME                                \
-      : public base::internal::DestructorAtExitLazyInstanceTraits<re2::RE2> { \
-    static re2::RE2* New(void* instance) {                                    \
-      re2::RE2::Options options;                                              \
-      options.set_case_sensitive(false);                                      \
-      re2::RE2* matcher = new (instance) re2::RE2(PATTERN, options);          \
-      DCHECK(matcher->ok());                                                  \
-      return matcher;                                                         \
-    }                                                                         \
-  };                                                                          \
-  base::LazyInstance<re2::RE2, LabelPatternLazyInstanceTraits_##NAME> NAME =  \
-      LAZY_INSTANCE_INITIALIZER
-
-// e.g. "?fbclid=1234"
-DECLARE_LAZY_MATCHER(tracker_only_matcher,
-                     "^(" + GetQueryStringTrackers() + ")=[^&]+$");
-
-// e.g. "?fbclid=1234&foo=1"
-DECLARE_LAZY_MATCHER(tracker_first_matcher,
-                     "^(" + GetQueryStringTrackers() + ")=[^&]+&");
-
-// e.g. "?foo=1&fbclid=1234" or "?foo=1&fbclid=1234&bar=2"
-DECLARE_LAZY_MATCHER(tracker_appended_matcher,
-                     "&(" + GetQueryStringTrackers() + ")=[^&]+");
-
-#undef DECLARE_LAZY_MATCHER
+// Longest entry of GetQueryStringTrackers(); longer keys can't match.
+constexpr size_t kMaxQueryStringTrackerLength = 13;
+
+// Whether |param| ("key=value") sets a tracker parameter to a non-empty
+// value. Keys are matched case-insensitively.
+bool IsQueryStringTracker(base::StringPiece param) {
+  const size_t separator = param.find('=');
+  if (separator == base::StringPiece::npos || separator == 0 ||
+      separator > kMaxQueryStringTrackerLength ||
+      separator + 1 == param.size()) {
+    return false;
+  }
+  char key[kMaxQueryStringTrackerLength];
+  for (size_t i = 0; i < separator; i++)
+    key[i] = base::ToLowerASCII(param[i]);
+  return base::Contains(GetQueryStringTrackers(),
+                        base::StringPiece(key, separator));
+}
+
+}  // namespace
+
+base::Optional<std::string> StripQueryStringTrackers(base::StringPiece query) {
+  // Single pass over the "&"-separated parameters. Nothing is copied until the
+  // first tracker turns up; the parameters before it are then taken verbatim.
+  base::Optional<std::string> stripped;
+  size_t kept = 0;
+  size_t start = 0;
+  while (true) {
+    size_t end = query.find('&', start);
+    if (end == base::StringPiece::npos)
+      end = query.size();
+    const base::StringPiece param = query.substr(start, end - start);
+    if (IsQueryStringTracker(param)) {
+      if (!stripped)
+        stripped = query.substr(0, start > 0 ? start - 1 : 0).as_string();
+    } else {
+      if (stripped) {
+        if (kept > 0)
+          stripped->push_back('&');
+        stripped->append(param.data(), param.size());
+      }
+      kept++;
+    }
+    if (end == query.size())
+      break;
+    start = end + 1;
+  }
+  return stripped;
+}
+
+namespace {
 
 void ApplyPotentialQueryStringFilter(std::shared_ptr<BraveRequestInfo> ctx) {
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.SiteHacks.QueryFilter");
@@ -122,14 +145,11 @@ void ApplyPotentialQueryStringFilter(std::shared_ptr<BraveRequestInfo> ctx) {
     return;
   }
 
-  std::string new_query = ctx->request_url.query();
-  // Note: the ordering of these replacements is important.
-  const int replacement_count =
-      re2::RE2::GlobalReplace(&new_query, tracker_appended_matcher.Get(), "") +
-      re2::RE2::GlobalReplace(&new_query, tracker_first_matcher.Get(), "") +
-      re2::RE2::GlobalReplace(&new_query, tracker_only_matcher.Get(), "");
+  const base::Optional<std::string> stripped_query =
+      StripQueryStringTrackers(ctx->request_url.query_piece());
 
-  if (replacement_count > 0) {
+  if (stripped_query) {
+    const std::string& new_query = *stripped_query;
     url::Replacements<char> replacements;
     if (new_query.empty()) {
       replacements.ClearQuery();
@@ -7,7 +7,10 @@
 #define BRAVE_BROWSER_NET_BRAVE_SITE_HACKS_NETWORK_DELEGATE_HELPER_H_
 
 #include <memory>
+#include <string>
 
+#include "base/optional.h"
+#include "base/strings/string_piece.h"
 #include "brave/browser/net/url_context.h"
 
 namespace net {
@@ -16,6 +19,10 @@ class URLRequest;
 
 namespace brave {
 
+// Returns |query| without the parameters that set a known tracker, or
+// base::nullopt when there are none to remove.
+base::Optional<std::string> StripQueryStringTrackers(base::StringPiece query);
+
 int OnBeforeURLRequest_SiteHacksWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx);
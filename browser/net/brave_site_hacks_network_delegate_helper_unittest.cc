@@ -10,10 +10,13 @@
 #include <utility>
 #include <vector>
 
+#include "base/logging.h"
+#include "base/timer/elapsed_timer.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
 #include "net/base/net_errors.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/re2/src/re2/re2.h"
 
 using brave::ResponseCallback;
 
@@ -299,3 +302,117 @@ TEST(BraveSiteHacksNetworkDelegateHelperTest, QueryStringFiltered) {
     EXPECT_EQ(brave_request_info->new_url_spec, "https://example.com/");
   }
 }
+
+namespace {
+
+// The regular expressions StripQueryStringTrackers() replaced, kept as a
+// reference for its behaviour.
+class RegexQueryStringFilter {
+ public:
+  RegexQueryStringFilter()
+      : trackers_(
+            "(fbclid|gclid|msclkid|mc_eid|dclid|oly_anon_id|oly_enc_id|"
+            "_openstat|vero_conv|vero_id|wickedid|yclid|__s|_hsenc|__hssc|"
+            "__hstc|__hsfp|hsCtaTracking)"),
+        only_matcher_("^" + trackers_ + "=[^&]+$", Options()),
+        first_matcher_("^" + trackers_ + "=[^&]+&", Options()),
+        appended_matcher_("&" + trackers_ + "=[^&]+", Options()) {}
+
+  base::Optional<std::string> Strip(const std::string& query) const {
+    std::string new_query = query;
+    // Note: the ordering of these replacements is important.
+    const int replacement_count =
+        re2::RE2::GlobalReplace(&new_query, appended_matcher_, "") +
+        re2::RE2::GlobalReplace(&new_query, first_matcher_, "") +
+        re2::RE2::GlobalReplace(&new_query, only_matcher_, "");
+    if (replacement_count == 0)
+      return base::nullopt;
+    return new_query;
+  }
+
+ private:
+  static re2::RE2::Options Options() {
+    re2::RE2::Options options;
+    options.set_case_sensitive(false);
+    return options;
+  }
+
+  const std::string trackers_;
+  const re2::RE2 only_matcher_;
+  const re2::RE2 first_matcher_;
+  const re2::RE2 appended_matcher_;
+};
+
+const char* const kQueryStrings[] = {
+    "",
+    "&",
+    "&&",
+    "=",
+    "foo=1",
+    "foo=1&bar=2&baz=3",
+    "fbclid=1234",
+    "FBCLID=1234",
+    "fbclid=",
+    "fbclid",
+    "fbclid=1234&",
+    "&fbclid=1234",
+    "fbclid=1&fbclid=2",
+    "fbclid=1&&foo",
+    "foo&&fbclid=1",
+    "foo=1&fbclid=abcd",
+    "fbclid=&foo=1&gclid=1234&bar=2",
+    "fbclid&foo&&gclid=2&bar=&%20",
+    "fbclid=1&1==2&=msclkid&foo=bar&&a=b=c&",
+    "fbclidx=1&xfbclid=1&__sx=1&x__s=1",
+    "__s=1234-abcd&hsctatracking=1&HsCtaTracking=2",
+    "gclid=a=b&foo=1",
+    "a+b+c=some%20thing&yclid=3&1%202=3+4",
+};
+
+}  // namespace
+
+TEST(BraveSiteHacksNetworkDelegateHelperTest, StripQueryStringTrackers) {
+  EXPECT_FALSE(brave::StripQueryStringTrackers("foo=1&bar=2"));
+  EXPECT_FALSE(brave::StripQueryStringTrackers("fbclid=&fbclid"));
+  EXPECT_EQ(brave::StripQueryStringTrackers("fbclid=1"), std::string());
+  EXPECT_EQ(brave::StripQueryStringTrackers("foo=1&MSCLKID=2&bar=3"),
+            "foo=1&bar=3");
+  EXPECT_EQ(brave::StripQueryStringTrackers("&fbclid=1&&gclid=2&"), "&&");
+}
+
+TEST(BraveSiteHacksNetworkDelegateHelperTest,
+     StripQueryStringTrackersMatchesRegex) {
+  const RegexQueryStringFilter regex_filter;
+  for (const char* query : kQueryStrings) {
+    EXPECT_EQ(brave::StripQueryStringTrackers(query),
+              regex_filter.Strip(query))
+        << query;
+  }
+}
+
+// Compares StripQueryStringTrackers() with the regular expressions it
+// replaced. Run manually with --gtest_also_run_disabled_tests.
+TEST(BraveSiteHacksNetworkDelegateHelperTest,
+     DISABLED_StripQueryStringTrackersPerf) {
+  constexpr int kIterations = 100000;
+  const RegexQueryStringFilter regex_filter;
+
+  size_t stripped_count = 0;
+  base::ElapsedTimer fast_timer;
+  for (int i = 0; i < kIterations; i++) {
+    for (const char* query : kQueryStrings)
+      stripped_count += brave::StripQueryStringTrackers(query).has_value();
+  }
+  const base::TimeDelta fast_time = fast_timer.Elapsed();
+
+  base::ElapsedTimer regex_timer;
+  for (int i = 0; i < kIterations; i++) {
+    for (const char* query : kQueryStrings)
+      stripped_count += regex_filter.Strip(query).has_value();
+  }
+  const base::TimeDelta regex_time = regex_timer.Elapsed();
+
+  LOG(INFO) << "StripQueryStringTrackers: " << fast_time.InMilliseconds()
+            << "ms, regex: " << regex_time.InMilliseconds() << "ms ("
+            << stripped_count << " stripped)";
+}
@@ -8,9 +8,14 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-#include "base/strings/string_piece_forward.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/no_destructor.h"
+#include "base/optional.h"
+#include "base/strings/string_piece.h"
 #include "brave/browser/translate/buildflags/buildflags.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/translate_network_constants.h"
@@ -31,169 +36,241 @@ base::StringPiece GetSafeBrowsingEndpoint() {
   return SAFEBROWSING_ENDPOINT;
 }
 
-}  // namespace
+// Rewrites |request_url| into |new_url|. Returns false when the rule doesn't
+// apply after all, in which case later rules are tried.
+using RedirectFunction = bool (*)(const GURL& request_url, GURL* new_url);
 
-void SetSafeBrowsingEndpointForTesting(bool testing) {
-  g_safebrowsing_api_endpoint_for_testing_ = testing;
-}
+struct StaticRedirectRule {
+  StaticRedirectRule(int valid_schemes,
+                     const char* pattern,
+                     RedirectFunction redirect,
+                     bool match_host_only = false,
+                     const char* exception = nullptr)
+      : pattern(valid_schemes, pattern),
+        redirect(redirect),
+        match_host_only(match_host_only) {
+    if (exception)
+      this->exception.emplace(valid_schemes, exception);
+  }
 
-int OnBeforeURLRequest_StaticRedirectWork(
-    const ResponseCallback& next_callback,
-    std::shared_ptr<BraveRequestInfo> ctx) {
-  GURL new_url;
-  int rc = OnBeforeURLRequest_StaticRedirectWorkForGURL(ctx->request_url,
-                                                        &new_url);
-  if (!new_url.is_empty()) {
-    ctx->new_url_spec = new_url.spec();
+  bool Matches(const GURL& request_url) const {
+    if (match_host_only)
+      return pattern.MatchesHost(request_url);
+    return pattern.MatchesURL(request_url) &&
+           !(exception && exception->MatchesURL(request_url));
   }
-  return rc;
+
+  URLPattern pattern;
+  // Requests matching |exception| are left alone even if they match
+  // |pattern|.
+  base::Optional<URLPattern> exception;
+  RedirectFunction redirect;
+  // Only compare the host, ignoring the scheme and path of |pattern|.
+  bool match_host_only;
+};
+
+bool ReplaceHost(const GURL& request_url,
+                 base::StringPiece host,
+                 GURL* new_url) {
+  GURL::Replacements replacements;
+  replacements.SetHostStr(host);
+  *new_url = request_url.ReplaceComponents(replacements);
+  return true;
 }
 
-int OnBeforeURLRequest_StaticRedirectWorkForGURL(
-    const GURL& request_url,
-    GURL* new_url) {
+bool ReplaceHostWithHttps(const GURL& request_url,
+                          base::StringPiece host,
+                          GURL* new_url) {
   GURL::Replacements replacements;
-  static URLPattern geo_pattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern);
-  static URLPattern safeBrowsing_pattern(URLPattern::SCHEME_HTTPS,
-                                         kSafeBrowsingPrefix);
-  static URLPattern safebrowsingfilecheck_pattern(URLPattern::SCHEME_HTTPS,
-                                                  kSafeBrowsingFileCheckPrefix);
-  static URLPattern safebrowsingcrxlist_pattern(URLPattern::SCHEME_HTTPS,
-                                                kSafeBrowsingCrxListPrefix);
-
-  // To-Do (@jumde) - Update the naming for the variables below
-  // https://github.com/brave/brave-browser/issues/10314
-  static URLPattern crlSet_pattern1(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix1);
-  static URLPattern crlSet_pattern2(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix2);
-  static URLPattern crlSet_pattern3(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix3);
-  static URLPattern crlSet_pattern4(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix4);
-  static URLPattern crxDownload_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRXDownloadPrefix);
-  static URLPattern autofill_pattern(
-      URLPattern::SCHEME_HTTPS, kAutofillPrefix);
-  static URLPattern gvt1_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, "*://*.gvt1.com/*");
-  static URLPattern googleDl_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      "*://dl.google.com/*");
-
-  static URLPattern widevine_gvt1_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      kWidevineGvt1Prefix);
-  static URLPattern widevine_google_dl_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
-      kWidevineGoogleDlPrefix);
+  replacements.SetSchemeStr("https");
+  replacements.SetHostStr(host);
+  *new_url = request_url.ReplaceComponents(replacements);
+  return true;
+}
 
-#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  static URLPattern translate_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateElementJSPattern);
-  static URLPattern translate_language_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateLanguagePattern);
-#endif
-  if (geo_pattern.MatchesURL(request_url)) {
-    *new_url = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
-    return net::OK;
-  }
+bool RedirectGeolocation(const GURL& request_url, GURL* new_url) {
+  *new_url = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
+  return true;
+}
 
+bool RedirectSafeBrowsing(const GURL& request_url, GURL* new_url) {
   auto safebrowsing_endpoint = GetSafeBrowsingEndpoint();
-  if (!safebrowsing_endpoint.empty() &&
-      safeBrowsing_pattern.MatchesHost(request_url)) {
-    replacements.SetHostStr(safebrowsing_endpoint);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
+  if (safebrowsing_endpoint.empty())
+    return false;
+  return ReplaceHost(request_url, safebrowsing_endpoint, new_url);
+}
 
-  if (!safebrowsing_endpoint.empty() &&
-      safebrowsingfilecheck_pattern.MatchesHost(request_url)) {
-    replacements.SetHostStr(kBraveSafeBrowsingSslProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
+bool RedirectSafeBrowsingFileCheck(const GURL& request_url, GURL* new_url) {
+  if (GetSafeBrowsingEndpoint().empty())
+    return false;
+  return ReplaceHost(request_url, kBraveSafeBrowsingSslProxy, new_url);
+}
 
-  if (!safebrowsing_endpoint.empty() &&
-      safebrowsingcrxlist_pattern.MatchesHost(request_url)) {
-    replacements.SetHostStr(kBraveSafeBrowsing2Proxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
+bool RedirectSafeBrowsingCrxList(const GURL& request_url, GURL* new_url) {
+  if (GetSafeBrowsingEndpoint().empty())
+    return false;
+  return ReplaceHost(request_url, kBraveSafeBrowsing2Proxy, new_url);
+}
 
-  if (crxDownload_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crxdownload.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
+bool RedirectCrxDownload(const GURL& request_url, GURL* new_url) {
+  return ReplaceHostWithHttps(request_url, "crxdownload.brave.com", new_url);
+}
 
-  if (autofill_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveStaticProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
+bool RedirectAutofill(const GURL& request_url, GURL* new_url) {
+  return ReplaceHostWithHttps(request_url, kBraveStaticProxy, new_url);
+}
 
-  if (crlSet_pattern1.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
+bool RedirectCRLSet(const GURL& request_url, GURL* new_url) {
+  return ReplaceHostWithHttps(request_url, "crlsets.brave.com", new_url);
+}
 
-  if (crlSet_pattern2.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
+bool RedirectComponentDownload(const GURL& request_url, GURL* new_url) {
+  return ReplaceHostWithHttps(request_url, kBraveRedirectorProxy, new_url);
+}
 
-  if (crlSet_pattern3.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+bool RedirectTranslateElementJS(const GURL& request_url, GURL* new_url) {
+  GURL::Replacements replacements;
+  replacements.SetQueryStr(request_url.query_piece());
+  replacements.SetPathStr(request_url.path_piece());
+  *new_url = GURL(kBraveTranslateEndpoint).ReplaceComponents(replacements);
+  return true;
+}
 
-  if (crlSet_pattern4.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
+bool RedirectTranslateLanguage(const GURL& request_url, GURL* new_url) {
+  *new_url = GURL(kBraveTranslateLanguageEndpoint);
+  return true;
+}
+#endif
 
-  if (gvt1_pattern.MatchesURL(request_url) &&
-      !widevine_gvt1_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
+// The static redirect rules, indexed by the host of their pattern. A request
+// only has to be checked against the rules filed under its host or one of
+// its parent domains (for "*.example.com" patterns), so the common case of
+// a host without rules costs a few hash lookups however many rules there
+// are.
+class StaticRedirectTable {
+ public:
+  StaticRedirectTable() {
+    constexpr int kHttpAndHttps =
+        URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+    // Earlier rules win when several match the same request.
+    rules_.emplace_back(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern,
+                        &RedirectGeolocation);
+    rules_.emplace_back(URLPattern::SCHEME_HTTPS, kSafeBrowsingPrefix,
+                        &RedirectSafeBrowsing, /*match_host_only=*/true);
+    rules_.emplace_back(URLPattern::SCHEME_HTTPS, kSafeBrowsingFileCheckPrefix,
+                        &RedirectSafeBrowsingFileCheck,
+                        /*match_host_only=*/true);
+    rules_.emplace_back(URLPattern::SCHEME_HTTPS, kSafeBrowsingCrxListPrefix,
+                        &RedirectSafeBrowsingCrxList,
+                        /*match_host_only=*/true);
+    rules_.emplace_back(kHttpAndHttps, kCRXDownloadPrefix,
+                        &RedirectCrxDownload);
+    rules_.emplace_back(URLPattern::SCHEME_HTTPS, kAutofillPrefix,
+                        &RedirectAutofill);
+    // To-Do (@jumde) - Update the naming for the CRLSet prefixes
+    // https://github.com/brave/brave-browser/issues/10314
+    rules_.emplace_back(kHttpAndHttps, kCRLSetPrefix1, &RedirectCRLSet);
+    rules_.emplace_back(kHttpAndHttps, kCRLSetPrefix2, &RedirectCRLSet);
+    rules_.emplace_back(kHttpAndHttps, kCRLSetPrefix3, &RedirectCRLSet);
+    rules_.emplace_back(kHttpAndHttps, kCRLSetPrefix4, &RedirectCRLSet);
+    rules_.emplace_back(kHttpAndHttps, "*://*.gvt1.com/*",
+                        &RedirectComponentDownload,
+                        /*match_host_only=*/false, kWidevineGvt1Prefix);
+    rules_.emplace_back(kHttpAndHttps, "*://dl.google.com/*",
+                        &RedirectComponentDownload,
+                        /*match_host_only=*/false, kWidevineGoogleDlPrefix);
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+    rules_.emplace_back(URLPattern::SCHEME_HTTPS, kTranslateElementJSPattern,
+                        &RedirectTranslateElementJS);
+    rules_.emplace_back(URLPattern::SCHEME_HTTPS, kTranslateLanguagePattern,
+                        &RedirectTranslateLanguage);
+#endif
+
+    // |rules_| is complete, so the keys can point into the patterns' hosts.
+    for (size_t i = 0; i < rules_.size(); i++) {
+      const std::string& host = rules_[i].pattern.host();
+      DCHECK(!host.empty());
+      rules_by_host_[host].push_back(i);
+    }
   }
 
-  if (googleDl_pattern.MatchesURL(request_url) &&
-      !widevine_google_dl_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
+  // Applies the first matching rule that accepts |request_url|. Returns
+  // false if there is none.
+  bool Redirect(const GURL& request_url, GURL* new_url) const {
+    if (!request_url.has_host())
+      return false;
+    for (size_t index = FindRule(request_url, 0); index < rules_.size();
+         index = FindRule(request_url, index + 1)) {
+      if (rules_[index].redirect(request_url, new_url))
+        return true;
+    }
+    return false;
   }
 
-#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  if (translate_pattern.MatchesURL(request_url)) {
-    replacements.SetQueryStr(request_url.query_piece());
-    replacements.SetPathStr(request_url.path_piece());
-    *new_url =
-      GURL(kBraveTranslateEndpoint).ReplaceComponents(replacements);
-    return net::OK;
+ private:
+  // Returns the index of the first rule at or after |first| that matches
+  // |request_url|, or rules_.size().
+  size_t FindRule(const GURL& request_url, size_t first) const {
+    size_t best_index = rules_.size();
+    base::StringPiece host = request_url.host_piece();
+    while (!host.empty()) {
+      auto it = rules_by_host_.find(host);
+      if (it != rules_by_host_.end()) {
+        for (size_t index : it->second) {
+          if (index >= best_index)
+            break;
+          if (index >= first && rules_[index].Matches(request_url)) {
+            best_index = index;
+            break;
+          }
+        }
+      }
+      const size_t dot = host.find('.');
+      if (dot == base::StringPiece::npos)
+        break;
+      host.remove_prefix(dot + 1);
+    }
+    return best_index;
   }
 
-  if (translate_language_pattern.MatchesURL(request_url)) {
-    *new_url = GURL(kBraveTranslateLanguageEndpoint);
-    return net::OK;
+  std::vector<StaticRedirectRule> rules_;
+  // Indices into |rules_|, in ascending order for each host.
+  std::unordered_map<base::StringPiece, std::vector<size_t>,
+                     base::StringPieceHash>
+      rules_by_host_;
+
+  DISALLOW_COPY_AND_ASSIGN(StaticRedirectTable);
+};
+
+const StaticRedirectTable& GetStaticRedirectTable() {
+  static const base::NoDestructor<StaticRedirectTable> table;
+  return *table;
+}
+
+}  // namespace
+
+void SetSafeBrowsingEndpointForTesting(bool testing) {
+  g_safebrowsing_api_endpoint_for_testing_ = testing;
+}
+
+int OnBeforeURLRequest_StaticRedirectWork(
+    const ResponseCallback& next_callback,
+    std::shared_ptr<BraveRequestInfo> ctx) {
+  GURL new_url;
+  int rc = OnBeforeURLRequest_StaticRedirectWorkForGURL(ctx->request_url,
+                                                        &new_url);
+  if (!new_url.is_empty()) {
+    ctx->new_url_spec = new_url.spec();
   }
-#endif
+  return rc;
+}
 
+int OnBeforeURLRequest_StaticRedirectWorkForGURL(
+    const GURL& request_url,
+    GURL* new_url) {
+  GetStaticRedirectTable().Redirect(request_url, new_url);
   return net::OK;
 }
 
@@ -29,6 +29,23 @@ TEST(BraveStaticRedirectNetworkDelegateHelperTest, NoModifyTypicalURL) {
   EXPECT_EQ(rc, net::OK);
 }
 
+TEST(BraveStaticRedirectNetworkDelegateHelperTest, NoModifyLookalikeHosts) {
+  const char* const kUrls[] = {
+      "https://dl.google.com.example.com/release2/chrome_component/crl-set",
+      "https://notgvt1.com/edgedl/release2/chrome_component/crl-set",
+      "https://gvt1.com.example.com/foo.crx",
+      "https://googleapis.com/geolocation/v1/geolocate?key=2_3_5_7",
+      "https://com/",
+  };
+  for (const char* url : kUrls) {
+    auto request_info = std::make_shared<brave::BraveRequestInfo>(GURL(url));
+    int rc =
+        OnBeforeURLRequest_StaticRedirectWork(ResponseCallback(), request_info);
+    EXPECT_TRUE(request_info->new_url_spec.empty()) << url;
+    EXPECT_EQ(rc, net::OK);
+  }
+}
+
 TEST(BraveStaticRedirectNetworkDelegateHelperTest, ModifyGeoURL) {
   const GURL url(
       "https://www.googleapis.com/geolocation/v1/geolocate?key=2_3_5_7");
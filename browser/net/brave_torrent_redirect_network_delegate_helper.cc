@@ -23,14 +23,14 @@ namespace {
 // Returns true if the URL contains a URL fragment that starts with "ix=". For
 // example, https://webtorrent.io/torrents/big-buck-bunny.torrent#ix=1.
 bool IsViewerURL(const GURL& url) {
-  return base::StartsWith(url.ref(), "ix=",
+  return base::StartsWith(url.ref_piece(), "ix=",
       base::CompareCase::INSENSITIVE_ASCII);
 }
 
 
 bool IsWebtorrentInitiated(std::shared_ptr<brave::BraveRequestInfo> ctx) {
-  return ctx->initiator_url.scheme() == extensions::kExtensionScheme &&
-      ctx->initiator_url.host() == brave_webtorrent_extension_id;
+  return ctx->initiator_url.SchemeIs(extensions::kExtensionScheme) &&
+      ctx->initiator_url.host_piece() == brave_webtorrent_extension_id;
 }
 
 // Returns true if the resource type is a frame (i.e. a top level page) or a
@@ -10,6 +10,7 @@
 #include <vector>
 #include "brave/common/translate_network_constants.h"
 #include "extensions/common/url_pattern.h"
+#include "url/url_constants.h"
 
 namespace {
 const char kTranslateElementLibQuery[] = "client=te_lib";
@@ -54,6 +55,14 @@ bool IsTranslateGen204Request(const GURL& gurl) {
   return is_te_lib && pattern.MatchesURL(gurl);
 }
 
+RequestFilter GetTranslateRedirectWorkFilter() {
+  RequestFilter filter;
+  filter.schemes = {url::kHttpsScheme};
+  filter.domains = {"translate.googleapis.com", "translate.google.com",
+                    "www.gstatic.com"};
+  return filter;
+}
+
 int OnBeforeURLRequest_TranslateRedirectWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
@@ -11,6 +11,9 @@
 
 namespace brave {
 
+// Translate element requests only go to a few Google hosts over https.
+RequestFilter GetTranslateRedirectWorkFilter();
+
 int OnBeforeURLRequest_TranslateRedirectWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx);
@@ -5,8 +5,13 @@
 
 #include "brave/browser/net/decentralized_dns_network_delegate_helper.h"
 
+#include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/containers/mru_cache.h"
+#include "base/no_destructor.h"
+#include "base/time/time.h"
 #include "net/base/net_errors.h"
 
 #include "brave/browser/brave_wallet/brave_wallet_service_factory.h"
@@ -16,6 +21,7 @@
 #include "brave/components/decentralized_dns/constants.h"
 #include "brave/components/decentralized_dns/utils.h"
 #include "brave/components/ipfs/ipfs_utils.h"
+#include "brave/net/decentralized_dns/constants.h"
 #include "chrome/browser/browser_process.h"
 #include "content/public/browser/browser_context.h"
 
@@ -27,8 +33,107 @@ std::string GetValue(const std::vector<std::string>& arr, RecordKeys key) {
   return arr[static_cast<size_t>(key)];
 }
 
+// Records rarely change, so resolved hosts are kept for a while to spare
+// navigations a provider round trip. An empty spec means the host has no
+// usable record.
+constexpr base::TimeDelta kResolvedHostTTL = base::TimeDelta::FromMinutes(5);
+const size_t kMaxResolvedHosts = 100;
+
+using ResolvedHostCache =
+    base::MRUCache<std::string, std::pair<std::string, base::TimeTicks>>;
+
+ResolvedHostCache& GetResolvedHostCache() {
+  static base::NoDestructor<ResolvedHostCache> cache(kMaxResolvedHosts);
+  return *cache;
+}
+
+bool GetResolvedHost(const std::string& host, std::string* new_url_spec) {
+  ResolvedHostCache& cache = GetResolvedHostCache();
+  auto it = cache.Get(host);
+  if (it == cache.end())
+    return false;
+  if (base::TimeTicks::Now() - it->second.second >= kResolvedHostTTL) {
+    cache.Erase(it);
+    return false;
+  }
+  *new_url_spec = it->second.first;
+  return true;
+}
+
+void SetResolvedHost(const std::string& host, const std::string& new_url_spec) {
+  GetResolvedHostCache().Put(
+      host, std::make_pair(new_url_spec, base::TimeTicks::Now()));
+}
+
+// Requests for a host whose resolution is already in flight wait for that
+// result instead of issuing another eth_call. A resolution which hasn't
+// answered within |kPendingResolutionTimeout| is assumed lost, and the next
+// request for the host starts a new one which the waiters then share.
+constexpr base::TimeDelta kPendingResolutionTimeout =
+    base::TimeDelta::FromSeconds(30);
+
+struct PendingResolution {
+  base::TimeTicks start_time;
+  std::vector<std::pair<brave::ResponseCallback,
+                        std::shared_ptr<brave::BraveRequestInfo>>>
+      waiters;
+};
+
+base::flat_map<std::string, PendingResolution>& GetPendingResolutions() {
+  static base::NoDestructor<base::flat_map<std::string, PendingResolution>>
+      pending;
+  return *pending;
+}
+
+// Returns true if |ctx| was queued behind a resolution already in flight,
+// otherwise marks its host as being resolved.
+bool WaitForPendingResolution(const brave::ResponseCallback& next_callback,
+                              std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  PendingResolution& resolution =
+      GetPendingResolutions()[ctx->request_url.host()];
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (resolution.start_time.is_null() ||
+      now - resolution.start_time >= kPendingResolutionTimeout) {
+    resolution.start_time = now;
+    return false;
+  }
+  resolution.waiters.emplace_back(next_callback, std::move(ctx));
+  return true;
+}
+
+void FinishResolution(const brave::ResponseCallback& next_callback,
+                      std::shared_ptr<brave::BraveRequestInfo> ctx,
+                      const std::string& new_url_spec) {
+  PendingResolution resolution;
+  auto& pending = GetPendingResolutions();
+  auto it = pending.find(ctx->request_url.host());
+  if (it != pending.end()) {
+    resolution = std::move(it->second);
+    pending.erase(it);
+  }
+
+  if (!new_url_spec.empty())
+    ctx->new_url_spec = new_url_spec;
+  if (!next_callback.is_null())
+    next_callback.Run();
+
+  for (auto& waiter : resolution.waiters) {
+    if (!new_url_spec.empty())
+      waiter.second->new_url_spec = new_url_spec;
+    if (!waiter.first.is_null())
+      waiter.first.Run();
+  }
+}
+
 }  // namespace
 
+brave::RequestFilter GetDecentralizedDnsPreRedirectWorkFilter() {
+  brave::RequestFilter filter;
+  // Skip the leading dot, DomainIs() matches subdomains already.
+  filter.domains = {kCryptoDomain + 1, kEthDomain + 1};
+  return filter;
+}
+
 int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
     const brave::ResponseCallback& next_callback,
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
@@ -37,15 +142,31 @@ int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
     return net::OK;
   }
 
-  if (IsUnstoppableDomainsTLD(ctx->request_url) &&
+  const bool resolve_unstoppable_domains =
+      IsUnstoppableDomainsTLD(ctx->request_url) &&
       IsUnstoppableDomainsResolveMethodEthereum(
-          g_browser_process->local_state())) {
+          g_browser_process->local_state());
+  const bool resolve_ens =
+      IsENSTLD(ctx->request_url) &&
+      IsENSResolveMethodEthereum(g_browser_process->local_state());
+  std::string new_url_spec;
+  if ((resolve_unstoppable_domains || resolve_ens) &&
+      GetResolvedHost(ctx->request_url.host(), &new_url_spec)) {
+    if (!new_url_spec.empty())
+      ctx->new_url_spec = new_url_spec;
+    return net::OK;
+  }
+
+  if (resolve_unstoppable_domains) {
     auto* service = brave_wallet::BraveWalletServiceFactory::GetForContext(
         ctx->browser_context);
     if (!service) {
       return net::OK;
     }
 
+    if (WaitForPendingResolution(next_callback, ctx))
+      return net::ERR_IO_PENDING;
+
     service->rpc_controller()->UnstoppableDomainsProxyReaderGetMany(
         kProxyReaderContractAddress, ctx->request_url.host(),
         std::vector<std::string>(std::begin(kRecordKeys),
@@ -56,14 +177,16 @@ int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
     return net::ERR_IO_PENDING;
   }
 
-  if (IsENSTLD(ctx->request_url) &&
-      IsENSResolveMethodEthereum(g_browser_process->local_state())) {
+  if (resolve_ens) {
     auto* service = brave_wallet::BraveWalletServiceFactory::GetForContext(
         ctx->browser_context);
     if (!service) {
       return net::OK;
     }
 
+    if (WaitForPendingResolution(next_callback, ctx))
+      return net::ERR_IO_PENDING;
+
     service->rpc_controller()->EnsProxyReaderResolveAddress(
         kEnsRegistryContractAddress, ctx->request_url.host(),
         std::vector<std::string>(std::begin(kRecordKeys),
@@ -83,26 +206,23 @@ void OnBeforeURLRequest_EnsRedirectWork(
     bool success,
     const std::string& result) {
   if (!success) {
-    if (!next_callback.is_null())
-      next_callback.Run();
+    FinishResolution(next_callback, ctx, std::string());
     return;
   }
   size_t offset = 2 /* len of "0x" */ + 64 /* len of offset to array */;
   std::string contenthash;
   if (offset > result.size() ||
       !brave_wallet::DecodeString(offset, result, &contenthash)) {
-    if (!next_callback.is_null())
-      next_callback.Run();
+    FinishResolution(next_callback, ctx, std::string());
     return;
   }
 
   GURL ipfs_uri = ipfs::ContentHashToCIDv1URL(contenthash);
-  if (ipfs_uri.is_valid()) {
-    ctx->new_url_spec = ipfs_uri.spec();
-  }
+  const std::string new_url_spec =
+      ipfs_uri.is_valid() ? ipfs_uri.spec() : std::string();
+  SetResolvedHost(ctx->request_url.host(), new_url_spec);
 
-  if (!next_callback.is_null())
-    next_callback.Run();
+  FinishResolution(next_callback, ctx, new_url_spec);
 }
 
 void OnBeforeURLRequest_DecentralizedDnsRedirectWork(
@@ -111,8 +231,7 @@ void OnBeforeURLRequest_DecentralizedDnsRedirectWork(
     bool success,
     const std::string& result) {
   if (!success) {
-    if (!next_callback.is_null())
-      next_callback.Run();
+    FinishResolution(next_callback, ctx, std::string());
     return;
   }
 
@@ -120,8 +239,7 @@ void OnBeforeURLRequest_DecentralizedDnsRedirectWork(
   size_t offset = 2 /* len of "0x" */ + 64 /* len of offset to array */;
   if (offset > result.size() ||
       !brave_wallet::DecodeStringArray(result.substr(offset), &output)) {
-    if (!next_callback.is_null())
-      next_callback.Run();
+    FinishResolution(next_callback, ctx, std::string());
     return;
   }
 
@@ -142,14 +260,20 @@ void OnBeforeURLRequest_DecentralizedDnsRedirectWork(
     fallback_url = GetValue(output, RecordKeys::IPFS_REDIRECT_DOMAIN_VALUE);
   }
 
+  std::string new_url_spec;
   if (!ipfs_uri.empty()) {
-    ctx->new_url_spec = GURL("ipfs://" + ipfs_uri).spec();
+    new_url_spec = GURL("ipfs://" + ipfs_uri).spec();
   } else if (!fallback_url.empty()) {
-    ctx->new_url_spec = GURL(fallback_url).spec();
+    new_url_spec = GURL(fallback_url).spec();
   }
+  SetResolvedHost(ctx->request_url.host(), new_url_spec);
 
-  if (!next_callback.is_null())
-    next_callback.Run();
+  FinishResolution(next_callback, ctx, new_url_spec);
+}
+
+void ClearResolvedHostsForTesting() {
+  GetResolvedHostCache().Clear();
+  GetPendingResolutions().clear();
 }
 
 }  // namespace decentralized_dns
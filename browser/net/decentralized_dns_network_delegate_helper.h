@@ -14,6 +14,9 @@
 
 namespace decentralized_dns {
 
+// Only .crypto and .eth hosts are resolved through Ethereum.
+brave::RequestFilter GetDecentralizedDnsPreRedirectWorkFilter();
+
 // Issue eth_call requests via Ethereum provider such as Infura to query
 // decentralized DNS records, and redirect URL requests based on them.
 int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
@@ -32,6 +35,8 @@ void OnBeforeURLRequest_EnsRedirectWork(
     bool success,
     const std::string& ipfs_uri);
 
+void ClearResolvedHostsForTesting();
+
 }  // namespace decentralized_dns
 
 #endif  // BRAVE_BROWSER_NET_DECENTRALIZED_DNS_NETWORK_DELEGATE_HELPER_H_
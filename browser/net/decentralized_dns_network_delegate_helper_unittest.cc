@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "base/test/bind.h"
 #include "base/test/scoped_feature_list.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/components/decentralized_dns/constants.h"
@@ -37,9 +38,11 @@ class DecentralizedDnsNetworkDelegateHelperTest : public testing::Test {
   void SetUp() override {
     feature_list_.InitAndEnableFeature(features::kDecentralizedDns);
     profile_ = std::make_unique<TestingProfile>();
+    ClearResolvedHostsForTesting();
   }
 
   void TearDown() override {
+    ClearResolvedHostsForTesting();
     profile_.reset();
     local_state_.reset();
   }
@@ -266,6 +269,69 @@ TEST_F(DecentralizedDnsNetworkDelegateHelperTest,
   EXPECT_EQ("https://fallback2.test.com/", brave_request_info->new_url_spec);
 }
 
+TEST_F(DecentralizedDnsNetworkDelegateHelperTest, ResolvedHostsAreCached) {
+  local_state()->SetInteger(kENSResolveMethod,
+                            static_cast<int>(ResolveMethodTypes::ETHEREUM));
+  GURL url("http://brave.eth");
+  auto brave_request_info = std::make_shared<brave::BraveRequestInfo>(url);
+  brave_request_info->browser_context = profile();
+  int rc = OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
+      ResponseCallback(), brave_request_info);
+  EXPECT_EQ(rc, net::ERR_IO_PENDING);
+
+  std::string hash =
+      "0x0000000000000000000000000000000000000000000000000000000000000020"
+      "0000000000000000000000000000000000000000000000000000000000000026e5"
+      "0101701220f073be187e8e06039796c432a5bdd6da3f403c2f93fa5d9dbdc5547c"
+      "7fe0e3bc0000000000000000000000000000000000000000000000000000";
+  OnBeforeURLRequest_EnsRedirectWork(ResponseCallback(), brave_request_info,
+                                     true, hash);
+  const std::string new_url_spec = brave_request_info->new_url_spec;
+  EXPECT_FALSE(new_url_spec.empty());
+
+  // The next navigation is redirected without another lookup.
+  brave_request_info = std::make_shared<brave::BraveRequestInfo>(url);
+  brave_request_info->browser_context = profile();
+  rc = OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(ResponseCallback(),
+                                                          brave_request_info);
+  EXPECT_EQ(rc, net::OK);
+  EXPECT_EQ(brave_request_info->new_url_spec, new_url_spec);
+}
+
+TEST_F(DecentralizedDnsNetworkDelegateHelperTest,
+       ConcurrentRequestsShareResolution) {
+  local_state()->SetInteger(kENSResolveMethod,
+                            static_cast<int>(ResolveMethodTypes::ETHEREUM));
+  GURL url("http://brave.eth");
+  auto first_request_info = std::make_shared<brave::BraveRequestInfo>(url);
+  first_request_info->browser_context = profile();
+  int rc = OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
+      ResponseCallback(), first_request_info);
+  EXPECT_EQ(rc, net::ERR_IO_PENDING);
+
+  // A second request for the host waits for the lookup in flight.
+  int waiter_callback_count = 0;
+  auto second_request_info = std::make_shared<brave::BraveRequestInfo>(url);
+  second_request_info->browser_context = profile();
+  rc = OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
+      base::BindLambdaForTesting([&]() { waiter_callback_count++; }),
+      second_request_info);
+  EXPECT_EQ(rc, net::ERR_IO_PENDING);
+  EXPECT_EQ(waiter_callback_count, 0);
+
+  std::string hash =
+      "0x0000000000000000000000000000000000000000000000000000000000000020"
+      "0000000000000000000000000000000000000000000000000000000000000026e5"
+      "0101701220f073be187e8e06039796c432a5bdd6da3f403c2f93fa5d9dbdc5547c"
+      "7fe0e3bc0000000000000000000000000000000000000000000000000000";
+  OnBeforeURLRequest_EnsRedirectWork(ResponseCallback(), first_request_info,
+                                     true, hash);
+  EXPECT_FALSE(first_request_info->new_url_spec.empty());
+  EXPECT_EQ(second_request_info->new_url_spec,
+            first_request_info->new_url_spec);
+  EXPECT_EQ(waiter_callback_count, 1);
+}
+
 TEST_F(DecentralizedDnsNetworkDelegateHelperTest, EnsRedirectWork) {
   GURL url("http://brave.eth");
   auto brave_request_info = std::make_shared<brave::BraveRequestInfo>(url);
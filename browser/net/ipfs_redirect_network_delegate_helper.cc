@@ -6,7 +6,14 @@
 #include "brave/browser/net/ipfs_redirect_network_delegate_helper.h"
 
 #include <string>
+#include <vector>
 
+#include "base/feature_list.h"
+#include "base/strings/string_split.h"
+#include "brave/browser/ipfs/ipfs_service_factory.h"
+#include "brave/components/ipfs/features.h"
+#include "brave/components/ipfs/ipfs_constants.h"
+#include "brave/components/ipfs/ipfs_service.h"
 #include "brave/components/ipfs/ipfs_utils.h"
 #include "chrome/common/channel_info.h"
 #include "components/prefs/pref_service.h"
@@ -16,6 +23,32 @@
 
 namespace ipfs {
 
+namespace {
+
+bool IsLocalGatewayMediaRequest(const brave::BraveRequestInfo& ctx,
+                                const GURL& url) {
+  return ctx.resource_type == blink::mojom::ResourceType::kMedia &&
+         IsLocalGatewayURL(url) &&
+         base::FeatureList::IsEnabled(features::kIpfsMediaPrefetch);
+}
+
+// Returns the root CID of an x-ipfs-path value like /ipfs/[cid]/[path].
+std::string GetRootCIDFromIPFSPath(const std::string& ipfs_path) {
+  std::vector<base::StringPiece> parts = base::SplitStringPiece(
+      ipfs_path, "/", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  if (parts.size() < 2 || parts[0] != kIPFSScheme)
+    return std::string();
+  return parts[1].as_string();
+}
+
+}  // namespace
+
+brave::RequestFilter GetIPFSRedirectWorkFilter() {
+  brave::RequestFilter filter;
+  filter.schemes = {kIPFSScheme, kIPNSScheme};
+  return filter;
+}
+
 int OnBeforeURLRequest_IPFSRedirectWork(
     const brave::ResponseCallback& next_callback,
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
@@ -41,6 +74,21 @@ int OnBeforeURLRequest_IPFSRedirectWork(
         (IsDefaultGatewayURL(new_url, prefs) &&
          IsDefaultGatewayURL(ctx->initiator_url, prefs))) {
       ctx->new_url_spec = new_url.spec();
+      if (IsLocalGatewayURL(new_url) &&
+          base::FeatureList::IsEnabled(
+              features::kIpfsAdaptiveResourceProfile)) {
+        auto* service = IpfsServiceFactory::GetForContext(ctx->browser_context);
+        if (service)
+          service->NotifyDaemonActivity();
+      }
+      std::string cid, path;
+      if (IsLocalGatewayMediaRequest(*ctx, new_url) &&
+          ctx->request_url.SchemeIs(kIPFSScheme) &&
+          ParseCIDAndPathFromIPFSUrl(ctx->request_url, &cid, &path)) {
+        auto* service = IpfsServiceFactory::GetForContext(ctx->browser_context);
+        if (service)
+          service->PrefetchMediaBlocks(cid);
+      }
     } else {
       ctx->blocked_by = brave::kOtherBlocked;
     }
@@ -78,6 +126,16 @@ int OnHeadersReceived_IPFSRedirectWork(
     (*override_response_headers)->RemoveHeader("Location");
     (*override_response_headers)->AddHeader("Location", new_url.spec());
     *allowed_unsafe_redirect_url = new_url;
+  } else if (response_headers &&
+             IsLocalGatewayMediaRequest(*ctx, ctx->request_url) &&
+             response_headers->GetNormalizedHeader("x-ipfs-path",
+                                                   &ipfs_path)) {
+    std::string cid = GetRootCIDFromIPFSPath(ipfs_path);
+    auto* service = IpfsServiceFactory::GetForContext(ctx->browser_context);
+    if (service && !cid.empty()) {
+      service->OnGatewayMediaResponse(cid,
+                                      response_headers->GetContentLength());
+    }
   }
 
   return net::OK;
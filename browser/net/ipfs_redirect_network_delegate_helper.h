@@ -14,6 +14,9 @@
 
 namespace ipfs {
 
+// Only ipfs:// and ipns:// URLs get translated to a gateway.
+brave::RequestFilter GetIPFSRedirectWorkFilter();
+
 int OnBeforeURLRequest_IPFSRedirectWork(
     const brave::ResponseCallback& next_callback,
     std::shared_ptr<brave::BraveRequestInfo> ctx);
@@ -5,10 +5,12 @@
 
 #include "brave/browser/net/url_context.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
+#include "brave/browser/brave_shields/shields_settings_tab_helper.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
 #include "brave/components/brave_webtorrent/browser/webtorrent_util.h"
@@ -79,8 +81,11 @@ std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
   ctx->resource_type =
       static_cast<blink::mojom::ResourceType>(request.resource_type);
 
+  // Only main frame responses are handed to the torrent viewer, so other
+  // requests skip the extension registry lookup.
   ctx->is_webtorrent_disabled =
 #if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
+      ctx->resource_type != blink::mojom::ResourceType::kMainFrame ||
       !webtorrent::IsWebtorrentEnabled(browser_context);
 #else
       true;
@@ -134,20 +139,21 @@ std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
 
   Profile* profile = Profile::FromBrowserContext(browser_context);
   auto* map = HostContentSettingsMapFactory::GetForProfile(profile);
-  ctx->allow_brave_shields =
-      brave_shields::GetBraveShieldsEnabled(map, ctx->tab_origin);
-  ctx->allow_ads = brave_shields::GetAdControlType(map, ctx->tab_origin) ==
-                   brave_shields::ControlType::ALLOW;
+  ctx->shields_settings = brave_shields::ShieldsSettingsTabHelper::GetSnapshot(
+      ctx->frame_tree_node_id, map, ctx->tab_origin);
+  ctx->allow_brave_shields = ctx->shields_settings->shields_enabled();
+  ctx->allow_ads = ctx->shields_settings->allow_ads();
   ctx->allow_http_upgradable_resource =
-      !brave_shields::GetHTTPSEverywhereEnabled(map, ctx->tab_origin);
+      !ctx->shields_settings->https_everywhere_enabled();
 
   // HACK: after we fix multiple creations of BraveRequestInfo we should
   // use only tab_origin. Since we recreate BraveRequestInfo during consequent
   // stages of navigation, |tab_origin| changes and so does |allow_referrers|
   // flag, which is not what we want for determining referrers.
-  ctx->allow_referrers = brave_shields::AllowReferrers(
-      map,
-      ctx->redirect_source.is_empty() ? ctx->tab_origin : ctx->redirect_source);
+  ctx->allow_referrers =
+      ctx->redirect_source.is_empty()
+          ? ctx->shields_settings->allow_referrers()
+          : brave_shields::AllowReferrers(map, ctx->redirect_source);
   ctx->upload_data = GetUploadData(request);
 
   ctx->browser_context = browser_context;
@@ -163,4 +169,42 @@ std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
   return ctx;
 }
 
+constexpr uint64_t RequestFilter::kAllResourceTypes;
+
+RequestFilter::RequestFilter() = default;
+
+RequestFilter::RequestFilter(const RequestFilter& other) = default;
+
+RequestFilter::~RequestFilter() = default;
+
+// static
+uint64_t RequestFilter::ResourceTypeBit(blink::mojom::ResourceType type) {
+  DCHECK_GE(static_cast<int>(type), 0);
+  DCHECK_LT(static_cast<int>(type), 64);
+  return static_cast<uint64_t>(1) << static_cast<int>(type);
+}
+
+bool RequestFilter::Matches(const BraveRequestInfo& ctx) const {
+  if (!schemes.empty() &&
+      std::none_of(schemes.begin(), schemes.end(),
+                   [&ctx](const std::string& scheme) {
+                     return ctx.request_url.SchemeIs(scheme);
+                   })) {
+    return false;
+  }
+  if (!domains.empty() &&
+      std::none_of(domains.begin(), domains.end(),
+                   [&ctx](const std::string& domain) {
+                     return ctx.request_url.DomainIs(domain);
+                   })) {
+    return false;
+  }
+  if (resource_types != kAllResourceTypes &&
+      ctx.resource_type != BraveRequestInfo::kInvalidResourceType &&
+      !(resource_types & ResourceTypeBit(ctx.resource_type))) {
+    return false;
+  }
+  return true;
+}
+
 }  // namespace brave
@@ -9,6 +9,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "net/base/network_isolation_key.h"
 #include "net/http/http_request_headers.h"
@@ -19,6 +20,10 @@
 
 class BraveRequestHandler;
 
+namespace brave_shields {
+class ShieldsSettingsSnapshot;
+}
+
 namespace content {
 class BrowserContext;
 }
@@ -28,6 +33,7 @@ struct ResourceRequest;
 }
 
 namespace brave {
+class ReferralHeadersTable;
 struct BraveRequestInfo;
 using ResponseCallback = base::RepeatingCallback<void()>;
 }  // namespace brave
@@ -77,6 +83,10 @@ struct BraveRequestInfo {
   bool allow_ads = false;
   bool allow_http_upgradable_resource = false;
   bool allow_referrers = false;
+  // Settings of the tab the request belongs to; the allow_* fields above are
+  // filled in from it.
+  scoped_refptr<const brave_shields::ShieldsSettingsSnapshot> shields_settings;
+  // Always set for requests other than main frame navigations.
   bool is_webtorrent_disabled = false;
   int frame_tree_node_id = 0;
   uint64_t request_identifier = 0;
@@ -93,7 +103,9 @@ struct BraveRequestInfo {
 
   GURL* allowed_unsafe_redirect_url = nullptr;
   BraveNetworkDelegateEventType event_type = kUnknownEventType;
-  const base::ListValue* referral_headers_list = nullptr;
+  // Shared with the request handler; a pref change swaps in a new table, so
+  // this stays valid while the request is in flight.
+  std::shared_ptr<const brave::ReferralHeadersTable> referral_headers;
   BlockedBy blocked_by = kNotBlocked;
   std::string mock_data_url;
   GURL ipfs_gateway_url;
@@ -131,6 +143,29 @@ struct BraveRequestInfo {
   DISALLOW_COPY_AND_ASSIGN(BraveRequestInfo);
 };
 
+// Describes the requests a network delegate helper can act on, so that
+// BraveRequestHandler can skip it without dispatching to it. Empty lists match
+// everything; a helper still has to do its own checks, the filter only needs
+// to be a superset of what the helper handles.
+struct RequestFilter {
+  static constexpr uint64_t kAllResourceTypes = ~static_cast<uint64_t>(0);
+
+  RequestFilter();
+  RequestFilter(const RequestFilter& other);
+  ~RequestFilter();
+
+  static uint64_t ResourceTypeBit(blink::mojom::ResourceType type);
+
+  bool Matches(const BraveRequestInfo& ctx) const;
+
+  std::vector<std::string> schemes;
+  // The request host has to be one of these domains or a subdomain of one.
+  std::vector<std::string> domains;
+  // Mask of ResourceTypeBit() values. Requests with an unknown resource type
+  // always match.
+  uint64_t resource_types = kAllResourceTypes;
+};
+
 // ResponseListener
 using OnBeforeURLRequestCallback =
     base::RepeatingCallback<int(const ResponseCallback& next_callback,
@@ -7,10 +7,12 @@
 
 #include <algorithm>
 
+#include "base/feature_list.h"
 #include "brave/browser/tor/tor_profile_service_factory.h"
 #include "brave/browser/translate/buildflags/buildflags.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
+#include "brave/components/tor/features.h"
 #include "brave/components/tor/tor_constants.h"
 #include "brave/components/tor/tor_profile_service.h"
 #include "chrome/browser/profiles/profile.h"
@@ -57,6 +59,24 @@ void TorProfileManager::SwitchToTorProfile(
                                         Profile::CREATE_STATUS_INITIALIZED);
 }
 
+// static
+void TorProfileManager::PrewarmTor(Profile* original_profile) {
+  DCHECK(original_profile);
+  if (!base::FeatureList::IsEnabled(tor::features::kTorPrewarm) ||
+      TorProfileServiceFactory::IsTorDisabled()) {
+    return;
+  }
+  Profile* tor_profile =
+      TorProfileManager::GetInstance().GetTorProfile(original_profile);
+  tor::TorProfileService* service =
+      TorProfileServiceFactory::GetForContext(tor_profile);
+  DCHECK(service);
+  // Same as SwitchToTorProfile, the tor process is launched once the tor
+  // binary is ready. It keeps its data directory, and so its cached consensus,
+  // between sessions, which makes this mostly a matter of building circuits.
+  service->RegisterTorClientUpdater();
+}
+
 // static
 void TorProfileManager::CloseTorProfileWindows(Profile* tor_profile) {
   DCHECK(tor_profile);
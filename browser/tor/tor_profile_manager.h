@@ -20,6 +20,11 @@ class TorProfileManager : public BrowserListObserver, public ProfileObserver {
   static void SwitchToTorProfile(Profile* original_profile,
                                  ProfileManager::CreateCallback callback);
   static void CloseTorProfileWindows(Profile* tor_profile);
+  // Starts Tor for the Tor profile of |original_profile| without opening a
+  // window, if tor::features::kTorPrewarm is enabled. Cheap to call again
+  // once Tor is starting, e.g. whenever a "New Tor window" command is about
+  // to be used.
+  static void PrewarmTor(Profile* original_profile);
   Profile* GetTorProfile(Profile* original_profile);
 
  private:
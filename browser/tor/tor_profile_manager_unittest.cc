@@ -6,10 +6,13 @@
 #include <memory>
 
 #include "base/test/bind.h"
+#include "base/test/scoped_feature_list.h"
 #include "brave/browser/tor/tor_profile_manager.h"
 #include "brave/browser/translate/buildflags/buildflags.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
+#include "brave/components/tor/features.h"
+#include "brave/components/tor/tor_constants.h"
 #include "chrome/common/pref_names.h"
 #include "chrome/test/base/testing_browser_process.h"
 #include "chrome/test/base/testing_profile.h"
@@ -81,3 +84,21 @@ TEST_F(TorProfileManagerUnitTest, InitTorProfileUserPrefs) {
       tor_profile->GetPrefs()->GetBoolean(prefs::kOfferTranslateEnabled));
 #endif
 }
+
+TEST_F(TorProfileManagerUnitTest, PrewarmTorDisabledByDefault) {
+  TorProfileManager::PrewarmTor(profile());
+  EXPECT_FALSE(profile()->HasOffTheRecordProfile(
+      Profile::OTRProfileID(tor::kTorProfileID)));
+}
+
+TEST_F(TorProfileManagerUnitTest, PrewarmTorCreatesTorProfile) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(tor::features::kTorPrewarm);
+
+  TorProfileManager::PrewarmTor(profile());
+  ASSERT_TRUE(profile()->HasOffTheRecordProfile(
+      Profile::OTRProfileID(tor::kTorProfileID)));
+  EXPECT_EQ(TorProfileManager::GetInstance().GetTorProfile(profile()),
+            profile()->GetOffTheRecordProfile(
+                Profile::OTRProfileID(tor::kTorProfileID)));
+}
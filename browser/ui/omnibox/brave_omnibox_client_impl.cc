@@ -7,18 +7,30 @@
 
 #include <algorithm>
 
+#include "base/callback_helpers.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/stl_util.h"
 #include "base/values.h"
 #include "brave/browser/autocomplete/brave_autocomplete_scheme_classifier.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_search/common/brave_search_utils.h"
 #include "brave/components/weekly_storage/weekly_storage.h"
+#include "chrome/browser/predictors/loading_predictor.h"
+#include "chrome/browser/predictors/loading_predictor_factory.h"
 #include "chrome/browser/profiles/profile.h"
+#include "chrome/browser/search_engines/template_url_service_factory.h"
 #include "chrome/browser/ui/omnibox/chrome_omnibox_client.h"
 #include "chrome/browser/ui/omnibox/chrome_omnibox_edit_controller.h"
 #include "components/omnibox/browser/autocomplete_match.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
+#include "components/search_engines/template_url.h"
+#include "components/search_engines/template_url_service.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/service_worker_context.h"
+#include "content/public/browser/storage_partition.h"
+#include "url/gurl.h"
+#include "url/url_constants.h"
 
 namespace {
 
@@ -90,3 +102,40 @@ void BraveOmniboxClientImpl::OnInputAccepted(const AutocompleteMatch& match) {
     RecordSearchEventP3A(storage.GetWeeklySum());
   }
 }
+
+void BraveOmniboxClientImpl::OnFocusChanged(OmniboxFocusState state,
+                                            OmniboxFocusChangeReason reason) {
+  ChromeOmniboxClient::OnFocusChanged(state, reason);
+  if (state != OMNIBOX_FOCUS_NONE)
+    WarmUpBraveSearch();
+}
+
+void BraveOmniboxClientImpl::WarmUpBraveSearch() {
+  TemplateURLService* template_url_service =
+      TemplateURLServiceFactory::GetForProfile(profile_);
+  if (!template_url_service)
+    return;
+  const TemplateURL* default_provider =
+      template_url_service->GetDefaultSearchProvider();
+  if (!default_provider)
+    return;
+
+  const GURL search_url = default_provider->GenerateSearchURL(
+      template_url_service->search_terms_data());
+  if (!search_url.SchemeIs(url::kHttpsScheme) ||
+      !brave_search::IsAllowedHost(search_url))
+    return;
+
+  // Both are no-ops when the worker is already running or a connection to the
+  // origin is already open, so this is cheap to repeat on every focus.
+  content::BrowserContext::GetDefaultStoragePartition(profile_)
+      ->GetServiceWorkerContext()
+      ->StartServiceWorkerForNavigationHint(search_url, base::DoNothing());
+
+  if (auto* loading_predictor =
+          predictors::LoadingPredictorFactory::GetForProfile(profile_)) {
+    loading_predictor->PrepareForPageLoad(search_url.GetOrigin(),
+                                          predictors::HintOrigin::OMNIBOX,
+                                          /* preconnectable */ true);
+  }
+}
@@ -8,6 +8,7 @@
 
 #include "brave/browser/autocomplete/brave_autocomplete_scheme_classifier.h"
 #include "chrome/browser/ui/omnibox/chrome_omnibox_client.h"
+#include "components/omnibox/common/omnibox_focus_state.h"
 
 class OmniboxEditController;
 class PrefRegistrySimple;
@@ -24,8 +25,15 @@ class BraveOmniboxClientImpl : public ChromeOmniboxClient {
   bool IsAutocompleteEnabled() const override;
 
   void OnInputAccepted(const AutocompleteMatch& match) override;
+  void OnFocusChanged(OmniboxFocusState state,
+                      OmniboxFocusChangeReason reason) override;
 
  private:
+  // Starts the Brave Search service worker and preconnects to its origin when
+  // Brave Search is the default search provider, so the result page for the
+  // query being typed doesn't wait on either.
+  void WarmUpBraveSearch();
+
   Profile* profile_;
   BraveAutocompleteSchemeClassifier scheme_classifier_;
 
@@ -150,12 +150,15 @@ void SidebarModel::OnURLVisited(history::HistoryService* history_service,
                                 const history::URLRow& row,
                                 const history::RedirectList& redirects,
                                 base::Time visit_time) {
-  const int item_count = GetAllSidebarItems().size();
   const auto items = GetAllSidebarItems();
+  const int item_count = items.size();
   for (int i = 0; i < item_count; ++i) {
     // If same url is added to history service, try to fetch favicon to update
     // for item.
     if (items[i].url == row.url() && data_[i]->need_favicon_update()) {
+      // Only one refetch is queued per item however often the url is visited.
+      // OnGetLocalFaviconImage() flags the item again if it still fails.
+      data_[i]->set_need_favicon_update(false);
       // Favicon seems cached after this callback.
       // TODO(simonhong): Find more deterministic method instead of using
       // delayed task.
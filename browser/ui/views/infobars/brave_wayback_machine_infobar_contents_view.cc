@@ -9,10 +9,14 @@
 #include <string>
 #include <utility>
 
+#include "base/bind.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+
 #include "brave/app/vector_icons/vector_icons.h"
 #include "brave/browser/themes/theme_properties.h"
 #include "brave/browser/ui/views/infobars/brave_wayback_machine_infobar_button_container.h"
 #include "brave/components/brave_wayback_machine/brave_wayback_machine_infobar_delegate.h"
+#include "brave/components/brave_wayback_machine/brave_wayback_machine_tab_helper.h"
 #include "brave/components/brave_wayback_machine/pref_names.h"
 #include "brave/components/brave_wayback_machine/wayback_machine_url_fetcher.h"
 #include "brave/grit/brave_generated_resources.h"
@@ -83,10 +87,17 @@ void BraveWaybackMachineInfoBarContentsView::OnThemeChanged() {
 }
 
 void BraveWaybackMachineInfoBarContentsView::OnWaybackURLFetched(
-    const GURL& latest_wayback_url) {
+    const GURL& latest_wayback_url,
+    bool lookup_failed) {
   DCHECK(wayback_url_fetch_requested_);
   wayback_url_fetch_requested_ = false;
 
+  // A failed lookup says nothing about the page, so the next check for it
+  // asks archive.org again.
+  auto* tab_helper = BraveWaybackMachineTabHelper::FromWebContents(contents_);
+  if (tab_helper && !lookup_failed)
+    tab_helper->CacheWaybackURL(fetching_url_, latest_wayback_url);
+
   fetch_url_button_->StopThrobber();
   Layout();
 
@@ -251,8 +262,23 @@ SkColor BraveWaybackMachineInfoBarContentsView::GetColor(int id) const {
 }
 
 void BraveWaybackMachineInfoBarContentsView::FetchWaybackURL() {
+  fetching_url_ = contents_->GetVisibleURL();
+
+  GURL cached_wayback_url;
+  auto* tab_helper = BraveWaybackMachineTabHelper::FromWebContents(contents_);
+  if (tab_helper &&
+      tab_helper->GetCachedWaybackURL(fetching_url_, &cached_wayback_url)) {
+    // Answer asynchronously like a real fetch so callers see the same order.
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(
+            &BraveWaybackMachineInfoBarContentsView::OnWaybackURLFetched,
+            weak_factory_.GetWeakPtr(), cached_wayback_url, false));
+  } else {
+    wayback_machine_url_fetcher_.Fetch(fetching_url_);
+  }
+
   fetch_url_button_->StartThrobber();
-  wayback_machine_url_fetcher_.Fetch(contents_->GetVisibleURL());
   Layout();
 }
 
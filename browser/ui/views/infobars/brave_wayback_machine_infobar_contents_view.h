@@ -8,8 +8,10 @@
 
 #include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "brave/components/brave_wayback_machine/wayback_machine_url_fetcher.h"
 #include "ui/views/view.h"
+#include "url/gurl.h"
 
 namespace content {
 class WebContents;
@@ -21,7 +23,6 @@ class Label;
 }  // namespace views
 
 class BraveWaybackMachineInfoBarButtonContainer;
-class GURL;
 class PrefService;
 
 // Includes all view controls except close button that managed by InfoBarView.
@@ -46,7 +47,8 @@ class BraveWaybackMachineInfoBarContentsView
   void OnThemeChanged() override;
 
   // WaybackMachineURLFetcher::Client overrides:
-  void OnWaybackURLFetched(const GURL& latest_wayback_url) override;
+  void OnWaybackURLFetched(const GURL& latest_wayback_url,
+                           bool lookup_failed) override;
 
   void InitializeChildren();
   views::Label* CreateLabel(const std::u16string& text);
@@ -71,6 +73,11 @@ class BraveWaybackMachineInfoBarContentsView
   PrefService* pref_service_ = nullptr;
   views::ImageView* wayback_spot_graphic_ = nullptr;
   bool wayback_url_fetch_requested_ = false;
+  // The page being looked up, so its result can be cached for this tab.
+  GURL fetching_url_;
+
+  base::WeakPtrFactory<BraveWaybackMachineInfoBarContentsView> weak_factory_{
+      this};
 };
 
 #endif  // BRAVE_BROWSER_UI_VIEWS_INFOBARS_BRAVE_WAYBACK_MACHINE_INFOBAR_CONTENTS_VIEW_H_
@@ -13,7 +13,9 @@
 
 #include "base/i18n/time_formatting.h"
 #include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/task/thread_pool.h"
 #include "base/time/time.h"
 #include "bat/ledger/mojom_structs.h"
 #include "brave/browser/brave_ads/ads_service_factory.h"
@@ -74,6 +76,7 @@ class RewardsDOMHandler : public WebUIMessageHandler,
   void GetReconcileStamp(const base::ListValue* args);
   void SaveSetting(const base::ListValue* args);
   void OnPublisherList(ledger::type::PublisherInfoList list);
+  void OnListConverted(const std::string& function_name, base::Value list);
   void OnExcludedSiteList(ledger::type::PublisherInfoList list);
   void ExcludePublisher(const base::ListValue* args);
   void RestorePublishers(const base::ListValue* args);
@@ -298,6 +301,8 @@ class RewardsDOMHandler : public WebUIMessageHandler,
 
   brave_rewards::RewardsService* rewards_service_;  // NOT OWNED
   brave_ads::AdsService* ads_service_;  // NOT OWNED
+  // Converts lists for the page in the order they were received
+  scoped_refptr<base::SequencedTaskRunner> conversion_task_runner_;
   base::WeakPtrFactory<RewardsDOMHandler> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(RewardsDOMHandler);
@@ -313,9 +318,119 @@ const char kAdsSubdivisionTargeting[] = "adsSubdivisionTargeting";
 const char kAutoDetectedAdsSubdivisionTargeting[] =
     "automaticallyDetectedAdsSubdivisionTargeting";
 
+// Publisher and contribution lists can hold thousands of entries, so they are
+// converted for the page on a worker sequence rather than the UI thread.
+
+base::Value ConvertContributeList(ledger::type::PublisherInfoList list) {
+  base::ListValue publishers;
+  for (auto const& item : list) {
+    auto publisher = std::make_unique<base::DictionaryValue>();
+    publisher->SetString("id", item->id);
+    publisher->SetDouble("percentage", item->percent);
+    publisher->SetString("publisherKey", item->id);
+    publisher->SetInteger("status", static_cast<int>(item->status));
+    publisher->SetInteger("excluded", static_cast<int>(item->excluded));
+    publisher->SetString("name", item->name);
+    publisher->SetString("provider", item->provider);
+    publisher->SetString("url", item->url);
+    publisher->SetString("favIcon", item->favicon_url);
+    publishers.Append(std::move(publisher));
+  }
+
+  return std::move(publishers);
+}
+
+base::Value ConvertExcludedList(ledger::type::PublisherInfoList list) {
+  base::ListValue publishers;
+  for (auto const& item : list) {
+    auto publisher = std::make_unique<base::DictionaryValue>();
+    publisher->SetString("id", item->id);
+    publisher->SetInteger("status", static_cast<int>(item->status));
+    publisher->SetString("name", item->name);
+    publisher->SetString("provider", item->provider);
+    publisher->SetString("url", item->url);
+    publisher->SetString("favIcon", item->favicon_url);
+    publishers.Append(std::move(publisher));
+  }
+
+  return std::move(publishers);
+}
+
+base::Value ConvertRecurringTips(ledger::type::PublisherInfoList list) {
+  base::ListValue publishers;
+
+  for (auto const& item : list) {
+    auto publisher = std::make_unique<base::DictionaryValue>();
+    publisher->SetString("id", item->id);
+    publisher->SetDouble("percentage", item->weight);
+    publisher->SetString("publisherKey", item->id);
+    publisher->SetInteger("status", static_cast<int>(item->status));
+    publisher->SetInteger("excluded", static_cast<int>(item->excluded));
+    publisher->SetString("name", item->name);
+    publisher->SetString("provider", item->provider);
+    publisher->SetString("url", item->url);
+    publisher->SetString("favIcon", item->favicon_url);
+    publisher->SetInteger("tipDate", 0);
+    publishers.Append(std::move(publisher));
+  }
+
+  return std::move(publishers);
+}
+
+base::Value ConvertOneTimeTips(ledger::type::PublisherInfoList list) {
+  base::ListValue publishers;
+
+  for (auto const& item : list) {
+    auto publisher = std::make_unique<base::DictionaryValue>();
+    publisher->SetString("id", item->id);
+    publisher->SetDouble("percentage", item->weight);
+    publisher->SetString("publisherKey", item->id);
+    publisher->SetInteger("status", static_cast<int>(item->status));
+    publisher->SetInteger("excluded", static_cast<int>(item->excluded));
+    publisher->SetString("name", item->name);
+    publisher->SetString("provider", item->provider);
+    publisher->SetString("url", item->url);
+    publisher->SetString("favIcon", item->favicon_url);
+    publisher->SetInteger("tipDate", item->reconcile_stamp);
+    publishers.Append(std::move(publisher));
+  }
+
+  return std::move(publishers);
+}
+
+base::Value ConvertPendingContributions(
+    ledger::type::PendingContributionInfoList list) {
+  base::ListValue contributions;
+  for (auto const& item : list) {
+    auto contribution =
+        std::make_unique<base::Value>(base::Value::Type::DICTIONARY);
+    contribution->SetKey("id", base::Value(static_cast<int>(item->id)));
+    contribution->SetKey("publisherKey", base::Value(item->publisher_key));
+    contribution->SetKey("status",
+        base::Value(static_cast<int>(item->status)));
+    contribution->SetKey("name", base::Value(item->name));
+    contribution->SetKey("provider", base::Value(item->provider));
+    contribution->SetKey("url", base::Value(item->url));
+    contribution->SetKey("favIcon", base::Value(item->favicon_url));
+    contribution->SetKey("amount", base::Value(item->amount));
+    contribution->SetKey("addedDate",
+        base::Value(std::to_string(item->added_date)));
+    contribution->SetKey("type", base::Value(static_cast<int>(item->type)));
+    contribution->SetKey("viewingId", base::Value(item->viewing_id));
+    contribution->SetKey("expirationDate",
+        base::Value(std::to_string(item->expiration_date)));
+    contributions.Append(std::move(contribution));
+  }
+
+  return std::move(contributions);
+}
+
 }  // namespace
 
-RewardsDOMHandler::RewardsDOMHandler() : weak_factory_(this) {}
+RewardsDOMHandler::RewardsDOMHandler()
+    : conversion_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::TaskPriority::USER_VISIBLE})),
+      weak_factory_(this) {}
 
 RewardsDOMHandler::~RewardsDOMHandler() {}
 
@@ -910,22 +1025,21 @@ void RewardsDOMHandler::OnPublisherList(ledger::type::PublisherInfoList list) {
     return;
   }
 
-  auto publishers = std::make_unique<base::ListValue>();
-  for (auto const& item : list) {
-    auto publisher = std::make_unique<base::DictionaryValue>();
-    publisher->SetString("id", item->id);
-    publisher->SetDouble("percentage", item->percent);
-    publisher->SetString("publisherKey", item->id);
-    publisher->SetInteger("status", static_cast<int>(item->status));
-    publisher->SetInteger("excluded", static_cast<int>(item->excluded));
-    publisher->SetString("name", item->name);
-    publisher->SetString("provider", item->provider);
-    publisher->SetString("url", item->url);
-    publisher->SetString("favIcon", item->favicon_url);
-    publishers->Append(std::move(publisher));
+  conversion_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&ConvertContributeList, std::move(list)),
+      base::BindOnce(&RewardsDOMHandler::OnListConverted,
+                     weak_factory_.GetWeakPtr(),
+                     std::string("brave_rewards.contributeList")));
+}
+
+void RewardsDOMHandler::OnListConverted(const std::string& function_name,
+                                        base::Value list) {
+  if (!IsJavascriptAllowed()) {
+    return;
   }
 
-  CallJavascriptFunction("brave_rewards.contributeList", *publishers);
+  CallJavascriptFunction(function_name, list);
 }
 
 void RewardsDOMHandler::OnExcludedSiteList(
@@ -934,19 +1048,12 @@ void RewardsDOMHandler::OnExcludedSiteList(
     return;
   }
 
-  auto publishers = std::make_unique<base::ListValue>();
-  for (auto const& item : list) {
-    auto publisher = std::make_unique<base::DictionaryValue>();
-    publisher->SetString("id", item->id);
-    publisher->SetInteger("status", static_cast<int>(item->status));
-    publisher->SetString("name", item->name);
-    publisher->SetString("provider", item->provider);
-    publisher->SetString("url", item->url);
-    publisher->SetString("favIcon", item->favicon_url);
-    publishers->Append(std::move(publisher));
-  }
-
-  CallJavascriptFunction("brave_rewards.excludedList", *publishers);
+  conversion_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&ConvertExcludedList, std::move(list)),
+      base::BindOnce(&RewardsDOMHandler::OnListConverted,
+                     weak_factory_.GetWeakPtr(),
+                     std::string("brave_rewards.excludedList")));
 }
 
 void RewardsDOMHandler::OnGetContributionAmount(double amount) {
@@ -1007,48 +1114,26 @@ void RewardsDOMHandler::OnGetRecurringTips(
   if (!IsJavascriptAllowed()) {
     return;
   }
-  auto publishers = std::make_unique<base::ListValue>();
 
-  for (auto const& item : list) {
-    auto publisher = std::make_unique<base::DictionaryValue>();
-    publisher->SetString("id", item->id);
-    publisher->SetDouble("percentage", item->weight);
-    publisher->SetString("publisherKey", item->id);
-    publisher->SetInteger("status", static_cast<int>(item->status));
-    publisher->SetInteger("excluded", static_cast<int>(item->excluded));
-    publisher->SetString("name", item->name);
-    publisher->SetString("provider", item->provider);
-    publisher->SetString("url", item->url);
-    publisher->SetString("favIcon", item->favicon_url);
-    publisher->SetInteger("tipDate", 0);
-    publishers->Append(std::move(publisher));
-  }
-
-  CallJavascriptFunction("brave_rewards.recurringTips", *publishers);
+  conversion_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&ConvertRecurringTips, std::move(list)),
+      base::BindOnce(&RewardsDOMHandler::OnListConverted,
+                     weak_factory_.GetWeakPtr(),
+                     std::string("brave_rewards.recurringTips")));
 }
 
 void RewardsDOMHandler::OnGetOneTimeTips(ledger::type::PublisherInfoList list) {
   if (!IsJavascriptAllowed()) {
     return;
   }
-  auto publishers = std::make_unique<base::ListValue>();
-
-  for (auto const& item : list) {
-    auto publisher = std::make_unique<base::DictionaryValue>();
-    publisher->SetString("id", item->id);
-    publisher->SetDouble("percentage", item->weight);
-    publisher->SetString("publisherKey", item->id);
-    publisher->SetInteger("status", static_cast<int>(item->status));
-    publisher->SetInteger("excluded", static_cast<int>(item->excluded));
-    publisher->SetString("name", item->name);
-    publisher->SetString("provider", item->provider);
-    publisher->SetString("url", item->url);
-    publisher->SetString("favIcon", item->favicon_url);
-    publisher->SetInteger("tipDate", item->reconcile_stamp);
-    publishers->Append(std::move(publisher));
-  }
 
-  CallJavascriptFunction("brave_rewards.currentTips", *publishers);
+  conversion_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&ConvertOneTimeTips, std::move(list)),
+      base::BindOnce(&RewardsDOMHandler::OnListConverted,
+                     weak_factory_.GetWeakPtr(),
+                     std::string("brave_rewards.currentTips")));
 }
 
 void RewardsDOMHandler::GetOneTimeTips(const base::ListValue *args) {
@@ -1476,29 +1561,12 @@ void RewardsDOMHandler::OnGetPendingContributions(
     return;
   }
 
-  auto contributions = std::make_unique<base::ListValue>();
-  for (auto const& item : list) {
-    auto contribution =
-        std::make_unique<base::Value>(base::Value::Type::DICTIONARY);
-    contribution->SetKey("id", base::Value(static_cast<int>(item->id)));
-    contribution->SetKey("publisherKey", base::Value(item->publisher_key));
-    contribution->SetKey("status",
-        base::Value(static_cast<int>(item->status)));
-    contribution->SetKey("name", base::Value(item->name));
-    contribution->SetKey("provider", base::Value(item->provider));
-    contribution->SetKey("url", base::Value(item->url));
-    contribution->SetKey("favIcon", base::Value(item->favicon_url));
-    contribution->SetKey("amount", base::Value(item->amount));
-    contribution->SetKey("addedDate",
-        base::Value(std::to_string(item->added_date)));
-    contribution->SetKey("type", base::Value(static_cast<int>(item->type)));
-    contribution->SetKey("viewingId", base::Value(item->viewing_id));
-    contribution->SetKey("expirationDate",
-        base::Value(std::to_string(item->expiration_date)));
-    contributions->Append(std::move(contribution));
-  }
-
-  CallJavascriptFunction("brave_rewards.pendingContributions", *contributions);
+  conversion_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&ConvertPendingContributions, std::move(list)),
+      base::BindOnce(&RewardsDOMHandler::OnListConverted,
+                     weak_factory_.GetWeakPtr(),
+                     std::string("brave_rewards.pendingContributions")));
 }
 
 void RewardsDOMHandler::RemovePendingContribution(
@@ -1117,6 +1117,7 @@ void CustomizeWebUIHTMLSource(const std::string &name,
         { "torProxyURI", IDS_TOR_INTERNALS_TOR_PROXY_URI },
         { "torConnectionStatus", IDS_TOR_INTERNALS_TOR_CONNECTION_STATUS },
         { "torInitProgress", IDS_TOR_INTERNALS_TOR_INIT_PROGRESS },
+        { "torStreamConnectTime", IDS_TOR_INTERNALS_TOR_STREAM_CONNECT_TIME },
       }
     }, {
 #endif
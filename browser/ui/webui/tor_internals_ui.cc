@@ -49,6 +49,10 @@ void TorInternalsDOMHandler::HandleGetTorGeneralInfo(
                  static_cast<int>(tor_launcher_factory_->GetTorPid()));
   info.SetStringKey("torProxyURI", tor_launcher_factory_->GetTorProxyURI());
   info.SetBoolKey("isTorConnected", tor_launcher_factory_->IsTorConnected());
+  info.SetIntKey("streamConnectTimeMs",
+                 static_cast<int>(tor_launcher_factory_
+                                      ->GetAverageStreamConnectTime()
+                                      .InMilliseconds()));
   web_ui()->CallJavascriptFunctionUnsafe("tor_internals.onGetTorGeneralInfo",
                                          std::move(info));
 }
@@ -0,0 +1,22 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_CHROMIUM_SRC_BASE_TRACE_EVENT_BUILTIN_CATEGORIES_H_
+#define BRAVE_CHROMIUM_SRC_BASE_TRACE_EVENT_BUILTIN_CATEGORIES_H_
+
+// Trace categories used by Brave components. Keep them in sync with
+// |kBraveTraceStartupCategories| in brave/app/brave_main_delegate.cc.
+#define BRAVE_INTERNAL_TRACE_LIST_BUILTIN_CATEGORIES(X) \
+  X("brave.ads")                                        \
+  X("brave.ipfs")                                       \
+  X("brave.p3a")                                        \
+  X("brave.rewards")                                    \
+  X("brave.shields")                                    \
+  X("brave.tor")                                        \
+  X("brave.wallet")
+
+#include "../../../../base/trace_event/builtin_categories.h"
+
+#endif  // BRAVE_CHROMIUM_SRC_BASE_TRACE_EVENT_BUILTIN_CATEGORIES_H_
@@ -34,6 +34,13 @@ void BraveMigrateOtherNodeFolder(BookmarkModel* model) {
 void BraveClearSyncV1MetaInfo(BookmarkModel* model) {
   CHECK(model);
   CHECK(model->loaded());
+  static const char* const kSyncV1MetaInfoKeys[] = {
+      "object_id", "order", "parent_object_id", "position_in_parent",
+      "sync_timestamp", "version",
+      // These might exist if user uses v1 since the very beginning when we
+      // integrates with chromium sync
+      "originator_cache_guid", "originator_client_item_id", "mtime", "ctime"};
+
   model->BeginExtensiveChanges();
   ui::TreeNodeIterator<const BookmarkNode> iterator(model->root_node());
   while (iterator.has_next()) {
@@ -43,21 +50,20 @@ void BraveClearSyncV1MetaInfo(BookmarkModel* model) {
     if (model->is_permanent_node(node)) {
       const_cast<BookmarkNode*>(node)->SetMetaInfoMap(
           BookmarkNode::MetaInfoMap());
+      continue;
     }
 
-    model->DeleteNodeMetaInfo(node, "object_id");
-    model->DeleteNodeMetaInfo(node, "order");
-    model->DeleteNodeMetaInfo(node, "parent_object_id");
-    model->DeleteNodeMetaInfo(node, "position_in_parent");
-    model->DeleteNodeMetaInfo(node, "sync_timestamp");
-    model->DeleteNodeMetaInfo(node, "version");
+    const BookmarkNode::MetaInfoMap* meta_info_map = node->GetMetaInfoMap();
+    if (!meta_info_map)
+      continue;
 
-    // These might exist if user uses v1 since the very beginning when we
-    // integrates with chromium sync
-    model->DeleteNodeMetaInfo(node, "originator_cache_guid");
-    model->DeleteNodeMetaInfo(node, "originator_client_item_id");
-    model->DeleteNodeMetaInfo(node, "mtime");
-    model->DeleteNodeMetaInfo(node, "ctime");
+    // Strip all keys at once, so each node is changed, saved and reported to
+    // observers once rather than once per key.
+    BookmarkNode::MetaInfoMap new_meta_info_map(*meta_info_map);
+    for (const char* key : kSyncV1MetaInfoKeys)
+      new_meta_info_map.erase(key);
+    if (new_meta_info_map.size() != meta_info_map->size())
+      model->SetNodeMetaInfoMap(node, new_meta_info_map);
   }
   model->EndExtensiveChanges();
 }
@@ -6,8 +6,20 @@
 #include "content/public/browser/tld_ephemeral_lifetime.h"
 
 #include <map>
-
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/containers/contains.h"
+#include "base/memory/ptr_util.h"
+#include "base/memory/weak_ptr.h"
 #include "base/no_destructor.h"
+#include "base/supports_user_data.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/session_storage_namespace.h"
+#include "content/public/browser/storage_partition.h"
 #include "services/network/public/mojom/cookie_manager.mojom.h"
 
 namespace content {
@@ -26,6 +38,70 @@ TLDEphemeralLifetimeMap& active_tld_storage_areas() {
   return *active_storage_areas.get();
 }
 
+const char kEphemeralStorageTeardownKey[] = "ephemeral_storage_teardown";
+
+// Collects the storage domains whose last tab went away, so that closing a
+// window with many tabs sends one cookie deletion per storage partition rather
+// than one per domain. Owned by the BrowserContext, so a pending flush is
+// dropped together with the context's storage partitions.
+class EphemeralStorageTeardown : public base::SupportsUserData::Data {
+ public:
+  static EphemeralStorageTeardown* Get(BrowserContext* browser_context) {
+    return static_cast<EphemeralStorageTeardown*>(
+        browser_context->GetUserData(kEphemeralStorageTeardownKey));
+  }
+
+  static EphemeralStorageTeardown* GetOrCreate(
+      BrowserContext* browser_context) {
+    auto* teardown = Get(browser_context);
+    if (!teardown) {
+      teardown = new EphemeralStorageTeardown();
+      browser_context->SetUserData(kEphemeralStorageTeardownKey,
+                                   base::WrapUnique(teardown));
+    }
+    return teardown;
+  }
+
+  void Add(StoragePartition* storage_partition,
+           const std::string& storage_domain) {
+    const bool flush_pending = !pending_domains_.empty();
+    pending_domains_[storage_partition].push_back(storage_domain);
+    if (flush_pending)
+      return;
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&EphemeralStorageTeardown::Flush,
+                                  weak_factory_.GetWeakPtr()));
+  }
+
+  // A domain that comes back before the flush must not have its new cookies
+  // deleted, so the old ones go right away.
+  void FlushIfPending(StoragePartition* storage_partition,
+                      const std::string& storage_domain) {
+    auto it = pending_domains_.find(storage_partition);
+    if (it != pending_domains_.end() &&
+        base::Contains(it->second, storage_domain)) {
+      Flush();
+    }
+  }
+
+ private:
+  EphemeralStorageTeardown() = default;
+
+  void Flush() {
+    auto pending_domains = std::move(pending_domains_);
+    pending_domains_.clear();
+    for (auto& it : pending_domains) {
+      auto filter = network::mojom::CookieDeletionFilter::New();
+      filter->ephemeral_storage_domains = std::move(it.second);
+      it.first->GetCookieManagerForBrowserProcess()->DeleteCookies(
+          std::move(filter), base::NullCallback());
+    }
+  }
+
+  std::map<StoragePartition*, std::vector<std::string>> pending_domains_;
+  base::WeakPtrFactory<EphemeralStorageTeardown> weak_factory_{this};
+};
+
 }  // namespace
 
 TLDEphemeralLifetime::TLDEphemeralLifetime(const TLDEphemeralLifetimeKey& key,
@@ -34,14 +110,14 @@ TLDEphemeralLifetime::TLDEphemeralLifetime(const TLDEphemeralLifetimeKey& key,
   DCHECK(active_tld_storage_areas().find(key_) ==
          active_tld_storage_areas().end());
   DCHECK(storage_partition_);
+  if (auto* teardown = EphemeralStorageTeardown::Get(key_.first))
+    teardown->FlushIfPending(storage_partition_, key_.second);
   active_tld_storage_areas().emplace(key_, weak_factory_.GetWeakPtr());
 }
 
 TLDEphemeralLifetime::~TLDEphemeralLifetime() {
-  auto filter = network::mojom::CookieDeletionFilter::New();
-  filter->ephemeral_storage_domain = key_.second;
-  storage_partition_->GetCookieManagerForBrowserProcess()->DeleteCookies(
-      std::move(filter), base::NullCallback());
+  EphemeralStorageTeardown::GetOrCreate(key_.first)
+      ->Add(storage_partition_, key_.second);
 
   if (!on_destroy_callbacks_.empty()) {
     auto on_destroy_callbacks = std::move(on_destroy_callbacks_);
@@ -82,6 +158,17 @@ TLDEphemeralLifetime* TLDEphemeralLifetime::Get(
   return it != active_tld_storage_areas().end() ? it->second.get() : nullptr;
 }
 
+SessionStorageNamespace* TLDEphemeralLifetime::local_storage_namespace()
+    const {
+  return local_storage_namespace_.get();
+}
+
+void TLDEphemeralLifetime::SetLocalStorageNamespace(
+    scoped_refptr<SessionStorageNamespace> local_storage_namespace) {
+  DCHECK(!local_storage_namespace_);
+  local_storage_namespace_ = std::move(local_storage_namespace);
+}
+
 void TLDEphemeralLifetime::RegisterOnDestroyCallback(
     OnDestroyCallback callback) {
   on_destroy_callbacks_.push_back(std::move(callback));
@@ -29,13 +29,13 @@ using TLDEphemeralLifetimeKey =
     std::pair<content::BrowserContext*, std::string>;
 
 // This class is responsible for managing the lifetime of ephemeral storage
-// cookies. Each instance is shared by each top-level frame with the same
-// TLDEphemeralLifetimeKey. When the last top-level frame holding a reference
-// is destroyed or navigates to a new storage domain, storage will be
-// cleared.
+// cookies and local storage. Each instance is shared by each top-level frame
+// with the same TLDEphemeralLifetimeKey. When the last top-level frame holding
+// a reference is destroyed or navigates to a new storage domain, storage will
+// be cleared.
 //
-// TODO(mrobinson): Have this class also manage ephemeral local storage and
-// take care of handing out new instances of session storage.
+// TODO(mrobinson): Have this class also take care of handing out new instances
+// of session storage.
 class CONTENT_EXPORT TLDEphemeralLifetime
     : public base::RefCounted<TLDEphemeralLifetime> {
  public:
@@ -55,6 +55,13 @@ class CONTENT_EXPORT TLDEphemeralLifetime
 
   const TLDEphemeralLifetimeKey& key() const { return key_; }
 
+  // The ephemeral local storage namespace of the storage domain. It is only
+  // created once a tab needs it, and then lives as long as this object so that
+  // every tab of the domain keeps it alive.
+  SessionStorageNamespace* local_storage_namespace() const;
+  void SetLocalStorageNamespace(
+      scoped_refptr<SessionStorageNamespace> local_storage_namespace);
+
  private:
   friend class RefCounted<TLDEphemeralLifetime>;
   virtual ~TLDEphemeralLifetime();
@@ -63,6 +70,7 @@ class CONTENT_EXPORT TLDEphemeralLifetime
 
   TLDEphemeralLifetimeKey key_;
   StoragePartition* storage_partition_;
+  scoped_refptr<SessionStorageNamespace> local_storage_namespace_;
   std::vector<OnDestroyCallback> on_destroy_callbacks_;
 
   base::WeakPtrFactory<TLDEphemeralLifetime> weak_factory_{this};
@@ -6,8 +6,11 @@
 #ifndef BRAVE_CHROMIUM_SRC_NET_COOKIES_COOKIE_DELETION_INFO_H_
 #define BRAVE_CHROMIUM_SRC_NET_COOKIES_COOKIE_DELETION_INFO_H_
 
+#include <string>
+#include <vector>
+
 #define BRAVE_COOKIE_DELETION_INFO_H \
-  base::Optional<std::string> ephemeral_storage_domain;
+  base::Optional<std::vector<std::string>> ephemeral_storage_domains;
 
 #include "../../../../net/cookies/cookie_deletion_info.h"
 
@@ -29,6 +29,13 @@ CookieMonster::CookieMonster(scoped_refptr<PersistentCookieStore> store,
 
 CookieMonster::~CookieMonster() {}
 
+ChromiumCookieMonster* CookieMonster::FindEphemeralCookieStoreForTopFrameURL(
+    const GURL& top_frame_url) {
+  auto it =
+      ephemeral_cookie_stores_.find(URLToEphemeralStorageDomain(top_frame_url));
+  return it != ephemeral_cookie_stores_.end() ? it->second.get() : nullptr;
+}
+
 ChromiumCookieMonster*
 CookieMonster::GetOrCreateEphemeralCookieStoreForTopFrameURL(
     const GURL& top_frame_url) {
@@ -65,8 +72,9 @@ void CookieMonster::DeleteAllCreatedInTimeRangeAsync(
 
 void CookieMonster::DeleteAllMatchingInfoAsync(CookieDeletionInfo delete_info,
                                                DeleteCallback callback) {
-  if (delete_info.ephemeral_storage_domain.has_value()) {
-    ephemeral_cookie_stores_.erase(*delete_info.ephemeral_storage_domain);
+  if (delete_info.ephemeral_storage_domains.has_value()) {
+    for (const auto& domain : *delete_info.ephemeral_storage_domains)
+      ephemeral_cookie_stores_.erase(domain);
     std::move(callback).Run(0);
     return;
   }
@@ -100,7 +108,12 @@ void CookieMonster::GetEphemeralCookieListWithOptionsAsync(
     const CookieOptions& options,
     GetCookieListCallback callback) {
   ChromiumCookieMonster* ephemeral_monster =
-      GetOrCreateEphemeralCookieStoreForTopFrameURL(top_frame_url);
+      FindEphemeralCookieStoreForTopFrameURL(top_frame_url);
+  if (!ephemeral_monster) {
+    // An in-memory monster would also reply synchronously.
+    std::move(callback).Run(CookieAccessResultList(), CookieAccessResultList());
+    return;
+  }
   ephemeral_monster->GetCookieListWithOptionsAsync(url, options,
                                                    std::move(callback));
 }
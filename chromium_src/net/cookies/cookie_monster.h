@@ -51,6 +51,11 @@ class NET_EXPORT CookieMonster : public ChromiumCookieMonster {
   NetLogWithSource net_log_;
   std::map<std::string, std::unique_ptr<ChromiumCookieMonster>>
       ephemeral_cookie_stores_;
+  // Returns nullptr if nothing was stored for |top_frame_url| yet. Reads use
+  // this so that third-party frames which only read cookies don't each get a
+  // full cookie monster for their top frame site.
+  ChromiumCookieMonster* FindEphemeralCookieStoreForTopFrameURL(
+      const GURL& top_frame_url);
   ChromiumCookieMonster* GetOrCreateEphemeralCookieStoreForTopFrameURL(
       const GURL& top_frame_url);
 };
@@ -14,14 +14,22 @@ bool GetNextIndex(const std::string& hostname,
                   const net::DnsConfig& config,
                   net::DnsServerIterator* dns_server_iterator,
                   size_t* doh_server_index) {
+  // Classify the hostname once; the loop below only compares server templates.
+  const bool is_crypto_domain =
+      base::EndsWith(hostname, decentralized_dns::kCryptoDomain);
+  const bool is_eth_domain =
+      base::EndsWith(hostname, decentralized_dns::kEthDomain);
+  auto should_skip = [&](base::StringPiece server) {
+    return (!is_crypto_domain &&
+            server == decentralized_dns::kUnstoppableDomainsDoHResolver) ||
+           (!is_eth_domain && server == decentralized_dns::kENSDoHResolver);
+  };
+
   base::StringPiece server =
       config.dns_over_https_servers[*doh_server_index].server_template;
 
   // Skip decentralized DNS resolvers if it is not target TLDs.
-  while ((server == decentralized_dns::kUnstoppableDomainsDoHResolver &&
-          !base::EndsWith(hostname, decentralized_dns::kCryptoDomain)) ||
-         (server == decentralized_dns::kENSDoHResolver &&
-          !base::EndsWith(hostname, decentralized_dns::kEthDomain))) {
+  while (should_skip(server)) {
     // No next available index to attempt.
     if (!dns_server_iterator->AttemptAvailable()) {
       return false;
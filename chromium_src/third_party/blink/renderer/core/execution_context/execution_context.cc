@@ -6,7 +6,10 @@
 #include "third_party/blink/renderer/core/execution_context/execution_context.h"
 
 #include "base/command_line.h"
+#include "base/feature_list.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/strings/string_number_conversions.h"
+#include "brave/third_party/blink/renderer/brave_canvas_farbling.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "crypto/hmac.h"
 #include "third_party/blink/public/platform/web_content_settings_client.h"
@@ -14,6 +17,7 @@
 #include "third_party/blink/renderer/core/frame/local_dom_window.h"
 #include "third_party/blink/renderer/core/frame/local_frame.h"
 #include "third_party/blink/renderer/core/workers/worker_global_scope.h"
+#include "third_party/blink/renderer/platform/audio/vector_math.h"
 #include "third_party/blink/renderer/platform/bindings/script_state.h"
 #include "third_party/blink/renderer/platform/graphics/image_data_buffer.h"
 #include "third_party/blink/renderer/platform/graphics/static_bitmap_image.h"
@@ -25,31 +29,21 @@
 
 namespace {
 
+// Keys canvas farbling from a sample of the pixels rather than all of them.
+// A page that changes only unsampled pixels keeps the same farbling, so this
+// trades some fingerprinting protection for speed and stays off by default.
+const base::Feature kBraveSampledCanvasFarbling{
+    "BraveSampledCanvasFarbling", base::FEATURE_DISABLED_BY_DEFAULT};
+
 const uint64_t zero = 0;
 
 inline uint64_t lfsr_next(uint64_t v) {
   return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
 }
 
-float Identity(float value, size_t index) {
-  return value;
-}
-
-float ConstantMultiplier(double fudge_factor, float value, size_t index) {
-  return value * fudge_factor;
-}
-
-float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
-  static uint64_t v;
+// Returns a pseudo-random float between 0 and 0.1 for the LFSR value |v|.
+inline float PseudoRandomSample(uint64_t v) {
   const double maxUInt64AsDouble = UINT64_MAX;
-  if (index == 0) {
-    // start of loop, reset to initial seed which was passed in and is based on
-    // the domain key
-    v = seed;
-  }
-  // get next value in PRNG sequence
-  v = lfsr_next(v);
-  // return pseudo-random float between 0 and 0.1
   return (v / maxUInt64AsDouble) / 10;
 }
 
@@ -60,6 +54,8 @@ namespace brave {
 const char kBraveSessionToken[] = "brave_session_token";
 const char BraveSessionCache::kSupplementName[] = "BraveSessionCache";
 const int kFarbledUserAgentMaxExtraSpaces = 5;
+// Enough for every string the plugin and WebGL farbling asks for.
+const size_t kRandomStringCacheSize = 32;
 
 // acceptable letters for generating random strings
 const char kLettersForRandomStrings[] =
@@ -86,7 +82,8 @@ blink::WebContentSettingsClient* GetContentSettingsClientFor(
 }
 
 BraveSessionCache::BraveSessionCache(ExecutionContext& context)
-    : Supplement<ExecutionContext>(context) {
+    : Supplement<ExecutionContext>(context),
+      random_strings_(kRandomStringCacheSize) {
   farbling_enabled_ = false;
   scoped_refptr<const blink::SecurityOrigin> origin;
   if (auto* window = blink::DynamicTo<blink::LocalDOMWindow>(context)) {
@@ -130,7 +127,69 @@ BraveSessionCache& BraveSessionCache::From(ExecutionContext& context) {
   return *cache;
 }
 
-AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
+AudioFarblingHelper::AudioFarblingHelper()
+    : AudioFarblingHelper(Mode::kOff, 1.0, 0) {}
+
+AudioFarblingHelper::AudioFarblingHelper(Mode mode,
+                                         double fudge_factor,
+                                         uint64_t seed)
+    : mode_(mode), fudge_factor_(fudge_factor), seed_(seed) {}
+
+// static
+AudioFarblingHelper AudioFarblingHelper::FromFudgeFactor(double fudge_factor) {
+  return AudioFarblingHelper(Mode::kConstantMultiplier, fudge_factor, 0);
+}
+
+// static
+AudioFarblingHelper AudioFarblingHelper::FromPseudoRandomSeed(uint64_t seed) {
+  return AudioFarblingHelper(Mode::kPseudoRandom, 1.0, seed);
+}
+
+void AudioFarblingHelper::FarbleAudioChannel(float* data, size_t count) const {
+  switch (mode_) {
+    case Mode::kOff:
+      break;
+    case Mode::kConstantMultiplier: {
+      const float scale = fudge_factor_;
+      blink::vector_math::Vsmul(data, 1, &scale, data, 1,
+                                base::checked_cast<uint32_t>(count));
+      break;
+    }
+    case Mode::kPseudoRandom: {
+      // Each buffer is its own sequence, so the same buffer farbles the same
+      // way every time.
+      uint64_t v = seed_;
+      for (size_t i = 0; i < count; i++) {
+        v = lfsr_next(v);
+        data[i] = PseudoRandomSample(v);
+      }
+      break;
+    }
+  }
+}
+
+float AudioFarblingHelper::FarbleAudioSample(float value,
+                                             size_t index,
+                                             uint64_t* state) const {
+  switch (mode_) {
+    case Mode::kOff:
+      return value;
+    case Mode::kConstantMultiplier:
+      return value * fudge_factor_;
+    case Mode::kPseudoRandom:
+      if (index == 0) {
+        // start of loop, reset to initial seed which is based on the domain
+        // key
+        *state = seed_;
+      }
+      *state = lfsr_next(*state);
+      return PseudoRandomSample(*state);
+  }
+  NOTREACHED();
+  return value;
+}
+
+AudioFarblingHelper BraveSessionCache::GetAudioFarblingHelper(
     blink::WebContentSettingsClient* settings) {
   if (farbling_enabled_ && settings) {
     switch (settings->GetBraveFarblingLevel()) {
@@ -143,15 +202,15 @@ AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
         double fudge_factor = 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
         VLOG(1) << "audio fudge factor (based on session token) = "
                 << fudge_factor;
-        return base::BindRepeating(&ConstantMultiplier, fudge_factor);
+        return AudioFarblingHelper::FromFudgeFactor(fudge_factor);
       }
       case BraveFarblingLevel::MAXIMUM: {
         uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-        return base::BindRepeating(&PseudoRandomSequence, seed);
+        return AudioFarblingHelper::FromPseudoRandomSeed(seed);
       }
     }
   }
-  return base::BindRepeating(&Identity);
+  return AudioFarblingHelper();
 }
 
 void BraveSessionCache::PerturbPixels(blink::WebContentSettingsClient* settings,
@@ -187,21 +246,22 @@ void BraveSessionCache::PerturbPixelsInternal(const unsigned char* data,
   const size_t pixel_count = size / 4;
   // calculate initial seed to find first pixel to perturb, based on session
   // key, domain key, and canvas contents
-  crypto::HMAC h(crypto::HMAC::SHA256);
-  uint64_t session_plus_domain_key =
-      session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_);
-  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
-               sizeof session_plus_domain_key));
-  uint8_t canvas_key[32];
-  CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(pixels), size),
-               canvas_key, sizeof canvas_key));
+  const uint64_t domain_key = *reinterpret_cast<uint64_t*>(domain_key_);
+  uint8_t canvas_key[kCanvasKeySize];
+  if (base::FeatureList::IsEnabled(kBraveSampledCanvasFarbling)) {
+    ComputeCanvasKeyFromSampledPixels(session_key_, domain_key, pixels, size,
+                                      canvas_key);
+  } else {
+    ComputeCanvasKeyFromAllPixels(session_key_ ^ domain_key, pixels, size,
+                                  canvas_key);
+  }
   uint64_t v = *reinterpret_cast<uint64_t*>(canvas_key);
   uint64_t pixel_index;
   // choose which channel (R, G, or B) to perturb
   uint8_t channel;
   // iterate through 32-byte canvas key and use each bit to determine how to
   // perturb the current pixel
-  for (int i = 0; i < 32; i++) {
+  for (size_t i = 0; i < kCanvasKeySize; i++) {
     uint8_t bit = canvas_key[i];
     for (int j = 0; j < 16; j++) {
       if (j % 8 == 0)
@@ -218,11 +278,17 @@ void BraveSessionCache::PerturbPixelsInternal(const unsigned char* data,
 
 WTF::String BraveSessionCache::GenerateRandomString(std::string seed,
                                                     wtf_size_t length) {
+  auto cache_key = std::make_pair(std::move(seed), length);
+  auto it = random_strings_.Get(cache_key);
+  if (it != random_strings_.end())
+    return it->second;
+
+  const std::string& hmac_seed = cache_key.first;
   uint8_t key[32];
   crypto::HMAC h(crypto::HMAC::SHA256);
   CHECK(h.Init(reinterpret_cast<const unsigned char*>(&domain_key_),
                sizeof domain_key_));
-  CHECK(h.Sign(seed, key, sizeof key));
+  CHECK(h.Sign(hmac_seed, key, sizeof key));
   // initial PRNG seed based on session key and passed-in seed string
   uint64_t v = *reinterpret_cast<uint64_t*>(key);
   UChar* destination;
@@ -232,22 +298,32 @@ WTF::String BraveSessionCache::GenerateRandomString(std::string seed,
         kLettersForRandomStrings[v % kLettersForRandomStringsLength];
     v = lfsr_next(v);
   }
+  random_strings_.Put(std::move(cache_key), WTF::String(value));
   return value;
 }
 
 WTF::String BraveSessionCache::FarbledUserAgent(WTF::String real_user_agent) {
+  if (!farbled_user_agent_.IsNull() && real_user_agent == real_user_agent_)
+    return farbled_user_agent_;
+
   std::mt19937_64 prng = MakePseudoRandomGenerator();
   WTF::StringBuilder result;
   result.Append(real_user_agent);
   int extra = prng() % kFarbledUserAgentMaxExtraSpaces;
   for (int i = 0; i < extra; i++)
     result.Append(" ");
-  return result.ToString();
+  real_user_agent_ = real_user_agent;
+  farbled_user_agent_ = result.ToString();
+  return farbled_user_agent_;
 }
 
 std::mt19937_64 BraveSessionCache::MakePseudoRandomGenerator() {
-  uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-  return std::mt19937_64(seed);
+  // Copying a seeded engine is cheaper than seeding a new one.
+  if (!prng_) {
+    uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
+    prng_.emplace(seed);
+  }
+  return *prng_;
 }
 
 }  // namespace brave
@@ -9,8 +9,11 @@
 #include "../../../../../../../third_party/blink/renderer/core/execution_context/execution_context.h"
 
 #include <random>
+#include <string>
+#include <utility>
 
-#include "base/callback.h"
+#include "base/containers/mru_cache.h"
+#include "base/optional.h"
 
 namespace blink {
 class WebContentSettingsClient;
@@ -26,7 +29,37 @@ using blink::TraceTrait;
 
 namespace brave {
 
-typedef base::RepeatingCallback<float(float, size_t)> AudioFarblingCallback;
+// Applies Web Audio farbling for one session and domain. It is cheap to copy
+// and keeps no PRNG state of its own, so it can be used from any thread.
+class CORE_EXPORT AudioFarblingHelper {
+ public:
+  // Leaves audio untouched.
+  AudioFarblingHelper();
+  // Scales every sample by |fudge_factor|.
+  static AudioFarblingHelper FromFudgeFactor(double fudge_factor);
+  // Replaces samples with a pseudo-random sequence started from |seed|.
+  static AudioFarblingHelper FromPseudoRandomSeed(uint64_t seed);
+
+  bool IsEnabled() const { return mode_ != Mode::kOff; }
+
+  // Farbles |count| consecutive samples in place, as one sequence. Scaling
+  // goes through the platform's vectorized audio math.
+  void FarbleAudioChannel(float* data, size_t count) const;
+
+  // Farbles the |index|th sample of a sequence that is produced one sample
+  // at a time. |state| carries the PRNG between calls and is reset when
+  // |index| is 0.
+  float FarbleAudioSample(float value, size_t index, uint64_t* state) const;
+
+ private:
+  enum class Mode { kOff, kConstantMultiplier, kPseudoRandom };
+
+  AudioFarblingHelper(Mode mode, double fudge_factor, uint64_t seed);
+
+  Mode mode_;
+  double fudge_factor_;
+  uint64_t seed_;
+};
 
 CORE_EXPORT blink::WebContentSettingsClient* GetContentSettingsClientFor(
     ExecutionContext* context);
@@ -42,7 +75,7 @@ class CORE_EXPORT BraveSessionCache final
 
   static BraveSessionCache& From(ExecutionContext&);
 
-  AudioFarblingCallback GetAudioFarblingCallback(
+  AudioFarblingHelper GetAudioFarblingHelper(
       blink::WebContentSettingsClient* settings);
   void PerturbPixels(blink::WebContentSettingsClient* settings,
                      const unsigned char* data,
@@ -55,6 +88,13 @@ class CORE_EXPORT BraveSessionCache final
   bool farbling_enabled_;
   uint64_t session_key_;
   uint8_t domain_key_[32];
+  // Derived values are fixed for the lifetime of the context, so compute
+  // them once rather than on every call from script.
+  base::MRUCache<std::pair<std::string, wtf_size_t>, WTF::String>
+      random_strings_;
+  WTF::String real_user_agent_;
+  WTF::String farbled_user_agent_;
+  base::Optional<std::mt19937_64> prng_;
 
   void PerturbPixelsInternal(const unsigned char* data, size_t size);
 };
@@ -16,8 +16,8 @@
   if (ExecutionContext* context = node.GetExecutionContext()) {              \
     if (WebContentSettingsClient* settings =                                 \
             brave::GetContentSettingsClientFor(context)) {                   \
-      analyser_.audio_farbling_callback_ =                                   \
-          brave::BraveSessionCache::From(*context).GetAudioFarblingCallback( \
+      analyser_.audio_farbling_helper_ =                                     \
+          brave::BraveSessionCache::From(*context).GetAudioFarblingHelper(   \
               settings);                                                     \
     }                                                                        \
   }
@@ -17,13 +17,28 @@ using blink::WebGLAny;
 
 namespace {
 
-ScriptValue FarbleGLIntParameter(WebGL2RenderingContextBase* owner,
-                                 ScriptState* script_state,
-                                 GLenum pname,
-                                 int discard) {
-  GLint value = 0;
-  if (!owner->isContextLost())
-    owner->ContextGL()->GetIntegerv(pname, &value);
+// Returns the farbled value of |pname|, which is cached on |owner| once it has
+// been computed from a live context.
+GLint64 GetFarbledGLParameter(WebGL2RenderingContextBase* owner,
+                              ScriptState* script_state,
+                              GLenum pname,
+                              bool is_int64,
+                              int discard) {
+  auto& farbled_parameters = owner->brave_farbled_parameters();
+  auto it = farbled_parameters.find(pname);
+  if (it != farbled_parameters.end())
+    return it->second;
+
+  if (owner->isContextLost())
+    return 0;
+  GLint64 value = 0;
+  if (is_int64) {
+    owner->ContextGL()->GetInteger64v(pname, &value);
+  } else {
+    GLint int_value = 0;
+    owner->ContextGL()->GetIntegerv(pname, &int_value);
+    value = int_value;
+  }
   if (value > 0) {
     std::mt19937_64 prng =
         brave::BraveSessionCache::From(*ExecutionContext::From(script_state))
@@ -33,6 +48,16 @@ ScriptValue FarbleGLIntParameter(WebGL2RenderingContextBase* owner,
       value = value - 1;
     }
   }
+  farbled_parameters[pname] = value;
+  return value;
+}
+
+ScriptValue FarbleGLIntParameter(WebGL2RenderingContextBase* owner,
+                                 ScriptState* script_state,
+                                 GLenum pname,
+                                 int discard) {
+  const GLint value = static_cast<GLint>(GetFarbledGLParameter(
+      owner, script_state, pname, /*is_int64=*/false, discard));
   return WebGLAny(script_state, value);
 }
 
@@ -40,18 +65,8 @@ ScriptValue FarbleGLInt64Parameter(WebGL2RenderingContextBase* owner,
                                    ScriptState* script_state,
                                    GLenum pname,
                                    int discard) {
-  GLint64 value = 0;
-  if (!owner->isContextLost())
-    owner->ContextGL()->GetInteger64v(pname, &value);
-  if (value > 0) {
-    std::mt19937_64 prng =
-        brave::BraveSessionCache::From(*ExecutionContext::From(script_state))
-            .MakePseudoRandomGenerator();
-    prng.discard(discard);
-    if (prng() % 2 != 0) {
-      value = value - 1;
-    }
-  }
+  const GLint64 value = GetFarbledGLParameter(owner, script_state, pname,
+                                              /*is_int64=*/true, discard);
   return WebGLAny(script_state, value);
 }
 
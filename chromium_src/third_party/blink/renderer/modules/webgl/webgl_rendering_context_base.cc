@@ -60,23 +60,19 @@ bool AllowFingerprintingForHost(blink::CanvasRenderingContextHost* host) {
     precision = 0;                                          \
   }
 
-#define BRAVE_WEBGL_GET_PARAMETER_UNMASKED_RENDERER     \
-  if (ExtensionEnabled(kWebGLDebugRendererInfoName) &&  \
-      !AllowFingerprintingForHost(Host()))              \
-    return WebGLAny(                                    \
-        script_state,                                   \
-        String(brave::BraveSessionCache::From(          \
-                   *(Host()->GetTopExecutionContext())) \
-                   .GenerateRandomString("UNMASKED_RENDERER_WEBGL", 8)));
-
-#define BRAVE_WEBGL_GET_PARAMETER_UNMASKED_VENDOR       \
-  if (ExtensionEnabled(kWebGLDebugRendererInfoName) &&  \
-      !AllowFingerprintingForHost(Host()))              \
-    return WebGLAny(                                    \
-        script_state,                                   \
-        String(brave::BraveSessionCache::From(          \
-                   *(Host()->GetTopExecutionContext())) \
-                   .GenerateRandomString("UNMASKED_VENDOR_WEBGL", 8)));
+#define BRAVE_WEBGL_GET_PARAMETER_UNMASKED_RENDERER    \
+  if (ExtensionEnabled(kWebGLDebugRendererInfoName) && \
+      !AllowFingerprintingForHost(Host()))             \
+    return WebGLAny(script_state,                      \
+                    GetBraveFarbledUnmaskedString(     \
+                        WebGLDebugRendererInfo::kUnmaskedRendererWebgl));
+
+#define BRAVE_WEBGL_GET_PARAMETER_UNMASKED_VENDOR      \
+  if (ExtensionEnabled(kWebGLDebugRendererInfoName) && \
+      !AllowFingerprintingForHost(Host()))             \
+    return WebGLAny(script_state,                      \
+                    GetBraveFarbledUnmaskedString(     \
+                        WebGLDebugRendererInfo::kUnmaskedVendorWebgl));
 
 #define getExtension getExtension_ChromiumImpl
 #define getSupportedExtensions getSupportedExtensions_ChromiumImpl
@@ -86,16 +82,28 @@ bool AllowFingerprintingForHost(blink::CanvasRenderingContextHost* host) {
 
 namespace blink {
 
+const String& WebGLRenderingContextBase::GetBraveFarbledUnmaskedString(
+    GLenum pname) {
+  const bool renderer = pname == WebGLDebugRendererInfo::kUnmaskedRendererWebgl;
+  String& value = renderer ? brave_farbled_unmasked_renderer_
+                           : brave_farbled_unmasked_vendor_;
+  if (value.IsNull()) {
+    value = brave::BraveSessionCache::From(*(Host()->GetTopExecutionContext()))
+                .GenerateRandomString(renderer ? "UNMASKED_RENDERER_WEBGL"
+                                               : "UNMASKED_VENDOR_WEBGL",
+                                      8);
+  }
+  return value;
+}
+
 // If fingerprinting is disallowed, claim that the only supported extension is
-// WebGLDebugRendererInfo.
+// WebGLDebugRendererInfo. The real list is only built when it is returned.
 base::Optional<Vector<String>>
 WebGLRenderingContextBase::getSupportedExtensions() {
-  base::Optional<Vector<String>> real_extensions =
-      getSupportedExtensions_ChromiumImpl();
-  if (real_extensions == base::nullopt)
-    return real_extensions;
   if (AllowFingerprintingForHost(Host()))
-    return real_extensions;
+    return getSupportedExtensions_ChromiumImpl();
+  if (isContextLost())
+    return base::nullopt;
 
   Vector<String> fake_extensions;
   fake_extensions.push_back(WebGLDebugRendererInfo::ExtensionName());
@@ -10,10 +10,25 @@
   getExtension_ChromiumImpl(ScriptState*, const String& name); \
   ScriptValue getExtension
 
-#define getSupportedExtensions           \
-  getSupportedExtensions_ChromiumImpl(); \
+// Farbled values only depend on the session, the top level domain and the
+// context's real limits, so each context computes them once and then answers
+// repeated queries from its cache.
+#define getSupportedExtensions                                  \
+  getSupportedExtensions_ChromiumImpl();                        \
+  const String& GetBraveFarbledUnmaskedString(GLenum pname);    \
+  base::flat_map<GLenum, GLint64>& brave_farbled_parameters() { \
+    return brave_farbled_parameters_;                           \
+  }                                                             \
+                                                                \
+ private:                                                       \
+  String brave_farbled_unmasked_renderer_;                      \
+  String brave_farbled_unmasked_vendor_;                        \
+  base::flat_map<GLenum, GLint64> brave_farbled_parameters_;    \
+                                                                \
+ public:                                                        \
   base::Optional<Vector<String>> getSupportedExtensions
 
+#include "base/containers/flat_map.h"
 #include "../../../../../../third_party/blink/renderer/modules/webgl/webgl_rendering_context_base.h"
 
 #undef getSupportedExtensions
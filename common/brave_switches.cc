@@ -45,4 +45,9 @@ const char kDisableDnsOverHttps[] = "disable-doh";
 
 // Override update feed url. Only valid on macOS.
 const char kUpdateFeedURL[] = "update-feed-url";
+
+// Records a startup trace of Brave components to disk. The trace file and
+// duration can be changed with the regular --trace-startup-file and
+// --trace-startup-duration switches.
+const char kTraceBraveStartup[] = "trace-brave-startup";
 }  // namespace switches
@@ -33,6 +33,8 @@ extern const char kComponentUpdateIntervalInSec[];
 extern const char kDisableDnsOverHttps[];
 
 extern const char kUpdateFeedURL[];
+
+extern const char kTraceBraveStartup[];
 }  // namespace switches
 
 #endif  // BRAVE_COMMON_BRAVE_SWITCHES_H_
@@ -50,6 +50,46 @@ void engine_match(struct C_Engine *engine,
                   bool *did_match_important,
                   char **redirect);
 
+/**
+ * Checks a batch of requests against the specified `Engine`.
+ *
+ * Each request is described by the entries at the same index in the input arrays. Its results
+ * are accumulated into the entries at the same index in the output arrays with the same
+ * semantics as `engine_match`. Requests which have already matched an important rule are
+ * skipped. A `redirects` entry is only written if this engine provides a redirect, so callers
+ * should initialize it to null.
+ */
+void engine_match_batch(struct C_Engine *engine,
+                        const char *const *urls,
+                        const char *const *hosts,
+                        const char *const *tab_hosts,
+                        const bool *third_party,
+                        const char *const *resource_types,
+                        size_t requests_size,
+                        bool *did_match_rule,
+                        bool *did_match_exception,
+                        bool *did_match_important,
+                        char **redirects);
+
+/**
+ * Checks if a `url` matches against each of several `Engine`s, in order, within one call.
+ *
+ * Results are accumulated exactly as with a sequence of `engine_match` calls, but the request
+ * strings only need to cross the FFI boundary once. Checking stops after the first engine that
+ * matches an important rule. If more than one engine returns a redirect, the last one wins.
+ */
+void engines_match(struct C_Engine *const *engines,
+                   size_t engines_size,
+                   const char *url,
+                   const char *host,
+                   const char *tab_host,
+                   bool third_party,
+                   const char *resource_type,
+                   bool *did_match_rule,
+                   bool *did_match_exception,
+                   bool *did_match_important,
+                   char **redirect);
+
 /**
  * Returns any CSP directives that should be added to a subdocument or document request's response
  * headers.
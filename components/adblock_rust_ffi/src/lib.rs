@@ -98,6 +98,118 @@ pub unsafe extern "C" fn engine_match(
     };
 }
 
+/// Checks a batch of requests against the specified `Engine`.
+///
+/// Each request is described by the entries at the same index in the input arrays. Its results
+/// are accumulated into the entries at the same index in the output arrays with the same
+/// semantics as `engine_match`. Requests which have already matched an important rule are
+/// skipped. A `redirects` entry is only written if this engine provides a redirect, so callers
+/// should initialize it to null.
+#[no_mangle]
+pub unsafe extern "C" fn engine_match_batch(
+    engine: *mut Engine,
+    urls: *const *const c_char,
+    hosts: *const *const c_char,
+    tab_hosts: *const *const c_char,
+    third_party: *const bool,
+    resource_types: *const *const c_char,
+    requests_size: size_t,
+    did_match_rule: *mut bool,
+    did_match_exception: *mut bool,
+    did_match_important: *mut bool,
+    redirects: *mut *mut c_char,
+) {
+    assert!(!engine.is_null());
+    let engine = Box::leak(Box::from_raw(engine));
+    let urls = std::slice::from_raw_parts(urls, requests_size);
+    let hosts = std::slice::from_raw_parts(hosts, requests_size);
+    let tab_hosts = std::slice::from_raw_parts(tab_hosts, requests_size);
+    let third_party = std::slice::from_raw_parts(third_party, requests_size);
+    let resource_types = std::slice::from_raw_parts(resource_types, requests_size);
+    let did_match_rule = std::slice::from_raw_parts_mut(did_match_rule, requests_size);
+    let did_match_exception = std::slice::from_raw_parts_mut(did_match_exception, requests_size);
+    let did_match_important = std::slice::from_raw_parts_mut(did_match_important, requests_size);
+    let redirects = std::slice::from_raw_parts_mut(redirects, requests_size);
+    for i in 0..requests_size {
+        if did_match_important[i] {
+            continue;
+        }
+        let blocker_result = engine.check_network_urls_with_hostnames_subset(
+            CStr::from_ptr(urls[i]).to_str().unwrap(),
+            CStr::from_ptr(hosts[i]).to_str().unwrap(),
+            CStr::from_ptr(tab_hosts[i]).to_str().unwrap(),
+            CStr::from_ptr(resource_types[i]).to_str().unwrap(),
+            Some(third_party[i]),
+            did_match_rule[i] || did_match_exception[i],
+            !did_match_exception[i],
+        );
+        did_match_rule[i] |= blocker_result.matched;
+        did_match_exception[i] |= blocker_result.exception.is_some();
+        did_match_important[i] |= blocker_result.important;
+        if let Some(x) = blocker_result.redirect {
+            if let Ok(y) = CString::new(x) {
+                redirects[i] = y.into_raw();
+            }
+        }
+    }
+}
+
+/// Checks if a `url` matches against each of several `Engine`s, in order, within one call.
+///
+/// Results are accumulated exactly as with a sequence of `engine_match` calls, but the request
+/// strings only need to cross the FFI boundary once. Checking stops after the first engine that
+/// matches an important rule. If more than one engine returns a redirect, the last one wins.
+#[no_mangle]
+pub unsafe extern "C" fn engines_match(
+    engines: *const *mut Engine,
+    engines_size: size_t,
+    url: *const c_char,
+    host: *const c_char,
+    tab_host: *const c_char,
+    third_party: bool,
+    resource_type: *const c_char,
+    did_match_rule: *mut bool,
+    did_match_exception: *mut bool,
+    did_match_important: *mut bool,
+    redirect: *mut *mut c_char,
+) {
+    let url = CStr::from_ptr(url).to_str().unwrap();
+    let host = CStr::from_ptr(host).to_str().unwrap();
+    let tab_host = CStr::from_ptr(tab_host).to_str().unwrap();
+    let resource_type = CStr::from_ptr(resource_type).to_str().unwrap();
+    let engines = std::slice::from_raw_parts(engines, engines_size);
+    let mut last_redirect: Option<String> = None;
+    for engine in engines {
+        assert!(!engine.is_null());
+        let engine = Box::leak(Box::from_raw(*engine));
+        let blocker_result = engine.check_network_urls_with_hostnames_subset(
+            url,
+            host,
+            tab_host,
+            resource_type,
+            Some(third_party),
+            *did_match_rule || *did_match_exception,
+            !*did_match_exception,
+        );
+        *did_match_rule |= blocker_result.matched;
+        *did_match_exception |= blocker_result.exception.is_some();
+        *did_match_important |= blocker_result.important;
+        if blocker_result.redirect.is_some() {
+            last_redirect = blocker_result.redirect;
+        }
+        if *did_match_important {
+            break;
+        }
+    }
+    *redirect = match last_redirect {
+        Some(x) => match CString::new(x) {
+            Ok(y) => y.into_raw(),
+            _ => ptr::null_mut(),
+        },
+        None => ptr::null_mut(),
+    };
+}
+
 /// Returns any CSP directives that should be added to a subdocument or document request's response
 /// headers.
 #[no_mangle]
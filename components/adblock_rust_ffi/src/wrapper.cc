@@ -40,6 +40,18 @@ FilterList::FilterList(const FilterList& other) = default;
 
 FilterList::~FilterList() {}
 
+BatchRequest::BatchRequest() = default;
+
+BatchRequest::BatchRequest(const BatchRequest& other) = default;
+
+BatchRequest::~BatchRequest() {}
+
+BatchResult::BatchResult() = default;
+
+BatchResult::BatchResult(const BatchResult& other) = default;
+
+BatchResult::~BatchResult() {}
+
 Engine::Engine() : raw(engine_create("")) {}
 
 Engine::Engine(const std::string& rules) : raw(engine_create(rules.c_str())) {}
@@ -65,6 +77,76 @@ void Engine::matches(const std::string& url,
   }
 }
 
+void Engine::matchesBatch(const BatchRequest* requests,
+                          size_t requests_size,
+                          BatchResult* results) {
+  std::vector<const char*> urls_raw(requests_size);
+  std::vector<const char*> hosts_raw(requests_size);
+  std::vector<const char*> tab_hosts_raw(requests_size);
+  std::unique_ptr<bool[]> third_party(new bool[requests_size]);
+  std::vector<const char*> resource_types_raw(requests_size);
+  std::unique_ptr<bool[]> did_match_rule(new bool[requests_size]);
+  std::unique_ptr<bool[]> did_match_exception(new bool[requests_size]);
+  std::unique_ptr<bool[]> did_match_important(new bool[requests_size]);
+  std::vector<char*> redirects_raw(requests_size, nullptr);
+  for (size_t i = 0; i < requests_size; i++) {
+    urls_raw[i] = requests[i].url.c_str();
+    hosts_raw[i] = requests[i].host.c_str();
+    tab_hosts_raw[i] = requests[i].tab_host.c_str();
+    third_party[i] = requests[i].is_third_party;
+    resource_types_raw[i] = requests[i].resource_type.c_str();
+    did_match_rule[i] = results[i].did_match_rule;
+    did_match_exception[i] = results[i].did_match_exception;
+    did_match_important[i] = results[i].did_match_important;
+  }
+
+  engine_match_batch(raw, urls_raw.data(), hosts_raw.data(),
+                     tab_hosts_raw.data(), third_party.get(),
+                     resource_types_raw.data(), requests_size,
+                     did_match_rule.get(), did_match_exception.get(),
+                     did_match_important.get(), redirects_raw.data());
+
+  for (size_t i = 0; i < requests_size; i++) {
+    results[i].did_match_rule = did_match_rule[i];
+    results[i].did_match_exception = did_match_exception[i];
+    results[i].did_match_important = did_match_important[i];
+    if (redirects_raw[i]) {
+      results[i].redirect = redirects_raw[i];
+      c_char_buffer_destroy(redirects_raw[i]);
+    }
+  }
+}
+
+// static
+void Engine::matchesUnion(const std::vector<Engine*>& engines,
+                          const std::string& url,
+                          const std::string& host,
+                          const std::string& tab_host,
+                          bool is_third_party,
+                          const std::string& resource_type,
+                          bool* did_match_rule,
+                          bool* did_match_exception,
+                          bool* did_match_important,
+                          std::string* redirect) {
+  std::vector<C_Engine*> engines_raw;
+  engines_raw.reserve(engines.size());
+  for (Engine* engine : engines) {
+    engines_raw.push_back(engine->raw);
+  }
+
+  char* redirect_char_ptr = nullptr;
+  engines_match(engines_raw.data(), engines_raw.size(), url.c_str(),
+                host.c_str(), tab_host.c_str(), is_third_party,
+                resource_type.c_str(), did_match_rule, did_match_exception,
+                did_match_important, &redirect_char_ptr);
+  if (redirect_char_ptr) {
+    if (redirect) {
+      *redirect = redirect_char_ptr;
+    }
+    c_char_buffer_destroy(redirect_char_ptr);
+  }
+}
+
 std::string Engine::getCspDirectives(const std::string& url,
                                      const std::string& host,
                                      const std::string& tab_host,
@@ -83,6 +165,11 @@ bool Engine::deserialize(const char* data, size_t data_size) {
   return engine_deserialize(raw, data, data_size);
 }
 
+bool Engine::deserialize(const uint8_t* data, size_t data_size) {
+  return engine_deserialize(raw, reinterpret_cast<const char*>(data),
+                            data_size);
+}
+
 void Engine::addTag(const std::string& tag) {
   engine_add_tag(raw, tag.c_str());
 }
@@ -64,6 +64,32 @@ class ADBLOCK_EXPORT FilterList {
   static std::vector<FilterList> regional_list;
 };
 
+// A request checked as part of Engine::matchesBatch.
+struct ADBLOCK_EXPORT BatchRequest {
+  BatchRequest();
+  BatchRequest(const BatchRequest& other);
+  ~BatchRequest();
+
+  std::string url;
+  std::string host;
+  std::string tab_host;
+  bool is_third_party = false;
+  std::string resource_type;
+};
+
+// The result for the BatchRequest at the same index. Like the out-parameters
+// of Engine::matches, results accumulate across engines.
+struct ADBLOCK_EXPORT BatchResult {
+  BatchResult();
+  BatchResult(const BatchResult& other);
+  ~BatchResult();
+
+  bool did_match_rule = false;
+  bool did_match_exception = false;
+  bool did_match_important = false;
+  std::string redirect;
+};
+
 class ADBLOCK_EXPORT Engine {
  public:
   Engine();
@@ -77,12 +103,33 @@ class ADBLOCK_EXPORT Engine {
                bool* did_match_exception,
                bool* did_match_important,
                std::string* redirect);
+  // Checks |requests_size| requests with a single call into the library.
+  // |results| must hold |requests_size| entries; requests which already
+  // matched an important rule are skipped.
+  void matchesBatch(const BatchRequest* requests,
+                    size_t requests_size,
+                    BatchResult* results);
+  // Checks |url| against every engine in |engines| with a single call into
+  // the library. Results accumulate as with repeated matches() calls.
+  static void matchesUnion(const std::vector<Engine*>& engines,
+                           const std::string& url,
+                           const std::string& host,
+                           const std::string& tab_host,
+                           bool is_third_party,
+                           const std::string& resource_type,
+                           bool* did_match_rule,
+                           bool* did_match_exception,
+                           bool* did_match_important,
+                           std::string* redirect);
   std::string getCspDirectives(const std::string& url,
                                const std::string& host,
                                const std::string& tab_host,
                                bool is_third_party,
                                const std::string& resource_type);
   bool deserialize(const char* data, size_t data_size);
+  // Deserializes directly from borrowed memory such as a file mapping. |data|
+  // only needs to stay valid for the duration of the call.
+  bool deserialize(const uint8_t* data, size_t data_size);
   void addTag(const std::string& tag);
   void addResource(const std::string& key,
                    const std::string& content_type,
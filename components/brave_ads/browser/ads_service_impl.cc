@@ -32,6 +32,7 @@
 #include "base/task/thread_pool.h"
 #include "base/task_runner_util.h"
 #include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
 #include "bat/ads/ad_history_info.h"
 #include "bat/ads/ad_notification_info.h"
 #include "bat/ads/ads.h"
@@ -269,6 +270,10 @@ void AdsServiceImpl::SetEnabled(const bool is_enabled) {
   SetBooleanPref(ads::prefs::kEnabled, is_enabled);
 }
 
+bool AdsServiceImpl::ShouldAllowConversionTracking() const {
+  return GetBooleanPref(ads::prefs::kShouldAllowConversionTracking);
+}
+
 void AdsServiceImpl::SetAllowConversionTracking(const bool should_allow) {
   SetBooleanPref(ads::prefs::kShouldAllowConversionTracking, should_allow);
 }
@@ -644,6 +649,7 @@ void AdsServiceImpl::OnMigrateConfirmationsState(const bool success) {
 }
 
 void AdsServiceImpl::Initialize() {
+  TRACE_EVENT0("brave.ads", "AdsServiceImpl::Initialize");
   profile_pref_change_registrar_.Init(profile_->GetPrefs());
 
   profile_pref_change_registrar_.Add(
@@ -682,6 +688,9 @@ void AdsServiceImpl::OnCreate() {
 }
 
 void AdsServiceImpl::OnInitialize(const int32_t result) {
+  TRACE_EVENT_NESTABLE_ASYNC_END1("brave.ads", "AdsServiceImpl::Start",
+                                  TRACE_ID_LOCAL(this), "result", result);
+
   if (result != ads::Result::SUCCESS) {
     VLOG(0) << "Failed to initialize ads";
 
@@ -738,6 +747,7 @@ bool AdsServiceImpl::StartService() {
   SetEnvironment();
   SetBuildChannel();
   UpdateIsDebugFlag();
+  UpdateIsPerfLogFlag();
 
   return true;
 }
@@ -777,6 +787,8 @@ void AdsServiceImpl::MaybeStart(const bool should_restart) {
 }
 
 void AdsServiceImpl::Start() {
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN0("brave.ads", "AdsServiceImpl::Start",
+                                    TRACE_ID_LOCAL(this));
   DetectUncertainFuture();
 }
 
@@ -928,6 +940,12 @@ bool AdsServiceImpl::IsDebug() const {
 #endif
 }
 
+void AdsServiceImpl::UpdateIsPerfLogFlag() {
+  const auto& command_line = *base::CommandLine::ForCurrentProcess();
+  const bool is_perf_log = command_line.HasSwitch(switches::kPerfLog);
+  bat_ads_service_->SetPerfLog(is_perf_log, base::NullCallback());
+}
+
 void AdsServiceImpl::StartCheckIdleStateTimer() {
 #if !defined(OS_ANDROID)
   idle_poll_timer_.Stop();
@@ -87,6 +87,7 @@ class AdsServiceImpl : public AdsService,
   bool IsEnabled() const override;
   void SetEnabled(const bool is_enabled) override;
 
+  bool ShouldAllowConversionTracking() const override;
   void SetAllowConversionTracking(const bool should_allow) override;
 
   int64_t GetAdsPerHour() const override;
@@ -224,6 +225,8 @@ class AdsServiceImpl : public AdsService,
   void UpdateIsDebugFlag();
   bool IsDebug() const;
 
+  void UpdateIsPerfLogFlag();
+
   void StartCheckIdleStateTimer();
   void CheckIdleState();
   void ProcessIdleState(const ui::IdleState idle_state, const int idle_time);
@@ -14,6 +14,7 @@ extern const char kProduction[];
 extern const char kStaging[];
 extern const char kDevelopment[];
 extern const char kDebug[];
+extern const char kPerfLog[];
 extern const char kTesting[];
 
 }  // namespace switches
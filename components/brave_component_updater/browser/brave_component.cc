@@ -13,6 +13,11 @@
 
 namespace brave_component_updater {
 
+void BraveComponent::Delegate::OnDemandUpdateAfterStartup(
+    const std::string& component_id) {
+  OnDemandUpdate(component_id);
+}
+
 BraveComponent::BraveComponent(Delegate* delegate)
     : delegate_(delegate),
       weak_factory_(this) {}
@@ -22,7 +27,8 @@ BraveComponent::~BraveComponent() {
 
 void BraveComponent::Register(const std::string& component_name,
                               const std::string& component_id,
-                              const std::string& component_base64_public_key) {
+                              const std::string& component_base64_public_key,
+                              UpdatePriority priority) {
   VLOG(2) << "register component: " << component_id;
   component_name_ = component_name;
   component_id_ = component_id;
@@ -31,7 +37,8 @@ void BraveComponent::Register(const std::string& component_name,
   auto registered_callback =
       base::BindOnce(&BraveComponent::OnComponentRegistered,
                      delegate_,
-                     component_id);
+                     component_id,
+                     priority);
   auto ready_callback =
       base::BindRepeating(&BraveComponent::OnComponentReadyInternal,
                           weak_factory_.GetWeakPtr(),
@@ -78,9 +85,13 @@ void BraveComponent::OnComponentReady(
 // static
 void BraveComponent::OnComponentRegistered(
     Delegate* delegate,
-    const std::string& component_id) {
+    const std::string& component_id,
+    UpdatePriority priority) {
   VLOG(2) << "component registered: " << component_id;
-  delegate->OnDemandUpdate(component_id);
+  if (priority == UpdatePriority::kAfterStartup)
+    delegate->OnDemandUpdateAfterStartup(component_id);
+  else
+    delegate->OnDemandUpdate(component_id);
 }
 
 BraveComponent::Delegate* BraveComponent::delegate() {
@@ -25,6 +25,10 @@ class BraveComponent {
                                                 const std::string& manifest)>;
   using ComponentObserver = update_client::UpdateClient::Observer;
 
+  // Components which aren't needed for the first window have their initial
+  // update check deferred until browser startup completes.
+  enum class UpdatePriority { kCritical, kAfterStartup };
+
   class Delegate {
    public:
     virtual ~Delegate() = default;
@@ -34,6 +38,7 @@ class BraveComponent {
                           ReadyCallback ready_callback) = 0;
     virtual bool Unregister(const std::string& component_id) = 0;
     virtual void OnDemandUpdate(const std::string& component_id) = 0;
+    virtual void OnDemandUpdateAfterStartup(const std::string& component_id);
     // An observer should not be added more than once.
     // The caller retains the ownership of the observer object.
     virtual void AddObserver(ComponentObserver* observer) = 0;
@@ -52,7 +57,8 @@ class BraveComponent {
   virtual ~BraveComponent();
   void Register(const std::string& component_name,
                 const std::string& component_id,
-                const std::string& component_base64_public_key);
+                const std::string& component_base64_public_key,
+                UpdatePriority priority = UpdatePriority::kCritical);
 
   bool Unregister();
   scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
@@ -73,7 +79,8 @@ class BraveComponent {
 
  private:
   static void OnComponentRegistered(Delegate* delegate,
-                                    const std::string& component_id);
+                                    const std::string& component_id,
+                                    UpdatePriority priority);
   void OnComponentReadyInternal(const std::string& component_id,
                                 const base::FilePath& install_dir,
                                 const std::string& manifest);
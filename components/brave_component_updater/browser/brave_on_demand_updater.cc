@@ -6,6 +6,7 @@
 #include "brave/components/brave_component_updater/browser/brave_on_demand_updater.h"
 
 #include <string>
+#include <vector>
 
 #include "base/memory/singleton.h"
 
@@ -24,6 +25,22 @@ void BraveOnDemandUpdater::OnDemandUpdate(const std::string& id) {
   on_demand_update_callback_.Run(id);
 }
 
+void BraveOnDemandUpdater::OnDemandUpdateAfterStartup(const std::string& id) {
+  if (startup_complete_) {
+    OnDemandUpdate(id);
+    return;
+  }
+  deferred_ids_.push_back(id);
+}
+
+void BraveOnDemandUpdater::OnStartupComplete() {
+  startup_complete_ = true;
+  std::vector<std::string> ids;
+  ids.swap(deferred_ids_);
+  for (const auto& id : ids)
+    OnDemandUpdate(id);
+}
+
 void BraveOnDemandUpdater::RegisterOnDemandUpdateCallback(Callback callback) {
   on_demand_update_callback_ = callback;
 }
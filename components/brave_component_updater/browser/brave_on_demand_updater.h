@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_BRAVE_COMPONENT_UPDATER_BROWSER_BRAVE_ON_DEMAND_UPDATER_H_
 
 #include <string>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/macros.h"
@@ -26,6 +27,13 @@ class BraveOnDemandUpdater {
   ~BraveOnDemandUpdater();
   void OnDemandUpdate(const std::string& id);
 
+  // Like OnDemandUpdate, but for components which aren't needed to show the
+  // first window. The update check is held back until OnStartupComplete, so
+  // their download, verification and install don't compete with the critical
+  // components on first run.
+  void OnDemandUpdateAfterStartup(const std::string& id);
+  void OnStartupComplete();
+
   void RegisterOnDemandUpdateCallback(Callback callback);
 
  private:
@@ -33,6 +41,8 @@ class BraveOnDemandUpdater {
   BraveOnDemandUpdater();
 
   Callback on_demand_update_callback_;
+  bool startup_complete_ = false;
+  std::vector<std::string> deferred_ids_;
 
   DISALLOW_COPY_AND_ASSIGN(BraveOnDemandUpdater);
 };
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 
 namespace brave_component_updater {
 
@@ -21,6 +22,11 @@ void GetDATFileData(const base::FilePath& file_path,
                     DATFileDataBuffer* buffer);
 std::string GetDATFileAsString(const base::FilePath& file_path);
 
+// Maps |file_path| read-only into |mapped_file|. The data is only valid for
+// the lifetime of |mapped_file|.
+bool MapDATFile(const base::FilePath& file_path,
+                base::MemoryMappedFile* mapped_file);
+
 template<typename T>
 using LoadDATFileDataResult =
     std::pair<std::unique_ptr<T>, brave_component_updater::DATFileDataBuffer>;
@@ -41,6 +47,23 @@ LoadDATFileDataResult<T> LoadDATFileData(
       std::move(client), std::move(buffer));
 }
 
+// Like LoadDATFileData, but deserializes straight from a read-only mapping of
+// the file. |T::deserialize| must not retain the data it is given; the
+// mapping is released as soon as deserialization finishes, so no copy of the
+// DAT file outlives this call.
+template<typename T>
+std::unique_ptr<T> LoadMappedDATFileData(
+    const base::FilePath& dat_file_path) {
+  base::MemoryMappedFile mapped_file;
+  if (!MapDATFile(dat_file_path, &mapped_file))
+    return nullptr;
+
+  auto client = std::make_unique<T>();
+  if (!client->deserialize(mapped_file.data(), mapped_file.length()))
+    return nullptr;
+
+  return client;
+}
 
 }  // namespace brave_component_updater
 
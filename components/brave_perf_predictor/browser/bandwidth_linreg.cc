@@ -11,6 +11,8 @@
 #include <utility>
 
 #include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_util.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
@@ -35,6 +37,29 @@ bool StandardiseFeatsNoOutliers(
   return false;
 }
 
+constexpr char kThirdPartyFeaturePrefix[] = "thirdParties.";
+constexpr char kThirdPartyFeatureSuffix[] = ".blocked";
+
+// Maps feature names, or entity names for third party features, to their
+// position in |feature_sequence|
+base::flat_map<base::StringPiece, size_t> BuildFeatureIndex(
+    bool third_parties) {
+  std::vector<std::pair<base::StringPiece, size_t>> index;
+  for (size_t i = 0; i < feature_count; i++) {
+    base::StringPiece feature(feature_sequence[i]);
+    if (third_parties) {
+      if (!base::StartsWith(feature, kThirdPartyFeaturePrefix) ||
+          !base::EndsWith(feature, kThirdPartyFeatureSuffix)) {
+        continue;
+      }
+      feature.remove_prefix(sizeof(kThirdPartyFeaturePrefix) - 1);
+      feature.remove_suffix(sizeof(kThirdPartyFeatureSuffix) - 1);
+    }
+    index.emplace_back(feature, i);
+  }
+  return base::flat_map<base::StringPiece, size_t>(std::move(index));
+}
+
 }  // namespace
 
 double LinregPredictVector(const std::array<double, feature_count>& features) {
@@ -75,4 +100,18 @@ double LinregPredictNamed(const base::flat_map<std::string, double>& features) {
   return LinregPredictVector(feature_vector);
 }
 
+size_t LinregFeatureIndex(base::StringPiece feature) {
+  static const base::NoDestructor<base::flat_map<base::StringPiece, size_t>>
+      index(BuildFeatureIndex(false));
+  const auto it = index->find(feature);
+  return it == index->end() ? feature_count : it->second;
+}
+
+size_t LinregThirdPartyFeatureIndex(base::StringPiece entity) {
+  static const base::NoDestructor<base::flat_map<base::StringPiece, size_t>>
+      index(BuildFeatureIndex(true));
+  const auto it = index->find(entity);
+  return it == index->end() ? feature_count : it->second;
+}
+
 }  // namespace brave_perf_predictor
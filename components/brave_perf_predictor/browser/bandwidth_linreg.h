@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/strings/string_piece.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
@@ -31,6 +32,14 @@ double LinregPredictVector(const std::array<double, feature_count>& features);
 // any extra features.
 double LinregPredictNamed(const base::flat_map<std::string, double>& features);
 
+// Returns the position of |feature| in the feature vector, or |feature_count|
+// if the model doesn't use it. Feature positions don't change, so callers
+// can look them up once and fill the feature vector in place.
+size_t LinregFeatureIndex(base::StringPiece feature);
+
+// Same as above for the "thirdParties.<entity>.blocked" feature of |entity|
+size_t LinregThirdPartyFeatureIndex(base::StringPiece entity);
+
 }  // namespace brave_perf_predictor
 
 #endif  // BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_LINREG_H_
@@ -43,6 +43,18 @@ TEST(BraveSavingsPredictorTest, HandlesSpecificVectorExample) {
             794);  // Equal on the order of thousands
 }
 
+TEST(BraveSavingsPredictorTest, FeatureIndex) {
+  EXPECT_EQ(LinregFeatureIndex("adblockRequests"), 0u);
+  EXPECT_EQ(feature_sequence[LinregFeatureIndex("resources.total.size")],
+            "resources.total.size");
+  EXPECT_EQ(LinregFeatureIndex("transfer.total.size"), feature_count);
+
+  const size_t index = LinregThirdPartyFeatureIndex("Google Analytics");
+  ASSERT_LT(index, feature_count);
+  EXPECT_EQ(feature_sequence[index], "thirdParties.Google Analytics.blocked");
+  EXPECT_EQ(LinregThirdPartyFeatureIndex("adblockRequests"), feature_count);
+}
+
 TEST(BraveSavingsPredictorTest, HandlesEmptyFeatureset) {
   const base::flat_map<std::string, double> features{};
   const double result = LinregPredictNamed(features);
@@ -6,10 +6,11 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_SAVINGS_PREDICTOR_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_SAVINGS_PREDICTOR_H_
 
+#include <array>
 #include <string>
 
-#include "base/containers/flat_map.h"
-#include "base/gtest_prod_util.h"
+#include "base/strings/string_piece.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 #include "url/gurl.h"
 
@@ -37,7 +38,9 @@ namespace brave_perf_predictor {
 //
 // The predictor expects to receive a series of |PageLoadTiming| inputs to
 // extract relevant standard performance metrics from, as well as notifications
-// of any resources fully loaded or blocked.
+// of any resources fully loaded or blocked. Features are written in place
+// into the vector the model consumes, so a prediction is a single pass over
+// it with no name lookups.
 class BandwidthSavingsPredictor {
  public:
   explicit BandwidthSavingsPredictor(const NamedThirdPartyRegistry* registry);
@@ -56,15 +59,18 @@ class BandwidthSavingsPredictor {
   double PredictSavingsBytes() const;
   void Reset();
 
+  // Returns the current value of the named model feature, 0 if unknown
+  double GetFeatureForTesting(base::StringPiece feature) const;
+
  private:
-  FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest, FeaturiseBlocked);
-  FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest, FeaturiseTiming);
-  FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest,
-                           FeaturiseResourceLoading);
+  void AddToFeature(size_t index, double value);
+  void SetFeature(size_t index, double value);
 
   GURL main_frame_url_;
   const NamedThirdPartyRegistry* tp_registry_;  // not owned
-  base::flat_map<std::string, double> feature_map_;
+  std::array<double, feature_count> features_{};
+  // Not a model feature, only used to sanity check predictions
+  double transfer_total_size_ = 0;
 };
 
 }  // namespace brave_perf_predictor
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+# Copyright (c) 2021 The Brave Authors. All rights reserved.
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this file,
+# You can obtain one at https://mozilla.org/MPL/2.0/.
+
+"""
+Compiles the Third Party Web entities list into a C++ header with static
+arrays of entity names and domains, so the browser doesn't have to parse the
+JSON at runtime.
+
+Only entities used by the bandwidth prediction model are kept; they are read
+from the |relevant_entities| array of the generated model parameters header.
+
+Usage:
+  generate_third_party_entities.py --entities entities.json \\
+      --parameters bandwidth_linreg_parameters.h --output third_party_entities.h
+"""
+
+import argparse
+import json
+import re
+import sys
+
+HEADER_GUARD = 'BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_THIRD_PARTY_ENTITIES_H_'
+
+TEMPLATE = """/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef {guard}
+#define {guard}
+
+/* This file is automatically generated, do not edit directly */
+
+#include <stdint.h>
+
+namespace brave_perf_predictor {{
+
+struct ThirdPartyDomain {{
+  const char* domain;
+  // Index into kThirdPartyEntityNames
+  uint16_t entity;
+}};
+
+constexpr const char* kThirdPartyEntityNames[] = {{
+{names}
+}};
+
+// Sorted by domain, each domain appears once
+constexpr ThirdPartyDomain kThirdPartyDomains[] = {{
+{domains}
+}};
+
+}}  // namespace brave_perf_predictor
+
+#endif  // {guard}
+"""
+
+
+def read_relevant_entities(parameters_path):
+    with open(parameters_path, 'r') as f:
+        contents = f.read()
+    match = re.search(r'relevant_entities\s*=?\s*\{(.*?)\};', contents, re.S)
+    if not match:
+        raise Exception('No relevant_entities found in ' + parameters_path)
+    return set(json.loads('"%s"' % name)
+               for name in re.findall(r'"((?:[^"\\]|\\.)*)"', match.group(1)))
+
+
+def to_cpp_string(value):
+    return json.dumps(value, ensure_ascii=True)
+
+
+def generate(entities_path, parameters_path, output_path):
+    relevant_entities = read_relevant_entities(parameters_path)
+    with open(entities_path, 'r') as f:
+        entities = json.load(f)
+
+    names = []
+    domains = {}
+    for entity in entities:
+        name = entity.get('name')
+        if not isinstance(name, str) or name not in relevant_entities:
+            continue
+        entity_domains = entity.get('domains')
+        if not isinstance(entity_domains, list):
+            continue
+        entity_id = len(names)
+        names.append(name)
+        for domain in entity_domains:
+            # Keep the first entity for duplicate domains, same as the JSON
+            # parser in NamedThirdPartyRegistry
+            if isinstance(domain, str) and domain not in domains:
+                domains[domain] = entity_id
+
+    if len(names) > 0xffff:
+        raise Exception('Too many entities')
+
+    with open(output_path, 'w') as f:
+        f.write(TEMPLATE.format(
+            guard=HEADER_GUARD,
+            names='\n'.join('    %s,' % to_cpp_string(name)
+                            for name in names),
+            domains='\n'.join('    {%s, %d},' % (to_cpp_string(domain),
+                                                 domains[domain])
+                              for domain in sorted(domains))))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--entities', required=True)
+    parser.add_argument('--parameters', required=True)
+    parser.add_argument('--output', required=True)
+    args = parser.parse_args()
+    generate(args.entities, args.parameters, args.output)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -5,39 +5,121 @@
 
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 
-#include <tuple>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
 
 #include "base/bind.h"
+#include "base/containers/adapters.h"
+#include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
 #include "base/values.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
-#include "components/grit/brave_components_resources.h"
+#include "brave/components/brave_perf_predictor/browser/third_party_entities.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
-#include "ui/base/resource/resource_bundle.h"
 #include "url/gurl.h"
 
 namespace brave_perf_predictor {
 
 namespace {
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
-  base::flat_map<std::string, std::string> entity_by_domain;
-  base::flat_map<std::string, std::string> entity_by_root_domain;
+using EntityId = uint32_t;
+constexpr EntityId kNoEntity = std::numeric_limits<EntityId>::max();
+// Root domain shared by several entities, which makes neither correct
+constexpr EntityId kAmbiguousEntity = kNoEntity - 1;
+
+}  // namespace
+
+struct NamedThirdPartyRegistry::DomainNode {
+  EntityId domain_entity = kNoEntity;
+  EntityId root_domain_entity = kNoEntity;
+  base::flat_map<std::string, std::unique_ptr<DomainNode>, std::less<>>
+      children;
+};
+
+struct NamedThirdPartyRegistry::Mappings {
+  std::vector<std::string> entity_names;
+  DomainNode domains;
+  size_t domain_count = 0;
+  size_t root_domain_count = 0;
+};
+
+namespace {
+
+using DomainNode = NamedThirdPartyRegistry::DomainNode;
+using Mappings = NamedThirdPartyRegistry::Mappings;
+
+// Returns the trie node for |domain|, creating missing nodes on the way
+DomainNode* FindOrCreateNode(DomainNode* root, base::StringPiece domain) {
+  DomainNode* node = root;
+  const std::vector<base::StringPiece> labels = base::SplitStringPiece(
+      domain, ".", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  for (const auto& label : base::Reversed(labels)) {
+    auto it = node->children.find(label);
+    if (it == node->children.end()) {
+      it = node->children
+               .emplace(std::string(label), std::make_unique<DomainNode>())
+               .first;
+    }
+    node = it->second.get();
+  }
+  return node;
+}
+
+void ShrinkToFit(DomainNode* node) {
+  node->children.shrink_to_fit();
+  for (auto& child : node->children)
+    ShrinkToFit(child.second.get());
+}
+
+void AddDomain(Mappings* mappings,
+               EntityId entity_id,
+               base::StringPiece entity_domain) {
+  DomainNode* domain_node = FindOrCreateNode(&mappings->domains, entity_domain);
+  if (domain_node->domain_entity == kNoEntity) {
+    domain_node->domain_entity = entity_id;
+    mappings->domain_count++;
+  } else {
+    VLOG(2) << "Malformed data: duplicate domain " << entity_domain;
+  }
+  const std::string root_domain =
+      net::registry_controlled_domains::GetDomainAndRegistry(
+          entity_domain,
+          net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  if (root_domain.empty())
+    return;
+
+  DomainNode* root_node = FindOrCreateNode(&mappings->domains, root_domain);
+  if (root_node->root_domain_entity == kNoEntity) {
+    root_node->root_domain_entity = entity_id;
+    mappings->root_domain_count++;
+  } else if (root_node->root_domain_entity != entity_id &&
+             root_node->root_domain_entity != kAmbiguousEntity) {
+    // If there is a clash at root domain level, neither is correct
+    root_node->root_domain_entity = kAmbiguousEntity;
+    mappings->root_domain_count--;
+  }
+}
+
+std::unique_ptr<Mappings> ParseMappings(const base::StringPiece entities,
+                                        bool discard_irrelevant) {
+  auto mappings = std::make_unique<Mappings>();
 
   // Parse the JSON
   base::Optional<base::Value> document = base::JSONReader::Read(entities);
   if (!document || !document->is_list()) {
     LOG(ERROR) << "Cannot parse the third-party entities list";
-    return {};
+    return mappings;
   }
 
   // Collect the mappings
@@ -53,48 +135,45 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
     if (!entity_domains)
       continue;
 
+    const EntityId entity_id = mappings->entity_names.size();
+    if (entity_id >= kAmbiguousEntity)
+      break;
+    mappings->entity_names.push_back(*entity_name);
+
     for (auto& entity_domain_it : entity_domains->GetList()) {
       if (!entity_domain_it.is_string()) {
         continue;
       }
-      const base::StringPiece entity_domain(entity_domain_it.GetString());
-
-      const auto inserted =
-          entity_by_domain.emplace(entity_domain, *entity_name);
-      if (!inserted.second) {
-        VLOG(2) << "Malformed data: duplicate domain " << entity_domain;
-      }
-      auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
-          entity_domain,
-          net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
-
-      auto root_entity_entry = entity_by_root_domain.find(root_domain);
-      if (root_entity_entry != entity_by_root_domain.end() &&
-          root_entity_entry->second != *entity_name) {
-        // If there is a clash at root domain level, neither is correct
-        entity_by_root_domain.erase(root_entity_entry);
-      } else {
-        entity_by_root_domain.emplace(root_domain, *entity_name);
-      }
+      AddDomain(mappings.get(), entity_id, entity_domain_it.GetString());
     }
   }
 
-  entity_by_domain.shrink_to_fit();
-  entity_by_root_domain.shrink_to_fit();
-  return std::make_tuple(entity_by_domain, entity_by_root_domain);
+  mappings->entity_names.shrink_to_fit();
+  ShrinkToFit(&mappings->domains);
+  return mappings;
 }
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseFromResource(int resource_id) {
+// Builds the mappings from the entity table compiled from the bundled Third
+// Party Web data, which only has relevant entities
+std::unique_ptr<Mappings> BuildDefaultMappings() {
   // TODO(AndriusA): insert trace event here
   SCOPED_UMA_HISTOGRAM_TIMER(
       "Brave.Savings.NamedThirdPartyRegistry.LoadTimeMS");
-  auto& resource_bundle = ui::ResourceBundle::GetSharedInstance();
-  std::string data_resource =
-      resource_bundle.LoadDataResourceString(resource_id);
-  // Parse resource, discarding irrelevant entities
-  return ParseMappings(data_resource, true);
+  auto mappings = std::make_unique<Mappings>();
+  mappings->entity_names.assign(std::begin(kThirdPartyEntityNames),
+                                std::end(kThirdPartyEntityNames));
+  for (const auto& domain : kThirdPartyDomains)
+    AddDomain(mappings.get(), domain.entity, domain.domain);
+  ShrinkToFit(&mappings->domains);
+  return mappings;
+}
+
+// The default mappings never change, so they are built once and shared by
+// the registries of all profiles
+const Mappings* GetDefaultMappings() {
+  static const base::NoDestructor<std::unique_ptr<Mappings>> mappings(
+      BuildDefaultMappings());
+  return mappings->get();
 }
 
 }  // namespace
@@ -102,25 +181,25 @@ ParseFromResource(int resource_id) {
 bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
                                            bool discard_irrelevant) {
   // Reset previous mappings
-  entity_by_domain_.clear();
-  entity_by_root_domain_.clear();
+  mappings_ = nullptr;
+  loaded_mappings_.reset();
   initialized_ = false;
 
-  tie(entity_by_domain_, entity_by_root_domain_) =
+  std::unique_ptr<Mappings> mappings =
       ParseMappings(entities, discard_irrelevant);
-  if (entity_by_domain_.size() == 0 || entity_by_root_domain_.size() == 0)
+  if (mappings->domain_count == 0 || mappings->root_domain_count == 0)
     return false;
 
-  initialized_ = true;
+  loaded_mappings_ = std::move(mappings);
+  UpdateMappings(loaded_mappings_.get());
   return true;
 }
 
-void NamedThirdPartyRegistry::UpdateMappings(
-    std::tuple<base::flat_map<std::string, std::string>,
-               base::flat_map<std::string, std::string>> entity_mappings) {
-  tie(entity_by_domain_, entity_by_root_domain_) = entity_mappings;
-  VLOG(2) << "Loaded " << entity_by_domain_.size() << " mappings by domain and "
-          << entity_by_root_domain_.size() << " by root domain; size";
+void NamedThirdPartyRegistry::UpdateMappings(const Mappings* mappings) {
+  VLOG(2) << "Loaded " << mappings->domain_count << " mappings by domain and "
+          << mappings->root_domain_count << " by root domain for "
+          << mappings->entity_names.size() << " entities";
+  mappings_ = mappings;
   initialized_ = true;
 }
 
@@ -132,23 +211,48 @@ base::Optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
   }
 
   const GURL url(request_url);
-  if (!url.is_valid())
+  if (!url.is_valid() || !url.has_host())
     return base::nullopt;
 
-  if (url.has_host()) {
-    auto domain_entry = entity_by_domain_.find(url.host());
-    if (domain_entry != entity_by_domain_.end())
-      return domain_entry->second;
+  const std::string* entity = GetThirdPartyForHost(url.host_piece());
+  if (!entity)
+    return base::nullopt;
+  return *entity;
+}
 
-    auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
-        url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+const std::string* NamedThirdPartyRegistry::GetThirdPartyForHost(
+    const base::StringPiece host) const {
+  if (!IsInitialized() || !mappings_ || host.empty())
+    return nullptr;
 
-    auto root_domain_entry = entity_by_root_domain_.find(root_domain);
-    if (root_domain_entry != entity_by_root_domain_.end())
-      return root_domain_entry->second;
+  // Walk the host labels from the right, remembering the deepest root domain
+  // on the way. Root domains are registrable domains, so at most one of them
+  // is a suffix of the host and it is the host's own root domain.
+  const DomainNode* node = &mappings_->domains;
+  EntityId root_domain_entity = kNoEntity;
+  size_t end = host.size();
+  while (end > 0) {
+    const size_t dot = host.rfind('.', end - 1);
+    const size_t start = dot == base::StringPiece::npos ? 0 : dot + 1;
+    const auto it = node->children.find(host.substr(start, end - start));
+    if (it == node->children.end())
+      break;
+    node = it->second.get();
+    if (node->root_domain_entity != kNoEntity)
+      root_domain_entity = node->root_domain_entity;
+    if (start == 0) {
+      if (node->domain_entity != kNoEntity)
+        return &mappings_->entity_names[node->domain_entity];
+      break;
+    }
+    end = dot;
   }
 
-  return base::nullopt;
+  if (root_domain_entity == kNoEntity ||
+      root_domain_entity == kAmbiguousEntity) {
+    return nullptr;
+  }
+  return &mappings_->entity_names[root_domain_entity];
 }
 
 NamedThirdPartyRegistry::NamedThirdPartyRegistry() = default;
@@ -156,9 +260,11 @@ NamedThirdPartyRegistry::NamedThirdPartyRegistry() = default;
 NamedThirdPartyRegistry::~NamedThirdPartyRegistry() = default;
 
 void NamedThirdPartyRegistry::InitializeDefault() {
+  // Only the first registry in the process builds the mappings, off the UI
+  // thread
   base::ThreadPool::PostTaskAndReplyWithResult(
-      FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&ParseFromResource, IDR_THIRD_PARTY_ENTITIES),
+      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&GetDefaultMappings),
       base::BindOnce(&NamedThirdPartyRegistry::UpdateMappings,
                      weak_factory_.GetWeakPtr()));
 }
@@ -6,12 +6,12 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 
+#include <memory>
 #include <string>
-#include <tuple>
 
-#include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
-#include "base/values.h"
+#include "base/optional.h"
+#include "base/strings/string_piece.h"
 #include "components/keyed_service/core/keyed_service.h"
 
 namespace brave_perf_predictor {
@@ -31,21 +31,30 @@ class NamedThirdPartyRegistry : public KeyedService {
   // entities not relevant to the bandwith prediction model (i.e. those not
   // seen in training the model).
   bool LoadMappings(const base::StringPiece entities, bool discard_irrelevant);
-  // Default initialization - asynchronously load from bundled resource
+  // Default initialization - asynchronously load from the entity table
+  // compiled into the binary
   void InitializeDefault();
   base::Optional<std::string> GetThirdParty(
       const base::StringPiece domain) const;
+  // Same as above for an already parsed, canonical |host|. Returns nullptr if
+  // the host doesn't belong to a known third party.
+  const std::string* GetThirdPartyForHost(const base::StringPiece host) const;
+
+  struct DomainNode;
+  struct Mappings;
 
  private:
   bool IsInitialized() const { return initialized_; }
   void MarkInitialized(bool initialized) { initialized_ = initialized; }
-  void UpdateMappings(
-      std::tuple<base::flat_map<std::string, std::string>,
-                 base::flat_map<std::string, std::string>> entity_mappings);
+  void UpdateMappings(const Mappings* mappings);
 
   bool initialized_ = false;
-  base::flat_map<std::string, std::string> entity_by_domain_;
-  base::flat_map<std::string, std::string> entity_by_root_domain_;
+  // Entity names and a trie of domains keyed by their labels from the right,
+  // so a host is matched against both exact and root domains in a single
+  // walk. Points to |loaded_mappings_| or to the default mappings which are
+  // shared by all registries.
+  const Mappings* mappings_ = nullptr;
+  std::unique_ptr<Mappings> loaded_mappings_;
 
   base::WeakPtrFactory<NamedThirdPartyRegistry> weak_factory_{this};
 };
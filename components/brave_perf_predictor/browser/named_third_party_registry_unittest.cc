@@ -8,6 +8,7 @@
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/path_service.h"
+#include "base/test/task_environment.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace brave_perf_predictor {
@@ -119,4 +120,73 @@ TEST(NamedThirdPartyRegistryTest, HandlesUnrecognisedThirdPartyTest) {
   EXPECT_FALSE(entity.has_value());
 }
 
+TEST(NamedThirdPartyRegistryTest, ExtractsThirdPartyFromHostTest) {
+  NamedThirdPartyRegistry extractor;
+  EXPECT_EQ(extractor.GetThirdPartyForHost("www.facebook.com"), nullptr);
+  ASSERT_TRUE(extractor.LoadMappings(test_mapping, false));
+
+  const std::string* entity = extractor.GetThirdPartyForHost("m.facebook.com");
+  ASSERT_NE(entity, nullptr);
+  EXPECT_EQ(*entity, "Facebook");
+  entity = extractor.GetThirdPartyForHost("a.b.static.xx.fbcdn.net");
+  ASSERT_NE(entity, nullptr);
+  EXPECT_EQ(*entity, "Facebook");
+  entity = extractor.GetThirdPartyForHost("ssl.google-analytics.com");
+  ASSERT_NE(entity, nullptr);
+  EXPECT_EQ(*entity, "Google Analytics");
+  // Entity names are interned
+  EXPECT_EQ(extractor.GetThirdPartyForHost("urchin.com"),
+            extractor.GetThirdPartyForHost("www.google-analytics.com"));
+
+  // Only whole labels match
+  EXPECT_EQ(extractor.GetThirdPartyForHost("notfacebook.com"), nullptr);
+  EXPECT_EQ(extractor.GetThirdPartyForHost("com"), nullptr);
+  EXPECT_EQ(extractor.GetThirdPartyForHost(".com"), nullptr);
+  EXPECT_EQ(extractor.GetThirdPartyForHost(""), nullptr);
+}
+
+TEST(NamedThirdPartyRegistryTest, InitializesDefaultTest) {
+  base::test::TaskEnvironment task_environment;
+  NamedThirdPartyRegistry extractor;
+  NamedThirdPartyRegistry other_extractor;
+  extractor.InitializeDefault();
+  other_extractor.InitializeDefault();
+  task_environment.RunUntilIdle();
+
+  const std::string* entity =
+      extractor.GetThirdPartyForHost("www.google-analytics.com");
+  ASSERT_NE(entity, nullptr);
+  EXPECT_EQ(*entity, "Google Analytics");
+  entity = extractor.GetThirdPartyForHost("test.m.facebook.com");
+  ASSERT_NE(entity, nullptr);
+  EXPECT_EQ(*entity, "Facebook");
+  EXPECT_EQ(extractor.GetThirdPartyForHost("example.com"), nullptr);
+
+  // Default mappings are shared
+  EXPECT_EQ(other_extractor.GetThirdPartyForHost("www.google-analytics.com"),
+            extractor.GetThirdPartyForHost("www.google-analytics.com"));
+}
+
+TEST(NamedThirdPartyRegistryTest, IgnoresAmbiguousRootDomainTest) {
+  NamedThirdPartyRegistry extractor;
+  ASSERT_TRUE(extractor.LoadMappings(R"([
+    {"name":"First","domains":["a.example.com","first.com"]},
+    {"name":"Second","domains":["b.example.com"]},
+    {"name":"Third","domains":["c.example.com"]}
+  ])",
+                                     false));
+
+  // Exact domains still match
+  const std::string* entity = extractor.GetThirdPartyForHost("b.example.com");
+  ASSERT_NE(entity, nullptr);
+  EXPECT_EQ(*entity, "Second");
+  entity = extractor.GetThirdPartyForHost("x.first.com");
+  ASSERT_NE(entity, nullptr);
+  EXPECT_EQ(*entity, "First");
+
+  // The shared root domain belongs to none of them
+  EXPECT_EQ(extractor.GetThirdPartyForHost("example.com"), nullptr);
+  EXPECT_EQ(extractor.GetThirdPartyForHost("x.example.com"), nullptr);
+}
+
 }  // namespace brave_perf_predictor
@@ -8,6 +8,7 @@
 #include <memory>
 #include <utility>
 
+#include "base/location.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/time/clock.h"
 #include "base/time/default_clock.h"
@@ -36,6 +37,10 @@ constexpr std::array<uint64_t, 7> kBandwidthSavingsBuckets{
 constexpr char kSavingsDailyUMAHistogramName[] =
     "Brave.Savings.BandwidthSavingsMB";
 
+// P3A only reports the latest sample of the histogram, so delaying it by up
+// to this much does not change what gets reported
+constexpr base::TimeDelta kFlushDelay = base::TimeDelta::FromMinutes(1);
+
 }  // namespace
 
 P3ABandwidthSavingsTracker::P3ABandwidthSavingsTracker(PrefService* user_prefs)
@@ -48,16 +53,24 @@ P3ABandwidthSavingsTracker::P3ABandwidthSavingsTracker(
     : user_prefs_(user_prefs), clock_(std::move(clock)) {}
 
 void P3ABandwidthSavingsTracker::RecordSavings(uint64_t savings) {
-  if (savings > 0 && user_prefs_) {
-    // TODO(AndriusA): optimise if needed, loading permanent state on every
-    // record could be costly
-    WeeklyStorage weekly(user_prefs_, prefs::kBandwidthSavedDailyBytes);
-    weekly.AddDelta(savings);
-    StoreSavingsHistogram(weekly.GetWeeklySum());
+  if (savings == 0 || !user_prefs_)
+    return;
+
+  const base::Time today = clock_->Now().LocalMidnight();
+  if (pending_savings_ > 0 && today != pending_savings_day_)
+    FlushSavings();
+
+  pending_savings_ += savings;
+  pending_savings_day_ = today;
+  if (!flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE, kFlushDelay, this,
+                       &P3ABandwidthSavingsTracker::FlushSavings);
   }
 }
 
-P3ABandwidthSavingsTracker::~P3ABandwidthSavingsTracker() = default;
+P3ABandwidthSavingsTracker::~P3ABandwidthSavingsTracker() {
+  FlushSavings();
+}
 
 // static
 void P3ABandwidthSavingsTracker::RegisterProfilePrefs(
@@ -66,6 +79,19 @@ void P3ABandwidthSavingsTracker::RegisterProfilePrefs(
     registry->RegisterListPref(prefs::kBandwidthSavedDailyBytes);
 }
 
+void P3ABandwidthSavingsTracker::FlushSavings() {
+  flush_timer_.Stop();
+  if (pending_savings_ == 0)
+    return;
+
+  WeeklyStorage weekly(user_prefs_, prefs::kBandwidthSavedDailyBytes,
+                       clock_.get());
+  // The timer may fire after midnight, the savings are still yesterday's
+  weekly.AddDeltaForDay(pending_savings_day_, pending_savings_);
+  pending_savings_ = 0;
+  StoreSavingsHistogram(weekly.GetWeeklySum());
+}
+
 void P3ABandwidthSavingsTracker::StoreSavingsHistogram(uint64_t savings_bytes) {
   int bucket = 0;
   // divide by 1024*1024 = 2^20 to convert bytes -> MB
@@ -9,6 +9,9 @@
 #include <cstdint>
 #include <memory>
 
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
 class PrefRegistrySimple;
 class PrefService;
 
@@ -30,12 +33,21 @@ class P3ABandwidthSavingsTracker {
       delete;
 
   static void RegisterProfilePrefs(PrefRegistrySimple* registry);
+  // Savings are accumulated in memory and written to prefs, along with the
+  // histogram, when the flush timer fires, the day changes or the tracker
+  // is destroyed.
   void RecordSavings(uint64_t savings);
 
  private:
   PrefService* user_prefs_;
   std::unique_ptr<base::Clock> clock_;  // Injected clock for testing
+  void FlushSavings();
   void StoreSavingsHistogram(uint64_t savings_bytes);
+
+  uint64_t pending_savings_ = 0;
+  // Local midnight of the day |pending_savings_| were recorded on
+  base::Time pending_savings_day_;
+  base::OneShotTimer flush_timer_;
 };
 
 }  // namespace brave_perf_predictor
@@ -10,7 +10,10 @@
 
 #include "base/test/metrics/histogram_tester.h"
 #include "base/test/simple_test_clock.h"
+#include "base/test/task_environment.h"
 #include "base/time/time.h"
+#include "base/values.h"
+#include "brave/components/brave_perf_predictor/common/pref_names.h"
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -21,7 +24,9 @@ constexpr char kSavingsDailyUMAHistogramName[] =
 
 class P3ABandwidthSavingsTrackerTest : public ::testing::Test {
  public:
-  P3ABandwidthSavingsTrackerTest() : clock_(new base::SimpleTestClock) {
+  P3ABandwidthSavingsTrackerTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        clock_(new base::SimpleTestClock) {
     P3ABandwidthSavingsTracker::RegisterProfilePrefs(pref_service_.registry());
     tracker_ = std::make_unique<P3ABandwidthSavingsTracker>(
         &pref_service_, std::unique_ptr<base::Clock>(clock_));
@@ -29,6 +34,11 @@ class P3ABandwidthSavingsTrackerTest : public ::testing::Test {
   }
 
  protected:
+  void FlushSavings() {
+    task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  }
+
+  base::test::TaskEnvironment task_environment_;
   base::SimpleTestClock* clock_;
   TestingPrefServiceSimple pref_service_;
   std::unique_ptr<P3ABandwidthSavingsTracker> tracker_;
@@ -37,6 +47,7 @@ class P3ABandwidthSavingsTrackerTest : public ::testing::Test {
 TEST_F(P3ABandwidthSavingsTrackerTest, RecordSavingsHistogram) {
   base::HistogramTester tester;
   tracker_->RecordSavings(10 << 20);
+  FlushSavings();
   tester.ExpectBucketCount(kSavingsDailyUMAHistogramName, 1, 1);
 }
 
@@ -46,6 +57,7 @@ TEST_F(P3ABandwidthSavingsTrackerTest, RecordSavingsHistogramIncrements) {
   tracker_->RecordSavings(20 << 20);
   tracker_->RecordSavings(5 << 20);
   tracker_->RecordSavings(20 << 20);
+  FlushSavings();
   tester.ExpectBucketCount(kSavingsDailyUMAHistogramName, 2, 1);
 }
 
@@ -53,7 +65,53 @@ TEST_F(P3ABandwidthSavingsTrackerTest, RecordSavingsHistogramLargeIncrements) {
   base::HistogramTester tester;
   tracker_->RecordSavings(10 << 20);
   tracker_->RecordSavings(700 << 20);
+  FlushSavings();
   tester.ExpectBucketCount(kSavingsDailyUMAHistogramName, 6, 1);
 }
 
+TEST_F(P3ABandwidthSavingsTrackerTest, RecordSavingsDoesNotWritePrefs) {
+  base::HistogramTester tester;
+  tracker_->RecordSavings(10 << 20);
+  tracker_->RecordSavings(20 << 20);
+  EXPECT_TRUE(pref_service_.GetList(prefs::kBandwidthSavedDailyBytes)
+                  ->GetList()
+                  .empty());
+  tester.ExpectTotalCount(kSavingsDailyUMAHistogramName, 0);
+
+  FlushSavings();
+  EXPECT_EQ(1u, pref_service_.GetList(prefs::kBandwidthSavedDailyBytes)
+                    ->GetList()
+                    .size());
+  tester.ExpectUniqueSample(kSavingsDailyUMAHistogramName, 1, 1);
+}
+
+TEST_F(P3ABandwidthSavingsTrackerTest, FlushSavingsOnDayChange) {
+  base::HistogramTester tester;
+  tracker_->RecordSavings(10 << 20);
+  clock_->Advance(base::TimeDelta::FromDays(1));
+  tracker_->RecordSavings(60 << 20);
+  tester.ExpectUniqueSample(kSavingsDailyUMAHistogramName, 1, 1);
+}
+
+TEST_F(P3ABandwidthSavingsTrackerTest, FlushSavingsAfterMidnight) {
+  const base::Time day = clock_->Now().LocalMidnight();
+  tracker_->RecordSavings(10 << 20);
+  clock_->Advance(base::TimeDelta::FromDays(1));
+  FlushSavings();
+
+  const base::Value* saved =
+      pref_service_.GetList(prefs::kBandwidthSavedDailyBytes);
+  ASSERT_EQ(1u, saved->GetList().size());
+  const base::Value* saved_day = saved->GetList()[0].FindKey("day");
+  ASSERT_TRUE(saved_day && saved_day->is_double());
+  EXPECT_EQ(day, base::Time::FromDoubleT(saved_day->GetDouble()));
+}
+
+TEST_F(P3ABandwidthSavingsTrackerTest, FlushSavingsOnDestruction) {
+  base::HistogramTester tester;
+  tracker_->RecordSavings(60 << 20);
+  tracker_.reset();
+  tester.ExpectUniqueSample(kSavingsDailyUMAHistogramName, 2, 1);
+}
+
 }  // namespace brave_perf_predictor
@@ -61,6 +61,19 @@ class PerfPredictorTabHelperTest : public InProcessBrowserTest {
 
   void TearDown() override { InProcessBrowserTest::TearDown(); }
 
+  // Custom filter engines are built on their own sequence, then swapped in on
+  // the shields task runner.
+  void WaitForCustomFilters() {
+    scoped_refptr<base::ThreadTestHelper> build_helper(
+        new base::ThreadTestHelper(
+            g_brave_browser_process->ad_block_custom_filters_service()
+                ->GetEngineBuildTaskRunnerForTest()));
+    ASSERT_TRUE(build_helper->Run());
+    scoped_refptr<base::ThreadTestHelper> tr_helper(new base::ThreadTestHelper(
+        g_brave_browser_process->ad_block_service()->GetTaskRunner()));
+    ASSERT_TRUE(tr_helper->Run());
+  }
+
   void InitEmbeddedTestServer() {
     brave::RegisterPathProvider();
     base::FilePath test_data_dir;
@@ -91,6 +104,7 @@ IN_PROC_BROWSER_TEST_F(PerfPredictorTabHelperTest, NoBlockNoSavings) {
 IN_PROC_BROWSER_TEST_F(PerfPredictorTabHelperTest, ScriptBlockHasSavings) {
   ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
                   ->UpdateCustomFilters("*analytics.js"));
+  WaitForCustomFilters();
   EXPECT_EQ(getProfileBandwidthSaved(browser()), 0ULL);
 
   GURL url = embedded_test_server()->GetURL("/blocking.html");
@@ -112,6 +126,7 @@ IN_PROC_BROWSER_TEST_F(PerfPredictorTabHelperTest, ScriptBlockHasSavings) {
 IN_PROC_BROWSER_TEST_F(PerfPredictorTabHelperTest, NewNavigationStoresSavings) {
   ASSERT_TRUE(g_brave_browser_process->ad_block_custom_filters_service()
                   ->UpdateCustomFilters("*analytics.js"));
+  WaitForCustomFilters();
   EXPECT_EQ(getProfileBandwidthSaved(browser()), 0ULL);
 
   GURL url = embedded_test_server()->GetURL("/blocking.html");
@@ -5,8 +5,9 @@
 
 #include "brave/components/brave_rewards/browser/diagnostic_log.h"
 
-#include <memory>
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "base/files/file_util.h"
 #include "base/i18n/time_formatting.h"
@@ -17,8 +18,10 @@
 
 namespace {
 
-const int64_t kChunkSize = 1024;
+const int64_t kChunkSize = 16 * 1024;
 const size_t kDividerLength = 80;
+const size_t kMaxBufferedLogEntriesSize = 64 * 1024;
+const int kFlushDelayInSeconds = 2;
 
 std::string FormatTime(const base::Time& time) {
   return base::UTF16ToUTF8(
@@ -48,217 +51,138 @@ std::string GetLogVerboseLevelName(int verbose_level) {
   return verbose_level_name;
 }
 
-bool Create(const base::FilePath& file_path, base::File* file) {
-  DCHECK(file);
-
-  file->Initialize(file_path, base::File::FLAG_CREATE_ALWAYS |
-                                  base::File::FLAG_READ |
-                                  base::File::FLAG_WRITE);
-
-  return file->IsValid();
-}
-
-bool Open(const base::FilePath& file_path, base::File* file) {
-  DCHECK(file);
-
-  file->Initialize(file_path, base::File::FLAG_OPEN | base::File::FLAG_READ |
-                                  base::File::FLAG_WRITE);
-
-  return file->IsValid();
-}
-
-bool CreateOrOpen(const base::FilePath& file_path, base::File* file) {
-  DCHECK(file);
-
-  if (!base::PathExists(file_path)) {
-    return Create(file_path, file);
-  }
-
-  if (!Open(file_path, file)) {
-    return false;
-  }
-
-  return file->IsValid();
+// Returns the path of the segment which holds the lines written before those
+// in |file_path|.
+base::FilePath GetPreviousSegmentPath(const base::FilePath& file_path) {
+  return file_path.AddExtension(FILE_PATH_LITERAL("1"));
 }
 
-int64_t SeekFromEnd(base::File* file, int num_lines) {
+// Returns the offset at which the last |*num_lines| lines of |file| start and
+// sets |*num_lines| to 0. If the file has fewer lines, returns 0 and decrements
+// |*num_lines| by the number of lines in the file. Returns -1 on error.
+int64_t SeekFromEnd(base::File* file, int* num_lines) {
   DCHECK(file);
+  DCHECK(num_lines);
 
   if (!file->IsValid()) {
-    return 0;
+    return -1;
   }
 
-  if (num_lines == 0) {
-    return 0;
+  if (*num_lines == 0) {
+    return file->GetLength();
   }
 
-  int64_t length = file->GetLength();
+  const int64_t length = file->GetLength();
   if (length == -1) {
     return -1;
   }
 
-  if (length == 0) {
-    return 0;
-  }
-
   int line_count = 0;
 
-  char chunk[kChunkSize];
-  int64_t chunk_size = kChunkSize;
-  int64_t last_chunk_size = 0;
-
-  if (file->Seek(base::File::FROM_END, 0) == -1) {
-    return -1;
-  }
-
-  do {
-    if (chunk_size > length) {
-      chunk_size = length;
-    }
+  std::vector<char> chunk(kChunkSize);
+  int64_t position = length;
 
-    const int64_t seek_offset = chunk_size + last_chunk_size;
-    if (file->Seek(base::File::FROM_CURRENT, -seek_offset) == -1) {
-      return -1;
-    }
+  while (position > 0) {
+    const int chunk_size =
+        static_cast<int>(std::min<int64_t>(kChunkSize, position));
+    position -= chunk_size;
 
-    if (file->ReadAtCurrentPos(chunk, chunk_size) == -1) {
+    if (file->Read(position, chunk.data(), chunk_size) != chunk_size) {
       return -1;
     }
 
     for (int i = chunk_size - 1; i >= 0; i--) {
       if (chunk[i] == '\n') {
         line_count++;
-        if (line_count == num_lines + 1) {
-          return length;
+        if (line_count == *num_lines + 1) {
+          *num_lines = 0;
+          return position + i + 1;
         }
       }
-
-      length--;
     }
-
-    last_chunk_size = chunk_size;
-  } while (length > 0);
-
-  return length;
-}
-
-bool TrimBeginningOfFile(base::File* file, int keep_num_lines) {
-  DCHECK(file);
-
-  if (file->GetLength() == 0) {
-    return true;
-  }
-
-  const int64_t offset = SeekFromEnd(file, keep_num_lines);
-  if (offset == -1) {
-    return false;
-  }
-
-  if (offset == 0) {
-    return true;
-  }
-
-  if (file->Seek(base::File::FROM_BEGIN, offset) == -1) {
-    return false;
-  }
-
-  const int64_t size = file->GetLength() - offset;
-  std::unique_ptr<char[]> buffer = std::make_unique<char[]>(size + 1);
-
-  if (file->ReadAtCurrentPos(buffer.get(), size) == -1) {
-    return false;
-  }
-
-  if (file->Seek(base::File::FROM_BEGIN, 0) == -1) {
-    return false;
   }
 
-  const std::string data = std::string(buffer.get());
-  const int64_t new_size = data.size();
+  *num_lines -= line_count;
+  return 0;
+}
 
-  if (file->WriteAtCurrentPos(data.c_str(), new_size) == -1) {
-    return false;
+// Prepends the last |*num_lines| lines of the file at |file_path| to |data|,
+// or the entire file if |*num_lines| is -1. See |SeekFromEnd| for how
+// |*num_lines| is updated.
+bool ReadLastNLinesOfFile(const base::FilePath& file_path,
+                          int* num_lines,
+                          std::string* data) {
+  DCHECK(num_lines);
+  DCHECK(data);
+
+  base::File file(file_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid()) {
+    return file.error_details() == base::File::FILE_ERROR_NOT_FOUND;
   }
 
-  if (!file->SetLength(new_size)) {
-    return false;
+  int64_t offset = 0;
+  if (*num_lines != -1) {
+    offset = SeekFromEnd(&file, num_lines);
+    if (offset == -1) {
+      return false;
+    }
   }
 
-  return true;
-}
-
-bool MaybeTrimBeginningOfFile(base::File* file,
-                              int64_t max_file_size,
-                              int keep_num_lines,
-                              bool first_write) {
-  DCHECK(file);
-
-  const int64_t length = file->GetLength();
+  const int64_t length = file.GetLength();
   if (length == -1) {
     return false;
   }
 
-  // We do not trim the log on first run so that if the browser
-  // crashes and we investigate the log with the user they are able to
-  // re-run the browser without losing past logs.
-  if (!first_write && length <= max_file_size) {
+  const int size = static_cast<int>(length - offset);
+  if (size == 0) {
     return true;
   }
 
-  if (!TrimBeginningOfFile(file, keep_num_lines)) {
+  std::string tail(size, '\0');
+  if (file.Read(offset, &tail[0], size) != size) {
     return false;
   }
 
+  data->insert(0, tail);
   return true;
 }
 
 std::string ReadLastNLinesOnFileTaskRunner(const base::FilePath& file_path,
                                            int num_lines) {
-  base::File file;
-  if (!Open(file_path, &file)) {
-    return "";
-  }
+  std::string data;
 
-  if (file.GetLength() == 0) {
+  if (!ReadLastNLinesOfFile(file_path, &num_lines, &data)) {
     return "";
   }
 
-  int64_t offset;
-
-  if (num_lines == -1) {
-    offset = 0;
-  } else {
-    offset = SeekFromEnd(&file, num_lines);
-    if (offset == -1) {
-      return "";
-    }
-  }
-
-  if (file.Seek(base::File::FROM_BEGIN, offset) == -1) {
+  if (num_lines != 0 &&
+      !ReadLastNLinesOfFile(GetPreviousSegmentPath(file_path), &num_lines,
+                            &data)) {
     return "";
   }
 
-  const int64_t size = file.GetLength() - offset;
-  std::unique_ptr<char[]> buffer = std::make_unique<char[]>(size + 1);
-
-  if (file.ReadAtCurrentPos(buffer.get(), size) == -1) {
-    return "";
-  }
-
-  return std::string(buffer.get());
+  return data;
 }
 
 bool WriteOnFileTaskRunner(const base::FilePath& file_path,
                            const std::string& log_entry,
-                           int64_t max_file_size,
-                           int keep_num_lines,
+                           int64_t max_segment_size,
                            bool first_write) {
-  base::File file;
-  if (!CreateOrOpen(file_path, &file)) {
-    return false;
+  // Once the current segment is full it replaces the previous one, so the log
+  // is trimmed by dropping the oldest segment rather than rewriting the file
+  int64_t segment_size = 0;
+  if (base::GetFileSize(file_path, &segment_size) &&
+      segment_size + static_cast<int64_t>(log_entry.length()) >
+          max_segment_size) {
+    if (!base::ReplaceFile(file_path, GetPreviousSegmentPath(file_path),
+                           nullptr)) {
+      return false;
+    }
   }
 
-  if (file.Seek(base::File::FROM_END, 0) == -1) {
+  base::File file(file_path,
+                  base::File::FLAG_OPEN_ALWAYS | base::File::FLAG_APPEND);
+  if (!file.IsValid()) {
     return false;
   }
 
@@ -267,16 +191,13 @@ bool WriteOnFileTaskRunner(const base::FilePath& file_path,
     file.WriteAtCurrentPos(divider.c_str(), divider.length());
   }
 
-  if (file.WriteAtCurrentPos(log_entry.c_str(), log_entry.length()) == -1) {
-    return false;
-  }
-
-  return MaybeTrimBeginningOfFile(&file, max_file_size, keep_num_lines,
-                                  first_write);
+  return file.WriteAtCurrentPos(log_entry.c_str(), log_entry.length()) != -1;
 }
 
 bool DeleteOnFileTaskRunner(const base::FilePath& file_path) {
-  return base::DeleteFile(file_path);
+  const bool deleted_previous_segment =
+      base::DeleteFile(GetPreviousSegmentPath(file_path));
+  return base::DeleteFile(file_path) && deleted_previous_segment;
 }
 
 }  // namespace
@@ -284,22 +205,22 @@ bool DeleteOnFileTaskRunner(const base::FilePath& file_path) {
 namespace brave_rewards {
 
 DiagnosticLog::DiagnosticLog(const base::FilePath& file_path,
-                             int64_t max_file_size,
-                             int keep_num_lines)
+                             int64_t max_file_size)
     : file_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
           {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
            base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
       file_path_(file_path),
-      max_file_size_(max_file_size),
-      keep_num_lines_(keep_num_lines),
+      max_segment_size_(max_file_size / 2),
       first_write_(true) {}
 
 DiagnosticLog::~DiagnosticLog() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  Flush();
 }
 
 void DiagnosticLog::ReadLastNLines(int num_lines, ReadCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  Flush();
   file_task_runner_->PostTaskAndReplyWithResult(
       FROM_HERE,
       base::BindOnce(&ReadLastNLinesOnFileTaskRunner, file_path_, num_lines),
@@ -310,13 +231,20 @@ void DiagnosticLog::ReadLastNLines(int num_lines, ReadCallback callback) {
 void DiagnosticLog::Write(const std::string& log_entry,
                           StatusCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  file_task_runner_->PostTaskAndReplyWithResult(
-      FROM_HERE,
-      base::BindOnce(&WriteOnFileTaskRunner, file_path_, log_entry,
-                     max_file_size_, keep_num_lines_, first_write_),
-      base::BindOnce(&DiagnosticLog::OnWrite, AsWeakPtr(),
-                     std::move(callback)));
-  first_write_ = false;
+  buffered_log_entries_ += log_entry;
+  buffered_callbacks_.push_back(std::move(callback));
+
+  if (buffered_log_entries_.size() >= kMaxBufferedLogEntriesSize) {
+    Flush();
+    return;
+  }
+
+  if (!flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE,
+                       base::TimeDelta::FromSeconds(kFlushDelayInSeconds),
+                       base::BindOnce(&DiagnosticLog::Flush,
+                                      base::Unretained(this)));
+  }
 }
 
 void DiagnosticLog::Write(const std::string& log_entry,
@@ -342,21 +270,48 @@ void DiagnosticLog::Write(const std::string& log_entry,
 
 void DiagnosticLog::Delete(StatusCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  Flush();
   file_task_runner_->PostTaskAndReplyWithResult(
       FROM_HERE, base::BindOnce(&DeleteOnFileTaskRunner, file_path_),
       base::BindOnce(&DiagnosticLog::OnDelete, AsWeakPtr(),
                      std::move(callback)));
 }
 
+void DiagnosticLog::Flush() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  flush_timer_.Stop();
+
+  if (buffered_log_entries_.empty()) {
+    return;
+  }
+
+  std::string log_entries;
+  log_entries.swap(buffered_log_entries_);
+
+  std::vector<StatusCallback> callbacks;
+  callbacks.swap(buffered_callbacks_);
+
+  file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&WriteOnFileTaskRunner, file_path_, std::move(log_entries),
+                     max_segment_size_, first_write_),
+      base::BindOnce(&DiagnosticLog::OnWrite, AsWeakPtr(),
+                     std::move(callbacks)));
+  first_write_ = false;
+}
+
 void DiagnosticLog::OnReadLastNLines(ReadCallback callback,
                                      const std::string& data) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   std::move(callback).Run(data);
 }
 
-void DiagnosticLog::OnWrite(StatusCallback callback, bool result) {
+void DiagnosticLog::OnWrite(std::vector<StatusCallback> callbacks,
+                            bool result) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  std::move(callback).Run(result);
+  for (auto& callback : callbacks) {
+    std::move(callback).Run(result);
+  }
 }
 
 void DiagnosticLog::OnDelete(StatusCallback callback, bool result) {
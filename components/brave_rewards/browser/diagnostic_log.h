@@ -7,22 +7,27 @@
 #define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_DIAGNOSTIC_LOG_H_
 
 #include <string>
+#include <vector>
 
 #include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/sequence_checker.h"
 #include "base/sequenced_task_runner.h"
+#include "base/timer/timer.h"
 
 namespace brave_rewards {
 
-// This class provides access to a diagnostic log file. If the file
-// size ever exceeds the provided maximum file size, it is trimmed to
-// keep only the last n lines.
+// This class provides access to a diagnostic log file. The log is
+// stored in two segments, the file itself and a previous segment next
+// to it with a ".1" extension. Once the file reaches half of the
+// provided maximum file size it replaces the previous segment, so the
+// log never exceeds the maximum size and is never rewritten.
+//
+// Log entries are buffered in memory and written in batches, once the
+// buffer grows large enough or shortly after the first buffered entry.
 class DiagnosticLog : public base::SupportsWeakPtr<DiagnosticLog> {
  public:
-  DiagnosticLog(const base::FilePath& path,
-                int64_t max_file_size,
-                int keep_num_lines);
+  DiagnosticLog(const base::FilePath& path, int64_t max_file_size);
   DiagnosticLog(const DiagnosticLog&) = delete;
   DiagnosticLog& operator=(const DiagnosticLog&) = delete;
   ~DiagnosticLog();
@@ -30,13 +35,14 @@ class DiagnosticLog : public base::SupportsWeakPtr<DiagnosticLog> {
   using ReadCallback = base::OnceCallback<void(const std::string& data)>;
   using StatusCallback = base::OnceCallback<void(bool result)>;
 
-  // Reads last |num_lines| lines of file. If |num_lines| is -1, reads
-  // the entire file.
+  // Reads last |num_lines| lines of the log. If |num_lines| is -1,
+  // reads the entire log.
   void ReadLastNLines(int num_lines, ReadCallback callback);
 
-  // Appends |log_entry| to end of file. If file doesn't exist, it is
-  // created. If total file size exceeds |max_file_size|, removes all
-  // but the last |keep_num_lines| lines.
+  // Buffers |log_entry| to be appended to end of file. If file doesn't
+  // exist, it is created. If the file would exceed half of
+  // |max_file_size|, it replaces the previous segment first. |callback|
+  // is run once the batch containing |log_entry| has been written.
   void Write(const std::string& log_entry, StatusCallback callback);
   void Write(const std::string& log_entry,
              const base::Time& time,
@@ -45,20 +51,26 @@ class DiagnosticLog : public base::SupportsWeakPtr<DiagnosticLog> {
              int verbose_level,
              StatusCallback callback);
 
-  // Deletes the file.
+  // Deletes the file and its previous segment.
   void Delete(StatusCallback callback);
 
+  // Writes any buffered log entries.
+  void Flush();
+
  private:
   void OnReadLastNLines(ReadCallback callback, const std::string& data);
-  void OnWrite(StatusCallback callback, bool result);
+  void OnWrite(std::vector<StatusCallback> callbacks, bool result);
   void OnDelete(StatusCallback callback, bool result);
 
   scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
   base::FilePath file_path_;
-  int64_t max_file_size_;
-  int keep_num_lines_;
+  int64_t max_segment_size_;
   bool first_write_;
 
+  std::string buffered_log_entries_;
+  std::vector<StatusCallback> buffered_callbacks_;
+  base::OneShotTimer flush_timer_;
+
   SEQUENCE_CHECKER(sequence_checker_);
 };
 
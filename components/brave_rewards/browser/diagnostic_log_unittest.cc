@@ -0,0 +1,166 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/diagnostic_log.h"
+
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=DiagnosticLogTest.*
+
+namespace brave_rewards {
+
+namespace {
+
+// The maximum size of each of the two segments is half of this.
+const int64_t kMaxFileSize = 200;
+
+std::string Divider() {
+  return std::string(80, '-') + "\n";
+}
+
+}  // namespace
+
+class DiagnosticLogTest : public testing::Test {
+ public:
+  DiagnosticLogTest() {}
+  ~DiagnosticLogTest() override {}
+
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    file_path_ = temp_dir_.GetPath().AppendASCII("Rewards.log");
+    previous_segment_path_ = temp_dir_.GetPath().AppendASCII("Rewards.log.1");
+  }
+
+  void CreateLog() {
+    log_ = std::make_unique<DiagnosticLog>(file_path_, kMaxFileSize);
+  }
+
+  bool Write(const std::string& log_entry) {
+    bool result = false;
+    base::RunLoop run_loop;
+    log_->Write(log_entry, base::BindOnce(
+                               [](bool* result, base::OnceClosure quit,
+                                  bool success) {
+                                 *result = success;
+                                 std::move(quit).Run();
+                               },
+                               &result, run_loop.QuitClosure()));
+    log_->Flush();
+    run_loop.Run();
+    return result;
+  }
+
+  std::string ReadLastNLines(int num_lines) {
+    std::string data;
+    base::RunLoop run_loop;
+    log_->ReadLastNLines(
+        num_lines, base::BindOnce(
+                       [](std::string* data, base::OnceClosure quit,
+                          const std::string& result) {
+                         *data = result;
+                         std::move(quit).Run();
+                       },
+                       &data, run_loop.QuitClosure()));
+    run_loop.Run();
+    return data;
+  }
+
+  std::string ReadFile(const base::FilePath& path) {
+    std::string contents;
+    base::ReadFileToString(path, &contents);
+    return contents;
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath file_path_;
+  base::FilePath previous_segment_path_;
+  std::unique_ptr<DiagnosticLog> log_;
+};
+
+TEST_F(DiagnosticLogTest, RotatesAtSegmentSizeLimit) {
+  CreateLog();
+
+  const std::string first_entry = "aaa\n";
+  const std::string second_entry = "bbb\n";
+  const std::string third_entry = std::string(19, 'c') + "\n";
+
+  // The divider and the first two entries fill most of the segment.
+  ASSERT_TRUE(Write(first_entry));
+  ASSERT_TRUE(Write(second_entry));
+  EXPECT_EQ(Divider() + first_entry + second_entry, ReadFile(file_path_));
+  EXPECT_FALSE(base::PathExists(previous_segment_path_));
+
+  // The third entry would take the segment past half of the maximum size, so
+  // the segment replaces the previous one first.
+  ASSERT_TRUE(Write(third_entry));
+  EXPECT_EQ(third_entry, ReadFile(file_path_));
+  EXPECT_EQ(Divider() + first_entry + second_entry,
+            ReadFile(previous_segment_path_));
+}
+
+TEST_F(DiagnosticLogTest, ReadsAcrossSegments) {
+  CreateLog();
+
+  const std::string first_entry = std::string(49, 'a') + "\n";
+  const std::string second_entry = std::string(49, 'b') + "\n";
+  const std::string third_entry = std::string(49, 'c') + "\n";
+
+  ASSERT_TRUE(Write(first_entry));
+  ASSERT_TRUE(Write(second_entry));
+  ASSERT_TRUE(Write(third_entry));
+  ASSERT_EQ(second_entry + third_entry, ReadFile(file_path_));
+  ASSERT_EQ(Divider() + first_entry, ReadFile(previous_segment_path_));
+
+  // Lines in the current segment are read without the previous segment.
+  EXPECT_EQ(third_entry, ReadLastNLines(1));
+  EXPECT_EQ(second_entry + third_entry, ReadLastNLines(2));
+
+  // Further lines come from the end of the previous segment.
+  EXPECT_EQ(first_entry + second_entry + third_entry, ReadLastNLines(3));
+  EXPECT_EQ(Divider() + first_entry + second_entry + third_entry,
+            ReadLastNLines(10));
+  EXPECT_EQ(Divider() + first_entry + second_entry + third_entry,
+            ReadLastNLines(-1));
+}
+
+TEST_F(DiagnosticLogTest, StartsWithExistingPreviousSegment) {
+  const std::string old_entry = "old\n";
+  const std::string current_entry = "current\n";
+  ASSERT_TRUE(base::WriteFile(previous_segment_path_, old_entry));
+  ASSERT_TRUE(base::WriteFile(file_path_, current_entry));
+
+  CreateLog();
+
+  EXPECT_EQ(old_entry + current_entry, ReadLastNLines(2));
+
+  // The first write of a session appends to the current segment.
+  const std::string new_entry = std::string(9, 'n') + "\n";
+  ASSERT_TRUE(Write(new_entry));
+  EXPECT_EQ(current_entry + Divider() + new_entry, ReadFile(file_path_));
+  EXPECT_EQ(old_entry, ReadFile(previous_segment_path_));
+
+  // Once the current segment is full it replaces the existing previous
+  // segment.
+  const std::string last_entry = std::string(19, 'l') + "\n";
+  ASSERT_TRUE(Write(last_entry));
+  EXPECT_EQ(last_entry, ReadFile(file_path_));
+  EXPECT_EQ(current_entry + Divider() + new_entry,
+            ReadFile(previous_segment_path_));
+
+  EXPECT_EQ(current_entry + Divider() + new_entry + last_entry,
+            ReadLastNLines(-1));
+}
+
+}  // namespace brave_rewards
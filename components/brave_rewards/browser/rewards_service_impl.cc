@@ -35,6 +35,7 @@
 #include "base/task_runner_util.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
 #include "bat/ads/pref_names.h"
 #include "bat/ledger/global_constants.h"
 #include "bat/ledger/ledger_database.h"
@@ -72,6 +73,7 @@
 #include "content/public/browser/service_process_host.h"
 #include "content/public/browser/storage_partition.h"
 #include "content/public/browser/url_data_source.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "net/base/escape.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "net/base/url_util.h"
@@ -100,8 +102,11 @@ static const unsigned int kRetriesCountOnNetworkChange = 1;
 namespace {
 
 const int kDiagnosticLogMaxVerboseLevel = 6;
-const int kDiagnosticLogKeepNumLines = 20000;
 const int kDiagnosticLogMaxFileSize = 10 * (1024 * 1024);
+// How long a fetched balance is served to later callers. Anything the
+// service knows to change the balance drops it earlier.
+constexpr base::TimeDelta kBalanceCacheDuration =
+    base::TimeDelta::FromSeconds(15);
 const char pref_prefix[] = "brave.rewards";
 
 std::string URLMethodToRequestType(ledger::type::UrlMethod method) {
@@ -326,8 +331,7 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
       publisher_list_path_(profile->GetPath().Append(kPublishers_list)),
       diagnostic_log_(
           new DiagnosticLog(profile_->GetPath().Append(kDiagnosticLogPath),
-                            kDiagnosticLogMaxFileSize,
-                            kDiagnosticLogKeepNumLines)),
+                            kDiagnosticLogMaxFileSize)),
       notification_service_(new RewardsNotificationServiceImpl(profile)),
       next_timer_id_(0) {
   // Set up the rewards data source
@@ -451,6 +455,11 @@ void RewardsServiceImpl::StartLedgerProcessIfNecessary() {
     return;
   }
 
+  TRACE_EVENT0("brave.rewards",
+               "RewardsServiceImpl::StartLedgerProcessIfNecessary");
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN0(
+      "brave.rewards", "RewardsServiceImpl::Start", TRACE_ID_LOCAL(this));
+
   ledger_database_.reset(
       ledger::LedgerDatabase::CreateInstance(publisher_info_db_path_));
 
@@ -825,10 +834,15 @@ void RewardsServiceImpl::Shutdown() {
   url_loaders_.clear();
 
   bat_ledger_.reset();
+  diagnostic_log_->Flush();
   RewardsService::Shutdown();
 }
 
 void RewardsServiceImpl::OnLedgerInitialized(ledger::type::Result result) {
+  TRACE_EVENT_NESTABLE_ASYNC_END1("brave.rewards", "RewardsServiceImpl::Start",
+                                  TRACE_ID_LOCAL(this), "result",
+                                  static_cast<int>(result));
+
   if (result == ledger::type::Result::LEDGER_OK) {
     StartNotificationTimers();
   }
@@ -889,6 +903,8 @@ void RewardsServiceImpl::GetAutoContributeProperties(
 void RewardsServiceImpl::OnReconcileComplete(
     const ledger::type::Result result,
     ledger::type::ContributionInfoPtr contribution) {
+  InvalidateBalanceCache();
+
   if (result == ledger::type::Result::LEDGER_OK &&
       contribution->type == ledger::type::RewardsType::RECURRING_TIP) {
     MaybeShowNotificationTipsPaid();
@@ -997,8 +1013,8 @@ void RewardsServiceImpl::LoadURL(
     ledger::type::UrlResponse response;
     response.url = request->url;
     response.status_code = response_status_code;
-    response.body = test_response;
-    response.headers = test_headers;
+    response.body = std::move(test_response);
+    response.headers = std::move(test_headers);
     callback(response);
     return;
   }
@@ -1037,11 +1053,15 @@ void RewardsServiceImpl::LoadURL(
     loader->AttachStringForUpload(request->content, request->content_type);
   }
 
+  if (!url_loader_factory_) {
+    url_loader_factory_ =
+        content::BrowserContext::GetDefaultStoragePartition(profile_)
+            ->GetURLLoaderFactoryForBrowserProcess();
+  }
+
   auto loader_it = url_loaders_.insert(url_loaders_.begin(), std::move(loader));
   loader_it->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
-      content::BrowserContext::GetDefaultStoragePartition(profile_)
-          ->GetURLLoaderFactoryForBrowserProcess()
-          .get(),
+      url_loader_factory_.get(),
       base::BindOnce(&RewardsServiceImpl::OnURLLoaderComplete,
                      base::Unretained(this), loader_it, callback));
 }
@@ -1058,7 +1078,8 @@ void RewardsServiceImpl::OnURLLoaderComplete(
   }
 
   ledger::type::UrlResponse response;
-  response.body = response_body ? *response_body : "";
+  if (response_body)
+    response.body = std::move(*response_body);
 
   if (loader->NetError() != net::OK) {
     response.error = net::ErrorToString(loader->NetError());
@@ -1289,6 +1310,8 @@ void RewardsServiceImpl::RecoverWallet(const std::string& passPhrase) {
 }
 
 void RewardsServiceImpl::OnRecoverWallet(const ledger::type::Result result) {
+  InvalidateBalanceCache();
+
   // Fetch balance after recovering wallet in order to initiate P3A
   // stats collection
   FetchBalance(base::DoNothing());
@@ -1323,6 +1346,8 @@ void RewardsServiceImpl::OnAttestPromotion(
     return;
   }
 
+  InvalidateBalanceCache();
+
   PrefService* pref_service = profile_->GetPrefs();
   pref_service->SetBoolean(prefs::kUserHasClaimedGrant, true);
 
@@ -1421,6 +1446,8 @@ void RewardsServiceImpl::OnDiagnosticLogDeletedForCompleteReset(
     ledger_state_path_,
     publisher_state_path_,
     publisher_info_db_path_,
+    // A stale write-ahead log must not be replayed into a new database.
+    base::FilePath(publisher_info_db_path_.value() + FILE_PATH_LITERAL("-wal")),
     publisher_list_path_,
   };
   base::PostTaskAndReplyWithResult(
@@ -1442,6 +1469,7 @@ void RewardsServiceImpl::Reset() {
   }
 
   current_media_fetchers_.clear();
+  InvalidateBalanceCache();
   bat_ledger_.reset();
   bat_ledger_client_receiver_.reset();
   bat_ledger_service_.reset();
@@ -2494,6 +2522,12 @@ bool RewardsServiceImpl::Connected() const {
   return bat_ledger_.is_bound();
 }
 
+void RewardsServiceImpl::SetBatLedgerForTesting(
+    mojo::PendingAssociatedRemote<bat_ledger::mojom::BatLedger> bat_ledger) {
+  bat_ledger_.reset();
+  bat_ledger_.Bind(std::move(bat_ledger));
+}
+
 void RewardsServiceImpl::SetLedgerEnvForTesting() {
   ledger_for_testing_ = true;
 }
@@ -2756,11 +2790,8 @@ void RewardsServiceImpl::OnContributeUnverifiedPublishers(
   }
 }
 
-void RewardsServiceImpl::OnFetchBalance(
-    FetchBalanceCallback callback,
-    const ledger::type::Result result,
-    ledger::type::BalancePtr balance) {
-  // Record wallet P3A stats
+void RewardsServiceImpl::RecordWalletP3A(
+    const ledger::type::Balance* balance) {
   if (IsRewardsEnabled()) {
     PrefService* pref_service = profile_->GetPrefs();
     const bool grants_claimed =
@@ -2779,8 +2810,25 @@ void RewardsServiceImpl::OnFetchBalance(
                                static_cast<size_t>(balance_minus_grant));
     }
   }
+}
+
+void RewardsServiceImpl::OnFetchBalance(
+    const ledger::type::Result result,
+    ledger::type::BalancePtr balance) {
+  if (result == ledger::type::Result::LEDGER_OK && balance &&
+      !balance_invalidated_during_fetch_) {
+    cached_balance_ = balance->Clone();
+    cached_balance_time_ = base::TimeTicks::Now();
+  }
 
-  std::move(callback).Run(result, std::move(balance));
+  std::vector<FetchBalanceCallback> callbacks;
+  callbacks.swap(fetch_balance_callbacks_);
+  for (auto& callback : callbacks) {
+    // Each caller used to run its own fetch, so wallet P3A is still recorded
+    // once per caller.
+    RecordWalletP3A(balance.get());
+    std::move(callback).Run(result, balance ? balance->Clone() : nullptr);
+  }
 }
 
 void RewardsServiceImpl::FetchBalance(FetchBalanceCallback callback) {
@@ -2789,10 +2837,32 @@ void RewardsServiceImpl::FetchBalance(FetchBalanceCallback callback) {
     return;
   }
 
-  bat_ledger_->FetchBalance(
-      base::BindOnce(&RewardsServiceImpl::OnFetchBalance,
-                     AsWeakPtr(),
-                     std::move(callback)));
+  if (cached_balance_ &&
+      base::TimeTicks::Now() - cached_balance_time_ < kBalanceCacheDuration) {
+    RecordWalletP3A(cached_balance_.get());
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(std::move(callback), ledger::type::Result::LEDGER_OK,
+                       cached_balance_->Clone()));
+    return;
+  }
+
+  fetch_balance_callbacks_.push_back(std::move(callback));
+  if (fetch_balance_callbacks_.size() > 1) {
+    return;
+  }
+
+  balance_invalidated_during_fetch_ = false;
+  // Callers must hear back even if the ledger process goes away meanwhile, as
+  // later fetches wait on this one.
+  bat_ledger_->FetchBalance(mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+      base::BindOnce(&RewardsServiceImpl::OnFetchBalance, AsWeakPtr()),
+      ledger::type::Result::LEDGER_ERROR, nullptr));
+}
+
+void RewardsServiceImpl::InvalidateBalanceCache() {
+  cached_balance_.reset();
+  balance_invalidated_during_fetch_ = true;
 }
 
 std::string RewardsServiceImpl::GetLegacyWallet() {
@@ -2856,6 +2926,8 @@ void RewardsServiceImpl::OnProcessExternalWalletAuthorization(
     ProcessRewardsPageUrlCallback callback,
     const ledger::type::Result result,
     const base::flat_map<std::string, std::string>& args) {
+  // Linking a wallet brings its balance in.
+  InvalidateBalanceCache();
   std::move(callback).Run(result, wallet_type, action, args);
 }
 
@@ -2910,6 +2982,8 @@ void RewardsServiceImpl::ProcessRewardsPageUrl(
 void RewardsServiceImpl::OnDisconnectWallet(
     const std::string& wallet_type,
     const ledger::type::Result result) {
+  InvalidateBalanceCache();
+
   for (auto& observer : observers_) {
     observer.OnDisconnectWallet(this, result, wallet_type);
   }
@@ -3057,6 +3131,8 @@ ledger::type::ClientInfoPtr RewardsServiceImpl::GetClientInfo() {
 }
 
 void RewardsServiceImpl::UnblindedTokensReady() {
+  InvalidateBalanceCache();
+
   for (auto& observer : observers_) {
     observer.OnUnblindedTokensReady(this);
   }
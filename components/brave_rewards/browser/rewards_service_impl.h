@@ -21,6 +21,7 @@
 #include "base/observer_list.h"
 #include "base/one_shot_event.h"
 #include "base/sequence_checker.h"
+#include "base/time/time.h"
 #include "base/values.h"
 #include "bat/ledger/ledger.h"
 #include "bat/ledger/ledger_client.h"
@@ -34,6 +35,7 @@
 #include "content/public/browser/browser_thread.h"
 #include "mojo/public/cpp/bindings/associated_receiver.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
+#include "mojo/public/cpp/bindings/pending_associated_remote.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "ui/gfx/image/image.h"
 
@@ -58,6 +60,7 @@ class DB;
 }  // namespace leveldb
 
 namespace network {
+class SharedURLLoaderFactory;
 class SimpleURLLoader;
 }  // namespace network
 
@@ -343,6 +346,8 @@ class RewardsServiceImpl : public RewardsService,
   bool IsRewardsEnabled() const override;
 
   // Testing methods
+  void SetBatLedgerForTesting(
+      mojo::PendingAssociatedRemote<bat_ledger::mojom::BatLedger> bat_ledger);
   void SetLedgerEnvForTesting();
   void PrepareLedgerEnvForTesting();
   void StartMonthlyContributionForTest();
@@ -467,9 +472,12 @@ class RewardsServiceImpl : public RewardsService,
 
   void OnRemoveAllPendingContributions(const ledger::type::Result result);
 
-  void OnFetchBalance(FetchBalanceCallback callback,
-                      const ledger::type::Result result,
+  void RecordWalletP3A(const ledger::type::Balance* balance);
+  void OnFetchBalance(const ledger::type::Result result,
                       ledger::type::BalancePtr balance);
+  // Drops the cached balance, and makes a fetch in flight not cache its
+  // result, after anything that may have changed the balance.
+  void InvalidateBalanceCache();
 
   void OnGetExternalWallet(GetExternalWalletCallback callback,
                            const ledger::type::Result result,
@@ -778,12 +786,23 @@ class RewardsServiceImpl : public RewardsService,
 
   std::unique_ptr<base::OneShotEvent> ready_;
   SimpleURLLoaderList url_loaders_;
+  // Shared by all ledger requests, so that they go through one factory and
+  // the storage partition isn't looked up for every request.
+  scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   std::map<std::string, BitmapFetcherService::RequestId>
       current_media_fetchers_;
   std::unique_ptr<base::OneShotTimer> notification_startup_timer_;
   std::unique_ptr<base::RepeatingTimer> notification_periodic_timer_;
   PrefChangeRegistrar profile_pref_change_registrar_;
 
+  // The panel, the tip dialog and the rewards page each fetch the balance
+  // when shown, so callers share the fetch in flight and a recent result
+  // rather than each querying the wallet servers.
+  std::vector<FetchBalanceCallback> fetch_balance_callbacks_;
+  ledger::type::BalancePtr cached_balance_;
+  base::TimeTicks cached_balance_time_;
+  bool balance_invalidated_during_fetch_ = false;
+
   uint32_t next_timer_id_;
   int32_t country_id_ = 0;
   bool reset_states_;
@@ -4,15 +4,25 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <map>
+#include <utility>
+#include <vector>
 
 #include "base/files/scoped_temp_dir.h"
+#include "base/notreached.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "bat/ads/pref_names.h"
 #include "bat/ledger/mojom_structs.h"
 #include "brave/browser/brave_rewards/rewards_service_factory.h"
 #include "brave/components/brave_rewards/browser/rewards_service_impl.h"
 #include "brave/components/brave_rewards/browser/rewards_service_observer.h"
 #include "brave/components/brave_rewards/browser/test_util.h"
+#include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom-test-utils.h"
 #include "chrome/browser/profiles/profile.h"
+#include "components/prefs/pref_service.h"
 #include "content/public/test/browser_task_environment.h"
+#include "mojo/public/cpp/bindings/associated_receiver.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -49,6 +59,35 @@ class MockRewardsServiceObserver : public RewardsServiceObserver {
   MOCK_METHOD2(OnAdsEnabled, void(RewardsService*, bool));
 };
 
+// Answers FetchBalance only, when the test says so.
+class FakeBatLedger : public bat_ledger::mojom::BatLedgerInterceptorForTesting {
+ public:
+  bat_ledger::mojom::BatLedger* GetForwardingInterface() override {
+    NOTREACHED();
+    return nullptr;
+  }
+
+  void FetchBalance(FetchBalanceCallback callback) override {
+    fetch_balance_callbacks_.push_back(std::move(callback));
+  }
+
+  size_t pending_fetches() const { return fetch_balance_callbacks_.size(); }
+
+  void RespondToFetches(double total) {
+    std::vector<FetchBalanceCallback> callbacks;
+    callbacks.swap(fetch_balance_callbacks_);
+    for (auto& callback : callbacks) {
+      auto balance = ledger::type::Balance::New();
+      balance->total = total;
+      std::move(callback).Run(ledger::type::Result::LEDGER_OK,
+                              std::move(balance));
+    }
+  }
+
+ private:
+  std::vector<FetchBalanceCallback> fetch_balance_callbacks_;
+};
+
 class RewardsServiceTest : public testing::Test {
  public:
   RewardsServiceTest() {}
@@ -76,6 +115,29 @@ class RewardsServiceTest : public testing::Test {
   RewardsServiceImpl* rewards_service() { return rewards_service_; }
   MockRewardsServiceObserver* observer() { return observer_.get(); }
 
+  // Routes the service's ledger calls to |bat_ledger_|. Rewards are enabled
+  // first so that balance fetches record wallet P3A.
+  void ConnectFakeBatLedger() {
+    profile()->GetPrefs()->SetBoolean(ads::prefs::kEnabled, true);
+    rewards_service()->SetBatLedgerForTesting(
+        bat_ledger_receiver_.BindNewEndpointAndPassDedicatedRemote());
+  }
+
+  // Fetches the balance and returns the total it was answered with, or -1 if
+  // it wasn't answered by the time the posted tasks ran.
+  void FetchBalance(double* total) {
+    *total = -1;
+    rewards_service()->FetchBalance(base::BindLambdaForTesting(
+        [total](const ledger::type::Result result,
+                ledger::type::BalancePtr balance) {
+          ASSERT_EQ(ledger::type::Result::LEDGER_OK, result);
+          ASSERT_TRUE(balance);
+          *total = balance->total;
+        }));
+  }
+
+  FakeBatLedger* bat_ledger() { return &bat_ledger_; }
+
  private:
   // Need this as a very first member to run tests in UI thread
   // When this is set, class should not install any other MessageLoops, like
@@ -85,8 +147,68 @@ class RewardsServiceTest : public testing::Test {
   RewardsServiceImpl* rewards_service_;
   std::unique_ptr<MockRewardsServiceObserver> observer_;
   base::ScopedTempDir temp_dir_;
+  FakeBatLedger bat_ledger_;
+  mojo::AssociatedReceiver<bat_ledger::mojom::BatLedger> bat_ledger_receiver_{
+      &bat_ledger_};
 };
 
+TEST_F(RewardsServiceTest, ConcurrentBalanceFetchesShareOneFetch) {
+  ConnectFakeBatLedger();
+  base::HistogramTester histogram_tester;
+
+  double first_total;
+  double second_total;
+  FetchBalance(&first_total);
+  FetchBalance(&second_total);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1u, bat_ledger()->pending_fetches());
+
+  bat_ledger()->RespondToFetches(5.0);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(5.0, first_total);
+  EXPECT_EQ(5.0, second_total);
+  // Wallet P3A is recorded for every caller, not once per fetch.
+  histogram_tester.ExpectTotalCount("Brave.Rewards.WalletState", 2);
+}
+
+TEST_F(RewardsServiceTest, ServesCachedBalance) {
+  ConnectFakeBatLedger();
+  double total;
+  FetchBalance(&total);
+  base::RunLoop().RunUntilIdle();
+  bat_ledger()->RespondToFetches(5.0);
+  base::RunLoop().RunUntilIdle();
+  ASSERT_EQ(5.0, total);
+
+  base::HistogramTester histogram_tester;
+  FetchBalance(&total);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0u, bat_ledger()->pending_fetches());
+  EXPECT_EQ(5.0, total);
+  histogram_tester.ExpectTotalCount("Brave.Rewards.WalletState", 1);
+}
+
+TEST_F(RewardsServiceTest, RefetchesBalanceAfterInvalidation) {
+  ConnectFakeBatLedger();
+  double total;
+  FetchBalance(&total);
+  base::RunLoop().RunUntilIdle();
+  bat_ledger()->RespondToFetches(5.0);
+  base::RunLoop().RunUntilIdle();
+  ASSERT_EQ(5.0, total);
+
+  // New tokens change the balance, so the cached one is no longer served.
+  static_cast<ledger::LedgerClient*>(rewards_service())
+      ->UnblindedTokensReady();
+  FetchBalance(&total);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1u, bat_ledger()->pending_fetches());
+
+  bat_ledger()->RespondToFetches(7.0);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(7.0, total);
+}
+
 // add test for strange entries
 
 }  // namespace brave_rewards
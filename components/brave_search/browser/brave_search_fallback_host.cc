@@ -37,6 +37,11 @@ net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
 }
 
 const unsigned int kRetriesCountOnNetworkChange = 1;
+// Results are kept briefly for repeated queries, such as going back and
+// forth in the search box.
+const size_t kCachedResultsSize = 10;
+constexpr base::TimeDelta kCachedResultsLifetime =
+    base::TimeDelta::FromMinutes(1);
 static GURL backup_provider_for_test;
 }  // namespace
 
@@ -47,9 +52,15 @@ void BraveSearchFallbackHost::SetBackupProviderForTest(
   backup_provider_for_test = backup_provider;
 }
 
+BraveSearchFallbackHost::PendingFetch::PendingFetch() = default;
+BraveSearchFallbackHost::PendingFetch::PendingFetch(PendingFetch&&) = default;
+BraveSearchFallbackHost::PendingFetch::~PendingFetch() = default;
+
 BraveSearchFallbackHost::BraveSearchFallbackHost(
     scoped_refptr<network::SharedURLLoaderFactory> factory)
-    : shared_url_loader_factory_(std::move(factory)), weak_factory_(this) {}
+    : cached_results_(kCachedResultsSize),
+      shared_url_loader_factory_(std::move(factory)),
+      weak_factory_(this) {}
 
 BraveSearchFallbackHost::~BraveSearchFallbackHost() {}
 
@@ -88,6 +99,24 @@ void BraveSearchFallbackHost::FetchBackupResults(
   }
   request->url = GetBackupResultURL(request->url, query, lang, country, geo,
                                     filter_explicit_results);
+
+  const std::string key = request->url.spec() + "\n" + geo;
+  auto cached = cached_results_.Get(key);
+  if (cached != cached_results_.end()) {
+    if (base::TimeTicks::Now() - cached->second.fetch_time <
+        kCachedResultsLifetime) {
+      std::move(callback).Run(cached->second.response_body);
+      return;
+    }
+    cached_results_.Erase(cached);
+  }
+
+  auto pending = pending_fetches_.find(key);
+  if (pending != pending_fetches_.end()) {
+    pending->second.callbacks.push_back(std::move(callback));
+    return;
+  }
+
   request->load_flags = net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE;
   request->credentials_mode = network::mojom::CredentialsMode::kOmit;
   request->load_flags |= net::LOAD_DO_NOT_SAVE_COOKIES;
@@ -99,23 +128,29 @@ void BraveSearchFallbackHost::FetchBackupResults(
   url_loader->SetRetryOptions(
       kRetriesCountOnNetworkChange,
       network::SimpleURLLoader::RetryMode::RETRY_ON_NETWORK_CHANGE);
-  auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
-  iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+  PendingFetch& fetch = pending_fetches_[key];
+  fetch.url_loader = std::move(url_loader);
+  fetch.callbacks.push_back(std::move(callback));
+  fetch.url_loader->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       shared_url_loader_factory_.get(),
       base::BindOnce(&BraveSearchFallbackHost::OnURLLoaderComplete,
-                     weak_factory_.GetWeakPtr(), iter, std::move(callback)));
+                     weak_factory_.GetWeakPtr(), key));
 }
 
 void BraveSearchFallbackHost::OnURLLoaderComplete(
-    SimpleURLLoaderList::iterator iter,
-    BraveSearchFallbackHost::FetchBackupResultsCallback callback,
+    const std::string& key,
     const std::unique_ptr<std::string> response_body) {
-  url_loaders_.erase(iter);
-  if (response_body) {
-    std::move(callback).Run(*response_body);
-  } else {
-    std::move(callback).Run("");
-  }
+  auto pending = pending_fetches_.find(key);
+  DCHECK(pending != pending_fetches_.end());
+  std::vector<FetchBackupResultsCallback> callbacks =
+      std::move(pending->second.callbacks);
+  pending_fetches_.erase(pending);
+
+  const std::string result = response_body ? *response_body : "";
+  if (!result.empty())
+    cached_results_.Put(key, CachedResults{result, base::TimeTicks::Now()});
+  for (auto& callback : callbacks)
+    std::move(callback).Run(result);
 }
 
 }  // namespace brave_search
@@ -6,12 +6,14 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SEARCH_BROWSER_BRAVE_SEARCH_FALLBACK_HOST_H_
 #define BRAVE_COMPONENTS_BRAVE_SEARCH_BROWSER_BRAVE_SEARCH_FALLBACK_HOST_H_
 
-#include <list>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "brave/components/brave_search/common/brave_search_fallback.mojom.h"
 #include "url/gurl.h"
 
@@ -47,18 +49,34 @@ class BraveSearchFallbackHost final
   static void SetBackupProviderForTest(const GURL&);
 
  private:
-  using SimpleURLLoaderList =
-      std::list<std::unique_ptr<network::SimpleURLLoader>>;
+  // A fetch and everyone waiting for its result. Requests for the same
+  // results while one is in flight, e.g. from retyping, share the fetch.
+  struct PendingFetch {
+    PendingFetch();
+    PendingFetch(PendingFetch&&);
+    ~PendingFetch();
+
+    std::unique_ptr<network::SimpleURLLoader> url_loader;
+    std::vector<FetchBackupResultsCallback> callbacks;
+  };
+
+  struct CachedResults {
+    std::string response_body;
+    base::TimeTicks fetch_time;
+  };
+
   using URLRequestCallback =
       base::OnceCallback<void(const int,
                               const std::string&,
                               const std::map<std::string, std::string>&)>;
 
-  void OnURLLoaderComplete(
-      SimpleURLLoaderList::iterator iter,
-      BraveSearchFallbackHost::FetchBackupResultsCallback callback,
-      const std::unique_ptr<std::string> response_body);
-  SimpleURLLoaderList url_loaders_;
+  void OnURLLoaderComplete(const std::string& key,
+                           const std::unique_ptr<std::string> response_body);
+
+  // Keyed by request URL and geo header. Loaders are cancelled when the
+  // renderer drops its remote and this host goes away.
+  std::map<std::string, PendingFetch> pending_fetches_;
+  base::MRUCache<std::string, CachedResults> cached_results_;
   scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
   base::WeakPtrFactory<BraveSearchFallbackHost> weak_factory_;
 };
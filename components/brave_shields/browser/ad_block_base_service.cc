@@ -6,23 +6,33 @@
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 
 #include <algorithm>
+#include <atomic>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/bind.h"
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/json/json_reader.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/process/process_metrics.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/ad_block_engine_registry.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
+#include "crypto/sha2.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "url/origin.h"
 
@@ -32,6 +42,53 @@ using namespace net::registry_controlled_domains;  // NOLINT
 
 namespace {
 
+std::atomic<uint64_t> g_engine_generation{0};
+
+// Maps the DAT at |dat_file_path| and deserializes it, unless the SHA-256 of
+// its contents is |previous_hash|, in which case the engine already in use is
+// current and the result carries no engine.
+brave_shields::AdBlockBaseService::LoadedDATFile LoadDATFileIfChanged(
+    const base::FilePath& dat_file_path,
+    base::Optional<std::string> previous_hash) {
+  TRACE_EVENT0("brave.shields", "LoadDATFileIfChanged");
+  brave_shields::AdBlockBaseService::LoadedDATFile result;
+  base::MemoryMappedFile mapped_file;
+  if (!brave_component_updater::MapDATFile(dat_file_path, &mapped_file))
+    return result;
+
+  result.hash = crypto::SHA256HashString(
+      base::StringPiece(reinterpret_cast<const char*>(mapped_file.data()),
+                        mapped_file.length()));
+  result.size = mapped_file.length();
+  if (previous_hash && *previous_hash == *result.hash) {
+    result.unchanged = true;
+    return result;
+  }
+
+  // Both engines stay resident until the swap completes, so the growth while
+  // deserializing approximates the extra memory an update costs. Other
+  // threads allocate meanwhile, so this is only an estimate.
+  std::unique_ptr<base::ProcessMetrics> metrics =
+      base::ProcessMetrics::CreateCurrentProcessMetrics();
+  const size_t malloc_usage_before = metrics->GetMallocUsage();
+
+  const base::TimeTicks deserialize_start = base::TimeTicks::Now();
+  auto engine = std::make_unique<adblock::Engine>();
+  if (!engine->deserialize(mapped_file.data(), mapped_file.length()))
+    return result;
+  UMA_HISTOGRAM_TIMES("Brave.Shields.AdBlockEngineDeserializeTime",
+                      base::TimeTicks::Now() - deserialize_start);
+
+  const size_t malloc_usage_after = metrics->GetMallocUsage();
+  if (malloc_usage_after > malloc_usage_before) {
+    UMA_HISTOGRAM_MEMORY_KB(
+        "Brave.Shields.AdBlockEngineSwapMemoryIncrease",
+        (malloc_usage_after - malloc_usage_before) / 1024);
+  }
+  result.engine = std::move(engine);
+  return result;
+}
+
 std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
   std::string filter_option = "";
   switch (resource_type) {
@@ -98,17 +155,43 @@ std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
   return filter_option;
 }
 
+// Determine third-party here so the library doesn't need to figure it out.
+// CreateFromNormalizedTuple is needed because SameDomainOrHost needs
+// a URL or origin and not a string to a host name.
+bool IsThirdPartyRequest(const GURL& url, const std::string& tab_host) {
+  return !SameDomainOrHost(
+      url,
+      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
+      INCLUDE_PRIVATE_REGISTRIES);
+}
+
 }  // namespace
 
 namespace brave_shields {
 
+AdBlockBaseService::LoadedDATFile::LoadedDATFile() = default;
+
+AdBlockBaseService::LoadedDATFile::LoadedDATFile(LoadedDATFile&& other) =
+    default;
+
+AdBlockBaseService::LoadedDATFile&
+AdBlockBaseService::LoadedDATFile::operator=(LoadedDATFile&& other) = default;
+
+AdBlockBaseService::LoadedDATFile::~LoadedDATFile() = default;
+
 AdBlockBaseService::AdBlockBaseService(BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
-      ad_block_client_(new adblock::Engine()),
-      weak_factory_(this) {}
+      ad_block_client_(base::MakeRefCounted<SharedAdBlockEngine>(
+          std::make_unique<adblock::Engine>()))) {}
 
 AdBlockBaseService::~AdBlockBaseService() {
-  GetTaskRunner()->DeleteSoon(FROM_HERE, ad_block_client_.release());
+  GetTaskRunner()->PostTask(
+      FROM_HERE, base::BindOnce(
+                     [](scoped_refptr<SharedAdBlockEngine> ad_block_client) {
+                       ad_block_client.reset();
+                       AdBlockEngineRegistry::GetInstance()->ReleaseUnused();
+                     },
+                     std::move(ad_block_client_)));
 }
 
 void AdBlockBaseService::ShouldStartRequest(
@@ -121,15 +204,8 @@ void AdBlockBaseService::ShouldStartRequest(
     std::string* mock_data_url) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
 
-  // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  bool is_third_party = !SameDomainOrHost(
-      url,
-      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
-      INCLUDE_PRIVATE_REGISTRIES);
-  ad_block_client_->matches(
-      url.spec(), url.host(), tab_host, is_third_party,
+  ad_block_client_->engine()->matches(
+      url.spec(), url.host(), tab_host, IsThirdPartyRequest(url, tab_host),
       ResourceTypeToString(resource_type), did_match_rule,
       did_match_exception, did_match_important, mock_data_url);
 
@@ -139,21 +215,61 @@ void AdBlockBaseService::ShouldStartRequest(
   //  << ", url.spec(): " << url.spec();
 }
 
+void AdBlockBaseService::ShouldStartRequests(
+    const std::vector<adblock::BatchRequest>& requests,
+    std::vector<adblock::BatchResult>* results) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  DCHECK_EQ(requests.size(), results->size());
+  if (requests.empty())
+    return;
+  ad_block_client_->engine()->matchesBatch(requests.data(), requests.size(),
+                                           results->data());
+}
+
+// static
+adblock::BatchRequest AdBlockBaseService::MakeBatchRequest(
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host) {
+  adblock::BatchRequest request;
+  request.url = url.spec();
+  request.host = url.host();
+  request.tab_host = tab_host;
+  request.is_third_party = IsThirdPartyRequest(url, tab_host);
+  request.resource_type = ResourceTypeToString(resource_type);
+  return request;
+}
+
+// static
+void AdBlockBaseService::MatchEngines(
+    const std::vector<adblock::Engine*>& engines,
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool* did_match_rule,
+    bool* did_match_exception,
+    bool* did_match_important,
+    std::string* mock_data_url) {
+  adblock::Engine::matchesUnion(
+      engines, url.spec(), url.host(), tab_host,
+      IsThirdPartyRequest(url, tab_host), ResourceTypeToString(resource_type),
+      did_match_rule, did_match_exception, did_match_important, mock_data_url);
+}
+
+void AdBlockBaseService::CollectEngines(
+    std::vector<adblock::Engine*>* engines) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  engines->push_back(ad_block_client_->engine());
+}
+
 base::Optional<std::string> AdBlockBaseService::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
     const std::string& tab_host) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
 
-  // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  bool is_third_party = !SameDomainOrHost(
-      url,
-      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
-      INCLUDE_PRIVATE_REGISTRIES);
-  const std::string result = ad_block_client_->getCspDirectives(
-      url.spec(), url.host(), tab_host, is_third_party,
+  const std::string result = ad_block_client_->engine()->getCspDirectives(
+      url.spec(), url.host(), tab_host, IsThirdPartyRequest(url, tab_host),
       ResourceTypeToString(resource_type));
 
   if (result.empty()) {
@@ -163,6 +279,16 @@ base::Optional<std::string> AdBlockBaseService::GetCspDirectives(
   }
 }
 
+// static
+uint64_t AdBlockBaseService::GetEngineGeneration() {
+  return g_engine_generation.load(std::memory_order_acquire);
+}
+
+// static
+void AdBlockBaseService::OnEnginesChanged() {
+  g_engine_generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
 void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
   if (BrowserThread::CurrentlyOn(BrowserThread::UI)) {
     GetTaskRunner()->PostTask(
@@ -172,16 +298,27 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
   }
 
   if (enabled) {
-    ad_block_client_->addTag(tag);
     tags_.push_back(tag);
   } else {
-    ad_block_client_->removeTag(tag);
     std::vector<std::string>::iterator it =
         std::find(tags_.begin(), tags_.end(), tag);
     if (it != tags_.end()) {
       tags_.erase(it);
     }
   }
+
+  // A registered engine may be shared with other services, so it is replaced
+  // by one for the new configuration rather than modified.
+  if (!component_id_.empty()) {
+    LoadEngine(component_id_, dat_file_path_, /* force_reload */ true);
+    return;
+  }
+
+  if (enabled)
+    ad_block_client_->engine()->addTag(tag);
+  else
+    ad_block_client_->engine()->removeTag(tag);
+  OnEnginesChanged();
 }
 
 void AdBlockBaseService::AddResources(const std::string& resources) {
@@ -192,8 +329,29 @@ void AdBlockBaseService::AddResources(const std::string& resources) {
     return;
   }
 
-  ad_block_client_->addResources(resources);
+  // Every component ships the same resources file and each regional list's
+  // copy is handed to all regional engines, so on startup most calls repeat
+  // resources the engine already has. New engines get |resources_| added in
+  // UpdateAdBlockClient, so there is nothing to redo here.
+  if (resources == resources_)
+    return;
+
   resources_ = resources;
+  if (!component_id_.empty()) {
+    LoadEngine(component_id_, dat_file_path_, /* force_reload */ true);
+    return;
+  }
+
+  ad_block_client_->engine()->addResources(resources);
+  // Scriptlets injected by cosmetic filtering come from the resources.
+  OnEnginesChanged();
+}
+
+std::string AdBlockBaseService::GetEngineConfig() const {
+  std::vector<std::string> tags = tags_;
+  std::sort(tags.begin(), tags.end());
+  return base::JoinString(tags, ",") + "|" +
+         crypto::SHA256HashString(resources_);
 }
 
 bool AdBlockBaseService::TagExists(const std::string& tag) {
@@ -203,7 +361,8 @@ bool AdBlockBaseService::TagExists(const std::string& tag) {
 base::Optional<base::Value> AdBlockBaseService::UrlCosmeticResources(
         const std::string& url) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  return base::JSONReader::Read(ad_block_client_->urlCosmeticResources(url));
+  return base::JSONReader::Read(
+      ad_block_client_->engine()->urlCosmeticResources(url));
 }
 
 base::Optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
@@ -212,51 +371,116 @@ base::Optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
         const std::vector<std::string>& exceptions) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
   return base::JSONReader::Read(
-      ad_block_client_->hiddenClassIdSelectors(classes, ids, exceptions));
+      ad_block_client_->engine()->hiddenClassIdSelectors(classes, ids,
+                                                         exceptions));
 }
 
-void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
+void AdBlockBaseService::GetDATFileData(const std::string& component_id,
+                                        const base::FilePath& dat_file_path) {
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&AdBlockBaseService::LoadEngine, base::Unretained(this),
+                     component_id, dat_file_path, /* force_reload */ false));
+}
+
+void AdBlockBaseService::LoadEngine(const std::string& component_id,
+                                    const base::FilePath& dat_file_path,
+                                    bool force_reload) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  component_id_ = component_id;
+  dat_file_path_ = dat_file_path;
+
+  scoped_refptr<SharedAdBlockEngine> shared_engine =
+      AdBlockEngineRegistry::GetInstance()->Get(component_id, dat_file_path,
+                                                GetEngineConfig());
+  if (shared_engine) {
+    // The registry doesn't know what the engine was built from.
+    loaded_dat_hash_.reset();
+    SetSharedAdBlockClient(std::move(shared_engine));
+    return;
+  }
+
+  // The current engine only matches the DAT when it was loaded with the
+  // same configuration.
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&brave_component_updater::LoadDATFileData<adblock::Engine>,
-                     dat_file_path),
+      base::BindOnce(&LoadDATFileIfChanged, dat_file_path,
+                     force_reload ? base::nullopt : loaded_dat_hash_),
       base::BindOnce(&AdBlockBaseService::OnGetDATFileData,
-                     weak_factory_.GetWeakPtr()));
+                     base::Unretained(this), component_id, dat_file_path));
 }
 
-void AdBlockBaseService::OnGetDATFileData(GetDATFileDataResult result) {
-  if (result.second.empty()) {
-    LOG(ERROR) << "Could not obtain ad block data";
+void AdBlockBaseService::OnGetDATFileData(
+    const std::string& component_id,
+    const base::FilePath& dat_file_path,
+    LoadedDATFile loaded) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  // A newer DAT started loading in the meantime.
+  if (component_id != component_id_ || dat_file_path != dat_file_path_)
+    return;
+  if (loaded.unchanged) {
+    // Same rules in a new component version; keep the current engine rather
+    // than holding two copies of it for the swap.
     return;
   }
-  if (!result.first.get()) {
-    LOG(ERROR) << "Failed to deserialize ad block data";
+  std::unique_ptr<adblock::Engine> ad_block_client = std::move(loaded.engine);
+  if (!ad_block_client) {
+    LOG(ERROR) << "Could not obtain or deserialize ad block data";
     return;
   }
-  GetTaskRunner()->PostTask(
-      FROM_HERE, base::BindOnce(&AdBlockBaseService::UpdateAdBlockClient,
-                                base::Unretained(this),
-                                std::move(result.first)));
+  loaded_dat_hash_ = loaded.hash;
+
+  // Nobody else can see the engine yet, so it is configured before it is
+  // registered. Tags or resources that changed while it was loading are
+  // already included.
+  for (const std::string& tag : tags_)
+    ad_block_client->addTag(tag);
+  ad_block_client->addResources(resources_);
+  SetSharedAdBlockClient(AdBlockEngineRegistry::GetInstance()->Add(
+      component_id, dat_file_path, GetEngineConfig(),
+      std::move(ad_block_client), loaded.size));
+}
+
+void AdBlockBaseService::SetSharedAdBlockClient(
+    scoped_refptr<SharedAdBlockEngine> ad_block_client) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  TRACE_EVENT0("brave.shields", "AdBlockBaseService::SetSharedAdBlockClient");
+  ad_block_client_ = std::move(ad_block_client);
+  OnEnginesChanged();
+  // The engine we were using before may have been the last user of an older
+  // DAT version or configuration.
+  AdBlockEngineRegistry::GetInstance()->ReleaseUnused();
 }
 
 void AdBlockBaseService::UpdateAdBlockClient(
-    std::unique_ptr<adblock::Engine> ad_block_client) {
+    scoped_refptr<SharedAdBlockEngine> ad_block_client) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  TRACE_EVENT0("brave.shields", "AdBlockBaseService::UpdateAdBlockClient");
+  // Engines which aren't registered are private to this service and are
+  // configured in place.
+  component_id_.clear();
+  dat_file_path_.clear();
+  loaded_dat_hash_.reset();
   ad_block_client_ = std::move(ad_block_client);
   AddKnownTagsToAdBlockInstance();
   AddKnownResourcesToAdBlockInstance();
+  OnEnginesChanged();
+  AdBlockEngineRegistry::GetInstance()->ReleaseUnused();
 }
 
 void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
   std::for_each(tags_.begin(), tags_.end(),
-                [&](const std::string tag) { ad_block_client_->addTag(tag); });
+                [&](const std::string tag) {
+                  ad_block_client_->engine()->addTag(tag);
+                });
 }
 
 void AdBlockBaseService::AddKnownResourcesToAdBlockInstance() {
-  ad_block_client_->addResources(resources_);
+  ad_block_client_->engine()->addResources(resources_);
 }
 
 bool AdBlockBaseService::Init() {
+  TRACE_EVENT0("brave.shields", "AdBlockBaseService::Init");
   return true;
 }
 
@@ -265,12 +489,16 @@ void AdBlockBaseService::ResetForTest(const std::string& rules,
   // This is temporary until adblock-rust supports incrementally adding
   // filter rules to an existing instance. At which point the hack below
   // will dissapear.
-  ad_block_client_.reset(new adblock::Engine(rules));
+  component_id_.clear();
+  dat_file_path_.clear();
+  ad_block_client_ = base::MakeRefCounted<SharedAdBlockEngine>(
+      std::make_unique<adblock::Engine>(rules));
   AddKnownTagsToAdBlockInstance();
   if (!resources.empty()) {
     resources_ = resources;
   }
   AddKnownResourcesToAdBlockInstance();
+  OnEnginesChanged();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -14,7 +14,8 @@
 #include <vector>
 
 #include "base/files/file_path.h"
-#include "base/memory/weak_ptr.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/optional.h"
 #include "base/sequence_checker.h"
 #include "base/values.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
@@ -27,16 +28,33 @@ class BraveAdBlockTPNetworkDelegateHelperTest;
 using brave_component_updater::BraveComponent;
 namespace adblock {
 class Engine;
+struct BatchRequest;
+struct BatchResult;
 }
 
 namespace brave_shields {
 
+class SharedAdBlockEngine;
+
 // The base class of the brave shields service in charge of ad-block
 // checking and init.
 class AdBlockBaseService : public BaseBraveShieldsService {
  public:
-  using GetDATFileDataResult =
-      brave_component_updater::LoadDATFileDataResult<adblock::Engine>;
+  // Result of loading a DAT file off the main thread.
+  struct LoadedDATFile {
+    LoadedDATFile();
+    LoadedDATFile(LoadedDATFile&& other);
+    LoadedDATFile& operator=(LoadedDATFile&& other);
+    ~LoadedDATFile();
+
+    std::unique_ptr<adblock::Engine> engine;
+    // SHA-256 of the DAT contents, if the file could be read.
+    base::Optional<std::string> hash;
+    // Size of the DAT contents the engine was deserialized from.
+    size_t size = 0;
+    // The contents match the DAT the current engine was built from.
+    bool unchanged = false;
+  };
 
   explicit AdBlockBaseService(BraveComponent::Delegate* delegate);
   ~AdBlockBaseService() override;
@@ -48,14 +66,27 @@ class AdBlockBaseService : public BaseBraveShieldsService {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* mock_data_url) override;
+  // Checks a batch of requests with a single library call per engine.
+  // |results| holds one entry per request and accumulates like the
+  // out-parameters of ShouldStartRequest.
+  virtual void ShouldStartRequests(
+      const std::vector<adblock::BatchRequest>& requests,
+      std::vector<adblock::BatchResult>* results);
   base::Optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
       const std::string& tab_host);
   void AddResources(const std::string& resources);
+  // Appends the engine backing this service, for use with MatchEngines().
+  void CollectEngines(std::vector<adblock::Engine*>* engines);
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
 
+  // Changes whenever the rules or tags of any ad-block engine change, so that
+  // cached match results can be told apart from current ones.
+  static uint64_t GetEngineGeneration();
+  static void OnEnginesChanged();
+
   virtual base::Optional<base::Value> UrlCosmeticResources(
       const std::string& url);
   virtual base::Optional<base::Value> HiddenClassIdSelectors(
@@ -69,22 +100,61 @@ class AdBlockBaseService : public BaseBraveShieldsService {
 
   bool Init() override;
 
-  void GetDATFileData(const base::FilePath& dat_file_path);
+  static adblock::BatchRequest MakeBatchRequest(
+      const GURL& url,
+      blink::mojom::ResourceType resource_type,
+      const std::string& tab_host);
+
+  // Checks |url| against all of |engines| in a single library call, with the
+  // same result semantics as calling ShouldStartRequest on each in turn.
+  static void MatchEngines(const std::vector<adblock::Engine*>& engines,
+                           const GURL& url,
+                           blink::mojom::ResourceType resource_type,
+                           const std::string& tab_host,
+                           bool* did_match_rule,
+                           bool* did_match_exception,
+                           bool* did_match_important,
+                           std::string* mock_data_url);
+
+  // Loads the engine for |dat_file_path|, reusing the one from
+  // AdBlockEngineRegistry if another service already loaded the same DAT
+  // with the same tags and resources.
+  void GetDATFileData(const std::string& component_id,
+                      const base::FilePath& dat_file_path);
   void AddKnownTagsToAdBlockInstance();
   void AddKnownResourcesToAdBlockInstance();
   void ResetForTest(const std::string& rules, const std::string& resources);
 
-  std::unique_ptr<adblock::Engine> ad_block_client_;
+  // Switches to an engine which is private to this service, such as the
+  // custom filters engine, and applies the known tags and resources to it.
+  void UpdateAdBlockClient(scoped_refptr<SharedAdBlockEngine> ad_block_client);
+
+  scoped_refptr<SharedAdBlockEngine> ad_block_client_;
 
  private:
-  void UpdateAdBlockClient(
-      std::unique_ptr<adblock::Engine> ad_block_client);
-  void OnGetDATFileData(GetDATFileDataResult result);
+  void LoadEngine(const std::string& component_id,
+                  const base::FilePath& dat_file_path,
+                  bool force_reload);
+  void OnGetDATFileData(const std::string& component_id,
+                        const base::FilePath& dat_file_path,
+                        LoadedDATFile loaded);
+  // Switches to a registered engine, which already has the tags and
+  // resources of GetEngineConfig() applied.
+  void SetSharedAdBlockClient(
+      scoped_refptr<SharedAdBlockEngine> ad_block_client);
+  // Identifies the tags and resources applied to registered engines.
+  std::string GetEngineConfig() const;
   void OnPreferenceChanges(const std::string& pref_name);
 
   std::vector<std::string> tags_;
   std::string resources_;
-  base::WeakPtrFactory<AdBlockBaseService> weak_factory_;
+  // The DAT |ad_block_client_| was loaded from, if it is a registered
+  // engine. Only used on the task runner, like |tags_| and |resources_|.
+  std::string component_id_;
+  base::FilePath dat_file_path_;
+  // SHA-256 of the DAT |ad_block_client_| was deserialized from, used to
+  // skip component updates that don't change the rules.
+  base::Optional<std::string> loaded_dat_hash_;
   DISALLOW_COPY_AND_ASSIGN(AdBlockBaseService);
 };
 
@@ -5,8 +5,16 @@
 
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 
+#include <utility>
+
+#include "base/bind.h"
 #include "base/logging.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/task/thread_pool.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "brave/components/brave_shields/browser/ad_block_engine_registry.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/common/pref_names.h"
 #include "components/prefs/pref_service.h"
@@ -16,9 +24,32 @@ using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
+namespace {
+
+// Returns the lines of |custom_filters| which can affect the engine, so that
+// saving with only comment or whitespace changes doesn't rebuild it.
+// Preprocessor directives ("!#...") are kept.
+std::string GetEffectiveRules(const std::string& custom_filters) {
+  std::string rules;
+  for (base::StringPiece line :
+       base::SplitStringPiece(custom_filters, "\r\n", base::TRIM_WHITESPACE,
+                              base::SPLIT_WANT_NONEMPTY)) {
+    if (base::StartsWith(line, "!") && !base::StartsWith(line, "!#"))
+      continue;
+    rules.append(line.data(), line.size());
+    rules.push_back('\n');
+  }
+  return rules;
+}
+
+}  // namespace
+
 AdBlockCustomFiltersService::AdBlockCustomFiltersService(
     BraveComponent::Delegate* delegate)
-    : AdBlockBaseService(delegate) {}
+    : AdBlockBaseService(delegate),
+      engine_build_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {}
 
 AdBlockCustomFiltersService::~AdBlockCustomFiltersService() {}
 
@@ -42,11 +73,11 @@ bool AdBlockCustomFiltersService::UpdateCustomFilters(
     return false;
   local_state->SetString(prefs::kAdBlockCustomFilters, custom_filters);
 
-  GetTaskRunner()->PostTask(
+  engine_build_task_runner_->PostTask(
       FROM_HERE,
-      base::BindOnce(
-          &AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner,
-          base::Unretained(this), custom_filters));
+      base::BindOnce(&AdBlockCustomFiltersService::BuildCustomFiltersEngine,
+                     base::Unretained(this), custom_filters,
+                     ++latest_generation_));
 
   return true;
 }
@@ -81,10 +112,29 @@ bool AdBlockCustomFiltersService::MigrateLegacyCosmeticFilters(
   return UpdateCustomFilters(filters_update);
 }
 
-void AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner(
-    const std::string& custom_filters) {
-  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  ad_block_client_.reset(new adblock::Engine(custom_filters.c_str()));
+void AdBlockCustomFiltersService::BuildCustomFiltersEngine(
+    const std::string& custom_filters,
+    uint64_t generation) {
+  DCHECK(engine_build_task_runner_->RunsTasksInCurrentSequence());
+  if (generation != latest_generation_)
+    return;
+
+  std::string rules = GetEffectiveRules(custom_filters);
+  if (engine_built_ && rules == built_rules_)
+    return;
+  built_rules_ = std::move(rules);
+  engine_built_ = true;
+
+  // Custom filters are specific to this service, so the engine is an overlay
+  // on top of the shared list engines rather than a registry entry.
+  auto ad_block_client = base::MakeRefCounted<SharedAdBlockEngine>(
+      std::make_unique<adblock::Engine>(custom_filters.c_str()),
+      custom_filters.size());
+  AdBlockEngineRegistry::GetInstance()->AddPrivate(ad_block_client);
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&AdBlockCustomFiltersService::UpdateAdBlockClient,
+                     base::Unretained(this), std::move(ad_block_client)));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -6,11 +6,14 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_CUSTOM_FILTERS_SERVICE_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_CUSTOM_FILTERS_SERVICE_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "base/memory/scoped_refptr.h"
+#include "base/sequenced_task_runner.h"
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 
 class AdBlockServiceTest;
@@ -31,12 +34,31 @@ class AdBlockCustomFiltersService : public AdBlockBaseService {
   bool MigrateLegacyCosmeticFilters(
       const std::map<std::string, std::vector<std::string>> legacyFilters);
 
+  scoped_refptr<base::SequencedTaskRunner> GetEngineBuildTaskRunnerForTest() {
+    return engine_build_task_runner_;
+  }
+
  protected:
   bool Init() override;
 
  private:
   friend class ::AdBlockServiceTest;
-  void UpdateCustomFiltersOnFileTaskRunner(const std::string& custom_filters);
+  void BuildCustomFiltersEngine(const std::string& custom_filters,
+                                uint64_t generation);
+
+  // Custom filters are parsed into a new engine on this sequence rather than
+  // the shields task runner, so lookups only ever wait for the swap. Being a
+  // sequence also keeps swaps in the order the filters were updated.
+  scoped_refptr<base::SequencedTaskRunner> engine_build_task_runner_;
+
+  // Bumped for every update, so a build overtaken by a newer update is
+  // skipped rather than swapped in only to be replaced.
+  std::atomic<uint64_t> latest_generation_{0};
+
+  // The rules the current engine was built from, without blank lines and
+  // comments. Only used on |engine_build_task_runner_|.
+  std::string built_rules_;
+  bool engine_built_ = false;
 
   DISALLOW_COPY_AND_ASSIGN(AdBlockCustomFiltersService);
 };
@@ -0,0 +1,127 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_engine_registry.h"
+
+#include <inttypes.h>
+
+#include <utility>
+
+#include "base/stl_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
+
+namespace brave_shields {
+
+SharedAdBlockEngine::SharedAdBlockEngine(
+    std::unique_ptr<adblock::Engine> engine,
+    size_t dat_size)
+    : engine_(std::move(engine)), dat_size_(dat_size) {
+  DCHECK(engine_);
+}
+
+SharedAdBlockEngine::~SharedAdBlockEngine() = default;
+
+// static
+AdBlockEngineRegistry* AdBlockEngineRegistry::GetInstance() {
+  static base::NoDestructor<AdBlockEngineRegistry> instance;
+  return instance.get();
+}
+
+AdBlockEngineRegistry::AdBlockEngineRegistry() {
+  // The registry is never destroyed, so it never has to unregister. Dumps may
+  // run on any thread, which |lock_| makes safe.
+  base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+      this, "BraveAdBlockEngines", nullptr);
+}
+
+AdBlockEngineRegistry::~AdBlockEngineRegistry() = default;
+
+scoped_refptr<SharedAdBlockEngine> AdBlockEngineRegistry::Get(
+    const std::string& component_id,
+    const base::FilePath& dat_file_path,
+    const std::string& config) {
+  base::AutoLock lock(lock_);
+  auto it = engines_.find(Key(component_id, dat_file_path, config));
+  if (it == engines_.end())
+    return nullptr;
+  return it->second;
+}
+
+scoped_refptr<SharedAdBlockEngine> AdBlockEngineRegistry::Add(
+    const std::string& component_id,
+    const base::FilePath& dat_file_path,
+    const std::string& config,
+    std::unique_ptr<adblock::Engine> engine,
+    size_t dat_size) {
+  base::AutoLock lock(lock_);
+  auto& shared_engine = engines_[Key(component_id, dat_file_path, config)];
+  if (!shared_engine)
+    shared_engine =
+        base::MakeRefCounted<SharedAdBlockEngine>(std::move(engine), dat_size);
+  return shared_engine;
+}
+
+void AdBlockEngineRegistry::AddPrivate(
+    scoped_refptr<SharedAdBlockEngine> engine) {
+  DCHECK(engine);
+  base::AutoLock lock(lock_);
+  private_engines_.push_back(std::move(engine));
+}
+
+void AdBlockEngineRegistry::ReleaseUnused() {
+  // Holding the lock guarantees nobody can take a new reference through Get()
+  // or Add(), so an entry we hold the only reference to is safe to drop.
+  base::AutoLock lock(lock_);
+  for (auto it = engines_.begin(); it != engines_.end();) {
+    if (it->second->HasOneRef())
+      it = engines_.erase(it);
+    else
+      ++it;
+  }
+  base::EraseIf(private_engines_,
+                [](const scoped_refptr<SharedAdBlockEngine>& engine) {
+                  return engine->HasOneRef();
+                });
+}
+
+bool AdBlockEngineRegistry::OnMemoryDump(
+    const base::trace_event::MemoryDumpArgs& args,
+    base::trace_event::ProcessMemoryDump* pmd) {
+  base::AutoLock lock(lock_);
+  size_t total_dat_size = 0;
+  // Several versions of a list can be loaded while services swap engines,
+  // so the engine address keeps the dump names unique.
+  auto dump_engine = [&](const std::string& name,
+                         const SharedAdBlockEngine* shared_engine) {
+    total_dat_size += shared_engine->dat_size();
+    base::trace_event::MemoryAllocatorDump* dump = pmd->CreateAllocatorDump(
+        base::StringPrintf("brave/adblock/engines/%s/0x%" PRIXPTR,
+                           name.c_str(),
+                           reinterpret_cast<uintptr_t>(shared_engine)));
+    dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                    base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                    shared_engine->dat_size());
+  };
+  for (const auto& entry : engines_)
+    dump_engine(std::get<0>(entry.first), entry.second.get());
+  for (const auto& engine : private_engines_)
+    dump_engine("private", engine.get());
+
+  base::trace_event::MemoryAllocatorDump* dump =
+      pmd->CreateAllocatorDump("brave/adblock/engines");
+  dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                  base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                  total_dat_size);
+  dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameObjectCount,
+                  base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                  engines_.size() + private_engines_.size());
+  return true;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,121 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_REGISTRY_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_REGISTRY_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/trace_event/memory_dump_provider.h"
+
+namespace adblock {
+class Engine;
+}
+
+namespace brave_shields {
+
+// A deserialized adblock engine which may be referenced by several ad block
+// services at once. The engine itself is only used on the shields task runner:
+// every adblock FFI entry point, matching included, takes the engine mutably,
+// and tag and resource updates modify it in place, so it must not be queried
+// from several threads. Services instead swap in whole new engines, which are
+// built off that sequence.
+class SharedAdBlockEngine
+    : public base::RefCountedThreadSafe<SharedAdBlockEngine> {
+ public:
+  // |dat_size| is the size of the serialized DAT or the rules the engine was
+  // built from, if any.
+  explicit SharedAdBlockEngine(std::unique_ptr<adblock::Engine> engine,
+                               size_t dat_size = 0);
+
+  adblock::Engine* engine() const { return engine_.get(); }
+  size_t dat_size() const { return dat_size_; }
+
+ private:
+  friend class base::RefCountedThreadSafe<SharedAdBlockEngine>;
+  ~SharedAdBlockEngine();
+
+  std::unique_ptr<adblock::Engine> engine_;
+  const size_t dat_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedAdBlockEngine);
+};
+
+// Process-wide registry of engines deserialized from component DAT files.
+// Engines are keyed by component id, DAT file path and the configuration
+// (enabled tags and resources) applied to them; component install directories
+// are versioned, so the path also identifies the DAT version. A service
+// loading a list that is already loaded with the same configuration reuses
+// the existing engine instead of deserializing another copy.
+//
+// Registered engines are never modified, as that would change the rules of
+// every service sharing them. A service whose configuration changes loads an
+// engine for the new configuration instead.
+//
+// The registry also reports the loaded engines to memory-infra, including the
+// private engines services build from their own rules, such as the custom
+// filters engine that is matched together with the lists. The engines live in
+// Rust and can't be measured directly, so each is reported with the size of
+// the DAT or rules it was built from, which the engine is roughly proportional
+// to.
+class AdBlockEngineRegistry : public base::trace_event::MemoryDumpProvider {
+ public:
+  static AdBlockEngineRegistry* GetInstance();
+
+  // Returns the engine already loaded for |component_id| and |dat_file_path|
+  // with |config| applied, or nullptr.
+  scoped_refptr<SharedAdBlockEngine> Get(const std::string& component_id,
+                                         const base::FilePath& dat_file_path,
+                                         const std::string& config);
+
+  // Registers |engine|, which must already have |config| applied, and returns
+  // the shared instance. If another service registered the same DAT and
+  // configuration in the meantime, that engine is returned instead and
+  // |engine| is dropped.
+  scoped_refptr<SharedAdBlockEngine> Add(
+      const std::string& component_id,
+      const base::FilePath& dat_file_path,
+      const std::string& config,
+      std::unique_ptr<adblock::Engine> engine,
+      size_t dat_size);
+
+  // Tracks |engine|, which is private to one service and never returned by
+  // Get(), so that it is reported to memory-infra while it is in use.
+  void AddPrivate(scoped_refptr<SharedAdBlockEngine> engine);
+
+  // Drops engines that are no longer referenced by any service, e.g. the
+  // previous version of a list after a component update.
+  void ReleaseUnused();
+
+  // base::trace_event::MemoryDumpProvider:
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
+
+ private:
+  friend class base::NoDestructor<AdBlockEngineRegistry>;
+  using Key = std::tuple<std::string, base::FilePath, std::string>;
+
+  AdBlockEngineRegistry();
+  ~AdBlockEngineRegistry() override;
+
+  base::Lock lock_;
+  std::map<Key, scoped_refptr<SharedAdBlockEngine>> engines_;
+  std::vector<scoped_refptr<SharedAdBlockEngine>> private_engines_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockEngineRegistry);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_REGISTRY_H_
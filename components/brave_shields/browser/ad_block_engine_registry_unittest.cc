@@ -0,0 +1,131 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_engine_registry.h"
+
+#include <memory>
+
+#include "base/files/file_path.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/process_memory_dump.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+namespace {
+
+const char kComponentId[] = "registry-test-component";
+const char kConfig[] = "";
+
+}  // namespace
+
+TEST(AdBlockEngineRegistryTest, ReusesEngineForSameDAT) {
+  auto* registry = AdBlockEngineRegistry::GetInstance();
+  const base::FilePath path(FILE_PATH_LITERAL("1.0.1/rs-test.dat"));
+
+  EXPECT_FALSE(registry->Get(kComponentId, path, kConfig));
+
+  auto first = registry->Add(kComponentId, path, kConfig,
+                             std::make_unique<adblock::Engine>(), 0);
+  auto second = registry->Add(kComponentId, path, kConfig,
+                              std::make_unique<adblock::Engine>(), 0);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(first, registry->Get(kComponentId, path, kConfig));
+
+  first.reset();
+  second.reset();
+  registry->ReleaseUnused();
+  EXPECT_FALSE(registry->Get(kComponentId, path, kConfig));
+}
+
+TEST(AdBlockEngineRegistryTest, DifferentVersionsAreSeparateEngines) {
+  auto* registry = AdBlockEngineRegistry::GetInstance();
+  const base::FilePath old_path(FILE_PATH_LITERAL("1.0.1/rs-test.dat"));
+  const base::FilePath new_path(FILE_PATH_LITERAL("1.0.2/rs-test.dat"));
+
+  auto old_engine = registry->Add(kComponentId, old_path, kConfig,
+                                  std::make_unique<adblock::Engine>(), 0);
+  auto new_engine = registry->Add(kComponentId, new_path, kConfig,
+                                  std::make_unique<adblock::Engine>(), 0);
+  EXPECT_NE(old_engine, new_engine);
+
+  // Dropping the last user of the old version releases only that engine.
+  old_engine.reset();
+  registry->ReleaseUnused();
+  EXPECT_FALSE(registry->Get(kComponentId, old_path, kConfig));
+  EXPECT_EQ(new_engine, registry->Get(kComponentId, new_path, kConfig));
+
+  new_engine.reset();
+  registry->ReleaseUnused();
+}
+
+TEST(AdBlockEngineRegistryTest, DifferentConfigsAreSeparateEngines) {
+  auto* registry = AdBlockEngineRegistry::GetInstance();
+  const base::FilePath path(FILE_PATH_LITERAL("1.0.1/rs-test.dat"));
+
+  auto engine = registry->Add(kComponentId, path, kConfig,
+                              std::make_unique<adblock::Engine>(), 0);
+  auto tagged_engine = registry->Add(kComponentId, path, "fb-embeds",
+                                     std::make_unique<adblock::Engine>(), 0);
+  EXPECT_NE(engine, tagged_engine);
+  EXPECT_EQ(engine, registry->Get(kComponentId, path, kConfig));
+  EXPECT_EQ(tagged_engine, registry->Get(kComponentId, path, "fb-embeds"));
+
+  engine.reset();
+  tagged_engine.reset();
+  registry->ReleaseUnused();
+}
+
+TEST(AdBlockEngineRegistryTest, DumpsDATSizeOfLoadedEngines) {
+  auto* registry = AdBlockEngineRegistry::GetInstance();
+  const base::FilePath path(FILE_PATH_LITERAL("1.0.1/rs-test.dat"));
+  auto engine = registry->Add(kComponentId, path, kConfig,
+                              std::make_unique<adblock::Engine>(), 1024);
+
+  base::trace_event::MemoryDumpArgs args = {
+      base::trace_event::MemoryDumpLevelOfDetail::DETAILED};
+  base::trace_event::ProcessMemoryDump pmd(args);
+  ASSERT_TRUE(registry->OnMemoryDump(args, &pmd));
+
+  base::trace_event::MemoryAllocatorDump* dump =
+      pmd.GetAllocatorDump("brave/adblock/engines");
+  ASSERT_TRUE(dump);
+  EXPECT_EQ(1024u, dump->GetSizeInternal());
+
+  engine.reset();
+  registry->ReleaseUnused();
+}
+
+TEST(AdBlockEngineRegistryTest, DumpsPrivateEnginesWhileInUse) {
+  auto* registry = AdBlockEngineRegistry::GetInstance();
+  auto engine = base::MakeRefCounted<SharedAdBlockEngine>(
+      std::make_unique<adblock::Engine>(), 256);
+  registry->AddPrivate(engine);
+
+  base::trace_event::MemoryDumpArgs args = {
+      base::trace_event::MemoryDumpLevelOfDetail::DETAILED};
+  {
+    base::trace_event::ProcessMemoryDump pmd(args);
+    ASSERT_TRUE(registry->OnMemoryDump(args, &pmd));
+    base::trace_event::MemoryAllocatorDump* dump =
+        pmd.GetAllocatorDump("brave/adblock/engines");
+    ASSERT_TRUE(dump);
+    EXPECT_EQ(256u, dump->GetSizeInternal());
+  }
+
+  engine.reset();
+  registry->ReleaseUnused();
+  {
+    base::trace_event::ProcessMemoryDump pmd(args);
+    ASSERT_TRUE(registry->OnMemoryDump(args, &pmd));
+    base::trace_event::MemoryAllocatorDump* dump =
+        pmd.GetAllocatorDump("brave/adblock/engines");
+    ASSERT_TRUE(dump);
+    EXPECT_EQ(0u, dump->GetSizeInternal());
+  }
+}
+
+}  // namespace brave_shields
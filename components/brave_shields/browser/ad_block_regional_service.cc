@@ -72,7 +72,7 @@ void AdBlockRegionalService::OnComponentReady(const std::string& component_id,
   base::FilePath dat_file_path =
       install_dir.AppendASCII(std::string("rs-") + uuid_)
           .AddExtension(FILE_PATH_LITERAL(".dat"));
-  GetDATFileData(dat_file_path);
+  GetDATFileData(component_id, dat_file_path);
   base::FilePath resources_file_path =
       install_dir.AppendASCII(kAdBlockResourcesFilename);
 
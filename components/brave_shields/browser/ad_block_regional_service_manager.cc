@@ -135,6 +135,23 @@ void AdBlockRegionalServiceManager::ShouldStartRequest(
   }
 }
 
+void AdBlockRegionalServiceManager::ShouldStartRequests(
+    const std::vector<adblock::BatchRequest>& requests,
+    std::vector<adblock::BatchResult>* results) {
+  base::AutoLock lock(regional_services_lock_);
+  for (const auto& regional_service : regional_services_) {
+    regional_service.second->ShouldStartRequests(requests, results);
+  }
+}
+
+void AdBlockRegionalServiceManager::CollectEngines(
+    std::vector<adblock::Engine*>* engines) {
+  base::AutoLock lock(regional_services_lock_);
+  for (const auto& regional_service : regional_services_) {
+    regional_service.second->CollectEngines(engines);
+  }
+}
+
 base::Optional<std::string> AdBlockRegionalServiceManager::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
@@ -190,6 +207,7 @@ void AdBlockRegionalServiceManager::EnableFilterList(
       DCHECK(it != regional_services_.end());
       it->second->Unregister();
       regional_services_.erase(it);
+      AdBlockBaseService::OnEnginesChanged();
     }
   }
 
@@ -58,6 +58,9 @@ class AdBlockRegionalServiceManager {
       const GURL& url,
       blink::mojom::ResourceType resource_type,
       const std::string& tab_host);
+  void ShouldStartRequests(const std::vector<adblock::BatchRequest>& requests,
+                           std::vector<adblock::BatchResult>* results);
+  void CollectEngines(std::vector<adblock::Engine*>* engines);
   void EnableTag(const std::string& tag, bool enabled);
   void AddResources(const std::string& resources);
   void EnableFilterList(const std::string& uuid, bool enabled);
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "base/base_paths.h"
 #include "base/bind.h"
@@ -15,9 +16,11 @@
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
@@ -70,6 +73,17 @@ void AdBlockService::ShouldStartRequest(
     bool* did_match_exception,
     bool* did_match_important,
     std::string* mock_data_url) {
+  if (base::FeatureList::IsEnabled(
+          brave_shields::features::kBraveAdblockCompiledUnion)) {
+    std::vector<adblock::Engine*> engines;
+    CollectEngines(&engines);
+    regional_service_manager()->CollectEngines(&engines);
+    custom_filters_service()->CollectEngines(&engines);
+    MatchEngines(engines, url, resource_type, tab_host, did_match_rule,
+                 did_match_exception, did_match_important, mock_data_url);
+    return;
+  }
+
   AdBlockBaseService::ShouldStartRequest(
       url, resource_type, tab_host, did_match_rule, did_match_exception,
       did_match_important, mock_data_url);
@@ -89,6 +103,56 @@ void AdBlockService::ShouldStartRequest(
       did_match_important, mock_data_url);
 }
 
+void AdBlockService::ShouldStartRequests(
+    const std::vector<adblock::BatchRequest>& requests,
+    std::vector<adblock::BatchResult>* results) {
+  DCHECK_EQ(requests.size(), results->size());
+  UMA_HISTOGRAM_COUNTS_1000("Brave.Shields.AdBlockMatchBatchSize",
+                            requests.size());
+
+  if (base::FeatureList::IsEnabled(
+          brave_shields::features::kBraveAdblockCompiledUnion)) {
+    std::vector<adblock::Engine*> engines;
+    CollectEngines(&engines);
+    regional_service_manager()->CollectEngines(&engines);
+    custom_filters_service()->CollectEngines(&engines);
+    for (size_t i = 0; i < requests.size(); i++) {
+      const adblock::BatchRequest& request = requests[i];
+      adblock::BatchResult& result = (*results)[i];
+      adblock::Engine::matchesUnion(
+          engines, request.url, request.host, request.tab_host,
+          request.is_third_party, request.resource_type, &result.did_match_rule,
+          &result.did_match_exception, &result.did_match_important,
+          &result.redirect);
+    }
+    return;
+  }
+
+  // Requests that matched an important rule are skipped by later engines.
+  // Each stage is timed separately, so chrome://histograms shows which
+  // lists matching time goes to.
+  base::TimeTicks start = base::TimeTicks::Now();
+  AdBlockBaseService::ShouldStartRequests(requests, results);
+  UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+      "Brave.Shields.AdBlockMatchTime.Default", base::TimeTicks::Now() - start,
+      base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+      50);
+
+  start = base::TimeTicks::Now();
+  regional_service_manager()->ShouldStartRequests(requests, results);
+  UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+      "Brave.Shields.AdBlockMatchTime.Regional", base::TimeTicks::Now() - start,
+      base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+      50);
+
+  start = base::TimeTicks::Now();
+  custom_filters_service()->ShouldStartRequests(requests, results);
+  UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+      "Brave.Shields.AdBlockMatchTime.Custom", base::TimeTicks::Now() - start,
+      base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+      50);
+}
+
 base::Optional<std::string> AdBlockService::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
@@ -226,7 +290,7 @@ void AdBlockService::OnComponentReady(const std::string& component_id,
   custom_filters_service()->Start();
 
   base::FilePath dat_file_path = install_dir.AppendASCII(DAT_FILE);
-  GetDATFileData(dat_file_path);
+  GetDATFileData(component_id, dat_file_path);
 
   base::FilePath regional_catalog_file_path =
       install_dir.AppendASCII(REGIONAL_CATALOG);
@@ -56,6 +56,9 @@ class AdBlockService : public AdBlockBaseService {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* mock_data_url) override;
+  void ShouldStartRequests(
+      const std::vector<adblock::BatchRequest>& requests,
+      std::vector<adblock::BatchResult>* results) override;
   base::Optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
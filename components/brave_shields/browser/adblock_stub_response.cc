@@ -10,8 +10,10 @@
 
 #include "base/compiler_specific.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/mru_cache.h"
 #include "base/no_destructor.h"
 #include "base/strings/string_split.h"
+#include "base/synchronization/lock.h"
 #include "net/base/data_url.h"
 #include "net/http/http_util.h"
 #include "services/network/public/cpp/resource_request.h"
@@ -117,6 +119,41 @@ std::string GetContentForMimeType(const std::string& mime_type) {
   return it->second;
 }
 
+// Redirect resources come from a fixed list, so blocked requests keep getting
+// the same few data URLs. Remember what they decode to instead of parsing the
+// base64 payload again for every request.
+constexpr size_t kDecodedDataURLCacheSize = 64;
+
+struct DecodedDataURL {
+  bool valid = false;
+  std::string mime_type;
+  std::string data;
+};
+
+DecodedDataURL DecodeDataURL(const std::string& data_url) {
+  static base::NoDestructor<base::Lock> lock;
+  static base::NoDestructor<base::HashingMRUCache<std::string, DecodedDataURL>>
+      cache(kDecodedDataURLCacheSize);
+
+  {
+    base::AutoLock auto_lock(*lock);
+    auto it = cache->Get(data_url);
+    if (it != cache->end())
+      return it->second;
+  }
+
+  DecodedDataURL decoded;
+  std::string charset;
+  decoded.valid = net::DataURL::Parse(GURL(data_url), &decoded.mime_type,
+                                      &charset, &decoded.data);
+  if (!decoded.valid)
+    LOG(ERROR) << "Could not parse ad-block data URL: " << data_url;
+
+  base::AutoLock auto_lock(*lock);
+  cache->Put(data_url, decoded);
+  return decoded;
+}
+
 }  // namespace
 
 void MakeStubResponse(const base::Optional<std::string>& data_url,
@@ -145,16 +182,11 @@ void MakeStubResponse(const base::Optional<std::string>& data_url,
   }
 
   if (data_url.has_value() && !data_url->empty()) {
-    std::string charset;
-    std::string mime_type;
-    std::string url_data;
-    if (!net::DataURL::Parse(GURL(data_url.value()), &mime_type, &charset,
-                             &url_data)) {
-      LOG(ERROR) << "Could not parse ad-block data URL: " << data_url.value();
-    } else {
-      *data = std::move(url_data);
-      if (!mime_type.empty() && data_url.value().find("data:,") != 0) {
-        (*response)->mime_type = mime_type;
+    DecodedDataURL decoded = DecodeDataURL(data_url.value());
+    if (decoded.valid) {
+      *data = std::move(decoded.data);
+      if (!decoded.mime_type.empty() && data_url.value().find("data:,") != 0) {
+        (*response)->mime_type = std::move(decoded.mime_type);
       }
     }
   }
@@ -27,6 +27,17 @@ TEST(AdBlockStubResponse, HTMLDataURL) {
   ASSERT_EQ(resource_response->mime_type, "text/html");
 }
 
+TEST(AdBlockStubResponse, RepeatedDataURL) {
+  std::string data_url = "data:text/javascript;base64,KGZ1bmN0aW9uKCkge30pKCk7";
+  for (int i = 0; i < 2; i++) {
+    std::string data;
+    auto resource_response = network::mojom::URLResponseHead::New();
+    brave_shields::MakeStubResponse(data_url, {}, &resource_response, &data);
+    ASSERT_EQ(data, "(function() {})();");
+    ASSERT_EQ(resource_response->mime_type, "text/javascript");
+  }
+}
+
 TEST(AdBlockStubResponse, HTMLDataURLPrioritizedOverRequestInfo) {
   std::string data_url = "data:text/xml,pi";
   std::string data;
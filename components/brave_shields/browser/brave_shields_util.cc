@@ -13,6 +13,7 @@
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_shields/common/brave_shield_utils.h"
 #include "brave/components/brave_shields/common/features.h"
+#include "brave/components/content_settings/core/browser/brave_content_settings_pref_provider.h"
 #include "brave/components/content_settings/core/common/content_settings_util.h"
 #include "components/content_settings/core/browser/host_content_settings_map.h"
 #include "components/content_settings/core/common/content_settings_types.h"
@@ -54,6 +55,26 @@ ContentSetting GetDefaultBlockFromControlType(ControlType type) {
                                     : CONTENT_SETTING_BLOCK;
 }
 
+// Resolves a shields setting through BravePrefProvider's host index rather
+// than the map's linear scan of every per-site exception. Shields settings
+// only come from user prefs, so anything without a matching rule resolves to
+// the default setting.
+ContentSetting GetShieldsContentSetting(HostContentSettingsMap* map,
+                                        const GURL& primary_url,
+                                        const GURL& secondary_url,
+                                        ContentSettingsType content_type) {
+  auto* provider =
+      static_cast<content_settings::BravePrefProvider*>(map->GetPrefProvider());
+  if (!provider || !primary_url.SchemeIsHTTPOrHTTPS())
+    return map->GetContentSetting(primary_url, secondary_url, content_type);
+
+  const ContentSetting setting = provider->GetShieldsContentSetting(
+      primary_url, secondary_url, content_type);
+  if (setting != CONTENT_SETTING_DEFAULT)
+    return setting;
+  return map->GetDefaultContentSetting(content_type, nullptr);
+}
+
 }  // namespace
 
 ContentSettingsPattern GetPatternFromURL(const GURL& url) {
@@ -139,8 +160,8 @@ bool GetBraveShieldsEnabled(HostContentSettingsMap* map, const GURL& url) {
   if (url.is_valid() && !url.SchemeIsHTTPOrHTTPS())
     return false;
 
-  ContentSetting setting =
-      map->GetContentSetting(url, GURL(), ContentSettingsType::BRAVE_SHIELDS);
+  ContentSetting setting = GetShieldsContentSetting(
+      map, url, GURL(), ContentSettingsType::BRAVE_SHIELDS);
 
   // see EnableBraveShields - allow and default == true
   return setting == CONTENT_SETTING_BLOCK ? false : true;
@@ -169,8 +190,8 @@ void SetAdControlType(HostContentSettingsMap* map,
 }
 
 ControlType GetAdControlType(HostContentSettingsMap* map, const GURL& url) {
-  ContentSetting setting =
-      map->GetContentSetting(url, GURL(), ContentSettingsType::BRAVE_ADS);
+  ContentSetting setting = GetShieldsContentSetting(
+      map, url, GURL(), ContentSettingsType::BRAVE_ADS);
 
   return setting == CONTENT_SETTING_ALLOW ? ControlType::ALLOW
                                           : ControlType::BLOCK;
@@ -202,12 +223,12 @@ void SetCosmeticFilteringControlType(HostContentSettingsMap* map,
 
 ControlType GetCosmeticFilteringControlType(HostContentSettingsMap* map,
                                             const GURL& url) {
-  ContentSetting setting = map->GetContentSetting(
-      url, GURL(), ContentSettingsType::BRAVE_COSMETIC_FILTERING);
+  ContentSetting setting = GetShieldsContentSetting(
+      map, url, GURL(), ContentSettingsType::BRAVE_COSMETIC_FILTERING);
 
   ContentSetting fp_setting =
-      map->GetContentSetting(url, GURL("https://firstParty/"),
-                             ContentSettingsType::BRAVE_COSMETIC_FILTERING);
+      GetShieldsContentSetting(map, url, GURL("https://firstParty/"),
+                               ContentSettingsType::BRAVE_COSMETIC_FILTERING);
 
   if (setting == CONTENT_SETTING_ALLOW) {
     return ControlType::ALLOW;
@@ -277,11 +298,12 @@ void SetCookieControlType(HostContentSettingsMap* map,
 // TODO(bridiver) - convert cookie settings to ContentSettingsType::COOKIES
 // while maintaining read backwards compat
 ControlType GetCookieControlType(HostContentSettingsMap* map, const GURL& url) {
-  ContentSetting setting =
-      map->GetContentSetting(url, GURL(), ContentSettingsType::BRAVE_COOKIES);
+  ContentSetting setting = GetShieldsContentSetting(
+      map, url, GURL(), ContentSettingsType::BRAVE_COOKIES);
 
-  ContentSetting fp_setting = map->GetContentSetting(
-      url, GURL("https://firstParty/"), ContentSettingsType::BRAVE_COOKIES);
+  ContentSetting fp_setting =
+      GetShieldsContentSetting(map, url, GURL("https://firstParty/"),
+                               ContentSettingsType::BRAVE_COOKIES);
 
   if (setting == CONTENT_SETTING_ALLOW) {
     return ControlType::ALLOW;
@@ -293,8 +315,8 @@ ControlType GetCookieControlType(HostContentSettingsMap* map, const GURL& url) {
 }
 
 bool AllowReferrers(HostContentSettingsMap* map, const GURL& url) {
-  ContentSetting setting =
-      map->GetContentSetting(url, GURL(), ContentSettingsType::BRAVE_REFERRERS);
+  ContentSetting setting = GetShieldsContentSetting(
+      map, url, GURL(), ContentSettingsType::BRAVE_REFERRERS);
 
   return setting == CONTENT_SETTING_ALLOW;
 }
@@ -380,8 +402,8 @@ void ResetHTTPSEverywhereEnabled(HostContentSettingsMap* map,
 }
 
 bool GetHTTPSEverywhereEnabled(HostContentSettingsMap* map, const GURL& url) {
-  ContentSetting setting = map->GetContentSetting(
-      url, GURL(), ContentSettingsType::BRAVE_HTTP_UPGRADABLE_RESOURCES);
+  ContentSetting setting = GetShieldsContentSetting(
+      map, url, GURL(), ContentSettingsType::BRAVE_HTTP_UPGRADABLE_RESOURCES);
 
   return setting == CONTENT_SETTING_ALLOW ? false : true;
 }
@@ -6,12 +6,17 @@
 #include "brave/components/brave_shields/browser/domain_block_navigation_throttle.h"
 
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "base/bind.h"
+#include "base/containers/mru_cache.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/macros.h"
+#include "base/no_destructor.h"
 #include "base/task/post_task.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -32,6 +37,58 @@
 
 namespace {
 
+constexpr size_t kAllowedURLCacheSize = 100;
+
+// Main frame URLs which recently passed the domain block check. Reloads,
+// history navigations and redirects through them then proceed right away
+// instead of waiting behind subresource checks on the shields task runner.
+// Everything cached is dropped as soon as any engine changes. Only used on
+// the UI thread.
+class AllowedURLCache {
+ public:
+  static AllowedURLCache* GetInstance() {
+    static base::NoDestructor<AllowedURLCache> instance;
+    return instance.get();
+  }
+
+  bool Contains(const GURL& url) {
+    const uint64_t generation =
+        brave_shields::AdBlockBaseService::GetEngineGeneration();
+    if (generation != generation_) {
+      entries_.Clear();
+      generation_ = generation;
+      return false;
+    }
+    return entries_.Get(MakeKey(url)) != entries_.end();
+  }
+
+  // |generation| is the engine generation from before the check was posted, so
+  // that a result which raced with a filter list update isn't kept.
+  void Add(const GURL& url, uint64_t generation) {
+    if (generation != generation_ ||
+        generation != brave_shields::AdBlockBaseService::GetEngineGeneration())
+      return;
+    entries_.Put(MakeKey(url), true);
+  }
+
+ private:
+  friend class base::NoDestructor<AllowedURLCache>;
+
+  AllowedURLCache() : entries_(kAllowedURLCacheSize) {}
+  ~AllowedURLCache() = default;
+
+  static std::string MakeKey(const GURL& url) {
+    GURL::Replacements replacements;
+    replacements.ClearRef();
+    return url.ReplaceComponents(replacements).spec();
+  }
+
+  uint64_t generation_ = 0;
+  base::HashingMRUCache<std::string, bool> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllowedURLCache);
+};
+
 bool ShouldBlockDomainOnTaskRunner(
     brave_shields::AdBlockService* ad_block_service,
     const GURL& url) {
@@ -111,6 +168,9 @@ DomainBlockNavigationThrottle::WillStartRequest() {
   if (tab_storage->IsProceeding())
     return content::NavigationThrottle::PROCEED;
 
+  if (AllowedURLCache::GetInstance()->Contains(request_url))
+    return content::NavigationThrottle::PROCEED;
+
   // Otherwise, call the ad block service on a task runner to determine whether
   // this domain should be blocked.
   ad_block_service_->GetTaskRunner()->PostTaskAndReplyWithResult(
@@ -118,7 +178,8 @@ DomainBlockNavigationThrottle::WillStartRequest() {
       base::BindOnce(&ShouldBlockDomainOnTaskRunner, ad_block_service_,
                      request_url),
       base::BindOnce(&DomainBlockNavigationThrottle::OnShouldBlockDomain,
-                     weak_ptr_factory_.GetWeakPtr()));
+                     weak_ptr_factory_.GetWeakPtr(), request_url,
+                     AdBlockBaseService::GetEngineGeneration()));
 
   // Since the call to the ad block service is asynchronous, we defer the final
   // decision of whether to allow or block this navigation. The callback from
@@ -132,10 +193,13 @@ DomainBlockNavigationThrottle::WillRedirectRequest() {
 }
 
 void DomainBlockNavigationThrottle::OnShouldBlockDomain(
+    const GURL& request_url,
+    uint64_t engine_generation,
     bool should_block_domain) {
   if (should_block_domain) {
     ShowInterstitial();
   } else {
+    AllowedURLCache::GetInstance()->Add(request_url, engine_generation);
     // Navigation was deferred while we called the ad block service on a task
     // runner, but now we know that we want to allow navigation to continue.
     Resume();
@@ -6,6 +6,8 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_DOMAIN_BLOCK_NAVIGATION_THROTTLE_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_DOMAIN_BLOCK_NAVIGATION_THROTTLE_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -54,7 +56,9 @@ class DomainBlockNavigationThrottle : public content::NavigationThrottle {
   const char* GetNameForLogging() override;
 
  private:
-  void OnShouldBlockDomain(bool should_block_domain);
+  void OnShouldBlockDomain(const GURL& request_url,
+                           uint64_t engine_generation,
+                           bool should_block_domain);
   void ShowInterstitial();
 
   AdBlockService* ad_block_service_ = nullptr;
@@ -0,0 +1,58 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_host_filter.h"
+
+#include <algorithm>
+
+#include "base/containers/span.h"
+#include "base/hash/hash.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Ten bits and seven hashes per key give a false positive rate of about 1%.
+constexpr size_t kBitsPerKey = 10;
+constexpr size_t kNumHashes = 7;
+constexpr size_t kMinBits = 64;
+
+}  // namespace
+
+HTTPSEHostFilter::HTTPSEHostFilter(size_t expected_keys)
+    : num_bits_(std::max(kMinBits, expected_keys * kBitsPerKey)),
+      bits_((num_bits_ + 63) / 64) {}
+
+HTTPSEHostFilter::~HTTPSEHostFilter() = default;
+
+size_t HTTPSEHostFilter::BitIndex(uint32_t h1, uint32_t h2, size_t i) const {
+  // Double hashing: the i-th probe is h1 + i * h2.
+  return (static_cast<uint64_t>(h1) + i * static_cast<uint64_t>(h2)) %
+         num_bits_;
+}
+
+void HTTPSEHostFilter::Add(base::StringPiece key) {
+  const auto bytes = base::as_bytes(base::make_span(key));
+  const uint32_t h1 = base::FastHash(bytes);
+  const uint32_t h2 = base::PersistentHash(bytes) | 1;
+  for (size_t i = 0; i < kNumHashes; i++) {
+    const size_t bit = BitIndex(h1, h2, i);
+    bits_[bit / 64] |= uint64_t{1} << (bit % 64);
+  }
+}
+
+bool HTTPSEHostFilter::MayContain(base::StringPiece key) const {
+  const auto bytes = base::as_bytes(base::make_span(key));
+  const uint32_t h1 = base::FastHash(bytes);
+  const uint32_t h2 = base::PersistentHash(bytes) | 1;
+  for (size_t i = 0; i < kNumHashes; i++) {
+    const size_t bit = BitIndex(h1, h2, i);
+    if (!(bits_[bit / 64] & (uint64_t{1} << (bit % 64))))
+      return false;
+  }
+  return true;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,43 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_HOST_FILTER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_HOST_FILTER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace brave_shields {
+
+// A bloom filter over the keys of the HTTPS Everywhere rules database. It
+// never reports a false negative, so a key it doesn't contain certainly has
+// no rules and the database needn't be asked. About 1% of absent keys are
+// reported as present.
+class HTTPSEHostFilter {
+ public:
+  // Sizes the filter for |expected_keys| keys.
+  explicit HTTPSEHostFilter(size_t expected_keys);
+  ~HTTPSEHostFilter();
+
+  void Add(base::StringPiece key);
+  bool MayContain(base::StringPiece key) const;
+
+ private:
+  size_t BitIndex(uint32_t h1, uint32_t h2, size_t i) const;
+
+  const size_t num_bits_;
+  std::vector<uint64_t> bits_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSEHostFilter);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_HOST_FILTER_H_
@@ -0,0 +1,49 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_host_filter.h"
+
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+TEST(HTTPSEHostFilterTest, EmptyFilterContainsNothing) {
+  HTTPSEHostFilter filter(0);
+  EXPECT_FALSE(filter.MayContain("com.example"));
+  EXPECT_FALSE(filter.MayContain(""));
+}
+
+TEST(HTTPSEHostFilterTest, ContainsAddedKeys) {
+  HTTPSEHostFilter filter(3);
+  filter.Add("com.example");
+  filter.Add("com.example.*");
+  filter.Add("org.wikipedia.en");
+  EXPECT_TRUE(filter.MayContain("com.example"));
+  EXPECT_TRUE(filter.MayContain("com.example.*"));
+  EXPECT_TRUE(filter.MayContain("org.wikipedia.en"));
+}
+
+TEST(HTTPSEHostFilterTest, NoFalseNegativesAndFewFalsePositives) {
+  constexpr int kKeys = 10000;
+  HTTPSEHostFilter filter(kKeys);
+  for (int i = 0; i < kKeys; i++)
+    filter.Add("com.present" + base::NumberToString(i));
+
+  for (int i = 0; i < kKeys; i++)
+    EXPECT_TRUE(filter.MayContain("com.present" + base::NumberToString(i)));
+
+  int false_positives = 0;
+  for (int i = 0; i < kKeys; i++) {
+    if (filter.MayContain("com.absent" + base::NumberToString(i)))
+      false_positives++;
+  }
+  // About 1% is expected; allow some slack.
+  EXPECT_LT(false_positives, kKeys / 50);
+}
+
+}  // namespace brave_shields
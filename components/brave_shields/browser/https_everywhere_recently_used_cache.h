@@ -6,40 +6,162 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RECENTLY_USED_CACHE_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RECENTLY_USED_CACHE_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
-#include "base/containers/mru_cache.h"
+#include "base/logging.h"
+#include "base/macros.h"
 #include "base/synchronization/lock.h"
 
+// A thread-safe, approximately least recently used cache.
+//
+// Entries are spread over independently locked shards, so lookups for
+// different keys rarely contend. Each shard evicts with the CLOCK algorithm:
+// a hit only sets the entry's reference bit rather than reordering a list, so
+// a shard lock is held just for the hash lookup.
 template <class T> class HTTPSERecentlyUsedCache {
  public:
-  explicit HTTPSERecentlyUsedCache(size_t size = 100) : data_(size) {}
+  static constexpr size_t kDefaultSize = 1000;
+
+  // |shard_count| of 0 picks a shard count suited to |size|; small caches use
+  // a single shard so their eviction order stays predictable.
+  explicit HTTPSERecentlyUsedCache(size_t size = kDefaultSize,
+                                   size_t shard_count = 0) {
+    DCHECK_GT(size, 0u);
+    if (shard_count == 0) {
+      shard_count = std::min(kMaxShardCount,
+                             std::max<size_t>(1, size / kMinShardCapacity));
+    }
+    const size_t shard_capacity = (size + shard_count - 1) / shard_count;
+    for (size_t i = 0; i < shard_count; i++)
+      shards_.push_back(std::make_unique<Shard>(shard_capacity));
+  }
 
   void add(const std::string& key, const T& value) {
-    base::AutoLock create(lock_);
-    data_.Put(key, value);
+    Shard* shard = GetShard(key);
+    base::AutoLock lock(shard->lock);
+    auto it = shard->index.find(key);
+    if (it != shard->index.end()) {
+      Slot& slot = shard->slots[it->second];
+      slot.value = value;
+      slot.referenced = true;
+      return;
+    }
+
+    size_t slot_index;
+    if (shard->slots.size() < shard->capacity) {
+      slot_index = shard->slots.size();
+      shard->slots.emplace_back();
+    } else {
+      slot_index = shard->NextVictim();
+      Slot& victim = shard->slots[slot_index];
+      if (victim.used)
+        shard->index.erase(victim.key);
+    }
+
+    Slot& slot = shard->slots[slot_index];
+    slot.key = key;
+    slot.value = value;
+    slot.used = true;
+    slot.referenced = false;
+    shard->index[key] = slot_index;
   }
 
   bool get(const std::string& key, T* value) {
-    base::AutoLock create(lock_);
-    auto it = data_.Get(key);
-    if (it != data_.end()) {
-      *value = it->second;
-      return true;
+    Shard* shard = GetShard(key);
+    {
+      base::AutoLock lock(shard->lock);
+      auto it = shard->index.find(key);
+      if (it != shard->index.end()) {
+        Slot& slot = shard->slots[it->second];
+        slot.referenced = true;
+        *value = slot.value;
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
     }
+    misses_.fetch_add(1, std::memory_order_relaxed);
     return false;
   }
 
   void remove(const std::string& key) {
-    base::AutoLock lock(lock_);
-    auto it = data_.Peek(key);
-    if (it != data_.end())
-      data_.Erase(it);
+    Shard* shard = GetShard(key);
+    base::AutoLock lock(shard->lock);
+    auto it = shard->index.find(key);
+    if (it == shard->index.end())
+      return;
+    Slot& slot = shard->slots[it->second];
+    slot.used = false;
+    slot.referenced = false;
+    slot.key.clear();
+    slot.value = T();
+    shard->index.erase(it);
   }
 
+  // Lookup statistics, useful for sizing the cache.
+  uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+  uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+
  private:
-  base::MRUCache<std::string, T> data_;
-  base::Lock lock_;
+  static constexpr size_t kMaxShardCount = 16;
+  static constexpr size_t kMinShardCapacity = 64;
+
+  struct Slot {
+    std::string key;
+    T value;
+    bool used = false;
+    bool referenced = false;
+  };
+
+  struct Shard {
+    explicit Shard(size_t capacity) : capacity(capacity) {
+      slots.reserve(capacity);
+    }
+
+    // Advances the clock hand to the first free or unreferenced slot,
+    // clearing reference bits along the way.
+    size_t NextVictim() {
+      while (true) {
+        Slot& slot = slots[hand];
+        const size_t current = hand;
+        hand = (hand + 1) % slots.size();
+        if (!slot.used || !slot.referenced)
+          return current;
+        slot.referenced = false;
+      }
+    }
+
+    base::Lock lock;
+    const size_t capacity;
+    std::vector<Slot> slots;
+    std::unordered_map<std::string, size_t> index;
+    size_t hand = 0;
+  };
+
+  Shard* GetShard(const std::string& key) {
+    return shards_[std::hash<std::string>()(key) % shards_.size()].get();
+  }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERecentlyUsedCache);
 };
 
+template <class T>
+constexpr size_t HTTPSERecentlyUsedCache<T>::kDefaultSize;
+template <class T>
+constexpr size_t HTTPSERecentlyUsedCache<T>::kMaxShardCount;
+template <class T>
+constexpr size_t HTTPSERecentlyUsedCache<T>::kMinShardCapacity;
+
 #endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RECENTLY_USED_CACHE_H_
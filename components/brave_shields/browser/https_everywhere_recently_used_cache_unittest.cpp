@@ -28,3 +28,23 @@ TEST(HTTPSEverywhereRecentlyUsedCacheTest, Operations) {
   cache.remove("kD");
   ASSERT_FALSE(cache.get("kD", &v));
 }
+
+TEST(HTTPSEverywhereRecentlyUsedCacheTest, ShardedSizeAndStats) {
+  using Cache = HTTPSERecentlyUsedCache<std::string>;
+  Cache cache(1000);
+
+  for (int i = 0; i < 2000; i++)
+    cache.add(std::to_string(i), "v");
+
+  std::string v;
+  size_t found = 0;
+  for (int i = 0; i < 2000; i++) {
+    if (cache.get(std::to_string(i), &v))
+      found++;
+  }
+  // Each shard is bounded, so roughly |size| entries survive.
+  EXPECT_GE(found, 900u);
+  EXPECT_LE(found, 1100u);
+  EXPECT_EQ(cache.hits(), found);
+  EXPECT_EQ(cache.misses(), 2000u - found);
+}
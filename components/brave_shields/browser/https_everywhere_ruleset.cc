@@ -0,0 +1,189 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/values.h"
+#include "third_party/re2/src/re2/re2.h"
+#include "third_party/re2/src/re2/set.h"
+
+namespace brave_shields {
+
+struct HTTPSERuleset::Rule {
+  // Rules with the "d" key upgrade the scheme without rewriting.
+  bool default_rule = false;
+  std::unique_ptr<re2::RE2> from;
+  std::string to;
+  // Index in Ruleset::rewrites, or -1 if |from| failed to compile.
+  int set_index = -1;
+};
+
+struct HTTPSERuleset::Ruleset {
+  std::unique_ptr<re2::RE2::Set> exclusions;
+  // Contains the |from| pattern of every rewrite rule.
+  std::unique_ptr<re2::RE2::Set> rewrites;
+  bool has_rules = false;
+  std::vector<Rule> rules;
+};
+
+namespace {
+
+std::unique_ptr<re2::RE2::Set> CompileSetOrNull(
+    std::unique_ptr<re2::RE2::Set> set,
+    size_t size) {
+  if (size == 0 || !set->Compile())
+    return nullptr;
+  return set;
+}
+
+// Returns the index of |pattern| in |set|, or -1 if it doesn't compile.
+int AddToSet(re2::RE2::Set* set,
+             const std::string& pattern,
+             size_t* invalid_pattern_count) {
+  std::string error;
+  int index = set->Add(pattern, &error);
+  if (index < 0) {
+    VLOG(1) << "Invalid HTTPS Everywhere pattern " << pattern << ": "
+            << error;
+    (*invalid_pattern_count)++;
+  }
+  return index;
+}
+
+}  // namespace
+
+HTTPSERuleset::HTTPSERuleset() = default;
+
+HTTPSERuleset::~HTTPSERuleset() = default;
+
+// static
+std::unique_ptr<HTTPSERuleset> HTTPSERuleset::Parse(const std::string& json) {
+  base::Optional<base::Value> json_object = base::JSONReader::Read(json);
+  if (!json_object || !json_object->is_list())
+    return nullptr;
+
+  auto result = base::WrapUnique(new HTTPSERuleset());
+  for (const auto& top_value : json_object->GetList()) {
+    if (!top_value.is_dict())
+      continue;
+
+    auto ruleset = std::make_unique<Ruleset>();
+
+    const base::Value* exclusions = top_value.FindListKey("e");
+    if (exclusions) {
+      auto exclusion_set = std::make_unique<re2::RE2::Set>(
+          re2::RE2::DefaultOptions, re2::RE2::ANCHOR_BOTH);
+      size_t exclusion_count = 0;
+      for (const auto& exclusion : exclusions->GetList()) {
+        if (!exclusion.is_dict())
+          continue;
+        const std::string* pattern = exclusion.FindStringKey("p");
+        if (!pattern)
+          continue;
+        // Patterns that don't compile could never match.
+        if (AddToSet(exclusion_set.get(), CorrectToRuleForRE2(*pattern),
+                     &result->invalid_pattern_count_) >= 0) {
+          exclusion_count++;
+        }
+      }
+      ruleset->exclusions =
+          CompileSetOrNull(std::move(exclusion_set), exclusion_count);
+    }
+
+    const base::Value* rules = top_value.FindListKey("r");
+    if (rules) {
+      ruleset->has_rules = true;
+      auto rewrite_set = std::make_unique<re2::RE2::Set>(
+          re2::RE2::DefaultOptions, re2::RE2::UNANCHORED);
+      size_t rewrite_count = 0;
+      for (const auto& rule_value : rules->GetList()) {
+        if (!rule_value.is_dict())
+          continue;
+        Rule rule;
+        if (rule_value.FindKey("d")) {
+          rule.default_rule = true;
+          ruleset->rules.push_back(std::move(rule));
+          continue;
+        }
+        const std::string* from = rule_value.FindStringKey("f");
+        const std::string* to = rule_value.FindStringKey("t");
+        if (!from || !to)
+          continue;
+        rule.from = std::make_unique<re2::RE2>(*from);
+        rule.to = CorrectToRuleForRE2(*to);
+        if (rule.from->ok()) {
+          rule.set_index = AddToSet(rewrite_set.get(), *from,
+                                    &result->invalid_pattern_count_);
+          if (rule.set_index >= 0)
+            rewrite_count++;
+        } else {
+          VLOG(1) << "Invalid HTTPS Everywhere rule " << *from << ": "
+                  << rule.from->error();
+          result->invalid_pattern_count_++;
+        }
+        ruleset->rules.push_back(std::move(rule));
+      }
+      ruleset->rewrites =
+          CompileSetOrNull(std::move(rewrite_set), rewrite_count);
+    }
+
+    result->rulesets_.push_back(std::move(ruleset));
+  }
+  return result;
+}
+
+std::string HTTPSERuleset::Apply(const std::string& url) const {
+  for (const auto& ruleset : rulesets_) {
+    if (ruleset->exclusions && ruleset->exclusions->Match(url, nullptr))
+      return "";
+
+    if (!ruleset->has_rules)
+      return "";
+
+    std::vector<int> matching_rewrites;
+    bool any_rewrite_matches =
+        ruleset->rewrites && ruleset->rewrites->Match(url, &matching_rewrites);
+    std::vector<bool> rewrite_matches;
+    if (any_rewrite_matches) {
+      rewrite_matches.resize(ruleset->rules.size());
+      for (int index : matching_rewrites)
+        rewrite_matches[index] = true;
+    }
+
+    for (const auto& rule : ruleset->rules) {
+      if (rule.default_rule) {
+        std::string new_url(url);
+        return new_url.insert(4, "s");
+      }
+      if (!any_rewrite_matches || rule.set_index < 0 ||
+          !rewrite_matches[rule.set_index]) {
+        continue;
+      }
+      std::string new_url(url);
+      if (re2::RE2::Replace(&new_url, *rule.from, rule.to) && new_url != url)
+        return new_url;
+    }
+  }
+  return "";
+}
+
+// static
+std::string HTTPSERuleset::CorrectToRuleForRE2(const std::string& to) {
+  std::string correctedto(to);
+  size_t pos = to.find("$");
+  while (std::string::npos != pos) {
+    correctedto[pos] = '\\';
+    pos = correctedto.find("$");
+  }
+
+  return correctedto;
+}
+
+}  // namespace brave_shields
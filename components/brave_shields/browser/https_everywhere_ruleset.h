@@ -0,0 +1,56 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+
+namespace re2 {
+class RE2;
+}  // namespace re2
+
+namespace brave_shields {
+
+// A value from the HTTPS Everywhere rules database, parsed once and with all
+// of its regular expressions compiled up front. Exclusions and rewrite
+// patterns of each ruleset are grouped into RE2::Sets, so a URL that no rule
+// applies to is rejected with one pass per group instead of one per pattern.
+class HTTPSERuleset {
+ public:
+  // Returns nullptr if |json| is not a list of rulesets.
+  static std::unique_ptr<HTTPSERuleset> Parse(const std::string& json);
+
+  ~HTTPSERuleset();
+
+  // Returns |url| rewritten to HTTPS, or an empty string if no rule applies.
+  std::string Apply(const std::string& url) const;
+
+  // The number of exclusion and rewrite patterns that failed to compile and
+  // were skipped.
+  size_t invalid_pattern_count() const { return invalid_pattern_count_; }
+
+  // The database stores replacement strings with JS-style $N references.
+  static std::string CorrectToRuleForRE2(const std::string& to);
+
+ private:
+  struct Rule;
+  struct Ruleset;
+
+  HTTPSERuleset();
+
+  std::vector<std::unique_ptr<Ruleset>> rulesets_;
+  size_t invalid_pattern_count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERuleset);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
@@ -0,0 +1,62 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+
+#include <memory>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+TEST(HTTPSERulesetTest, InvalidJSON) {
+  EXPECT_FALSE(HTTPSERuleset::Parse("not json"));
+  EXPECT_FALSE(HTTPSERuleset::Parse("{}"));
+}
+
+TEST(HTTPSERulesetTest, DefaultRule) {
+  auto ruleset = HTTPSERuleset::Parse(R"([{"r": [{"d": 1}]}])");
+  ASSERT_TRUE(ruleset);
+  EXPECT_EQ("https://example.com/", ruleset->Apply("http://example.com/"));
+}
+
+TEST(HTTPSERulesetTest, RewriteRule) {
+  auto ruleset = HTTPSERuleset::Parse(
+      R"([{"r": [{"f": "^http://a\\.example\\.com/", "t": "https://a.example.com/"},
+                 {"f": "^http://(www\\.)?example\\.com/",
+                  "t": "https://$1example.com/"}]}])");
+  ASSERT_TRUE(ruleset);
+  EXPECT_EQ("https://a.example.com/x",
+            ruleset->Apply("http://a.example.com/x"));
+  EXPECT_EQ("https://www.example.com/y",
+            ruleset->Apply("http://www.example.com/y"));
+  EXPECT_EQ("", ruleset->Apply("http://b.example.com/"));
+}
+
+TEST(HTTPSERulesetTest, Exclusion) {
+  auto ruleset = HTTPSERuleset::Parse(
+      R"([{"e": [{"p": "^http://example\\.com/plain.*"}],
+           "r": [{"d": 1}]}])");
+  ASSERT_TRUE(ruleset);
+  EXPECT_EQ("", ruleset->Apply("http://example.com/plain/page"));
+  EXPECT_EQ("https://example.com/other",
+            ruleset->Apply("http://example.com/other"));
+  EXPECT_EQ(0u, ruleset->invalid_pattern_count());
+}
+
+TEST(HTTPSERulesetTest, InvalidPatternsAreCounted) {
+  auto ruleset = HTTPSERuleset::Parse(
+      R"([{"e": [{"p": "^http://example\\.com/(plain"}],
+           "r": [{"f": "^http://(example\\.com/",
+                  "t": "https://example.com/"},
+                 {"f": "^http://example\\.com/",
+                  "t": "https://example.com/"}]}])");
+  ASSERT_TRUE(ruleset);
+  EXPECT_EQ(2u, ruleset->invalid_pattern_count());
+  EXPECT_EQ("https://example.com/plain",
+            ruleset->Apply("http://example.com/plain"));
+}
+
+}  // namespace brave_shields
@@ -12,24 +12,34 @@
 
 #include "base/base_paths.h"
 #include "base/bind.h"
-#include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/scoped_blocking_call.h"
-#include "base/values.h"
+#include "brave/components/brave_shields/browser/https_everywhere_host_filter.h"
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+#include "third_party/leveldatabase/env_chromium.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
-#include "third_party/re2/src/re2/re2.h"
+#include "third_party/leveldatabase/src/include/leveldb/iterator.h"
 #include "third_party/zlib/google/zip.h"
 
 #define DAT_FILE "httpse.leveldb.zip"
 #define DAT_FILE_VERSION "6.0"
-#define HTTPSE_URLS_REDIRECTS_COUNT_QUEUE   1
 #define HTTPSE_URL_MAX_REDIRECTS_COUNT      5
 
 namespace {
 
+// Number of compiled rulesets kept around. Only targets that actually have
+// rules end up here, so this covers many more sites than its size suggests.
+constexpr size_t kRulesetCacheSize = 500;
+
+// Upper bound on requests whose redirect counts are tracked at once, and how
+// long an untouched count stays valid.
+constexpr size_t kMaxTrackedRedirectRequests = 1000;
+constexpr base::TimeDelta kRedirectCountExpiry =
+    base::TimeDelta::FromMinutes(5);
+
 std::vector<std::string> Split(const std::string& s, char delim) {
   std::stringstream ss(s);
   std::string item;
@@ -100,12 +110,13 @@ HTTPSEverywhereService::g_https_everywhere_component_base64_public_key_(
 HTTPSEverywhereService::HTTPSEverywhereService(
     BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
-      level_db_(nullptr) {
+      httpse_urls_redirects_count_(kMaxTrackedRedirectRequests),
+      ruleset_cache_(kRulesetCacheSize) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
 HTTPSEverywhereService::~HTTPSEverywhereService() {
-  GetTaskRunner()->DeleteSoon(FROM_HERE, level_db_);
+  GetTaskRunner()->DeleteSoon(FROM_HERE, std::move(level_db_));
 }
 
 bool HTTPSEverywhereService::Init() {
@@ -128,12 +139,11 @@ void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir) {
   }
 
   CloseDatabase();
+  ruleset_cache_.Clear();
 
-  leveldb::Options options;
-  leveldb::Status status =
-      leveldb::DB::Open(options,
-                        unzipped_level_db_path.AsUTF8Unsafe(),
-                        &level_db_);
+  leveldb_env::Options options;
+  leveldb::Status status = leveldb_env::OpenDB(
+      options, unzipped_level_db_path.AsUTF8Unsafe(), &level_db_);
   if (!status.ok() || !level_db_) {
     LOG(ERROR) << "Level db open error "
                << unzipped_level_db_path.value().c_str()
@@ -141,6 +151,39 @@ void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir) {
     CloseDatabase();
     return;
   }
+
+  BuildHostFilter();
+}
+
+void HTTPSEverywhereService::BuildHostFilter() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  leveldb::ReadOptions read_options;
+  read_options.fill_cache = false;
+
+  size_t key_count = 0;
+  std::unique_ptr<leveldb::Iterator> it(level_db_->NewIterator(read_options));
+  for (it->SeekToFirst(); it->Valid(); it->Next())
+    key_count++;
+  if (!it->status().ok()) {
+    LOG(ERROR) << "Failed to read HTTPSE database keys: "
+               << it->status().ToString();
+    return;
+  }
+
+  auto host_filter = std::make_unique<HTTPSEHostFilter>(key_count);
+  it.reset(level_db_->NewIterator(read_options));
+  for (it->SeekToFirst(); it->Valid(); it->Next())
+    host_filter->Add(base::StringPiece(it->key().data(), it->key().size()));
+  if (!it->status().ok()) {
+    LOG(ERROR) << "Failed to read HTTPSE database keys: "
+               << it->status().ToString();
+    return;
+  }
+
+  base::AutoLock auto_lock(host_filter_lock_);
+  host_filter_ = std::move(host_filter);
 }
 
 void HTTPSEverywhereService::OnComponentReady(
@@ -183,9 +226,9 @@ bool HTTPSEverywhereService::GetHTTPSURL(
   const std::vector<std::string> domains =
       ExpandDomainForLookup(candidate_url.host());
   for (auto domain : domains) {
-    std::string value = leveldbGet(level_db_, domain);
-    if (!value.empty()) {
-      *new_url = ApplyHTTPSRule(candidate_url.spec(), value);
+    const HTTPSERuleset* ruleset = GetRuleset(domain);
+    if (ruleset) {
+      *new_url = ruleset->Apply(candidate_url.spec());
       if (0 != new_url->length()) {
         recently_used_cache_.add(candidate_url.spec(), *new_url);
         AddHTTPSEUrlToRedirectList(request_identifier);
@@ -218,166 +261,78 @@ bool HTTPSEverywhereService::GetHTTPSURLFromCacheOnly(
   return false;
 }
 
+bool HTTPSEverywhereService::MayHaveRules(const GURL& url) {
+  if (!url.is_valid() || url.SchemeIs(url::kHttpsScheme))
+    return false;
+
+  base::AutoLock auto_lock(host_filter_lock_);
+  // Without a filter the database lookup has to decide.
+  if (!host_filter_)
+    return true;
+  for (const auto& domain : ExpandDomainForLookup(url.host())) {
+    if (host_filter_->MayContain(domain))
+      return true;
+  }
+  return false;
+}
+
 bool HTTPSEverywhereService::ShouldHTTPSERedirect(
     const uint64_t& request_identifier) {
   base::AutoLock auto_lock(httpse_get_urls_redirects_count_mutex_);
-  for (size_t i = 0; i < httpse_urls_redirects_count_.size(); i++) {
-    if (request_identifier ==
-        httpse_urls_redirects_count_[i].request_identifier_ &&
-        httpse_urls_redirects_count_[i].redirects_ >=
-        HTTPSE_URL_MAX_REDIRECTS_COUNT - 1) {
-      return false;
-    }
-  }
-
-  return true;
+  auto it = httpse_urls_redirects_count_.Peek(request_identifier);
+  if (it == httpse_urls_redirects_count_.end())
+    return true;
+  if (base::TimeTicks::Now() - it->second.last_update > kRedirectCountExpiry)
+    return true;
+  return it->second.redirects < HTTPSE_URL_MAX_REDIRECTS_COUNT - 1;
 }
 
 void HTTPSEverywhereService::AddHTTPSEUrlToRedirectList(
     const uint64_t& request_identifier) {
   // Adding redirects count for the current request
   base::AutoLock auto_lock(httpse_get_urls_redirects_count_mutex_);
-  bool hostFound = false;
-  for (size_t i = 0; i < httpse_urls_redirects_count_.size(); i++) {
-    if (request_identifier ==
-        httpse_urls_redirects_count_[i].request_identifier_) {
-      // Found the host, just increment the redirects_count
-      httpse_urls_redirects_count_[i].redirects_++;
-      hostFound = true;
-      break;
-    }
-  }
-  if (!hostFound) {
-      // The host is new, adding it to the redirects list
-      if (httpse_urls_redirects_count_.size() >=
-          HTTPSE_URLS_REDIRECTS_COUNT_QUEUE) {
-          // The queue is full, erase the first element
-          httpse_urls_redirects_count_.erase(
-              httpse_urls_redirects_count_.begin());
-      }
-      httpse_urls_redirects_count_.push_back(
-          HTTPSE_REDIRECTS_COUNT_ST(request_identifier, 1));
+  const base::TimeTicks now = base::TimeTicks::Now();
+  auto it = httpse_urls_redirects_count_.Get(request_identifier);
+  if (it == httpse_urls_redirects_count_.end()) {
+    it = httpse_urls_redirects_count_.Put(request_identifier, RedirectsCount());
+  } else if (now - it->second.last_update > kRedirectCountExpiry) {
+    it->second.redirects = 0;
   }
+  it->second.redirects++;
+  it->second.last_update = now;
 }
 
-std::string HTTPSEverywhereService::ApplyHTTPSRule(
-    const std::string& originalUrl,
-    const std::string& rule) {
-  base::Optional<base::Value> json_object = base::JSONReader::Read(rule);
-  if (base::nullopt == json_object || !json_object->is_list()) {
-    return "";
-  }
-
-  base::Value::ConstListView topValues = json_object->GetList();
-  for (auto it = topValues.cbegin(); it != topValues.cend(); ++it) {
-    if (!it->is_dict()) {
-      continue;
-    }
-    const base::DictionaryValue* childTopDictionary = nullptr;
-    it->GetAsDictionary(&childTopDictionary);
-    if (nullptr == childTopDictionary) {
-      continue;
-    }
-
-    const base::Value* exclusion = nullptr;
-    if (childTopDictionary->Get("e", &exclusion)) {
-      const base::ListValue* eValues = nullptr;
-      exclusion->GetAsList(&eValues);
-      if (nullptr != eValues) {
-        for (size_t j = 0; j < eValues->GetSize(); ++j) {
-          const base::Value* pValue = nullptr;
-          if (!eValues->Get(j, &pValue)) {
-            continue;
-          }
-          const base::DictionaryValue* pDictionary = nullptr;
-          pValue->GetAsDictionary(&pDictionary);
-          if (nullptr == pDictionary) {
-            continue;
-          }
-          const base::Value* patternValue = nullptr;
-          if (!pDictionary->Get("p", &patternValue)) {
-            continue;
-          }
-          std::string pattern;
-          if (!patternValue->GetAsString(&pattern)) {
-            continue;
-          }
-          pattern = CorrecttoRuleToRE2Engine(pattern);
-          if (RE2::FullMatch(originalUrl, pattern)) {
-            return "";
-          }
-        }
-      }
-    }
-
-    const base::Value* rules = nullptr;
-    if (!childTopDictionary->Get("r", &rules)) {
-      return "";
-    }
-    const base::ListValue* rValues = nullptr;
-    rules->GetAsList(&rValues);
-    if (nullptr == rValues) {
-      return "";
-    }
-
-    for (size_t j = 0; j < rValues->GetSize(); ++j) {
-      const base::Value* pValue = nullptr;
-      if (!rValues->Get(j, &pValue)) {
-        continue;
-      }
-      const base::DictionaryValue* pDictionary = nullptr;
-      pValue->GetAsDictionary(&pDictionary);
-      if (nullptr == pDictionary) {
-        continue;
-      }
-      const base::Value* patternValue = nullptr;
-      if (pDictionary->Get("d", &patternValue)) {
-        std::string newUrl(originalUrl);
-        return newUrl.insert(4, "s");
-      }
-
-      const base::Value* from_value = nullptr;
-      const base::Value* to_value = nullptr;
-      if (!pDictionary->Get("f", &from_value) ||
-          !pDictionary->Get("t", &to_value)) {
-        continue;
-      }
-      std::string from, to;
-      if (!from_value->GetAsString(&from) ||
-          !to_value->GetAsString(&to)) {
-        continue;
-      }
-
-      to = CorrecttoRuleToRE2Engine(to);
-      std::string newUrl(originalUrl);
-      RE2 regExp(from);
-
-      if (RE2::Replace(&newUrl, regExp, to) && newUrl != originalUrl) {
-        return newUrl;
-      }
-    }
-  }
-  return "";
+void HTTPSEverywhereService::OnRequestDestroyed(uint64_t request_identifier) {
+  base::AutoLock auto_lock(httpse_get_urls_redirects_count_mutex_);
+  auto it = httpse_urls_redirects_count_.Peek(request_identifier);
+  if (it != httpse_urls_redirects_count_.end())
+    httpse_urls_redirects_count_.Erase(it);
 }
 
-std::string HTTPSEverywhereService::CorrecttoRuleToRE2Engine(
-    const std::string& to) {
-  std::string correctedto(to);
-  size_t pos = to.find("$");
-  while (std::string::npos != pos) {
-    correctedto[pos] = '\\';
-    pos = correctedto.find("$");
-  }
-
-  return correctedto;
+const HTTPSERuleset* HTTPSEverywhereService::GetRuleset(
+    const std::string& domain) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto it = ruleset_cache_.Get(domain);
+  if (it != ruleset_cache_.end())
+    return it->second.get();
+
+  std::string value = leveldbGet(level_db_.get(), domain);
+  if (value.empty())
+    return nullptr;
+
+  std::unique_ptr<HTTPSERuleset> ruleset = HTTPSERuleset::Parse(value);
+  if (!ruleset)
+    return nullptr;
+  return ruleset_cache_.Put(domain, std::move(ruleset))->second.get();
 }
 
 void HTTPSEverywhereService::CloseDatabase() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  if (level_db_) {
-    delete level_db_;
-    level_db_ = nullptr;
+  {
+    base::AutoLock auto_lock(host_filter_lock_);
+    host_filter_.reset();
   }
+  level_db_.reset();
 }
 
 // static
@@ -10,10 +10,12 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/synchronization/lock.h"
+#include "base/time/time.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
 
@@ -27,22 +29,13 @@ using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
+class HTTPSEHostFilter;
+class HTTPSERuleset;
+
 extern const char kHTTPSEverywhereComponentName[];
 extern const char kHTTPSEverywhereComponentId[];
 extern const char kHTTPSEverywhereComponentBase64PublicKey[];
 
-struct HTTPSE_REDIRECTS_COUNT_ST {
- public:
-  HTTPSE_REDIRECTS_COUNT_ST(uint64_t request_identifier,
-                            unsigned int redirects):
-    request_identifier_(request_identifier),
-    redirects_(redirects) {
-  }
-
-  uint64_t request_identifier_;
-  unsigned int redirects_;
-};
-
 class HTTPSEverywhereService : public BaseBraveShieldsService,
                          public base::SupportsWeakPtr<HTTPSEverywhereService> {
  public:
@@ -54,6 +47,11 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
   bool GetHTTPSURLFromCacheOnly(const GURL* url,
                                 const uint64_t& request_id,
                                 std::string* cached_url);
+  // Drops the redirect count kept for |request_id| once the request is gone.
+  void OnRequestDestroyed(uint64_t request_id);
+  // Returns false if no rule can apply to |url|, so that GetHTTPSURL()
+  // needn't be called. Can be called from any sequence.
+  bool MayHaveRules(const GURL& url);
 
  protected:
   bool Init() override;
@@ -63,9 +61,8 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
 
   void AddHTTPSEUrlToRedirectList(const uint64_t& request_id);
   bool ShouldHTTPSERedirect(const uint64_t& request_id);
-  std::string ApplyHTTPSRule(const std::string& originalUrl,
-      const std::string& rule);
-  std::string CorrecttoRuleToRE2Engine(const std::string& to);
+  // Returns the compiled ruleset stored for |domain|, or nullptr.
+  const HTTPSERuleset* GetRuleset(const std::string& domain);
 
  private:
   friend class ::HTTPSEverywhereServiceTest;
@@ -80,11 +77,28 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
   void CloseDatabase();
 
   void InitDB(const base::FilePath& install_dir);
+  void BuildHostFilter();
+
+  struct RedirectsCount {
+    unsigned int redirects = 0;
+    base::TimeTicks last_update;
+  };
 
   base::Lock httpse_get_urls_redirects_count_mutex_;
-  std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
+  // Redirects done so far per request. Entries are dropped when the request
+  // is destroyed; the size bound and expiry only catch requests that never
+  // report back.
+  base::HashingMRUCache<uint64_t, RedirectsCount> httpse_urls_redirects_count_;
   HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
-  leveldb::DB* level_db_;
+  // Compiled rulesets keyed by their database key, only used on the task
+  // runner sequence.
+  base::MRUCache<std::string, std::unique_ptr<HTTPSERuleset>> ruleset_cache_;
+  base::Lock host_filter_lock_;
+  // Every key of |level_db_|, or nullptr while no database is loaded.
+  std::unique_ptr<HTTPSEHostFilter> host_filter_;
+  // Opened through leveldb_env so that its memory is reported by the leveldb
+  // memory-infra dump provider.
+  std::unique_ptr<leveldb::DB> level_db_;
 
   SEQUENCE_CHECKER(sequence_checker_);
   DISALLOW_COPY_AND_ASSIGN(HTTPSEverywhereService);
@@ -0,0 +1,36 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_settings_snapshot.h"
+
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+
+namespace brave_shields {
+
+// static
+scoped_refptr<const ShieldsSettingsSnapshot> ShieldsSettingsSnapshot::Create(
+    HostContentSettingsMap* map,
+    const GURL& tab_origin) {
+  return base::WrapRefCounted(new ShieldsSettingsSnapshot(
+      tab_origin, GetBraveShieldsEnabled(map, tab_origin),
+      GetAdControlType(map, tab_origin) == ControlType::ALLOW,
+      GetHTTPSEverywhereEnabled(map, tab_origin),
+      AllowReferrers(map, tab_origin)));
+}
+
+ShieldsSettingsSnapshot::ShieldsSettingsSnapshot(const GURL& tab_origin,
+                                                 bool shields_enabled,
+                                                 bool allow_ads,
+                                                 bool https_everywhere_enabled,
+                                                 bool allow_referrers)
+    : tab_origin_(tab_origin),
+      shields_enabled_(shields_enabled),
+      allow_ads_(allow_ads),
+      https_everywhere_enabled_(https_everywhere_enabled),
+      allow_referrers_(allow_referrers) {}
+
+ShieldsSettingsSnapshot::~ShieldsSettingsSnapshot() = default;
+
+}  // namespace brave_shields
@@ -0,0 +1,54 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_SNAPSHOT_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_SNAPSHOT_H_
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "url/gurl.h"
+
+class HostContentSettingsMap;
+
+namespace brave_shields {
+
+// The shields settings that apply to requests made from one tab origin, read
+// from content settings once and shared by every request of that tab. The
+// snapshot never changes; a settings change replaces it with a new one.
+class ShieldsSettingsSnapshot
+    : public base::RefCountedThreadSafe<ShieldsSettingsSnapshot> {
+ public:
+  static scoped_refptr<const ShieldsSettingsSnapshot> Create(
+      HostContentSettingsMap* map,
+      const GURL& tab_origin);
+
+  const GURL& tab_origin() const { return tab_origin_; }
+  bool shields_enabled() const { return shields_enabled_; }
+  bool allow_ads() const { return allow_ads_; }
+  bool https_everywhere_enabled() const { return https_everywhere_enabled_; }
+  bool allow_referrers() const { return allow_referrers_; }
+
+ private:
+  friend class base::RefCountedThreadSafe<ShieldsSettingsSnapshot>;
+
+  ShieldsSettingsSnapshot(const GURL& tab_origin,
+                          bool shields_enabled,
+                          bool allow_ads,
+                          bool https_everywhere_enabled,
+                          bool allow_referrers);
+  ~ShieldsSettingsSnapshot();
+
+  const GURL tab_origin_;
+  const bool shields_enabled_;
+  const bool allow_ads_;
+  const bool https_everywhere_enabled_;
+  const bool allow_referrers_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettingsSnapshot);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_SNAPSHOT_H_
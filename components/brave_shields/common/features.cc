@@ -15,6 +15,11 @@ namespace features {
 // substituted for any canonical name found.
 const base::Feature kBraveAdblockCnameUncloaking{
     "BraveAdblockCnameUncloaking", base::FEATURE_ENABLED_BY_DEFAULT};
+// When enabled, network requests are checked against the default, regional
+// and custom filter engines in a single pass through adblock-rust instead of
+// one call per engine.
+const base::Feature kBraveAdblockCompiledUnion{
+    "BraveAdblockCompiledUnion", base::FEATURE_DISABLED_BY_DEFAULT};
 const base::Feature kBraveAdblockCosmeticFiltering{
     "BraveAdblockCosmeticFiltering",
     base::FEATURE_ENABLED_BY_DEFAULT};
@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_sync/crypto/crypto.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "base/logging.h"
@@ -14,6 +15,7 @@
 #include "third_party/boringssl/src/include/openssl/curve25519.h"
 #include "third_party/boringssl/src/include/openssl/digest.h"
 #include "third_party/boringssl/src/include/openssl/hkdf.h"
+#include "third_party/boringssl/src/include/openssl/mem.h"
 
 namespace brave_sync {
 namespace crypto {
@@ -24,7 +26,7 @@ std::vector<uint8_t> GetSeed(size_t size) {
   return bytes;
 }
 
-std::vector<uint8_t> HKDFSha512(const std::vector<uint8_t>& ikm,
+std::vector<uint8_t> HKDFSha512(base::span<const uint8_t> ikm,
                                 const std::vector<uint8_t>* salt,
                                 const std::vector<uint8_t>* info,
                                 size_t derived_key_size) {
@@ -37,7 +39,7 @@ std::vector<uint8_t> HKDFSha512(const std::vector<uint8_t>& ikm,
   return derived_key;
 }
 
-void DeriveSigningKeysFromSeed(const std::vector<uint8_t>& seed,
+void DeriveSigningKeysFromSeed(base::span<const uint8_t> seed,
                                const std::vector<uint8_t>* salt,
                                const std::vector<uint8_t>* info,
                                std::vector<uint8_t>* public_key,
@@ -45,16 +47,20 @@ void DeriveSigningKeysFromSeed(const std::vector<uint8_t>& seed,
   DCHECK(public_key);
   DCHECK(private_key);
   DCHECK(info);
-  std::vector<uint8_t> output =
-      HKDFSha512(seed, salt, info, DEFAULT_SEED_SIZE);
+  uint8_t output[DEFAULT_SEED_SIZE];
+  int result =
+      HKDF(output, sizeof(output), EVP_sha512(), seed.data(), seed.size(),
+           salt ? salt->data() : NULL, salt ? salt->size() : 0, info->data(),
+           info->size());
+  DCHECK(result);
   public_key->resize(ED25519_PUBLIC_KEY_LEN);
   private_key->resize(ED25519_PRIVATE_KEY_LEN);
-  ED25519_keypair_from_seed(public_key->data(), private_key->data(),
-                            output.data());
+  ED25519_keypair_from_seed(public_key->data(), private_key->data(), output);
+  OPENSSL_cleanse(output, sizeof(output));
 }
 
-bool Sign(const std::vector<uint8_t>& message,
-          const std::vector<uint8_t>& private_key,
+bool Sign(base::span<const uint8_t> message,
+          base::span<const uint8_t> private_key,
           std::vector<uint8_t>* out_sig) {
   DCHECK(out_sig);
   DCHECK_EQ(private_key.size(), (size_t)ED25519_PRIVATE_KEY_LEN);
@@ -63,9 +69,9 @@ bool Sign(const std::vector<uint8_t>& message,
                       private_key.data());
 }
 
-bool Verify(const std::vector<uint8_t>& message,
-            const std::vector<uint8_t>& signature,
-            const std::vector<uint8_t>& public_key) {
+bool Verify(base::span<const uint8_t> message,
+            base::span<const uint8_t> signature,
+            base::span<const uint8_t> public_key) {
   DCHECK_EQ(signature.size(), (size_t)ED25519_SIGNATURE_LEN);
   DCHECK_EQ(public_key.size(), (size_t)ED25519_PUBLIC_KEY_LEN);
   return ED25519_verify(message.data(), message.size(), signature.data(),
@@ -84,29 +90,27 @@ std::vector<uint8_t> GetNonce(uint16_t counter,
   return nonce;
 }
 
-bool Encrypt(const std::vector<uint8_t>& message,
-             const std::vector<uint8_t>& nonce,
-             const std::vector<uint8_t>& secretbox_key,
+bool Encrypt(base::span<const uint8_t> message,
+             base::span<const uint8_t> nonce,
+             base::span<const uint8_t> secretbox_key,
              std::vector<uint8_t>* ciphertext) {
   DCHECK(ciphertext);
   DCHECK_EQ(secretbox_key.size(), (size_t)crypto_secretbox_KEYBYTES);
   DCHECK_EQ(nonce.size(), (size_t)crypto_secretbox_NONCEBYTES);
   std::vector<uint8_t> m(crypto_secretbox_ZEROBYTES + message.size());
   std::vector<uint8_t> c(m.size());
-  for (size_t i = 0; i < message.size(); ++i) {
-    m[i + crypto_secretbox_ZEROBYTES] = message[i];
-  }
+  std::copy(message.begin(), message.end(),
+            m.begin() + crypto_secretbox_ZEROBYTES);
   if (crypto_secretbox(c.data(), m.data(), m.size(), nonce.data(),
                        secretbox_key.data()) != 0)
     return false;
-  *ciphertext =
-      std::vector<uint8_t>(c.begin() + crypto_secretbox_BOXZEROBYTES, c.end());
+  ciphertext->assign(c.begin() + crypto_secretbox_BOXZEROBYTES, c.end());
   return true;
 }
 
-bool Decrypt(const std::vector<uint8_t>& ciphertext,
-             const std::vector<uint8_t>& nonce,
-             const std::vector<uint8_t>& secretbox_key,
+bool Decrypt(base::span<const uint8_t> ciphertext,
+             base::span<const uint8_t> nonce,
+             base::span<const uint8_t> secretbox_key,
              std::vector<uint8_t>* message) {
   DCHECK(message);
   DCHECK_EQ(secretbox_key.size(), (size_t)crypto_secretbox_KEYBYTES);
@@ -115,14 +119,12 @@ bool Decrypt(const std::vector<uint8_t>& ciphertext,
   if (c.size() < 32)
     return false;
   std::vector<uint8_t> m(c.size());
-  for (size_t i = 0; i < ciphertext.size(); ++i) {
-    c[i + crypto_secretbox_BOXZEROBYTES] = ciphertext[i];
-  }
+  std::copy(ciphertext.begin(), ciphertext.end(),
+            c.begin() + crypto_secretbox_BOXZEROBYTES);
   if (crypto_secretbox_open(m.data(), c.data(), c.size(), nonce.data(),
                             secretbox_key.data()) != 0)
     return false;
-  *message =
-      std::vector<uint8_t>(m.begin() + crypto_secretbox_ZEROBYTES, m.end());
+  message->assign(m.begin() + crypto_secretbox_ZEROBYTES, m.end());
   return true;
 }
 
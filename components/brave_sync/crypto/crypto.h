@@ -8,6 +8,8 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/span.h"
+
 namespace brave_sync {
 namespace crypto {
 
@@ -18,13 +20,13 @@ std::vector<uint8_t> GetSeed(size_t size = DEFAULT_SEED_SIZE);
 
 // Returns HKDF output according to rfc5869 using sha512
 // salt and info are optional
-std::vector<uint8_t> HKDFSha512(const std::vector<uint8_t>& ikm,
+std::vector<uint8_t> HKDFSha512(base::span<const uint8_t> ikm,
                                 const std::vector<uint8_t>* salt,
                                 const std::vector<uint8_t>* info,
                                 size_t derived_key_size);
 
 // Derives an Ed25519 keypair given a random seed and an optional HKDF salt
-void DeriveSigningKeysFromSeed(const std::vector<uint8_t>& seed,
+void DeriveSigningKeysFromSeed(base::span<const uint8_t> seed,
                                const std::vector<uint8_t>* salt,
                                const std::vector<uint8_t>* info,
                                std::vector<uint8_t>* public_key,
@@ -32,15 +34,15 @@ void DeriveSigningKeysFromSeed(const std::vector<uint8_t>& seed,
 
 // Signs a message using Ed25519.
 // It returns true on success or false on allocation failure.
-bool Sign(const std::vector<uint8_t>& message,
-          const std::vector<uint8_t>& private_key,
+bool Sign(base::span<const uint8_t> message,
+          base::span<const uint8_t> private_key,
           std::vector<uint8_t>* out_sig);
 
 // Verify a message using Ed25519.
 // It returns true iff |signature| is a valid signature
-bool Verify(const std::vector<uint8_t>& message,
-            const std::vector<uint8_t>& signature,
-            const std::vector<uint8_t>& public_key);
+bool Verify(base::span<const uint8_t> message,
+            base::span<const uint8_t> signature,
+            base::span<const uint8_t> public_key);
 
 /**
  * Build a 24-byte nonce for NaCl secretbox. Nonce structure is:
@@ -62,9 +64,9 @@ std::vector<uint8_t> GetNonce(uint16_t counter,
  * @param ciphertext encrypted by secretbox_key
  * @returns success or failure
  */
-bool Encrypt(const std::vector<uint8_t>& message,
-             const std::vector<uint8_t>& nonce,
-             const std::vector<uint8_t>& secretbox_key,
+bool Encrypt(base::span<const uint8_t> message,
+             base::span<const uint8_t> nonce,
+             base::span<const uint8_t> secretbox_key,
              std::vector<uint8_t>* ciphertext);
 
 /**
@@ -76,9 +78,9 @@ bool Encrypt(const std::vector<uint8_t>& message,
  * @param message
  * @returns true when sucess, false if verification fails
  */
-bool Decrypt(const std::vector<uint8_t>& ciphertext,
-             const std::vector<uint8_t>& nonce,
-             const std::vector<uint8_t>& secretbox_key,
+bool Decrypt(base::span<const uint8_t> ciphertext,
+             base::span<const uint8_t> nonce,
+             base::span<const uint8_t> secretbox_key,
              std::vector<uint8_t>* message);
 /**
  * Convert a 32 bytes array into passphrase using bip39
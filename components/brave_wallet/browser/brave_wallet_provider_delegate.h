@@ -6,6 +6,8 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_BRAVE_WALLET_PROVIDER_DELEGATE_H_
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_BRAVE_WALLET_PROVIDER_DELEGATE_H_
 
+#include "url/origin.h"
+
 namespace brave_wallet {
 
 class BraveWalletProviderDelegate {
@@ -17,6 +19,8 @@ class BraveWalletProviderDelegate {
   virtual ~BraveWalletProviderDelegate() = default;
 
   virtual void ShowConnectToSiteUI() = 0;
+  // Returns the origin of the top level page the provider is exposed to.
+  virtual url::Origin GetOrigin() const = 0;
 };
 
 }  // namespace brave_wallet
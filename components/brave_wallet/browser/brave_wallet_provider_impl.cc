@@ -10,9 +10,54 @@
 #include "brave/components/brave_wallet/browser/brave_wallet_provider_delegate.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_service.h"
 #include "brave/components/brave_wallet/browser/eth_json_rpc_controller.h"
+#include "brave/components/brave_wallet/browser/eth_requests.h"
 
 namespace brave_wallet {
 
+namespace {
+
+// Read-only methods which dapps poll and whose results are the same for
+// every caller. Block aware results are only valid until the chain head
+// moves.
+const struct {
+  const char* method;
+  bool block_aware;
+} kCacheableMethods[] = {
+    {"eth_blockNumber", true},  {"eth_call", true},
+    {"eth_chainId", false},     {"eth_gasPrice", true},
+    {"eth_getBalance", true},   {"eth_getCode", true},
+    {"eth_getStorageAt", true}, {"eth_getTransactionCount", true},
+    {"net_version", false},
+};
+
+// Methods which send or sign transactions and so change the state the
+// origin's cached block aware results were read from.
+const char* const kStateChangingMethods[] = {
+    "eth_sendRawTransaction", "eth_sendTransaction", "eth_sign",
+    "eth_signTransaction",    "eth_signTypedData",   "eth_signTypedData_v3",
+    "eth_signTypedData_v4",   "personal_sign",
+};
+
+bool IsStateChangingMethod(const std::string& method) {
+  for (const char* state_changing_method : kStateChangingMethods) {
+    if (method == state_changing_method)
+      return true;
+  }
+  return false;
+}
+
+bool IsCacheableMethod(const std::string& method, bool* block_aware) {
+  for (const auto& cacheable_method : kCacheableMethods) {
+    if (method == cacheable_method.method) {
+      *block_aware = cacheable_method.block_aware;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
 BraveWalletProviderImpl::BraveWalletProviderImpl(
     base::WeakPtr<BraveWalletService> wallet_service,
     std::unique_ptr<BraveWalletProviderDelegate> delegate)
@@ -34,6 +79,30 @@ void BraveWalletProviderImpl::Request(const std::string& json_payload,
     return;
 
   auto* rpc_controller = wallet_service_->rpc_controller();
+
+  std::string method;
+  base::Value id;
+  bool block_aware = false;
+  const bool has_method =
+      delegate_ && GetJsonRpcMethodAndId(json_payload, &method, &id);
+  if (has_method && IsStateChangingMethod(method))
+    rpc_controller->ClearProviderResponses(delegate_->GetOrigin());
+  // Results for the "pending" block change with every transaction seen.
+  if (has_method && IsCacheableMethod(method, &block_aware) &&
+      !IsPendingBlockRequest(json_payload)) {
+    // Pages pick their own ids, so requests are cached with a fixed one and
+    // the page's id is put back into the response.
+    const std::string cacheable_payload =
+        SetJsonRpcId(json_payload, base::Value(1));
+    rpc_controller->CachedProviderRequest(
+        delegate_->GetOrigin(), cacheable_payload,
+        base::BindOnce(&BraveWalletProviderImpl::OnCachedResponse,
+                       weak_factory_.GetWeakPtr(), std::move(callback),
+                       std::move(id)),
+        block_aware);
+    return;
+  }
+
   rpc_controller->Request(
       json_payload,
       base::BindOnce(&BraveWalletProviderImpl::OnResponse,
@@ -51,6 +120,18 @@ void BraveWalletProviderImpl::OnResponse(
   std::move(callback).Run(http_code, response);
 }
 
+void BraveWalletProviderImpl::OnCachedResponse(
+    RequestCallback callback,
+    const base::Value& id,
+    const int http_code,
+    const std::string& response,
+    const std::map<std::string, std::string>& headers) {
+  // Error pages are not JSON-RPC responses and are passed on as they are.
+  const std::string response_with_id = SetJsonRpcId(response, id);
+  std::move(callback).Run(
+      http_code, response_with_id.empty() ? response : response_with_id);
+}
+
 void BraveWalletProviderImpl::Enable() {
   if (!delegate_)
     return;
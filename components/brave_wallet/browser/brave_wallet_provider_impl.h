@@ -11,6 +11,7 @@
 #include <string>
 
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_provider_events_observer.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
@@ -39,6 +40,11 @@ class BraveWalletProviderImpl final : public mojom::BraveWalletProvider,
                   const int http_code,
                   const std::string& response,
                   const std::map<std::string, std::string>& headers);
+  void OnCachedResponse(RequestCallback callback,
+                        const base::Value& id,
+                        const int http_code,
+                        const std::string& response,
+                        const std::map<std::string, std::string>& headers);
   void Enable() override;
   void GetChainId(GetChainIdCallback callback) override;
   void Init(
@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_wallet/browser/brave_wallet_service.h"
 
+#include "base/trace_event/trace_event.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_json_rpc_controller.h"
@@ -20,6 +21,7 @@ BraveWalletService::BraveWalletService(
     PrefService* prefs,
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
     : prefs_(prefs) {
+  TRACE_EVENT0("brave.wallet", "BraveWalletService::BraveWalletService");
   rpc_controller_ = std::make_unique<brave_wallet::EthJsonRpcController>(
       brave_wallet::Network::kMainnet, url_loader_factory);
   keyring_controller_ =
@@ -38,6 +40,7 @@ void BraveWalletService::RegisterProfilePrefs(PrefRegistrySimple* registry) {
   registry->RegisterStringPref(kBraveWalletPasswordEncryptorNonce, "");
   registry->RegisterStringPref(kBraveWalletEncryptedMnemonic, "");
   registry->RegisterIntegerPref(kBraveWalletDefaultKeyringAccountNum, 0);
+  registry->RegisterStringPref(kBraveWalletEncryptedAccountAddresses, "");
   registry->RegisterBooleanPref(kShowWalletIconOnToolbar, true);
   registry->RegisterBooleanPref(kBraveWalletBackupComplete, false);
 }
@@ -8,6 +8,9 @@
 #include <utility>
 
 #include "base/environment.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_call_data_builder.h"
 #include "brave/components/brave_wallet/browser/eth_requests.h"
@@ -15,6 +18,7 @@
 #include "net/base/load_flags.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
+#include "url/origin.h"
 
 namespace {
 
@@ -43,6 +47,21 @@ net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
 
 const unsigned int kRetriesCountOnNetworkChange = 1;
 
+// How long read-only requests are held back to be batched with others, and
+// the largest batch sent at once.
+constexpr base::TimeDelta kBatchWindow = base::TimeDelta::FromMilliseconds(10);
+const size_t kMaxBatchSize = 20;
+
+// Cached responses which don't depend on the chain head, such as ENS and
+// Unstoppable Domains records, are reused for kResponseCacheTTL. Block aware
+// ones expire after kBlockAwareResponseTTL, shorter than the ~13 second block
+// time, and are dropped earlier when polling sees a new block.
+const size_t kMaxCachedResponses = 200;
+constexpr base::TimeDelta kResponseCacheTTL = base::TimeDelta::FromMinutes(5);
+constexpr base::TimeDelta kBlockAwareResponseTTL =
+    base::TimeDelta::FromSeconds(10);
+constexpr base::TimeDelta kBlockPollInterval = base::TimeDelta::FromSeconds(15);
+
 std::string GetInfuraProjectID() {
   std::string project_id(BRAVE_INFURA_PROJECT_ID);
   std::unique_ptr<base::Environment> env(base::Environment::Create());
@@ -67,7 +86,8 @@ namespace brave_wallet {
 EthJsonRpcController::EthJsonRpcController(
     Network network,
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
-    : network_(network),
+    : response_cache_(kMaxCachedResponses),
+      network_(network),
       url_loader_factory_(url_loader_factory),
       observers_(new base::ObserverListThreadSafe<
                  BraveWalletProviderEventsObserver>()),
@@ -77,6 +97,11 @@ EthJsonRpcController::EthJsonRpcController(
 
 EthJsonRpcController::~EthJsonRpcController() {}
 
+EthJsonRpcController::CachedResponse::CachedResponse() = default;
+EthJsonRpcController::CachedResponse::CachedResponse(
+    const CachedResponse& other) = default;
+EthJsonRpcController::CachedResponse::~CachedResponse() = default;
+
 void EthJsonRpcController::AddObserver(
     BraveWalletProviderEventsObserver* observer) {
   observers_->AddObserver(observer);
@@ -140,6 +165,220 @@ void EthJsonRpcController::OnURLLoaderComplete(
                           headers);
 }
 
+void EthJsonRpcController::BatchRequest(const std::string& json_payload,
+                                        URLRequestCallback callback) {
+  batch_payloads_.push_back(json_payload);
+  batch_callbacks_.push_back(std::move(callback));
+  if (batch_payloads_.size() >= kMaxBatchSize) {
+    FlushBatch();
+    return;
+  }
+  if (!batch_timer_.IsRunning()) {
+    batch_timer_.Start(FROM_HERE, kBatchWindow, this,
+                       &EthJsonRpcController::FlushBatch);
+  }
+}
+
+void EthJsonRpcController::FlushBatch() {
+  batch_timer_.Stop();
+  if (batch_payloads_.empty())
+    return;
+
+  std::vector<std::string> payloads;
+  std::vector<URLRequestCallback> callbacks;
+  payloads.swap(batch_payloads_);
+  callbacks.swap(batch_callbacks_);
+  if (payloads.size() == 1) {
+    Request(payloads[0], std::move(callbacks[0]), true);
+    return;
+  }
+
+  const std::string batch = GetJsonRpcBatch(payloads);
+  if (batch.empty()) {
+    for (size_t i = 0; i < payloads.size(); i++)
+      Request(payloads[i], std::move(callbacks[i]), true);
+    return;
+  }
+  Request(batch,
+          base::BindOnce(&EthJsonRpcController::OnBatchRequestComplete,
+                         weak_ptr_factory_.GetWeakPtr(), std::move(payloads),
+                         std::move(callbacks)),
+          true);
+}
+
+void EthJsonRpcController::OnBatchRequestComplete(
+    std::vector<std::string> payloads,
+    std::vector<URLRequestCallback> callbacks,
+    const int status,
+    const std::string& body,
+    const std::map<std::string, std::string>& headers) {
+  if (status < 200 || status > 299) {
+    for (auto& callback : callbacks)
+      std::move(callback).Run(status, body, headers);
+    return;
+  }
+
+  std::vector<std::string> responses;
+  if (!ParseJsonRpcBatchResponse(body, callbacks.size(), &responses)) {
+    // The provider doesn't support batches, send the requests one by one.
+    for (size_t i = 0; i < payloads.size(); i++)
+      Request(payloads[i], std::move(callbacks[i]), true);
+    return;
+  }
+
+  for (size_t i = 0; i < callbacks.size(); i++)
+    std::move(callbacks[i]).Run(status, responses[i], headers);
+}
+
+void EthJsonRpcController::CachedProviderRequest(
+    const url::Origin& origin,
+    const std::string& json_payload,
+    URLRequestCallback callback,
+    bool block_aware) {
+  CachedRequestWithKey(GetProviderCacheKeyPrefix(origin) + json_payload,
+                       json_payload, std::move(callback), block_aware);
+}
+
+void EthJsonRpcController::ClearProviderResponses(const url::Origin& origin) {
+  ClearBlockAwareResponses(GetProviderCacheKeyPrefix(origin));
+}
+
+std::string EthJsonRpcController::GetProviderCacheKeyPrefix(
+    const url::Origin& origin) const {
+  return network_url_.spec() + " " + origin.Serialize() + " ";
+}
+
+void EthJsonRpcController::ClearBlockAwareResponses(
+    const std::string& prefix) {
+  for (auto it = response_cache_.begin(); it != response_cache_.end();) {
+    if (it->second.block_aware && base::StartsWith(it->first, prefix))
+      it = response_cache_.Erase(it);
+    else
+      ++it;
+  }
+  // Responses to requests in flight may predate the state change as well.
+  for (const auto& pending : pending_cached_requests_) {
+    if (base::StartsWith(pending.first, prefix))
+      uncacheable_pending_requests_.insert(pending.first);
+  }
+}
+
+void EthJsonRpcController::CachedRequest(const std::string& json_payload,
+                                         URLRequestCallback callback,
+                                         bool block_aware) {
+  CachedRequestWithKey(network_url_.spec() + " " + json_payload, json_payload,
+                       std::move(callback), block_aware);
+}
+
+void EthJsonRpcController::CachedRequestWithKey(
+    const std::string& cache_key,
+    const std::string& json_payload,
+    URLRequestCallback callback,
+    bool block_aware) {
+  auto it = response_cache_.Get(cache_key);
+  if (it != response_cache_.end()) {
+    const CachedResponse& cached = it->second;
+    const base::TimeDelta ttl =
+        cached.block_aware ? kBlockAwareResponseTTL : kResponseCacheTTL;
+    if (base::TimeTicks::Now() - cached.time < ttl) {
+      // Callers expect to be answered asynchronously.
+      base::SequencedTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE,
+          base::BindOnce(std::move(callback), 200, cached.body,
+                         cached.headers));
+      return;
+    }
+    response_cache_.Erase(it);
+  }
+
+  auto& pending_callbacks = pending_cached_requests_[cache_key];
+  pending_callbacks.push_back(std::move(callback));
+  if (pending_callbacks.size() > 1) {
+    // The same request is in flight already.
+    return;
+  }
+
+  auto internal_callback =
+      base::BindOnce(&EthJsonRpcController::OnCachedRequestComplete,
+                     weak_ptr_factory_.GetWeakPtr(), cache_key, block_aware);
+  if (block_aware)
+    BatchRequest(json_payload, std::move(internal_callback));
+  else
+    Request(json_payload, std::move(internal_callback), true);
+}
+
+void EthJsonRpcController::OnCachedRequestComplete(
+    const std::string& cache_key,
+    bool block_aware,
+    const int status,
+    const std::string& body,
+    const std::map<std::string, std::string>& headers) {
+  std::string result;
+  const bool invalidated = uncacheable_pending_requests_.erase(cache_key) > 0;
+  // Skip responses for a network which is no longer selected.
+  if (!invalidated && status >= 200 && status <= 299 &&
+      ParseEthCall(body, &result) &&
+      base::StartsWith(cache_key, network_url_.spec() + " ")) {
+    CachedResponse cached;
+    cached.body = body;
+    cached.headers = headers;
+    cached.time = base::TimeTicks::Now();
+    cached.block_aware = block_aware;
+    response_cache_.Put(cache_key, std::move(cached));
+    if (block_aware && !block_poll_timer_.IsRunning()) {
+      block_poll_timer_.Start(FROM_HERE, kBlockPollInterval, this,
+                              &EthJsonRpcController::PollBlockNumber);
+    }
+  }
+
+  auto pending_it = pending_cached_requests_.find(cache_key);
+  if (pending_it == pending_cached_requests_.end())
+    return;
+  std::vector<URLRequestCallback> callbacks = std::move(pending_it->second);
+  pending_cached_requests_.erase(pending_it);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(status, body, headers);
+}
+
+void EthJsonRpcController::PollBlockNumber() {
+  bool has_block_aware_responses = false;
+  for (const auto& cached : response_cache_) {
+    if (cached.second.block_aware) {
+      has_block_aware_responses = true;
+      break;
+    }
+  }
+  if (!has_block_aware_responses) {
+    block_poll_timer_.Stop();
+    return;
+  }
+
+  BatchRequest(eth_blockNumber(),
+               base::BindOnce(&EthJsonRpcController::OnGetBlockNumber,
+                              weak_ptr_factory_.GetWeakPtr()));
+}
+
+void EthJsonRpcController::OnGetBlockNumber(
+    const int status,
+    const std::string& body,
+    const std::map<std::string, std::string>& headers) {
+  uint256_t block_number;
+  if (status < 200 || status > 299 ||
+      !ParseEthGetBlockNumber(body, &block_number) ||
+      block_number == block_number_) {
+    return;
+  }
+
+  block_number_ = block_number;
+  ClearBlockAwareResponses(network_url_.spec() + " ");
+}
+
+void EthJsonRpcController::ClearResponseCache() {
+  response_cache_.Clear();
+  block_number_ = 0;
+  block_poll_timer_.Stop();
+}
+
 Network EthJsonRpcController::GetNetwork() const {
   return network_;
 }
@@ -149,6 +388,9 @@ GURL EthJsonRpcController::GetNetworkURL() const {
 }
 
 void EthJsonRpcController::SetNetwork(Network network) {
+  // Queued requests were made for the previous network.
+  FlushBatch();
+  ClearResponseCache();
   std::string subdomain;
   network_ = network;
   switch (network) {
@@ -187,6 +429,8 @@ void EthJsonRpcController::SetNetwork(Network network) {
 }
 
 void EthJsonRpcController::SetCustomNetwork(const GURL& network_url) {
+  FlushBatch();
+  ClearResponseCache();
   network_ = Network::kCustom;
   network_url_ = network_url;
 }
@@ -197,8 +441,8 @@ void EthJsonRpcController::GetBalance(
   auto internal_callback =
       base::BindOnce(&EthJsonRpcController::OnGetBalance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  return Request(eth_getBalance(address, "latest"),
-                 std::move(internal_callback), true);
+  CachedRequest(eth_getBalance(address, "latest"), std::move(internal_callback),
+                true);
 }
 
 void EthJsonRpcController::OnGetBalance(
@@ -224,8 +468,8 @@ void EthJsonRpcController::GetTransactionCount(const std::string& address,
   auto internal_callback =
       base::BindOnce(&EthJsonRpcController::OnGetTransactionCount,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  return Request(eth_getTransactionCount(address, "latest"),
-                 std::move(internal_callback), true);
+  BatchRequest(eth_getTransactionCount(address, "latest"),
+               std::move(internal_callback));
 }
 
 void EthJsonRpcController::OnGetTransactionCount(
@@ -252,8 +496,8 @@ void EthJsonRpcController::GetTransactionReceipt(
   auto internal_callback =
       base::BindOnce(&EthJsonRpcController::OnGetTransactionReceipt,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  return Request(eth_getTransactionReceipt(tx_hash),
-                 std::move(internal_callback), true);
+  BatchRequest(eth_getTransactionReceipt(tx_hash),
+               std::move(internal_callback));
 }
 
 void EthJsonRpcController::OnGetTransactionReceipt(
@@ -279,6 +523,8 @@ void EthJsonRpcController::SendRawTransaction(const std::string& signed_tx,
   auto internal_callback =
       base::BindOnce(&EthJsonRpcController::OnSendRawTransaction,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
+  // Balances and nonces read so far are about to change.
+  ClearBlockAwareResponses(network_url_.spec() + " ");
   return Request(eth_sendRawTransaction(signed_tx),
                  std::move(internal_callback), true);
 }
@@ -312,8 +558,8 @@ bool EthJsonRpcController::GetERC20TokenBalance(
   if (!erc20::BalanceOf(address, &data)) {
     return false;
   }
-  Request(eth_call("", address, "", "", "", data, ""),
-          std::move(internal_callback), true);
+  CachedRequest(eth_call("", address, "", "", "", data, ""),
+                std::move(internal_callback), true);
   return true;
 }
 
@@ -347,8 +593,8 @@ bool EthJsonRpcController::EnsProxyReaderResolveAddress(
     return false;
   }
 
-  Request(eth_call("", contract_address, "", "", "", data, "latest"),
-          std::move(internal_callback), true);
+  CachedRequest(eth_call("", contract_address, "", "", "", data, "latest"),
+                std::move(internal_callback), false);
   return true;
 }
 
@@ -383,8 +629,8 @@ bool EthJsonRpcController::UnstoppableDomainsProxyReaderGetMany(
     return false;
   }
 
-  Request(eth_call("", contract_address, "", "", "", data, "latest"),
-          std::move(internal_callback), true);
+  CachedRequest(eth_call("", contract_address, "", "", "", data, "latest"),
+                std::move(internal_callback), false);
   return true;
 }
 
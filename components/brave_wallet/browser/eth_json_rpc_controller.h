@@ -9,17 +9,24 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "base/callback.h"
+#include "base/containers/mru_cache.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list_threadsafe.h"
+#include "base/timer/timer.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_provider_events_observer.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_types.h"
 #include "url/gurl.h"
 
+namespace url {
+class Origin;
+}  // namespace url
+
 namespace network {
 class SharedURLLoaderFactory;
 class SimpleURLLoader;
@@ -45,6 +52,20 @@ class EthJsonRpcController {
       base::OnceCallback<void(bool status, const std::string& balance)>;
   void GetBalance(const std::string& address, GetBallanceCallback callback);
 
+  // Sends a read-only JSON-RPC request made by a page of |origin|. Responses
+  // are cached and in-flight requests are shared like for |CachedRequest|,
+  // but only with other frames of the same origin, so that pages can't learn
+  // what other sites asked for. |json_payload| should have a fixed id, as it
+  // is part of the cache key.
+  void CachedProviderRequest(const url::Origin& origin,
+                             const std::string& json_payload,
+                             URLRequestCallback callback,
+                             bool block_aware);
+  // Drops the block aware responses cached for |origin|, and keeps its
+  // requests in flight from being cached, as sending or signing a
+  // transaction changes the state they were read from.
+  void ClearProviderResponses(const url::Origin& origin);
+
   using GetTxCountCallback =
       base::OnceCallback<void(bool status, uint256_t result)>;
   void GetTransactionCount(const std::string& address,
@@ -100,6 +121,43 @@ class EthJsonRpcController {
   void OnURLLoaderComplete(SimpleURLLoaderList::iterator iter,
                            URLRequestCallback callback,
                            const std::unique_ptr<std::string> response_body);
+  // Queues a read-only request. Requests queued within a short window are
+  // sent as one JSON-RPC batch.
+  void BatchRequest(const std::string& json_payload,
+                    URLRequestCallback callback);
+  void FlushBatch();
+  void OnBatchRequestComplete(
+      std::vector<std::string> payloads,
+      std::vector<URLRequestCallback> callbacks,
+      const int status,
+      const std::string& body,
+      const std::map<std::string, std::string>& headers);
+  // Sends a read-only request whose result is a single string, answering it
+  // from |response_cache_| when possible. |block_aware| results expire within
+  // a block time and are batched with other requests, the others expire after
+  // a few minutes.
+  void CachedRequest(const std::string& json_payload,
+                     URLRequestCallback callback,
+                     bool block_aware);
+  void CachedRequestWithKey(const std::string& cache_key,
+                            const std::string& json_payload,
+                            URLRequestCallback callback,
+                            bool block_aware);
+  std::string GetProviderCacheKeyPrefix(const url::Origin& origin) const;
+  // Drops the block aware responses whose key starts with |prefix|, and
+  // keeps requests in flight with such a key from being cached.
+  void ClearBlockAwareResponses(const std::string& prefix);
+  void OnCachedRequestComplete(
+      const std::string& cache_key,
+      bool block_aware,
+      const int status,
+      const std::string& body,
+      const std::map<std::string, std::string>& headers);
+  void PollBlockNumber();
+  void OnGetBlockNumber(const int status,
+                        const std::string& body,
+                        const std::map<std::string, std::string>& headers);
+  void ClearResponseCache();
   void OnGetBalance(GetBallanceCallback callback,
                     const int status,
                     const std::string& body,
@@ -137,6 +195,30 @@ class EthJsonRpcController {
 
   GURL network_url_;
   SimpleURLLoaderList url_loaders_;
+  std::vector<std::string> batch_payloads_;
+  std::vector<URLRequestCallback> batch_callbacks_;
+  base::OneShotTimer batch_timer_;
+
+  struct CachedResponse {
+    CachedResponse();
+    CachedResponse(const CachedResponse& other);
+    ~CachedResponse();
+
+    std::string body;
+    std::map<std::string, std::string> headers;
+    base::TimeTicks time;
+    bool block_aware = false;
+  };
+  // Keyed by network URL and request payload.
+  base::MRUCache<std::string, CachedResponse> response_cache_;
+  // Callbacks of requests waiting for the same in-flight response, keyed like
+  // |response_cache_|.
+  std::map<std::string, std::vector<URLRequestCallback>>
+      pending_cached_requests_;
+  // Keys of |pending_cached_requests_| whose responses must not be cached.
+  std::set<std::string> uncacheable_pending_requests_;
+  uint256_t block_number_ = 0;
+  base::RepeatingTimer block_poll_timer_;
   Network network_;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   scoped_refptr<base::ObserverListThreadSafe<BraveWalletProviderEventsObserver>>
@@ -3,28 +3,66 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "base/json/json_reader.h"
+#include "base/test/bind.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/eth_json_rpc_controller.h"
 #include "content/public/browser/storage_partition.h"
 #include "content/public/test/browser_task_environment.h"
 #include "content/public/test/test_browser_context.h"
-#include "services/network/test/test_shared_url_loader_factory.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "services/network/test/test_utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "url/gurl.h"
+#include "url/origin.h"
 
 namespace brave_wallet {
 
+namespace {
+
+const char kAddress[] = "0x2f015c60e0be116b1f0cd534704db9c92118fb6a";
+
+const char kGetBalance[] =
+    R"({"id":1,"jsonrpc":"2.0","method":"eth_getBalance",)"
+    R"("params":["0x2f015c60e0be116b1f0cd534704db9c92118fb6a","latest"]})";
+const char kChainId[] =
+    R"({"id":1,"jsonrpc":"2.0","method":"eth_chainId","params":[]})";
+
+// Returns the method of a single JSON-RPC request, or of each request of a
+// batch.
+std::vector<std::string> GetMethods(const std::string& json) {
+  std::vector<std::string> methods;
+  base::Optional<base::Value> value = base::JSONReader::Read(json);
+  if (!value)
+    return methods;
+  if (value->is_dict()) {
+    const std::string* method = value->FindStringKey("method");
+    methods.push_back(method ? *method : "");
+    return methods;
+  }
+  for (const auto& request : value->GetList()) {
+    const std::string* method = request.FindStringKey("method");
+    methods.push_back(method ? *method : "");
+  }
+  return methods;
+}
+
+}  // namespace
+
 class EthJsonRpcControllerUnitTest : public testing::Test {
  public:
   EthJsonRpcControllerUnitTest()
-      : browser_context_(new content::TestBrowserContext()) {
-    shared_url_loader_factory_ =
-        base::MakeRefCounted<network::TestSharedURLLoaderFactory>(
-            nullptr /* network_service */, true /* is_trusted */);
-  }
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        browser_context_(new content::TestBrowserContext()),
+        shared_url_loader_factory_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)) {}
   ~EthJsonRpcControllerUnitTest() override = default;
 
   network::SharedURLLoaderFactory* shared_url_loader_factory() {
@@ -33,10 +71,58 @@ class EthJsonRpcControllerUnitTest : public testing::Test {
 
   content::TestBrowserContext* context() { return browser_context_.get(); }
 
+  // Answers every request with the response |respond| returns for its upload
+  // body, and records the uploaded bodies.
+  void SetInterceptor(
+      const GURL& url,
+      base::RepeatingCallback<std::string(const std::string&)> respond) {
+    url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [this, url, respond](const network::ResourceRequest& request) {
+          const std::string body = network::GetUploadData(request);
+          request_bodies_.push_back(body);
+          url_loader_factory_.ClearResponses();
+          url_loader_factory_.AddResponse(url.spec(), respond.Run(body));
+        }));
+  }
+
+  const std::vector<std::string>& request_bodies() const {
+    return request_bodies_;
+  }
+
+  // Sends a provider request for |origin| and counts the responses in
+  // |responses|.
+  void ProviderRequest(EthJsonRpcController* controller,
+                       const url::Origin& origin,
+                       const std::string& json_payload,
+                       bool block_aware,
+                       int* responses) {
+    controller->CachedProviderRequest(
+        origin, json_payload,
+        base::BindLambdaForTesting(
+            [responses](const int status, const std::string& body,
+                        const std::map<std::string, std::string>& headers) {
+              EXPECT_EQ(200, status);
+              ++*responses;
+            }),
+        block_aware);
+  }
+
+  void FastForwardBy(base::TimeDelta delta) {
+    task_environment_.FastForwardBy(delta);
+  }
+
+  // Runs the batch timer and all requests it sends.
+  void RunBatch() {
+    task_environment_.FastForwardBy(base::TimeDelta::FromMilliseconds(10));
+    task_environment_.RunUntilIdle();
+  }
+
  private:
-  scoped_refptr<network::TestSharedURLLoaderFactory> shared_url_loader_factory_;
   content::BrowserTaskEnvironment task_environment_;
   std::unique_ptr<content::TestBrowserContext> browser_context_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  std::vector<std::string> request_bodies_;
 };
 
 TEST_F(EthJsonRpcControllerUnitTest, SetNetwork) {
@@ -85,4 +171,242 @@ TEST_F(EthJsonRpcControllerUnitTest, SetCustomNetwork) {
   ASSERT_EQ(controller.GetNetworkURL(), custom_network);
 }
 
+TEST_F(EthJsonRpcControllerUnitTest, BatchesReadOnlyRequests) {
+  EthJsonRpcController controller(Network::kMainnet,
+                                  shared_url_loader_factory());
+  SetInterceptor(controller.GetNetworkURL(),
+                 base::BindRepeating([](const std::string& body) {
+                   // Answered out of order, the ids identify the requests.
+                   return std::string(
+                       R"([{"jsonrpc":"2.0","id":1,"result":"0x5"},)"
+                       R"({"jsonrpc":"2.0","id":0,)"
+                       R"("result":"0xde0b6b3a7640000"}])");
+                 }));
+
+  bool balance_called = false;
+  controller.GetBalance(kAddress, base::BindLambdaForTesting(
+                                      [&](bool status,
+                                          const std::string& balance) {
+                                        EXPECT_TRUE(status);
+                                        EXPECT_EQ("0xde0b6b3a7640000", balance);
+                                        balance_called = true;
+                                      }));
+  bool count_called = false;
+  controller.GetTransactionCount(
+      kAddress, base::BindLambdaForTesting([&](bool status, uint256_t count) {
+        EXPECT_TRUE(status);
+        EXPECT_EQ(uint256_t(5), count);
+        count_called = true;
+      }));
+  EXPECT_TRUE(request_bodies().empty());
+
+  RunBatch();
+
+  ASSERT_EQ(1u, request_bodies().size());
+  EXPECT_EQ(std::vector<std::string>(
+                {"eth_getBalance", "eth_getTransactionCount"}),
+            GetMethods(request_bodies()[0]));
+  EXPECT_TRUE(balance_called);
+  EXPECT_TRUE(count_called);
+}
+
+TEST_F(EthJsonRpcControllerUnitTest, SendsSingleRequestUnbatched) {
+  EthJsonRpcController controller(Network::kMainnet,
+                                  shared_url_loader_factory());
+  SetInterceptor(controller.GetNetworkURL(),
+                 base::BindRepeating([](const std::string& body) {
+                   return std::string(
+                       R"({"jsonrpc":"2.0","id":1,"result":"0x5"})");
+                 }));
+
+  bool count_called = false;
+  controller.GetTransactionCount(
+      kAddress, base::BindLambdaForTesting([&](bool status, uint256_t count) {
+        EXPECT_TRUE(status);
+        EXPECT_EQ(uint256_t(5), count);
+        count_called = true;
+      }));
+
+  RunBatch();
+
+  ASSERT_EQ(1u, request_bodies().size());
+  EXPECT_EQ(std::vector<std::string>({"eth_getTransactionCount"}),
+            GetMethods(request_bodies()[0]));
+  base::Optional<base::Value> request =
+      base::JSONReader::Read(request_bodies()[0]);
+  ASSERT_TRUE(request);
+  EXPECT_TRUE(request->is_dict());
+  EXPECT_TRUE(count_called);
+}
+
+TEST_F(EthJsonRpcControllerUnitTest, FallsBackToUnbatchedRequests) {
+  EthJsonRpcController controller(Network::kMainnet,
+                                  shared_url_loader_factory());
+  SetInterceptor(
+      controller.GetNetworkURL(),
+      base::BindRepeating([](const std::string& body) {
+        const std::vector<std::string> methods = GetMethods(body);
+        // The provider doesn't support batches.
+        if (methods.size() != 1u || body[0] == '[') {
+          return std::string(
+              R"({"jsonrpc":"2.0","id":null,)"
+              R"("error":{"code":-32600,"message":"Invalid request"}})");
+        }
+        if (methods[0] == "eth_getBalance") {
+          return std::string(
+              R"({"jsonrpc":"2.0","id":1,"result":"0xde0b6b3a7640000"})");
+        }
+        return std::string(R"({"jsonrpc":"2.0","id":1,"result":"0x5"})");
+      }));
+
+  bool balance_called = false;
+  controller.GetBalance(kAddress, base::BindLambdaForTesting(
+                                      [&](bool status,
+                                          const std::string& balance) {
+                                        EXPECT_TRUE(status);
+                                        EXPECT_EQ("0xde0b6b3a7640000", balance);
+                                        balance_called = true;
+                                      }));
+  bool count_called = false;
+  controller.GetTransactionCount(
+      kAddress, base::BindLambdaForTesting([&](bool status, uint256_t count) {
+        EXPECT_TRUE(status);
+        EXPECT_EQ(uint256_t(5), count);
+        count_called = true;
+      }));
+
+  RunBatch();
+
+  // The batch, then each request on its own.
+  ASSERT_EQ(3u, request_bodies().size());
+  EXPECT_EQ(std::vector<std::string>(
+                {"eth_getBalance", "eth_getTransactionCount"}),
+            GetMethods(request_bodies()[0]));
+  EXPECT_EQ(std::vector<std::string>({"eth_getBalance"}),
+            GetMethods(request_bodies()[1]));
+  EXPECT_EQ(std::vector<std::string>({"eth_getTransactionCount"}),
+            GetMethods(request_bodies()[2]));
+  EXPECT_TRUE(balance_called);
+  EXPECT_TRUE(count_called);
+}
+
+TEST_F(EthJsonRpcControllerUnitTest, SharesInFlightProviderRequests) {
+  EthJsonRpcController controller(Network::kMainnet,
+                                  shared_url_loader_factory());
+  SetInterceptor(controller.GetNetworkURL(),
+                 base::BindRepeating([](const std::string& body) {
+                   return std::string(
+                       R"({"jsonrpc":"2.0","id":1,"result":"0x5"})");
+                 }));
+  const url::Origin origin = url::Origin::Create(GURL("https://a.test"));
+
+  int responses = 0;
+  ProviderRequest(&controller, origin, kGetBalance, true, &responses);
+  ProviderRequest(&controller, origin, kGetBalance, true, &responses);
+  RunBatch();
+
+  EXPECT_EQ(1u, request_bodies().size());
+  EXPECT_EQ(2, responses);
+
+  // Answered from the cache.
+  ProviderRequest(&controller, origin, kGetBalance, true, &responses);
+  RunBatch();
+
+  EXPECT_EQ(1u, request_bodies().size());
+  EXPECT_EQ(3, responses);
+}
+
+TEST_F(EthJsonRpcControllerUnitTest, PartitionsProviderRequestsByOrigin) {
+  EthJsonRpcController controller(Network::kMainnet,
+                                  shared_url_loader_factory());
+  SetInterceptor(controller.GetNetworkURL(),
+                 base::BindRepeating([](const std::string& body) {
+                   return std::string(
+                       R"({"jsonrpc":"2.0","id":1,"result":"0x1"})");
+                 }));
+  const url::Origin origin = url::Origin::Create(GURL("https://a.test"));
+  const url::Origin other_origin = url::Origin::Create(GURL("https://b.test"));
+
+  int responses = 0;
+  ProviderRequest(&controller, origin, kChainId, false, &responses);
+  RunBatch();
+  ProviderRequest(&controller, other_origin, kChainId, false, &responses);
+  RunBatch();
+
+  EXPECT_EQ(2u, request_bodies().size());
+  EXPECT_EQ(2, responses);
+
+  ProviderRequest(&controller, origin, kChainId, false, &responses);
+  ProviderRequest(&controller, other_origin, kChainId, false, &responses);
+  RunBatch();
+
+  EXPECT_EQ(2u, request_bodies().size());
+  EXPECT_EQ(4, responses);
+}
+
+TEST_F(EthJsonRpcControllerUnitTest, ClearsProviderResponsesOfOrigin) {
+  EthJsonRpcController controller(Network::kMainnet,
+                                  shared_url_loader_factory());
+  SetInterceptor(controller.GetNetworkURL(),
+                 base::BindRepeating([](const std::string& body) {
+                   return std::string(
+                       R"({"jsonrpc":"2.0","id":1,"result":"0x5"})");
+                 }));
+  const url::Origin origin = url::Origin::Create(GURL("https://a.test"));
+  const url::Origin other_origin = url::Origin::Create(GURL("https://b.test"));
+
+  int responses = 0;
+  ProviderRequest(&controller, origin, kGetBalance, true, &responses);
+  RunBatch();
+  ProviderRequest(&controller, other_origin, kGetBalance, true, &responses);
+  RunBatch();
+  ASSERT_EQ(2u, request_bodies().size());
+
+  controller.ClearProviderResponses(origin);
+
+  // Only the origin which sent a transaction reads its balance again.
+  ProviderRequest(&controller, origin, kGetBalance, true, &responses);
+  ProviderRequest(&controller, other_origin, kGetBalance, true, &responses);
+  RunBatch();
+  EXPECT_EQ(3u, request_bodies().size());
+
+  // Answered from the cache.
+  ProviderRequest(&controller, origin, kGetBalance, true, &responses);
+  RunBatch();
+  EXPECT_EQ(3u, request_bodies().size());
+
+  // A response to a request in flight while clearing isn't cached.
+  controller.ClearProviderResponses(origin);
+  ProviderRequest(&controller, origin, kGetBalance, true, &responses);
+  controller.ClearProviderResponses(origin);
+  RunBatch();
+  ProviderRequest(&controller, origin, kGetBalance, true, &responses);
+  RunBatch();
+  EXPECT_EQ(5u, request_bodies().size());
+  EXPECT_EQ(7, responses);
+}
+
+TEST_F(EthJsonRpcControllerUnitTest, ExpiresBlockAwareProviderResponses) {
+  EthJsonRpcController controller(Network::kMainnet,
+                                  shared_url_loader_factory());
+  SetInterceptor(controller.GetNetworkURL(),
+                 base::BindRepeating([](const std::string& body) {
+                   return std::string(
+                       R"({"jsonrpc":"2.0","id":1,"result":"0x5"})");
+                 }));
+  const url::Origin origin = url::Origin::Create(GURL("https://a.test"));
+
+  int responses = 0;
+  ProviderRequest(&controller, origin, kGetBalance, true, &responses);
+  RunBatch();
+  ASSERT_EQ(1u, request_bodies().size());
+
+  // Shorter than a block.
+  FastForwardBy(base::TimeDelta::FromSeconds(10));
+  ProviderRequest(&controller, origin, kGetBalance, true, &responses);
+  RunBatch();
+  EXPECT_EQ(2u, request_bodies().size());
+  EXPECT_EQ(2, responses);
+}
+
 }  // namespace brave_wallet
@@ -7,6 +7,8 @@
 
 #include <utility>
 
+#include "base/check.h"
+#include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 
@@ -390,4 +392,59 @@ std::string eth_getLogs(const std::string& from_block_quantity_tag,
   return GetJSON(dictionary);
 }
 
+std::string GetJsonRpcBatch(const std::vector<std::string>& requests) {
+  base::Value batch(base::Value::Type::LIST);
+  for (size_t i = 0; i < requests.size(); i++) {
+    base::Optional<base::Value> request = base::JSONReader::Read(
+        requests[i], base::JSONParserOptions::JSON_PARSE_RFC);
+    if (!request || !request->is_dict())
+      return std::string();
+    request->SetKey("id", base::Value(static_cast<int>(i)));
+    batch.Append(std::move(*request));
+  }
+  return GetJSON(batch);
+}
+
+bool GetJsonRpcMethodAndId(const std::string& json,
+                           std::string* method,
+                           base::Value* id) {
+  DCHECK(method);
+  DCHECK(id);
+  base::Optional<base::Value> request =
+      base::JSONReader::Read(json, base::JSONParserOptions::JSON_PARSE_RFC);
+  if (!request || !request->is_dict())
+    return false;
+  const std::string* request_method = request->FindStringKey("method");
+  if (!request_method)
+    return false;
+  *method = *request_method;
+  const base::Value* request_id = request->FindKey("id");
+  *id = request_id ? request_id->Clone() : base::Value();
+  return true;
+}
+
+std::string SetJsonRpcId(const std::string& json, const base::Value& id) {
+  base::Optional<base::Value> message =
+      base::JSONReader::Read(json, base::JSONParserOptions::JSON_PARSE_RFC);
+  if (!message || !message->is_dict())
+    return std::string();
+  message->SetKey("id", id.Clone());
+  return GetJSON(*message);
+}
+
+bool IsPendingBlockRequest(const std::string& json) {
+  base::Optional<base::Value> request =
+      base::JSONReader::Read(json, base::JSONParserOptions::JSON_PARSE_RFC);
+  if (!request || !request->is_dict())
+    return false;
+  const base::Value* params = request->FindListKey("params");
+  if (!params)
+    return false;
+  for (const auto& param : params->GetList()) {
+    if (param.is_string() && param.GetString() == "pending")
+      return true;
+  }
+  return false;
+}
+
 }  // namespace brave_wallet
@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_REQUESTS_H_
 
 #include <string>
+#include <vector>
 #include "base/values.h"
 
 namespace brave_wallet {
@@ -184,6 +185,26 @@ std::string eth_getLogs(const std::string& from_block_quantity_tag,
 // condition to be met (“target”).
 std::string eth_getWork();
 
+// Combines single JSON-RPC requests into one batch array. Each request gets
+// its index in |requests| as id, so that responses can be matched with
+// ParseJsonRpcBatchResponse. Returns an empty string if a request is not a
+// valid JSON-RPC object.
+std::string GetJsonRpcBatch(const std::vector<std::string>& requests);
+
+// Reads the method and the id of a single JSON-RPC request. Returns false if
+// |json| is not a JSON-RPC object with a method.
+bool GetJsonRpcMethodAndId(const std::string& json,
+                           std::string* method,
+                           base::Value* id);
+
+// Returns the JSON-RPC request or response |json| with its id replaced by
+// |id|, or an empty string if |json| is not a JSON-RPC object.
+std::string SetJsonRpcId(const std::string& json, const base::Value& id);
+
+// Returns true if a param of the JSON-RPC request |json| is the "pending"
+// block tag, whose results change with the mempool rather than per block.
+bool IsPendingBlockRequest(const std::string& json);
+
 }  // namespace brave_wallet
 
 #endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_REQUESTS_H_
@@ -328,4 +328,49 @@ TEST(EthRequestUnitTest, eth_getLogs) {
       R"({"id":1,"jsonrpc":"2.0","method":"eth_getLogs","params":[{"address":"0x8888f1f195afa192cfee860698584c030f4c9db1","blockhash":"0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238","fromBlock":"0x1","toBlock":"0x2","topics":["0x000000000000000000000000a94f5374fce5edbc8e2a8697c15331677e6ebf0b",["0x000000000000000000000000a94f5374fce5edbc8e2a8697c15331677e6ebf0b","0x0000000000000000000000000aff3454fce5edbc8cca8697c15331677e6ebccc"]]}]})");  // NOLINT
 }
 
+TEST(EthRequestUnitTest, GetJsonRpcBatch) {
+  ASSERT_EQ(
+      GetJsonRpcBatch({eth_blockNumber(), eth_gasPrice()}),
+      R"([{"id":0,"jsonrpc":"2.0","method":"eth_blockNumber","params":[]},{"id":1,"jsonrpc":"2.0","method":"eth_gasPrice","params":[]}])");  // NOLINT
+  ASSERT_EQ(GetJsonRpcBatch({eth_blockNumber(), "[]"}), "");
+  ASSERT_EQ(GetJsonRpcBatch({}), "[]");
+}
+
+TEST(EthRequestUnitTest, GetJsonRpcMethodAndId) {
+  std::string method;
+  base::Value id;
+  ASSERT_TRUE(GetJsonRpcMethodAndId(
+      R"({"id":"abc","jsonrpc":"2.0","method":"eth_chainId","params":[]})",
+      &method, &id));
+  ASSERT_EQ(method, "eth_chainId");
+  ASSERT_EQ(id, base::Value("abc"));
+
+  ASSERT_TRUE(GetJsonRpcMethodAndId(eth_blockNumber(), &method, &id));
+  ASSERT_EQ(method, "eth_blockNumber");
+  ASSERT_EQ(id, base::Value(1));
+
+  ASSERT_FALSE(GetJsonRpcMethodAndId(R"({"id":1})", &method, &id));
+  ASSERT_FALSE(GetJsonRpcMethodAndId("[]", &method, &id));
+}
+
+TEST(EthRequestUnitTest, SetJsonRpcId) {
+  ASSERT_EQ(SetJsonRpcId(R"({"id":7,"jsonrpc":"2.0","result":"0x1"})",
+                         base::Value("abc")),
+            R"({"id":"abc","jsonrpc":"2.0","result":"0x1"})");
+  ASSERT_EQ(SetJsonRpcId(eth_blockNumber(), base::Value(42)),
+            R"({"id":42,"jsonrpc":"2.0","method":"eth_blockNumber","params":[]})");  // NOLINT
+  ASSERT_EQ(SetJsonRpcId("[]", base::Value(1)), "");
+}
+
+TEST(EthRequestUnitTest, IsPendingBlockRequest) {
+  ASSERT_TRUE(IsPendingBlockRequest(
+      eth_getTransactionCount("0x407d73d8a49eeb85d32cf465507dd71d507100c1",
+                              "pending")));
+  ASSERT_FALSE(IsPendingBlockRequest(
+      eth_getTransactionCount("0x407d73d8a49eeb85d32cf465507dd71d507100c1",
+                              "latest")));
+  ASSERT_FALSE(IsPendingBlockRequest(eth_blockNumber()));
+  ASSERT_FALSE(IsPendingBlockRequest("[]"));
+}
+
 }  // namespace brave_wallet
@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
 #include "base/logging.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 
@@ -153,4 +154,34 @@ bool ParseEthCall(const std::string& json, std::string* result) {
   return ParseSingleStringResult(json, result);
 }
 
+bool ParseEthGetBlockNumber(const std::string& json, uint256_t* block_number) {
+  std::string block_number_str;
+  if (!ParseSingleStringResult(json, &block_number_str))
+    return false;
+
+  return HexValueToUint256(block_number_str, block_number);
+}
+
+bool ParseJsonRpcBatchResponse(const std::string& json,
+                               size_t count,
+                               std::vector<std::string>* responses) {
+  DCHECK(responses);
+  base::Optional<base::Value> records_v =
+      base::JSONReader::Read(json, base::JSONParserOptions::JSON_PARSE_RFC);
+  if (!records_v || !records_v->is_list())
+    return false;
+
+  responses->assign(count, std::string());
+  for (const auto& response : records_v->GetList()) {
+    if (!response.is_dict())
+      continue;
+    base::Optional<int> id = response.FindIntKey("id");
+    if (!id || *id < 0 || static_cast<size_t>(*id) >= count)
+      continue;
+    base::JSONWriter::Write(response, &(*responses)[*id]);
+  }
+
+  return true;
+}
+
 }  // namespace brave_wallet
@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_RESPONSE_PARSER_H_
 
 #include <string>
+#include <vector>
 #include "base/values.h"
 
 #include "brave/components/brave_wallet/browser/brave_wallet_types.h"
@@ -20,6 +21,15 @@ bool ParseEthGetTransactionReceipt(const std::string& json,
                                    TransactionReceipt* receipt);
 bool ParseEthSendRawTransaction(const std::string& json, std::string* tx_hash);
 bool ParseEthCall(const std::string& json, std::string* result);
+bool ParseEthGetBlockNumber(const std::string& json, uint256_t* block_number);
+
+// Splits the response to a batch built by GetJsonRpcBatch into |count|
+// single JSON-RPC responses, ordered by request id. Responses missing from
+// the batch are left empty. Returns false if |json| is not a batch response,
+// e.g. when the provider does not support batching.
+bool ParseJsonRpcBatchResponse(const std::string& json,
+                               size_t count,
+                               std::vector<std::string>* responses);
 
 }  // namespace brave_wallet
 
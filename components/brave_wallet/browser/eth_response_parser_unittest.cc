@@ -91,4 +91,39 @@ TEST(EthResponseParserUnitTest, ParseEthGetTransactionReceipt) {
   EXPECT_TRUE(receipt.status);
 }
 
+TEST(EthResponseParserUnitTest, ParseEthGetBlockNumber) {
+  uint256_t block_number;
+  ASSERT_TRUE(ParseEthGetBlockNumber(
+      R"({"id":1,"jsonrpc":"2.0","result":"0x4b7"})", &block_number));
+  EXPECT_EQ(block_number, (uint256_t)1207);
+  EXPECT_FALSE(ParseEthGetBlockNumber(
+      R"({"id":1,"jsonrpc":"2.0","result":"block"})", &block_number));
+}
+
+TEST(EthResponseParserUnitTest, ParseJsonRpcBatchResponse) {
+  // Providers may answer batch entries in any order.
+  std::string json(R"([
+      {"id": 1, "jsonrpc": "2.0", "result": "0xb539d5"},
+      {"id": 0, "jsonrpc": "2.0", "result": "0x0"},
+      {"id": 7, "jsonrpc": "2.0", "result": "0x1"}
+    ])");
+  std::vector<std::string> responses;
+  ASSERT_TRUE(ParseJsonRpcBatchResponse(json, 3, &responses));
+  ASSERT_EQ(responses.size(), 3u);
+
+  std::string balance;
+  ASSERT_TRUE(ParseEthGetBalance(responses[0], &balance));
+  EXPECT_EQ(balance, "0x0");
+  ASSERT_TRUE(ParseEthGetBalance(responses[1], &balance));
+  EXPECT_EQ(balance, "0xb539d5");
+  EXPECT_TRUE(responses[2].empty());
+  EXPECT_FALSE(ParseEthGetBalance(responses[2], &balance));
+
+  // Not a batch response.
+  EXPECT_FALSE(ParseJsonRpcBatchResponse(
+      R"({"id": 0, "jsonrpc": "2.0", "error": {"code": -32600}})", 2,
+      &responses));
+  EXPECT_FALSE(ParseJsonRpcBatchResponse("invalid", 2, &responses));
+}
+
 }  // namespace brave_wallet
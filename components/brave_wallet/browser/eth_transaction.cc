@@ -43,8 +43,9 @@ std::vector<uint8_t> EthTransaction::GetMessageToSign(uint64_t chain_id) const {
     list.Append(RLPUint256ToBlobValue(0));
   }
 
-  const std::string message = RLPEncode(std::move(list));
-  return KeccakHash(std::vector<uint8_t>(message.begin(), message.end()));
+  std::vector<uint8_t> message(RLPEncodedSize(list));
+  RLPEncodeTo(list, message);
+  return KeccakHash(message);
 }
 
 std::string EthTransaction::GetSignedTransaction() const {
@@ -5,6 +5,9 @@
 
 #include "brave/components/brave_wallet/browser/hd_keyring.h"
 
+#include <utility>
+
+#include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_address.h"
@@ -27,6 +30,7 @@ void HDKeyring::ClearData() {
   root_.reset();
   master_key_.reset();
   accounts_.clear();
+  addresses_.clear();
 }
 
 void HDKeyring::ConstructRootHDKey(const std::vector<uint8_t>& seed,
@@ -48,6 +52,14 @@ void HDKeyring::AddAccounts(size_t number) {
   }
 }
 
+void HDKeyring::RestoreAccounts(const std::vector<std::string>& addresses) {
+  if (!root_)
+    return;
+  accounts_.clear();
+  accounts_.resize(addresses.size());
+  addresses_ = addresses;
+}
+
 std::vector<std::string> HDKeyring::GetAccounts() {
   std::vector<std::string> addresses;
   for (size_t i = 0; i < accounts_.size(); ++i) {
@@ -60,6 +72,7 @@ void HDKeyring::RemoveAccount(const std::string& address) {
   for (size_t i = 0; i < accounts_.size(); ++i) {
     if (GetAddress(i) == address) {
       accounts_.erase(accounts_.begin() + i);
+      addresses_.erase(addresses_.begin() + i);
     }
   }
 }
@@ -67,6 +80,13 @@ void HDKeyring::RemoveAccount(const std::string& address) {
 std::string HDKeyring::GetAddress(size_t index) {
   if (accounts_.empty() || index >= accounts_.size())
     return std::string();
+  if (addresses_.size() < accounts_.size())
+    addresses_.resize(accounts_.size());
+  if (!addresses_[index].empty())
+    return addresses_[index];
+  if (!accounts_[index])
+    return std::string();
+
   const std::vector<uint8_t> public_key =
       accounts_[index]->GetUncompressedPublicKey();
   // trim the header byte 0x04
@@ -75,7 +95,8 @@ std::string HDKeyring::GetAddress(size_t index) {
   EthAddress addr = EthAddress::FromPublicKey(pubkey_no_header);
 
   // TODO(darkdh): chain id
-  return addr.ToChecksumAddress();
+  addresses_[index] = addr.ToChecksumAddress();
+  return addresses_[index];
 }
 
 void HDKeyring::SignTransaction(const std::string& address,
@@ -110,8 +131,24 @@ std::vector<uint8_t> HDKeyring::SignMessage(
 
 HDKey* HDKeyring::GetHDKeyFromAddress(const std::string& address) {
   for (size_t i = 0; i < accounts_.size(); ++i) {
-    if (GetAddress(i) == address)
-      return accounts_[i].get();
+    if (GetAddress(i) != address)
+      continue;
+    if (!accounts_[i] && root_) {
+      // Derive restored accounts lazily and make sure the key still matches
+      // the cached address before signing with it
+      std::unique_ptr<HDKey> key = root_->DeriveChild(i);
+      if (!key)
+        return nullptr;
+      accounts_[i] = std::move(key);
+      addresses_[i].clear();
+      if (GetAddress(i) != address) {
+        LOG(ERROR) << __func__ << ": Restored address doesn't match key";
+        accounts_[i].reset();
+        addresses_[i] = address;
+        return nullptr;
+      }
+    }
+    return accounts_[i].get();
   }
   return nullptr;
 }
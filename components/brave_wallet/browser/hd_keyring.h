@@ -20,6 +20,7 @@ class EthTransaction;
 
 FORWARD_DECLARE_TEST(HDKeyringUnitTest, ConstructRootHDKey);
 FORWARD_DECLARE_TEST(HDKeyringUnitTest, SignMessage);
+FORWARD_DECLARE_TEST(HDKeyringUnitTest, RestoreAccounts);
 class HDKeyring {
  public:
   enum Type { kDefault = 0, kLedger, kTrezor, kBitcoin };
@@ -34,6 +35,9 @@ class HDKeyring {
                                   const std::string& hd_path);
 
   virtual void AddAccounts(size_t number = 1);
+  // Restores accounts from previously derived |addresses| without deriving
+  // their keys, which happens on first use for signing instead.
+  virtual void RestoreAccounts(const std::vector<std::string>& addresses);
   // This will return vector of address of all accounts
   virtual std::vector<std::string> GetAccounts();
   virtual void RemoveAccount(const std::string& address);
@@ -53,11 +57,15 @@ class HDKeyring {
 
   std::unique_ptr<HDKey> root_;
   std::unique_ptr<HDKey> master_key_;
+  // Entries are null for restored accounts whose key hasn't been derived yet
   std::vector<std::unique_ptr<HDKey>> accounts_;
+  // Address cache parallel to |accounts_|, empty when not computed yet
+  std::vector<std::string> addresses_;
 
  private:
   FRIEND_TEST_ALL_PREFIXES(HDKeyringUnitTest, ConstructRootHDKey);
   FRIEND_TEST_ALL_PREFIXES(HDKeyringUnitTest, SignMessage);
+  FRIEND_TEST_ALL_PREFIXES(HDKeyringUnitTest, RestoreAccounts);
 
   HDKeyring(const HDKeyring&) = delete;
   HDKeyring& operator=(const HDKeyring&) = delete;
@@ -121,6 +121,47 @@ TEST(HDKeyringUnitTest, SignMessage) {
           .empty());
 }
 
+TEST(HDKeyringUnitTest, RestoreAccounts) {
+  std::vector<uint8_t> seed;
+  EXPECT_TRUE(base::HexStringToBytes(
+      "13ca6c28d26812f82db27908de0b0b7b18940cc4e9d96ebd7de190f706741489907ef65b"
+      "8f9e36c31dc46e81472b6a5e40a4487e725ace445b8203f243fb8958",
+      &seed));
+  HDKeyring keyring;
+  keyring.ConstructRootHDKey(seed, "m/44'/60'/0'/0");
+  keyring.RestoreAccounts({"0x2166fB4e11D44100112B1124ac593081519cA1ec",
+                           "0x2A22ad45446E8b34Da4da1f4ADd7B1571Ab4e4E7"});
+  EXPECT_FALSE(keyring.empty());
+  EXPECT_EQ(keyring.GetAccounts().size(), 2u);
+  EXPECT_EQ(keyring.GetAddress(1),
+            "0x2A22ad45446E8b34Da4da1f4ADd7B1571Ab4e4E7");
+  // Keys are only derived when they are needed
+  EXPECT_EQ(keyring.accounts_[0], nullptr);
+  EXPECT_EQ(keyring.accounts_[1], nullptr);
+
+  std::vector<uint8_t> message;
+  EXPECT_TRUE(base::HexStringToBytes("68656c6c6f20776f726c64", &message));
+  EXPECT_FALSE(
+      keyring.SignMessage("0x2A22ad45446E8b34Da4da1f4ADd7B1571Ab4e4E7", message)
+          .empty());
+  EXPECT_EQ(keyring.accounts_[0], nullptr);
+  EXPECT_NE(keyring.accounts_[1], nullptr);
+
+  // New accounts continue after the restored ones
+  keyring.AddAccounts();
+  EXPECT_EQ(keyring.GetAddress(2),
+            "0x02e77f0e2fa06F95BDEa79Fad158477723145838");
+
+  // A cached address which doesn't match its key is never used for signing
+  HDKeyring keyring2;
+  keyring2.ConstructRootHDKey(seed, "m/44'/60'/0'/0");
+  keyring2.RestoreAccounts({"0xDEADBEEFdeadbeefdeadbeefdeadbeefDEADBEEF"});
+  EXPECT_TRUE(keyring2
+                  .SignMessage("0xDEADBEEFdeadbeefdeadbeefdeadbeefDEADBEEF",
+                               message)
+                  .empty());
+}
+
 TEST(HDKeyringUnitTest, ClearData) {
   HDKeyring keyring;
   std::vector<uint8_t> seed;
@@ -5,8 +5,14 @@
 
 #include "brave/components/brave_wallet/browser/keyring_controller.h"
 
+#include <utility>
+
 #include "base/base64.h"
+#include "base/bind.h"
 #include "base/logging.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/task/thread_pool.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/hd_keyring.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
@@ -17,21 +23,53 @@ namespace brave_wallet {
 namespace {
 const size_t kSaltSize = 32;
 const size_t kNonceSize = 12;
+const size_t kPbkdf2Iterations = 100000;
+const size_t kPbkdf2KeySize = 256;
+const char kDefaultKeyringHDPath[] = "m/44'/60'/0'/0";
+const char kAddressesSeparator[] = ",";
 
 static base::span<const uint8_t> ToSpan(base::StringPiece sp) {
   return base::as_bytes(base::make_span(sp));
 }
+
+// |encrypted_addresses| is the nonce followed by the ciphertext
+std::vector<std::string> DecryptAddresses(
+    PasswordEncryptor* encryptor,
+    const std::vector<uint8_t>& encrypted_addresses) {
+  if (encrypted_addresses.size() <= kNonceSize)
+    return std::vector<std::string>();
+  const auto bytes = base::make_span(encrypted_addresses);
+  std::vector<uint8_t> addresses;
+  if (!encryptor->Decrypt(bytes.subspan(kNonceSize), bytes.first(kNonceSize),
+                          &addresses)) {
+    return std::vector<std::string>();
+  }
+  return base::SplitString(std::string(addresses.begin(), addresses.end()),
+                           kAddressesSeparator, base::TRIM_WHITESPACE,
+                           base::SPLIT_WANT_NONEMPTY);
+}
 }  // namespace
 
+struct KeyringController::UnlockParams {
+  std::string password;
+  std::vector<uint8_t> salt;
+  std::vector<uint8_t> nonce;
+  std::vector<uint8_t> encrypted_mnemonic;
+  std::vector<uint8_t> encrypted_addresses;
+  size_t account_no = 0;
+};
+
+struct KeyringController::UnlockResult {
+  std::unique_ptr<PasswordEncryptor> encryptor;
+  std::unique_ptr<HDKeyring> keyring;
+};
+
 KeyringController::KeyringController(PrefService* prefs) : prefs_(prefs) {
   DCHECK(prefs);
 }
 
 KeyringController::~KeyringController() {
-  // Store the accounts number for keyring resume
-  if (!IsLocked() && default_keyring_)
-    prefs_->SetInteger(kBraveWalletDefaultKeyringAccountNum,
-                       default_keyring_->GetAccounts().size());
+  SaveDefaultKeyringAccounts();
 }
 
 HDKeyring* KeyringController::CreateDefaultKeyring(
@@ -49,20 +87,109 @@ HDKeyring* KeyringController::CreateDefaultKeyring(
 
 HDKeyring* KeyringController::ResumeDefaultKeyring(
     const std::string& password) {
-  if (!CreateEncryptor(password)) {
+  UnlockParams params;
+  if (!GetUnlockParams(password, &params) ||
+      !OnDefaultKeyringResumed(ResumeDefaultKeyringWithParams(params))) {
     return nullptr;
   }
 
-  const std::string mnemonic = GetMnemonicForDefaultKeyring();
-  if (mnemonic.empty() || !CreateDefaultKeyringInternal(mnemonic)) {
-    return nullptr;
+  return default_keyring_.get();
+}
+
+bool KeyringController::GetUnlockParams(const std::string& password,
+                                        UnlockParams* params) {
+  DCHECK(params);
+  if (password.empty())
+    return false;
+  params->password = password;
+  if (!GetPrefsInBytes(kBraveWalletPasswordEncryptorSalt, &params->salt) ||
+      !GetPrefsInBytes(kBraveWalletPasswordEncryptorNonce, &params->nonce) ||
+      !GetPrefsInBytes(kBraveWalletEncryptedMnemonic,
+                       &params->encrypted_mnemonic)) {
+    return false;
   }
-  size_t account_no =
+  // Missing address cache only means accounts have to be derived again
+  GetPrefsInBytes(kBraveWalletEncryptedAccountAddresses,
+                  &params->encrypted_addresses);
+  params->account_no =
       (size_t)prefs_->GetInteger(kBraveWalletDefaultKeyringAccountNum);
-  if (account_no)
-    default_keyring_->AddAccounts(account_no);
+  return true;
+}
 
-  return default_keyring_.get();
+// static
+KeyringController::UnlockResult
+KeyringController::ResumeDefaultKeyringWithParams(const UnlockParams& params) {
+  UnlockResult result;
+  std::unique_ptr<PasswordEncryptor> encryptor =
+      PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
+          params.password, params.salt, kPbkdf2Iterations, kPbkdf2KeySize);
+  if (!encryptor)
+    return result;
+
+  std::vector<uint8_t> mnemonic;
+  if (!encryptor->Decrypt(params.encrypted_mnemonic, params.nonce,
+                          &mnemonic)) {
+    return result;
+  }
+  const std::unique_ptr<std::vector<uint8_t>> seed =
+      MnemonicToSeed(std::string(mnemonic.begin(), mnemonic.end()), "");
+  if (!seed)
+    return result;
+  auto keyring = std::make_unique<HDKeyring>();
+  keyring->ConstructRootHDKey(*seed, kDefaultKeyringHDPath);
+
+  // Restoring the cached addresses keeps unlock from growing with the number
+  // of accounts, their keys are derived on demand when signing
+  const std::vector<std::string> addresses =
+      DecryptAddresses(encryptor.get(), params.encrypted_addresses);
+  if (params.account_no && addresses.size() == params.account_no)
+    keyring->RestoreAccounts(addresses);
+  else if (params.account_no)
+    keyring->AddAccounts(params.account_no);
+
+  result.encryptor = std::move(encryptor);
+  result.keyring = std::move(keyring);
+  return result;
+}
+
+bool KeyringController::OnDefaultKeyringResumed(UnlockResult result) {
+  // The keyring might have been reset while it was being resumed
+  if (!result.encryptor || !result.keyring || !IsDefaultKeyringCreated())
+    return false;
+  encryptor_ = std::move(result.encryptor);
+  default_keyring_ = std::move(result.keyring);
+  return true;
+}
+
+void KeyringController::OnUnlock(UnlockCallback callback,
+                                 UnlockResult result) {
+  if (!OnDefaultKeyringResumed(std::move(result))) {
+    encryptor_.reset();
+    std::move(callback).Run(false);
+    return;
+  }
+
+  std::move(callback).Run(true);
+}
+
+void KeyringController::SaveDefaultKeyringAccounts() {
+  if (IsLocked() || !default_keyring_)
+    return;
+  const std::vector<std::string> addresses = default_keyring_->GetAccounts();
+  prefs_->SetInteger(kBraveWalletDefaultKeyringAccountNum, addresses.size());
+
+  std::vector<uint8_t> encrypted_addresses(kNonceSize);
+  crypto::RandBytes(encrypted_addresses);
+  std::vector<uint8_t> ciphertext;
+  if (!encryptor_->Encrypt(
+          ToSpan(base::JoinString(addresses, kAddressesSeparator)),
+          encrypted_addresses, &ciphertext)) {
+    prefs_->ClearPref(kBraveWalletEncryptedAccountAddresses);
+    return;
+  }
+  encrypted_addresses.insert(encrypted_addresses.end(), ciphertext.begin(),
+                             ciphertext.end());
+  SetPrefsInBytes(kBraveWalletEncryptedAccountAddresses, encrypted_addresses);
 }
 
 HDKeyring* KeyringController::RestoreDefaultKeyring(
@@ -116,9 +243,8 @@ bool KeyringController::IsLocked() const {
 void KeyringController::Lock() {
   if (IsLocked() || !default_keyring_)
     return;
-  // invalidate keyring and save account number
-  prefs_->SetInteger(kBraveWalletDefaultKeyringAccountNum,
-                     default_keyring_->GetAccounts().size());
+  // invalidate keyring and save accounts
+  SaveDefaultKeyringAccounts();
   default_keyring_->ClearData();
 
   encryptor_.reset();
@@ -133,6 +259,23 @@ bool KeyringController::Unlock(const std::string& password) {
   return true;
 }
 
+void KeyringController::Unlock(const std::string& password,
+                               UnlockCallback callback) {
+  UnlockParams params;
+  if (!GetUnlockParams(password, &params)) {
+    encryptor_.reset();
+    std::move(callback).Run(false);
+    return;
+  }
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_BLOCKING},
+      base::BindOnce(&KeyringController::ResumeDefaultKeyringWithParams,
+                     std::move(params)),
+      base::BindOnce(&KeyringController::OnUnlock,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback)));
+}
+
 void KeyringController::Reset() {
   prefs_->ClearPref(kBraveWalletPasswordEncryptorSalt);
   prefs_->ClearPref(kBraveWalletPasswordEncryptorNonce);
@@ -141,6 +284,7 @@ void KeyringController::Reset() {
   default_keyring_.reset();
   prefs_->ClearPref(kBraveWalletEncryptedMnemonic);
   prefs_->ClearPref(kBraveWalletDefaultKeyringAccountNum);
+  prefs_->ClearPref(kBraveWalletEncryptedAccountAddresses);
 }
 
 bool KeyringController::GetPrefsInBytes(const std::string& path,
@@ -184,7 +328,7 @@ bool KeyringController::CreateEncryptor(const std::string& password) {
     SetPrefsInBytes(kBraveWalletPasswordEncryptorSalt, salt);
   }
   encryptor_ = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
-      password, salt, 100000, 256);
+      password, salt, kPbkdf2Iterations, kPbkdf2KeySize);
   return encryptor_ != nullptr;
 }
 
@@ -198,13 +342,15 @@ bool KeyringController::CreateDefaultKeyringInternal(
     return false;
   }
   SetPrefsInBytes(kBraveWalletEncryptedMnemonic, encrypted_mnemonic);
+  // Cached addresses belong to the previous keyring
+  prefs_->ClearPref(kBraveWalletEncryptedAccountAddresses);
 
   const std::unique_ptr<std::vector<uint8_t>> seed =
       MnemonicToSeed(mnemonic, "");
   if (!seed)
     return false;
   default_keyring_ = std::make_unique<HDKeyring>();
-  default_keyring_->ConstructRootHDKey(*seed, "m/44'/60'/0'/0");
+  default_keyring_->ConstructRootHDKey(*seed, kDefaultKeyringHDPath);
 
   return true;
 }
@@ -10,7 +10,9 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/gtest_prod_util.h"
+#include "base/memory/weak_ptr.h"
 #include "brave/components/brave_wallet/browser/password_encryptor.h"
 
 class PrefService;
@@ -28,6 +30,7 @@ FORWARD_DECLARE_TEST(KeyringControllerUnitTest, CreateDefaultKeyringInternal);
 FORWARD_DECLARE_TEST(KeyringControllerUnitTest, GetMnemonicForDefaultKeyring);
 FORWARD_DECLARE_TEST(KeyringControllerUnitTest, LockAndUnlock);
 FORWARD_DECLARE_TEST(KeyringControllerUnitTest, Reset);
+FORWARD_DECLARE_TEST(KeyringControllerUnitTest, UnlockRestoresCachedAccounts);
 
 // This class is not thread-safe and should have single owner
 class KeyringController {
@@ -50,6 +53,10 @@ class KeyringController {
   bool IsLocked() const;
   void Lock();
   bool Unlock(const std::string& password);
+  // Same as above but derives the key from |password| and resumes the default
+  // keyring on the thread pool
+  using UnlockCallback = base::OnceCallback<void(bool)>;
+  void Unlock(const std::string& password, UnlockCallback callback);
 
   /* TODO(darkdh): For other keyrings support
   void DeleteKeyring(size_t index);
@@ -69,6 +76,11 @@ class KeyringController {
                            GetMnemonicForDefaultKeyring);
   FRIEND_TEST_ALL_PREFIXES(KeyringControllerUnitTest, LockAndUnlock);
   FRIEND_TEST_ALL_PREFIXES(KeyringControllerUnitTest, Reset);
+  FRIEND_TEST_ALL_PREFIXES(KeyringControllerUnitTest,
+                           UnlockRestoresCachedAccounts);
+
+  struct UnlockParams;
+  struct UnlockResult;
 
   bool GetPrefsInBytes(const std::string& path, std::vector<uint8_t>* bytes);
   void SetPrefsInBytes(const std::string& path,
@@ -78,6 +90,16 @@ class KeyringController {
   bool CreateDefaultKeyringInternal(const std::string& mnemonic);
   // It's used to reconstruct same default keyring between browser relaunch
   HDKeyring* ResumeDefaultKeyring(const std::string& password);
+  // Reads everything ResumeDefaultKeyringWithParams needs from prefs, returns
+  // false if there is no keyring to resume
+  bool GetUnlockParams(const std::string& password, UnlockParams* params);
+  // Runs PBKDF2 and derives the default keyring, safe to call on any sequence
+  static UnlockResult ResumeDefaultKeyringWithParams(
+      const UnlockParams& params);
+  bool OnDefaultKeyringResumed(UnlockResult result);
+  void OnUnlock(UnlockCallback callback, UnlockResult result);
+  // Stores the accounts number and encrypted addresses for keyring resume
+  void SaveDefaultKeyringAccounts();
 
   std::unique_ptr<PasswordEncryptor> encryptor_;
   std::unique_ptr<HDKeyring> default_keyring_;
@@ -87,6 +109,8 @@ class KeyringController {
 
   PrefService* prefs_;
 
+  base::WeakPtrFactory<KeyringController> weak_ptr_factory_{this};
+
   KeyringController(const KeyringController&) = delete;
   KeyringController& operator=(const KeyringController&) = delete;
 };
@@ -6,6 +6,8 @@
 #include "brave/components/brave_wallet/browser/keyring_controller.h"
 
 #include "base/base64.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
 #include "brave/components/brave_wallet/browser/hd_keyring.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
 #include "chrome/browser/profiles/profile_manager.h"
@@ -401,4 +403,70 @@ TEST_F(KeyringControllerUnitTest, Reset) {
   EXPECT_EQ(controller.encryptor_, nullptr);
 }
 
+TEST_F(KeyringControllerUnitTest, UnlockRestoresCachedAccounts) {
+  std::vector<std::string> accounts;
+  {
+    KeyringController controller(GetPrefs());
+    HDKeyring* keyring = controller.CreateDefaultKeyring("brave");
+    ASSERT_NE(keyring, nullptr);
+    EXPECT_FALSE(
+        GetPrefs()->HasPrefPath(kBraveWalletEncryptedAccountAddresses));
+    keyring->AddAccounts(3);
+    accounts = keyring->GetAccounts();
+    controller.Lock();
+    // Addresses are only stored encrypted
+    const std::string encrypted_addresses =
+        GetPrefs()->GetString(kBraveWalletEncryptedAccountAddresses);
+    EXPECT_FALSE(encrypted_addresses.empty());
+    EXPECT_EQ(encrypted_addresses.find(accounts[0]), std::string::npos);
+  }
+  {
+    KeyringController controller(GetPrefs());
+    bool callback_called = false;
+    base::RunLoop run_loop;
+    controller.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                        EXPECT_TRUE(success);
+                        callback_called = true;
+                        run_loop.Quit();
+                      }));
+    // Key derivation happens on the thread pool
+    EXPECT_TRUE(controller.IsLocked());
+    run_loop.Run();
+    ASSERT_TRUE(callback_called);
+    ASSERT_FALSE(controller.IsLocked());
+    HDKeyring* keyring = controller.GetDefaultKeyring();
+    ASSERT_NE(keyring, nullptr);
+    EXPECT_EQ(keyring->GetAccounts(), accounts);
+    EXPECT_FALSE(keyring->SignMessage(accounts[2], {0xde, 0xad}).empty());
+
+    // Sync unlock restores the same accounts
+    controller.Lock();
+    ASSERT_TRUE(controller.Unlock("brave"));
+    EXPECT_EQ(controller.GetDefaultKeyring()->GetAccounts(), accounts);
+  }
+  {
+    KeyringController controller(GetPrefs());
+    base::RunLoop run_loop;
+    controller.Unlock("brave123", base::BindLambdaForTesting([&](bool success) {
+                        EXPECT_FALSE(success);
+                        run_loop.Quit();
+                      }));
+    run_loop.Run();
+    EXPECT_TRUE(controller.IsLocked());
+  }
+  {
+    // Without the address cache accounts are derived again
+    GetPrefs()->ClearPref(kBraveWalletEncryptedAccountAddresses);
+    KeyringController controller(GetPrefs());
+    ASSERT_TRUE(controller.Unlock("brave"));
+    EXPECT_EQ(controller.GetDefaultKeyring()->GetAccounts(), accounts);
+  }
+  {
+    KeyringController controller(GetPrefs());
+    controller.Reset();
+    EXPECT_FALSE(
+        GetPrefs()->HasPrefPath(kBraveWalletEncryptedAccountAddresses));
+  }
+}
+
 }  // namespace brave_wallet
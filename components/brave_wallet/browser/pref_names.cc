@@ -13,6 +13,8 @@ const char kBraveWalletPasswordEncryptorNonce[] =
 const char kBraveWalletEncryptedMnemonic[] = "brave.wallet.encrypted_mnemonic";
 const char kBraveWalletDefaultKeyringAccountNum[] =
     "brave.wallet.default_keyring_account_num";
+const char kBraveWalletEncryptedAccountAddresses[] =
+    "brave.wallet.encrypted_account_addresses";
 const char kShowWalletIconOnToolbar[] =
     "brave.wallet.show_wallet_icon_on_toolbar";
 const char kBraveWalletBackupComplete[] = "brave.wallet.wallet_backup_complete";
@@ -11,6 +11,7 @@ extern const char kBraveWalletPasswordEncryptorSalt[];
 extern const char kBraveWalletPasswordEncryptorNonce[];
 extern const char kBraveWalletEncryptedMnemonic[];
 extern const char kBraveWalletDefaultKeyringAccountNum[];
+extern const char kBraveWalletEncryptedAccountAddresses[];
 extern const char kShowWalletIconOnToolbar[];
 extern const char kBraveWalletBackupComplete[];
 
@@ -5,27 +5,26 @@
 
 #include "brave/components/brave_wallet/browser/rlp_decode.h"
 
+#include <limits>
 #include <utility>
 
+#include "base/check.h"
+
 namespace {
 
-// Decodes an integer
-bool RLPToInteger(const std::string& s, size_t* val) {
-  size_t length = s.length();
-  if (length == 0) {
+// Decodes a big endian integer
+bool RLPToInteger(base::span<const uint8_t> s, size_t* val) {
+  if (s.empty()) {
     return false;
   }
-
-  if (length == 1) {
-    *val = static_cast<size_t>(static_cast<uint8_t>(s[0]));
-    return true;
-  }
-
-  size_t v2;
-  if (length <= 1 || !RLPToInteger(s.substr(0, length - 1), &v2)) {
-    return false;
+  size_t result = 0;
+  for (uint8_t byte : s) {
+    if (result > (std::numeric_limits<size_t>::max() >> 8)) {
+      return false;
+    }
+    result = result * 256 + byte;
   }
-  *val = static_cast<size_t>(static_cast<uint8_t>(s[length - 1]) + v2 * 256);
+  *val = result;
   return true;
 }
 
@@ -34,152 +33,151 @@ bool IsWithinBounds(size_t offset, size_t data_len, size_t length) {
   return offset <= length && data_len <= length && offset + data_len <= length;
 }
 
-// Decodes an offset, length, and value
-bool RLPDecodeLength(const std::string& s,
-                     size_t* offset,
-                     size_t* data_len,
-                     base::Value* value) {
-  size_t length = s.length();
-  if (length == 0) {
+// Checks that a long string or list length follows its prefix and decodes it
+bool RLPDecodeLongLength(base::span<const uint8_t> s,
+                         size_t length_of_length,
+                         size_t* offset,
+                         size_t* data_len) {
+  if (s.size() < 1 + length_of_length ||
+      !RLPToInteger(s.subspan(1, length_of_length), data_len)) {
     return false;
   }
-  uint8_t prefix = static_cast<uint8_t>(s[0]);
-  if (prefix <= 0x7f) {
-    *offset = 0;
-    *data_len = 1;
-    std::string str = {s[0]};
-    *value = base::Value(str);
-    return true;
-  }
+  *offset = 1 + length_of_length;
+  // If the data is 0-55 bytes long, it should have been encoded with a short
+  // prefix by the RLP encoding spec.  So this input should never happen, even
+  // though it could in theory decode properly.
+  return *data_len > 55 && IsWithinBounds(*offset, *data_len, s.size());
+}
 
-  if (prefix <= 0xb7 && length > prefix - 0x80) {
-    size_t strLen = prefix - 0x80;
-    *offset = 1;
-    *data_len = strLen;
-    if (!IsWithinBounds(*offset, *data_len, length)) {
+bool RLPDecodeInternal(brave_wallet::RLPReader* reader, base::Value* output) {
+  if (!reader->NextIsList()) {
+    base::span<const uint8_t> value;
+    if (!reader->ReadString(&value)) {
       return false;
     }
-    // If a string length is 1 it should have been handled by the single byte
-    // clause above.
-    if (*data_len == 1) {
-      return false;
-    }
-    std::string str = s.substr(*offset, *data_len);
-    *value = base::Value(str);
+    *output = base::Value(std::string(value.begin(), value.end()));
     return true;
   }
 
-  size_t i;
-  if (1 + prefix - 0xb7 <= length &&
-      RLPToInteger(s.substr(1, prefix - 0xb7), &i)) {
-    if (prefix <= 0xbf && length > prefix - 0xb7 &&
-        length > prefix - 0xb7 + i) {
-      size_t strLen = i;
-      *offset = 1 + prefix - 0xb7;
-      *data_len = strLen;
-      if (!IsWithinBounds(*offset, *data_len, length)) {
-        return false;
-      }
-      // If a list contains 0-55 bytes, it should have been handled above by
-      // the RLP encoding spec.  So this input should never happen, even though
-      // it could in theory decode properly.
-      if (*data_len <= 55) {
-        return false;
-      }
-
-      std::string str = s.substr(*offset, *data_len);
-      *value = base::Value(str);
-      return true;
-    }
-  }
-
-  if (prefix <= 0xf7 && length > prefix - 0xc0) {
-    *offset = 1;
-    *data_len = prefix - 0xc0;
-    *value = base::ListValue();
-    return true;
+  brave_wallet::RLPReader list(base::span<const uint8_t>{});
+  if (!reader->ReadList(&list)) {
+    return false;
   }
-
-  // The data is a list if the range of the first byte is [0xf8, 0xff], and the
-  // total payload of the list whose length is equal to the first byte minus
-  // 0xf7 follows the first byte, and the concatenation of the RLP encodings
-  // of all items of the list follows the total payload of the list;
-  size_t list_data_len;
-  size_t list_len_length = prefix - 0xf7;
-  if (prefix <= 0xff && length >= 1 + prefix - 0xf7 &&
-      RLPToInteger(s.substr(1, list_len_length), &list_data_len)) {
-    // Skip past the prefix and the list len length
-    *offset = 1 + list_len_length;
-    *data_len = list_data_len;
-    // If a list contains 0-55 elements, it should have been handled above by
-    // the RLP encoding spec.  So this input should never happen, even though
-    // it could in theory decode properly.
-    if (*data_len <= 55 || !IsWithinBounds(*offset, *data_len, length)) {
+  base::Value output_list(base::Value::Type::LIST);
+  while (!list.empty()) {
+    base::Value v;
+    if (!RLPDecodeInternal(&list, &v)) {
       return false;
     }
-    *value = base::ListValue();
-    return true;
+    output_list.Append(std::move(v));
   }
+  *output = std::move(output_list);
+  return true;
+}
+
+}  // namespace
 
-  return false;
+namespace brave_wallet {
+
+RLPReader::RLPReader(base::span<const uint8_t> input) : input_(input) {}
+
+RLPReader::RLPReader(const RLPReader& other) = default;
+
+RLPReader::~RLPReader() = default;
+
+bool RLPReader::NextIsList() const {
+  bool is_list;
+  base::span<const uint8_t> payload;
+  size_t size;
+  return PeekItem(&is_list, &payload, &size) && is_list;
+}
+
+bool RLPReader::ReadString(base::span<const uint8_t>* value) {
+  DCHECK(value);
+  bool is_list;
+  size_t size;
+  if (!PeekItem(&is_list, value, &size) || is_list) {
+    return false;
+  }
+  input_ = input_.subspan(size);
+  return true;
 }
 
-// Decodes a string and gives the result, an offset, and a data_len
-bool RLPDecodeInternal(const std::string& s,
-                       base::Value* output,
-                       size_t* offset,
-                       size_t* data_len) {
-  size_t length = s.length();
-  if (!RLPDecodeLength(s, offset, data_len, output)) {
+bool RLPReader::ReadList(RLPReader* list) {
+  DCHECK(list);
+  bool is_list;
+  base::span<const uint8_t> payload;
+  size_t size;
+  if (!PeekItem(&is_list, &payload, &size) || !is_list) {
     return false;
   }
+  *list = RLPReader(payload);
+  input_ = input_.subspan(size);
+  return true;
+}
 
-  if (output->is_string()) {
-    if (!IsWithinBounds(*offset, *data_len, length)) {
+bool RLPReader::PeekItem(bool* is_list,
+                         base::span<const uint8_t>* payload,
+                         size_t* size) const {
+  const size_t length = input_.size();
+  if (length == 0) {
+    return false;
+  }
+  const uint8_t prefix = input_[0];
+  size_t offset;
+  size_t data_len;
+  if (prefix <= 0x7f) {
+    // A single byte is its own encoding
+    *is_list = false;
+    offset = 0;
+    data_len = 1;
+  } else if (prefix <= 0xb7) {
+    *is_list = false;
+    offset = 1;
+    data_len = prefix - 0x80;
+    if (!IsWithinBounds(offset, data_len, length)) {
+      return false;
+    }
+    // A single byte below 0x80 should have been handled by the single byte
+    // clause above.
+    if (data_len == 1 && input_[1] < 0x80) {
       return false;
     }
-    std::string str = s.substr(*offset, *data_len);
-    *output = base::Value(str);
-  } else if (output->is_list()) {
-    *output = base::ListValue();
-    base::ListValue* output_list;
-    if (!output->GetAsList(&output_list)) {
+  } else if (prefix <= 0xbf) {
+    *is_list = false;
+    if (!RLPDecodeLongLength(input_, prefix - 0xb7, &offset, &data_len)) {
       return false;
     }
-    if (!IsWithinBounds(*offset, *data_len, length)) {
+  } else if (prefix <= 0xf7) {
+    *is_list = true;
+    offset = 1;
+    data_len = prefix - 0xc0;
+    if (!IsWithinBounds(offset, data_len, length)) {
       return false;
     }
-    std::string sub = s.substr(*offset, *data_len);
-    while (sub.length() > 0) {
-      base::Value v;
-      size_t offset2, data_len2;
-      if (!RLPDecodeInternal(sub, &v, &offset2, &data_len2)) {
-        return false;
-      }
-      output_list->Append(std::move(v));
-      *offset += data_len2 + offset2;
-      *data_len -= data_len2 + offset2;
-      if (!IsWithinBounds(*offset, *data_len, length)) {
-        return false;
-      }
-      sub = s.substr(*offset, *data_len);
+  } else {
+    // The data is a list if the range of the first byte is [0xf8, 0xff], and
+    // the total payload of the list whose length is equal to the first byte
+    // minus 0xf7 follows the first byte, and the concatenation of the RLP
+    // encodings of all items of the list follows the total payload of the
+    // list;
+    *is_list = true;
+    if (!RLPDecodeLongLength(input_, prefix - 0xf7, &offset, &data_len)) {
+      return false;
     }
   }
 
+  *payload = input_.subspan(offset, data_len);
+  *size = offset + data_len;
   return true;
 }
 
-}  // namespace
-
-namespace brave_wallet {
-
 bool RLPDecode(const std::string& s, base::Value* output) {
   if (!output) {
     return false;
   }
-  size_t offset;
-  size_t data_len;
-  bool result = RLPDecodeInternal(s, output, &offset, &data_len);
+  RLPReader reader(base::as_bytes(base::make_span(s)));
+  bool result = RLPDecodeInternal(&reader, output);
   if (!result) {
     *output = base::Value();
   }
@@ -8,10 +8,43 @@
 
 #include <string>
 
+#include "base/containers/span.h"
 #include "base/values.h"
 
 namespace brave_wallet {
 
+// Cursor over RLP encoded data which hands out views into the input instead
+// of copying strings or building base::Value trees. The input must outlive the
+// reader and every view it returns.
+class RLPReader {
+ public:
+  explicit RLPReader(base::span<const uint8_t> input);
+  RLPReader(const RLPReader& other);
+  ~RLPReader();
+
+  // No items left to read
+  bool empty() const { return input_.empty(); }
+
+  // Returns true if the next item is a list, false if it is a string or the
+  // next item can't be decoded
+  bool NextIsList() const;
+
+  // Reads the next item if it is a string and advances past it
+  bool ReadString(base::span<const uint8_t>* value);
+  // Reads the next item if it is a list and advances past it, |list| iterates
+  // over its items
+  bool ReadList(RLPReader* list);
+
+ private:
+  // Decodes the next item without advancing, |size| is the whole size of the
+  // item including its prefix
+  bool PeekItem(bool* is_list,
+                base::span<const uint8_t>* payload,
+                size_t* size) const;
+
+  base::span<const uint8_t> input_;
+};
+
 // Recursive Length Prefix (RLP) decoding of arbitrarily nested arrays of data
 // Input string should be a hex string but without the 0x prefix
 bool RLPDecode(const std::string& s, base::Value* output);
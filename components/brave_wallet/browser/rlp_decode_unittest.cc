@@ -76,6 +76,14 @@ TEST(RLPDecodeTest, ByteString7f) {
   ASSERT_EQ(bytestring, s);
 }
 
+TEST(RLPDecodeTest, ByteString80) {
+  base::Value val;
+  ASSERT_TRUE(RLPDecode(FromHex("0x8180"), &val));
+  std::string s;
+  ASSERT_TRUE(val.GetAsString(&s));
+  ASSERT_EQ("\x80", s);
+}
+
 TEST(RLPDecodeTest, EmptyString) {
   base::Value val;
   ASSERT_TRUE(RLPDecode(FromHex("0x80"), &val));
@@ -276,6 +284,44 @@ TEST(RLPDecodeTest, ComplexStructure) {
             RLPTestValueToString(val));
 }
 
+TEST(RLPDecodeTest, Reader) {
+  const std::string input = FromHex(
+      "0xe383636174ca85707570707983636f7785686f727365c1c083706967c180857368656"
+      "570");
+  const auto bytes = base::as_bytes(base::make_span(input));
+  RLPReader reader(bytes);
+  ASSERT_TRUE(reader.NextIsList());
+  base::span<const uint8_t> value;
+  EXPECT_FALSE(reader.ReadString(&value));
+
+  RLPReader list(base::span<const uint8_t>{});
+  ASSERT_TRUE(reader.ReadList(&list));
+  EXPECT_TRUE(reader.empty());
+
+  ASSERT_TRUE(list.ReadString(&value));
+  EXPECT_EQ(std::string(value.begin(), value.end()), "cat");
+  // Views point into the input
+  EXPECT_EQ(value.data(), bytes.data() + 2);
+
+  RLPReader sub_list(base::span<const uint8_t>{});
+  ASSERT_TRUE(list.ReadList(&sub_list));
+  ASSERT_TRUE(sub_list.ReadString(&value));
+  EXPECT_EQ(std::string(value.begin(), value.end()), "puppy");
+  ASSERT_TRUE(sub_list.ReadString(&value));
+  EXPECT_EQ(std::string(value.begin(), value.end()), "cow");
+  EXPECT_TRUE(sub_list.empty());
+  EXPECT_FALSE(sub_list.ReadString(&value));
+
+  ASSERT_TRUE(list.ReadString(&value));
+  EXPECT_EQ(std::string(value.begin(), value.end()), "horse");
+  EXPECT_FALSE(list.empty());
+
+  const std::string invalid_input = FromHex("0xc5010203");
+  RLPReader invalid(base::as_bytes(base::make_span(invalid_input)));
+  EXPECT_FALSE(invalid.NextIsList());
+  EXPECT_FALSE(invalid.ReadList(&list));
+}
+
 TEST(RLPDecodeTest, InvalidInputInt32Overflow) {
   base::Value val;
   ASSERT_FALSE(RLPDecode(FromHex("0xbf0f000000000000021111"), &val));
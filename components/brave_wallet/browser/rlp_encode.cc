@@ -8,28 +8,107 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/check_op.h"
+
 namespace {
 
-std::string RLPToBinary(size_t x) {
-  if (x == 0) {
-    return "";
+// Number of big endian bytes needed for |x|, 0 takes no bytes
+template <typename T>
+size_t RLPBinaryLength(T x) {
+  size_t length = 0;
+  while (x > static_cast<T>(0)) {
+    ++length;
+    x >>= 8;
+  }
+  return length;
+}
+
+// Writes |x| as |length| big endian bytes
+template <typename T>
+void RLPWriteBinary(T x, size_t length, uint8_t* out) {
+  for (size_t i = length; i > 0; --i) {
+    out[i - 1] = static_cast<uint8_t>(x & static_cast<T>(0xFF));
+    x >>= 8;
   }
-  std::string ret = RLPToBinary(x / 256);
-  ret.push_back(x % 256);
-  return ret;
 }
 
-std::string RLPEncodeLength(size_t length, size_t offset) {
-  char sz[2] = {0};
+size_t RLPEncodedLengthSize(size_t length) {
+  return length < 56 ? 1 : 1 + RLPBinaryLength(length);
+}
+
+size_t RLPWriteLength(size_t length, size_t offset, uint8_t* out) {
   if (length < 56) {
-    sz[0] = length + offset;
-    return sz;
+    out[0] = static_cast<uint8_t>(length + offset);
+    return 1;
   }
-  std::string BL = RLPToBinary(length);
-  sz[0] = BL.length() + offset + 55;
-  std::string ret(sz);
-  ret.append(BL);
-  return ret;
+  const size_t binary_length = RLPBinaryLength(length);
+  out[0] = static_cast<uint8_t>(binary_length + offset + 55);
+  RLPWriteBinary(length, binary_length, out + 1);
+  return 1 + binary_length;
+}
+
+size_t RLPEncodedBytesSize(const uint8_t* bytes, size_t length) {
+  if (length == 1 && bytes[0] < 0x80)
+    return 1;
+  return RLPEncodedLengthSize(length) + length;
+}
+
+size_t RLPWriteBytes(const uint8_t* bytes, size_t length, uint8_t* out) {
+  if (length == 1 && bytes[0] < 0x80) {
+    out[0] = bytes[0];
+    return 1;
+  }
+  const size_t written = RLPWriteLength(length, 0x80, out);
+  std::copy(bytes, bytes + length, out + written);
+  return written + length;
+}
+
+// Ints are encoded as their big endian bytes, same as RLPUint256ToBlobValue
+size_t RLPEncodedIntSize(int i) {
+  const uint256_t value = static_cast<uint256_t>(i);
+  const size_t length = RLPBinaryLength(value);
+  if (length == 1 && value < static_cast<uint256_t>(0x80))
+    return 1;
+  return RLPEncodedLengthSize(length) + length;
+}
+
+size_t RLPWriteInt(int i, uint8_t* out) {
+  const uint256_t value = static_cast<uint256_t>(i);
+  const size_t length = RLPBinaryLength(value);
+  if (length == 1 && value < static_cast<uint256_t>(0x80)) {
+    out[0] = static_cast<uint8_t>(value);
+    return 1;
+  }
+  const size_t written = RLPWriteLength(length, 0x80, out);
+  RLPWriteBinary(value, length, out + written);
+  return written + length;
+}
+
+size_t RLPEncodedPayloadSize(const base::Value& list) {
+  size_t size = 0;
+  for (const auto& item : list.GetList())
+    size += brave_wallet::RLPEncodedSize(item);
+  return size;
+}
+
+// |out| must have room for RLPEncodedSize(val) bytes
+size_t RLPWrite(const base::Value& val, uint8_t* out) {
+  if (val.is_int()) {
+    return RLPWriteInt(val.GetInt(), out);
+  } else if (val.is_blob()) {
+    const base::Value::BlobStorage& blob = val.GetBlob();
+    return RLPWriteBytes(blob.data(), blob.size(), out);
+  } else if (val.is_string()) {
+    const std::string& s = val.GetString();
+    return RLPWriteBytes(reinterpret_cast<const uint8_t*>(s.data()), s.size(),
+                         out);
+  } else if (val.is_list()) {
+    size_t written = RLPWriteLength(RLPEncodedPayloadSize(val), 0xc0, out);
+    for (const auto& item : val.GetList())
+      written += RLPWrite(item, out + written);
+    return written;
+  }
+  return 0;
 }
 
 }  // namespace
@@ -49,29 +128,37 @@ base::Value RLPUint256ToBlobValue(uint256_t input) {
 }
 
 std::string RLPEncode(base::Value val) {
+  std::string output(RLPEncodedSize(val), '\0');
+  if (output.empty())
+    return output;
+  const size_t written = RLPEncodeTo(
+      val, base::make_span(reinterpret_cast<uint8_t*>(&output[0]),
+                           output.size()));
+  DCHECK_EQ(written, output.size());
+  return output;
+}
+
+size_t RLPEncodedSize(const base::Value& val) {
   if (val.is_int()) {
-    int i;
-    val.GetAsInteger(&i);
-    return RLPEncode(base::Value(RLPUint256ToBlobValue((uint256_t)i)));
+    return RLPEncodedIntSize(val.GetInt());
   } else if (val.is_blob()) {
-    base::Value::BlobStorage blob = val.GetBlob();
-    std::string s(blob.begin(), blob.end());
-    if (blob.size() == 1 && static_cast<uint8_t>(blob[0]) < 0x80) {
-      return s;
-    }
-    return RLPEncodeLength(blob.size(), 0x80) + s;
+    const base::Value::BlobStorage& blob = val.GetBlob();
+    return RLPEncodedBytesSize(blob.data(), blob.size());
   } else if (val.is_string()) {
-    std::string s;
-    val.GetAsString(&s);
-    return RLPEncode(base::Value(base::Value::BlobStorage(s.begin(), s.end())));
+    const std::string& s = val.GetString();
+    return RLPEncodedBytesSize(reinterpret_cast<const uint8_t*>(s.data()),
+                               s.size());
   } else if (val.is_list()) {
-    std::string output;
-    for (auto& item : val.GetList()) {
-      output += RLPEncode(std::move(item));
-    }
-    return RLPEncodeLength(output.length(), 0xc0) + output;
+    const size_t payload_size = RLPEncodedPayloadSize(val);
+    return RLPEncodedLengthSize(payload_size) + payload_size;
   }
-  return "";
+  return 0;
+}
+
+size_t RLPEncodeTo(const base::Value& val, base::span<uint8_t> output) {
+  if (output.size() < RLPEncodedSize(val))
+    return 0;
+  return RLPWrite(val, output.data());
 }
 
 }  // namespace brave_wallet
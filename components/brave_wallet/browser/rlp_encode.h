@@ -8,6 +8,7 @@
 
 #include <string>
 
+#include "base/containers/span.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_types.h"
 
@@ -20,6 +21,15 @@ base::Value RLPUint256ToBlobValue(uint256_t input);
 // blob, or int data
 std::string RLPEncode(base::Value val);
 
+// Returns the number of bytes the RLP encoding of |val| takes, used to size
+// the buffer passed to RLPEncodeTo
+size_t RLPEncodedSize(const base::Value& val);
+
+// Writes the RLP encoding of |val| to the front of |output| without any
+// intermediate allocations and returns the number of bytes written, or 0 if
+// |output| is smaller than RLPEncodedSize(val)
+size_t RLPEncodeTo(const base::Value& val, base::span<uint8_t> output);
+
 }  // namespace brave_wallet
 
 #endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_RLP_ENCODE_H_
@@ -6,6 +6,7 @@
 #include <ctype.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/rlp_encode.h"
@@ -391,4 +392,29 @@ TEST(RLPEncodeTest, DictionaryValueNotSupported) {
   ASSERT_TRUE(brave_wallet::RLPEncode(std::move(d)).empty());
 }
 
+TEST(RLPEncodeTest, EncodeToBuffer) {
+  base::Value val = RLPTestStringToValue(
+      "['cat',['puppy', 'cow'], 'horse', [[]], 'pig', [''], 'sheep']");
+  const size_t size = brave_wallet::RLPEncodedSize(val);
+  ASSERT_EQ(size, 36u);
+
+  // Too small buffer isn't written to
+  std::vector<uint8_t> small(size - 1, 0xff);
+  EXPECT_EQ(brave_wallet::RLPEncodeTo(val, small), 0u);
+  EXPECT_EQ(small, std::vector<uint8_t>(size - 1, 0xff));
+
+  // Larger buffers are only written at the front
+  std::vector<uint8_t> buffer(size + 2, 0xff);
+  ASSERT_EQ(brave_wallet::RLPEncodeTo(val, buffer), size);
+  EXPECT_EQ(ToHex(std::string(buffer.begin(), buffer.begin() + size)),
+            "0xe383636174ca85707570707983636f7785686f727365c1c083706967c1808573"
+            "68656570");
+  EXPECT_EQ(buffer[size], 0xff);
+  EXPECT_EQ(ToHex(std::string(buffer.begin(), buffer.begin() + size)),
+            ToHex(brave_wallet::RLPEncode(val.Clone())));
+
+  EXPECT_EQ(brave_wallet::RLPEncodedSize(RLPTestStringToValue("100000")), 4u);
+  EXPECT_EQ(brave_wallet::RLPEncodedSize(base::DictionaryValue()), 0u);
+}
+
 }  // namespace brave_wallet
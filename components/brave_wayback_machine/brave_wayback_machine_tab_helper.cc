@@ -21,10 +21,21 @@
 #include "content/public/browser/web_contents.h"
 #include "net/http/http_response_headers.h"
 #include "net/http/http_status_code.h"
+#include "url/gurl.h"
+
+namespace {
+
+constexpr size_t kMaxCachedWaybackURLs = 10;
+// How long a page without a snapshot is remembered as such.
+constexpr base::TimeDelta kMissingWaybackURLCacheDuration =
+    base::TimeDelta::FromMinutes(10);
+
+}  // namespace
 
 BraveWaybackMachineTabHelper::BraveWaybackMachineTabHelper(
     content::WebContents* contents)
     : WebContentsObserver(contents),
+      wayback_url_cache_(kMaxCachedWaybackURLs),
       weak_factory_(this) {
   pref_service_ = user_prefs::UserPrefs::Get(contents->GetBrowserContext());
 }
@@ -37,6 +48,29 @@ void BraveWaybackMachineTabHelper::set_delegate(
   delegate_ = std::move(delegate);
 }
 
+bool BraveWaybackMachineTabHelper::GetCachedWaybackURL(const GURL& url,
+                                                       GURL* wayback_url) {
+  DCHECK(wayback_url);
+  auto it = wayback_url_cache_.Get(url);
+  if (it == wayback_url_cache_.end())
+    return false;
+
+  if (it->second.wayback_url.is_empty() &&
+      base::TimeTicks::Now() - it->second.cached_time >=
+          kMissingWaybackURLCacheDuration) {
+    wayback_url_cache_.Erase(it);
+    return false;
+  }
+
+  *wayback_url = it->second.wayback_url;
+  return true;
+}
+
+void BraveWaybackMachineTabHelper::CacheWaybackURL(const GURL& url,
+                                                   const GURL& wayback_url) {
+  wayback_url_cache_.Put(url, {wayback_url, base::TimeTicks::Now()});
+}
+
 void BraveWaybackMachineTabHelper::DidFinishNavigation(
     content::NavigationHandle* navigation_handle) {
   DCHECK(delegate_);
@@ -8,9 +8,12 @@
 
 #include <memory>
 
+#include "base/containers/mru_cache.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
+#include "url/gurl.h"
 
 class BraveWaybackMachineDelegate;
 class PrefService;
@@ -28,6 +31,14 @@ class BraveWaybackMachineTabHelper
 
   void set_delegate(std::unique_ptr<BraveWaybackMachineDelegate> delegate);
 
+  // Recent wayback lookups for this tab, so checking the same broken page
+  // again (e.g. after a reload) doesn't query archive.org a second time. Only
+  // answers archive.org gave should be cached. An empty |wayback_url| records
+  // that no snapshot was found, which is only kept for a while as the page
+  // may be archived later.
+  bool GetCachedWaybackURL(const GURL& url, GURL* wayback_url);
+  void CacheWaybackURL(const GURL& url, const GURL& wayback_url);
+
   WEB_CONTENTS_USER_DATA_KEY_DECL();
  private:
   FRIEND_TEST_ALL_PREFIXES(BraveWaybackMachineTest, InfobarAddTest);
@@ -44,6 +55,11 @@ class BraveWaybackMachineTabHelper
 
   PrefService* pref_service_ = nullptr;
   std::unique_ptr<BraveWaybackMachineDelegate> delegate_;
+  struct CachedWaybackURL {
+    GURL wayback_url;
+    base::TimeTicks cached_time;
+  };
+  base::MRUCache<GURL, CachedWaybackURL> wayback_url_cache_;
 
   base::WeakPtrFactory<BraveWaybackMachineTabHelper> weak_factory_;
 };
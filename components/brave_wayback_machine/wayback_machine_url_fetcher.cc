@@ -75,17 +75,23 @@ void WaybackMachineURLFetcher::OnWaybackURLFetched(
     const GURL& original_url,
     std::unique_ptr<std::string> response_body) {
   if (!response_body) {
-    client_->OnWaybackURLFetched(GURL::EmptyGURL());
+    client_->OnWaybackURLFetched(GURL::EmptyGURL(), true);
     return;
   }
 
   std::string wayback_response_json = std::move(*response_body);
   const auto result = base::JSONReader::Read(wayback_response_json);
-  if (!result || !result->FindPath("archived_snapshots.closest.url")) {
-    client_->OnWaybackURLFetched(GURL::EmptyGURL());
+  if (!result || !result->is_dict()) {
+    client_->OnWaybackURLFetched(GURL::EmptyGURL(), true);
     return;
   }
 
-  client_->OnWaybackURLFetched(
-      GURL(result->FindPath("archived_snapshots.closest.url")->GetString()));
+  const std::string* url =
+      result->FindStringPath("archived_snapshots.closest.url");
+  if (!url) {
+    client_->OnWaybackURLFetched(GURL::EmptyGURL(), false);
+    return;
+  }
+
+  client_->OnWaybackURLFetched(GURL(*url), false);
 }
@@ -25,7 +25,11 @@ class WaybackMachineURLFetcher final {
  public:
   class Client {
    public:
-    virtual void OnWaybackURLFetched(const GURL& lastest_wayback_url) = 0;
+    // |lookup_failed| is true when archive.org couldn't be reached or sent an
+    // unexpected response. Otherwise an empty |lastest_wayback_url| means the
+    // page has no snapshot.
+    virtual void OnWaybackURLFetched(const GURL& lastest_wayback_url,
+                                     bool lookup_failed) = 0;
    protected:
     virtual ~Client() = default;
   };
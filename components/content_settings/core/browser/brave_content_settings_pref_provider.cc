@@ -9,7 +9,10 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
 #include "base/optional.h"
+#include "base/strings/string_piece.h"
 #include "base/task/post_task.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/pref_names.h"
@@ -26,6 +29,7 @@
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "services/preferences/public/cpp/dictionary_value_update.h"
 #include "services/preferences/public/cpp/scoped_pref_update.h"
+#include "url/gurl.h"
 
 namespace content_settings {
 
@@ -40,6 +44,8 @@ const char kSessionModelPath[] = "model";
 const char kSettingPath[] = "setting";
 const char kPerResourcePath[] = "per_resource";
 
+using RulePatterns = std::pair<ContentSettingsPattern, ContentSettingsPattern>;
+
 Rule CloneRule(const Rule& rule, bool reverse_patterns = false) {
   // brave plugin rules incorrectly use first party url as primary
   auto primary_pattern = reverse_patterns ? rule.secondary_pattern
@@ -117,6 +123,23 @@ bool IsActive(const Rule& cookie_rule,
 
 }  // namespace
 
+// Rules of one shields content type, keyed by the host of their primary
+// pattern. A URL only has to be checked against the rules filed under the
+// suffixes of its host, and against the few rules without a host.
+struct BravePrefProvider::ShieldsRuleIndex {
+  struct IndexedRule {
+    // Position in HostContentSettingsMap's lookup order, lower wins.
+    size_t precedence;
+    ContentSettingsPattern primary_pattern;
+    ContentSettingsPattern secondary_pattern;
+    ContentSetting setting;
+    base::Time expiration;
+  };
+
+  std::map<std::string, std::vector<IndexedRule>, std::less<>> rules_by_host;
+  std::vector<IndexedRule> rules_without_host;
+};
+
 // static
 void BravePrefProvider::CopyPluginSettingsForMigration(PrefService* prefs) {
   if (!prefs->HasPrefPath("profile.content_settings.exceptions.plugins")) {
@@ -157,6 +180,10 @@ BravePrefProvider::~BravePrefProvider() {}
 
 void BravePrefProvider::ShutdownOnUIThread() {
   RemoveObserver(this);
+  {
+    base::AutoLock lock(shields_rule_indexes_lock_);
+    shields_rule_indexes_.clear();
+  }
   PrefProvider::ShutdownOnUIThread();
 }
 
@@ -438,6 +465,75 @@ std::unique_ptr<RuleIterator> BravePrefProvider::GetRuleIterator(
   return PrefProvider::GetRuleIterator(content_type, incognito);
 }
 
+ContentSetting BravePrefProvider::GetShieldsContentSetting(
+    const GURL& primary_url,
+    const GURL& secondary_url,
+    ContentSettingsType content_type) const {
+  DCHECK(IsShieldsContentSettingsType(content_type));
+
+  base::AutoLock lock(shields_rule_indexes_lock_);
+  auto& index = shields_rule_indexes_[content_type];
+  if (!index)
+    index = BuildShieldsRuleIndex(content_type);
+
+  const base::Time now = base::Time::Now();
+  const ShieldsRuleIndex::IndexedRule* best_match = nullptr;
+  auto check_rules =
+      [&](const std::vector<ShieldsRuleIndex::IndexedRule>& rules) {
+        for (const auto& rule : rules) {
+          if (best_match && best_match->precedence < rule.precedence)
+            break;
+          if (!rule.expiration.is_null() && rule.expiration < now)
+            continue;
+          if (rule.primary_pattern.Matches(primary_url) &&
+              rule.secondary_pattern.Matches(secondary_url)) {
+            best_match = &rule;
+            break;
+          }
+        }
+      };
+
+  // Walk the host and each of its parent domains.
+  base::StringPiece host = primary_url.host_piece();
+  while (!host.empty()) {
+    auto it = index->rules_by_host.find(host);
+    if (it != index->rules_by_host.end())
+      check_rules(it->second);
+    const size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
+  check_rules(index->rules_without_host);
+
+  return best_match ? best_match->setting : CONTENT_SETTING_DEFAULT;
+}
+
+std::unique_ptr<BravePrefProvider::ShieldsRuleIndex>
+BravePrefProvider::BuildShieldsRuleIndex(
+    ContentSettingsType content_type) const {
+  auto index = std::make_unique<ShieldsRuleIndex>();
+  size_t precedence = 0;
+  // The map checks incognito rules before the regular ones, and each
+  // iterator must be gone before the next one is created.
+  auto add_rules = [&](bool incognito) {
+    auto rule_iterator = PrefProvider::GetRuleIterator(content_type, incognito);
+    while (rule_iterator && rule_iterator->HasNext()) {
+      Rule rule = rule_iterator->Next();
+      const std::string& host = rule.primary_pattern.GetHost();
+      auto& rules =
+          host.empty() ? index->rules_without_host : index->rules_by_host[host];
+      rules.push_back({precedence++, rule.primary_pattern,
+                       rule.secondary_pattern,
+                       ValueToContentSetting(&rule.value), rule.expiration});
+    }
+  };
+  if (off_the_record_)
+    add_rules(true);
+  add_rules(false);
+  return index;
+}
+
 void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
                                           bool incognito) {
   auto& rules = cookie_rules_[incognito];
@@ -534,54 +630,68 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
     }
   }
 
+  // Only cookie rule changes caused by brave settings are notified, so there
+  // is nothing to diff for chromium cookie changes or during initialization.
+  if (!initialized_ || (content_type != ContentSettingsType::BRAVE_COOKIES &&
+                        content_type != ContentSettingsType::BRAVE_SHIELDS)) {
+    return;
+  }
+
+  // Index both rule sets by their patterns so the diff stays O(n log n) for
+  // profiles with many per-site exceptions.
+  std::vector<std::pair<RulePatterns, ContentSetting>> old_settings;
+  old_settings.reserve(old_rules.size());
+  for (const auto& old_rule : old_rules) {
+    old_settings.emplace_back(
+        RulePatterns(old_rule.primary_pattern, old_rule.secondary_pattern),
+        ValueToContentSetting(&old_rule.value));
+  }
+  const base::flat_map<RulePatterns, ContentSetting> old_settings_map(
+      std::move(old_settings));
+
+  std::vector<RulePatterns> new_patterns;
+  new_patterns.reserve(brave_cookie_rules_[incognito].size());
+
   // get the list of changes
   std::vector<Rule> brave_cookie_updates;
   for (const auto& new_rule : brave_cookie_rules_[incognito]) {
-    auto match = std::find_if(
-        old_rules.begin(),
-        old_rules.end(),
-        [&new_rule](const auto& old_rule) {
-          // we want an exact match here because any change to the rule
-          // is an update
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern &&
-                 ValueToContentSetting(&new_rule.value) ==
-                    ValueToContentSetting(&old_rule.value);
-        });
-    if (match == old_rules.end()) {
+    RulePatterns patterns(new_rule.primary_pattern,
+                          new_rule.secondary_pattern);
+    // we want an exact match here because any change to the rule
+    // is an update
+    auto match = old_settings_map.find(patterns);
+    if (match == old_settings_map.end() ||
+        match->second != ValueToContentSetting(&new_rule.value)) {
       brave_cookie_updates.emplace_back(CloneRule(new_rule));
     }
+    new_patterns.push_back(std::move(patterns));
   }
 
   // find any removed rules
+  // we only care about the patterns here because we're looking
+  // for deleted rules, not changed rules
+  const base::flat_set<RulePatterns> new_patterns_set(std::move(new_patterns));
   for (const auto& old_rule : old_rules) {
-    auto match = std::find_if(
-        brave_cookie_rules_[incognito].begin(),
-        brave_cookie_rules_[incognito].end(),
-        [&old_rule](const auto& new_rule) {
-          // we only care about the patterns here because we're looking
-          // for deleted rules, not changed rules
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern;
-        });
-    if (match == brave_cookie_rules_[incognito].end()) {
+    if (!new_patterns_set.contains(
+            RulePatterns(old_rule.primary_pattern,
+                         old_rule.secondary_pattern))) {
       brave_cookie_updates.emplace_back(
           Rule(old_rule.primary_pattern, old_rule.secondary_pattern,
                base::Value(), old_rule.expiration, old_rule.session_model));
     }
   }
 
+  if (brave_cookie_updates.empty())
+    return;
+
   // Notify brave cookie changes as ContentSettingsType::COOKIES
-  if (initialized_ && (content_type == ContentSettingsType::BRAVE_COOKIES ||
-                       content_type == ContentSettingsType::BRAVE_SHIELDS)) {
-    // PostTask here to avoid content settings autolock DCHECK
-    base::PostTask(
-        FROM_HERE,
-        {content::BrowserThread::UI, base::TaskPriority::USER_VISIBLE},
-        base::BindOnce(&BravePrefProvider::NotifyChanges,
-                       weak_factory_.GetWeakPtr(),
-                       std::move(brave_cookie_updates), incognito));
-  }
+  // PostTask here to avoid content settings autolock DCHECK
+  base::PostTask(
+      FROM_HERE,
+      {content::BrowserThread::UI, base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&BravePrefProvider::NotifyChanges,
+                     weak_factory_.GetWeakPtr(),
+                     std::move(brave_cookie_updates), incognito));
 }
 
 void BravePrefProvider::NotifyChanges(const std::vector<Rule>& rules,
@@ -607,6 +717,11 @@ void BravePrefProvider::OnContentSettingChanged(
     const ContentSettingsPattern& primary_pattern,
     const ContentSettingsPattern& secondary_pattern,
     ContentSettingsType content_type) {
+  if (IsShieldsContentSettingsType(content_type)) {
+    base::AutoLock lock(shields_rule_indexes_lock_);
+    shields_rule_indexes_.erase(content_type);
+  }
+
   if (content_type == ContentSettingsType::COOKIES ||
       content_type == ContentSettingsType::BRAVE_COOKIES ||
       content_type == ContentSettingsType::BRAVE_SHIELDS) {
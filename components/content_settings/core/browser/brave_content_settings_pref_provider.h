@@ -12,10 +12,13 @@
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
+#include "base/synchronization/lock.h"
 #include "components/content_settings/core/browser/content_settings_observer.h"
 #include "components/content_settings/core/browser/content_settings_pref_provider.h"
 #include "components/prefs/pref_change_registrar.h"
 
+class GURL;
+
 namespace content_settings {
 
 // With this subclass, shields configuration is persisted across sessions.
@@ -42,7 +45,19 @@ class BravePrefProvider : public PrefProvider,
       ContentSettingsType content_type,
       bool incognito) const override;
 
+  // Returns the setting of the first rule matching |primary_url| and
+  // |secondary_url|, in the order HostContentSettingsMap tries them, or
+  // CONTENT_SETTING_DEFAULT if no per-site rule matches. Only valid for
+  // shields content types, whose rules are indexed by host so a lookup
+  // doesn't scan every exception.
+  ContentSetting GetShieldsContentSetting(
+      const GURL& primary_url,
+      const GURL& secondary_url,
+      ContentSettingsType content_type) const;
+
  private:
+  struct ShieldsRuleIndex;
+
   friend class BravePrefProviderTest;
   FRIEND_TEST_ALL_PREFIXES(BravePrefProviderTest, TestShieldsSettingsMigration);
   FRIEND_TEST_ALL_PREFIXES(BravePrefProviderTest,
@@ -65,6 +80,8 @@ class BravePrefProvider : public PrefProvider,
   void UpdateCookieRules(ContentSettingsType content_type, bool incognito);
   void OnCookieSettingsChanged(ContentSettingsType content_type);
   void NotifyChanges(const std::vector<Rule>& rules, bool incognito);
+  std::unique_ptr<ShieldsRuleIndex> BuildShieldsRuleIndex(
+      ContentSettingsType content_type) const;
   bool SetWebsiteSettingInternal(
       const ContentSettingsPattern& primary_pattern,
       const ContentSettingsPattern& secondary_pattern,
@@ -81,6 +98,12 @@ class BravePrefProvider : public PrefProvider,
   std::map<bool /* is_incognito */, std::vector<Rule>> cookie_rules_;
   std::map<bool /* is_incognito */, std::vector<Rule>> brave_cookie_rules_;
 
+  // Built on first lookup for each shields content type and dropped whenever
+  // a setting of that type changes. Lookups may come from any thread.
+  mutable std::map<ContentSettingsType, std::unique_ptr<ShieldsRuleIndex>>
+      shields_rule_indexes_;
+  mutable base::Lock shields_rule_indexes_lock_;
+
   bool initialized_;
   bool store_last_modified_;
   base::WeakPtrFactory<BravePrefProvider> weak_factory_;
@@ -8,12 +8,14 @@
 
 #include "base/macros.h"
 #include "base/optional.h"
+#include "base/run_loop.h"
 #include "base/values.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/content_settings/core/browser/brave_content_settings_pref_provider.h"
 #include "brave/components/content_settings/core/browser/brave_content_settings_utils.h"
 #include "chrome/test/base/testing_profile.h"
+#include "components/content_settings/core/browser/content_settings_mock_observer.h"
 #include "components/content_settings/core/browser/content_settings_registry.h"
 #include "components/content_settings/core/common/content_settings.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
@@ -24,6 +26,7 @@
 #include "content/public/test/browser_task_environment.h"
 #include "services/preferences/public/cpp/dictionary_value_update.h"
 #include "services/preferences/public/cpp/scoped_pref_update.h"
+#include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "url/gurl.h"
 
@@ -524,4 +527,109 @@ TEST_F(BravePrefProviderTest, TestShieldsSettingsMigrationFromUnknownSettings) {
   provider.ShutdownOnUIThread();
 }
 
+TEST_F(BravePrefProviderTest, NotifiesOnlyChangedCookieRules) {
+  BravePrefProvider provider(
+      testing_profile()->GetPrefs(), false /* incognito */,
+      true /* store_last_modified */, false /* restore_session */);
+  MockObserver observer;
+  provider.AddObserver(&observer);
+
+  const auto pattern = ContentSettingsPattern::FromString("*://brave.com/*");
+  const auto pattern2 =
+      ContentSettingsPattern::FromString("*://example.com/*");
+
+  // Shields down for a site adds a cookie rule allowing it as first party.
+  EXPECT_CALL(observer, OnContentSettingChanged(testing::_, testing::_,
+                                                testing::_))
+      .Times(testing::AnyNumber());
+  EXPECT_CALL(observer, OnContentSettingChanged(
+                            ContentSettingsPattern::Wildcard(), pattern,
+                            ContentSettingsType::COOKIES))
+      .Times(1);
+  provider.SetWebsiteSetting(pattern, ContentSettingsPattern::Wildcard(),
+                             ContentSettingsType::BRAVE_SHIELDS,
+                             ContentSettingToValue(CONTENT_SETTING_BLOCK), {});
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&observer);
+
+  // Another site's toggle leaves the first site's rule unnotified.
+  EXPECT_CALL(observer, OnContentSettingChanged(testing::_, testing::_,
+                                                testing::_))
+      .Times(testing::AnyNumber());
+  EXPECT_CALL(observer, OnContentSettingChanged(
+                            ContentSettingsPattern::Wildcard(), pattern,
+                            ContentSettingsType::COOKIES))
+      .Times(0);
+  EXPECT_CALL(observer, OnContentSettingChanged(
+                            ContentSettingsPattern::Wildcard(), pattern2,
+                            ContentSettingsType::COOKIES))
+      .Times(1);
+  provider.SetWebsiteSetting(pattern2, ContentSettingsPattern::Wildcard(),
+                             ContentSettingsType::BRAVE_SHIELDS,
+                             ContentSettingToValue(CONTENT_SETTING_BLOCK), {});
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&observer);
+
+  provider.RemoveObserver(&observer);
+  provider.ShutdownOnUIThread();
+}
+
+TEST_F(BravePrefProviderTest, GetShieldsContentSetting) {
+  BravePrefProvider provider(
+      testing_profile()->GetPrefs(), false /* incognito */,
+      true /* store_last_modified */, false /* restore_session */);
+
+  const GURL url("https://sub.brave.com/");
+  const GURL url2("https://other.brave.com/");
+  const GURL url3("https://example.com/");
+  EXPECT_EQ(CONTENT_SETTING_DEFAULT,
+            provider.GetShieldsContentSetting(
+                url, GURL(), ContentSettingsType::BRAVE_SHIELDS));
+
+  provider.SetWebsiteSetting(
+      ContentSettingsPattern::FromString("[*.]brave.com"),
+      ContentSettingsPattern::Wildcard(), ContentSettingsType::BRAVE_SHIELDS,
+      ContentSettingToValue(CONTENT_SETTING_BLOCK), {});
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            provider.GetShieldsContentSetting(
+                url, GURL(), ContentSettingsType::BRAVE_SHIELDS));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            provider.GetShieldsContentSetting(
+                url2, GURL(), ContentSettingsType::BRAVE_SHIELDS));
+  EXPECT_EQ(CONTENT_SETTING_DEFAULT,
+            provider.GetShieldsContentSetting(
+                url3, GURL(), ContentSettingsType::BRAVE_SHIELDS));
+  EXPECT_EQ(CONTENT_SETTING_DEFAULT,
+            provider.GetShieldsContentSetting(
+                url, GURL(), ContentSettingsType::BRAVE_ADS));
+
+  // The more specific pattern is tried first, wherever it's indexed.
+  provider.SetWebsiteSetting(
+      ContentSettingsPattern::FromString("sub.brave.com"),
+      ContentSettingsPattern::Wildcard(), ContentSettingsType::BRAVE_SHIELDS,
+      ContentSettingToValue(CONTENT_SETTING_ALLOW), {});
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            provider.GetShieldsContentSetting(
+                url, GURL(), ContentSettingsType::BRAVE_SHIELDS));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            provider.GetShieldsContentSetting(
+                url2, GURL(), ContentSettingsType::BRAVE_SHIELDS));
+
+  // Secondary patterns have to match too.
+  provider.SetWebsiteSetting(
+      ContentSettingsPattern::FromString("[*.]example.com"),
+      ContentSettingsPattern::FromString("https://firstParty/*"),
+      ContentSettingsType::BRAVE_COOKIES,
+      ContentSettingToValue(CONTENT_SETTING_BLOCK), {});
+  EXPECT_EQ(CONTENT_SETTING_DEFAULT,
+            provider.GetShieldsContentSetting(
+                url3, GURL(), ContentSettingsType::BRAVE_COOKIES));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            provider.GetShieldsContentSetting(
+                url3, GURL("https://firstParty/"),
+                ContentSettingsType::BRAVE_COOKIES));
+
+  provider.ShutdownOnUIThread();
+}
+
 }  //  namespace content_settings
@@ -90,6 +90,10 @@ void BraveContentSettingsAgentImpl::DidCommitProvisionalLoad(
     ui::PageTransition transition) {
   temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
+  // The browser drops the areas when the tab leaves the storage domain, so
+  // each document asks for them again.
+  ephemeral_storage_top_origin_.reset();
+  ResetDocumentCache();
   ContentSettingsAgentImpl::DidCommitProvisionalLoad(transition);
 }
 
@@ -118,7 +122,7 @@ bool BraveContentSettingsAgentImpl::AllowScript(bool enabled_per_settings) {
   const GURL secondary_url(url::Origin(frame->GetSecurityOrigin()).GetURL());
 
   bool allow = ContentSettingsAgentImpl::AllowScript(enabled_per_settings);
-  allow = allow || IsBraveShieldsDown(frame, secondary_url) ||
+  allow = allow || GetDocumentShieldsState().shields_down ||
           IsScriptTemporilyAllowed(secondary_url);
 
   return allow;
@@ -153,10 +157,26 @@ bool BraveContentSettingsAgentImpl::UseEphemeralStorageSync(
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES))
     return false;
 
-  return  // block 3p
+  const bool use_ephemeral_storage =
+      // block 3p
       !ContentSettingsAgentImpl::AllowStorageAccessSync(storage_type) &&
       // allow 1p
       AllowStorageAccessForMainFrameSync(storage_type);
+  if (use_ephemeral_storage)
+    EnsureEphemeralStorageAreas(top_origin);
+
+  return use_ephemeral_storage;
+}
+
+void BraveContentSettingsAgentImpl::EnsureEphemeralStorageAreas(
+    const url::Origin& top_origin) {
+  if (ephemeral_storage_top_origin_ == top_origin)
+    return;
+
+  ephemeral_storage_top_origin_ = top_origin;
+  // Blocks until the browser has created the areas, as blink binds to them by
+  // id right after this returns.
+  GetOrCreateBraveShieldsRemote()->CreateEphemeralStorageAreas();
 }
 
 bool BraveContentSettingsAgentImpl::AllowStorageAccessSync(
@@ -210,7 +230,7 @@ bool BraveContentSettingsAgentImpl::AllowScriptFromSource(
       render_frame()->GetWebFrame()->GetDocument().Url());
 
   allow = allow || should_white_list ||
-          IsBraveShieldsDown(render_frame()->GetWebFrame(), secondary_url) ||
+          IsBraveShieldsDownForScript(secondary_url) ||
           IsScriptTemporilyAllowed(secondary_url);
 
   if (!allow) {
@@ -228,26 +248,19 @@ bool BraveContentSettingsAgentImpl::IsBraveShieldsDown(
              frame, secondary_url, content_setting_rules_->brave_shields_rules);
 }
 
-bool BraveContentSettingsAgentImpl::AllowFingerprinting(
-    bool enabled_per_settings) {
-  if (!enabled_per_settings)
-    return false;
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-  const GURL secondary_url(url::Origin(frame->GetSecurityOrigin()).GetURL());
-  if (IsBraveShieldsDown(frame, secondary_url)) {
-    return true;
-  }
-
-  return GetBraveFarblingLevel() != BraveFarblingLevel::MAXIMUM;
-}
+const BraveContentSettingsAgentImpl::DocumentShieldsState&
+BraveContentSettingsAgentImpl::GetDocumentShieldsState() {
+  MaybeResetDocumentCache();
+  if (document_shields_state_)
+    return *document_shields_state_;
 
-BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  const bool shields_down = IsBraveShieldsDown(
+      frame, url::Origin(frame->GetSecurityOrigin()).GetURL());
 
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
   if (content_setting_rules_) {
-    if (IsBraveShieldsDown(frame,
-                           url::Origin(frame->GetSecurityOrigin()).GetURL())) {
+    if (shields_down) {
       setting = CONTENT_SETTING_ALLOW;
     } else {
       setting = GetBraveFPContentSettingFromRules(
@@ -255,16 +268,66 @@ BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
     }
   }
 
+  BraveFarblingLevel farbling_level;
   if (setting == CONTENT_SETTING_BLOCK) {
     VLOG(1) << "farbling level MAXIMUM";
-    return BraveFarblingLevel::MAXIMUM;
+    farbling_level = BraveFarblingLevel::MAXIMUM;
   } else if (setting == CONTENT_SETTING_ALLOW) {
     VLOG(1) << "farbling level OFF";
-    return BraveFarblingLevel::OFF;
+    farbling_level = BraveFarblingLevel::OFF;
   } else {
     VLOG(1) << "farbling level BALANCED";
-    return BraveFarblingLevel::BALANCED;
+    farbling_level = BraveFarblingLevel::BALANCED;
   }
+
+  document_shields_state_ = DocumentShieldsState{shields_down, farbling_level};
+  return *document_shields_state_;
+}
+
+bool BraveContentSettingsAgentImpl::IsBraveShieldsDownForScript(
+    const GURL& script_url) {
+  // Patterns only look at the path for file: URLs, so anything other than
+  // http(s) is matched against the full URL every time.
+  if (!script_url.SchemeIsHTTPOrHTTPS())
+    return IsBraveShieldsDown(render_frame()->GetWebFrame(), script_url);
+
+  MaybeResetDocumentCache();
+  url::Origin script_origin = url::Origin::Create(script_url);
+  auto it = script_origin_shields_down_.find(script_origin);
+  if (it != script_origin_shields_down_.end())
+    return it->second;
+
+  const bool shields_down =
+      IsBraveShieldsDown(render_frame()->GetWebFrame(), script_url);
+  script_origin_shields_down_.emplace(std::move(script_origin), shields_down);
+  return shields_down;
+}
+
+void BraveContentSettingsAgentImpl::MaybeResetDocumentCache() {
+  if (document_cache_rules_ != content_setting_rules_)
+    ResetDocumentCache();
+}
+
+void BraveContentSettingsAgentImpl::ResetDocumentCache() {
+  document_shields_state_.reset();
+  document_autoplay_setting_.reset();
+  script_origin_shields_down_.clear();
+  document_cache_rules_ = content_setting_rules_;
+}
+
+bool BraveContentSettingsAgentImpl::AllowFingerprinting(
+    bool enabled_per_settings) {
+  if (!enabled_per_settings)
+    return false;
+  const DocumentShieldsState& state = GetDocumentShieldsState();
+  if (state.shields_down)
+    return true;
+
+  return state.farbling_level != BraveFarblingLevel::MAXIMUM;
+}
+
+BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
+  return GetDocumentShieldsState().farbling_level;
 }
 
 bool BraveContentSettingsAgentImpl::AllowAutoplay(bool play_requested) {
@@ -278,9 +341,13 @@ bool BraveContentSettingsAgentImpl::AllowAutoplay(bool play_requested) {
 
   // respect user's site blocklist, if any
   if (content_setting_rules_) {
-    ContentSetting setting =
-        GetContentSettingFromRules(content_setting_rules_->autoplay_rules,
-                                   frame, url::Origin(origin).GetURL());
+    MaybeResetDocumentCache();
+    if (!document_autoplay_setting_) {
+      document_autoplay_setting_ =
+          GetContentSettingFromRules(content_setting_rules_->autoplay_rules,
+                                     frame, url::Origin(origin).GetURL());
+    }
+    const ContentSetting setting = *document_autoplay_setting_;
     if (setting == CONTENT_SETTING_BLOCK) {
       VLOG(1) << "AllowAutoplay=false because rule=CONTENT_SETTING_BLOCK";
       if (play_requested)
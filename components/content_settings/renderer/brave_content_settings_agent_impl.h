@@ -13,6 +13,7 @@
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
+#include "base/optional.h"
 #include "brave/components/brave_shields/common/brave_shields.mojom.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "components/content_settings/core/common/content_settings.h"
@@ -23,6 +24,7 @@
 #include "mojo/public/cpp/bindings/pending_associated_receiver.h"
 
 #include "url/gurl.h"
+#include "url/origin.h"
 
 namespace blink {
 class WebLocalFrame;
@@ -67,11 +69,29 @@ class BraveContentSettingsAgentImpl
       const blink::WebFrame* frame,
       const GURL& secondary_url);
 
+  // Shields state of the committed document, keyed off its top and frame
+  // origins. Both are fixed until the next commit, so this is worked out once
+  // rather than on every farbled API call.
+  struct DocumentShieldsState {
+    bool shields_down;
+    BraveFarblingLevel farbling_level;
+  };
+  const DocumentShieldsState& GetDocumentShieldsState();
+  bool IsBraveShieldsDownForScript(const GURL& script_url);
+  // Drops the per-document results if the rules have been swapped since they
+  // were computed.
+  void MaybeResetDocumentCache();
+  void ResetDocumentCache();
+
   // RenderFrameObserver
   void DidCommitProvisionalLoad(ui::PageTransition transition) override;
 
   bool IsScriptTemporilyAllowed(const GURL& script_url);
   bool AllowStorageAccessForMainFrameSync(StorageType storage_type);
+  // The browser process only creates the ephemeral storage areas of a tab
+  // once a third-party frame asks for them, which this does once per
+  // document and top frame origin.
+  void EnsureEphemeralStorageAreas(const url::Origin& top_origin);
 
   // brave_shields::mojom::BraveShields.
   void SetAllowScriptsFromOriginsOnce(
@@ -99,6 +119,18 @@ class BraveContentSettingsAgentImpl
   using StoragePermissionsKey = std::pair<url::Origin, StorageType>;
   base::flat_map<StoragePermissionsKey, bool> cached_storage_permissions_;
 
+  // Top frame origin which the ephemeral storage areas were last requested
+  // for by the current document.
+  base::Optional<url::Origin> ephemeral_storage_top_origin_;
+
+  // Per-document results, reset on commit and whenever the rules are swapped
+  // for new ones.
+  base::Optional<DocumentShieldsState> document_shields_state_;
+  base::Optional<ContentSetting> document_autoplay_setting_;
+  // Whether shields are down for scripts from an http(s) origin.
+  base::flat_map<url::Origin, bool> script_origin_shields_down_;
+  const RendererContentSettingRules* document_cache_rules_ = nullptr;
+
   mojo::AssociatedRemote<brave_shields::mojom::BraveShieldsHost>
       brave_shields_remote_;
 
@@ -5,17 +5,139 @@
 
 #include "brave/components/cosmetic_filters/browser/cosmetic_filters_resources.h"
 
+#include <string>
 #include <utility>
+#include <vector>
 
-#include "base/json/json_reader.h"
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
 #include "base/optional.h"
+#include "base/time/time.h"
 #include "base/values.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "url/gurl.h"
 
 namespace cosmetic_filters {
 
+namespace {
+
+std::vector<std::string> ToStringList(const base::Value* list) {
+  std::vector<std::string> strings;
+  if (!list || !list->is_list())
+    return strings;
+  strings.reserve(list->GetList().size());
+  for (const auto& item : list->GetList()) {
+    if (item.is_string())
+      strings.push_back(item.GetString());
+  }
+  return strings;
+}
+
+// Converts the ad block engines' resources to the mojom struct on the ad
+// block task runner, so that neither the UI thread nor the renderer has to
+// walk them as a base::Value.
+mojom::UrlCosmeticResourcesPtr GetUrlCosmeticResources(
+    brave_shields::AdBlockService* ad_block_service,
+    const std::string& url) {
+  const base::TimeTicks start = base::TimeTicks::Now();
+  base::Optional<base::Value> value =
+      ad_block_service->UrlCosmeticResources(url);
+  UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+      "Brave.Shields.UrlCosmeticResourcesTime", base::TimeTicks::Now() - start,
+      base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+      50);
+  if (!value || !value->is_dict())
+    return nullptr;
+
+  auto resources = mojom::UrlCosmeticResources::New();
+  resources->hide_selectors =
+      ToStringList(value->FindListKey("hide_selectors"));
+  resources->force_hide_selectors =
+      ToStringList(value->FindListKey("force_hide_selectors"));
+  resources->exceptions = ToStringList(value->FindListKey("exceptions"));
+
+  const base::Value* style_selectors = value->FindDictKey("style_selectors");
+  if (style_selectors) {
+    for (const auto& item : style_selectors->DictItems()) {
+      resources->style_selectors.emplace(item.first,
+                                         ToStringList(&item.second));
+    }
+  }
+
+  const std::string* injected_script =
+      value->FindStringKey("injected_script");
+  if (injected_script)
+    resources->injected_script = *injected_script;
+  resources->generichide = value->FindBoolKey("generichide").value_or(false);
+  return resources;
+}
+
+constexpr size_t kUrlCosmeticResourcesCacheSize = 64;
+
+// Recent UrlCosmeticResources results by hostname, so that the many frames of
+// a page don't each make the engines look the same host up. Cleared whenever
+// any ad block engine changes. Only used on the ad block task runner.
+class UrlCosmeticResourcesCache {
+ public:
+  static UrlCosmeticResourcesCache* GetInstance() {
+    static base::NoDestructor<UrlCosmeticResourcesCache> instance;
+    return instance.get();
+  }
+
+  mojom::UrlCosmeticResourcesPtr Get(
+      brave_shields::AdBlockService* ad_block_service,
+      const std::string& url) {
+    DCHECK(ad_block_service->GetTaskRunner()->RunsTasksInCurrentSequence());
+    // The engines only look at the host, apart from $generichide exceptions,
+    // which in practice are written per domain too.
+    const std::string host = GURL(url).host();
+    if (host.empty())
+      return GetUrlCosmeticResources(ad_block_service, url);
+
+    const uint64_t generation =
+        brave_shields::AdBlockBaseService::GetEngineGeneration();
+    if (generation != generation_) {
+      entries_.Clear();
+      generation_ = generation;
+    }
+
+    auto it = entries_.Get(host);
+    if (it != entries_.end())
+      return it->second.Clone();
+
+    mojom::UrlCosmeticResourcesPtr resources =
+        GetUrlCosmeticResources(ad_block_service, url);
+    // Filter list changes on the UI thread may race with the lookup.
+    if (brave_shields::AdBlockBaseService::GetEngineGeneration() == generation)
+      entries_.Put(host, resources.Clone());
+    return resources;
+  }
+
+ private:
+  friend class base::NoDestructor<UrlCosmeticResourcesCache>;
+
+  UrlCosmeticResourcesCache() : entries_(kUrlCosmeticResourcesCacheSize) {}
+  ~UrlCosmeticResourcesCache() = default;
+
+  base::HashingMRUCache<std::string, mojom::UrlCosmeticResourcesPtr> entries_;
+  uint64_t generation_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(UrlCosmeticResourcesCache);
+};
+
+mojom::UrlCosmeticResourcesPtr GetCachedUrlCosmeticResources(
+    brave_shields::AdBlockService* ad_block_service,
+    const std::string& url) {
+  return UrlCosmeticResourcesCache::GetInstance()->Get(ad_block_service, url);
+}
+
+}  // namespace
+
 CosmeticFiltersResources::CosmeticFiltersResources(
     HostContentSettingsMap* settings_map,
     brave_shields::AdBlockService* ad_block_service)
@@ -26,43 +148,10 @@ CosmeticFiltersResources::CosmeticFiltersResources(
 CosmeticFiltersResources::~CosmeticFiltersResources() {}
 
 void CosmeticFiltersResources::HiddenClassIdSelectors(
-    const std::string& input,
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
     const std::vector<std::string>& exceptions,
     HiddenClassIdSelectorsCallback callback) {
-  base::Optional<base::Value> input_value = base::JSONReader::Read(input);
-  if (!input_value || !input_value->is_dict()) {
-    // Nothing to work with
-    std::move(callback).Run(base::Value());
-
-    return;
-  }
-  base::DictionaryValue* input_dict;
-  if (!input_value->GetAsDictionary(&input_dict)) {
-    std::move(callback).Run(base::Value());
-
-    return;
-  }
-  std::vector<std::string> classes;
-  base::ListValue* classes_list;
-  if (input_dict->GetList("classes", &classes_list)) {
-    for (size_t i = 0; i < classes_list->GetSize(); i++) {
-      if (!classes_list->GetList()[i].is_string()) {
-        continue;
-      }
-      classes.push_back(classes_list->GetList()[i].GetString());
-    }
-  }
-  std::vector<std::string> ids;
-  base::ListValue* ids_list;
-  if (input_dict->GetList("ids", &ids_list)) {
-    for (size_t i = 0; i < ids_list->GetSize(); i++) {
-      if (!ids_list->GetList()[i].is_string()) {
-        continue;
-      }
-      ids.push_back(ids_list->GetList()[i].GetString());
-    }
-  }
-
   ad_block_service_->GetTaskRunner()->PostTaskAndReplyWithResult(
       FROM_HERE,
       base::BindOnce(&brave_shields::AdBlockService::HiddenClassIdSelectors,
@@ -81,9 +170,8 @@ void CosmeticFiltersResources::HiddenClassIdSelectorsOnUI(
 
 void CosmeticFiltersResources::UrlCosmeticResourcesOnUI(
     UrlCosmeticResourcesCallback callback,
-    base::Optional<base::Value> resources) {
-  std::move(callback).Run(resources ? std::move(resources.value())
-                                    : base::Value());
+    mojom::UrlCosmeticResourcesPtr resources) {
+  std::move(callback).Run(std::move(resources));
 }
 
 void CosmeticFiltersResources::ShouldDoCosmeticFiltering(
@@ -102,7 +190,7 @@ void CosmeticFiltersResources::UrlCosmeticResources(
     UrlCosmeticResourcesCallback callback) {
   ad_block_service_->GetTaskRunner()->PostTaskAndReplyWithResult(
       FROM_HERE,
-      base::BindOnce(&brave_shields::AdBlockService::UrlCosmeticResources,
+      base::BindOnce(&GetCachedUrlCosmeticResources,
                      base::Unretained(ad_block_service_), url),
       base::BindOnce(&CosmeticFiltersResources::UrlCosmeticResourcesOnUI,
                      weak_factory_.GetWeakPtr(), std::move(callback)));
@@ -8,16 +8,21 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/containers/mru_cache.h"
+#include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
+#include "base/json/string_escape.h"
 #include "base/no_destructor.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
 #include "brave/components/cosmetic_filters/resources/grit/cosmetic_filters_generated_map.h"
 #include "content/public/renderer/render_frame.h"
 #include "gin/arguments.h"
 #include "gin/function_template.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "third_party/blink/public/common/browser_interface_broker_proxy.h"
+#include "third_party/blink/public/platform/task_type.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/public/web/web_script_source.h"
@@ -181,10 +186,84 @@ bool IsVettedSearchEngine(const GURL& url) {
   return false;
 }
 
+constexpr size_t kRendererResourcesCacheSize = 16;
+// Short enough that a filter list update reaches new frames quickly.
+constexpr base::TimeDelta kRendererResourcesCacheTtl =
+    base::TimeDelta::FromSeconds(30);
+
+struct CachedUrlCosmeticResources {
+  // Null if the engines had nothing for the host.
+  scoped_refptr<const cosmetic_filters::CompiledCosmeticResources> resources;
+  base::TimeTicks fetch_time;
+};
+
+// UrlCosmeticResources results recently received by this renderer process,
+// by hostname, so that same-site frames don't each ask the browser for them.
+// Only used on the main thread.
+base::HashingMRUCache<std::string, CachedUrlCosmeticResources>&
+GetRendererResourcesCache() {
+  static base::NoDestructor<
+      base::HashingMRUCache<std::string, CachedUrlCosmeticResources>>
+      cache(kRendererResourcesCacheSize);
+  return *cache;
+}
+
+// How long to collect class and id names from the observing script before
+// sending them to the browser in one request.
+constexpr base::TimeDelta kHiddenClassIdSelectorsBatchDelay =
+    base::TimeDelta::FromMilliseconds(50);
+// Upper bound on the names remembered per document, so that pages generating
+// unique class names can't grow the sets without limit. Once reached, names
+// may be queried again, which is harmless.
+constexpr size_t kMaxQueriedNames = 10000;
+
+// Formats |strings| as a JSON array literal for the injected scripts.
+std::string ToJSONList(const std::vector<std::string>& strings) {
+  std::string json = "[";
+  for (const auto& string : strings) {
+    if (json.size() > 1)
+      json += ',';
+    base::EscapeJSONString(string, true, &json);
+  }
+  json += ']';
+  return json;
+}
+
 }  // namespace
 
 namespace cosmetic_filters {
 
+CompiledCosmeticResources::CompiledCosmeticResources(
+    const mojom::UrlCosmeticResources& resources)
+    : exceptions_(resources.exceptions),
+      injected_script_(resources.injected_script),
+      generichide_(resources.generichide) {
+  if (!resources.hide_selectors.empty()) {
+    hide_selectors_script_ =
+        base::StringPrintf(kHideSelectorsInjectScript,
+                           ToJSONList(resources.hide_selectors).c_str());
+  }
+  if (!resources.force_hide_selectors.empty()) {
+    force_hide_selectors_script_ =
+        base::StringPrintf(kForceHideSelectorsInjectScript,
+                           ToJSONList(resources.force_hide_selectors).c_str());
+  }
+
+  std::string json_style_selectors = "{";
+  for (const auto& style_selector : resources.style_selectors) {
+    if (json_style_selectors.size() > 1)
+      json_style_selectors += ',';
+    base::EscapeJSONString(style_selector.first, true, &json_style_selectors);
+    json_style_selectors += ':';
+    json_style_selectors += ToJSONList(style_selector.second);
+  }
+  json_style_selectors += '}';
+  style_selectors_script_ = base::StringPrintf(kStyleSelectorsInjectScript,
+                                               json_style_selectors.c_str());
+}
+
+CompiledCosmeticResources::~CompiledCosmeticResources() = default;
+
 CosmeticFiltersJSHandler::CosmeticFiltersJSHandler(
     content::RenderFrame* render_frame,
     const int32_t isolated_world_id)
@@ -201,11 +280,71 @@ CosmeticFiltersJSHandler::~CosmeticFiltersJSHandler() = default;
 
 void CosmeticFiltersJSHandler::HiddenClassIdSelectors(
     const std::string& input) {
-  if (!EnsureConnected())
+  base::Optional<base::Value> input_value = base::JSONReader::Read(input);
+  if (!input_value || !input_value->is_dict())
     return;
 
+  QueueUnseenNames(input_value->FindListKey("classes"), queried_classes_,
+                   &pending_classes_);
+  QueueUnseenNames(input_value->FindListKey("ids"), queried_ids_,
+                   &pending_ids_);
+  if ((pending_classes_.empty() && pending_ids_.empty()) ||
+      flush_timer_.IsRunning())
+    return;
+
+  flush_timer_.SetTaskRunner(
+      render_frame_->GetTaskRunner(blink::TaskType::kInternalDefault));
+  flush_timer_.Start(
+      FROM_HERE, kHiddenClassIdSelectorsBatchDelay,
+      base::BindOnce(&CosmeticFiltersJSHandler::FlushHiddenClassIdSelectors,
+                     base::Unretained(this)));
+}
+
+void CosmeticFiltersJSHandler::QueueUnseenNames(
+    const base::Value* list,
+    const std::unordered_set<std::string>& seen,
+    std::unordered_set<std::string>* pending) {
+  if (!list)
+    return;
+
+  for (const auto& name : list->GetList()) {
+    if (!name.is_string() || name.GetString().empty())
+      continue;
+    if (pending->size() >= kMaxQueriedNames)
+      return;
+    if (!seen.count(name.GetString()))
+      pending->insert(name.GetString());
+  }
+}
+
+// static
+std::vector<std::string> CosmeticFiltersJSHandler::MarkNamesSeen(
+    std::unordered_set<std::string>* pending,
+    std::unordered_set<std::string>* seen) {
+  std::vector<std::string> names;
+  names.reserve(pending->size());
+  for (const auto& name : *pending) {
+    if (seen->size() >= kMaxQueriedNames)
+      seen->clear();
+    seen->insert(name);
+    names.push_back(name);
+  }
+  pending->clear();
+  return names;
+}
+
+void CosmeticFiltersJSHandler::FlushHiddenClassIdSelectors() {
+  if ((pending_classes_.empty() && pending_ids_.empty()) ||
+      !EnsureConnected()) {
+    // Still unseen; they are sent with the next batch.
+    return;
+  }
+
+  std::vector<std::string> classes =
+      MarkNamesSeen(&pending_classes_, &queried_classes_);
+  std::vector<std::string> ids = MarkNamesSeen(&pending_ids_, &queried_ids_);
   cosmetic_filters_resources_->HiddenClassIdSelectors(
-      input, exceptions_,
+      classes, ids, exceptions_,
       base::BindOnce(&CosmeticFiltersJSHandler::OnHiddenClassIdSelectors,
                      base::Unretained(this)));
 }
@@ -276,7 +415,12 @@ bool CosmeticFiltersJSHandler::EnsureConnected() {
 
 void CosmeticFiltersJSHandler::ProcessURL(const GURL& url,
                                           base::OnceClosure callback) {
-  resources_dict_.reset();
+  resources_.reset();
+  flush_timer_.Stop();
+  queried_classes_.clear();
+  queried_ids_.clear();
+  pending_classes_.clear();
+  pending_ids_.clear();
   url_ = url;
   // Trivially, don't make exceptions for malformed URLs.
   if (!EnsureConnected() || url_.is_empty() || !url_.is_valid())
@@ -296,33 +440,54 @@ void CosmeticFiltersJSHandler::OnShouldDoCosmeticFiltering(
     return;
 
   enabled_1st_party_cf_ = first_party_enabled;
+
+  auto& cache = GetRendererResourcesCache();
+  auto it = cache.Get(url_.host());
+  if (it != cache.end()) {
+    if (base::TimeTicks::Now() - it->second.fetch_time <
+        kRendererResourcesCacheTtl) {
+      resources_ = it->second.resources;
+      std::move(callback).Run();
+      return;
+    }
+    cache.Erase(it);
+  }
+
   cosmetic_filters_resources_->UrlCosmeticResources(
       url_.spec(),
       base::BindOnce(&CosmeticFiltersJSHandler::OnUrlCosmeticResources,
-                     base::Unretained(this), std::move(callback)));
+                     base::Unretained(this), url_.host(), std::move(callback)));
 }
 
 void CosmeticFiltersJSHandler::OnUrlCosmeticResources(
+    const std::string& host,
     base::OnceClosure callback,
-    base::Value result) {
-  resources_dict_ = base::DictionaryValue::From(
-      base::Value::ToUniquePtrValue(std::move(result)));
+    mojom::UrlCosmeticResourcesPtr resources) {
+  scoped_refptr<const CompiledCosmeticResources> compiled =
+      resources ? base::MakeRefCounted<CompiledCosmeticResources>(*resources)
+                : nullptr;
+  // Cache under the host the resources were requested for; the frame may
+  // have navigated elsewhere since.
+  if (!host.empty()) {
+    GetRendererResourcesCache().Put(
+        host, CachedUrlCosmeticResources{compiled, base::TimeTicks::Now()});
+  }
+  if (url_.host() != host)
+    return;
+
+  resources_ = std::move(compiled);
   std::move(callback).Run();
 }
 
 void CosmeticFiltersJSHandler::ApplyRules() {
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  if (!resources_dict_ || web_frame->IsProvisional())
+  if (!resources_ || web_frame->IsProvisional())
     return;
 
-  std::string scriptlet_script;
-  base::Value* injected_script = resources_dict_->FindPath("injected_script");
-  if (injected_script &&
-      base::JSONWriter::Write(*injected_script, &scriptlet_script)) {
-    scriptlet_script =
-        base::StringPrintf(kScriptletInitScript, scriptlet_script.c_str());
-  }
-  if (!scriptlet_script.empty()) {
+  if (!resources_->injected_script().empty()) {
+    std::string scriptlet_script = base::StringPrintf(
+        kScriptletInitScript,
+        base::GetQuotedJSONString(resources_->injected_script()).c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(scriptlet_script));
   }
@@ -330,11 +495,9 @@ void CosmeticFiltersJSHandler::ApplyRules() {
     return;
 
   // Working on css rules, we do that on a main frame only
-  bool generichide = false;
-  resources_dict_->GetBoolean("generichide", &generichide);
   std::string cosmetic_filtering_init_script = base::StringPrintf(
       kCosmeticFilteringInitScript, enabled_1st_party_cf_ ? "true" : "false",
-      generichide ? "true" : "false");
+      resources_->generichide() ? "true" : "false");
   std::string pre_init_script = base::StringPrintf(
       kPreInitScript, cosmetic_filtering_init_script.c_str());
 
@@ -343,75 +506,35 @@ void CosmeticFiltersJSHandler::ApplyRules() {
   web_frame->ExecuteScriptInIsolatedWorld(
       isolated_world_id_, blink::WebString::FromUTF8(*g_observing_script));
 
-  CSSRulesRoutine(resources_dict_.get());
+  CSSRulesRoutine(*resources_);
 }
 
 void CosmeticFiltersJSHandler::CSSRulesRoutine(
-    base::DictionaryValue* resources_dict) {
+    const CompiledCosmeticResources& resources) {
   // Otherwise, if its a vetted engine AND we're not in aggressive
   // mode, also don't do cosmetic filtering.
   if (!enabled_1st_party_cf_ && IsVettedSearchEngine(url_))
     return;
 
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  base::ListValue* cf_exceptions_list;
-  if (resources_dict->GetList("exceptions", &cf_exceptions_list)) {
-    for (size_t i = 0; i < cf_exceptions_list->GetSize(); i++) {
-      exceptions_.push_back(cf_exceptions_list->GetList()[i].GetString());
-    }
-  }
-  base::ListValue* hide_selectors_list;
-  if (!resources_dict->GetList("hide_selectors", &hide_selectors_list)) {
-    hide_selectors_list = nullptr;
-  }
-  base::ListValue* force_hide_selectors_list;
-  if (!resources_dict->GetList("force_hide_selectors",
-                               &force_hide_selectors_list)) {
-    force_hide_selectors_list = nullptr;
-  }
+  exceptions_.insert(exceptions_.end(), resources.exceptions().begin(),
+                     resources.exceptions().end());
 
-  if (hide_selectors_list && hide_selectors_list->GetSize() != 0) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*hide_selectors_list, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
-    // Building a script for stylesheet modifications
-    std::string new_selectors_script =
-        base::StringPrintf(kHideSelectorsInjectScript, json_selectors.c_str());
+  if (!resources.hide_selectors_script().empty()) {
     web_frame->ExecuteScriptInIsolatedWorld(
-        isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script));
+        isolated_world_id_,
+        blink::WebString::FromUTF8(resources.hide_selectors_script()));
   }
 
-  if (force_hide_selectors_list && force_hide_selectors_list->GetSize() != 0) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*force_hide_selectors_list, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
-    // Building a script for stylesheet modifications
-    std::string new_selectors_script = base::StringPrintf(
-        kForceHideSelectorsInjectScript, json_selectors.c_str());
+  if (!resources.force_hide_selectors_script().empty()) {
     web_frame->ExecuteScriptInIsolatedWorld(
-        isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script));
+        isolated_world_id_,
+        blink::WebString::FromUTF8(resources.force_hide_selectors_script()));
   }
 
-  base::DictionaryValue* style_selectors_dictionary = nullptr;
-  if (resources_dict->GetDictionary("style_selectors",
-                                    &style_selectors_dictionary)) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*style_selectors_dictionary,
-                                 &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
-    std::string new_selectors_script =
-        base::StringPrintf(kStyleSelectorsInjectScript, json_selectors.c_str());
-    if (!json_selectors.empty()) {
-      web_frame->ExecuteScriptInIsolatedWorld(
-          isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script));
-    }
-  }
+  web_frame->ExecuteScriptInIsolatedWorld(
+      isolated_world_id_,
+      blink::WebString::FromUTF8(resources.style_selectors_script()));
 
   if (!enabled_1st_party_cf_) {
     web_frame->ExecuteScriptInIsolatedWorld(
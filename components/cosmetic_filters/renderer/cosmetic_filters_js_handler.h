@@ -8,8 +8,12 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/timer/timer.h"
 #include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
@@ -19,6 +23,44 @@
 
 namespace cosmetic_filters {
 
+// The parts of a mojom::UrlCosmeticResources that frames use, with the
+// stylesheet injection scripts already built. Immutable once created, so one
+// instance is shared by every frame of a host instead of each frame
+// formatting the selector lists again.
+class CompiledCosmeticResources
+    : public base::RefCounted<CompiledCosmeticResources> {
+ public:
+  explicit CompiledCosmeticResources(
+      const mojom::UrlCosmeticResources& resources);
+
+  const std::vector<std::string>& exceptions() const { return exceptions_; }
+  const std::string& injected_script() const { return injected_script_; }
+  bool generichide() const { return generichide_; }
+  // The hide scripts are empty when there are no selectors of that kind.
+  const std::string& hide_selectors_script() const {
+    return hide_selectors_script_;
+  }
+  const std::string& force_hide_selectors_script() const {
+    return force_hide_selectors_script_;
+  }
+  const std::string& style_selectors_script() const {
+    return style_selectors_script_;
+  }
+
+ private:
+  friend class base::RefCounted<CompiledCosmeticResources>;
+  ~CompiledCosmeticResources();
+
+  std::vector<std::string> exceptions_;
+  std::string injected_script_;
+  bool generichide_;
+  std::string hide_selectors_script_;
+  std::string force_hide_selectors_script_;
+  std::string style_selectors_script_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompiledCosmeticResources);
+};
+
 // CosmeticFiltersJSHandler class is responsible for JS execution inside a
 // a given render_frame. It also does interactions with CosmeticFiltersResources
 // class that lives in the main process.
@@ -51,12 +93,23 @@ class CosmeticFiltersJSHandler {
 
   // A function to be called from JS
   void HiddenClassIdSelectors(const std::string& input);
+  // Queues the names in |list| that this frame hasn't asked about yet.
+  void QueueUnseenNames(const base::Value* list,
+                        const std::unordered_set<std::string>& seen,
+                        std::unordered_set<std::string>* pending);
+  // Moves the names in |pending| into |seen| once they are being sent.
+  static std::vector<std::string> MarkNamesSeen(
+      std::unordered_set<std::string>* pending,
+      std::unordered_set<std::string>* seen);
+  void FlushHiddenClassIdSelectors();
 
   void OnShouldDoCosmeticFiltering(base::OnceClosure callback,
                                    bool enabled,
                                    bool first_party_enabled);
-  void OnUrlCosmeticResources(base::OnceClosure callback, base::Value result);
-  void CSSRulesRoutine(base::DictionaryValue* resources_dict);
+  void OnUrlCosmeticResources(const std::string& host,
+                              base::OnceClosure callback,
+                              mojom::UrlCosmeticResourcesPtr resources);
+  void CSSRulesRoutine(const CompiledCosmeticResources& resources);
   void OnHiddenClassIdSelectors(base::Value result);
 
   content::RenderFrame* render_frame_;
@@ -66,7 +119,18 @@ class CosmeticFiltersJSHandler {
   bool enabled_1st_party_cf_;
   std::vector<std::string> exceptions_;
   GURL url_;
-  std::unique_ptr<base::DictionaryValue> resources_dict_;
+  scoped_refptr<const CompiledCosmeticResources> resources_;
+  // Class and id names already sent to the browser for the current document.
+  // The observing script is re-injected after every batch of results, and
+  // each injection starts with empty sets of its own, so this is what keeps
+  // the same names from being queried over and over.
+  std::unordered_set<std::string> queried_classes_;
+  std::unordered_set<std::string> queried_ids_;
+  // Names waiting for the next batch. They only become "queried" once the
+  // batch is actually sent.
+  std::unordered_set<std::string> pending_classes_;
+  std::unordered_set<std::string> pending_ids_;
+  base::OneShotTimer flush_timer_;
 };
 
 // static
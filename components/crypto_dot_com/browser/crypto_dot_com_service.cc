@@ -34,6 +34,7 @@ namespace {
 const char root_host[] = "crypto.com";
 const char api_host[] = "api.crypto.com";
 const unsigned int kRetriesCountOnNetworkChange = 1;
+constexpr base::TimeDelta kResponseCacheTTL = base::TimeDelta::FromSeconds(30);
 
 net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
   return net::DefineNetworkTrafficAnnotation("crypto_dot_com_service", R"(
@@ -73,6 +74,7 @@ CryptoDotComService::CryptoDotComService(content::BrowserContext* context)
       url_loader_factory_(
           content::BrowserContext::GetDefaultStoragePartition(context_)
               ->GetURLLoaderFactoryForBrowserProcess()),
+      response_cache_(kResponseCacheTTL),
       weak_factory_(this) {
 }
 
@@ -85,8 +87,7 @@ bool CryptoDotComService::GetTickerInfo(const std::string& asset,
       base::Unretained(this), std::move(callback));
   GURL url = GetURLWithPath(api_host, get_ticker_info_path);
   url = net::AppendQueryParameter(url, "instrument_name", asset);
-  return NetworkRequest(
-      url, "GET", "", std::move(internal_callback));
+  return CachedGetRequest(url, std::move(internal_callback));
 }
 
 void CryptoDotComService::OnTickerInfo(
@@ -109,8 +110,7 @@ bool CryptoDotComService::GetChartData(const std::string& asset,
   url = net::AppendQueryParameter(url, "instrument_name", asset);
   url = net::AppendQueryParameter(url, "timeframe", "4h");
   url = net::AppendQueryParameter(url, "depth", "42");
-  return NetworkRequest(
-      url, "GET", "", std::move(internal_callback));
+  return CachedGetRequest(url, std::move(internal_callback));
 }
 
 void CryptoDotComService::OnChartData(
@@ -131,8 +131,7 @@ bool CryptoDotComService::GetSupportedPairs(
       &CryptoDotComService::OnSupportedPairs,
       base::Unretained(this), std::move(callback));
   GURL url = GetURLWithPath(api_host, get_pairs_path);
-  return NetworkRequest(
-      url, "GET", "", std::move(internal_callback));
+  return CachedGetRequest(url, std::move(internal_callback));
 }
 
 void CryptoDotComService::OnSupportedPairs(
@@ -153,8 +152,7 @@ bool CryptoDotComService::GetAssetRankings(
       &CryptoDotComService::OnAssetRankings,
       base::Unretained(this), std::move(callback));
   GURL url = GetURLWithPath(root_host, get_gainers_losers_path);
-  return NetworkRequest(
-      url, "GET", "", std::move(internal_callback));
+  return CachedGetRequest(url, std::move(internal_callback));
 }
 
 void CryptoDotComService::OnAssetRankings(
@@ -207,6 +205,17 @@ bool CryptoDotComService::NetworkRequest(const GURL &url,
   return true;
 }
 
+bool CryptoDotComService::CachedGetRequest(const GURL& url,
+                                           URLRequestCallback callback) {
+  if (!response_cache_.AddRequest(url, std::move(callback)))
+    return true;
+
+  return NetworkRequest(
+      url, "GET", "",
+      base::BindOnce(&ntp_widget_utils::ResponseCache::OnResponse,
+                     base::Unretained(&response_cache_), url));
+}
+
 void CryptoDotComService::OnURLLoaderComplete(
     SimpleURLLoaderList::iterator iter,
     URLRequestCallback callback,
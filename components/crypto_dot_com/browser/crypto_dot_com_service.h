@@ -19,6 +19,7 @@
 #include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/scoped_observer.h"
+#include "brave/components/ntp_widget_utils/browser/ntp_widget_utils_response_cache.h"
 #include "components/keyed_service/core/keyed_service.h"
 #include "url/gurl.h"
 
@@ -95,6 +96,9 @@ class CryptoDotComService : public KeyedService {
 
   bool NetworkRequest(const GURL& url, const std::string& method,
       const std::string& post_data, URLRequestCallback callback);
+  // Market data is the same for every new tab page, so GET requests share
+  // recent and in-flight responses.
+  bool CachedGetRequest(const GURL& url, URLRequestCallback callback);
   void OnURLLoaderComplete(
       SimpleURLLoaderList::iterator iter,
       URLRequestCallback callback,
@@ -105,6 +109,7 @@ class CryptoDotComService : public KeyedService {
   content::BrowserContext* context_;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   SimpleURLLoaderList url_loaders_;
+  ntp_widget_utils::ResponseCache response_cache_;
   base::WeakPtrFactory<CryptoDotComService> weak_factory_;
 
   friend class CryptoDotComAPIBrowserTest;
@@ -14,6 +14,7 @@ declare namespace TorInternals {
     torPid: number,
     torProxyURI: string,
     isTorConnected: boolean,
-    torInitPercentage: string
+    torInitPercentage: string,
+    streamConnectTimeMs: number
   }
 }
@@ -13,6 +13,7 @@
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
 #include "base/task_runner_util.h"
+#include "base/time/time.h"
 #include "brave/components/ftx/browser/ftx_json_parser.h"
 #include "brave/components/ftx/common/pref_names.h"
 #include "brave/components/ntp_widget_utils/browser/ntp_widget_utils_oauth.h"
@@ -33,6 +34,7 @@ namespace {
 const char api_host[] = "ftx.com";
 const char oauth_callback[] = "com.brave.ftx://authorization";
 const unsigned int kRetriesCountOnNetworkChange = 1;
+constexpr base::TimeDelta kResponseCacheTTL = base::TimeDelta::FromSeconds(30);
 
 net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
   return net::DefineNetworkTrafficAnnotation("ftx_service", R"(
@@ -78,6 +80,7 @@ FTXService::FTXService(content::BrowserContext* context)
       url_loader_factory_(
           content::BrowserContext::GetDefaultStoragePartition(context_)
               ->GetURLLoaderFactoryForBrowserProcess()),
+      response_cache_(kResponseCacheTTL),
       weak_factory_(this) {
   PrefService* prefs = user_prefs::UserPrefs::Get(context);
   // Get access token from prefs
@@ -104,8 +107,7 @@ bool FTXService::GetFuturesData(GetFuturesDataCallback callback) {
   auto internal_callback = base::BindOnce(
       &FTXService::OnFuturesData, base::Unretained(this), std::move(callback));
   GURL url = GetURLWithPath(api_host, get_futures_data_path);
-  return NetworkRequest(url, "GET", "", "",
-      std::move(internal_callback), false);
+  return CachedGetRequest(url, std::move(internal_callback));
 }
 
 void FTXService::OnFuturesData(
@@ -136,8 +138,7 @@ bool FTXService::GetChartData(const std::string& symbol,
   if (!end.empty()) {
     url = net::AppendQueryParameter(url, "end_time", end);
   }
-  return NetworkRequest(url, "GET", "", "",
-      std::move(internal_callback), false);
+  return CachedGetRequest(url, std::move(internal_callback));
 }
 
 void FTXService::OnChartData(
@@ -365,6 +366,18 @@ bool FTXService::NetworkRequest(const GURL& url,
   return true;
 }
 
+bool FTXService::CachedGetRequest(const GURL& url,
+                                  URLRequestCallback callback) {
+  if (!response_cache_.AddRequest(url, std::move(callback)))
+    return true;
+
+  return NetworkRequest(
+      url, "GET", "", "",
+      base::BindOnce(&ntp_widget_utils::ResponseCache::OnResponse,
+                     base::Unretained(&response_cache_), url),
+      false);
+}
+
 void FTXService::OnURLLoaderComplete(
     SimpleURLLoaderList::iterator iter,
     URLRequestCallback callback,
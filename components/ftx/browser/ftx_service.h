@@ -19,6 +19,7 @@
 #include "base/macros.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "brave/components/ntp_widget_utils/browser/ntp_widget_utils_response_cache.h"
 #include "components/keyed_service/core/keyed_service.h"
 #include "url/gurl.h"
 
@@ -146,6 +147,9 @@ class FTXService : public KeyedService {
                       const std::string& post_data_type,
                       URLRequestCallback callback,
                       bool set_auth_header);
+  // Market data is the same for every new tab page, so unauthenticated GET
+  // requests share recent and in-flight responses.
+  bool CachedGetRequest(const GURL& url, URLRequestCallback callback);
   void OnURLLoaderComplete(SimpleURLLoaderList::iterator iter,
                            URLRequestCallback callback,
                            const std::unique_ptr<std::string> response_body);
@@ -159,6 +163,7 @@ class FTXService : public KeyedService {
   content::BrowserContext* context_;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   SimpleURLLoaderList url_loaders_;
+  ntp_widget_utils::ResponseCache response_cache_;
   base::WeakPtrFactory<FTXService> weak_factory_;
 };
 
@@ -115,6 +115,8 @@ void GreaselionRule::Parse(base::DictionaryValue* preconditions_value,
       }
     }
   }
+  std::vector<std::string> pattern_strings;
+  std::vector<URLPattern> patterns;
   for (const auto& urls_it : urls_value->GetList()) {
     std::string pattern_string = urls_it.GetString();
     URLPattern pattern;
@@ -124,7 +126,20 @@ void GreaselionRule::Parse(base::DictionaryValue* preconditions_value,
       url_patterns_.clear();
       return;
     }
-    url_patterns_.push_back(pattern_string);
+    pattern_strings.push_back(pattern_string);
+    patterns.push_back(std::move(pattern));
+  }
+  // The patterns become the rule's content script matches, which are all
+  // tested on every navigation, so leave out duplicates and patterns another
+  // pattern of the rule already covers.
+  for (size_t i = 0; i < patterns.size(); i++) {
+    bool redundant = false;
+    for (size_t j = 0; j < patterns.size() && !redundant; j++) {
+      redundant = j != i && patterns[j].Contains(patterns[i]) &&
+                  (j < i || !patterns[i].Contains(patterns[j]));
+    }
+    if (!redundant)
+      url_patterns_.push_back(pattern_strings[i]);
   }
   for (const auto& scripts_it : scripts_value->GetList()) {
     base::FilePath script_path = resource_dir.AppendASCII(
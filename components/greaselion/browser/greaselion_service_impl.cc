@@ -6,7 +6,10 @@
 #include "brave/components/greaselion/browser/greaselion_service_impl.h"
 
 #include <stddef.h>
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -16,11 +19,13 @@
 #include "base/callback_helpers.h"
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/json/json_file_value_serializer.h"
 #include "base/one_shot_event.h"
 #include "base/sequenced_task_runner.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
@@ -33,6 +38,7 @@
 #include "brave/components/version_info//version_info.h"
 #include "chrome/browser/extensions/extension_service.h"
 #include "components/version_info/version_info.h"
+#include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
 #include "extensions/browser/extension_registry.h"
 #include "extensions/browser/extension_system.h"
@@ -51,6 +57,79 @@ namespace {
 
 constexpr char kRunAtDocumentStart[] = "document_start";
 
+void HashString(crypto::SecureHash* hash, const std::string& value) {
+  // Length-prefixed, so that adjacent fields can't run into each other.
+  const uint64_t size = value.size();
+  hash->Update(&size, sizeof(size));
+  hash->Update(value.data(), value.size());
+}
+
+// |name| is where the file ends up inside the extension. The component
+// directory the file is copied from changes with every component version, but
+// doesn't make a difference to the extension.
+bool HashFile(crypto::SecureHash* hash,
+              const base::FilePath& path,
+              const base::FilePath& name) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return false;
+  HashString(hash, name.AsUTF8Unsafe());
+  HashString(hash, contents);
+  return true;
+}
+
+// Hashes everything the extension for |rule| is built from, so that rules
+// which haven't changed since their extension was installed, including script
+// edits made in dev mode, can keep it. Returns an empty string if a file
+// couldn't be read; the rule then always gets converted again.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+std::string HashGreaselionRule(const greaselion::GreaselionRule& rule) {
+  std::unique_ptr<crypto::SecureHash> hash =
+      crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  HashString(hash.get(), rule.name());
+  HashString(hash.get(), rule.run_at());
+  for (const auto& url_pattern : rule.url_patterns())
+    HashString(hash.get(), url_pattern);
+  for (const auto& script : rule.scripts()) {
+    if (!HashFile(hash.get(), script, script.BaseName()))
+      return std::string();
+  }
+  if (!rule.messages().empty()) {
+    std::vector<base::FilePath> message_files;
+    base::FileEnumerator enumerator(rule.messages(), true,
+                                    base::FileEnumerator::FILES);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      message_files.push_back(path);
+    }
+    std::sort(message_files.begin(), message_files.end());
+    for (const auto& path : message_files) {
+      base::FilePath name;
+      rule.messages().AppendRelativePath(path, &name);
+      if (!HashFile(hash.get(), path, name))
+        return std::string();
+    }
+  }
+
+  uint8_t digest[crypto::kSHA256Length];
+  hash->Finish(digest, sizeof(digest));
+  return base::HexEncode(digest, sizeof(digest));
+}
+
+std::vector<std::string> HashGreaselionRulesOnTaskRunner(
+    const std::vector<greaselion::GreaselionRule>& rules) {
+  std::vector<std::string> hashes;
+  hashes.reserve(rules.size());
+  for (const auto& rule : rules)
+    hashes.push_back(HashGreaselionRule(rule));
+  return hashes;
+}
+
+void DeleteExtensionDirOnTaskRunner(base::ScopedTempDir extension_dir) {
+  // |extension_dir| deletes the directory as it goes out of scope.
+}
+
 // Wraps a Greaselion rule in a component. The component is stored as
 // an unpacked extension in the user data dir. Returns a valid
 // extension that the caller should take ownership of, or nullptr.
@@ -238,61 +317,102 @@ void GreaselionServiceImpl::UpdateInstalledExtensions() {
     return;
   }
   update_in_progress_ = true;
-  if (greaselion_extensions_.empty()) {
-    // No Greaselion extensions are currently installed, so we can move on to
-    // the install phase immediately.
+
+  std::vector<GreaselionRule> rules;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
+    if (rule->Matches(state_, browser_version_) &&
+        rule->has_unknown_preconditions() == false) {
+      rules.push_back(*rule);
+    }
+  }
+  // Hashing reads the rule files, so it runs on the extension file task runner
+  // like the conversion does.
+  std::vector<GreaselionRule> rules_to_hash = rules;
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&HashGreaselionRulesOnTaskRunner,
+                     std::move(rules_to_hash)),
+      base::BindOnce(&GreaselionServiceImpl::OnRulesHashed,
+                     weak_factory_.GetWeakPtr(), std::move(rules)));
+}
+
+void GreaselionServiceImpl::OnRulesHashed(std::vector<GreaselionRule> rules,
+                                          std::vector<std::string> hashes) {
+  DCHECK(update_in_progress_);
+  DCHECK_EQ(rules.size(), hashes.size());
+  DCHECK(rules_to_install_.empty());
+  DCHECK(pending_unloads_.empty());
+
+  // Extensions built from a rule which still matches with the same contents
+  // stay installed; everything else gets unloaded and converted again.
+  std::map<std::string, std::string> wanted_hashes;
+  for (size_t i = 0; i < rules.size(); i++) {
+    if (!hashes[i].empty())
+      wanted_hashes[rules[i].name()] = hashes[i];
+  }
+  for (const auto& installed : installed_extensions_) {
+    auto it = wanted_hashes.find(installed.second.rule_name);
+    if (it == wanted_hashes.end() || it->second != installed.second.rule_hash)
+      pending_unloads_.insert(installed.first);
+  }
+  for (size_t i = 0; i < rules.size(); i++) {
+    const std::string& name = rules[i].name();
+    const bool unchanged = std::any_of(
+        installed_extensions_.begin(), installed_extensions_.end(),
+        [&](const auto& installed) {
+          return installed.second.rule_name == name &&
+                 !pending_unloads_.count(installed.first);
+        });
+    if (!unchanged)
+      rules_to_install_.emplace_back(std::move(rules[i]), hashes[i]);
+  }
+
+  if (pending_unloads_.empty()) {
     CreateAndInstallExtensions();
     return;
   }
 
-  // Make a copy of greaselion_extensions_ to iterate while the original vector
-  // changes.
-  std::vector<extensions::ExtensionId> extensions = greaselion_extensions_;
-  for (auto id : extensions) {
-    // We need to unload all the Greaselion extensions that are already
-    // installed. OnExtensionUnloaded will be called on each extension, where we
-    // will update the greaselion_extensions_ set. Once it's empty, that
-    // callback will call CreateAndInstallExtensions().
+  // Make a copy of pending_unloads_ to iterate while the original set changes.
+  // OnExtensionUnloaded removes each extension from it, and once it's empty,
+  // that callback calls CreateAndInstallExtensions().
+  std::set<extensions::ExtensionId> extensions = pending_unloads_;
+  for (const auto& id : extensions) {
     extension_service_->UnloadExtension(
         id, extensions::UnloadedExtensionReason::UPDATE);
   }
 }
 
 void GreaselionServiceImpl::CreateAndInstallExtensions() {
-  DCHECK(greaselion_extensions_.empty());
+  DCHECK(pending_unloads_.empty());
   DCHECK(update_in_progress_);
   all_rules_installed_successfully_ = true;
-  pending_installs_ = 0;
-  std::vector<std::unique_ptr<GreaselionRule>>* rules =
-      download_service_->rules();
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
-    }
-  }
+  std::vector<std::pair<GreaselionRule, std::string>> rules =
+      std::move(rules_to_install_);
+  rules_to_install_.clear();
+  pending_installs_ = static_cast<int>(rules.size());
   if (!pending_installs_) {
-    // no rules match, nothing else to do
+    // nothing changed, or no rules match, nothing else to do
     MaybeNotifyObservers();
     return;
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      GreaselionRule rule_copy(*rule);
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule_copy, install_directory_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
-    }
+  for (auto& rule : rules) {
+    // Convert script file to component extension. This must run on extension
+    // file task runner, which was passed in in the constructor.
+    const std::string rule_name = rule.first.name();
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
+                       std::move(rule.first), install_directory_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr(), rule_name,
+                       std::move(rule.second)));
   }
 }
 
 void GreaselionServiceImpl::PostConvert(
+    const std::string& rule_name,
+    const std::string& rule_hash,
     base::Optional<GreaselionConvertedExtension> converted_extension) {
   if (!converted_extension) {
     all_rules_installed_successfully_ = false;
@@ -300,8 +420,12 @@ void GreaselionServiceImpl::PostConvert(
     MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
-    greaselion_extensions_.push_back(converted_extension->first->id());
-    extension_dirs_.push_back(std::move(converted_extension->second));
+    const extensions::ExtensionId& id = converted_extension->first->id();
+    greaselion_extensions_.push_back(id);
+    InstalledExtension& installed = installed_extensions_[id];
+    installed.rule_name = rule_name;
+    installed.rule_hash = rule_hash;
+    installed.dir = std::move(converted_extension->second);
     extension_system_->ready().Post(
         FROM_HERE, base::BindOnce(&GreaselionServiceImpl::Install,
                                   weak_factory_.GetWeakPtr(),
@@ -339,7 +463,15 @@ void GreaselionServiceImpl::OnExtensionUnloaded(
     return;
   }
   greaselion_extensions_.erase(index);
-  if (update_in_progress_ && greaselion_extensions_.empty()) {
+  auto installed = installed_extensions_.find(extension->id());
+  if (installed != installed_extensions_.end()) {
+    task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&DeleteExtensionDirOnTaskRunner,
+                                  std::move(installed->second.dir)));
+    installed_extensions_.erase(installed);
+  }
+  if (update_in_progress_ && pending_unloads_.erase(extension->id()) &&
+      pending_unloads_.empty()) {
     // It's time!
     CreateAndInstallExtensions();
   }
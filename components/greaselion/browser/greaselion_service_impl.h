@@ -8,6 +8,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,6 +19,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/path_service.h"
 #include "base/version.h"
+#include "brave/components/greaselion/browser/greaselion_download_service.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
 #include "extensions/common/extension_id.h"
 #include "url/gurl.h"
@@ -68,8 +70,12 @@ class GreaselionServiceImpl : public GreaselionService {
 
  private:
   void SetBrowserVersionForTesting(const base::Version& version) override;
+  void OnRulesHashed(std::vector<GreaselionRule> rules,
+                     std::vector<std::string> hashes);
   void CreateAndInstallExtensions();
   void PostConvert(
+      const std::string& rule_name,
+      const std::string& rule_hash,
       base::Optional<GreaselionConvertedExtension> converted_extension);
   void Install(scoped_refptr<extensions::Extension> extension);
   void MaybeNotifyObservers();
@@ -87,7 +93,16 @@ class GreaselionServiceImpl : public GreaselionService {
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<Observer> observers_;
   std::vector<extensions::ExtensionId> greaselion_extensions_;
-  std::vector<base::ScopedTempDir> extension_dirs_;
+  // What each installed extension was converted from, so that updates only
+  // reinstall extensions whose rule changed.
+  struct InstalledExtension {
+    std::string rule_name;
+    std::string rule_hash;
+    base::ScopedTempDir dir;
+  };
+  std::map<extensions::ExtensionId, InstalledExtension> installed_extensions_;
+  std::set<extensions::ExtensionId> pending_unloads_;
+  std::vector<std::pair<GreaselionRule, std::string>> rules_to_install_;
   base::Version browser_version_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 
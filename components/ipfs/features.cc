@@ -20,5 +20,21 @@ const base::Feature kIpfsFeature{
 #endif
 };
 
+// Import folders file by file with several uploads in flight, and compose the
+// directory in MFS, instead of posting the whole tree in a single request
+const base::Feature kIpfsParallelFolderImport{
+    "IpfsParallelFolderImport", base::FEATURE_DISABLED_BY_DEFAULT};
+
+// Ask the local node to fetch all blocks of media loaded from ipfs:// URLs as
+// soon as playback starts, so sequential reads and seeks hit the local repo
+const base::Feature kIpfsMediaPrefetch{"IpfsMediaPrefetch",
+                                       base::FEATURE_DISABLED_BY_DEFAULT};
+
+// Relaunch the local node with the lowpower profile while on battery, under
+// memory pressure or after a long idle time, and with the default one again
+// otherwise
+const base::Feature kIpfsAdaptiveResourceProfile{
+    "IpfsAdaptiveResourceProfile", base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
 }  // namespace ipfs
@@ -14,6 +14,9 @@ namespace ipfs {
 namespace features {
 
 extern const base::Feature kIpfsFeature;
+extern const base::Feature kIpfsParallelFolderImport;
+extern const base::Feature kIpfsMediaPrefetch;
+extern const base::Feature kIpfsAdaptiveResourceProfile;
 
 }  // namespace features
 }  // namespace ipfs
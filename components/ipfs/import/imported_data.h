@@ -38,6 +38,10 @@ struct ImportedData {
 using ImportCompletedCallback =
     base::OnceCallback<void(const ipfs::ImportedData&)>;
 
+// Reports how many files of a folder import have been added to ipfs so far.
+using ImportProgressCallback =
+    base::RepeatingCallback<void(size_t imported_files, size_t total_files)>;
+
 }  // namespace ipfs
 
 #endif  // BRAVE_COMPONENTS_IPFS_IMPORT_IMPORTED_DATA_H_
@@ -5,9 +5,12 @@
 
 #include "brave/components/ipfs/import/ipfs_import_worker_base.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/command_line.h"
+#include "base/feature_list.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_util.h"
 #include "base/guid.h"
 #include "base/strings/strcat.h"
@@ -17,6 +20,7 @@
 #include "base/task/thread_pool.h"
 #include "base/task_runner_util.h"
 #include "base/time/time.h"
+#include "brave/components/ipfs/features.h"
 #include "brave/components/ipfs/ipfs_constants.h"
 #include "brave/components/ipfs/ipfs_json_parser.h"
 #include "brave/components/ipfs/ipfs_utils.h"
@@ -40,6 +44,12 @@
 
 namespace {
 
+// Uploads in flight at once for parallel folder imports.
+constexpr size_t kMaxParallelFolderUploads = 4;
+// How many times a file of a parallel folder import is re-uploaded before the
+// whole import fails.
+constexpr int kMaxFolderFileRetries = 1;
+
 // Return a date string formatted as "YYYY-MM-DD".
 std::string TimeFormatDate(const base::Time& time) {
   base::Time::Exploded exploded_time;
@@ -70,6 +80,14 @@ IpfsImportWorkerBase::IpfsImportWorkerBase(
 
 IpfsImportWorkerBase::~IpfsImportWorkerBase() = default;
 
+IpfsImportWorkerBase::FolderContents::FolderContents() = default;
+IpfsImportWorkerBase::FolderContents::FolderContents(FolderContents&& other) =
+    default;
+IpfsImportWorkerBase::FolderContents&
+IpfsImportWorkerBase::FolderContents::operator=(FolderContents&& other) =
+    default;
+IpfsImportWorkerBase::FolderContents::~FolderContents() = default;
+
 void IpfsImportWorkerBase::ImportFile(const base::FilePath path) {
   ImportFile(path, kFileMimeType, path.BaseName().MaybeAsASCII());
 }
@@ -91,13 +109,26 @@ void IpfsImportWorkerBase::ImportFile(const base::FilePath upload_file_path,
 }
 
 void IpfsImportWorkerBase::ImportFolder(const base::FilePath folder_path) {
+  data_->filename = folder_path.BaseName().MaybeAsASCII();
+  if (base::FeatureList::IsEnabled(features::kIpfsParallelFolderImport)) {
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::MayBlock()},
+        base::BindOnce(&IpfsImportWorkerBase::EnumerateFolder, folder_path),
+        base::BindOnce(&IpfsImportWorkerBase::OnFolderEnumerated,
+                       weak_factory_.GetWeakPtr()));
+    return;
+  }
   auto upload_callback = base::BindOnce(&IpfsImportWorkerBase::UploadData,
                                         weak_factory_.GetWeakPtr());
-  data_->filename = folder_path.BaseName().MaybeAsASCII();
   CreateRequestForFolder(folder_path, blob_context_getter_factory_,
                          std::move(upload_callback));
 }
 
+void IpfsImportWorkerBase::SetProgressCallback(
+    ImportProgressCallback callback) {
+  progress_callback_ = std::move(callback);
+}
+
 void IpfsImportWorkerBase::ImportText(const std::string& text,
                                       const std::string& host) {
   if (text.empty() || host.empty()) {
@@ -280,6 +311,243 @@ void IpfsImportWorkerBase::OnContentPublished(
                                 : IPFS_IMPORT_ERROR_PUBLISH_FAILED);
 }
 
+// static
+IpfsImportWorkerBase::FolderContents IpfsImportWorkerBase::EnumerateFolder(
+    const base::FilePath& folder_path) {
+  FolderContents contents;
+  base::FileEnumerator file_enum(
+      folder_path, true,
+      base::FileEnumerator::FILES | base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath enum_path = file_enum.Next(); !enum_path.empty();
+       enum_path = file_enum.Next()) {
+    // Skip symlinks.
+    if (base::IsLink(enum_path))
+      continue;
+    base::FilePath relative_path;
+    if (!folder_path.AppendRelativePath(enum_path, &relative_path))
+      continue;
+    std::string relative =
+        relative_path.NormalizePathSeparatorsTo(FILE_PATH_LITERAL('/'))
+            .AsUTF8Unsafe();
+    const base::FileEnumerator::FileInfo info = file_enum.GetInfo();
+    if (info.IsDirectory()) {
+      contents.directories.push_back(std::move(relative));
+      continue;
+    }
+    FolderFile file;
+    file.path = enum_path;
+    file.relative_path = std::move(relative);
+    file.size = info.GetSize();
+    contents.files.push_back(std::move(file));
+  }
+  // A parent sorts before its children.
+  std::sort(contents.directories.begin(), contents.directories.end());
+  return contents;
+}
+
+void IpfsImportWorkerBase::OnFolderEnumerated(FolderContents contents) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  folder_ = std::move(contents);
+  if (folder_.files.empty()) {
+    ComposeFolder();
+    return;
+  }
+  UploadFolderFiles();
+}
+
+void IpfsImportWorkerBase::UploadFolderFiles() {
+  while (next_folder_file_ < folder_.files.size() &&
+         next_folder_file_ - folder_files_added_ < kMaxParallelFolderUploads) {
+    StartFolderFileUpload(next_folder_file_++);
+  }
+}
+
+void IpfsImportWorkerBase::StartFolderFileUpload(size_t index) {
+  DCHECK_LT(index, folder_.files.size());
+  const FolderFile& file = folder_.files[index];
+  CreateRequestForFile(
+      file.path, blob_context_getter_factory_, kFileMimeType,
+      file.path.BaseName().AsUTF8Unsafe(),
+      base::BindOnce(&IpfsImportWorkerBase::OnFolderFileRequestCreated,
+                     weak_factory_.GetWeakPtr(), index),
+      file.size);
+}
+
+void IpfsImportWorkerBase::OnFolderFileRequestCreated(
+    size_t index,
+    std::unique_ptr<network::ResourceRequest> request) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!request)
+    return FailFolderImport(IPFS_IMPORT_ERROR_REQUEST_EMPTY);
+
+  GURL url = net::AppendQueryParameter(server_endpoint_.Resolve(kImportAddPath),
+                                       "stream-channels", "true");
+  url = net::AppendQueryParameter(url, "pin", "false");
+  url = net::AppendQueryParameter(url, "progress", "false");
+
+  auto iter = folder_url_loaders_.insert(
+      folder_url_loaders_.begin(),
+      CreateURLLoader(url, "POST", std::move(request)));
+  iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+      url_loader_factory_,
+      base::BindOnce(&IpfsImportWorkerBase::OnFolderFileAdded,
+                     weak_factory_.GetWeakPtr(), index, iter));
+}
+
+void IpfsImportWorkerBase::OnFolderFileAdded(
+    size_t index,
+    SimpleURLLoaderList::iterator iter,
+    std::unique_ptr<std::string> response_body) {
+  auto* url_loader = iter->get();
+  int error_code = url_loader->NetError();
+  int response_code = -1;
+  if (url_loader->ResponseInfo() && url_loader->ResponseInfo()->headers)
+    response_code = url_loader->ResponseInfo()->headers->response_code();
+  folder_url_loaders_.erase(iter);
+
+  FolderFile& file = folder_.files[index];
+  ipfs::ImportedData added;
+  bool success = (error_code == net::OK && response_code == net::HTTP_OK);
+  if (success) {
+    success = response_body &&
+              IPFSJSONParser::GetImportResponseFromJSON(*response_body,
+                                                        &added) &&
+              !added.hash.empty();
+  }
+  if (!success) {
+    VLOG(1) << "error_code:" << error_code << " response_code:" << response_code
+            << " file:" << file.relative_path;
+    // Only this file has to be sent again.
+    if (file.retries++ < kMaxFolderFileRetries) {
+      StartFolderFileUpload(index);
+      return;
+    }
+    return FailFolderImport(IPFS_IMPORT_ERROR_ADD_FAILED);
+  }
+
+  file.hash = added.hash;
+  folder_files_added_++;
+  if (progress_callback_)
+    progress_callback_.Run(folder_files_added_, folder_.files.size());
+  if (folder_files_added_ == folder_.files.size()) {
+    ComposeFolder();
+    return;
+  }
+  UploadFolderFiles();
+}
+
+void IpfsImportWorkerBase::ComposeFolder() {
+  DCHECK(!url_loader_);
+  std::string directory = kImportDirectory;
+  directory += TimeFormatDate(base::Time::Now());
+  directory += "/";
+  data_->directory = directory;
+  folder_target_ = directory + data_->filename;
+
+  const GURL mkdir_url = net::AppendQueryParameter(
+      server_endpoint_.Resolve(kImportMakeDirectoryPath), "parents", "true");
+  folder_requests_.emplace(
+      net::AppendQueryParameter(mkdir_url, "arg", folder_target_),
+      IPFS_IMPORT_ERROR_MKDIR_FAILED);
+  for (const auto& relative_path : folder_.directories) {
+    folder_requests_.emplace(
+        net::AppendQueryParameter(mkdir_url, "arg",
+                                  folder_target_ + "/" + relative_path),
+        IPFS_IMPORT_ERROR_MKDIR_FAILED);
+  }
+
+  int64_t size = 0;
+  for (const auto& file : folder_.files) {
+    GURL copy_url = net::AppendQueryParameter(
+        server_endpoint_.Resolve(kImportCopyPath), "arg", "/ipfs/" + file.hash);
+    copy_url = net::AppendQueryParameter(
+        copy_url, "arg", folder_target_ + "/" + file.relative_path);
+    folder_requests_.emplace(copy_url, IPFS_IMPORT_ERROR_MOVE_FAILED);
+    size += file.size;
+  }
+  data_->size = size;
+
+  DoNextFolderRequest();
+}
+
+void IpfsImportWorkerBase::DoNextFolderRequest() {
+  DCHECK(!url_loader_);
+  if (folder_requests_.empty()) {
+    StatFolder();
+    return;
+  }
+  std::pair<GURL, ipfs::ImportState> request =
+      std::move(folder_requests_.front());
+  folder_requests_.pop();
+
+  url_loader_ = CreateURLLoader(request.first, "POST");
+  url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+      url_loader_factory_,
+      base::BindOnce(&IpfsImportWorkerBase::OnFolderRequestComplete,
+                     base::Unretained(this), request.second));
+}
+
+void IpfsImportWorkerBase::OnFolderRequestComplete(
+    ipfs::ImportState error_state,
+    std::unique_ptr<std::string> response_body) {
+  int error_code = url_loader_->NetError();
+  int response_code = -1;
+  if (url_loader_->ResponseInfo() && url_loader_->ResponseInfo()->headers)
+    response_code = url_loader_->ResponseInfo()->headers->response_code();
+  url_loader_.reset();
+  bool success = (error_code == net::OK && response_code == net::HTTP_OK);
+  if (!success) {
+    VLOG(1) << "error_code:" << error_code << " response_code:" << response_code
+            << " response_body:" << (response_body ? *response_body : "");
+    return FailFolderImport(error_state);
+  }
+  DoNextFolderRequest();
+}
+
+void IpfsImportWorkerBase::StatFolder() {
+  DCHECK(!url_loader_);
+  GURL url = net::AppendQueryParameter(
+      server_endpoint_.Resolve(kImportStatPath), "arg", folder_target_);
+
+  url_loader_ = CreateURLLoader(url, "POST");
+  url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+      url_loader_factory_, base::BindOnce(&IpfsImportWorkerBase::OnFolderStat,
+                                          base::Unretained(this)));
+}
+
+void IpfsImportWorkerBase::OnFolderStat(
+    std::unique_ptr<std::string> response_body) {
+  int error_code = url_loader_->NetError();
+  int response_code = -1;
+  if (url_loader_->ResponseInfo() && url_loader_->ResponseInfo()->headers)
+    response_code = url_loader_->ResponseInfo()->headers->response_code();
+  url_loader_.reset();
+  ipfs::ImportedData stat;
+  bool success = (error_code == net::OK && response_code == net::HTTP_OK);
+  if (success) {
+    success = response_body &&
+              IPFSJSONParser::GetImportResponseFromJSON(*response_body,
+                                                        &stat) &&
+              !stat.hash.empty();
+  }
+  if (!success)
+    return FailFolderImport(IPFS_IMPORT_ERROR_MOVE_FAILED);
+
+  data_->hash = stat.hash;
+  if (!key_to_publish_.empty()) {
+    PublishContent();
+    return;
+  }
+  NotifyImportCompleted(IPFS_IMPORT_SUCCESS);
+}
+
+void IpfsImportWorkerBase::FailFolderImport(ipfs::ImportState state) {
+  // Drop uploads still in flight along with their pending callbacks.
+  folder_url_loaders_.clear();
+  weak_factory_.InvalidateWeakPtrs();
+  NotifyImportCompleted(state);
+}
+
 void IpfsImportWorkerBase::NotifyImportCompleted(ipfs::ImportState state) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   data_->state = state;
@@ -42,6 +42,10 @@ namespace ipfs {
 //   3. Creates target directory for import using IPFS api(/api/v0/files/mkdir)
 //   4. Moves objects to target directory using IPFS api(/api/v0/files/cp)
 //   5. Publishes objects under passed IPNS key(/api/v0/name/publish)
+// With features::kIpfsParallelFolderImport, folders are imported file by file
+// instead: files are added with a bounded number of uploads in flight, then
+// the tree is rebuilt under the target directory with files/mkdir and
+// files/cp, and its hash is read back with /api/v0/files/stat.
 class IpfsImportWorkerBase {
  public:
   IpfsImportWorkerBase(BlobContextGetterFactory* blob_context_getter_factory,
@@ -61,6 +65,9 @@ class IpfsImportWorkerBase {
   void ImportText(const std::string& text, const std::string& host);
   void ImportFolder(const base::FilePath folder_path);
 
+  // Only used by folder imports.
+  void SetProgressCallback(ImportProgressCallback callback);
+
  protected:
   network::mojom::URLLoaderFactory* GetUrlLoaderFactory();
 
@@ -80,7 +87,49 @@ class IpfsImportWorkerBase {
                          ipfs::ImportedData* data);
   void PublishContent();
   void OnContentPublished(std::unique_ptr<std::string> response_body);
+
+  // Parallel folder import.
+  struct FolderFile {
+    base::FilePath path;
+    // Path relative to the imported folder, '/' separated.
+    std::string relative_path;
+    int64_t size = 0;
+    std::string hash;
+    int retries = 0;
+  };
+  struct FolderContents {
+    FolderContents();
+    FolderContents(FolderContents&& other);
+    FolderContents& operator=(FolderContents&& other);
+    ~FolderContents();
+
+    // Relative paths of all subdirectories, parents first.
+    std::vector<std::string> directories;
+    std::vector<FolderFile> files;
+  };
+  using SimpleURLLoaderList =
+      std::list<std::unique_ptr<network::SimpleURLLoader>>;
+
+  static FolderContents EnumerateFolder(const base::FilePath& folder_path);
+  void OnFolderEnumerated(FolderContents contents);
+  void UploadFolderFiles();
+  void StartFolderFileUpload(size_t index);
+  void OnFolderFileRequestCreated(
+      size_t index,
+      std::unique_ptr<network::ResourceRequest> request);
+  void OnFolderFileAdded(size_t index,
+                         SimpleURLLoaderList::iterator iter,
+                         std::unique_ptr<std::string> response_body);
+  void ComposeFolder();
+  void DoNextFolderRequest();
+  void OnFolderRequestComplete(ipfs::ImportState error_state,
+                               std::unique_ptr<std::string> response_body);
+  void StatFolder();
+  void OnFolderStat(std::unique_ptr<std::string> response_body);
+  void FailFolderImport(ipfs::ImportState state);
+
   ImportCompletedCallback callback_;
+  ImportProgressCallback progress_callback_;
   std::unique_ptr<ipfs::ImportedData> data_;
 
   BlobContextGetterFactory* blob_context_getter_factory_ = nullptr;
@@ -88,6 +137,15 @@ class IpfsImportWorkerBase {
   std::unique_ptr<network::SimpleURLLoader> url_loader_;
   GURL server_endpoint_;
   std::string key_to_publish_;
+
+  FolderContents folder_;
+  size_t next_folder_file_ = 0;
+  size_t folder_files_added_ = 0;
+  SimpleURLLoaderList folder_url_loaders_;
+  // Pending MFS calls and the state to fail with if they don't succeed.
+  base::queue<std::pair<GURL, ipfs::ImportState>> folder_requests_;
+  std::string folder_target_;
+
   base::WeakPtrFactory<IpfsImportWorkerBase> weak_factory_;
 };
 
@@ -35,9 +35,13 @@ const char kNodeInfoPath[] = "/api/v0/id";
 const char kLocalhostIP[] = "127.0.0.1";
 const char kLocalhostDomain[] = "localhost";
 const char kGarbageCollectionPath[] = "/api/v0/repo/gc";
+const char kRefsPath[] = "/api/v0/refs";
+const char kRefsRecursiveParamName[] = "recursive";
+const char kRefsUniqueParamName[] = "unique";
 const char kImportAddPath[] = "/api/v0/add";
 const char kImportMakeDirectoryPath[] = "/api/v0/files/mkdir";
 const char kImportCopyPath[] = "/api/v0/files/cp";
+const char kImportStatPath[] = "/api/v0/files/stat";
 const char kImportDirectory[] = "/brave-imports/";
 const char kIPFSImportMultipartContentType[] = "multipart/form-data;";
 const char kFileValueName[] = "file";
@@ -31,9 +31,13 @@ extern const char kNodeInfoPath[];
 extern const char kLocalhostIP[];
 extern const char kLocalhostDomain[];
 extern const char kGarbageCollectionPath[];
+extern const char kRefsPath[];
+extern const char kRefsRecursiveParamName[];
+extern const char kRefsUniqueParamName[];
 extern const char kImportAddPath[];
 extern const char kImportMakeDirectoryPath[];
 extern const char kImportCopyPath[];
+extern const char kImportStatPath[];
 extern const char kImportDirectory[];
 extern const char kAPIPublishNameEndpoint[];
 extern const char kIPFSImportMultipartContentType[];
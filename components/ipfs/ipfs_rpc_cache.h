@@ -0,0 +1,84 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_IPFS_IPFS_RPC_CACHE_H_
+#define BRAVE_COMPONENTS_IPFS_IPFS_RPC_CACHE_H_
+
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/optional.h"
+#include "base/time/time.h"
+
+namespace ipfs {
+
+// Coalesces concurrent calls of one daemon RPC into a single request and
+// keeps its last successful result for |ttl|.
+//
+// Callers hand their callback to Add() and send the request only if it
+// returns true, then pass the result to Complete(), which answers every
+// callback queued in the meantime.
+template <typename T>
+class IpfsRpcCache {
+ public:
+  using Callback = base::OnceCallback<void(bool, const T&)>;
+
+  explicit IpfsRpcCache(base::TimeDelta ttl) : ttl_(ttl) {}
+  ~IpfsRpcCache() = default;
+
+  IpfsRpcCache(const IpfsRpcCache&) = delete;
+  IpfsRpcCache& operator=(const IpfsRpcCache&) = delete;
+
+  // Runs |callback| right away if a fresh result is cached. Otherwise queues
+  // it, and returns true if no request is in flight yet.
+  bool Add(Callback callback) {
+    if (cached_ && base::TimeTicks::Now() - cached_time_ < ttl_) {
+      if (callback)
+        std::move(callback).Run(true, *cached_);
+      return false;
+    }
+    pending_.push_back(std::move(callback));
+    if (in_flight_)
+      return false;
+    in_flight_ = true;
+    return true;
+  }
+
+  // Answers all queued callbacks. Only successful results are cached.
+  void Complete(bool success, const T& value) {
+    in_flight_ = false;
+    if (success) {
+      cached_ = value;
+      cached_time_ = base::TimeTicks::Now();
+    } else {
+      cached_.reset();
+    }
+    // Callbacks may call Add() again.
+    std::vector<Callback> callbacks;
+    callbacks.swap(pending_);
+    for (auto& callback : callbacks) {
+      if (callback)
+        std::move(callback).Run(success, value);
+    }
+  }
+
+  // Drops the cached result, e.g. when the daemon went away. A request in
+  // flight still completes normally.
+  void Invalidate() { cached_.reset(); }
+
+  bool in_flight() const { return in_flight_; }
+
+ private:
+  const base::TimeDelta ttl_;
+  base::Optional<T> cached_;
+  base::TimeTicks cached_time_;
+  std::vector<Callback> pending_;
+  bool in_flight_ = false;
+};
+
+}  // namespace ipfs
+
+#endif  // BRAVE_COMPONENTS_IPFS_IPFS_RPC_CACHE_H_
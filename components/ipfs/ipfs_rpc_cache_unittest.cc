@@ -0,0 +1,108 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/ipfs_rpc_cache.h"
+
+#include <string>
+
+#include "base/bind.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ipfs {
+
+namespace {
+
+IpfsRpcCache<std::string>::Callback RecordResult(int* calls,
+                                                 bool* success,
+                                                 std::string* value) {
+  return base::BindOnce(
+      [](int* calls, bool* success, std::string* value, bool result_success,
+         const std::string& result_value) {
+        (*calls)++;
+        *success = result_success;
+        *value = result_value;
+      },
+      calls, success, value);
+}
+
+}  // namespace
+
+class IpfsRpcCacheUnitTest : public testing::Test {
+ public:
+  IpfsRpcCacheUnitTest() = default;
+  ~IpfsRpcCacheUnitTest() override = default;
+
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+};
+
+TEST_F(IpfsRpcCacheUnitTest, CoalescesConcurrentCalls) {
+  IpfsRpcCache<std::string> cache(base::TimeDelta::FromSeconds(1));
+  int calls = 0;
+  bool success = false;
+  std::string value;
+
+  EXPECT_TRUE(cache.Add(RecordResult(&calls, &success, &value)));
+  EXPECT_FALSE(cache.Add(RecordResult(&calls, &success, &value)));
+  EXPECT_TRUE(cache.in_flight());
+  EXPECT_EQ(calls, 0);
+
+  cache.Complete(true, "peers");
+  EXPECT_FALSE(cache.in_flight());
+  EXPECT_EQ(calls, 2);
+  EXPECT_TRUE(success);
+  EXPECT_EQ(value, "peers");
+}
+
+TEST_F(IpfsRpcCacheUnitTest, ServesFromCacheUntilExpired) {
+  IpfsRpcCache<std::string> cache(base::TimeDelta::FromSeconds(1));
+  int calls = 0;
+  bool success = false;
+  std::string value;
+
+  EXPECT_TRUE(cache.Add(RecordResult(&calls, &success, &value)));
+  cache.Complete(true, "stats");
+  EXPECT_EQ(calls, 1);
+
+  // Answered synchronously from the cache.
+  EXPECT_FALSE(cache.Add(RecordResult(&calls, &success, &value)));
+  EXPECT_EQ(calls, 2);
+  EXPECT_EQ(value, "stats");
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_TRUE(cache.Add(RecordResult(&calls, &success, &value)));
+  EXPECT_EQ(calls, 2);
+}
+
+TEST_F(IpfsRpcCacheUnitTest, DoesNotCacheFailures) {
+  IpfsRpcCache<std::string> cache(base::TimeDelta::FromSeconds(1));
+  int calls = 0;
+  bool success = true;
+  std::string value;
+
+  EXPECT_TRUE(cache.Add(RecordResult(&calls, &success, &value)));
+  cache.Complete(false, std::string());
+  EXPECT_EQ(calls, 1);
+  EXPECT_FALSE(success);
+
+  EXPECT_TRUE(cache.Add(RecordResult(&calls, &success, &value)));
+}
+
+TEST_F(IpfsRpcCacheUnitTest, Invalidate) {
+  IpfsRpcCache<std::string> cache(base::TimeDelta::FromSeconds(1));
+  int calls = 0;
+  bool success = false;
+  std::string value;
+
+  EXPECT_TRUE(cache.Add(RecordResult(&calls, &success, &value)));
+  cache.Complete(true, "info");
+  cache.Invalidate();
+  EXPECT_TRUE(cache.Add(RecordResult(&calls, &success, &value)));
+  EXPECT_EQ(calls, 1);
+}
+
+}  // namespace ipfs
@@ -5,11 +5,15 @@
 
 #include "brave/components/ipfs/ipfs_service.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/command_line.h"
 #include "base/files/file_util.h"
+#include "base/feature_list.h"
 #include "base/json/json_reader.h"
+#include "base/memory/memory_pressure_monitor.h"
+#include "base/power_monitor/power_monitor.h"
 #include "base/process/launch.h"
 #include "base/process/process.h"
 #include "base/rand_util.h"
@@ -18,8 +22,10 @@
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
 #include "base/task_runner_util.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/components/ipfs/blob_context_getter_factory.h"
 #include "brave/components/ipfs/buildflags/buildflags.h"
+#include "brave/components/ipfs/features.h"
 #include "brave/components/ipfs/ipfs_constants.h"
 #include "brave/components/ipfs/ipfs_json_parser.h"
 #include "brave/components/ipfs/ipfs_network_utils.h"
@@ -74,11 +80,32 @@ class ReentrancyCheck {
 };
 #endif
 // Used to retry request if we got zero peers from ipfs service
-// Actual value will be generated randomly in range
-// (kMinimalPeersRetryIntervalMs, kPeersRetryRate*kMinimalPeersRetryIntervalMs)
+// The interval doubles with every attempt up to kMaximalPeersRetryIntervalMs,
+// and the actual value will be generated randomly in range
+// (interval, kPeersRetryRate*interval)
 const int kMinimalPeersRetryIntervalMs = 350;
+const int kMaximalPeersRetryIntervalMs = 5000;
 const int kPeersRetryRate = 3;
 
+// How long results of the daemon RPCs are reused.
+constexpr base::TimeDelta kPeersCacheTTL = base::TimeDelta::FromSeconds(1);
+constexpr base::TimeDelta kAddressesConfigCacheTTL =
+    base::TimeDelta::FromSeconds(10);
+constexpr base::TimeDelta kRepoStatsCacheTTL = base::TimeDelta::FromSeconds(3);
+constexpr base::TimeDelta kNodeInfoCacheTTL = base::TimeDelta::FromSeconds(10);
+
+// Number of CIDs remembered for media prefetch and gateway statistics.
+const size_t kMaxTrackedMediaCIDs = 100;
+
+// How often the node's resource profile is checked, how long the node has to
+// be idle before it is switched to the low power profile, and how long after
+// the last activity it may be relaunched at all.
+constexpr base::TimeDelta kResourceProfileCheckInterval =
+    base::TimeDelta::FromMinutes(5);
+constexpr base::TimeDelta kIdleLowPowerDelay = base::TimeDelta::FromMinutes(30);
+constexpr base::TimeDelta kRelaunchQuietPeriod =
+    base::TimeDelta::FromMinutes(1);
+
 std::pair<bool, std::string> LoadConfigFileOnFileTaskRunner(
     const base::FilePath& path) {
   std::string data;
@@ -105,6 +132,13 @@ IpfsService::IpfsService(
     : prefs_(prefs),
       url_loader_factory_(url_loader_factory),
       blob_context_getter_factory_(std::move(blob_context_getter_factory)),
+      peers_cache_(kPeersCacheTTL),
+      addresses_config_cache_(kAddressesConfigCacheTTL),
+      repo_stats_cache_(kRepoStatsCacheTTL),
+      node_info_cache_(kNodeInfoCacheTTL),
+      prefetched_cids_(kMaxTrackedMediaCIDs),
+      media_request_times_(kMaxTrackedMediaCIDs),
+      gateway_stats_(kMaxTrackedMediaCIDs),
       server_endpoint_(GetAPIServer(channel)),
       user_data_dir_(user_data_dir),
       ipfs_client_updater_(ipfs_client_updater),
@@ -186,6 +220,13 @@ void IpfsService::LaunchIfNotRunning(const base::FilePath& executable_path) {
   if (ipfs_service_.is_bound())
     return;
 
+  // Activity which caused the launch may not have been reported yet.
+  if (last_activity_time_.is_null())
+    last_activity_time_ = base::TimeTicks::Now();
+  low_power_profile_ = ShouldUseLowPowerProfile();
+
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN0("brave.ipfs", "IpfsService::Launch",
+                                    TRACE_ID_LOCAL(this));
   content::ServiceProcessHost::Launch(
       ipfs_service_.BindNewPipeAndPassReceiver(),
       content::ServiceProcessHost::Options()
@@ -200,7 +241,7 @@ void IpfsService::LaunchIfNotRunning(const base::FilePath& executable_path) {
   auto config = mojom::IpfsConfig::New(
       executable_path, GetConfigFilePath(), GetDataPath(),
       GetGatewayPort(channel_), GetAPIPort(channel_), GetSwarmPort(channel_),
-      GetStorageSize());
+      GetStorageSize(), low_power_profile_);
 
   ipfs_service_->Launch(
       std::move(config),
@@ -266,9 +307,15 @@ void IpfsService::NotifyDaemonLaunched(bool result, int64_t pid) {
 }
 
 void IpfsService::OnIpfsLaunched(bool result, int64_t pid) {
+  TRACE_EVENT_NESTABLE_ASYNC_END1("brave.ipfs", "IpfsService::Launch",
+                                  TRACE_ID_LOCAL(this), "result", result);
   if (result) {
     ipfs_pid_ = pid;
     RegisterIpfsClientUpdater();
+    if (base::FeatureList::IsEnabled(features::kIpfsAdaptiveResourceProfile)) {
+      resource_profile_timer_.Start(FROM_HERE, kResourceProfileCheckInterval,
+                                    this, &IpfsService::UpdateResourceProfile);
+    }
   } else {
     VLOG(0) << "Failed to launch IPFS";
     Shutdown();
@@ -282,6 +329,52 @@ void IpfsService::Shutdown() {
   }
   ipfs_service_.reset();
   ipfs_pid_ = -1;
+  resource_profile_timer_.Stop();
+  InvalidateRpcCaches();
+}
+
+void IpfsService::NotifyDaemonActivity() {
+  last_activity_time_ = base::TimeTicks::Now();
+}
+
+bool IpfsService::ShouldUseLowPowerProfile() const {
+  if (!base::FeatureList::IsEnabled(features::kIpfsAdaptiveResourceProfile))
+    return false;
+  if (base::PowerMonitor::IsOnBatteryPower())
+    return true;
+  auto* memory_pressure_monitor = base::MemoryPressureMonitor::Get();
+  if (memory_pressure_monitor &&
+      memory_pressure_monitor->GetCurrentPressureLevel() !=
+          base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE) {
+    return true;
+  }
+  return !last_activity_time_.is_null() &&
+         base::TimeTicks::Now() - last_activity_time_ >= kIdleLowPowerDelay;
+}
+
+void IpfsService::UpdateResourceProfile() {
+  if (!IsDaemonLaunched() || ShouldUseLowPowerProfile() == low_power_profile_)
+    return;
+  // Don't interrupt requests in flight or a user who is browsing the gateway,
+  // the next check will try again.
+  if (!url_loaders_.empty() ||
+      base::TimeTicks::Now() - last_activity_time_ < kRelaunchQuietPeriod) {
+    return;
+  }
+#if BUILDFLAG(IPFS_LOCAL_NODE_ENABLED)
+  if (!importers_.empty())
+    return;
+#endif
+  VLOG(1) << "Relaunching IPFS node with the "
+          << (low_power_profile_ ? "default" : "low power") << " profile";
+  RestartDaemon();
+}
+
+void IpfsService::InvalidateRpcCaches() {
+  peers_cache_.Invalidate();
+  addresses_config_cache_.Invalidate();
+  repo_stats_cache_.Invalidate();
+  node_info_cache_.Invalidate();
 }
 #if BUILDFLAG(IPFS_LOCAL_NODE_ENABLED)
 void IpfsService::NotifyIpnsKeysLoaded(bool result) {
@@ -370,6 +463,9 @@ void IpfsService::ImportDirectoryToIpfs(const base::FilePath& folder,
   importers_[hash] = std::make_unique<IpfsImportWorkerBase>(
       blob_context_getter_factory_.get(), url_loader_factory_.get(),
       server_endpoint_, std::move(import_completed_callback), key);
+  importers_[hash]->SetProgressCallback(
+      base::BindRepeating(&IpfsService::OnImportProgress,
+                          weak_factory_.GetWeakPtr(), folder));
   importers_[hash]->ImportFolder(folder);
 }
 
@@ -408,6 +504,14 @@ void IpfsService::OnImportFinished(ipfs::ImportCompletedCallback callback,
     std::move(callback).Run(data);
 
   importers_.erase(key);
+  NotifyDaemonActivity();
+}
+
+void IpfsService::OnImportProgress(const base::FilePath& folder,
+                                   size_t imported_files,
+                                   size_t total_files) {
+  for (auto& observer : observers_)
+    observer.OnImportProgress(folder, imported_files, total_files);
 }
 #endif
 void IpfsService::GetConnectedPeers(GetConnectedPeersCallback callback,
@@ -425,6 +529,21 @@ void IpfsService::GetConnectedPeers(GetConnectedPeersCallback callback,
     return;
   }
 
+  // Observers are notified once per caller so that callers which only listen
+  // to observer notifications still get an answer from the cache.
+  if (peers_cache_.Add(base::BindOnce(&IpfsService::NotifyConnectedPeers,
+                                      weak_factory_.GetWeakPtr(),
+                                      std::move(callback)))) {
+    RequestConnectedPeers(retries);
+  }
+}
+
+void IpfsService::RequestConnectedPeers(int retries) {
+  if (!IsDaemonLaunched()) {
+    peers_cache_.Complete(false, std::vector<std::string>{});
+    return;
+  }
+
   auto url_loader =
       CreateURLLoader(server_endpoint_.Resolve(kSwarmPeersPath), "POST");
   auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
@@ -432,20 +551,34 @@ void IpfsService::GetConnectedPeers(GetConnectedPeersCallback callback,
   iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_.get(),
       base::BindOnce(&IpfsService::OnGetConnectedPeers, base::Unretained(this),
-                     iter, std::move(callback), retries));
+                     iter, retries));
+}
+
+void IpfsService::NotifyConnectedPeers(GetConnectedPeersCallback callback,
+                                       bool success,
+                                       const std::vector<std::string>& peers) {
+  if (callback)
+    std::move(callback).Run(success, peers);
+
+  for (auto& observer : observers_) {
+    observer.OnGetConnectedPeers(success, peers);
+  }
 }
 
-base::TimeDelta IpfsService::CalculatePeersRetryTime() {
+base::TimeDelta IpfsService::CalculatePeersRetryTime(int retries) {
   if (zero_peer_time_for_test_)
     return base::TimeDelta();
+  int attempt = std::max(0, kPeersDefaultRetries - retries);
+  int interval_ms = kMinimalPeersRetryIntervalMs;
+  while (attempt-- > 0 && interval_ms < kMaximalPeersRetryIntervalMs)
+    interval_ms *= 2;
+  interval_ms = std::min(interval_ms, kMaximalPeersRetryIntervalMs);
   return base::TimeDelta::FromMilliseconds(
-      base::RandInt(kMinimalPeersRetryIntervalMs,
-                    kPeersRetryRate * kMinimalPeersRetryIntervalMs));
+      base::RandInt(interval_ms, kPeersRetryRate * interval_ms));
 }
 
 void IpfsService::OnGetConnectedPeers(
     SimpleURLLoaderList::iterator iter,
-    GetConnectedPeersCallback callback,
     int retry_number,
     std::unique_ptr<std::string> response_body) {
   auto* url_loader = iter->get();
@@ -458,10 +591,9 @@ void IpfsService::OnGetConnectedPeers(
   if (error_code == net::ERR_CONNECTION_REFUSED && retry_number) {
     base::SequencedTaskRunnerHandle::Get()->PostDelayedTask(
         FROM_HERE,
-        base::BindOnce(&IpfsService::GetConnectedPeers,
-                       weak_factory_.GetWeakPtr(), std::move(callback),
-                       retry_number - 1),
-        CalculatePeersRetryTime());
+        base::BindOnce(&IpfsService::RequestConnectedPeers,
+                       weak_factory_.GetWeakPtr(), retry_number - 1),
+        CalculatePeersRetryTime(retry_number));
     return;
   }
 
@@ -475,12 +607,7 @@ void IpfsService::OnGetConnectedPeers(
   if (success)
     success = IPFSJSONParser::GetPeersFromJSON(*response_body, &peers);
 
-  if (callback)
-    std::move(callback).Run(success, peers);
-
-  for (auto& observer : observers_) {
-    observer.OnGetConnectedPeers(success, peers);
-  }
+  peers_cache_.Complete(success, peers);
 }
 
 void IpfsService::GetAddressesConfig(GetAddressesConfigCallback callback) {
@@ -489,6 +616,9 @@ void IpfsService::GetAddressesConfig(GetAddressesConfigCallback callback) {
     return;
   }
 
+  if (!addresses_config_cache_.Add(std::move(callback)))
+    return;
+
   GURL gurl = net::AppendQueryParameter(server_endpoint_.Resolve(kConfigPath),
                                         kArgQueryParam, kAddressesField);
   auto url_loader = CreateURLLoader(gurl, "POST");
@@ -497,12 +627,11 @@ void IpfsService::GetAddressesConfig(GetAddressesConfigCallback callback) {
   iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_.get(),
       base::BindOnce(&IpfsService::OnGetAddressesConfig, base::Unretained(this),
-                     iter, std::move(callback)));
+                     iter));
 }
 
 void IpfsService::OnGetAddressesConfig(
     SimpleURLLoaderList::iterator iter,
-    GetAddressesConfigCallback callback,
     std::unique_ptr<std::string> response_body) {
   auto* url_loader = iter->get();
   int error_code = url_loader->NetError();
@@ -515,13 +644,13 @@ void IpfsService::OnGetAddressesConfig(
   if (error_code != net::OK || response_code != net::HTTP_OK) {
     VLOG(1) << "Fail to get addresses config, error_code = " << error_code
             << " response_code = " << response_code;
-    std::move(callback).Run(false, addresses_config);
+    addresses_config_cache_.Complete(false, addresses_config);
     return;
   }
 
   bool success = IPFSJSONParser::GetAddressesConfigFromJSON(*response_body,
                                                             &addresses_config);
-  std::move(callback).Run(success, addresses_config);
+  addresses_config_cache_.Complete(success, addresses_config);
 }
 
 bool IpfsService::IsDaemonLaunched() const {
@@ -548,6 +677,7 @@ void IpfsService::StartDaemonAndLaunch(
 }
 
 void IpfsService::LaunchDaemon(LaunchDaemonCallback callback) {
+  TRACE_EVENT0("brave.ipfs", "IpfsService::LaunchDaemon");
   if (IsDaemonLaunched()) {
     if (callback)
       std::move(callback).Run(true);
@@ -630,6 +760,7 @@ void IpfsService::SetAllowIpfsLaunchForTest(bool launched) {
 
 void IpfsService::SetServerEndpointForTest(const GURL& gurl) {
   server_endpoint_ = gurl;
+  InvalidateRpcCaches();
 }
 
 void IpfsService::RunLaunchDaemonCallbackForTest(bool result) {
@@ -659,6 +790,9 @@ void IpfsService::GetRepoStats(GetRepoStatsCallback callback) {
     return;
   }
 
+  if (!repo_stats_cache_.Add(std::move(callback)))
+    return;
+
   GURL gurl =
       net::AppendQueryParameter(server_endpoint_.Resolve(ipfs::kRepoStatsPath),
                                 ipfs::kRepoStatsHumanReadableParamName,
@@ -668,12 +802,10 @@ void IpfsService::GetRepoStats(GetRepoStatsCallback callback) {
 
   iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_.get(),
-      base::BindOnce(&IpfsService::OnRepoStats, base::Unretained(this), iter,
-                     std::move(callback)));
+      base::BindOnce(&IpfsService::OnRepoStats, base::Unretained(this), iter));
 }
 
 void IpfsService::OnRepoStats(SimpleURLLoaderList::iterator iter,
-                              GetRepoStatsCallback callback,
                               std::unique_ptr<std::string> response_body) {
   auto* url_loader = iter->get();
   int error_code = url_loader->NetError();
@@ -686,13 +818,13 @@ void IpfsService::OnRepoStats(SimpleURLLoaderList::iterator iter,
   if (error_code != net::OK || response_code != net::HTTP_OK) {
     VLOG(1) << "Fail to get repro stats, error_code = " << error_code
             << " response_code = " << response_code;
-    std::move(callback).Run(false, repo_stats);
+    repo_stats_cache_.Complete(false, repo_stats);
     return;
   }
 
   bool success =
       IPFSJSONParser::GetRepoStatsFromJSON(*response_body, &repo_stats);
-  std::move(callback).Run(success, repo_stats);
+  repo_stats_cache_.Complete(success, repo_stats);
 }
 
 void IpfsService::GetNodeInfo(GetNodeInfoCallback callback) {
@@ -701,18 +833,19 @@ void IpfsService::GetNodeInfo(GetNodeInfoCallback callback) {
     return;
   }
 
+  if (!node_info_cache_.Add(std::move(callback)))
+    return;
+
   GURL gurl = server_endpoint_.Resolve(ipfs::kNodeInfoPath);
   auto url_loader = CreateURLLoader(gurl, "POST");
   auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
 
   iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_.get(),
-      base::BindOnce(&IpfsService::OnNodeInfo, base::Unretained(this), iter,
-                     std::move(callback)));
+      base::BindOnce(&IpfsService::OnNodeInfo, base::Unretained(this), iter));
 }
 
 void IpfsService::OnNodeInfo(SimpleURLLoaderList::iterator iter,
-                             GetNodeInfoCallback callback,
                              std::unique_ptr<std::string> response_body) {
   auto* url_loader = iter->get();
   int error_code = url_loader->NetError();
@@ -725,13 +858,13 @@ void IpfsService::OnNodeInfo(SimpleURLLoaderList::iterator iter,
   if (error_code != net::OK || response_code != net::HTTP_OK) {
     VLOG(1) << "Fail to get node info, error_code = " << error_code
             << " response_code = " << response_code;
-    std::move(callback).Run(false, node_info);
+    node_info_cache_.Complete(false, node_info);
     return;
   }
 
   bool success =
       IPFSJSONParser::GetNodeInfoFromJSON(*response_body, &node_info);
-  std::move(callback).Run(success, node_info);
+  node_info_cache_.Complete(success, node_info);
 }
 
 void IpfsService::RunGarbageCollection(GarbageCollectionCallback callback) {
@@ -794,4 +927,73 @@ void IpfsService::OnPreWarmComplete(
     std::move(prewarm_callback_for_testing_).Run();
 }
 
+void IpfsService::PrefetchMediaBlocks(const std::string& cid) {
+  if (cid.empty())
+    return;
+  NotifyDaemonActivity();
+  media_request_times_.Put(cid, base::TimeTicks::Now());
+
+  if (!IsDaemonLaunched() || prefetching_cids_.count(cid) ||
+      prefetched_cids_.Peek(cid) != prefetched_cids_.end())
+    return;
+  prefetching_cids_.insert(cid);
+
+  // Listing the refs recursively makes the node fetch every block of the DAG.
+  GURL gurl = net::AppendQueryParameter(server_endpoint_.Resolve(kRefsPath),
+                                        kArgQueryParam, cid);
+  gurl = net::AppendQueryParameter(gurl, kRefsRecursiveParamName, "true");
+  gurl = net::AppendQueryParameter(gurl, kRefsUniqueParamName, "true");
+  auto url_loader = CreateURLLoader(gurl, "POST");
+  auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
+  iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+      url_loader_factory_.get(),
+      base::BindOnce(&IpfsService::OnMediaBlocksPrefetched,
+                     base::Unretained(this), iter, cid));
+}
+
+void IpfsService::OnMediaBlocksPrefetched(
+    SimpleURLLoaderList::iterator iter,
+    const std::string& cid,
+    std::unique_ptr<std::string> response_body) {
+  auto* url_loader = iter->get();
+  int error_code = url_loader->NetError();
+  int response_code = -1;
+  if (url_loader->ResponseInfo() && url_loader->ResponseInfo()->headers)
+    response_code = url_loader->ResponseInfo()->headers->response_code();
+  url_loaders_.erase(iter);
+  prefetching_cids_.erase(cid);
+
+  if (error_code != net::OK || response_code != net::HTTP_OK) {
+    VLOG(1) << "Fail to prefetch media blocks, error_code = " << error_code
+            << " response_code = " << response_code;
+    return;
+  }
+  prefetched_cids_.Put(cid, true);
+}
+
+void IpfsService::OnGatewayMediaResponse(const std::string& cid,
+                                         int64_t content_length) {
+  auto stats_it = gateway_stats_.Get(cid);
+  if (stats_it == gateway_stats_.end())
+    stats_it = gateway_stats_.Put(cid, GatewayStats());
+  GatewayStats& stats = stats_it->second;
+  stats.responses++;
+  if (content_length > 0)
+    stats.bytes_served += content_length;
+
+  auto time_it = media_request_times_.Peek(cid);
+  if (time_it != media_request_times_.end()) {
+    stats.last_time_to_headers = base::TimeTicks::Now() - time_it->second;
+    media_request_times_.Erase(time_it);
+  }
+}
+
+base::Optional<IpfsService::GatewayStats> IpfsService::GetGatewayStats(
+    const std::string& cid) const {
+  auto it = gateway_stats_.Peek(cid);
+  if (it == gateway_stats_.end())
+    return base::nullopt;
+  return it->second;
+}
+
 }  // namespace ipfs
@@ -10,12 +10,17 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/containers/queue.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/observer_list.h"
+#include "base/optional.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "brave/components/ipfs/addresses_config.h"
 #include "brave/components/ipfs/blob_context_getter_factory.h"
 #include "brave/components/ipfs/brave_ipfs_client_updater.h"
@@ -23,6 +28,7 @@
 #include "brave/components/ipfs/import/imported_data.h"
 #include "brave/components/ipfs/ipfs_constants.h"
 #include "brave/components/ipfs/ipfs_p3a.h"
+#include "brave/components/ipfs/ipfs_rpc_cache.h"
 #include "brave/components/ipfs/node_info.h"
 #include "brave/components/ipfs/repo_stats.h"
 #include "brave/components/services/ipfs/public/mojom/ipfs_service.mojom.h"
@@ -101,6 +107,26 @@ class IpfsService : public KeyedService,
 
   virtual void PreWarmShareableLink(const GURL& url);
 
+  // Media loaded by the local gateway, per root CID.
+  struct GatewayStats {
+    size_t responses = 0;
+    uint64_t bytes_served = 0;
+    // Time from the last request to its response headers.
+    base::TimeDelta last_time_to_headers;
+  };
+
+  // Called when a media element requests |cid| from the local gateway. Asks
+  // the node to fetch the whole DAG once, ahead of the media pipeline.
+  void PrefetchMediaBlocks(const std::string& cid);
+  // Records a local gateway response for |cid|. |content_length| is -1 if
+  // unknown.
+  void OnGatewayMediaResponse(const std::string& cid, int64_t content_length);
+  base::Optional<GatewayStats> GetGatewayStats(const std::string& cid) const;
+
+  // Called when the node serves a request on behalf of the user. The node is
+  // switched to the low power profile after a long time without activity.
+  void NotifyDaemonActivity();
+
 #if BUILDFLAG(IPFS_LOCAL_NODE_ENABLED)
   virtual void ImportFileToIpfs(const base::FilePath& path,
                                 const std::string& key,
@@ -117,6 +143,9 @@ class IpfsService : public KeyedService,
   void OnImportFinished(ipfs::ImportCompletedCallback callback,
                         size_t key,
                         const ipfs::ImportedData& data);
+  void OnImportProgress(const base::FilePath& folder,
+                        size_t imported_files,
+                        size_t total_files);
 #endif
   void GetConnectedPeers(GetConnectedPeersCallback callback,
                          int retries = kPeersDefaultRetries);
@@ -164,26 +193,38 @@ class IpfsService : public KeyedService,
   void NotifyIpnsKeysLoaded(bool result);
   // Launches the ipfs service in an utility process.
   void LaunchIfNotRunning(const base::FilePath& executable_path);
-  base::TimeDelta CalculatePeersRetryTime();
-
+  // Backs off exponentially with the number of attempts already made,
+  // |retries| being the number of attempts left.
+  base::TimeDelta CalculatePeersRetryTime(int retries);
+  // Drops cached daemon RPC results, e.g. when the daemon goes away.
+  void InvalidateRpcCaches();
+  // Whether the node should run with the low power profile right now.
+  bool ShouldUseLowPowerProfile() const;
+  // Relaunches an idle node if its profile no longer matches the system
+  // state.
+  void UpdateResourceProfile();
+
+  void RequestConnectedPeers(int retries);
+  void NotifyConnectedPeers(GetConnectedPeersCallback callback,
+                            bool success,
+                            const std::vector<std::string>& peers);
   void OnGetConnectedPeers(SimpleURLLoaderList::iterator iter,
-                           GetConnectedPeersCallback,
                            int retries,
                            std::unique_ptr<std::string> response_body);
   void OnGetAddressesConfig(SimpleURLLoaderList::iterator iter,
-                            GetAddressesConfigCallback callback,
                             std::unique_ptr<std::string> response_body);
   void OnRepoStats(SimpleURLLoaderList::iterator iter,
-                   GetRepoStatsCallback callback,
                    std::unique_ptr<std::string> response_body);
   void OnNodeInfo(SimpleURLLoaderList::iterator iter,
-                  GetNodeInfoCallback callback,
                   std::unique_ptr<std::string> response_body);
   void OnGarbageCollection(SimpleURLLoaderList::iterator iter,
                            GarbageCollectionCallback callback,
                            std::unique_ptr<std::string> response_body);
   void OnPreWarmComplete(SimpleURLLoaderList::iterator iter,
                          std::unique_ptr<std::string> response_body);
+  void OnMediaBlocksPrefetched(SimpleURLLoaderList::iterator iter,
+                               const std::string& cid,
+                               std::unique_ptr<std::string> response_body);
   std::string GetStorageSize();
   // The remote to the ipfs service running on an utility process. The browser
   // will not launch a new ipfs service process if this remote is already
@@ -200,6 +241,25 @@ class IpfsService : public KeyedService,
 
   base::queue<LaunchDaemonCallback> pending_launch_callbacks_;
 
+  // Concurrent calls of these RPCs share one request to the daemon, and
+  // their results are reused for a short while since the settings page and
+  // the internals page poll them.
+  IpfsRpcCache<std::vector<std::string>> peers_cache_;
+  IpfsRpcCache<ipfs::AddressesConfig> addresses_config_cache_;
+  IpfsRpcCache<ipfs::RepoStats> repo_stats_cache_;
+  IpfsRpcCache<ipfs::NodeInfo> node_info_cache_;
+
+  // DAGs being fetched by the node, and the ones fetched already.
+  std::unordered_set<std::string> prefetching_cids_;
+  base::MRUCache<std::string, bool> prefetched_cids_;
+  base::MRUCache<std::string, base::TimeTicks> media_request_times_;
+  base::MRUCache<std::string, GatewayStats> gateway_stats_;
+
+  // Profile the running node was launched with.
+  bool low_power_profile_ = false;
+  base::TimeTicks last_activity_time_;
+  base::RepeatingTimer resource_profile_timer_;
+
   bool allow_ipfs_launch_for_test_ = false;
   bool skip_get_connected_peers_callback_for_test_ = false;
   bool connected_peers_function_called_ = false;
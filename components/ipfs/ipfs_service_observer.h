@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
 #include "base/observer_list_types.h"
 #include "components/component_updater/component_updater_service.h"
 
@@ -25,6 +26,9 @@ class IpfsServiceObserver : public base::CheckedObserver {
   virtual void OnGetConnectedPeers(bool succes,
                                    const std::vector<std::string>& peers) {}
   virtual void OnIpnsKeysLoaded(bool success) {}
+  virtual void OnImportProgress(const base::FilePath& path,
+                                size_t imported_files,
+                                size_t total_files) {}
 };
 
 }  // namespace ipfs
@@ -134,8 +134,11 @@ NTPBackgroundImagesComponentInstallerPolicy::GetInstallerAttributes() const {
   return update_client::InstallerAttributes();
 }
 
+// NTP images are only needed once a new tab page is shown, so their first
+// update check shouldn't compete with the components the first window needs.
 void OnRegistered(const std::string& component_id) {
-  BraveOnDemandUpdater::GetInstance()->OnDemandUpdate(component_id);
+  BraveOnDemandUpdater::GetInstance()->OnDemandUpdateAfterStartup(
+      component_id);
 }
 
 }  // namespace
@@ -16,6 +16,10 @@
 #include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
 #include "brave/components/brave_component_updater/browser/brave_on_demand_updater.h"
 #include "brave/components/brave_referrals/browser/brave_referrals_service.h"
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
@@ -50,6 +54,16 @@ constexpr char kNTPSRMappingTableComponentID[] =
 constexpr char kNTPSRMappingTableComponentName[] =
     "NTP Super Referral mapping table";
 
+// Enough for a few full resolution wallpapers plus logos and favicons.
+constexpr size_t kMaxImageCacheBytes = 16 * 1024 * 1024;
+
+base::Optional<std::string> ReadImageFile(const base::FilePath& path) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return base::nullopt;
+  return contents;
+}
+
 std::string GetMappingTableData(const base::FilePath& installed_dir) {
   std::string contents;
   const auto json_path = installed_dir.AppendASCII(kNTPSRMappingTableFile);
@@ -101,10 +115,18 @@ NTPBackgroundImagesService::NTPBackgroundImagesService(
     PrefService* local_pref)
     : component_update_service_(cus),
       local_pref_(local_pref),
+      image_cache_(decltype(image_cache_)::NO_AUTO_EVICT),
       weak_factory_(this) {
+  base::trace_event::MemoryDumpManager::GetInstance()
+      ->RegisterDumpProviderWithSequencedTaskRunner(
+          this, "NTPBackgroundImages", base::SequencedTaskRunnerHandle::Get(),
+          base::trace_event::MemoryDumpProvider::Options());
 }
 
-NTPBackgroundImagesService::~NTPBackgroundImagesService() = default;
+NTPBackgroundImagesService::~NTPBackgroundImagesService() {
+  base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
+      this);
+}
 
 void NTPBackgroundImagesService::Init() {
   // Flag override for testing or demo purposes
@@ -393,6 +415,97 @@ bool NTPBackgroundImagesService::HasObserver(Observer* observer) {
   return observer_list_.HasObserver(observer);
 }
 
+void NTPBackgroundImagesService::GetImageFile(
+    const base::FilePath& image_file_path,
+    ImageFileCallback callback) {
+  auto it = image_cache_.Get(image_file_path);
+  if (it != image_cache_.end()) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback), it->second));
+    return;
+  }
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock()},
+      base::BindOnce(&ReadImageFile, image_file_path),
+      base::BindOnce(&NTPBackgroundImagesService::OnGotImageFile,
+                     weak_factory_.GetWeakPtr(), image_file_path,
+                     std::move(callback)));
+}
+
+void NTPBackgroundImagesService::PrefetchImageFile(
+    const base::FilePath& image_file_path) {
+  if (image_file_path.empty() ||
+      image_cache_.Peek(image_file_path) != image_cache_.end()) {
+    return;
+  }
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::BEST_EFFORT},
+      base::BindOnce(&ReadImageFile, image_file_path),
+      base::BindOnce(&NTPBackgroundImagesService::OnGotImageFile,
+                     weak_factory_.GetWeakPtr(), image_file_path,
+                     ImageFileCallback()));
+}
+
+void NTPBackgroundImagesService::OnGotImageFile(
+    const base::FilePath& image_file_path,
+    ImageFileCallback callback,
+    base::Optional<std::string> contents) {
+  scoped_refptr<base::RefCountedMemory> bytes;
+  if (contents) {
+    bytes = base::RefCountedString::TakeString(&contents.value());
+    AddToImageCache(image_file_path, bytes);
+  }
+
+  if (callback)
+    std::move(callback).Run(std::move(bytes));
+}
+
+void NTPBackgroundImagesService::AddToImageCache(
+    const base::FilePath& image_file_path,
+    scoped_refptr<base::RefCountedMemory> bytes) {
+  if (bytes->size() > kMaxImageCacheBytes)
+    return;
+
+  auto it = image_cache_.Peek(image_file_path);
+  if (it != image_cache_.end()) {
+    image_cache_bytes_ -= it->second->size();
+    image_cache_.Erase(it);
+  }
+
+  while (!image_cache_.empty() &&
+         image_cache_bytes_ + bytes->size() > kMaxImageCacheBytes) {
+    auto oldest = image_cache_.rbegin();
+    image_cache_bytes_ -= oldest->second->size();
+    image_cache_.Erase(oldest);
+  }
+
+  image_cache_bytes_ += bytes->size();
+  image_cache_.Put(image_file_path, std::move(bytes));
+}
+
+bool NTPBackgroundImagesService::OnMemoryDump(
+    const base::trace_event::MemoryDumpArgs& args,
+    base::trace_event::ProcessMemoryDump* pmd) {
+  base::trace_event::MemoryAllocatorDump* dump =
+      pmd->CreateAllocatorDump("brave/ntp_background_images/image_cache");
+  dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                  base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                  image_cache_bytes_);
+  dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameObjectCount,
+                  base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                  image_cache_.size());
+
+  // The cached files are heap allocated, so take them out of malloc.
+  const char* system_allocator_pool_name =
+      base::trace_event::MemoryDumpManager::GetInstance()
+          ->system_allocator_pool_name();
+  if (system_allocator_pool_name)
+    pmd->AddSuballocation(dump->guid(), system_allocator_pool_name);
+  return true;
+}
+
 NTPBackgroundImagesData*
 NTPBackgroundImagesService::GetBackgroundImagesData(bool super_referral) const {
   const bool is_sr_enabled =
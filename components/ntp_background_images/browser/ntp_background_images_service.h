@@ -10,11 +10,16 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/gtest_prod_util.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
+#include "base/optional.h"
 #include "base/observer_list.h"
 #include "base/timer/timer.h"
+#include "base/trace_event/memory_dump_provider.h"
 #include "base/values.h"
 #include "components/prefs/pref_change_registrar.h"
 
@@ -29,7 +34,8 @@ namespace ntp_background_images {
 
 struct NTPBackgroundImagesData;
 
-class NTPBackgroundImagesService {
+class NTPBackgroundImagesService
+    : public base::trace_event::MemoryDumpProvider {
  public:
   class Observer {
    public:
@@ -41,12 +47,15 @@ class NTPBackgroundImagesService {
     virtual ~Observer() {}
   };
 
+  using ImageFileCallback =
+      base::OnceCallback<void(scoped_refptr<base::RefCountedMemory>)>;
+
   static void RegisterLocalStatePrefs(PrefRegistrySimple* registry);
 
   NTPBackgroundImagesService(
       component_updater::ComponentUpdateService* cus,
       PrefService* local_pref);
-  virtual ~NTPBackgroundImagesService();
+  ~NTPBackgroundImagesService() override;
 
   NTPBackgroundImagesService(const NTPBackgroundImagesService&) = delete;
   NTPBackgroundImagesService& operator=(
@@ -68,6 +77,18 @@ class NTPBackgroundImagesService {
 
   std::vector<std::string> GetTopSitesFaviconList() const;
 
+  // Runs |callback| with the contents of |image_file_path|, or null if it
+  // can't be read. Recently read files are served from memory.
+  void GetImageFile(const base::FilePath& image_file_path,
+                    ImageFileCallback callback);
+  // Reads |image_file_path| into memory at best effort priority, so a later
+  // GetImageFile() for it doesn't wait on disk.
+  void PrefetchImageFile(const base::FilePath& image_file_path);
+
+  // base::trace_event::MemoryDumpProvider:
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
+
  private:
   friend class TestNTPBackgroundImagesService;
   friend class NTPBackgroundImagesServiceTest;
@@ -120,6 +141,12 @@ class NTPBackgroundImagesService {
       const base::Value& component_info) const;
 
   void CacheTopSitesFaviconList();
+
+  void OnGotImageFile(const base::FilePath& image_file_path,
+                      ImageFileCallback callback,
+                      base::Optional<std::string> contents);
+  void AddToImageCache(const base::FilePath& image_file_path,
+                       scoped_refptr<base::RefCountedMemory> bytes);
   void CheckSIComponentUpdate(const std::string& component_id);
 
   // virtual for test.
@@ -154,6 +181,11 @@ class NTPBackgroundImagesService {
   // not show SI images until user chooses Brave default images. So, we should
   // know the exact timing whether SR assets is ready to use or not.
   base::Value initial_sr_component_info_;
+  // Encoded image files by path, evicted by total size. Component updates
+  // install into new versioned directories, so entries never go stale.
+  base::MRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>>
+      image_cache_;
+  size_t image_cache_bytes_ = 0;
   base::WeakPtrFactory<NTPBackgroundImagesService> weak_factory_;
 };
 
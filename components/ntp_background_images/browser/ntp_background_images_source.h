@@ -8,8 +8,7 @@
 
 #include <string>
 
-#include "base/memory/weak_ptr.h"
-#include "base/optional.h"
+#include "base/gtest_prod_util.h"
 #include "content/public/browser/url_data_source.h"
 
 namespace base {
@@ -20,7 +19,8 @@ namespace ntp_background_images {
 
 class NTPBackgroundImagesService;
 
-// This serves background image data.
+// This serves background image data. Image files are read through
+// NTPBackgroundImagesService, which keeps recently used ones in memory.
 class NTPBackgroundImagesSource : public content::URLDataSource {
  public:
   explicit NTPBackgroundImagesSource(NTPBackgroundImagesService* service);
@@ -35,6 +35,7 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest, BasicTest);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest,
                            BasicSuperReferralDataTest);
+  FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest, CachesImageFile);
 
   // content::URLDataSource overrides:
   std::string GetSource() override;
@@ -46,8 +47,6 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
 
   void GetImageFile(const base::FilePath& image_file_path,
                     GotDataCallback callback);
-  void OnGotImageFile(GotDataCallback callback,
-                      base::Optional<std::string> input);
   bool IsValidPath(const std::string& path) const;
   bool IsLogoPath(const std::string& path) const;
   bool IsDefaultLogoPath(const std::string& path) const;
@@ -58,7 +57,6 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   base::FilePath GetTopSiteFaviconFilePath(const std::string& path) const;
 
   NTPBackgroundImagesService* service_;  // not owned
-  base::WeakPtrFactory<NTPBackgroundImagesSource> weak_factory_;
 };
 
 }  // namespace ntp_background_images
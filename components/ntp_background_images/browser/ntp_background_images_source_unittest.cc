@@ -6,6 +6,11 @@
 #include <memory>
 #include <string>
 
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
 #include "base/test/task_environment.h"
 #include "brave/components/brave_referrals/browser/brave_referrals_service.h"
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
@@ -32,7 +37,8 @@ class NTPBackgroundImagesSourceTest : public testing::Test {
                     base::Value(base::Value::Type::DICTIONARY));
   }
 
-  base::test::SingleThreadTaskEnvironment task_environment;
+  // Image files are read on the thread pool.
+  base::test::TaskEnvironment task_environment;
   TestingPrefServiceSimple local_pref_;
   std::unique_ptr<NTPBackgroundImagesService> service_;
   std::unique_ptr<NTPBackgroundImagesSource> source_;
@@ -78,6 +84,34 @@ TEST_F(NTPBackgroundImagesSourceTest, BasicTest) {
       source_->GetWallpaperIndexFromPath("sponsored-images/wallpaper-3.jpg"));
 }
 
+TEST_F(NTPBackgroundImagesSourceTest, CachesImageFile) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath image_file_path =
+      temp_dir.GetPath().AppendASCII("wallpaper-0.jpg");
+  ASSERT_TRUE(base::WriteFile(image_file_path, "image data"));
+
+  auto get_image_file = [&]() {
+    std::string data;
+    base::RunLoop run_loop;
+    source_->GetImageFile(
+        image_file_path,
+        base::BindLambdaForTesting(
+            [&](scoped_refptr<base::RefCountedMemory> bytes) {
+              data.assign(bytes->front_as<char>(), bytes->size());
+              run_loop.Quit();
+            }));
+    run_loop.Run();
+    return data;
+  };
+
+  EXPECT_EQ("image data", get_image_file());
+
+  // Served from memory once read.
+  ASSERT_TRUE(base::DeleteFile(image_file_path));
+  EXPECT_EQ("image data", get_image_file());
+}
+
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
 
 #if !defined(OS_LINUX)
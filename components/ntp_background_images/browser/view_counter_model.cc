@@ -23,6 +23,21 @@ bool ViewCounterModel::ShouldShowBrandedWallpaper() const {
   return count_to_branded_wallpaper_ == 0;
 }
 
+int ViewCounterModel::GetNextBrandedWallpaperImageIndex() const {
+  if (total_image_count_ <= 0)
+    return -1;
+
+  if (ignore_count_to_branded_wallpaper_)
+    return (current_wallpaper_image_index_ + 1) % total_image_count_;
+
+  // The index only advances when the count wraps around, and the wallpaper
+  // isn't shown on that view.
+  if (count_to_branded_wallpaper_ - 1 != 0)
+    return -1;
+
+  return current_wallpaper_image_index_;
+}
+
 void ViewCounterModel::ResetCurrentWallpaperImageIndex() {
   current_wallpaper_image_index_ = 0;
 }
@@ -28,6 +28,9 @@ class ViewCounterModel {
   }
 
   bool ShouldShowBrandedWallpaper() const;
+  // Returns the image index the branded wallpaper will be shown at after the
+  // next RegisterPageView(), or -1 if it won't be shown then.
+  int GetNextBrandedWallpaperImageIndex() const;
   void RegisterPageView();
   void ResetCurrentWallpaperImageIndex();
 
@@ -80,4 +80,27 @@ TEST(ViewCounterModelTest, NTPSuperReferralTest) {
   }
 }
 
+TEST(ViewCounterModelTest, NextBrandedWallpaperImageIndexTest) {
+  ViewCounterModel model;
+  model.set_total_image_count(kTestImageCount);
+
+  // The next index must match what the following page view shows.
+  for (int i = 0; i < 20; ++i) {
+    const int next_index = model.GetNextBrandedWallpaperImageIndex();
+    model.RegisterPageView();
+    if (model.ShouldShowBrandedWallpaper()) {
+      EXPECT_EQ(model.current_wallpaper_image_index(), next_index);
+    } else {
+      EXPECT_EQ(-1, next_index);
+    }
+  }
+
+  model.set_ignore_count_to_branded_wallpaper(true);
+  for (int i = 0; i < 10; ++i) {
+    const int next_index = model.GetNextBrandedWallpaperImageIndex();
+    model.RegisterPageView();
+    EXPECT_EQ(model.current_wallpaper_image_index(), next_index);
+  }
+}
+
 }  // namespace ntp_background_images
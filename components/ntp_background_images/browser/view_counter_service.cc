@@ -217,9 +217,22 @@ void ViewCounterService::RegisterPageView() {
   // or the user opt-in status changing.
   if (IsBrandedWallpaperActive()) {
     model_.RegisterPageView();
+    PrefetchNextBrandedWallpaper();
   }
 }
 
+void ViewCounterService::PrefetchNextBrandedWallpaper() {
+  auto* data = GetCurrentBrandedWallpaperData();
+  const int index = model_.GetNextBrandedWallpaperImageIndex();
+  if (!data || index < 0 || index >= static_cast<int>(data->backgrounds.size()))
+    return;
+
+  const Background& background = data->backgrounds[index];
+  service_->PrefetchImageFile(background.image_file);
+  service_->PrefetchImageFile(background.logo ? background.logo->image_file
+                                              : data->default_logo.image_file);
+}
+
 void ViewCounterService::BrandedWallpaperLogoClicked(
     const std::string& creative_instance_id,
     const std::string& destination_url,
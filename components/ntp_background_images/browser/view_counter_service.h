@@ -120,6 +120,10 @@ class ViewCounterService : public KeyedService,
 
   void ResetModel();
 
+  // Reads the wallpaper and logo the next page view will show into memory,
+  // so that page doesn't wait on disk for them.
+  void PrefetchNextBrandedWallpaper();
+
   void UpdateP3AValues() const;
 
   NTPBackgroundImagesService* service_ = nullptr;  // not owned
@@ -93,7 +93,8 @@ class NTPBackgroundImagesViewCounterTest : public testing::Test {
   sync_preferences::TestingPrefServiceSyncable* prefs() { return &prefs_; }
 
  protected:
-  base::test::SingleThreadTaskEnvironment task_environment;
+  // Page views prefetch the next wallpaper on the thread pool.
+  base::test::TaskEnvironment task_environment;
   TestingPrefServiceSimple local_pref_;
   sync_preferences::TestingPrefServiceSyncable prefs_;
   std::unique_ptr<ViewCounterService> view_counter_;
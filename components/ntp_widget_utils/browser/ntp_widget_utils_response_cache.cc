@@ -0,0 +1,86 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_widget_utils/browser/ntp_widget_utils_response_cache.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+
+namespace ntp_widget_utils {
+
+ResponseCache::Response::Response() = default;
+
+ResponseCache::Response::Response(const Response& other) = default;
+
+ResponseCache::Response::~Response() = default;
+
+ResponseCache::ResponseCache(const base::TimeDelta& ttl) : ttl_(ttl) {}
+
+ResponseCache::~ResponseCache() = default;
+
+bool ResponseCache::AddRequest(const GURL& url, ResponseCallback callback) {
+  RemoveExpiredResponses();
+
+  auto response_iter = responses_.find(url);
+  if (response_iter != responses_.end()) {
+    // Callers may not expect to be called back before the request returns.
+    // The callback is dropped if the cache goes away, as its owner is gone.
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&ResponseCache::RunCallback,
+                                  weak_factory_.GetWeakPtr(),
+                                  std::move(callback), response_iter->second));
+    return false;
+  }
+
+  auto& callbacks = pending_callbacks_[url];
+  callbacks.push_back(std::move(callback));
+  return callbacks.size() == 1;
+}
+
+void ResponseCache::OnResponse(const GURL& url,
+                               const int status,
+                               const std::string& body,
+                               const Headers& headers) {
+  if (status >= 200 && status <= 299) {
+    Response& response = responses_[url];
+    response.status = status;
+    response.body = body;
+    response.headers = headers;
+    response.time = base::TimeTicks::Now();
+  }
+
+  auto iter = pending_callbacks_.find(url);
+  if (iter == pending_callbacks_.end())
+    return;
+
+  std::vector<ResponseCallback> callbacks = std::move(iter->second);
+  pending_callbacks_.erase(iter);
+
+  for (auto& callback : callbacks)
+    std::move(callback).Run(status, body, headers);
+}
+
+void ResponseCache::Clear() {
+  responses_.clear();
+}
+
+void ResponseCache::RemoveExpiredResponses() {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  for (auto iter = responses_.begin(); iter != responses_.end();) {
+    if (now - iter->second.time >= ttl_)
+      iter = responses_.erase(iter);
+    else
+      ++iter;
+  }
+}
+
+void ResponseCache::RunCallback(ResponseCallback callback,
+                                const Response& response) {
+  std::move(callback).Run(response.status, response.body, response.headers);
+}
+
+}  // namespace ntp_widget_utils
@@ -0,0 +1,75 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_NTP_WIDGET_UTILS_BROWSER_NTP_WIDGET_UTILS_RESPONSE_CACHE_H_
+#define BRAVE_COMPONENTS_NTP_WIDGET_UTILS_BROWSER_NTP_WIDGET_UTILS_RESPONSE_CACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "url/gurl.h"
+
+namespace ntp_widget_utils {
+
+// Caches responses to unauthenticated GET requests of the new tab page
+// widgets for a short time, and shares a single in-flight request between
+// callers asking for the same URL. Opening several new tab pages in quick
+// succession then only fetches market data once.
+class ResponseCache {
+ public:
+  using Headers = std::map<std::string, std::string>;
+  using ResponseCallback = base::OnceCallback<
+      void(const int, const std::string&, const Headers&)>;
+
+  explicit ResponseCache(const base::TimeDelta& ttl);
+  ~ResponseCache();
+
+  ResponseCache(const ResponseCache&) = delete;
+  ResponseCache& operator=(const ResponseCache&) = delete;
+
+  // Queues |callback| for the response to |url|. Returns true if the caller
+  // must start a request for |url| and pass its response to |OnResponse|.
+  // Otherwise |callback| is run asynchronously, either with a cached
+  // response or once the request already in flight completes.
+  bool AddRequest(const GURL& url, ResponseCallback callback);
+
+  // Runs the callbacks queued for |url|. Successful responses are cached.
+  void OnResponse(const GURL& url,
+                  const int status,
+                  const std::string& body,
+                  const Headers& headers);
+
+  void Clear();
+
+ private:
+  struct Response {
+    Response();
+    Response(const Response& other);
+    ~Response();
+
+    int status = 0;
+    std::string body;
+    Headers headers;
+    base::TimeTicks time;
+  };
+
+  void RemoveExpiredResponses();
+
+  void RunCallback(ResponseCallback callback, const Response& response);
+
+  base::TimeDelta ttl_;
+  std::map<GURL, Response> responses_;
+  std::map<GURL, std::vector<ResponseCallback>> pending_callbacks_;
+
+  base::WeakPtrFactory<ResponseCache> weak_factory_{this};
+};
+
+}  // namespace ntp_widget_utils
+
+#endif  // BRAVE_COMPONENTS_NTP_WIDGET_UTILS_BROWSER_NTP_WIDGET_UTILS_RESPONSE_CACHE_H_
@@ -0,0 +1,113 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_widget_utils/browser/ntp_widget_utils_response_cache.h"
+
+#include <string>
+
+#include "base/bind.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=NTPWidgetUtilsResponseCacheTest.*
+
+namespace {
+
+constexpr base::TimeDelta kTTL = base::TimeDelta::FromSeconds(30);
+
+}  // namespace
+
+class NTPWidgetUtilsResponseCacheTest : public testing::Test {
+ public:
+  NTPWidgetUtilsResponseCacheTest()
+      : cache_(kTTL), url_("https://api.crypto.com/v2/public/get-ticker") {}
+
+ protected:
+  ntp_widget_utils::ResponseCache::ResponseCallback RecordResponse(
+      int* calls,
+      std::string* body) {
+    return base::BindOnce(
+        [](int* calls, std::string* body, const int status,
+           const std::string& response_body,
+           const ntp_widget_utils::ResponseCache::Headers& headers) {
+          (*calls)++;
+          *body = response_body;
+        },
+        calls, body);
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  ntp_widget_utils::ResponseCache cache_;
+  GURL url_;
+};
+
+TEST_F(NTPWidgetUtilsResponseCacheTest, SharesInFlightRequest) {
+  int calls = 0;
+  std::string first_body;
+  std::string second_body;
+
+  EXPECT_TRUE(cache_.AddRequest(url_, RecordResponse(&calls, &first_body)));
+  EXPECT_FALSE(cache_.AddRequest(url_, RecordResponse(&calls, &second_body)));
+
+  cache_.OnResponse(url_, 200, "ticker", {});
+
+  EXPECT_EQ(2, calls);
+  EXPECT_EQ("ticker", first_body);
+  EXPECT_EQ("ticker", second_body);
+}
+
+TEST_F(NTPWidgetUtilsResponseCacheTest, ServesCachedResponseWithinTTL) {
+  int calls = 0;
+  std::string body;
+
+  ASSERT_TRUE(cache_.AddRequest(url_, RecordResponse(&calls, &body)));
+  cache_.OnResponse(url_, 200, "ticker", {});
+  ASSERT_EQ(1, calls);
+
+  task_environment_.FastForwardBy(kTTL / 2);
+
+  body.clear();
+  EXPECT_FALSE(cache_.AddRequest(url_, RecordResponse(&calls, &body)));
+  // Cached responses are returned asynchronously.
+  EXPECT_EQ(1, calls);
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(2, calls);
+  EXPECT_EQ("ticker", body);
+}
+
+TEST_F(NTPWidgetUtilsResponseCacheTest, RequestsAgainAfterTTL) {
+  int calls = 0;
+  std::string body;
+
+  ASSERT_TRUE(cache_.AddRequest(url_, RecordResponse(&calls, &body)));
+  cache_.OnResponse(url_, 200, "ticker", {});
+
+  task_environment_.FastForwardBy(kTTL);
+
+  EXPECT_TRUE(cache_.AddRequest(url_, RecordResponse(&calls, &body)));
+}
+
+TEST_F(NTPWidgetUtilsResponseCacheTest, DoesNotCacheFailedResponses) {
+  int calls = 0;
+  std::string body;
+
+  ASSERT_TRUE(cache_.AddRequest(url_, RecordResponse(&calls, &body)));
+  cache_.OnResponse(url_, 500, "error", {});
+  EXPECT_EQ(1, calls);
+
+  EXPECT_TRUE(cache_.AddRequest(url_, RecordResponse(&calls, &body)));
+}
+
+TEST_F(NTPWidgetUtilsResponseCacheTest, KeysByURL) {
+  int calls = 0;
+  std::string body;
+
+  ASSERT_TRUE(cache_.AddRequest(url_, RecordResponse(&calls, &body)));
+  cache_.OnResponse(url_, 200, "ticker", {});
+
+  const GURL other_url("https://api.crypto.com/v2/public/get-instruments");
+  EXPECT_TRUE(cache_.AddRequest(other_url, RecordResponse(&calls, &body)));
+}
@@ -5,18 +5,28 @@
 
 #include "brave/components/p3a/brave_p3a_log_store.h"
 
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/rand_util.h"
+#include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/task/post_task.h"
+#include "base/task/thread_pool.h"
+#include "brave/components/p3a/brave_p3a_log.pb.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
-#include "components/prefs/scoped_user_pref_update.h"
 
 namespace brave {
 
 namespace {
+// Logs were persisted in this pref before moving to a separate file.
 constexpr char kPrefName[] = "p3a.logs";
 constexpr char kLogValueKey[] = "value";
 constexpr char kLogSentKey[] = "sent";
@@ -34,16 +44,44 @@ void RecordP3A(uint64_t answers_count) {
   UMA_HISTOGRAM_EXACT_LINEAR("Brave.P3A.SentAnswersCount", answer, 3);
 }
 
+base::Optional<std::string> ReadLogFile(const base::FilePath& path) {
+  std::string data;
+  if (!base::ReadFileToString(path, &data)) {
+    return base::nullopt;
+  }
+  return data;
+}
+
+std::string GetLogType(base::StringPiece histogram_name) {
+  if (base::StartsWith(histogram_name, "Brave.P2A",
+                       base::CompareCase::SENSITIVE)) {
+    return "p2a";
+  }
+  return "p3a";
+}
+
 }  // namespace
 
 BraveP3ALogStore::BraveP3ALogStore(Delegate* delegate,
-                                   PrefService* local_state)
-    : delegate_(delegate), local_state_(local_state) {
+                                   PrefService* local_state,
+                                   const base::FilePath& log_path,
+                                   bool batch_uploads)
+    : delegate_(delegate),
+      local_state_(local_state),
+      batch_uploads_(batch_uploads),
+      file_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+           base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
+      writer_(log_path, file_task_runner_) {
   DCHECK(delegate_);
   DCHECK(local_state);
 }
 
-BraveP3ALogStore::~BraveP3ALogStore() = default;
+BraveP3ALogStore::~BraveP3ALogStore() {
+  if (writer_.HasPendingWrite()) {
+    writer_.DoScheduledWrite();
+  }
+}
 
 void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
   registry->RegisterDictionaryPref(kPrefName);
@@ -51,52 +89,68 @@ void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
 
 void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
                                    uint64_t value) {
-  LogEntry& entry = log_[histogram_name];
-  entry.value = value;
-  if (!entry.sent) {
-    DCHECK(entry.sent_timestamp.is_null());
-    unsent_entries_.insert(histogram_name);
+  UpdateValues({{histogram_name, value}});
+}
+
+void BraveP3ALogStore::UpdateValues(
+    const base::flat_map<std::string, uint64_t>& values) {
+  bool updated = false;
+  for (const auto& pair : values) {
+    const std::string& histogram_name = pair.first;
+    const uint64_t value = pair.second;
+
+    auto iter = log_.find(histogram_name);
+    if (iter != log_.end() && iter->second.value == value) {
+      continue;
+    }
+
+    LogEntry& entry = log_[histogram_name];
+    entry.value = value;
+    if (!entry.sent) {
+      DCHECK(entry.sent_timestamp.is_null());
+      unsent_entries_.insert(histogram_name);
+    }
+
+    updated = true;
   }
 
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  // Update the persistent values.
+  if (updated) {
+    writer_.ScheduleWrite(this);
+  }
 }
 
 void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
   DCHECK(delegate_->IsActualMetric(histogram_name));
-  log_.erase(histogram_name);
+  if (log_.erase(histogram_name) == 0) {
+    return;
+  }
   unsent_entries_.erase(histogram_name);
 
   // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->RemovePath(histogram_name);
+  writer_.ScheduleWrite(this);
 
-  if (has_staged_log() && staged_entry_key_ == histogram_name) {
-    staged_entry_key_.clear();
+  // Unstage the whole log, other staged entries are staged again later.
+  if (base::Contains(staged_entry_keys_, histogram_name)) {
+    staged_entry_keys_.clear();
     staged_log_.clear();
   }
 }
 
 void BraveP3ALogStore::ResetUploadStamps() {
   // Clear log entries flags.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
   for (auto& pair : log_) {
     if (pair.second.sent) {
       DCHECK(!pair.second.sent_timestamp.is_null());
       DCHECK(!unsent_entries_.contains(pair.first));
 
       pair.second.ResetSentState();
-
-      // Update persistent values.
-      update->SetPath({pair.first, kLogSentKey}, base::Value(pair.second.sent));
-      update->SetPath({pair.first, kLogTimestampKey},
-                      base::Value(pair.second.sent_timestamp.ToDoubleT()));
     }
   }
 
+  // Update persistent values.
+  writer_.ScheduleWrite(this);
+
   RecordP3A(log_.size() - unsent_entries_.size());
 
   // Rebuild the unsent set.
@@ -111,27 +165,17 @@ bool BraveP3ALogStore::has_unsent_logs() const {
 }
 
 bool BraveP3ALogStore::has_staged_log() const {
-  return !staged_entry_key_.empty();
+  return !staged_entry_keys_.empty();
 }
 
 const std::string& BraveP3ALogStore::staged_log() const {
-  DCHECK(!staged_entry_key_.empty());
-  auto iter = log_.find(staged_entry_key_);
-  DCHECK(iter != log_.end());
-
+  DCHECK(has_staged_log());
   return staged_log_;
 }
 
 std::string BraveP3ALogStore::staged_log_type() const {
-  DCHECK(!staged_entry_key_.empty());
-  auto iter = log_.find(staged_entry_key_);
-  DCHECK(iter != log_.end());
-
-  if (base::StartsWith(iter->first, "Brave.P2A",
-                       base::CompareCase::SENSITIVE)) {
-    return "p2a";
-  }
-  return "p3a";
+  DCHECK(has_staged_log());
+  return GetLogType(staged_entry_keys_.front());
 }
 
 const std::string& BraveP3ALogStore::staged_log_hash() const {
@@ -148,13 +192,36 @@ void BraveP3ALogStore::StageNextLog() {
   // Stage the next item.
   DCHECK(has_unsent_logs());
   uint64_t rand_idx = base::RandGenerator(unsent_entries_.size());
-  staged_entry_key_ = *(unsent_entries_.begin() + rand_idx);
-  DCHECK(!log_.find(staged_entry_key_)->second.sent);
+  const std::string& next_entry_key = *(unsent_entries_.begin() + rand_idx);
+  DCHECK(!log_.find(next_entry_key)->second.sent);
 
-  uint64_t staged_entry_value = log_[staged_entry_key_].value;
-  staged_log_ = delegate_->Serialize(staged_entry_key_, staged_entry_value);
+  if (!batch_uploads_) {
+    staged_entry_keys_ = {next_entry_key};
+    uint64_t staged_entry_value = log_[next_entry_key].value;
+    staged_log_ = delegate_->Serialize(next_entry_key, staged_entry_value);
 
-  VLOG(2) << "BraveP3ALogStore::StageNextLog: staged " << staged_entry_key_;
+    VLOG(2) << "BraveP3ALogStore::StageNextLog: staged " << next_entry_key;
+    return;
+  }
+
+  // P3A and P2A entries go to different endpoints, so batch only the entries
+  // of the randomly picked type. Unlike single entries, the entries of a batch
+  // are linkable to each other, see |switches::kP3ABatchUploads|.
+  const std::string log_type = GetLogType(next_entry_key);
+  base::flat_map<std::string, uint64_t> staged_entries;
+  staged_entry_keys_.clear();
+  for (const std::string& entry_key : unsent_entries_) {
+    if (GetLogType(entry_key) != log_type) {
+      continue;
+    }
+    DCHECK(!log_.find(entry_key)->second.sent);
+    staged_entry_keys_.push_back(entry_key);
+    staged_entries[entry_key] = log_[entry_key].value;
+  }
+  staged_log_ = delegate_->SerializeBatch(staged_entries);
+
+  VLOG(2) << "BraveP3ALogStore::StageNextLog: staged "
+          << staged_entry_keys_.size() << " " << log_type << " entries";
 }
 
 void BraveP3ALogStore::DiscardStagedLog() {
@@ -162,25 +229,25 @@ void BraveP3ALogStore::DiscardStagedLog() {
     return;
   }
 
-  // Mark previous staged log as sent.
-  auto log_iter = log_.find(staged_entry_key_);
-  DCHECK(log_iter != log_.end());
-  log_iter->second.MarkAsSent();
+  for (const std::string& staged_entry_key : staged_entry_keys_) {
+    // Mark previous staged log as sent.
+    auto log_iter = log_.find(staged_entry_key);
+    DCHECK(log_iter != log_.end());
+    log_iter->second.MarkAsSent();
 
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({log_iter->first, kLogSentKey},
-                  base::Value(log_iter->second.sent));
-  update->SetPath({log_iter->first, kLogTimestampKey},
-                  base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
-
-  // Erase the entry from the unsent queue.
-  auto unsent_entries_iter = unsent_entries_.find(staged_entry_key_);
-  DCHECK(unsent_entries_iter != unsent_entries_.end());
-  unsent_entries_.erase(unsent_entries_iter);
-
-  staged_entry_key_.clear();
+    // Erase the entry from the unsent queue.
+    auto unsent_entries_iter = unsent_entries_.find(staged_entry_key);
+    DCHECK(unsent_entries_iter != unsent_entries_.end());
+    unsent_entries_.erase(unsent_entries_iter);
+  }
+
+  staged_entry_keys_.clear();
   staged_log_.clear();
+
+  // Update the persistent values. Write them out right away, a value marked as
+  // sent would be uploaded again if the write were lost.
+  writer_.ScheduleWrite(this);
+  writer_.DoScheduledWrite();
 }
 
 void BraveP3ALogStore::MarkStagedLogAsSent() {}
@@ -190,18 +257,97 @@ void BraveP3ALogStore::TrimAndPersistUnsentLogs() {
 }
 
 void BraveP3ALogStore::LoadPersistedUnsentLogs() {
+  NOTREACHED();
+}
+
+bool BraveP3ALogStore::SerializeData(std::string* data) {
+  brave_p3a::Log log;
+  for (const auto& pair : log_) {
+    brave_p3a::LogEntry* entry = log.add_entries();
+    entry->set_histogram_name(pair.first);
+    entry->set_value(pair.second.value);
+    entry->set_sent(pair.second.sent);
+    entry->set_sent_timestamp(
+        pair.second.sent_timestamp.ToDeltaSinceWindowsEpoch().InMicroseconds());
+  }
+  return log.SerializeToString(data);
+}
+
+void BraveP3ALogStore::Load(base::OnceClosure callback) {
   DCHECK(log_.empty());
   DCHECK(unsent_entries_.empty());
 
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  base::DictionaryValue* list = update.Get();
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&ReadLogFile, writer_.path()),
+      base::BindOnce(&BraveP3ALogStore::OnLoaded,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback)));
+}
+
+void BraveP3ALogStore::OnLoaded(base::OnceClosure callback,
+                                base::Optional<std::string> data) {
+  if (!data || !LoadFromData(*data)) {
+    // Nothing is stored yet, or the file is corrupted. Logs may still be in
+    // prefs if they were persisted by an older version.
+    log_.clear();
+    unsent_entries_.clear();
+    LoadFromPrefs();
+    // Hand the migrated logs to the file writer before clearing the pref, so
+    // they are not lost if the browser exits before a scheduled write.
+    writer_.ScheduleWrite(this);
+    writer_.DoScheduledWrite();
+    local_state_->ClearPref(kPrefName);
+  }
+
+  std::move(callback).Run();
+}
+
+bool BraveP3ALogStore::LoadFromData(const std::string& data) {
+  brave_p3a::Log log;
+  if (!log.ParseFromString(data)) {
+    return false;
+  }
+
+  bool has_obsolete_entries = false;
+  for (const brave_p3a::LogEntry& persisted_entry : log.entries()) {
+    const std::string& name = persisted_entry.histogram_name();
+    // Check if the metric is obsolete.
+    if (!delegate_->IsActualMetric(name)) {
+      has_obsolete_entries = true;
+      continue;
+    }
+
+    LogEntry entry;
+    entry.value = persisted_entry.value();
+    entry.sent = persisted_entry.sent();
+    if (persisted_entry.sent_timestamp() != 0) {
+      entry.sent_timestamp = base::Time::FromDeltaSinceWindowsEpoch(
+          base::TimeDelta::FromMicroseconds(persisted_entry.sent_timestamp()));
+    }
+    if (entry.sent == entry.sent_timestamp.is_null()) {
+      return false;
+    }
+
+    log_[name] = entry;
+    if (!entry.sent) {
+      unsent_entries_.insert(name);
+    }
+  }
+
+  // Drop obsolete metrics from the file.
+  if (has_obsolete_entries) {
+    writer_.ScheduleWrite(this);
+  }
+  return true;
+}
+
+void BraveP3ALogStore::LoadFromPrefs() {
+  const base::DictionaryValue* list = local_state_->GetDictionary(kPrefName);
   for (auto dict_item : list->DictItems()) {
     LogEntry entry;
     const std::string name = dict_item.first;
     // Check if the metric is obsolete.
     if (!delegate_->IsActualMetric(name)) {
-      // Drop it from the local state.
-      list->RemoveKey(name);
       continue;
     }
     const base::Value& dict = dict_item.second;
@@ -7,9 +7,15 @@
 #define BRAVE_COMPONENTS_P3A_BRAVE_P3A_LOG_STORE_H_
 
 #include <string>
+#include <vector>
 
+#include "base/callback_forward.h"
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
+#include "base/files/important_file_writer.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/optional.h"
 #include "base/strings/string_piece.h"
 #include "base/time/time.h"
 #include "components/metrics/log_store.h"
@@ -17,26 +23,42 @@
 class PrefService;
 class PrefRegistrySimple;
 
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
 namespace brave {
 
-// Stores all given values in memory and persists in prefs on the fly.
-// All logs (not only unsent are persistent), and all logs could be loaded
-// using |LoadPersistedUnsentLogs()|. We should fix this at some point since
-// for now persisted entries never expire.
-class BraveP3ALogStore : public metrics::LogStore {
+// Stores all given values in memory and persists them into a protobuf file on
+// a background sequence. Writes are coalesced, so several updates in a row
+// result in one write. All logs (not only unsent are persistent), and all logs
+// could be loaded using |Load()|. We should fix this at some point since for
+// now persisted entries never expire.
+class BraveP3ALogStore : public metrics::LogStore,
+                         public base::ImportantFileWriter::DataSerializer {
  public:
   class Delegate {
    public:
     // Prepares a string representaion of an entry.
     virtual std::string Serialize(base::StringPiece histogram_name,
                                   uint64_t value) = 0;
+    // Prepares a single compressed payload holding all of the given entries.
+    virtual std::string SerializeBatch(
+        const base::flat_map<std::string, uint64_t>& entries) = 0;
     // Returns false if the metric is obsolete and should be cleaned up.
     virtual bool IsActualMetric(base::StringPiece histogram_name) const = 0;
     virtual ~Delegate() {}
   };
 
+  // If |batch_uploads| is set, a staged log holds all unsent entries of the
+  // same type instead of a single randomly picked one. This makes the entries
+  // linkable, so it must stay off by default.
+  // |local_state| is only used to migrate logs persisted in prefs by older
+  // versions.
   BraveP3ALogStore(Delegate* delegate,
-                   PrefService* local_state);
+                   PrefService* local_state,
+                   const base::FilePath& log_path,
+                   bool batch_uploads);
 
   // TODO(iefremov): Make parent destructor virtual?
   virtual ~BraveP3ALogStore();
@@ -44,11 +66,18 @@ class BraveP3ALogStore : public metrics::LogStore {
   static void RegisterPrefs(PrefRegistrySimple* registry);
 
   void UpdateValue(const std::string& histogram_name, uint64_t value);
+  // Same as |UpdateValue| for each entry, with a single pref update. Entries
+  // whose value is unchanged are not written again.
+  void UpdateValues(const base::flat_map<std::string, uint64_t>& values);
   // Removes and also unstages the metric value if it is known and/or staged.
   void RemoveValueIfExists(const std::string& histogram_name);
   // Marks all saved values as unsent.
   void ResetUploadStamps();
 
+  // Reads persisted logs on a background sequence and runs |callback| once
+  // they are available. Values must not be updated before that.
+  void Load(base::OnceClosure callback);
+
   // metrics::LogStore:
   bool has_unsent_logs() const override;
   bool has_staged_log() const override;
@@ -63,9 +92,13 @@ class BraveP3ALogStore : public metrics::LogStore {
   // |TrimAndPersistUnsentLogs| should not be used, since we persist everything
   // on the fly.
   void TrimAndPersistUnsentLogs() override;
-  // Returns early if founds malformed persisted values.
+  // |LoadPersistedUnsentLogs| should not be used, since logs are loaded
+  // asynchronously by |Load|.
   void LoadPersistedUnsentLogs() override;
 
+  // base::ImportantFileWriter::DataSerializer:
+  bool SerializeData(std::string* data) override;
+
  private:
   struct LogEntry {
     LogEntry() {}
@@ -84,19 +117,31 @@ class BraveP3ALogStore : public metrics::LogStore {
     base::Time sent_timestamp;  // At the moment only for debugging purposes.
   };
 
+  void OnLoaded(base::OnceClosure callback, base::Optional<std::string> data);
+  // Returns false if |data| is malformed.
+  bool LoadFromData(const std::string& data);
+  // Returns early if founds malformed persisted values.
+  void LoadFromPrefs();
+
   Delegate* const delegate_ = nullptr;  // Weak.
   PrefService* const local_state_ = nullptr;
+  const bool batch_uploads_ = false;
+
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  base::ImportantFileWriter writer_;
 
   // TODO(iefremov): Try to replace with base::StringPiece?
   base::flat_map<std::string, LogEntry> log_;
   base::flat_set<std::string> unsent_entries_;
 
-  std::string staged_entry_key_;
+  std::vector<std::string> staged_entry_keys_;
   std::string staged_log_;
 
   // Not used for now.
   std::string staged_log_hash_;
   std::string staged_log_signature_;
+
+  base::WeakPtrFactory<BraveP3ALogStore> weak_ptr_factory_{this};
 };
 
 }  // namespace brave
@@ -0,0 +1,150 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_log_store.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "base/values.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveP3ALogStoreTest.*
+
+namespace brave {
+
+namespace {
+
+constexpr char kPrefName[] = "p3a.logs";
+
+class FakeDelegate : public BraveP3ALogStore::Delegate {
+ public:
+  std::string Serialize(base::StringPiece histogram_name,
+                        uint64_t value) override {
+    return std::string(histogram_name) + ":" + base::NumberToString(value);
+  }
+
+  std::string SerializeBatch(
+      const base::flat_map<std::string, uint64_t>& entries) override {
+    std::string batch;
+    for (const auto& entry : entries) {
+      batch += Serialize(entry.first, entry.second) + ";";
+    }
+    return batch;
+  }
+
+  bool IsActualMetric(base::StringPiece histogram_name) const override {
+    return histogram_name != "Brave.Obsolete";
+  }
+};
+
+base::Value CreatePersistedEntry(const std::string& value,
+                                 bool sent,
+                                 double timestamp) {
+  base::Value entry(base::Value::Type::DICTIONARY);
+  entry.SetStringKey("value", value);
+  entry.SetBoolKey("sent", sent);
+  entry.SetDoubleKey("timestamp", timestamp);
+  return entry;
+}
+
+}  // namespace
+
+class BraveP3ALogStoreTest : public testing::Test {
+ public:
+  BraveP3ALogStoreTest() {}
+  ~BraveP3ALogStoreTest() override {}
+
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    log_path_ = temp_dir_.GetPath().AppendASCII("P3A Log");
+    BraveP3ALogStore::RegisterPrefs(local_state_.registry());
+  }
+
+  std::unique_ptr<BraveP3ALogStore> CreateAndLoadLogStore() {
+    auto log_store = std::make_unique<BraveP3ALogStore>(
+        &delegate_, &local_state_, log_path_, /* batch_uploads */ false);
+    base::RunLoop run_loop;
+    log_store->Load(run_loop.QuitClosure());
+    run_loop.Run();
+    // Let any write scheduled while loading reach the file.
+    task_environment_.RunUntilIdle();
+    return log_store;
+  }
+
+  void SetPersistedPrefEntries() {
+    base::Value logs(base::Value::Type::DICTIONARY);
+    logs.SetKey("Brave.Unsent", CreatePersistedEntry("2", false, 0));
+    logs.SetKey("Brave.Sent", CreatePersistedEntry("1", true, 1000));
+    logs.SetKey("Brave.Obsolete", CreatePersistedEntry("3", false, 0));
+    local_state_.Set(kPrefName, logs);
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath log_path_;
+  TestingPrefServiceSimple local_state_;
+  FakeDelegate delegate_;
+};
+
+TEST_F(BraveP3ALogStoreTest, MigratesLogsFromPrefs) {
+  SetPersistedPrefEntries();
+
+  auto log_store = CreateAndLoadLogStore();
+
+  // Only the unsent entry is staged, and the obsolete entry is dropped.
+  ASSERT_TRUE(log_store->has_unsent_logs());
+  log_store->StageNextLog();
+  EXPECT_EQ("Brave.Unsent:2", log_store->staged_log());
+  log_store->DiscardStagedLog();
+  EXPECT_FALSE(log_store->has_unsent_logs());
+
+  // The pref is cleared once the migrated logs are handed to the writer.
+  EXPECT_FALSE(local_state_.HasPrefPath(kPrefName));
+  EXPECT_TRUE(base::PathExists(log_path_));
+}
+
+TEST_F(BraveP3ALogStoreTest, MigratedLogsAreWrittenRightAway) {
+  SetPersistedPrefEntries();
+
+  // The migrating store stays alive, so nothing is written by its destructor
+  // and the regular write delay has not passed.
+  auto migrating_log_store = CreateAndLoadLogStore();
+  ASSERT_FALSE(local_state_.HasPrefPath(kPrefName));
+
+  // The logs are loaded from the file, with the pref gone.
+  auto log_store = CreateAndLoadLogStore();
+  ASSERT_TRUE(log_store->has_unsent_logs());
+  log_store->StageNextLog();
+  EXPECT_EQ("Brave.Unsent:2", log_store->staged_log());
+}
+
+TEST_F(BraveP3ALogStoreTest, DoesNotMigrateOverExistingFile) {
+  {
+    auto log_store = CreateAndLoadLogStore();
+    log_store->UpdateValue("Brave.Stored", 5);
+  }
+  task_environment_.RunUntilIdle();
+
+  // Entries left in the pref are ignored once the logs are stored in the
+  // file.
+  SetPersistedPrefEntries();
+  auto log_store = CreateAndLoadLogStore();
+  ASSERT_TRUE(log_store->has_unsent_logs());
+  log_store->StageNextLog();
+  EXPECT_EQ("Brave.Stored:5", log_store->staged_log());
+  log_store->DiscardStagedLog();
+  EXPECT_FALSE(log_store->has_unsent_logs());
+}
+
+}  // namespace brave
@@ -37,6 +37,7 @@
 #include "content/public/browser/browser_task_traits.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "third_party/metrics_proto/reporting_info.pb.h"
+#include "third_party/zlib/google/compression_utils.h"
 
 namespace brave {
 
@@ -55,6 +56,12 @@ constexpr char kP2AServerUrl[] = "https://p2a.brave.com/";
 
 constexpr uint64_t kDefaultUploadIntervalSeconds = 60;  // 1 minute.
 
+constexpr base::FilePath::CharType kLogFilename[] =
+    FILE_PATH_LITERAL("P3A Log");
+
+// Histogram changes recorded within this interval are applied together.
+constexpr int kPendingHistogramValuesDelaySeconds = 1;
+
 // TODO(iefremov): Provide moar histograms!
 // Whitelist for histograms that we collect. Will be replaced with something
 // updating on the fly.
@@ -197,9 +204,11 @@ base::TimeDelta TimeDeltaTillMonday(base::Time time) {
 }  // namespace
 
 BraveP3AService::BraveP3AService(PrefService* local_state,
+                                 const base::FilePath& user_data_dir,
                                  std::string channel,
                                  std::string week_of_install)
     : local_state_(std::move(local_state)),
+      user_data_dir_(user_data_dir),
       channel_(std::move(channel)),
       week_of_install_(week_of_install) {}
 
@@ -226,8 +235,6 @@ void BraveP3AService::InitCallbacks() {
 void BraveP3AService::Init(
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory) {
   // Init basic prefs.
-  initialized_ = true;
-
   average_upload_interval_ =
       base::TimeDelta::FromSeconds(kDefaultUploadIntervalSeconds);
 
@@ -239,17 +246,24 @@ void BraveP3AService::Init(
           << ", average_upload_interval_ = " << average_upload_interval_
           << ", randomize_upload_interval_ = " << randomize_upload_interval_
           << ", upload_server_url_ = " << upload_server_url_.spec()
+          << ", batch_uploads_ = " << batch_uploads_
           << ", rotation_interval_ = " << rotation_interval_;
 
   InitPyxisMeta();
 
   // Init log store.
-  log_store_.reset(new BraveP3ALogStore(this, local_state_));
-  log_store_->LoadPersistedUnsentLogs();
+  log_store_.reset(new BraveP3ALogStore(this, local_state_,
+                                        user_data_dir_.Append(kLogFilename),
+                                        batch_uploads_));
+  log_store_->Load(base::BindOnce(&BraveP3AService::OnLogStoreLoaded, this,
+                                  url_loader_factory));
+}
+
+void BraveP3AService::OnLogStoreLoaded(
+    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory) {
+  initialized_ = true;
   // Store values that were recorded between calling constructor and |Init()|.
-  for (const auto& entry : histogram_values_) {
-    HandleHistogramChange(entry.first.as_string(), entry.second);
-  }
+  HandleHistogramChanges(histogram_values_);
   histogram_values_ = {};
   // Do rotation if needed.
   const base::Time last_rotation =
@@ -286,7 +300,7 @@ void BraveP3AService::Init(
 
 std::string BraveP3AService::Serialize(base::StringPiece histogram_name,
                                        uint64_t value) {
-  // TRACE_EVENT0("brave_p3a", "SerializeMessage");
+  TRACE_EVENT0("brave.p3a", "SerializeMessage");
   // TODO(iefremov): Maybe we should store it in logs and pass here?
   // We cannot directly query |base::StatisticsRecorder::FindHistogram| because
   // the serialized value can be obtained from persisted log storage at the
@@ -305,6 +319,22 @@ std::string BraveP3AService::Serialize(base::StringPiece histogram_name,
   return message.SerializeAsString();
 }
 
+std::string BraveP3AService::SerializeBatch(
+    const base::flat_map<std::string, uint64_t>& entries) {
+  UpdatePyxisMeta();
+  brave_pyxis::RawP3AValueBatch batch;
+  for (const auto& entry : entries) {
+    prochlo::GenerateP3AMessage(base::HashMetricName(entry.first),
+                                entry.second, pyxis_meta_, batch.add_values());
+  }
+
+  std::string compressed_batch;
+  const bool compressed =
+      compression::GzipCompress(batch.SerializeAsString(), &compressed_batch);
+  DCHECK(compressed);
+  return compressed_batch;
+}
+
 bool
 BraveP3AService::IsActualMetric(base::StringPiece histogram_name) const {
   static const base::NoDestructor<base::flat_set<base::StringPiece>>
@@ -338,6 +368,10 @@ void BraveP3AService::MaybeOverrideSettingsFromCommandLine() {
     }
   }
 
+  if (cmdline->HasSwitch(switches::kP3ABatchUploads)) {
+    batch_uploads_ = true;
+  }
+
   if (cmdline->HasSwitch(switches::kP3AUploadServerUrl)) {
     GURL url =
         GURL(cmdline->GetSwitchValueASCII(switches::kP3AUploadServerUrl));
@@ -400,7 +434,11 @@ void BraveP3AService::StartScheduledUpload() {
     const std::string log_type = log_store_->staged_log_type();
     VLOG(2) << "StartScheduledUpload - Uploading " << log.size() << " bytes "
             << "of type " << log_type;
-    uploader_->UploadLog(log, log_type);
+    if (batch_uploads_) {
+      uploader_->UploadBatch(log, log_type);
+    } else {
+      uploader_->UploadLog(log, log_type);
+    }
   }
 }
 
@@ -414,12 +452,7 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
   // Shortcut for the special values, see |kSuspendedMetricValue|
   // description for details.
   if (IsSuspendedMetric(histogram_name, sample)) {
-    base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                   base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI,
-                                  this,
-                                  histogram_name,
-                                  kSuspendedMetricValue,
-                                  kSuspendedMetricBucket));
+    AddPendingHistogramChange(histogram_name, kSuspendedMetricBucket);
     return;
   }
 
@@ -448,31 +481,56 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
     bucket = DirectEncodingProtocol::Perturb(bucket_count, bucket);
   }
 
-  base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                 base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI, this,
-                                histogram_name, sample, bucket));
-}
-
-void BraveP3AService::OnHistogramChangedOnUI(const char* histogram_name,
-                                             base::HistogramBase::Sample sample,
-                                             size_t bucket) {
   VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
           << histogram_name << " Sample = " << sample << " bucket = " << bucket;
+  AddPendingHistogramChange(histogram_name, bucket);
+}
+
+void BraveP3AService::AddPendingHistogramChange(const char* histogram_name,
+                                                size_t bucket) {
+  base::AutoLock lock(pending_histogram_values_lock_);
+  pending_histogram_values_[histogram_name] = bucket;
+  if (pending_histogram_values_posted_) {
+    return;
+  }
+
+  pending_histogram_values_posted_ = true;
+  base::PostDelayedTask(
+      FROM_HERE, {content::BrowserThread::UI},
+      base::BindOnce(&BraveP3AService::OnHistogramChangesOnUI, this),
+      base::TimeDelta::FromSeconds(kPendingHistogramValuesDelaySeconds));
+}
+
+void BraveP3AService::OnHistogramChangesOnUI() {
+  base::flat_map<base::StringPiece, size_t> values;
+  {
+    base::AutoLock lock(pending_histogram_values_lock_);
+    values.swap(pending_histogram_values_);
+    pending_histogram_values_posted_ = false;
+  }
+
   if (!initialized_) {
     // Will handle it later when ready.
-    histogram_values_[histogram_name] = bucket;
-  } else {
-    HandleHistogramChange(histogram_name, bucket);
+    for (const auto& entry : values) {
+      histogram_values_[entry.first] = entry.second;
+    }
+    return;
   }
+
+  HandleHistogramChanges(values);
 }
 
-void BraveP3AService::HandleHistogramChange(base::StringPiece histogram_name,
-                                            size_t bucket) {
-  if (IsSuspendedMetric(histogram_name, bucket)) {
-    log_store_->RemoveValueIfExists(histogram_name.as_string());
-    return;
+void BraveP3AService::HandleHistogramChanges(
+    const base::flat_map<base::StringPiece, size_t>& values) {
+  base::flat_map<std::string, uint64_t> updated_values;
+  for (const auto& entry : values) {
+    if (IsSuspendedMetric(entry.first, entry.second)) {
+      log_store_->RemoveValueIfExists(entry.first.as_string());
+      continue;
+    }
+    updated_values[entry.first.as_string()] = entry.second;
   }
-  log_store_->UpdateValue(histogram_name.as_string(), bucket);
+  log_store_->UpdateValues(updated_values);
 }
 
 void BraveP3AService::OnLogUploadComplete(int response_code,
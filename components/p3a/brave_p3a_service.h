@@ -10,8 +10,10 @@
 #include <string>
 
 #include "base/containers/flat_map.h"
+#include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
 #include "base/metrics/histogram_base.h"
+#include "base/synchronization/lock.h"
 #include "base/timer/timer.h"
 #include "brave/components/brave_prochlo/brave_prochlo_message.h"
 #include "brave/components/p3a/brave_p3a_log_store.h"
@@ -35,7 +37,9 @@ class BraveP3AUploader;
 class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
                         public BraveP3ALogStore::Delegate {
  public:
+  // Logs are persisted in a file under |user_data_dir|.
   BraveP3AService(PrefService* local_state,
+                  const base::FilePath& user_data_dir,
                   std::string channel,
                   std::string week_of_install);
 
@@ -52,6 +56,8 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // BraveP3ALogStore::Delegate
   std::string Serialize(base::StringPiece histogram_name,
                         uint64_t value) override;
+  std::string SerializeBatch(
+      const base::flat_map<std::string, uint64_t>& entries) override;
 
   // May be accessed from multiple threads, so this is thread-safe.
   bool IsActualMetric(base::StringPiece histogram_name) const override;
@@ -75,12 +81,15 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
                           uint64_t name_hash,
                           base::HistogramBase::Sample sample);
 
-  void OnHistogramChangedOnUI(const char* histogram_name,
-                              base::HistogramBase::Sample sample,
-                              size_t bucket);
+  // Records the latest bucket of |histogram_name| and makes sure that pending
+  // changes are applied on UI thread soon. Can be called on any thread.
+  void AddPendingHistogramChange(const char* histogram_name, size_t bucket);
 
-  // Updates or removes a metric from the log.
-  void HandleHistogramChange(base::StringPiece histogram_name, size_t bucket);
+  void OnHistogramChangesOnUI();
+
+  // Updates or removes metrics from the log.
+  void HandleHistogramChanges(
+      const base::flat_map<base::StringPiece, size_t>& values);
 
   void OnLogUploadComplete(int response_code, int error_code, bool was_https);
 
@@ -89,9 +98,14 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
 
   void UpdateRotationTimer();
 
+  // Completes |Init()| once persisted logs are loaded.
+  void OnLogStoreLoaded(
+      scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
+
   // General prefs:
   bool initialized_ = false;
   PrefService* local_state_ = nullptr;
+  const base::FilePath user_data_dir_;
 
   const std::string channel_;
   const std::string week_of_install_;
@@ -99,6 +113,8 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // The average interval between uploading different values.
   base::TimeDelta average_upload_interval_;
   bool randomize_upload_interval_ = true;
+  // Whether all unsent values of a kind are uploaded in one request.
+  bool batch_uploads_ = false;
   // Interval between rotations, only used for testing from the command line.
   base::TimeDelta rotation_interval_;
   GURL upload_server_url_;
@@ -114,6 +130,12 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // the service and its initialization.
   base::flat_map<base::StringPiece, size_t> histogram_values_;
 
+  // Latest buckets of histograms changed since the last UI task, written on
+  // any thread.
+  base::Lock pending_histogram_values_lock_;
+  base::flat_map<base::StringPiece, size_t> pending_histogram_values_;
+  bool pending_histogram_values_posted_ = false;
+
   // Once fired we restart the overall uploading process.
   base::OneShotTimer rotation_timer_;
 
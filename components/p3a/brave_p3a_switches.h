@@ -22,6 +22,16 @@ constexpr char kP3ARotationIntervalSeconds[] = "p3a-rotation-interval-seconds";
 // P3A cloud backend URL.
 constexpr char kP3AUploadServerUrl[] = "p3a-upload-server-url";
 
+// Upload all unsent values of a kind as one compressed batch instead of
+// uploading them one by one. Requires a backend supporting batches.
+//
+// This is a privacy tradeoff and is off by default. Values uploaded one by
+// one at randomized intervals cannot be told apart from other clients' values,
+// while every value in a batch is known to come from the same client, so the
+// backend can link the answers of a batch together. Only use it for testing
+// until batches are anonymized before they reach the backend.
+constexpr char kP3ABatchUploads[] = "p3a-batch-uploads";
+
 // Do not try to resent values even if a cloud returned an HTTP error, just
 // continue the normal process.
 constexpr char kP3AIgnoreServerErrors[] = "p3a-ignore-server-errors";
@@ -81,13 +81,28 @@ BraveP3AUploader::~BraveP3AUploader() = default;
 
 void BraveP3AUploader::UploadLog(const std::string& compressed_log_data,
                                  const std::string& upload_type) {
+  Upload(compressed_log_data, upload_type, false);
+}
+
+void BraveP3AUploader::UploadBatch(const std::string& compressed_batch_data,
+                                   const std::string& upload_type) {
+  Upload(compressed_batch_data, upload_type, true);
+}
+
+void BraveP3AUploader::Upload(const std::string& data,
+                              const std::string& upload_type,
+                              bool is_batch) {
   auto resource_request = std::make_unique<network::ResourceRequest>();
   if (upload_type == "p2a") {
     resource_request->url = p2a_endpoint_;
     resource_request->headers.SetHeader("X-Brave-P2A", "?1");
+    if (is_batch)
+      resource_request->headers.SetHeader("X-Brave-P2A-Batch", "?1");
   } else if (upload_type == "p3a") {
     resource_request->url = p3a_endpoint_;
     resource_request->headers.SetHeader("X-Brave-P3A", "?1");
+    if (is_batch)
+      resource_request->headers.SetHeader("X-Brave-P3A-Batch", "?1");
   } else {
     NOTREACHED();
   }
@@ -99,7 +114,7 @@ void BraveP3AUploader::UploadLog(const std::string& compressed_log_data,
       std::move(resource_request),
       GetNetworkTrafficAnnotation(upload_type));
   std::string base64;
-  base::Base64Encode(compressed_log_data, &base64);
+  base::Base64Encode(data, &base64);
   url_loader_->AttachStringForUpload(base64, "application/base64");
 
   url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
@@ -35,10 +35,17 @@ class BraveP3AUploader {
   // From metrics::MetricsLogUploader
   void UploadLog(const std::string& compressed_log_data,
                  const std::string& upload_type);
+  // Uploads a gzipped |RawP3AValueBatch| holding several values at once.
+  void UploadBatch(const std::string& compressed_batch_data,
+                   const std::string& upload_type);
 
   void OnUploadComplete(std::unique_ptr<std::string> response_body);
 
  private:
+  void Upload(const std::string& data,
+              const std::string& upload_type,
+              bool is_batch);
+
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   const GURL p3a_endpoint_;
   const GURL p2a_endpoint_;
@@ -65,4 +65,12 @@ void BatAdsServiceImpl::SetDebug(
   std::move(callback).Run();
 }
 
+void BatAdsServiceImpl::SetPerfLog(
+    const bool is_perf_log,
+    SetPerfLogCallback callback) {
+  DCHECK(!is_initialized_);
+  ads::g_is_perf_log = is_perf_log;
+  std::move(callback).Run();
+}
+
 }  // namespace bat_ads
@@ -52,6 +52,10 @@ class BatAdsServiceImpl : public mojom::BatAdsService {
       const bool is_debug,
       SetDebugCallback callback) override;
 
+  void SetPerfLog(
+      const bool is_perf_log,
+      SetPerfLogCallback callback) override;
+
  private:
   mojo::Receiver<mojom::BatAdsService> receiver_;
   bool is_initialized_;
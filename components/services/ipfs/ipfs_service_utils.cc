@@ -15,6 +15,20 @@
 
 namespace ipfs {
 
+namespace {
+
+// Removes a setting written by the low power profile so that the go-ipfs
+// default applies again, leaving values set by the user alone.
+void RemoveIfEquals(base::DictionaryValue* dict,
+                    const std::string& path,
+                    const base::Value& value) {
+  const base::Value* current = dict->FindPath(path);
+  if (current && *current == value)
+    dict->RemovePath(path);
+}
+
+}  // namespace
+
 // Updates the ipfs node config to meet current preferences
 bool UpdateConfigJSON(const std::string& source,
                       const ipfs::mojom::IpfsConfig* config,
@@ -37,9 +51,23 @@ bool UpdateConfigJSON(const std::string& source,
   dict->Set("Addresses.Gateway",
             std::make_unique<base::Value>("/ip4/127.0.0.1/tcp/" +
                                           config->gateway_port));
-  dict->Set("Datastore.GCPeriod", std::make_unique<base::Value>("1h"));
-  dict->Set("Swarm.ConnMgr.LowWater", std::make_unique<base::Value>(50));
-  dict->Set("Swarm.ConnMgr.HighWater", std::make_unique<base::Value>(300));
+  if (config->low_power) {
+    dict->Set("Datastore.GCPeriod", std::make_unique<base::Value>("4h"));
+    dict->Set("Swarm.ConnMgr.LowWater", std::make_unique<base::Value>(20));
+    dict->Set("Swarm.ConnMgr.HighWater", std::make_unique<base::Value>(40));
+    dict->Set("Swarm.ConnMgr.GracePeriod", std::make_unique<base::Value>("1m"));
+    dict->Set("Routing.Type", std::make_unique<base::Value>("dhtclient"));
+    dict->Set("AutoNAT.ServiceMode", std::make_unique<base::Value>("disabled"));
+    dict->Set("Reprovider.Interval", std::make_unique<base::Value>("0"));
+  } else {
+    dict->Set("Datastore.GCPeriod", std::make_unique<base::Value>("1h"));
+    dict->Set("Swarm.ConnMgr.LowWater", std::make_unique<base::Value>(50));
+    dict->Set("Swarm.ConnMgr.HighWater", std::make_unique<base::Value>(300));
+    RemoveIfEquals(dict, "Swarm.ConnMgr.GracePeriod", base::Value("1m"));
+    RemoveIfEquals(dict, "Routing.Type", base::Value("dhtclient"));
+    RemoveIfEquals(dict, "AutoNAT.ServiceMode", base::Value("disabled"));
+    RemoveIfEquals(dict, "Reprovider.Interval", base::Value("0"));
+  }
   dict->Set("Datastore.StorageMax",
             std::make_unique<base::Value>(config->storage_max));
   std::unique_ptr<base::ListValue> list = std::make_unique<base::ListValue>();
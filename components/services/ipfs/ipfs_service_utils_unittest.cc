@@ -4,6 +4,7 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <memory>
+#include <string>
 
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
@@ -22,7 +23,7 @@ TEST_F(IPFSServiceUtils, UpdateConfigJSONTest) {
   std::string updated;
   auto config = ipfs::mojom::IpfsConfig::New(
       base::FilePath(), base::FilePath(), base::FilePath(), "GatewayPort",
-      "APIPort", "SwarmPort", "StorageSize");
+      "APIPort", "SwarmPort", "StorageSize", false);
 
   std::string expect =
       "{\"Addresses\":{\"API\":\"/ip4/127.0.0.1/tcp/APIPort\","
@@ -65,4 +66,44 @@ TEST_F(IPFSServiceUtils, UpdateConfigJSONTest) {
   EXPECT_EQ(updated, "");
 }
 
+TEST_F(IPFSServiceUtils, UpdateConfigJSONLowPowerTest) {
+  std::string json = R"({})";
+  std::string low_power;
+  auto config = ipfs::mojom::IpfsConfig::New(
+      base::FilePath(), base::FilePath(), base::FilePath(), "GatewayPort",
+      "APIPort", "SwarmPort", "StorageSize", true);
+
+  std::string expect =
+      "{\"Addresses\":{\"API\":\"/ip4/127.0.0.1/tcp/APIPort\","
+      "\"Gateway\":\"/ip4/127.0.0.1/tcp/GatewayPort\",\"Swarm\":"
+      "[\"/ip4/0.0.0.0/tcp/SwarmPort\",\"/ip6/::/tcp/SwarmPort\""
+      "]},\"AutoNAT\":{\"ServiceMode\":\"disabled\"},\"Datastore\":"
+      "{\"GCPeriod\":\"4h\",\"StorageMax\":\"StorageSize\"},"
+      "\"Reprovider\":{\"Interval\":\"0\"},\"Routing\":{\"Type\":"
+      "\"dhtclient\"},\"Swarm\":{\"ConnMgr\":{\"GracePeriod\":\"1m\","
+      "\"HighWater\":40,\"LowWater\":20}}}";
+  ASSERT_TRUE(UpdateConfigJSON(json, config.get(), &low_power));
+  EXPECT_EQ(low_power, expect);
+
+  // Switching back restores the defaults.
+  std::string updated;
+  config->low_power = false;
+  expect =
+      "{\"Addresses\":{\"API\":\"/ip4/127.0.0.1/tcp/APIPort\","
+      "\"Gateway\":\"/ip4/127.0.0.1/tcp/GatewayPort\",\"Swarm\":"
+      "[\"/ip4/0.0.0.0/tcp/SwarmPort\",\"/ip6/::/tcp/SwarmPort\""
+      "]},\"Datastore\":{\"GCPeriod\":\"1h\",\"StorageMax\":"
+      "\"StorageSize\"},\"Swarm\":{\"ConnMgr\":{\"HighWater\""
+      ":300,\"LowWater\":50}}}";
+  ASSERT_TRUE(UpdateConfigJSON(low_power, config.get(), &updated));
+  EXPECT_EQ(updated, expect);
+
+  // Values set by the user are kept.
+  updated.clear();
+  json = R"({"Routing":{"Type":"none"}})";
+  ASSERT_TRUE(UpdateConfigJSON(json, config.get(), &updated));
+  EXPECT_NE(updated.find("\"Routing\":{\"Type\":\"none\"}"),
+            std::string::npos);
+}
+
 }  // namespace ipfs
@@ -7,10 +7,13 @@
 
 #include <utility>
 
+#include "base/bind_post_task.h"
 #include "base/command_line.h"
 #include "base/files/file_util.h"
 #include "base/process/launch.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "brave/components/tor/tor_file_watcher.h"
 
 namespace tor {
 
@@ -30,6 +33,9 @@ void TorLauncherImpl::Cleanup() {
   in_shutdown_ = true;
 
   child_monitor_.reset();
+  watching_control_prerequisites_ = false;
+  control_prerequisites_ready_ = false;
+  RunControlPrerequisitesCallback();
 }
 
 TorLauncherImpl::~TorLauncherImpl() {
@@ -101,6 +107,9 @@ void TorLauncherImpl::Launch(mojom::TorConfigPtr config,
 
   bool result = tor_process.IsValid();
 
+  if (result && !tor_watch_path.empty())
+    WatchControlPrerequisites(tor_watch_path, tor_process.Pid());
+
   if (callback)
     std::move(callback).Run(result, tor_process.Pid());
 
@@ -114,6 +123,64 @@ void TorLauncherImpl::SetCrashHandler(SetCrashHandlerCallback callback) {
   crash_handler_callback_ = std::move(callback);
 }
 
+void TorLauncherImpl::GetControlPrerequisites(
+    GetControlPrerequisitesCallback callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // Only one caller waits at a time; a previous one falls back to watching.
+  if (control_prerequisites_callback_)
+    std::move(control_prerequisites_callback_).Run(false, {}, -1);
+  control_prerequisites_callback_ = std::move(callback);
+  if (!watching_control_prerequisites_)
+    RunControlPrerequisitesCallback();
+}
+
+void TorLauncherImpl::WatchControlPrerequisites(
+    const base::FilePath& tor_watch_path,
+    base::ProcessId pid) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  watched_pid_ = pid;
+  watching_control_prerequisites_ = true;
+  control_prerequisites_ready_ = false;
+  control_cookie_.clear();
+  control_port_ = -1;
+
+  // The watcher deletes itself once it is done.
+  TorFileWatcher* tor_file_watcher = new TorFileWatcher(tor_watch_path);
+  tor_file_watcher->StartWatching(base::BindPostTask(
+      base::SequencedTaskRunnerHandle::Get(),
+      base::BindOnce(&TorLauncherImpl::OnControlPrerequisitesReady,
+                     weak_ptr_factory_.GetWeakPtr(), pid)));
+}
+
+void TorLauncherImpl::OnControlPrerequisitesReady(base::ProcessId pid,
+                                                  bool ready,
+                                                  std::vector<uint8_t> cookie,
+                                                  int port) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // Tor may have been relaunched meanwhile.
+  if (pid != watched_pid_ || !watching_control_prerequisites_)
+    return;
+
+  watching_control_prerequisites_ = false;
+  control_prerequisites_ready_ = ready;
+  control_cookie_ = std::move(cookie);
+  control_port_ = port;
+  RunControlPrerequisitesCallback();
+}
+
+void TorLauncherImpl::RunControlPrerequisitesCallback() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!control_prerequisites_callback_)
+    return;
+
+  if (control_prerequisites_ready_) {
+    std::move(control_prerequisites_callback_)
+        .Run(true, control_cookie_, control_port_);
+  } else {
+    std::move(control_prerequisites_callback_).Run(false, {}, -1);
+  }
+}
+
 void TorLauncherImpl::OnChildCrash(base::ProcessId pid) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   if (receiver_.is_bound() && crash_handler_callback_ && !in_shutdown_)
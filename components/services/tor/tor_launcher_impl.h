@@ -7,7 +7,9 @@
 #define BRAVE_COMPONENTS_SERVICES_TOR_TOR_LAUNCHER_IMPL_H_
 
 #include <memory>
+#include <vector>
 
+#include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/process/process.h"
 #include "base/sequence_checker.h"
@@ -30,12 +32,31 @@ class TorLauncherImpl : public tor::mojom::TorLauncher {
   void Shutdown() override;
   void Launch(mojom::TorConfigPtr config, LaunchCallback callback) override;
   void SetCrashHandler(SetCrashHandlerCallback callback) override;
+  void GetControlPrerequisites(
+      GetControlPrerequisitesCallback callback) override;
 
  private:
   void OnChildCrash(base::ProcessId pid);
   void Cleanup();
+  // Starts watching for the control files as soon as Tor is spawned, so they
+  // are picked up right when Tor writes them.
+  void WatchControlPrerequisites(const base::FilePath& tor_watch_path,
+                                 base::ProcessId pid);
+  void OnControlPrerequisitesReady(base::ProcessId pid,
+                                   bool ready,
+                                   std::vector<uint8_t> cookie,
+                                   int port);
+  void RunControlPrerequisitesCallback();
 
   SetCrashHandlerCallback crash_handler_callback_;
+
+  // Control port and auth cookie of the Tor process which is being watched.
+  base::ProcessId watched_pid_ = base::kNullProcessId;
+  bool watching_control_prerequisites_ = false;
+  bool control_prerequisites_ready_ = false;
+  std::vector<uint8_t> control_cookie_;
+  int control_port_ = -1;
+  GetControlPrerequisitesCallback control_prerequisites_callback_;
   std::unique_ptr<brave::ChildProcessMonitor> child_monitor_;
   mojo::Receiver<tor::mojom::TorLauncher> receiver_;
   bool in_shutdown_ = false;
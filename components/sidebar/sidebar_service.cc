@@ -8,8 +8,10 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/feature_list.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "base/values.h"
 #include "brave/components/sidebar/features.h"
 #include "brave/components/sidebar/pref_names.h"
@@ -75,7 +77,13 @@ SidebarService::SidebarService(PrefService* prefs) : prefs_(prefs) {
                           base::Unretained(this)));
 }
 
-SidebarService::~SidebarService() = default;
+SidebarService::~SidebarService() {
+  FlushPendingSidebarItemsUpdate();
+}
+
+void SidebarService::Shutdown() {
+  FlushPendingSidebarItemsUpdate();
+}
 
 void SidebarService::AddItem(const SidebarItem& item) {
   items_.push_back(item);
@@ -85,7 +93,7 @@ void SidebarService::AddItem(const SidebarItem& item) {
     obs.OnItemAdded(item, items_.size() - 1);
   }
 
-  UpdateSidebarItemsToPrefStore();
+  ScheduleUpdateSidebarItemsToPrefStore();
 }
 
 void SidebarService::RemoveItemAt(int index) {
@@ -98,7 +106,7 @@ void SidebarService::RemoveItemAt(int index) {
   for (Observer& obs : observers_)
     obs.OnItemRemoved(removed_item, index);
 
-  UpdateSidebarItemsToPrefStore();
+  ScheduleUpdateSidebarItemsToPrefStore();
 }
 
 void SidebarService::MoveItem(int from, int to) {
@@ -115,10 +123,27 @@ void SidebarService::MoveItem(int from, int to) {
   for (Observer& obs : observers_)
     obs.OnItemMoved(item, from, to);
 
-  UpdateSidebarItemsToPrefStore();
+  ScheduleUpdateSidebarItemsToPrefStore();
+}
+
+void SidebarService::ScheduleUpdateSidebarItemsToPrefStore() {
+  if (pref_update_weak_factory_.HasWeakPtrs())
+    return;
+
+  base::SequencedTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&SidebarService::UpdateSidebarItemsToPrefStore,
+                     pref_update_weak_factory_.GetWeakPtr()));
+}
+
+void SidebarService::FlushPendingSidebarItemsUpdate() {
+  if (pref_update_weak_factory_.HasWeakPtrs())
+    UpdateSidebarItemsToPrefStore();
 }
 
 void SidebarService::UpdateSidebarItemsToPrefStore() {
+  pref_update_weak_factory_.InvalidateWeakPtrs();
+
   ListPrefUpdate update(prefs_, kSidebarItems);
   update->ClearList();
 
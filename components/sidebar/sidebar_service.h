@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "brave/components/sidebar/sidebar_item.h"
 #include "components/keyed_service/core/keyed_service.h"
@@ -62,10 +63,17 @@ class SidebarService : public KeyedService {
   SidebarService(const SidebarService&) = delete;
   SidebarService& operator=(const SidebarService&) = delete;
 
+  // KeyedService overrides:
+  void Shutdown() override;
+
  private:
   FRIEND_TEST_ALL_PREFIXES(SidebarServiceTest, AddRemoveItems);
 
   void LoadSidebarItems();
+  // Item changes made in the same task, e.g. while the user drags an item
+  // across the sidebar, are written to prefs once.
+  void ScheduleUpdateSidebarItemsToPrefStore();
+  void FlushPendingSidebarItemsUpdate();
   void UpdateSidebarItemsToPrefStore();
   std::vector<SidebarItem> GetDefaultSidebarItemsFromCurrentItems() const;
   void OnPreferenceChanged(const std::string& pref_name);
@@ -74,6 +82,7 @@ class SidebarService : public KeyedService {
   std::vector<SidebarItem> items_;
   base::ObserverList<Observer> observers_;
   PrefChangeRegistrar pref_change_registrar_;
+  base::WeakPtrFactory<SidebarService> pref_update_weak_factory_{this};
 };
 
 }  // namespace sidebar
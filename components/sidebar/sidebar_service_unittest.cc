@@ -7,7 +7,9 @@
 
 #include "base/feature_list.h"
 #include "base/test/scoped_feature_list.h"
+#include "base/test/task_environment.h"
 #include "brave/components/sidebar/features.h"
+#include "brave/components/sidebar/pref_names.h"
 #include "brave/components/sidebar/sidebar_service.h"
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -69,6 +71,7 @@ class SidebarServiceTest : public testing::Test,
   bool on_item_removed_called_ = false;
   bool on_item_moved_called_ = false;
 
+  base::test::TaskEnvironment task_environment_;
   TestingPrefServiceSimple prefs_;
   std::unique_ptr<SidebarService> service_;
   base::test::ScopedFeatureList scoped_feature_list_;
@@ -141,4 +144,28 @@ TEST_F(SidebarServiceTest, MoveItem) {
   EXPECT_EQ(item.url, service_->items()[1].url);
 }
 
+TEST_F(SidebarServiceTest, CoalescePrefUpdates) {
+  EXPECT_TRUE(prefs_.FindPreference(kSidebarItems)->IsDefaultValue());
+
+  const SidebarItem item =
+      SidebarItem::Create(GURL("https://www.brave.com/"), std::u16string(),
+                          SidebarItem::Type::kTypeWeb, true);
+  service_->AddItem(item);
+  service_->MoveItem(4, 0);
+  service_->RemoveItemAt(1);
+
+  // Nothing is written until the current task completes.
+  EXPECT_TRUE(prefs_.FindPreference(kSidebarItems)->IsDefaultValue());
+  task_environment_.RunUntilIdle();
+
+  const auto& list = prefs_.GetList(kSidebarItems)->GetList();
+  ASSERT_EQ(4UL, list.size());
+  EXPECT_EQ(item.url.spec(), *list[0].FindStringKey("url"));
+
+  // Pending changes are flushed when the service goes away.
+  service_->RemoveItemAt(0);
+  service_->Shutdown();
+  EXPECT_EQ(3UL, prefs_.GetList(kSidebarItems)->GetList().size());
+}
+
 }  // namespace sidebar
@@ -25,6 +25,9 @@ namespace speedreader {
 
 namespace {
 
+// Enough for the articles of a few busy tabs.
+constexpr size_t kMaxCachedReadableURLs = 100;
+
 std::string GetDistilledPageStylesheet(const base::FilePath& stylesheet_path) {
   std::string stylesheet;
   const bool success = base::ReadFileToString(stylesheet_path, &stylesheet);
@@ -43,7 +46,8 @@ std::string GetDistilledPageStylesheet(const base::FilePath& stylesheet_path) {
 SpeedreaderRewriterService::SpeedreaderRewriterService(
     brave_component_updater::BraveComponent::Delegate* delegate)
     : component_(new speedreader::SpeedreaderComponent(delegate)),
-      speedreader_(new speedreader::SpeedReader) {
+      speedreader_(new speedreader::SpeedReader),
+      readable_urls_(kMaxCachedReadableURLs) {
   if (base::FeatureList::IsEnabled(kSpeedreaderLegacyBackend)) {
     backend_ = RewriterType::RewriterStreaming;
   }
@@ -92,6 +96,16 @@ void SpeedreaderRewriterService::OnStylesheetReady(const base::FilePath& path) {
 }
 
 bool SpeedreaderRewriterService::IsWhitelisted(const GURL& url) {
+  auto it = readable_urls_.Get(url);
+  if (it != readable_urls_.end())
+    return it->second;
+
+  const bool readable = IsWhitelistedUncached(url);
+  readable_urls_.Put(url, readable);
+  return readable;
+}
+
+bool SpeedreaderRewriterService::IsWhitelistedUncached(const GURL& url) {
   if (backend_ == RewriterType::RewriterStreaming) {
     return speedreader_->IsReadableURL(url.spec());
   } else {
@@ -112,8 +126,22 @@ bool SpeedreaderRewriterService::IsWhitelisted(const GURL& url) {
 }
 
 std::unique_ptr<Rewriter> SpeedreaderRewriterService::MakeRewriter(
-    const GURL& url) {
-  return speedreader_->MakeRewriter(url.spec(), backend_);
+    const GURL& url,
+    void (*output_sink)(const char*, size_t, void*),
+    void* output_sink_user_data) {
+  return speedreader_->MakeRewriter(url.spec(), backend_, output_sink,
+                                    output_sink_user_data);
+}
+
+std::unique_ptr<Rewriter> SpeedreaderRewriterService::MakeStreamingRewriter(
+    const GURL& url,
+    void (*output_sink)(const char*, size_t, void*),
+    void* output_sink_user_data) {
+  // The heuristics backend can only distill once it has seen the whole page.
+  if (backend_ != RewriterType::RewriterStreaming)
+    return nullptr;
+  return speedreader_->MakeRewriter(url.spec(), backend_, output_sink,
+                                    output_sink_user_data);
 }
 
 const std::string& SpeedreaderRewriterService::GetContentStylesheet() {
@@ -128,8 +156,10 @@ void SpeedreaderRewriterService::OnLoadStylesheet(std::string stylesheet) {
 void SpeedreaderRewriterService::OnLoadDATFileData(
     GetDATFileDataResult result) {
   VLOG(2) << "Speedreader loaded from DAT file";
-  if (result.first)
+  if (result.first) {
     speedreader_ = std::move(result.first);
+    readable_urls_.Clear();
+  }
 }
 
 }  // namespace speedreader
@@ -9,11 +9,13 @@
 #include <memory>
 #include <string>
 
+#include "base/containers/mru_cache.h"
 #include "base/memory/weak_ptr.h"
 #include "brave/components/brave_component_updater/browser/brave_component.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/speedreader/rust/ffi/speedreader.h"
 #include "brave/components/speedreader/speedreader_component.h"
+#include "url/gurl.h"
 
 namespace base {
 class FilePath;
@@ -24,8 +26,6 @@ class SpeedReader;
 class Rewriter;
 }  // namespace speedreader
 
-class GURL;
-
 namespace speedreader {
 
 class SpeedreaderRewriterService : public SpeedreaderComponent::Observer {
@@ -44,7 +44,18 @@ class SpeedreaderRewriterService : public SpeedreaderComponent::Observer {
 
   // The API
   bool IsWhitelisted(const GURL& url);
-  std::unique_ptr<Rewriter> MakeRewriter(const GURL& url);
+  // Returns a rewriter that passes its output to |output_sink|. With the
+  // default backend all of it arrives once the rewriter is ended.
+  std::unique_ptr<Rewriter> MakeRewriter(
+      const GURL& url,
+      void (*output_sink)(const char*, size_t, void*),
+      void* output_sink_user_data);
+  // Returns a rewriter that passes output to |output_sink| as input is
+  // written, or nullptr if the current backend needs the whole document.
+  std::unique_ptr<Rewriter> MakeStreamingRewriter(
+      const GURL& url,
+      void (*output_sink)(const char*, size_t, void*),
+      void* output_sink_user_data);
   const std::string& GetContentStylesheet();
 
  private:
@@ -53,6 +64,7 @@ class SpeedreaderRewriterService : public SpeedreaderComponent::Observer {
 
   void OnLoadDATFileData(GetDATFileDataResult result);
   void OnLoadStylesheet(std::string stylesheet);
+  bool IsWhitelistedUncached(const GURL& url);
 
   // Default backend is an Arc90 implementation.
   RewriterType backend_ = RewriterType::RewriterHeuristics;
@@ -60,6 +72,9 @@ class SpeedreaderRewriterService : public SpeedreaderComponent::Observer {
   std::string content_stylesheet_;
   std::unique_ptr<speedreader::SpeedreaderComponent> component_;
   std::unique_ptr<speedreader::SpeedReader> speedreader_;
+  // Results of IsWhitelisted(), which is asked again for every navigation
+  // and redirect. Cleared whenever a new whitelist is loaded.
+  base::MRUCache<GURL, bool> readable_urls_;
   base::WeakPtrFactory<SpeedreaderRewriterService> weak_factory_{this};
 };
 
@@ -5,12 +5,16 @@
 
 #include "brave/components/speedreader/speedreader_url_loader.h"
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
 #include "brave/components/speedreader/rust/ffi/speedreader.h"
@@ -25,6 +29,71 @@ namespace {
 
 constexpr uint32_t kReadBufferSize = 32768;
 
+// Distilled output shorter than this means the page wasn't readable.
+// TODO(brave-browser/issues/10372): would be better to pass explicit signal
+// back from rewriter to indicate if content was found
+constexpr size_t kMinDistilledSize = 1024;
+
+// Distilling that takes longer than this is abandoned in favour of the
+// untouched body.
+constexpr base::TimeDelta kDistillLatencyBudget =
+    base::TimeDelta::FromSeconds(1);
+
+// Upper bound on pages distilled at the same time across all loaders.
+constexpr size_t kMaxConcurrentDistills = 2;
+
+// Returns one of kMaxConcurrentDistills worker sequences, so that many pages
+// loading at once (e.g. on session restore) don't take over the thread pool.
+scoped_refptr<base::SequencedTaskRunner> GetDistillTaskRunner() {
+  static base::NoDestructor<
+      std::vector<scoped_refptr<base::SequencedTaskRunner>>>
+      task_runners([] {
+        std::vector<scoped_refptr<base::SequencedTaskRunner>> task_runners;
+        for (size_t i = 0; i < kMaxConcurrentDistills; i++) {
+          task_runners.push_back(base::ThreadPool::CreateSequencedTaskRunner(
+              {base::TaskPriority::USER_BLOCKING}));
+        }
+        return task_runners;
+      }());
+  static std::atomic<size_t> next_task_runner{0};
+  return (*task_runners)[next_task_runner++ % kMaxConcurrentDistills];
+}
+
+// Output sink for the distilling rewriter. |user_data| is the std::string
+// the distilled page is built in.
+void AppendRewriterOutput(const char* data, size_t size, void* user_data) {
+  static_cast<std::string*>(user_data)->append(data, size);
+}
+
+// Returns the distilled page, or base::nullopt if |body| isn't readable.
+// |rewriter| writes its output straight after the stylesheet that |output|
+// starts with, so the distilled page is never copied.
+base::Optional<std::string> Distill(
+    scoped_refptr<base::RefCountedString> body,
+    std::unique_ptr<Rewriter> rewriter,
+    std::unique_ptr<std::string> output) {
+  SCOPED_UMA_HISTOGRAM_TIMER("Brave.Speedreader.Distill");
+  const size_t stylesheet_size = output->size();
+  const std::string& data = body->data();
+  int written = rewriter->Write(data.c_str(), data.length());
+  if (written == 0)
+    rewriter->End();
+  // The rewriter writes into |output|, so it must go first.
+  rewriter.reset();
+  // Error occurred
+  if (written != 0)
+    return base::nullopt;
+
+  if (output->size() - stylesheet_size < kMinDistilledSize)
+    return base::nullopt;
+
+  return std::move(*output);
+}
+
+// Streaming stops reading the body while this much rewritten output is still
+// waiting to be sent.
+constexpr size_t kMaxPendingOutputSize = 4 * kReadBufferSize;
+
 }  // namespace
 
 // static
@@ -122,6 +191,10 @@ void SpeedReaderURLLoader::OnStartLoadingResponseBody(
     mojo::ScopedDataPipeConsumerHandle body) {
   VLOG(2) << __func__ << " " << response_url_;
   state_ = State::kLoading;
+  if (rewriter_service_) {
+    streaming_rewriter_ = rewriter_service_->MakeStreamingRewriter(
+        response_url_, &SpeedReaderURLLoader::OnRewriterOutput, this);
+  }
   body_consumer_handle_ = std::move(body);
   body_consumer_watcher_.Watch(
       body_consumer_handle_.get(),
@@ -147,6 +220,7 @@ void SpeedReaderURLLoader::OnComplete(
       destination_url_loader_client_->OnComplete(status);
       return;
     case State::kLoading:
+    case State::kStreaming:
     case State::kSending:
       // Defer calling OnComplete() until distilling has finished and all
       // data is sent.
@@ -192,6 +266,10 @@ void SpeedReaderURLLoader::ResumeReadingBodyFromNet() {
 }
 
 void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
+  if (streaming_rewriter_ || pass_through_) {
+    ReadStreamingBody();
+    return;
+  }
   DCHECK_EQ(State::kLoading, state_);
 
   size_t start_size = buffered_body_.size();
@@ -205,6 +283,10 @@ void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
     case MOJO_RESULT_FAILED_PRECONDITION:
       // Reading is finished.
       buffered_body_.resize(start_size);
+      if (skip_distilling_) {
+        CompleteLoading(std::move(buffered_body_));
+        return;
+      }
       MaybeLaunchSpeedreader();
       return;
     case MOJO_RESULT_SHOULD_WAIT:
@@ -217,16 +299,126 @@ void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
 
   DCHECK_EQ(MOJO_RESULT_OK, result);
   buffered_body_.resize(start_size + read_bytes);
-  // TODO(iefremov): We actually can partially |pumpContent| to speedreader,
-  // but skipping it for now to simplify things. Pumping is not free in terms
-  // of CPU ticks, so we will have to keep alive speedreader instance on another
-  // thread.
+
+  if (!skip_distilling_ &&
+      article_classifier_.Feed(base::StringPiece(
+          buffered_body_.data() + start_size, read_bytes)) ==
+          ArticleClassifier::Verdict::kNotArticle) {
+    UMA_HISTOGRAM_BOOLEAN("Brave.Speedreader.PassThrough", true);
+    StartPassThrough();
+    return;
+  }
 
   body_consumer_watcher_.ArmOrNotify();
 }
 
-void SpeedReaderURLLoader::OnBodyWritable(MojoResult r) {
-  DCHECK_EQ(State::kSending, state_);
+void SpeedReaderURLLoader::StartPassThrough() {
+  DCHECK_EQ(State::kLoading, state_);
+  VLOG(2) << __func__ << " " << response_url_;
+  state_ = State::kStreaming;
+  pass_through_ = true;
+  bytes_remaining_in_buffer_ = buffered_body_.size();
+  if (!StartSendingToClient())
+    return;
+  SendReceivedBodyToClient();
+  if (state_ == State::kStreaming)
+    body_consumer_watcher_.ArmOrNotify();
+}
+
+// static
+void SpeedReaderURLLoader::OnRewriterOutput(const char* data,
+                                            size_t size,
+                                            void* user_data) {
+  auto* loader = static_cast<SpeedReaderURLLoader*>(user_data);
+  loader->buffered_body_.append(data, size);
+  loader->bytes_remaining_in_buffer_ += size;
+}
+
+void SpeedReaderURLLoader::ReadStreamingBody() {
+  DCHECK(state_ == State::kLoading || state_ == State::kStreaming);
+  DCHECK(streaming_rewriter_ || pass_through_);
+
+  // Hand the pipe's buffer straight to the rewriter instead of copying it.
+  const void* buffer = nullptr;
+  uint32_t read_bytes = 0;
+  MojoResult result = body_consumer_handle_->BeginReadData(
+      &buffer, &read_bytes, MOJO_READ_DATA_FLAG_NONE);
+  switch (result) {
+    case MOJO_RESULT_OK:
+      break;
+    case MOJO_RESULT_FAILED_PRECONDITION:
+      // Reading is finished.
+      FinishStreamingRewrite();
+      return;
+    case MOJO_RESULT_SHOULD_WAIT:
+      body_consumer_watcher_.ArmOrNotify();
+      return;
+    default:
+      NOTREACHED();
+      return;
+  }
+
+  const char* chunk = static_cast<const char*>(buffer);
+  if (state_ == State::kLoading)
+    original_body_.append(chunk, read_bytes);
+  int written = 0;
+  if (pass_through_)
+    OnRewriterOutput(chunk, read_bytes, this);
+  else
+    written = streaming_rewriter_->Write(chunk, read_bytes);
+  body_consumer_handle_->EndReadData(read_bytes);
+  // Error occurred
+  if (written != 0) {
+    FallBackToBuffering();
+    return;
+  }
+
+  if (state_ == State::kLoading &&
+      bytes_remaining_in_buffer_ >= kMinDistilledSize && !StartStreaming()) {
+    return;
+  }
+
+  if (state_ == State::kStreaming) {
+    if (!body_producer_armed_ && bytes_remaining_in_buffer_ > 0) {
+      SendReceivedBodyToClient();
+      if (state_ != State::kStreaming)
+        return;
+    }
+    if (bytes_remaining_in_buffer_ >= kMaxPendingOutputSize) {
+      body_reading_paused_ = true;
+      return;
+    }
+  }
+
+  body_consumer_watcher_.ArmOrNotify();
+}
+
+void SpeedReaderURLLoader::FinishStreamingRewrite() {
+  // Flushes the remaining output through OnRewriterOutput().
+  const int ended = pass_through_ ? 0 : streaming_rewriter_->End();
+  streaming_rewriter_.reset();
+
+  if (state_ == State::kLoading) {
+    // Not enough output to have been sent yet, so the page can still be sent
+    // untouched.
+    if (ended != 0 || bytes_remaining_in_buffer_ < kMinDistilledSize) {
+      CompleteLoading(std::move(original_body_));
+      return;
+    }
+    original_body_.clear();
+    CompleteLoading(rewriter_service_->GetContentStylesheet() +
+                    buffered_body_);
+    return;
+  }
+
+  DCHECK_EQ(State::kStreaming, state_);
+  if (ended != 0) {
+    Abort();
+    return;
+  }
+  body_read_ = true;
+  if (body_producer_armed_)
+    return;
   if (bytes_remaining_in_buffer_ > 0) {
     SendReceivedBodyToClient();
   } else {
@@ -234,6 +426,43 @@ void SpeedReaderURLLoader::OnBodyWritable(MojoResult r) {
   }
 }
 
+void SpeedReaderURLLoader::FallBackToBuffering() {
+  streaming_rewriter_.reset();
+  if (state_ == State::kStreaming) {
+    // Part of the distilled page was already sent.
+    Abort();
+    return;
+  }
+
+  DCHECK_EQ(State::kLoading, state_);
+  skip_distilling_ = true;
+  buffered_body_ = std::move(original_body_);
+  original_body_.clear();
+  bytes_remaining_in_buffer_ = 0;
+  body_consumer_watcher_.ArmOrNotify();
+}
+
+bool SpeedReaderURLLoader::StartStreaming() {
+  DCHECK_EQ(State::kLoading, state_);
+  VLOG(2) << __func__ << " " << response_url_;
+  state_ = State::kStreaming;
+  original_body_ = std::string();
+  buffered_body_.insert(0, rewriter_service_->GetContentStylesheet());
+  bytes_remaining_in_buffer_ = buffered_body_.size();
+  return StartSendingToClient();
+}
+
+void SpeedReaderURLLoader::OnBodyWritable(MojoResult r) {
+  DCHECK(state_ == State::kSending || state_ == State::kStreaming);
+  body_producer_armed_ = false;
+  if (bytes_remaining_in_buffer_ > 0) {
+    SendReceivedBodyToClient();
+  } else if (state_ == State::kSending || body_read_) {
+    CompleteSending();
+  }
+  // Otherwise wait for the rewriter to produce more output.
+}
+
 void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
   DCHECK_EQ(State::kLoading, state_);
   if (!throttle_ || !rewriter_service_) {
@@ -245,52 +474,83 @@ void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
   bytes_remaining_in_buffer_ = buffered_body_.size();
 
   if (bytes_remaining_in_buffer_ > 0) {
-    // Offload heavy distilling to another thread.
-    base::ThreadPool::PostTaskAndReplyWithResult(
-        FROM_HERE, {base::TaskPriority::USER_BLOCKING},
-        base::BindOnce(
-            [](std::string data, std::unique_ptr<Rewriter> rewriter,
-               const std::string& stylesheet) -> auto {
-              SCOPED_UMA_HISTOGRAM_TIMER("Brave.Speedreader.Distill");
-              int written = rewriter->Write(data.c_str(), data.length());
-              // Error occurred
-              if (written != 0) {
-                return data;
-              }
-
-              rewriter->End();
-              const std::string& transformed = rewriter->GetOutput();
-
-              // TODO(brave-browser/issues/10372): would be better to pass
-              // explicit signal back from rewriter to indicate if content was
-              // found
-              if (transformed.length() < 1024) {
-                return data;
-              }
-
-              return stylesheet + transformed;
-            },
-            std::move(buffered_body_),
-            rewriter_service_->MakeRewriter(response_url_),
-            rewriter_service_->GetContentStylesheet()),
-        base::BindOnce(&SpeedReaderURLLoader::CompleteLoading,
+    // Offload heavy distilling to another thread. The body is shared
+    // read-only with the worker so it can still be sent as-is if distilling
+    // takes too long.
+    original_body_for_distill_ =
+        base::RefCountedString::TakeString(&buffered_body_);
+    distill_timeout_timer_.Start(
+        FROM_HERE, kDistillLatencyBudget,
+        base::BindOnce(&SpeedReaderURLLoader::OnDistillTimedOut,
+                       base::Unretained(this)));
+    auto output = std::make_unique<std::string>(
+        rewriter_service_->GetContentStylesheet());
+    std::unique_ptr<Rewriter> rewriter = rewriter_service_->MakeRewriter(
+        response_url_, &AppendRewriterOutput, output.get());
+    GetDistillTaskRunner()->PostTaskAndReplyWithResult(
+        FROM_HERE,
+        base::BindOnce(&Distill, original_body_for_distill_,
+                       std::move(rewriter), std::move(output)),
+        base::BindOnce(&SpeedReaderURLLoader::OnDistilled,
                        weak_factory_.GetWeakPtr()));
     return;
   }
   CompleteLoading(std::move(buffered_body_));
 }
 
+void SpeedReaderURLLoader::OnDistilled(
+    base::Optional<std::string> distilled_body) {
+  // Already sent untouched by OnDistillTimedOut().
+  if (!original_body_for_distill_)
+    return;
+
+  distill_timeout_timer_.Stop();
+  UMA_HISTOGRAM_BOOLEAN("Brave.Speedreader.DistillTimedOut", false);
+  scoped_refptr<base::RefCountedString> original_body =
+      std::move(original_body_for_distill_);
+  if (distilled_body) {
+    CompleteLoading(std::move(*distilled_body));
+  } else if (original_body->HasOneRef()) {
+    CompleteLoading(std::move(original_body->data()));
+  } else {
+    CompleteLoading(original_body->data());
+  }
+}
+
+void SpeedReaderURLLoader::OnDistillTimedOut() {
+  DCHECK(original_body_for_distill_);
+  VLOG(2) << __func__ << " " << response_url_;
+  UMA_HISTOGRAM_BOOLEAN("Brave.Speedreader.DistillTimedOut", true);
+  // The worker may still be reading the body, so send a copy.
+  scoped_refptr<base::RefCountedString> original_body =
+      std::move(original_body_for_distill_);
+  CompleteLoading(original_body->data());
+}
+
 void SpeedReaderURLLoader::CompleteLoading(std::string body) {
   DCHECK_EQ(State::kLoading, state_);
   state_ = State::kSending;
 
-  if (!throttle_) {
-    Abort();
+  buffered_body_ = std::move(body);
+  bytes_remaining_in_buffer_ = buffered_body_.size();
+
+  if (!StartSendingToClient())
+    return;
+
+  DCHECK(bytes_remaining_in_buffer_);
+  if (bytes_remaining_in_buffer_) {
+    SendReceivedBodyToClient();
     return;
   }
 
-  buffered_body_ = std::move(body);
-  bytes_remaining_in_buffer_ = buffered_body_.size();
+  CompleteSending();
+}
+
+bool SpeedReaderURLLoader::StartSendingToClient() {
+  if (!throttle_) {
+    Abort();
+    return false;
+  }
 
   throttle_->Resume();
   mojo::ScopedDataPipeConsumerHandle body_to_send;
@@ -298,7 +558,7 @@ void SpeedReaderURLLoader::CompleteLoading(std::string body) {
       mojo::CreateDataPipe(nullptr, body_producer_handle_, body_to_send);
   if (result != MOJO_RESULT_OK) {
     Abort();
-    return;
+    return false;
   }
   // Set up the watcher for the producer handle.
   body_producer_watcher_.Watch(
@@ -310,18 +570,11 @@ void SpeedReaderURLLoader::CompleteLoading(std::string body) {
   // Send deferred message.
   destination_url_loader_client_->OnStartLoadingResponseBody(
       std::move(body_to_send));
-
-  DCHECK(bytes_remaining_in_buffer_);
-  if (bytes_remaining_in_buffer_) {
-    SendReceivedBodyToClient();
-    return;
-  }
-
-  CompleteSending();
+  return true;
 }
 
 void SpeedReaderURLLoader::CompleteSending() {
-  DCHECK_EQ(State::kSending, state_);
+  DCHECK(state_ == State::kSending || state_ == State::kStreaming);
   state_ = State::kCompleted;
   // Call client's OnComplete() if |this|'s OnComplete() has already been
   // called.
@@ -335,7 +588,7 @@ void SpeedReaderURLLoader::CompleteSending() {
 }
 
 void SpeedReaderURLLoader::SendReceivedBodyToClient() {
-  DCHECK_EQ(State::kSending, state_);
+  DCHECK(state_ == State::kSending || state_ == State::kStreaming);
   // Send the buffered data first.
   DCHECK_GT(bytes_remaining_in_buffer_, 0u);
   size_t start_position = buffered_body_.size() - bytes_remaining_in_buffer_;
@@ -352,6 +605,7 @@ void SpeedReaderURLLoader::SendReceivedBodyToClient() {
       Abort();
       return;
     case MOJO_RESULT_SHOULD_WAIT:
+      body_producer_armed_ = true;
       body_producer_watcher_.ArmOrNotify();
       return;
     default:
@@ -359,12 +613,26 @@ void SpeedReaderURLLoader::SendReceivedBodyToClient() {
       return;
   }
   bytes_remaining_in_buffer_ -= bytes_sent;
+  if (state_ == State::kStreaming) {
+    // Sent output isn't needed again.
+    if (bytes_remaining_in_buffer_ == 0)
+      buffered_body_.clear();
+    if (body_reading_paused_ &&
+        bytes_remaining_in_buffer_ < kMaxPendingOutputSize) {
+      body_reading_paused_ = false;
+      body_consumer_watcher_.ArmOrNotify();
+    }
+  }
+  body_producer_armed_ = true;
   body_producer_watcher_.ArmOrNotify();
 }
 
 void SpeedReaderURLLoader::Abort() {
   VLOG(2) << __func__ << " " << response_url_;
   state_ = State::kAborted;
+  streaming_rewriter_.reset();
+  distill_timeout_timer_.Stop();
+  original_body_for_distill_ = nullptr;
   body_consumer_watcher_.Cancel();
   body_producer_watcher_.Cancel();
   source_url_loader_.reset();
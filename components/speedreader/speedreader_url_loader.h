@@ -6,14 +6,18 @@
 #ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 #define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
 
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "base/strings/string_piece.h"
+#include "base/timer/timer.h"
+#include "brave/components/speedreader/speedreader_util.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/receiver.h"
@@ -25,13 +29,14 @@
 
 namespace speedreader {
 
+class Rewriter;
 class SpeedReaderThrottle;
 class SpeedreaderRewriterService;
 
 // Loads the whole response body and tries to Speedreader-distill it.
 // Cargoculted from |`SniffingURLLoader|.
 //
-// This loader has five states:
+// This loader has six states:
 // kWaitForBody: The initial state until the body is received (=
 //               OnStartLoadingResponseBody() is called) or the response is
 //               finished (= OnComplete() is called). When body is provided, the
@@ -43,6 +48,13 @@ class SpeedreaderRewriterService;
 //            done, this loader will dispatch queued messages like
 //            OnStartLoadingResponseBody() to the destination
 //            loader client, and then the state is changed to kSending.
+// kStreaming: Output is sent to the destination loader client while the rest
+//             of the body is still being read. Entered from kLoading either
+//             once a streaming rewriter has produced enough output to count
+//             as distilled, or once the start of a buffered body shows the
+//             page isn't an article, in which case it passes through
+//             untouched. The state changes to kCompleted after all output is
+//             sent.
 // kSending: Receives the body and sends it to the destination loader client.
 //           The state changes to kCompleted after all data is sent.
 // kCompleted: All data has been sent to the destination loader.
@@ -113,9 +125,29 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   void OnBodyReadable(MojoResult);
   void OnBodyWritable(MojoResult);
   void MaybeLaunchSpeedreader();
+  // Called with the distilled body, or base::nullopt if the page isn't
+  // readable.
+  void OnDistilled(base::Optional<std::string> distilled_body);
+  void OnDistillTimedOut();
+
+  // Streaming mode: feeds the body to |streaming_rewriter_|, or straight to
+  // the output when passing through, as it arrives.
+  static void OnRewriterOutput(const char* data, size_t size, void* user_data);
+  void ReadStreamingBody();
+  void FinishStreamingRewrite();
+  // Goes back to buffering the untouched body after the rewriter failed.
+  void FallBackToBuffering();
+  // Starts sending rewritten output before the whole body has been read.
+  bool StartStreaming();
+  // Sends the body untouched, as it arrives, once |article_classifier_| has
+  // ruled out distilling it.
+  void StartPassThrough();
 
   // Gets either distilled or untouched body.
   void CompleteLoading(std::string body);
+  // Resumes the throttle and hands the destination its body pipe. Returns
+  // false if |this| was aborted instead.
+  bool StartSendingToClient();
   void CompleteSending();
   void SendReceivedBodyToClient();
 
@@ -132,15 +164,46 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
 
   scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
 
-  enum class State { kWaitForBody, kLoading, kSending, kCompleted, kAborted };
+  enum class State {
+    kWaitForBody,
+    kLoading,
+    kStreaming,
+    kSending,
+    kCompleted,
+    kAborted
+  };
   State state_ = State::kWaitForBody;
 
   // Set if OnComplete() is called during distilling.
   base::Optional<network::URLLoaderCompletionStatus> complete_status_;
 
-  // Note that this could be replaced by a distilled version.
+  // Note that this could be replaced by a distilled version. In streaming
+  // mode this holds rewritten output that hasn't been sent yet.
   std::string buffered_body_;
-  size_t bytes_remaining_in_buffer_;
+  size_t bytes_remaining_in_buffer_ = 0;
+
+  // The body while it is being distilled on a worker sequence.
+  scoped_refptr<base::RefCountedString> original_body_for_distill_;
+  // Sends the untouched body if distilling is too slow.
+  base::OneShotTimer distill_timeout_timer_;
+
+  // Set while the body is streamed through the rewriter.
+  std::unique_ptr<Rewriter> streaming_rewriter_;
+  // The untouched body, kept in streaming mode until it is known whether the
+  // page distills.
+  std::string original_body_;
+  // Set once a streaming rewrite failed; the body is then sent untouched.
+  bool skip_distilling_ = false;
+  // Whether the whole body has been read in kStreaming.
+  bool body_read_ = false;
+  // Whether reading was paused until more output has been sent.
+  bool body_reading_paused_ = false;
+  bool body_producer_armed_ = false;
+
+  // Looks at the start of a buffered body to skip pages that won't distill.
+  ArticleClassifier article_classifier_;
+  // Set once the rest of the body is streamed through untouched.
+  bool pass_through_ = false;
 
   mojo::ScopedDataPipeConsumerHandle body_consumer_handle_;
   mojo::ScopedDataPipeProducerHandle body_producer_handle_;
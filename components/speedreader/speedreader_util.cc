@@ -22,6 +22,18 @@ constexpr char kReadablePathMultiComponentHints[] = "/\\d\\d\\d\\d/\\d\\d/";
 
 constexpr char kReadableBlogSubdomain[] = "blog.";
 
+// ArticleClassifier decides once it has seen this much of the <body>.
+constexpr size_t kClassifierBodySampleSize = 32 * 1024;
+// Documents whose <body> doesn't start within this many bytes are left to
+// the distiller.
+constexpr size_t kClassifierMaxScanSize = 256 * 1024;
+// Pages with at least this many paragraphs are treated as articles.
+constexpr size_t kClassifierMinParagraphs = 3;
+// Bodies with a smaller share of visible text than this are mostly markup.
+constexpr double kClassifierMinTextRatio = 0.1;
+// Longer than any tag name the classifier looks at.
+constexpr size_t kClassifierMaxTagNameLength = 8;
+
 }  // namespace
 
 // private constructor
@@ -46,4 +58,122 @@ bool URLReadableHintExtractor::HasHints(const GURL& url) {
   return false;
 }
 
+ArticleClassifier::ArticleClassifier() = default;
+
+ArticleClassifier::~ArticleClassifier() = default;
+
+ArticleClassifier::Verdict ArticleClassifier::Feed(base::StringPiece chunk) {
+  if (verdict_ != Verdict::kUndecided)
+    return verdict_;
+
+  for (const char c : chunk) {
+    total_bytes_++;
+    if (in_body_)
+      body_bytes_++;
+
+    switch (state_) {
+      case State::kText:
+        if (c == '<') {
+          state_ = State::kTagName;
+          tag_name_.clear();
+          closing_tag_ = false;
+        } else if (in_body_ && !base::IsAsciiWhitespace(c)) {
+          text_bytes_++;
+        }
+        break;
+      case State::kRawText:
+        if (c == '<')
+          state_ = State::kRawTextTagOpen;
+        break;
+      case State::kRawTextTagOpen:
+        if (c == '/') {
+          state_ = State::kTagName;
+          tag_name_.clear();
+          closing_tag_ = true;
+        } else if (c != '<') {
+          state_ = State::kRawText;
+        }
+        break;
+      case State::kTagName:
+        if (c == '/' && tag_name_.empty() && !closing_tag_) {
+          closing_tag_ = true;
+        } else if (c == '!' && tag_name_.empty() && !closing_tag_) {
+          state_ = State::kMarkupDeclaration;
+          dashes_ = 0;
+        } else if (base::IsAsciiAlpha(c) || base::IsAsciiDigit(c)) {
+          if (tag_name_.size() <= kClassifierMaxTagNameLength)
+            tag_name_.push_back(base::ToLowerASCII(c));
+        } else {
+          OnTag();
+          if (c == '>')
+            state_ = raw_text_tag_.empty() ? State::kText : State::kRawText;
+          else
+            state_ = State::kTag;
+        }
+        break;
+      case State::kTag:
+        if (c == '>')
+          state_ = raw_text_tag_.empty() ? State::kText : State::kRawText;
+        break;
+      case State::kMarkupDeclaration:
+        // "<!--" starts a comment; anything else, e.g. <!DOCTYPE>, is skipped
+        // like a tag.
+        if (c == '-') {
+          if (++dashes_ == 2) {
+            state_ = State::kComment;
+            dashes_ = 0;
+          }
+        } else {
+          state_ = c == '>' ? State::kText : State::kTag;
+        }
+        break;
+      case State::kComment:
+        if (c == '-') {
+          dashes_++;
+        } else {
+          if (c == '>' && dashes_ >= 2)
+            state_ = State::kText;
+          dashes_ = 0;
+        }
+        break;
+    }
+  }
+
+  MaybeDecide();
+  return verdict_;
+}
+
+void ArticleClassifier::OnTag() {
+  if (!raw_text_tag_.empty()) {
+    // Only the end tag of the <script> or <style> element counts here.
+    if (closing_tag_ && tag_name_ == raw_text_tag_)
+      raw_text_tag_.clear();
+    return;
+  }
+  if (closing_tag_)
+    return;
+
+  if (tag_name_ == "body") {
+    in_body_ = true;
+  } else if (tag_name_ == "script" || tag_name_ == "style") {
+    raw_text_tag_ = tag_name_;
+  } else if (tag_name_ == "article") {
+    article_seen_ = true;
+  } else if (tag_name_ == "p" && in_body_) {
+    paragraphs_++;
+  }
+}
+
+void ArticleClassifier::MaybeDecide() {
+  if (article_seen_ || paragraphs_ >= kClassifierMinParagraphs) {
+    verdict_ = Verdict::kArticle;
+  } else if (in_body_ && body_bytes_ >= kClassifierBodySampleSize) {
+    const double text_ratio = static_cast<double>(text_bytes_) / body_bytes_;
+    verdict_ = text_ratio >= kClassifierMinTextRatio ? Verdict::kArticle
+                                                     : Verdict::kNotArticle;
+  } else if (total_bytes_ >= kClassifierMaxScanSize) {
+    verdict_ = Verdict::kArticle;
+  }
+}
+
 }  // namespace speedreader
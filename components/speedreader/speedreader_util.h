@@ -6,7 +6,12 @@
 #ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_UTIL_H_
 #define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_UTIL_H_
 
+#include <stddef.h>
+
+#include <string>
+
 #include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
 #include "third_party/re2/src/re2/re2.h"
 
 class GURL;
@@ -37,6 +42,56 @@ class URLReadableHintExtractor {
   const re2::RE2 path_multi_component_hints_;
 };
 
+// Cheap guess at whether an HTML document is an article, made from the start
+// of its <body> while the response is still arriving. Looks at <article>
+// and <p> tags and at how much of the body is text rather than markup, so
+// that pages which clearly won't distill needn't be buffered whole.
+class ArticleClassifier {
+ public:
+  enum class Verdict { kUndecided, kArticle, kNotArticle };
+
+  ArticleClassifier();
+  ~ArticleClassifier();
+
+  ArticleClassifier(const ArticleClassifier&) = delete;
+  ArticleClassifier& operator=(const ArticleClassifier&) = delete;
+
+  // Scans the next chunk of the document. Returns kUndecided until enough of
+  // it has been seen; once decided the verdict doesn't change.
+  Verdict Feed(base::StringPiece chunk);
+
+  Verdict verdict() const { return verdict_; }
+
+ private:
+  enum class State {
+    kText,
+    kTagName,
+    kTag,
+    kRawText,
+    kRawTextTagOpen,
+    kMarkupDeclaration,
+    kComment,
+  };
+
+  void OnTag();
+  void MaybeDecide();
+
+  Verdict verdict_ = Verdict::kUndecided;
+  State state_ = State::kText;
+  std::string tag_name_;
+  bool closing_tag_ = false;
+  // Consecutive dashes seen in a markup declaration or comment.
+  size_t dashes_ = 0;
+  // Name of the <script> or <style> element whose contents are being skipped.
+  std::string raw_text_tag_;
+  bool in_body_ = false;
+  size_t total_bytes_ = 0;
+  size_t body_bytes_ = 0;
+  size_t text_bytes_ = 0;
+  size_t paragraphs_ = 0;
+  bool article_seen_ = false;
+};
+
 }  // namespace speedreader
 
 #endif  // BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_UTIL_H_
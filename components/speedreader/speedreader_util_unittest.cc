@@ -4,6 +4,9 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "brave/components/speedreader/speedreader_util.h"
+
+#include <string>
+
 #include "third_party/googletest/src/googletest/include/gtest/gtest.h"
 #include "url/gurl.h"
 
@@ -55,4 +58,67 @@ TEST(SpeedreaderUtilTest, URLHasHints) {
   EXPECT_FALSE(URLReadableHintExtractor::GetInstance()->HasHints(
       GURL("https://fake.com/storyboard")));
 }
+
+TEST(SpeedreaderUtilTest, ArticleClassifierFindsArticles) {
+  {
+    ArticleClassifier classifier;
+    EXPECT_EQ(ArticleClassifier::Verdict::kUndecided,
+              classifier.Feed("<html><head><title>Hi</title></head><body>"));
+    EXPECT_EQ(ArticleClassifier::Verdict::kArticle,
+              classifier.Feed("<ARTICLE><h1>Title</h1>"));
+  }
+  {
+    ArticleClassifier classifier;
+    EXPECT_EQ(ArticleClassifier::Verdict::kArticle,
+              classifier.Feed("<body><p>One</p><p>Two</p><p class=x>Three"));
+  }
+  {
+    // Tags split across chunks.
+    ArticleClassifier classifier;
+    EXPECT_EQ(ArticleClassifier::Verdict::kUndecided, classifier.Feed("<bo"));
+    EXPECT_EQ(ArticleClassifier::Verdict::kUndecided, classifier.Feed("dy><"));
+    EXPECT_EQ(ArticleClassifier::Verdict::kArticle,
+              classifier.Feed("article>"));
+  }
+}
+
+TEST(SpeedreaderUtilTest, ArticleClassifierIgnoresScriptsAndLookalikes) {
+  ArticleClassifier classifier;
+  std::string page =
+      "<body><script>var s = '<article><p><p><p>';</script>"
+      "<style>p { color: red; }</style><articles></articles><pre></pre>";
+  EXPECT_EQ(ArticleClassifier::Verdict::kUndecided, classifier.Feed(page));
+
+  // A body that is almost all markup is not an article.
+  std::string markup;
+  while (markup.size() < 64 * 1024)
+    markup += "<div class=\"widget\"><span data-id=\"1\"></span></div>";
+  EXPECT_EQ(ArticleClassifier::Verdict::kNotArticle, classifier.Feed(markup));
+  // The verdict is final.
+  EXPECT_EQ(ArticleClassifier::Verdict::kNotArticle,
+            classifier.Feed("<article><p><p><p>"));
+}
+
+TEST(SpeedreaderUtilTest, ArticleClassifierIgnoresComments) {
+  ArticleClassifier classifier;
+  std::string page =
+      "<!DOCTYPE html><body><!-- <article> --><!-- a > b <p><p><p> -->"
+      "<!--<article>--><!-";
+  EXPECT_EQ(ArticleClassifier::Verdict::kUndecided, classifier.Feed(page));
+  // Still inside a comment split across chunks.
+  EXPECT_EQ(ArticleClassifier::Verdict::kUndecided,
+            classifier.Feed("- <article> -"));
+  EXPECT_EQ(ArticleClassifier::Verdict::kUndecided,
+            classifier.Feed("-><p>One</p><p>Two</p>"));
+  EXPECT_EQ(ArticleClassifier::Verdict::kArticle, classifier.Feed("<article>"));
+}
+
+TEST(SpeedreaderUtilTest, ArticleClassifierTextHeavyBody) {
+  ArticleClassifier classifier;
+  std::string text = "<body><div>";
+  while (text.size() < 64 * 1024)
+    text += "Lorem ipsum dolor sit amet, consectetur adipiscing elit. ";
+  EXPECT_EQ(ArticleClassifier::Verdict::kArticle, classifier.Feed(text));
+}
+
 }  // namespace speedreader
@@ -6,6 +6,7 @@
 #include "brave/components/sync/driver/brave_sync_auth_manager.h"
 
 #include "base/base64.h"
+#include "base/containers/span.h"
 #include "base/strings/string_number_conversions.h"
 #include "brave/common/network_constants.h"
 #include "brave/components/brave_sync/crypto/crypto.h"
@@ -96,8 +97,7 @@ std::string BraveSyncAuthManager::GenerateAccessToken(
   const std::string timestamp_hex =
       base::HexEncode(timestamp.data(), timestamp.size());
 
-  std::vector<uint8_t> timestamp_bytes;
-  base::HexStringToBytes(timestamp_hex, &timestamp_bytes);
+  const auto timestamp_bytes = base::as_bytes(base::make_span(timestamp));
   std::vector<uint8_t> signature;
   brave_sync::crypto::Sign(timestamp_bytes, private_key_, &signature);
   DCHECK(brave_sync::crypto::Verify(timestamp_bytes, signature, public_key_));
@@ -5,6 +5,8 @@
 
 #include "brave/components/sync/engine/brave_model_type_worker.h"
 
+#include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include "base/feature_list.h"
@@ -91,22 +93,33 @@ bool BraveModelTypeWorker::IsResetProgressMarkerRequired(
     return false;
   }
 
-  bool found_conflict_or_transient = false;
+  std::set<ClientTagHash> failing_entities;
   for (const syncer::FailedCommitResponseData& failed_response_entry :
        error_response_list) {
     if (failed_response_entry.response_type ==
             sync_pb::CommitResponse_ResponseType_CONFLICT ||
         failed_response_entry.response_type ==
             sync_pb::CommitResponse_ResponseType_TRANSIENT_ERROR) {
-      found_conflict_or_transient = true;
-      break;
+      failing_entities.insert(failed_response_entry.client_tag_hash);
     }
   }
 
-  if (found_conflict_or_transient) {
-    ++failed_commit_times_;
-  } else {
+  // Only count failures of entities which failed every time. When the
+  // entities that failed before went through, regular updates are resolving
+  // the conflicts and there is no need to download the whole type again.
+  std::set<ClientTagHash> still_failing;
+  std::set_intersection(failing_entities_.begin(), failing_entities_.end(),
+                        failing_entities.begin(), failing_entities.end(),
+                        std::inserter(still_failing, still_failing.end()));
+  if (failing_entities.empty()) {
     failed_commit_times_ = 0;
+    failing_entities_.clear();
+  } else if (still_failing.empty()) {
+    failed_commit_times_ = 1;
+    failing_entities_ = std::move(failing_entities);
+  } else {
+    ++failed_commit_times_;
+    failing_entities_ = std::move(still_failing);
   }
 
   return failed_commit_times_ >= kFailuresToResetMarker;
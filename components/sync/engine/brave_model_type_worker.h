@@ -7,8 +7,10 @@
 #define BRAVE_COMPONENTS_SYNC_ENGINE_BRAVE_MODEL_TYPE_WORKER_H_
 
 #include <memory>
+#include <set>
 
 #include "base/feature_list.h"
+#include "components/sync/base/client_tag_hash.h"
 #include "components/sync/base/model_type.h"
 #include "components/sync/base/passphrase_enums.h"
 #include "components/sync/engine/commit_and_get_updates_types.h"
@@ -31,6 +33,8 @@ FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest, ResetProgressMarker);
 FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest, ResetProgressMarkerMaxPeriod);
 FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest,
                      ResetProgressMarkerDisabledFeature);
+FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest,
+                     ResetProgressMarkerOnlyForStuckEntities);
 
 class BraveModelTypeWorker : public ModelTypeWorker {
  public:
@@ -52,6 +56,8 @@ class BraveModelTypeWorker : public ModelTypeWorker {
                            ResetProgressMarkerMaxPeriod);
   FRIEND_TEST_ALL_PREFIXES(BraveModelTypeWorkerTest,
                            ResetProgressMarkerDisabledFeature);
+  FRIEND_TEST_ALL_PREFIXES(BraveModelTypeWorkerTest,
+                           ResetProgressMarkerOnlyForStuckEntities);
 
   void OnCommitResponse(
       const CommitResponseDataList& committed_response_list,
@@ -62,6 +68,9 @@ class BraveModelTypeWorker : public ModelTypeWorker {
   void ResetProgressMarker();
 
   size_t failed_commit_times_ = 0;
+  // Entities which got a conflict or transient error in each of the last
+  // |failed_commit_times_| commits.
+  std::set<ClientTagHash> failing_entities_;
   base::Time last_reset_marker_time_;
   static size_t GetFailuresToResetMarkerForTests();
   static base::TimeDelta MinimalTimeBetweenResetForTests();
@@ -5,9 +5,11 @@
 
 #include "brave/components/sync/engine/brave_model_type_worker.h"
 
+#include <string>
 #include <utility>
 
 #include "base/bind.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/test/scoped_feature_list.h"
 #include "base/time/time_override.h"
 #include "components/sync/engine/cancelation_signal.h"
@@ -112,8 +114,10 @@ std::unique_ptr<ScopedTimeClockOverrides> AdvanceTimeToAllowResetMarker() {
 }
 
 FailedCommitResponseDataList MakeErrorResponseList(
-    CommitResponse_ResponseType err_code) {
+    CommitResponse_ResponseType err_code,
+    const std::string& client_tag_hash = std::string()) {
   FailedCommitResponseData data;
+  data.client_tag_hash = ClientTagHash::FromHashed(client_tag_hash);
   data.response_type = err_code;
   return FailedCommitResponseDataList({data});
 }
@@ -189,6 +193,34 @@ TEST_F(BraveModelTypeWorkerTest, ResetProgressMarkerMaxPeriod) {
   EXPECT_FALSE(IsProgressMarkerEmpty());
 }
 
+TEST_F(BraveModelTypeWorkerTest, ResetProgressMarkerOnlyForStuckEntities) {
+  NormalInitialize();
+
+  // A different entity fails each time, so nothing is stuck.
+  for (size_t i = 0;
+       i < BraveModelTypeWorker::GetFailuresToResetMarkerForTests() * 2; ++i) {
+    worker()->OnCommitResponse(
+        CommitResponseDataList(),
+        MakeErrorResponseList(CommitResponse_ResponseType_CONFLICT,
+                              base::NumberToString(i)));
+    EXPECT_FALSE(IsProgressMarkerEmpty());
+  }
+
+  // The same entity keeps failing.
+  for (size_t i = 0;
+       i < BraveModelTypeWorker::GetFailuresToResetMarkerForTests() - 1; ++i) {
+    worker()->OnCommitResponse(
+        CommitResponseDataList(),
+        MakeErrorResponseList(CommitResponse_ResponseType_CONFLICT, "stuck"));
+    EXPECT_FALSE(IsProgressMarkerEmpty());
+  }
+
+  worker()->OnCommitResponse(
+      CommitResponseDataList(),
+      MakeErrorResponseList(CommitResponse_ResponseType_CONFLICT, "stuck"));
+  EXPECT_TRUE(IsProgressMarkerEmpty());
+}
+
 TEST_F(BraveModelTypeWorkerTest, ResetProgressMarkerDisabledFeature) {
   base::test::ScopedFeatureList feature_list;
   feature_list.InitAndDisableFeature(features::kBraveSyncResetProgressMarker);
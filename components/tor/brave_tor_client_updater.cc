@@ -135,7 +135,8 @@ void BraveTorClientUpdater::Register() {
 
   BraveComponent::Register(kTorClientComponentName,
                            g_tor_client_component_id_,
-                           g_tor_client_component_base64_public_key_);
+                           g_tor_client_component_base64_public_key_,
+                           UpdatePriority::kAfterStartup);
   registered_ = true;
 }
 
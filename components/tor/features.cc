@@ -0,0 +1,19 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/tor/features.h"
+
+#include "base/feature_list.h"
+
+namespace tor {
+namespace features {
+
+// Launch Tor in the background once startup is done, so the first Tor window
+// doesn't have to wait for it to bootstrap.
+const base::Feature kTorPrewarm{"TorPrewarm",
+                                base::FEATURE_DISABLED_BY_DEFAULT};
+
+}  // namespace features
+}  // namespace tor
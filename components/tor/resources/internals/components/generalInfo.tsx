@@ -35,6 +35,9 @@ export class GeneralInfo extends React.Component<Props, {}> {
           {getLocale('torInitProgress') + ': '} {this.props.state.generalInfo.torInitPercentage}
           {this.props.state.generalInfo.torInitPercentage ? '%' : ''}
         </div>
+        <div>
+          {getLocale('torStreamConnectTime') + ': '} {this.props.state.generalInfo.streamConnectTimeMs} ms
+        </div>
       </div>
     )
   }
@@ -9,7 +9,8 @@ export const defaultState: TorInternals.State = {
     torPid: -1,
     torProxyURI: '',
     isTorConnected: false,
-    torInitPercentage: ''
+    torInitPercentage: '',
+    streamConnectTimeMs: 0
   },
   log: '',
   torControlEvents: []
@@ -344,6 +344,11 @@ std::string TorControl::SetEventsCmd() {
 //      intermediate line; then call callback for the last line or on
 //      error.
 //
+//      Commands are pipelined: they are written as soon as they are
+//      issued, without waiting for replies to earlier commands.  Tor
+//      answers synchronous commands in the order it received them, so
+//      each reply goes to the callback at the front of cmdq_.
+//
 void TorControl::DoCmd(std::string cmd,
                        PerLineCallback perline,
                        CmdCallback callback) {
@@ -521,7 +526,9 @@ void TorControl::GetCircuitEstablishedDone(
 
 // StartWrite()
 //
-//      Pick a write off the queue and start an I/O buffer for it.
+//      Take every write off the queue and start a single I/O buffer
+//      for them, so commands issued back-to-back share one socket
+//      write.
 //
 //      Caller must ensure writing_ is true.
 //
@@ -530,9 +537,14 @@ void TorControl::StartWrite() {
   DCHECK(writing_);
   DCHECK(!writeq_.empty());
   DCHECK(!cmdq_.empty());
-  auto buf = base::MakeRefCounted<net::StringIOBuffer>(writeq_.front());
-  writeiobuf_ = base::MakeRefCounted<net::DrainableIOBuffer>(buf, buf->size());
+  std::string data = std::move(writeq_.front());
   writeq_.pop();
+  while (!writeq_.empty()) {
+    data += writeq_.front();
+    writeq_.pop();
+  }
+  auto buf = base::MakeRefCounted<net::StringIOBuffer>(std::move(data));
+  writeiobuf_ = base::MakeRefCounted<net::DrainableIOBuffer>(buf, buf->size());
 }
 
 // DoWrites()
@@ -716,8 +728,8 @@ void TorControl::ReadDone(int rv) {
         // CRLF seen, so we must have i >= 2.  Emit a line and advance
         // to the next one, unless anything went wrong with the line.
         assert(i >= 1);
-        std::string line(readiobuf_->StartOfBuffer() + read_start_,
-                         readiobuf_->offset() + i - 1 - read_start_);
+        base::StringPiece line(readiobuf_->StartOfBuffer() + read_start_,
+                               readiobuf_->offset() + i - 1 - read_start_);
         read_start_ = readiobuf_->offset() + i + 1;
         read_cr_ = false;
         if (!ReadLine(line)) {
@@ -771,9 +783,10 @@ void TorControl::ReadDone(int rv) {
 // ReadLine(line)
 //
 //      We have read a line of input; process it.  Return true on
-//      success, false on error.
+//      success, false on error.  The line points into the read buffer,
+//      so it is only copied where the reply outlives this call.
 //
-bool TorControl::ReadLine(const std::string& line) {
+bool TorControl::ReadLine(base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
 
   if (line.size() < 4) {
@@ -788,21 +801,21 @@ bool TorControl::ReadLine(const std::string& line) {
   // intermediate reply and ` ' for a final reply.
   //
   // TODO(riastradh): parse or check syntax of status
-  std::string status(line, 0, 3);
+  const std::string status = line.substr(0, 3).as_string();
   char pos = line[3];
-  std::string reply(line, 4);
+  base::StringPiece reply = line.substr(4);
 
   // Determine whether it is an asynchronous reply, status 6yz.
   if (status[0] == '6') {
     // Notify delegate of the raw reply.
-    NotifyTorRawAsync(status, reply);
+    NotifyTorRawAsync(status, reply.as_string());
 
     // Is this a new async reply?
     if (!async_) {
       // Parse the keyword and the initial line.
       const size_t sp = reply.find(' ');
-      std::string event_name, initial;
-      if (sp == std::string::npos) {
+      base::StringPiece event_name, initial;
+      if (sp == base::StringPiece::npos) {
         event_name = reply;
       } else {
         event_name = reply.substr(0, sp);
@@ -815,7 +828,8 @@ bool TorControl::ReadLine(const std::string& line) {
           // Single-line async reply.
 
           // Bail if we don't recognize the event name.
-          const auto& found = kTorControlEventByName.find(event_name);
+          const auto& found =
+              kTorControlEventByName.find(event_name.as_string());
           if (found == kTorControlEventByName.end()) {
             VLOG(1) << "tor: unknown event: " << event_name;  // XXX escape
             return false;
@@ -830,7 +844,7 @@ bool TorControl::ReadLine(const std::string& line) {
 
           // Notify the delegate of the parsed reply.  No extra
           // because there were no intermediate reply lines.
-          NotifyTorEvent(event, initial, {});
+          NotifyTorEvent(event, initial.as_string(), {});
 
           return true;
         }
@@ -839,13 +853,14 @@ bool TorControl::ReadLine(const std::string& line) {
 
           // Start a fresh async reply state.  Parse the rest, but
           // skip it, if we don't recognize the event.
-          const auto& found = kTorControlEventByName.find(event_name);
+          const auto& found =
+              kTorControlEventByName.find(event_name.as_string());
           const TorControlEvent event =
               (found == kTorControlEventByName.end() ? TorControlEvent::INVALID
                                                      : (*found).second);
           async_ = std::make_unique<Async>();
           async_->event = event;
-          async_->initial = initial;
+          async_->initial = initial.as_string();
           async_->skip = (event == TorControlEvent::INVALID);
           return true;
         }
@@ -878,7 +893,7 @@ bool TorControl::ReadLine(const std::string& line) {
             Error();
             return false;
           }
-          async_->extra[key] = value;
+          async_->extra[key] = std::move(value);
           return true;
         }
         case ' ': {
@@ -896,7 +911,7 @@ bool TorControl::ReadLine(const std::string& line) {
               Error();
               return false;
             }
-            async_->extra[key] = value;
+            async_->extra[key] = std::move(value);
 
             // If we're still subscribed, notify the delegate of the
             // parsed reply.
@@ -913,26 +928,30 @@ bool TorControl::ReadLine(const std::string& line) {
     // Synchronous reply.  Return it to the next command callback in
     // the queue.
     switch (pos) {
-      case '-':
-        NotifyTorRawMid(status, reply);
+      case '-': {
+        const std::string reply_string = reply.as_string();
+        NotifyTorRawMid(status, reply_string);
         if (!cmdq_.empty()) {
           PerLineCallback& perline = cmdq_.front().first;
-          perline.Run(status, reply);
+          perline.Run(status, reply_string);
         }
         return true;
+      }
       case '+':
         VLOG(2) << "tor: NYI: control data reply";
         // XXX Just ignore it for now.
         return true;
-      case ' ':
-        NotifyTorRawEnd(status, reply);
+      case ' ': {
+        const std::string reply_string = reply.as_string();
+        NotifyTorRawEnd(status, reply_string);
         if (!cmdq_.empty()) {
           CmdCallback& callback = cmdq_.front().second;
           bool error = false;
-          std::move(callback).Run(error, status, reply);
+          std::move(callback).Run(error, status, reply_string);
           cmdq_.pop();
         }
         return true;
+      }
     }
   }
 
@@ -1038,7 +1057,7 @@ void TorControl::NotifyTorRawEnd(const std::string& status,
 //      success, false on failure.
 //
 // static
-bool TorControl::ParseKV(const std::string& string,
+bool TorControl::ParseKV(base::StringPiece string,
                          std::string* key,
                          std::string* value) {
   size_t end;
@@ -1053,21 +1072,21 @@ bool TorControl::ParseKV(const std::string& string,
 //      failure.
 //
 // static
-bool TorControl::ParseKV(const std::string& string,
+bool TorControl::ParseKV(base::StringPiece string,
                          std::string* key,
                          std::string* value,
                          size_t* end) {
   DCHECK(key && value && end);
   // Search for `=' -- it had better be there.
-  size_t eq = string.find("=");
-  if (eq == std::string::npos)
+  size_t eq = string.find('=');
+  if (eq == base::StringPiece::npos)
     return false;
   size_t vstart = eq + 1;
 
   // If we're at the end of the string, value is empt.
   if (vstart == string.size()) {
-    *key = string.substr(0, eq);
-    *value = "";
+    string.substr(0, eq).CopyToString(key);
+    value->clear();
     *end = string.size();
     return true;
   }
@@ -1076,7 +1095,7 @@ bool TorControl::ParseKV(const std::string& string,
   if (string[vstart] != '"') {
     // Not quoted.  Check for a delimiter.
     size_t i, vend = string.size();
-    if ((i = string.find(" ", vstart)) != std::string::npos) {
+    if ((i = string.find(' ', vstart)) != base::StringPiece::npos) {
       // Delimited.  Stop at the delimiter, and consume it.
       vend = i;
       *end = vend + 1;
@@ -1086,19 +1105,19 @@ bool TorControl::ParseKV(const std::string& string,
     }
 
     // Check for internal quotes; they are forbidden.
-    if ((i = string.find("\"", vstart)) != std::string::npos)
+    if ((i = string.find('"', vstart)) != base::StringPiece::npos)
       return false;
 
     // Extract the key and value and we're done.
-    *key = string.substr(0, eq);
-    *value = string.substr(vstart, vend - vstart);
+    string.substr(0, eq).CopyToString(key);
+    string.substr(vstart, vend - vstart).CopyToString(value);
     return true;
   }
 
   // Quoted string.  Parse it, and consume trailing spaces.
   if (!ParseQuoted(string.substr(eq + 1), value, end))
     return false;
-  *key = string.substr(0, eq);
+  string.substr(0, eq).CopyToString(key);
   *end += eq + 1;
   while (*end < string.size() && string[*end] == ' ')
     (*end)++;
@@ -1113,7 +1132,7 @@ bool TorControl::ParseKV(const std::string& string,
 //      return false on failure.
 //
 // static
-bool TorControl::ParseQuoted(const std::string& string,
+bool TorControl::ParseQuoted(base::StringPiece string,
                              std::string* value,
                              size_t* end) {
   enum {
@@ -1125,7 +1144,10 @@ bool TorControl::ParseQuoted(const std::string& string,
     OCTAL1,
     OCTAL2,
   } S = START;
-  std::string buf(string.size(), '\0');
+  // The unescaped value is never longer than the quoted input, so
+  // build it in place in value rather than in a scratch buffer.
+  std::string& buf = *value;
+  buf.assign(string.size(), '\0');
   size_t i, pos = 0;
   unsigned octal;
 
@@ -1238,7 +1260,7 @@ bool TorControl::ParseQuoted(const std::string& string,
       case REJECT:
         return false;
       case ACCEPT:
-        *value = buf.substr(0, pos);
+        buf.resize(pos);
         *end = i + 1;
         return true;
       default:
@@ -5,8 +5,11 @@
 
 #include "brave/components/tor/tor_control.h"
 
+#include <vector>
+
 #include "base/callback_helpers.h"
 #include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/test/browser_task_environment.h"
@@ -184,6 +187,55 @@ TEST(TorControlTest, ReadLine) {
   base::RunLoop().RunUntilIdle();
 }
 
+TEST(TorControlTest, PipelinedReplies) {
+  content::BrowserTaskEnvironment task_environment;
+  scoped_refptr<base::SequencedTaskRunner> io_task_runner =
+      content::GetIOThreadTaskRunner({});
+
+  MockTorControlDelegate delegate;
+  std::unique_ptr<TorControl> control =
+      std::make_unique<TorControl>(delegate.AsWeakPtr(), io_task_runner);
+
+  io_task_runner->PostTask(
+      FROM_HERE,
+      base::BindOnce(
+          [](std::unique_ptr<TorControl> control) {
+            // Emulate two commands written back-to-back before any reply.
+            std::vector<std::string> lines;
+            std::vector<std::string> replies;
+            for (int i = 0; i < 2; i++) {
+              control->cmdq_.push(std::make_pair(
+                  base::BindRepeating(
+                      [](std::vector<std::string>* lines, int i,
+                         const std::string& status, const std::string& reply) {
+                        lines->push_back(base::NumberToString(i) + ":" + reply);
+                      },
+                      &lines, i),
+                  base::BindOnce(
+                      [](std::vector<std::string>* replies, int i, bool error,
+                         const std::string& status, const std::string& reply) {
+                        EXPECT_FALSE(error);
+                        replies->push_back(base::NumberToString(i) + ":" +
+                                           reply);
+                      },
+                      &replies, i)));
+            }
+            EXPECT_TRUE(control->ReadLine("250-version=0.4.5.7"));
+            EXPECT_TRUE(control->ReadLine("250 OK"));
+            EXPECT_TRUE(control->ReadLine("250-status/circuit-established=1"));
+            EXPECT_TRUE(control->ReadLine("250 OK"));
+            EXPECT_TRUE(control->cmdq_.empty());
+            EXPECT_EQ(lines,
+                      std::vector<std::string>(
+                          {"0:version=0.4.5.7",
+                           "1:status/circuit-established=1"}));
+            EXPECT_EQ(replies, std::vector<std::string>({"0:OK", "1:OK"}));
+          },
+          std::move(control)));
+
+  base::RunLoop().RunUntilIdle();
+}
+
 TEST(TorControlTest, GetCircuitEstablishedDone) {
   content::BrowserTaskEnvironment task_environment;
   scoped_refptr<base::SequencedTaskRunner> io_task_runner =
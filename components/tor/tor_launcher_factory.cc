@@ -6,11 +6,14 @@
 #include "brave/components/tor/tor_launcher_factory.h"
 
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/bind_post_task.h"
 #include "base/files/file_util.h"
 #include "base/sequenced_task_runner.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
 #include "base/threading/sequenced_task_runner_handle.h"
@@ -31,6 +34,9 @@ constexpr char kStatusClientBootstrap[] = "BOOTSTRAP";
 constexpr char kStatusClientBootstrapProgress[] = "PROGRESS=";
 constexpr char kStatusClientCircuitEstablished[] = "CIRCUIT_ESTABLISHED";
 constexpr char kStatusClientCircuitNotEstablished[] = "CIRCUIT_NOT_ESTABLISHED";
+// tor::TorControlEvent::STREAM bookkeeping
+constexpr size_t kMaxPendingStreams = 500;
+constexpr int kStreamConnectTimeWeight = 8;
 
 std::pair<bool, std::string> LoadTorLogOnFileTaskRunner(
     const base::FilePath& path) {
@@ -215,12 +221,11 @@ void TorLauncherFactory::OnTorLaunched(bool result, int64_t pid) {
     return;
   }
 
-  tor::TorFileWatcher* tor_file_watcher =
-      new tor::TorFileWatcher(config_.tor_watch_path);
-  tor_file_watcher->StartWatching(base::BindPostTask(
-      base::SequencedTaskRunnerHandle::Get(),
-      base::BindOnce(&TorLauncherFactory::OnTorControlPrerequisitesReady,
-                     weak_ptr_factory_.GetWeakPtr(), pid)));
+  // The launcher starts watching as soon as it spawns Tor, so it usually has
+  // the control port and cookie before we would.
+  tor_launcher_->GetControlPrerequisites(
+      base::BindOnce(&TorLauncherFactory::OnLauncherControlPrerequisitesReady,
+                     weak_ptr_factory_.GetWeakPtr(), pid));
 }
 
 void TorLauncherFactory::OnTorControlReady() {
@@ -300,6 +305,7 @@ void TorLauncherFactory::GotCircuitEstablished(bool error, bool established) {
 void TorLauncherFactory::OnTorControlClosed(bool was_running) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   VLOG(2) << "TOR CONTROL: Closed!";
+  pending_streams_.clear();
   // If we're still running, try watching again to start over.
   // TODO(riastradh-brave): Rate limit in case of flapping?
   if (was_running) {
@@ -320,15 +326,38 @@ void TorLauncherFactory::OnTorControlPrerequisitesReady(
   if (ready) {
     control_->Start(std::move(cookie), port);
   } else {
-    tor::TorFileWatcher* tor_file_watcher =
-        new tor::TorFileWatcher(config_.tor_watch_path);
-    tor_file_watcher->StartWatching(base::BindPostTask(
-        base::SequencedTaskRunnerHandle::Get(),
-        base::BindOnce(&TorLauncherFactory::OnTorControlPrerequisitesReady,
-                       weak_ptr_factory_.GetWeakPtr(), pid)));
+    WatchTorControlPrerequisites(pid);
+  }
+}
+
+void TorLauncherFactory::OnLauncherControlPrerequisitesReady(
+    int64_t pid,
+    bool ready,
+    const std::vector<uint8_t>& cookie,
+    int32_t port) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (pid != tor_pid_) {
+    VLOG(1) << "Tor control pid mismatched!";
+    return;
+  }
+  if (ready) {
+    control_->Start(cookie, port);
+  } else {
+    VLOG(1) << "Tor launcher has no control prerequisites, watching instead";
+    WatchTorControlPrerequisites(pid);
   }
 }
 
+void TorLauncherFactory::WatchTorControlPrerequisites(int64_t pid) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  tor::TorFileWatcher* tor_file_watcher =
+      new tor::TorFileWatcher(config_.tor_watch_path);
+  tor_file_watcher->StartWatching(base::BindPostTask(
+      base::SequencedTaskRunnerHandle::Get(),
+      base::BindOnce(&TorLauncherFactory::OnTorControlPrerequisitesReady,
+                     weak_ptr_factory_.GetWeakPtr(), pid)));
+}
+
 void TorLauncherFactory::RelaunchTor() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   Init();
@@ -358,7 +387,9 @@ void TorLauncherFactory::OnTorEvent(
   VLOG(3) << "TOR CONTROL: event " << raw_event;
   for (auto& observer : observers_)
     observer.OnTorControlEvent(raw_event);
-  if (event == tor::TorControlEvent::STATUS_CLIENT) {
+  if (event == tor::TorControlEvent::STREAM) {
+    UpdateStreamConnectTime(initial);
+  } else if (event == tor::TorControlEvent::STATUS_CLIENT) {
     if (initial.find(kStatusClientBootstrap) != std::string::npos) {
       size_t progress_start = initial.find(kStatusClientBootstrapProgress);
       size_t progress_length = initial.substr(progress_start).find(" ");
@@ -381,6 +412,44 @@ void TorLauncherFactory::OnTorEvent(
   }
 }
 
+base::TimeDelta TorLauncherFactory::GetAverageStreamConnectTime() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return average_stream_connect_time_;
+}
+
+void TorLauncherFactory::UpdateStreamConnectTime(
+    const std::string& stream_event) {
+  // "<StreamID> <StreamStatus> <CircuitID> <Target> ..."
+  const std::vector<base::StringPiece> fields = base::SplitStringPiece(
+      stream_event, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  if (fields.size() < 2)
+    return;
+  const std::string stream_id = fields[0].as_string();
+  const base::StringPiece status = fields[1];
+
+  if (status == "NEW") {
+    // Streams which never report back shouldn't accumulate.
+    if (pending_streams_.size() >= kMaxPendingStreams)
+      pending_streams_.clear();
+    pending_streams_[stream_id] = base::TimeTicks::Now();
+  } else if (status == "SUCCEEDED") {
+    auto it = pending_streams_.find(stream_id);
+    if (it == pending_streams_.end())
+      return;
+    const base::TimeDelta connect_time = base::TimeTicks::Now() - it->second;
+    pending_streams_.erase(it);
+    // Exponentially weighted, so the average follows the current circuits.
+    average_stream_connect_time_ =
+        average_stream_connect_time_.is_zero()
+            ? connect_time
+            : (average_stream_connect_time_ * (kStreamConnectTimeWeight - 1) +
+               connect_time) /
+                  kStreamConnectTimeWeight;
+  } else if (status == "FAILED" || status == "CLOSED") {
+    pending_streams_.erase(stream_id);
+  }
+}
+
 void TorLauncherFactory::OnTorRawCmd(const std::string& cmd) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   VLOG(3) << "TOR CONTROL: command: " << cmd;
@@ -17,6 +17,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/sequence_checker.h"
+#include "base/time/time.h"
 #include "brave/components/services/tor/public/interfaces/tor.mojom.h"
 #include "brave/components/tor/tor_control.h"
 #include "mojo/public/cpp/bindings/remote.h"
@@ -43,6 +44,10 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
   virtual std::string GetTorVersion() const;
   virtual void GetTorLog(GetLogCallback);
 
+  // Moving average of the time from a stream being opened until it is
+  // connected, as reported by STREAM events. Zero until a stream succeeds.
+  base::TimeDelta GetAverageStreamConnectTime() const;
+
   void AddObserver(TorLauncherObserver* observer);
   void RemoveObserver(TorLauncherObserver* observer);
 
@@ -67,6 +72,13 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
 
   void OnTorLogLoaded(GetLogCallback, const std::pair<bool, std::string>&);
 
+  // Control port and auth cookie as reported by the Tor launcher. Falls back
+  // to |WatchTorControlPrerequisites| if the launcher could not get them.
+  void OnLauncherControlPrerequisitesReady(int64_t pid,
+                                           bool ready,
+                                           const std::vector<uint8_t>& cookie,
+                                           int32_t port);
+  void WatchTorControlPrerequisites(int64_t pid);
   void OnTorControlPrerequisitesReady(int64_t pid,
                                       bool ready,
                                       std::vector<uint8_t> cookie,
@@ -84,6 +96,8 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
   void RelaunchTor();
   void DelayedRelaunchTor();
 
+  void UpdateStreamConnectTime(const std::string& stream_event);
+
   bool is_starting_;
   bool is_connected_;
 
@@ -94,6 +108,10 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
 
   int64_t tor_pid_;
 
+  // Streams which have been opened but are not connected yet, by stream id.
+  std::map<std::string, base::TimeTicks> pending_streams_;
+  base::TimeDelta average_stream_connect_time_;
+
   tor::mojom::TorConfig config_;
 
   base::ObserverList<TorLauncherObserver> observers_;
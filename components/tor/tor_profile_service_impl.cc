@@ -11,6 +11,7 @@
 
 #include "base/bind.h"
 #include "base/task/post_task.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/components/tor/pref_names.h"
 #include "brave/components/tor/tor_constants.h"
 #include "brave/net/proxy_resolution/proxy_config_service_tor.h"
@@ -119,6 +120,7 @@ TorProfileServiceImpl::TorProfileServiceImpl(
       tor_client_updater_(tor_client_updater),
       tor_launcher_factory_(TorLauncherFactory::GetInstance()),
       weak_ptr_factory_(this) {
+  TRACE_EVENT0("brave.tor", "TorProfileServiceImpl::TorProfileServiceImpl");
   if (tor_launcher_factory_) {
     tor_launcher_factory_->AddObserver(this);
   }
@@ -148,6 +150,7 @@ void TorProfileServiceImpl::OnExecutableReady(const base::FilePath& path) {
 }
 
 void TorProfileServiceImpl::LaunchTor() {
+  TRACE_EVENT0("brave.tor", "TorProfileServiceImpl::LaunchTor");
   tor::mojom::TorConfig config(GetTorExecutablePath(), GetTorDataPath(),
                                GetTorWatchPath());
   tor_launcher_factory_->LaunchTorProcess(config);
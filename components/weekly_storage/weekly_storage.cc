@@ -19,34 +19,45 @@ constexpr size_t kDaysInWeek = 7;
 }
 
 WeeklyStorage::WeeklyStorage(PrefService* prefs, const char* pref_name)
+    : WeeklyStorage(prefs, pref_name, base::DefaultClock::GetInstance()) {}
+
+WeeklyStorage::WeeklyStorage(PrefService* prefs,
+                             const char* pref_name,
+                             std::unique_ptr<base::Clock> clock)
     : prefs_(prefs),
       pref_name_(pref_name),
-      clock_(std::make_unique<base::DefaultClock>()) {
+      owned_clock_(std::move(clock)),
+      clock_(owned_clock_.get()) {
+  DCHECK(prefs);
   DCHECK(pref_name);
-  if (prefs) {
-    Load();
-  }
+  Load();
 }
 
 WeeklyStorage::WeeklyStorage(PrefService* prefs,
                              const char* pref_name,
-                             std::unique_ptr<base::Clock> clock)
-    : prefs_(prefs), pref_name_(pref_name), clock_(std::move(clock)) {
-  DCHECK(prefs);
+                             const base::Clock* clock)
+    : prefs_(prefs), pref_name_(pref_name), clock_(clock) {
   DCHECK(pref_name);
-  Load();
+  DCHECK(clock);
+  if (prefs) {
+    Load();
+  }
 }
 
 WeeklyStorage::~WeeklyStorage() = default;
 
 void WeeklyStorage::AddDelta(uint64_t delta) {
-  FilterToWeek();
+  AddDeltaForDay(clock_->Now(), delta);
+}
+
+void WeeklyStorage::AddDeltaForDay(base::Time time, uint64_t delta) {
+  FilterToWeek(time.LocalMidnight());
   daily_values_.front().value += delta;
   Save();
 }
 
 void WeeklyStorage::ReplaceTodaysValueIfGreater(uint64_t value) {
-  FilterToWeek();
+  FilterToWeek(clock_->Now().LocalMidnight());
   DailyValue& today = daily_values_.front();
   if (today.value < value) {
     today.value = value;
@@ -98,18 +109,17 @@ bool WeeklyStorage::IsOneWeekPassed() const {
   return daily_values_.size() == kDaysInWeek;
 }
 
-void WeeklyStorage::FilterToWeek() {
-  base::Time now_midnight = clock_->Now().LocalMidnight();
+void WeeklyStorage::FilterToWeek(base::Time day) {
   base::Time last_saved_midnight;
 
   if (!daily_values_.empty()) {
     last_saved_midnight = daily_values_.front().day;
   }
 
-  if (now_midnight - last_saved_midnight > base::TimeDelta()) {
+  if (day - last_saved_midnight > base::TimeDelta()) {
     // Day changed. Since we consider only small incoming intervals, lets just
     // save it with a new timestamp.
-    daily_values_.push_front({now_midnight, 0});
+    daily_values_.push_front({day, 0});
     if (daily_values_.size() > kDaysInWeek) {
       daily_values_.pop_back();
     }
@@ -30,12 +30,20 @@ class WeeklyStorage {
   WeeklyStorage(PrefService* user_prefs,
                 const char* pref_name,
                 std::unique_ptr<base::Clock> clock);
+  // Uses the |clock| of the caller, which must outlive this object.
+  WeeklyStorage(PrefService* prefs,
+                const char* pref_name,
+                const base::Clock* clock);
   ~WeeklyStorage();
 
   WeeklyStorage(const WeeklyStorage&) = delete;
   WeeklyStorage& operator=(const WeeklyStorage&) = delete;
 
   void AddDelta(uint64_t delta);
+  // Adds |delta| to the value of the day |time| is in, for values collected
+  // before being stored. |time| must not be older than the last day a value
+  // was added on.
+  void AddDeltaForDay(base::Time time, uint64_t delta);
   void ReplaceTodaysValueIfGreater(uint64_t value);
   uint64_t GetWeeklySum() const;
   uint64_t GetHighestValueInWeek() const;
@@ -46,13 +54,14 @@ class WeeklyStorage {
     base::Time day;
     uint64_t value = 0ull;
   };
-  void FilterToWeek();
+  void FilterToWeek(base::Time day);
   void Load();
   void Save();
 
   PrefService* prefs_ = nullptr;
   const char* pref_name_ = nullptr;
-  std::unique_ptr<base::Clock> clock_;
+  std::unique_ptr<base::Clock> owned_clock_;
+  const base::Clock* clock_ = nullptr;
 
   std::list<DailyValue> daily_values_;
 };
@@ -46,6 +46,18 @@ TEST_F(WeeklyStorageTest, AddsSavings) {
   EXPECT_EQ(state_->GetWeeklySum(), saving * 3);
 }
 
+TEST_F(WeeklyStorageTest, AddsSavingsForDay) {
+  uint64_t saving = 10000;
+  const base::Time yesterday = clock_->Now() - base::TimeDelta::FromDays(1);
+  state_->AddDeltaForDay(yesterday, saving);
+  state_->AddDelta(saving);
+  EXPECT_EQ(state_->GetWeeklySum(), saving * 2);
+
+  // Yesterday's savings are forgotten a day earlier
+  clock_->Advance(base::TimeDelta::FromDays(6));
+  EXPECT_EQ(state_->GetWeeklySum(), saving);
+}
+
 TEST_F(WeeklyStorageTest, ForgetsOldSavings) {
   uint64_t saving = 10000;
   state_->AddDelta(saving);
@@ -0,0 +1,142 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_canvas_farbling.h"
+
+#include <string.h>
+
+#include "base/logging.h"
+#include "base/strings/string_piece.h"
+#include "crypto/hmac.h"
+
+namespace brave {
+
+namespace {
+
+// Number of 8 byte words (two RGBA pixels each) hashed from a canvas that is
+// too large to hash completely.
+constexpr size_t kSampledWordCount = 2048;
+
+inline uint64_t RotateLeft(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t ReadWord(const uint8_t* data) {
+  uint64_t word;
+  memcpy(&word, data, sizeof word);
+  return word;
+}
+
+// SipHash-2-4 over a sequence of 64-bit words.
+class SipHasher {
+ public:
+  SipHasher(uint64_t k0, uint64_t k1)
+      : v0_(k0 ^ 0x736f6d6570736575ULL),
+        v1_(k1 ^ 0x646f72616e646f6dULL),
+        v2_(k0 ^ 0x6c7967656e657261ULL),
+        v3_(k1 ^ 0x7465646279746573ULL) {}
+
+  void Update(uint64_t word) {
+    v3_ ^= word;
+    Round();
+    Round();
+    v0_ ^= word;
+    length_ += sizeof word;
+  }
+
+  uint64_t Finish() {
+    const uint64_t last = static_cast<uint64_t>(length_) << 56;
+    v3_ ^= last;
+    Round();
+    Round();
+    v0_ ^= last;
+    v2_ ^= 0xff;
+    Round();
+    Round();
+    Round();
+    Round();
+    return v0_ ^ v1_ ^ v2_ ^ v3_;
+  }
+
+ private:
+  void Round() {
+    v0_ += v1_;
+    v1_ = RotateLeft(v1_, 13);
+    v1_ ^= v0_;
+    v0_ = RotateLeft(v0_, 32);
+    v2_ += v3_;
+    v3_ = RotateLeft(v3_, 16);
+    v3_ ^= v2_;
+    v0_ += v3_;
+    v3_ = RotateLeft(v3_, 21);
+    v3_ ^= v0_;
+    v2_ += v1_;
+    v1_ = RotateLeft(v1_, 17);
+    v1_ ^= v2_;
+    v2_ = RotateLeft(v2_, 32);
+  }
+
+  uint64_t v0_;
+  uint64_t v1_;
+  uint64_t v2_;
+  uint64_t v3_;
+  size_t length_ = 0;
+};
+
+}  // namespace
+
+void ComputeCanvasKeyFromAllPixels(uint64_t key,
+                                   const uint8_t* pixels,
+                                   size_t size,
+                                   uint8_t canvas_key[kCanvasKeySize]) {
+  crypto::HMAC h(crypto::HMAC::SHA256);
+  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&key), sizeof key));
+  CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(pixels), size),
+               canvas_key, kCanvasKeySize));
+}
+
+void ComputeCanvasKeyFromSampledPixels(uint64_t k0,
+                                       uint64_t k1,
+                                       const uint8_t* pixels,
+                                       size_t size,
+                                       uint8_t canvas_key[kCanvasKeySize]) {
+  SipHasher hasher(k0, k1);
+  hasher.Update(size);
+  const size_t word_count = size / sizeof(uint64_t);
+  if (word_count <= kSampledWordCount) {
+    for (size_t i = 0; i < word_count; i++)
+      hasher.Update(ReadWord(pixels + i * sizeof(uint64_t)));
+  } else {
+    // Take one word from each of kSampledWordCount equal stripes, so that
+    // the whole canvas contributes. Where in its stripe a word is taken from
+    // is derived from the keys. Otherwise a page could learn which pixels
+    // are sampled and keep the farbling fixed while changing the rest.
+    const size_t stride = word_count / kSampledWordCount;
+    hasher.Update(ReadWord(pixels));
+    for (size_t i = 0; i < kSampledWordCount; i++) {
+      SipHasher position(k1, k0);
+      position.Update(i);
+      const size_t index = i * stride + position.Finish() % stride;
+      hasher.Update(ReadWord(pixels + index * sizeof(uint64_t)));
+    }
+    hasher.Update(ReadWord(pixels + (word_count - 1) * sizeof(uint64_t)));
+  }
+  uint64_t tail = 0;
+  memcpy(&tail, pixels + word_count * sizeof(uint64_t),
+         size % sizeof(uint64_t));
+  hasher.Update(tail);
+  const uint64_t digest = hasher.Finish();
+
+  // Expand the digest to a full canvas key, one keyed hash per word.
+  for (size_t i = 0; i < kCanvasKeySize / sizeof(uint64_t); i++) {
+    SipHasher expander(k0, k1);
+    expander.Update(digest);
+    expander.Update(i);
+    const uint64_t word = expander.Finish();
+    memcpy(canvas_key + i * sizeof(uint64_t), &word, sizeof word);
+  }
+}
+
+}  // namespace brave
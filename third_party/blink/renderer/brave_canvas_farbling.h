@@ -0,0 +1,36 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_FARBLING_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_FARBLING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace brave {
+
+// Size of the key that decides which canvas pixels get perturbed.
+constexpr size_t kCanvasKeySize = 32;
+
+// Derives the canvas key from an HMAC-SHA256 over every byte of |pixels|.
+void ComputeCanvasKeyFromAllPixels(uint64_t key,
+                                   const uint8_t* pixels,
+                                   size_t size,
+                                   uint8_t canvas_key[kCanvasKeySize]);
+
+// Derives the canvas key from a SipHash-2-4, keyed with |k0| and |k1|, over
+// |size| and a sample of |pixels|. The sampled positions are spread over the
+// whole canvas and also derived from the keys, so they differ per session
+// and site. The cost no longer grows with the canvas, and the same canvas
+// contents under the same keys still always give the same result.
+void ComputeCanvasKeyFromSampledPixels(uint64_t k0,
+                                       uint64_t k1,
+                                       const uint8_t* pixels,
+                                       size_t size,
+                                       uint8_t canvas_key[kCanvasKeySize]);
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_FARBLING_H_
@@ -0,0 +1,133 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_canvas_farbling.h"
+
+#include <string.h>
+
+#include <vector>
+
+#include "base/logging.h"
+#include "base/timer/elapsed_timer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr uint64_t kSessionKey = 0x0123456789abcdefULL;
+constexpr uint64_t kDomainKey = 0xfedcba9876543210ULL;
+
+std::vector<uint8_t> MakeCanvas(size_t width, size_t height) {
+  std::vector<uint8_t> pixels(width * height * 4);
+  for (size_t i = 0; i < pixels.size(); i++)
+    pixels[i] = static_cast<uint8_t>((i * 31) ^ (i >> 9));
+  return pixels;
+}
+
+std::vector<uint8_t> SampledKey(uint64_t k0,
+                                uint64_t k1,
+                                const std::vector<uint8_t>& pixels) {
+  std::vector<uint8_t> key(brave::kCanvasKeySize);
+  brave::ComputeCanvasKeyFromSampledPixels(k0, k1, pixels.data(),
+                                           pixels.size(), key.data());
+  return key;
+}
+
+// Returns the index of the word in the second sampling stripe of |pixels|
+// that the sampled key depends on.
+size_t SampledWordInSecondStripe(uint64_t k0,
+                                 uint64_t k1,
+                                 std::vector<uint8_t> pixels) {
+  const std::vector<uint8_t> key = SampledKey(k0, k1, pixels);
+  const size_t stride = pixels.size() / sizeof(uint64_t) / 2048;
+  for (size_t i = stride; i < 2 * stride; i++) {
+    pixels[i * sizeof(uint64_t)] ^= 1;
+    const bool changed = key != SampledKey(k0, k1, pixels);
+    pixels[i * sizeof(uint64_t)] ^= 1;
+    if (changed)
+      return i;
+  }
+  return 0;
+}
+
+}  // namespace
+
+TEST(BraveCanvasFarblingTest, SampledKeyIsDeterministic) {
+  const std::vector<uint8_t> pixels = MakeCanvas(640, 480);
+  EXPECT_EQ(SampledKey(kSessionKey, kDomainKey, pixels),
+            SampledKey(kSessionKey, kDomainKey, pixels));
+}
+
+TEST(BraveCanvasFarblingTest, SampledKeyDependsOnKeys) {
+  const std::vector<uint8_t> pixels = MakeCanvas(640, 480);
+  const std::vector<uint8_t> key = SampledKey(kSessionKey, kDomainKey, pixels);
+  EXPECT_NE(key, SampledKey(kSessionKey + 1, kDomainKey, pixels));
+  EXPECT_NE(key, SampledKey(kSessionKey, kDomainKey + 1, pixels));
+}
+
+TEST(BraveCanvasFarblingTest, SampledKeyDependsOnContents) {
+  // Small canvases are hashed completely, including a partial trailing word.
+  std::vector<uint8_t> small = MakeCanvas(3, 3);
+  const std::vector<uint8_t> small_key =
+      SampledKey(kSessionKey, kDomainKey, small);
+  small.back() ^= 1;
+  EXPECT_NE(small_key, SampledKey(kSessionKey, kDomainKey, small));
+
+  // Large canvases are sampled, but always at their first and last pixels.
+  std::vector<uint8_t> large = MakeCanvas(3840, 2160);
+  const std::vector<uint8_t> large_key =
+      SampledKey(kSessionKey, kDomainKey, large);
+  large.front() ^= 1;
+  EXPECT_NE(large_key, SampledKey(kSessionKey, kDomainKey, large));
+  large.front() ^= 1;
+  large.back() ^= 1;
+  EXPECT_NE(large_key, SampledKey(kSessionKey, kDomainKey, large));
+}
+
+TEST(BraveCanvasFarblingTest, SampledPositionsDependOnKeys) {
+  const std::vector<uint8_t> pixels = MakeCanvas(3840, 2160);
+  const size_t word =
+      SampledWordInSecondStripe(kSessionKey, kDomainKey, pixels);
+  ASSERT_NE(0u, word);
+  EXPECT_NE(word,
+            SampledWordInSecondStripe(kSessionKey, kDomainKey + 1, pixels));
+}
+
+TEST(BraveCanvasFarblingTest, AllPixelsKeyIsDeterministic) {
+  const std::vector<uint8_t> pixels = MakeCanvas(64, 64);
+  uint8_t key1[brave::kCanvasKeySize];
+  uint8_t key2[brave::kCanvasKeySize];
+  brave::ComputeCanvasKeyFromAllPixels(kSessionKey ^ kDomainKey, pixels.data(),
+                                       pixels.size(), key1);
+  brave::ComputeCanvasKeyFromAllPixels(kSessionKey ^ kDomainKey, pixels.data(),
+                                       pixels.size(), key2);
+  EXPECT_EQ(0, memcmp(key1, key2, sizeof key1));
+}
+
+// Compares the cost of both key derivations on a 4K canvas. Run with
+// --gtest_also_run_disabled_tests.
+TEST(BraveCanvasFarblingTest, DISABLED_CanvasKeyPerf) {
+  constexpr int kIterations = 50;
+  const std::vector<uint8_t> pixels = MakeCanvas(3840, 2160);
+  uint8_t key[brave::kCanvasKeySize];
+
+  base::ElapsedTimer all_pixels_timer;
+  for (int i = 0; i < kIterations; i++) {
+    brave::ComputeCanvasKeyFromAllPixels(kSessionKey ^ kDomainKey,
+                                         pixels.data(), pixels.size(), key);
+  }
+  const base::TimeDelta all_pixels_time = all_pixels_timer.Elapsed();
+
+  base::ElapsedTimer sampled_timer;
+  for (int i = 0; i < kIterations; i++) {
+    brave::ComputeCanvasKeyFromSampledPixels(kSessionKey, kDomainKey,
+                                             pixels.data(), pixels.size(), key);
+  }
+  const base::TimeDelta sampled_time = sampled_timer.Elapsed();
+
+  LOG(INFO) << "Canvas key for 3840x2160, HMAC over all pixels: "
+            << (all_pixels_time / kIterations).InMicroseconds()
+            << "us, sampled SipHash: "
+            << (sampled_time / kIterations).InMicroseconds() << "us";
+}
@@ -51,6 +51,10 @@ using base::Time;
 
 namespace {
 
+// History rows are handed to the bridge in chunks of this size so that a
+// long-lived profile's history is never held in memory all at once.
+constexpr size_t kHistoryRowsChunkSize = 1000;
+
 // Most of below code is copied from os_crypt_win.cc
 #if defined(OS_WIN)
 // Contains base64 random key encrypted with DPAPI.
@@ -248,6 +252,7 @@ void ChromeImporter::ImportHistory() {
   s.BindInt64(4, ui::PAGE_TRANSITION_KEYWORD_GENERATED);
 
   std::vector<ImporterURLRow> rows;
+  rows.reserve(kHistoryRowsChunkSize);
   while (s.Step() && !cancelled()) {
     GURL url(s.ColumnString(0));
 
@@ -260,6 +265,10 @@ void ChromeImporter::ImportHistory() {
     row.visit_count = s.ColumnInt(4);
 
     rows.push_back(row);
+    if (rows.size() == kHistoryRowsChunkSize) {
+      bridge_->SetHistoryItems(rows, importer::VISIT_SOURCE_CHROME_IMPORTED);
+      rows.clear();
+    }
   }
 
   if (!rows.empty() && !cancelled())
@@ -267,17 +276,21 @@ void ChromeImporter::ImportHistory() {
 }
 
 void ChromeImporter::ImportBookmarks() {
-  std::string bookmarks_content;
   base::FilePath bookmarks_path = source_path_.Append(
       base::FilePath::StringType(FILE_PATH_LITERAL("Bookmarks")));
   ScopedCopyFile copy_bookmark_file(bookmarks_path);
   if (!copy_bookmark_file.copy_success())
     return;
 
-  base::ReadFileToString(copy_bookmark_file.copied_file_path(),
-                         &bookmarks_content);
-  base::Optional<base::Value> bookmarks_json =
-      base::JSONReader::Read(bookmarks_content);
+  base::Optional<base::Value> bookmarks_json;
+  {
+    // Drop the raw file contents as soon as they are parsed; for large
+    // bookmark files they are as big as the parsed tree itself.
+    std::string bookmarks_content;
+    base::ReadFileToString(copy_bookmark_file.copied_file_path(),
+                           &bookmarks_content);
+    bookmarks_json = base::JSONReader::Read(bookmarks_content);
+  }
   const base::DictionaryValue* bookmark_dict;
   if (!bookmarks_json || !bookmarks_json->GetAsDictionary(&bookmark_dict))
     return;
@@ -305,7 +318,12 @@ void ChromeImporter::ImportBookmarks() {
       RecursiveReadBookmarksFolder(other, path, false, &bookmarks);
     }
   }
-  // Write into profile.
+  // The entries hold copies of everything needed from the parsed tree.
+  bookmarks_json.reset();
+
+  // Write into profile. All entries go in one call, as each call may create
+  // its own "Imported from" folder; ProfileWriter applies them to the
+  // BookmarkModel inside a single extensive change.
   if (!bookmarks.empty() && !cancelled()) {
     bridge_->AddBookmarks(bookmarks, u"Imported from Chrome");
   }
@@ -416,7 +434,7 @@ void ChromeImporter::RecursiveReadBookmarksFolder(
           entry.title = name;
           entry.creation_time = base::Time::FromDoubleT(
               chromeTimeToDouble(std::stoll(date_added)));
-          bookmarks->push_back(entry);
+          bookmarks->push_back(std::move(entry));
         }
 
         std::vector<std::u16string> path = parent_path;
@@ -430,7 +448,7 @@ void ChromeImporter::RecursiveReadBookmarksFolder(
         entry.title = name;
         entry.creation_time =
             base::Time::FromDoubleT(chromeTimeToDouble(std::stoll(date_added)));
-        bookmarks->push_back(entry);
+        bookmarks->push_back(std::move(entry));
       }
     }
   }